@@ -93,6 +93,10 @@ namespace ch {
 		return a.x * b.x + a.y * b.y;
 	}	
 
+	float vec_cross_product(vec_t a, vec_t b) {
+		return a.x * b.y - a.y * b.x;
+	}
+
 	vec_t vec_abs(vec_t v) {
 		return vec_t(std::abs(v.x), std::abs(v.y));
 	}
@@ -118,6 +122,214 @@ namespace ch {
 	}
 }
 
+#include <array>
+#include <cmath>
+
+#ifdef CH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace ch {
+
+	using MagnitudeBatchKernel = void(*)(const float*, const float*, float*, size_t);
+	using DotProductBatchKernel = void(*)(const float*, const float*, const float*, const float*, float*, size_t);
+	using NormalizeBatchKernel = void(*)(float*, float*, size_t);
+
+	/**
+	 * \brief Function pointers to the batched vector maths kernels of one SIMD tier.
+	 */
+	struct BatchVectorMathsKernels {
+		MagnitudeBatchKernel magnitude;
+		DotProductBatchKernel dotProduct;
+		NormalizeBatchKernel normalize;
+	};
+
+	static void vec_magnitude_range(const float* x, const float* y, float* magnitudes, size_t first, size_t count) {
+		for (size_t i = first; i < count; ++i) {
+			magnitudes[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+		}
+	}
+
+	static void vec_dot_product_range(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t first, size_t count) {
+		for (size_t i = first; i < count; ++i) {
+			products[i] = ax[i] * bx[i] + ay[i] * by[i];
+		}
+	}
+
+	static void vec_normalize_range(float* x, float* y, size_t first, size_t count) {
+		for (size_t i = first; i < count; ++i) {
+			if (x[i] != 0.f || y[i] != 0.f) {
+				float magnitude = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+				x[i] /= magnitude;
+				y[i] /= magnitude;
+			}
+		}
+	}
+
+	static void vec_magnitude_batch_scalar(const float* x, const float* y, float* magnitudes, size_t count) {
+		vec_magnitude_range(x, y, magnitudes, 0, count);
+	}
+
+	static void vec_dot_product_batch_scalar(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		vec_dot_product_range(ax, ay, bx, by, products, 0, count);
+	}
+
+	static void vec_normalize_batch_scalar(float* x, float* y, size_t count) {
+		vec_normalize_range(x, y, 0, count);
+	}
+
+#ifdef CH_SIMD_X86
+	CH_SIMD_TARGET("sse2")
+	static void vec_magnitude_batch_sse2(const float* x, const float* y, float* magnitudes, size_t count) {
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 vx = _mm_loadu_ps(x + i);
+			__m128 vy = _mm_loadu_ps(y + i);
+			_mm_storeu_ps(magnitudes + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy))));
+		}
+		vec_magnitude_range(x, y, magnitudes, i, count);
+	}
+
+	CH_SIMD_TARGET("sse2")
+	static void vec_dot_product_batch_sse2(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 xx = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+			__m128 yy = _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+			_mm_storeu_ps(products + i, _mm_add_ps(xx, yy));
+		}
+		vec_dot_product_range(ax, ay, bx, by, products, i, count);
+	}
+
+	CH_SIMD_TARGET("sse2")
+	static void vec_normalize_batch_sse2(float* x, float* y, size_t count) {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 vx = _mm_loadu_ps(x + i);
+			__m128 vy = _mm_loadu_ps(y + i);
+			__m128 magnitude = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+			// Null vectors are divided by 1 so they stay null instead of becoming NaN
+			__m128 isNull = _mm_cmpeq_ps(magnitude, zero);
+			__m128 divisor = _mm_or_ps(_mm_and_ps(isNull, one), _mm_andnot_ps(isNull, magnitude));
+			_mm_storeu_ps(x + i, _mm_div_ps(vx, divisor));
+			_mm_storeu_ps(y + i, _mm_div_ps(vy, divisor));
+		}
+		vec_normalize_range(x, y, i, count);
+	}
+
+	CH_SIMD_TARGET("avx2")
+	static void vec_magnitude_batch_avx2(const float* x, const float* y, float* magnitudes, size_t count) {
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 vx = _mm256_loadu_ps(x + i);
+			__m256 vy = _mm256_loadu_ps(y + i);
+			_mm256_storeu_ps(magnitudes + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy))));
+		}
+		vec_magnitude_range(x, y, magnitudes, i, count);
+	}
+
+	CH_SIMD_TARGET("avx2")
+	static void vec_dot_product_batch_avx2(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 xx = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+			__m256 yy = _mm256_mul_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i));
+			_mm256_storeu_ps(products + i, _mm256_add_ps(xx, yy));
+		}
+		vec_dot_product_range(ax, ay, bx, by, products, i, count);
+	}
+
+	CH_SIMD_TARGET("avx2")
+	static void vec_normalize_batch_avx2(float* x, float* y, size_t count) {
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.f);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 vx = _mm256_loadu_ps(x + i);
+			__m256 vy = _mm256_loadu_ps(y + i);
+			__m256 magnitude = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+			__m256 divisor = _mm256_blendv_ps(magnitude, one, _mm256_cmp_ps(magnitude, zero, _CMP_EQ_OQ));
+			_mm256_storeu_ps(x + i, _mm256_div_ps(vx, divisor));
+			_mm256_storeu_ps(y + i, _mm256_div_ps(vy, divisor));
+		}
+		vec_normalize_range(x, y, i, count);
+	}
+
+	CH_SIMD_TARGET("avx512f")
+	static void vec_magnitude_batch_avx512(const float* x, const float* y, float* magnitudes, size_t count) {
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m512 vx = _mm512_loadu_ps(x + i);
+			__m512 vy = _mm512_loadu_ps(y + i);
+			_mm512_storeu_ps(magnitudes + i, _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(vx, vx), _mm512_mul_ps(vy, vy))));
+		}
+		vec_magnitude_range(x, y, magnitudes, i, count);
+	}
+
+	CH_SIMD_TARGET("avx512f")
+	static void vec_dot_product_batch_avx512(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m512 xx = _mm512_mul_ps(_mm512_loadu_ps(ax + i), _mm512_loadu_ps(bx + i));
+			__m512 yy = _mm512_mul_ps(_mm512_loadu_ps(ay + i), _mm512_loadu_ps(by + i));
+			_mm512_storeu_ps(products + i, _mm512_add_ps(xx, yy));
+		}
+		vec_dot_product_range(ax, ay, bx, by, products, i, count);
+	}
+
+	CH_SIMD_TARGET("avx512f")
+	static void vec_normalize_batch_avx512(float* x, float* y, size_t count) {
+		const __m512 zero = _mm512_setzero_ps();
+		const __m512 one = _mm512_set1_ps(1.f);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m512 vx = _mm512_loadu_ps(x + i);
+			__m512 vy = _mm512_loadu_ps(y + i);
+			__m512 magnitude = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(vx, vx), _mm512_mul_ps(vy, vy)));
+			__m512 divisor = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(magnitude, zero, _CMP_EQ_OQ), magnitude, one);
+			_mm512_storeu_ps(x + i, _mm512_div_ps(vx, divisor));
+			_mm512_storeu_ps(y + i, _mm512_div_ps(vy, divisor));
+		}
+		vec_normalize_range(x, y, i, count);
+	}
+#endif
+
+	/**
+	 * \brief Returns the kernels matching the active SIMD tier.
+	 */
+	static const BatchVectorMathsKernels& batch_vector_maths_kernels() {
+		static const std::array<BatchVectorMathsKernels, static_cast<size_t>(simd::SimdLevel::MAX_VALUE)> KERNELS =
+		{
+#ifdef CH_SIMD_X86
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_sse2, vec_dot_product_batch_sse2, vec_normalize_batch_sse2 },
+			BatchVectorMathsKernels{ vec_magnitude_batch_avx2, vec_dot_product_batch_avx2, vec_normalize_batch_avx2 },
+			BatchVectorMathsKernels{ vec_magnitude_batch_avx512, vec_dot_product_batch_avx512, vec_normalize_batch_avx512 }
+#else
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar }
+#endif
+		};
+		return KERNELS[static_cast<size_t>(simd::active_simd_level())];
+	}
+
+	void vec_magnitude_batch(const float* x, const float* y, float* magnitudes, size_t count) {
+		batch_vector_maths_kernels().magnitude(x, y, magnitudes, count);
+	}
+
+	void vec_dot_product_batch(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		batch_vector_maths_kernels().dotProduct(ax, ay, bx, by, products, count);
+	}
+
+	void vec_normalize_batch(float* x, float* y, size_t count) {
+		batch_vector_maths_kernels().normalize(x, y, count);
+	}
+}
+
 #include <array>
 
 namespace ch {
@@ -264,6 +476,50 @@ namespace ch {
 	}
 }
 
+namespace ch {
+
+	Bounds::Bounds() : min(0.f, 0.f), max(0.f, 0.f) {}
+
+	Bounds::Bounds(const vec_t& min_, const vec_t& max_) : min(min_), max(max_) {}
+
+	Bounds::Bounds(float minX, float minY, float maxX, float maxY) : min(minX, minY), max(maxX, maxY) {}
+
+	Bounds::Bounds(const AABB& aabb) : min(aabb.pos), max(aabb.pos + aabb.size) {}
+
+	AABB Bounds::toAABB() const {
+		return AABB(min, max - min);
+	}
+
+	void Bounds::move(const vec_t& movement) {
+		min += movement;
+		max += movement;
+	}
+
+	vec_t Bounds::center() const {
+		return (min + max) / 2.f;
+	}
+
+	vec_t Bounds::size() const {
+		return max - min;
+	}
+
+	float Bounds::perimeter() const {
+		return 2 * (max.x - min.x + max.y - min.y);
+	}
+
+	float Bounds::area() const {
+		return (max.x - min.x) * (max.y - min.y);
+	}
+
+	bool operator==(const Bounds& left, const Bounds& right) {
+		return left.min == right.min && left.max == right.max;
+	}
+
+	bool operator!=(const Bounds& left, const Bounds& right) {
+		return !(left == right);
+	}
+}
+
 namespace ch {
 	SegmentsIntersection::SegmentsIntersection(IntersectionType type_) : type(type_) {}
 	SegmentsIntersection::SegmentsIntersection(IntersectionType type_, const vec_t& point_) : type(type_), point(point_) {}
@@ -339,405 +595,8171 @@ namespace ch {
 	}
 }
 
+#include <algorithm>
+#include <cmath>
+
 namespace ch {
 
-	Stopwatch::Stopwatch() {
-		start();
+	PreparedSegment::PreparedSegment(const vec_t& startPoint, const vec_t& endPoint) :
+		start_(startPoint),
+		end_(endPoint),
+		direction_(endPoint - startPoint),
+		inverseDirection_(direction_.x != 0.f ? 1.f / direction_.x : 0.f, direction_.y != 0.f ? 1.f / direction_.y : 0.f),
+		length_(vec_magnitude(direction_)),
+		inverseLengthSquared_(0.f),
+		bounds_(std::min(startPoint.x, endPoint.x), std::min(startPoint.y, endPoint.y), std::max(startPoint.x, endPoint.x), std::max(startPoint.y, endPoint.y))
+	{
+		const float lengthSquared = vec_dot_product(direction_, direction_);
+		if (lengthSquared != 0.f) {
+			inverseLengthSquared_ = 1.f / lengthSquared;
+		}
 	}
 
-	void Stopwatch::start() {
-		start_ = now();
+	PreparedSegment::PreparedSegment(const LineSegment& segment) : PreparedSegment(segment.start, segment.end) {}
+
+	const vec_t& PreparedSegment::start() const {
+		return start_;
 	}
 
-	void Stopwatch::reset() {
-		start();
+	const vec_t& PreparedSegment::end() const {
+		return end_;
 	}
 
-	void Stopwatch::stop() {
-		end_ = now();
+	const vec_t& PreparedSegment::direction() const {
+		return direction_;
 	}
 
-	long Stopwatch::elapsedSeconds() {
-		stop();
-		return std::chrono::duration_cast<std::chrono::seconds>(end_ - start_).count();
+	const vec_t& PreparedSegment::inverseDirection() const {
+		return inverseDirection_;
 	}
 
-	long Stopwatch::elapsedMilliseconds() {
-		stop();
-		return std::chrono::duration_cast<std::chrono::milliseconds>(end_ - start_).count();
+	float PreparedSegment::length() const {
+		return length_;
 	}
 
-	long Stopwatch::elapsedMicroseconds() {
-		stop();
-		return std::chrono::duration_cast<std::chrono::microseconds>(end_ - start_).count();
+	float PreparedSegment::inverseLengthSquared() const {
+		return inverseLengthSquared_;
 	}
 
-	long Stopwatch::elapsedNanoseconds() {
-		stop();
-		return std::chrono::duration_cast<std::chrono::nanoseconds>(end_ - start_).count();
+	const Bounds& PreparedSegment::bounds() const {
+		return bounds_;
 	}
 
-	Stopwatch::time_point Stopwatch::now() const {
-		return std::chrono::system_clock::now();
+	LineSegment PreparedSegment::segment() const {
+		return LineSegment(start_, end_);
 	}
 }
 
-#include <random>
-#include <chrono>
+#include <algorithm>
+#include <stdexcept>
 
 namespace ch {
-	namespace rand {
 
-		/**
-		 * \brief Returns a reference to a static instance of the random engine.
-		 */
-		std::default_random_engine& get_random_engine() {
-			static std::default_random_engine rng{ static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()) };
-			return rng;
+	ConvexPolygon::ConvexPolygon(const std::vector<vec_t>& vertices) : vertices_(), normals_(), count_(vertices.size()), bounds_() {
+		if (count_ < 3 || count_ > MAX_VERTICES) {
+			throw std::invalid_argument("Invalid argument : a ConvexPolygon must have between 3 and MAX_VERTICES vertices");
 		}
 
-		int rand_int(int lowerInc, int upperInc) {
-			std::uniform_int_distribution<int> distribution(lowerInc, upperInc);
-			return distribution(get_random_engine());
+		// Every vertex must be on the inner side of every edge : the polygon turns once, in the direction of its area
+		float area = 0.f;
+		for (size_t i = 0; i < count_; ++i) {
+			area += vec_cross_product(vertices[i], vertices[(i + 1) % count_]);
 		}
-
-		float rand_float(float min, float max) {
-			std::uniform_real_distribution<float> distribution(min, max);
-			return distribution(get_random_engine());
+		if (area == 0.f) {
+			throw std::invalid_argument("Invalid argument : the vertices of a ConvexPolygon must form a convex polygon");
 		}
-
-		bool rand_bit() {
-			return rand_int(0, 1) == 0;
+		for (size_t i = 0; i < count_; ++i) {
+			const vec_t edge = vertices[(i + 1) % count_] - vertices[i];
+			if (edge == NULL_VEC) {
+				throw std::invalid_argument("Invalid argument : two consecutive vertices of a ConvexPolygon can't be equal");
+			}
+			for (size_t j = 0; j < count_; ++j) {
+				if (vec_cross_product(edge, vertices[j] - vertices[i]) * area < 0.f) {
+					throw std::invalid_argument("Invalid argument : the vertices of a ConvexPolygon must form a convex polygon");
+				}
+			}
 		}
 
-		bool rand_bit(float probability) {
-			return rand_float(0.f, 1.f) <= probability;
+		// The vertices are stored in the order that makes the area positive
+		for (size_t i = 0; i < count_; ++i) {
+			vertices_[i] = area > 0.f ? vertices[i] : vertices[count_ - 1 - i];
 		}
+		update();
+	}
 
-		float rnd_normal_float() {
-			return rand_float(-1.f, 1.f);
-		}
+	ConvexPolygon::ConvexPolygon(const AABB& aabb) : ConvexPolygon(std::vector<vec_t>{
+		aabb.corner(Corner::TopLeft),
+		aabb.corner(Corner::TopRight),
+		aabb.corner(Corner::BottomRight),
+		aabb.corner(Corner::BottomLeft) }) {}
 
-		float rnd_angle_deg() {
-			return rand_float(0.f, 360.f);
+	void ConvexPolygon::move(const vec_t& movement) {
+		for (size_t i = 0; i < count_; ++i) {
+			vertices_[i] += movement;
 		}
+		bounds_.move(movement);
+	}
 
-		float rnd_angle_rad() {
-			static constexpr float PI_2 = 2.f * 3.1415926f;
-			return rand_float(0.f, PI_2);
+	void ConvexPolygon::rotate(float angle) {
+		const vec_t pivot = center();
+		for (size_t i = 0; i < count_; ++i) {
+			vertices_[i] = pivot + vec_rotate(vertices_[i] - pivot, angle);
 		}
+		update();
+	}
 
-		vec_t rand_vector(float minX, float maxX, float minY, float maxY) {
-			return vec_t(rand_float(minX, maxX), rand_float(minY, maxY));
-		}
+	const vec_t& ConvexPolygon::vertex(size_t index) const {
+		return vertices_[index];
+	}
 
-		vec_t rand_unit_vector() {
-			float randomRadianAngle = rnd_angle_rad();
-			return vec_t(std::cosf(randomRadianAngle), std::sinf(randomRadianAngle));
-		}
+	const vec_t& ConvexPolygon::normal(size_t index) const {
+		return normals_[index];
+	}
 
-		vec_t rand_point_on_rect(vec_t topLeftCorner, vec_t size) {
-			auto bottomRightCorner = topLeftCorner + size;
-			return rand_vector(topLeftCorner.x, topLeftCorner.y, bottomRightCorner.x, bottomRightCorner.y);
-		}
+	size_t ConvexPolygon::size() const {
+		return count_;
+	}
 
-		vec_t rand_point_on_rect(vec_t center, float width, float height) {
-			return center + vec_t(rnd_normal_float() * (width / 2.f), rnd_normal_float() * (height / 2.f));
+	vec_t ConvexPolygon::center() const {
+		vec_t sum(0.f, 0.f);
+		for (size_t i = 0; i < count_; ++i) {
+			sum += vertices_[i];
 		}
+		return sum / static_cast<float>(count_);
+	}
 
-		vec_t rand_point_on_circle(float circleRadius, vec_t circleCenter) {
-			return circleCenter + rand_unit_vector() * rand_float(0.f, circleRadius);
-		}
+	const Bounds& ConvexPolygon::bounds() const {
+		return bounds_;
+	}
 
-		vec_t rand_point_on_torus(float innerRadius, float outerRadius, vec_t torusCenter) {
-			return torusCenter + rand_unit_vector() * rand_float(innerRadius, outerRadius);
+	AABB ConvexPolygon::aabb() const {
+		return bounds_.toAABB();
+	}
+
+	void ConvexPolygon::update() {
+		bounds_ = Bounds(vertices_[0], vertices_[0]);
+		for (size_t i = 0; i < count_; ++i) {
+			const vec_t& current = vertices_[i];
+			const vec_t edge = vertices_[(i + 1) % count_] - current;
+			normals_[i] = vec_normalize(vec_t(edge.y, -edge.x));
+			bounds_.min = vec_t(std::min(bounds_.min.x, current.x), std::min(bounds_.min.y, current.y));
+			bounds_.max = vec_t(std::max(bounds_.max.x, current.x), std::max(bounds_.max.y, current.y));
 		}
 	}
 }
 
+#include <cmath>
+
 namespace ch {
-	namespace collision {
-		Circle enclosingCircle(const AABB& aabb) {
-			return Circle(aabb.center(), aabb.diagonalLength() / 2.f);
-		}
 
-		Circle inscribedCircle(const AABB& aabb) {
-			return Circle(aabb.center(), std::min(aabb.size.x, aabb.size.y) / 2.f);
-		}
+	OBB::OBB(const vec_t& center, const vec_t& halfSize, float angle) : center_(center), halfSize_(halfSize), angle_(0.f), axisX_(RIGHT_VEC), axisY_(DOWN_VEC) {
+		setAngle(angle);
+	}
 
-		AABB enclosingAABB(const Circle& circle) {
-			return AABB(circle.pos.x - circle.radius, circle.pos.y - circle.radius, circle.radius * 2, circle.radius * 2);
-		}
+	OBB::OBB(const AABB& aabb) : OBB(aabb.center(), aabb.size / 2.f) {}
 
-		AABB enclosingAABB(const LineSegment& lineSegment) {
-			return AABB({ lineSegment.minX(), lineSegment.minY() }, lineSegment.absoluteSize());
-		}
+	void OBB::move(const vec_t& movement) {
+		center_ += movement;
+	}
 
-		AABB inscribedAABB(const Circle& circle) {
-			float halfSide = sqrtf(circle.radius * circle.radius / 2.f);
-			auto halfSize = vec_t(halfSide, halfSide);
-			return AABB(circle.pos - halfSize, halfSize * 2.f);
-		}
+	void OBB::setCenter(const vec_t& center) {
+		center_ = center;
+	}
 
-		bool aabb_contains(const AABB& aabb, const vec_t& point) {
-			return
-				point.x >= aabb.pos.x &&
-				point.y >= aabb.pos.y &&
-				point.x <= aabb.pos.x + aabb.size.x &&
-				point.y <= aabb.pos.y + aabb.size.y;
-		}
+	void OBB::setAngle(float angle) {
+		angle_ = angle;
+		float radians = angle * FLT_PI / 180.f;
+		float cosine = std::cos(radians);
+		float sine = std::sin(radians);
+		axisX_ = vec_t(cosine, sine);
+		axisY_ = vec_t(-sine, cosine);
+	}
 
-		bool aabb_contains(const AABB& first, const AABB& other) {
-			if (first.area() >= other.area()) {
-				AABB zone = first;
-				zone.size -= other.size;
+	void OBB::rotate(float angle) {
+		setAngle(angle_ + angle);
+	}
 
-				return aabb_contains(zone, other.pos);
-			}
-			return false;
-		}
+	const vec_t& OBB::center() const {
+		return center_;
+	}
 
-		bool aabb_contains(const AABB& aabb, const Circle& circle) {
-			return aabb_contains(aabb, enclosingAABB(circle));
-		}
+	const vec_t& OBB::halfSize() const {
+		return halfSize_;
+	}
 
-		bool circle_contains(const Circle& circle, const vec_t& point) {
-			return vec_magnitude_squared(circle.pos - point) < circle.radius * circle.radius;
-		}
+	float OBB::angle() const {
+		return angle_;
+	}
 
-		bool circle_contains(const Circle& first, const Circle& other) {
-			if (other.radius <= first.radius) {
-				return vec_magnitude_squared(first.pos - other.pos) <= (first.radius - other.radius) * (first.radius - other.radius);
-			}
-			return false;
-		}
+	const vec_t& OBB::axisX() const {
+		return axisX_;
+	}
 
-		bool circle_contains(const Circle& circle, const AABB& aabb) {
-			return
-				circle_contains(circle, aabb.corner(ch::Corner::TopLeft)) &&
-				circle_contains(circle, aabb.corner(ch::Corner::TopRight)) &&
-				circle_contains(circle, aabb.corner(ch::Corner::BottomLeft)) &&
-				circle_contains(circle, aabb.corner(ch::Corner::BottomRight));
-		}
+	const vec_t& OBB::axisY() const {
+		return axisY_;
+	}
 
-		bool aabb_intersects(const AABB& a, const AABB& b) {
-			AABB extended = b;
+	std::array<vec_t, static_cast<size_t>(Corner::MAX_VALUE)> OBB::corners() const {
+		return {
+			toWorld(vec_t(-halfSize_.x, -halfSize_.y)),
+			toWorld(vec_t(halfSize_.x, -halfSize_.y)),
+			toWorld(vec_t(-halfSize_.x, halfSize_.y)),
+			toWorld(vec_t(halfSize_.x, halfSize_.y))
+		};
+	}
 
-			extended.size += a.size;
-			extended.pos -= a.size;
+	Bounds OBB::bounds() const {
+		vec_t extent(
+			halfSize_.x * std::abs(axisX_.x) + halfSize_.y * std::abs(axisY_.x),
+			halfSize_.x * std::abs(axisX_.y) + halfSize_.y * std::abs(axisY_.y));
+		return Bounds(center_ - extent, center_ + extent);
+	}
 
-			return aabb_contains(extended, a.pos);
-		}
+	AABB OBB::aabb() const {
+		return bounds().toAABB();
+	}
 
-		bool aabb_intersects(const AABB& aabb, const Circle& circle) {
-			// First check : are the circle and the box close enough to be colliding ?
-			if (!aabb_intersects(aabb, enclosingAABB(circle))) {
-				return false;
-			}
+	vec_t OBB::toLocal(const vec_t& point) const {
+		vec_t delta = point - center_;
+		return vec_t(vec_dot_product(delta, axisX_), vec_dot_product(delta, axisY_));
+	}
 
-			// Second check : does the circle contain any of the box corners ?
-			if (circle_contains(circle, aabb.corner(ch::Corner::TopLeft)) ||
-				circle_contains(circle, aabb.corner(ch::Corner::TopRight)) ||
-				circle_contains(circle, aabb.corner(ch::Corner::BottomLeft)) ||
-				circle_contains(circle, aabb.corner(ch::Corner::BottomRight)))
-					return true;
+	vec_t OBB::toWorld(const vec_t& point) const {
+		return center_ + axisX_ * point.x + axisY_ * point.y;
+	}
+}
 
-			// Last check : does the aabb contain any of the extremums of the circle ?
-			if (aabb_contains(aabb, circle.pos + LEFT_VEC * circle.radius) ||
-				aabb_contains(aabb, circle.pos + RIGHT_VEC * circle.radius) ||
-				aabb_contains(aabb, circle.pos + UP_VEC * circle.radius) ||
-				aabb_contains(aabb, circle.pos + DOWN_VEC * circle.radius))
-					return true;
+namespace ch {
 
-			return false;
-		}
+	Capsule::Capsule() : segment(), radius(0.f) {}
 
-		bool circle_intersects(const Circle& circle, const Circle& other) {
-			return vec_magnitude_squared(circle.pos - other.pos) < (circle.radius + other.radius) * (circle.radius + other.radius);
-		}
+	Capsule::Capsule(const LineSegment& segment_, float radius_) : segment(segment_), radius(radius_) {}
 
-		bool circle_intersects(const Circle& circle, const AABB& aabb) {
-			return aabb_intersects(aabb, circle);
-		}
+	Capsule::Capsule(const vec_t& start, const vec_t& end, float radius_) : segment(start, end), radius(radius_) {}
 
-		float circles_distance(const Circle& a, const Circle& b) {
-			return vec_magnitude(a.pos - b.pos) - a.radius - b.radius;
-		}
-		
-		AABBCollision aabb_collision_info(const AABB& first, const AABB& other) {
-			if (!aabb_intersects(first, other)) {
-				return AABBCollision{ NULL_VEC, NULL_VEC };
-			}
+	void Capsule::move(const vec_t& movement) {
+		segment.start += movement;
+		segment.end += movement;
+	}
 
-			auto currentCorners = first.corners();
-			auto otherCorners = other.corners();
+	vec_t Capsule::center() const {
+		return (segment.start + segment.end) / 2.f;
+	}
+
+	Bounds Capsule::bounds() const {
+		return Bounds(
+			segment.minX() - radius,
+			segment.minY() - radius,
+			segment.maxX() + radius,
+			segment.maxY() + radius);
+	}
+
+	AABB Capsule::aabb() const {
+		return bounds().toAABB();
+	}
+
+	bool operator==(const Capsule& left, const Capsule& right) {
+		return left.radius == right.radius && left.segment == right.segment;
+	}
+
+	bool operator!=(const Capsule& left, const Capsule& right) {
+		return !(left == right);
+	}
+}
+
+namespace ch {
+
+	static vec_t support_shape_aabb(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const AABB*>(shape), direction);
+	}
+
+	static vec_t support_shape_bounds(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const Bounds*>(shape), direction);
+	}
+
+	static vec_t support_shape_circle(const void* shape, const vec_t& /*direction*/) {
+		return static_cast<const Circle*>(shape)->pos;
+	}
+
+	static vec_t support_shape_segment(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const LineSegment*>(shape), direction);
+	}
+
+	static vec_t support_shape_polygon(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const ConvexPolygon*>(shape), direction);
+	}
+
+	static vec_t support_shape_obb(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const OBB*>(shape), direction);
+	}
+
+	static vec_t support_shape_capsule(const void* shape, const vec_t& direction) {
+		return collision::support_point(static_cast<const Capsule*>(shape)->segment, direction);
+	}
+
+	SupportShape::SupportShape(const AABB& aabb) : SupportShape(&aabb, support_shape_aabb) {}
+
+	SupportShape::SupportShape(const Bounds& bounds) : SupportShape(&bounds, support_shape_bounds) {}
+
+	SupportShape::SupportShape(const Circle& circle) : SupportShape(&circle, support_shape_circle, circle.radius) {}
+
+	SupportShape::SupportShape(const LineSegment& segment) : SupportShape(&segment, support_shape_segment) {}
+
+	SupportShape::SupportShape(const ConvexPolygon& polygon) : SupportShape(&polygon, support_shape_polygon) {}
+
+	SupportShape::SupportShape(const OBB& obb) : SupportShape(&obb, support_shape_obb) {}
+
+	SupportShape::SupportShape(const Capsule& capsule) : SupportShape(&capsule, support_shape_capsule, capsule.radius) {}
+
+	SupportShape::SupportShape(const void* shape, SupportMapping mapping, float radius) : shape_(shape), mapping_(mapping), radius_(radius) {}
+
+	vec_t SupportShape::support(const vec_t& direction) const {
+		return mapping_(shape_, direction);
+	}
+
+	float SupportShape::radius() const {
+		return radius_;
+	}
+}
+
+namespace ch {
+
+	AABBBatch::AABBBatch() : minX(), minY(), maxX(), maxY() {}
+
+	AABBBatch::AABBBatch(const std::vector<AABB>& aabbs) : AABBBatch() {
+		reserve(aabbs.size());
+		for (const auto& aabb : aabbs) {
+			push_back(aabb);
+		}
+	}
+
+	void AABBBatch::push_back(const AABB& aabb) {
+		minX.push_back(aabb.pos.x);
+		minY.push_back(aabb.pos.y);
+		maxX.push_back(aabb.pos.x + aabb.size.x);
+		maxY.push_back(aabb.pos.y + aabb.size.y);
+	}
+
+	void AABBBatch::push_back(const Bounds& bounds) {
+		minX.push_back(bounds.min.x);
+		minY.push_back(bounds.min.y);
+		maxX.push_back(bounds.max.x);
+		maxY.push_back(bounds.max.y);
+	}
+
+	void AABBBatch::set(size_t index, const AABB& aabb) {
+		minX[index] = aabb.pos.x;
+		minY[index] = aabb.pos.y;
+		maxX[index] = aabb.pos.x + aabb.size.x;
+		maxY[index] = aabb.pos.y + aabb.size.y;
+	}
+
+	void AABBBatch::set(size_t index, const Bounds& bounds) {
+		minX[index] = bounds.min.x;
+		minY[index] = bounds.min.y;
+		maxX[index] = bounds.max.x;
+		maxY[index] = bounds.max.y;
+	}
+
+	AABB AABBBatch::at(size_t index) const {
+		return AABB(minX[index], minY[index], maxX[index] - minX[index], maxY[index] - minY[index]);
+	}
+
+	Bounds AABBBatch::bounds(size_t index) const {
+		return Bounds(minX[index], minY[index], maxX[index], maxY[index]);
+	}
+
+	void AABBBatch::reserve(size_t capacity) {
+		minX.reserve(capacity);
+		minY.reserve(capacity);
+		maxX.reserve(capacity);
+		maxY.reserve(capacity);
+	}
+
+	void AABBBatch::clear() {
+		minX.clear();
+		minY.clear();
+		maxX.clear();
+		maxY.clear();
+	}
+
+	size_t AABBBatch::size() const {
+		return minX.size();
+	}
+
+	bool AABBBatch::empty() const {
+		return minX.empty();
+	}
+}
+
+namespace ch {
+
+	CircleBatch::CircleBatch() : x(), y(), radius() {}
+
+	CircleBatch::CircleBatch(const std::vector<Circle>& circles) : CircleBatch() {
+		reserve(circles.size());
+		for (const auto& circle : circles) {
+			push_back(circle);
+		}
+	}
+
+	void CircleBatch::push_back(const Circle& circle) {
+		x.push_back(circle.pos.x);
+		y.push_back(circle.pos.y);
+		radius.push_back(circle.radius);
+	}
+
+	void CircleBatch::set(size_t index, const Circle& circle) {
+		x[index] = circle.pos.x;
+		y[index] = circle.pos.y;
+		radius[index] = circle.radius;
+	}
+
+	Circle CircleBatch::at(size_t index) const {
+		return Circle({ x[index], y[index] }, radius[index]);
+	}
+
+	void CircleBatch::reserve(size_t capacity) {
+		x.reserve(capacity);
+		y.reserve(capacity);
+		radius.reserve(capacity);
+	}
+
+	void CircleBatch::clear() {
+		x.clear();
+		y.clear();
+		radius.clear();
+	}
+
+	size_t CircleBatch::size() const {
+		return x.size();
+	}
+
+	bool CircleBatch::empty() const {
+		return x.empty();
+	}
+}
+
+namespace ch {
+
+	LineSegmentBatch::LineSegmentBatch() : startX(), startY(), endX(), endY() {}
+
+	LineSegmentBatch::LineSegmentBatch(const std::vector<LineSegment>& segments) : LineSegmentBatch() {
+		reserve(segments.size());
+		for (const auto& segment : segments) {
+			push_back(segment);
+		}
+	}
+
+	void LineSegmentBatch::push_back(const LineSegment& segment) {
+		startX.push_back(segment.start.x);
+		startY.push_back(segment.start.y);
+		endX.push_back(segment.end.x);
+		endY.push_back(segment.end.y);
+	}
+
+	void LineSegmentBatch::set(size_t index, const LineSegment& segment) {
+		startX[index] = segment.start.x;
+		startY[index] = segment.start.y;
+		endX[index] = segment.end.x;
+		endY[index] = segment.end.y;
+	}
+
+	LineSegment LineSegmentBatch::at(size_t index) const {
+		return LineSegment({ startX[index], startY[index] }, { endX[index], endY[index] });
+	}
+
+	void LineSegmentBatch::reserve(size_t capacity) {
+		startX.reserve(capacity);
+		startY.reserve(capacity);
+		endX.reserve(capacity);
+		endY.reserve(capacity);
+	}
+
+	void LineSegmentBatch::clear() {
+		startX.clear();
+		startY.clear();
+		endX.clear();
+		endY.clear();
+	}
+
+	size_t LineSegmentBatch::size() const {
+		return startX.size();
+	}
+
+	bool LineSegmentBatch::empty() const {
+		return startX.empty();
+	}
+}
+
+#include <cmath>
+
+namespace ch {
+
+	OBBBatch::OBBBatch() : centerX(), centerY(), halfWidth(), halfHeight(), cosine(), sine() {}
+
+	OBBBatch::OBBBatch(const std::vector<OBB>& obbs) : OBBBatch() {
+		reserve(obbs.size());
+		for (const auto& obb : obbs) {
+			push_back(obb);
+		}
+	}
+
+	void OBBBatch::push_back(const OBB& obb) {
+		centerX.push_back(obb.center().x);
+		centerY.push_back(obb.center().y);
+		halfWidth.push_back(obb.halfSize().x);
+		halfHeight.push_back(obb.halfSize().y);
+		cosine.push_back(obb.axisX().x);
+		sine.push_back(obb.axisX().y);
+	}
+
+	void OBBBatch::set(size_t index, const OBB& obb) {
+		centerX[index] = obb.center().x;
+		centerY[index] = obb.center().y;
+		halfWidth[index] = obb.halfSize().x;
+		halfHeight[index] = obb.halfSize().y;
+		cosine[index] = obb.axisX().x;
+		sine[index] = obb.axisX().y;
+	}
+
+	OBB OBBBatch::at(size_t index) const {
+		float angle = std::atan2(sine[index], cosine[index]) * 180.f / FLT_PI;
+		return OBB({ centerX[index], centerY[index] }, { halfWidth[index], halfHeight[index] }, angle);
+	}
+
+	void OBBBatch::reserve(size_t capacity) {
+		centerX.reserve(capacity);
+		centerY.reserve(capacity);
+		halfWidth.reserve(capacity);
+		halfHeight.reserve(capacity);
+		cosine.reserve(capacity);
+		sine.reserve(capacity);
+	}
+
+	void OBBBatch::clear() {
+		centerX.clear();
+		centerY.clear();
+		halfWidth.clear();
+		halfHeight.clear();
+		cosine.clear();
+		sine.clear();
+	}
+
+	size_t OBBBatch::size() const {
+		return centerX.size();
+	}
+
+	bool OBBBatch::empty() const {
+		return centerX.empty();
+	}
+}
+
+namespace ch {
+
+	Stopwatch::Stopwatch() {
+		start();
+	}
+
+	void Stopwatch::start() {
+		start_ = now();
+	}
+
+	void Stopwatch::reset() {
+		start();
+	}
+
+	void Stopwatch::stop() {
+		end_ = now();
+	}
+
+	long Stopwatch::elapsedSeconds() {
+		stop();
+		return std::chrono::duration_cast<std::chrono::seconds>(end_ - start_).count();
+	}
+
+	long Stopwatch::elapsedMilliseconds() {
+		stop();
+		return std::chrono::duration_cast<std::chrono::milliseconds>(end_ - start_).count();
+	}
+
+	long Stopwatch::elapsedMicroseconds() {
+		stop();
+		return std::chrono::duration_cast<std::chrono::microseconds>(end_ - start_).count();
+	}
+
+	long Stopwatch::elapsedNanoseconds() {
+		stop();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(end_ - start_).count();
+	}
+
+	Stopwatch::time_point Stopwatch::now() const {
+		return std::chrono::system_clock::now();
+	}
+}
+
+#include <random>
+#include <chrono>
+
+namespace ch {
+	namespace rand {
+
+		/**
+		 * \brief Returns a reference to a static instance of the random engine.
+		 */
+		std::default_random_engine& get_random_engine() {
+			static std::default_random_engine rng{ static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()) };
+			return rng;
+		}
+
+		int rand_int(int lowerInc, int upperInc) {
+			std::uniform_int_distribution<int> distribution(lowerInc, upperInc);
+			return distribution(get_random_engine());
+		}
+
+		float rand_float(float min, float max) {
+			std::uniform_real_distribution<float> distribution(min, max);
+			return distribution(get_random_engine());
+		}
+
+		bool rand_bit() {
+			return rand_int(0, 1) == 0;
+		}
+
+		bool rand_bit(float probability) {
+			return rand_float(0.f, 1.f) <= probability;
+		}
+
+		float rnd_normal_float() {
+			return rand_float(-1.f, 1.f);
+		}
+
+		float rnd_angle_deg() {
+			return rand_float(0.f, 360.f);
+		}
+
+		float rnd_angle_rad() {
+			static constexpr float PI_2 = 2.f * 3.1415926f;
+			return rand_float(0.f, PI_2);
+		}
+
+		vec_t rand_vector(float minX, float maxX, float minY, float maxY) {
+			return vec_t(rand_float(minX, maxX), rand_float(minY, maxY));
+		}
+
+		vec_t rand_unit_vector() {
+			float randomRadianAngle = rnd_angle_rad();
+			return vec_t(std::cosf(randomRadianAngle), std::sinf(randomRadianAngle));
+		}
+
+		vec_t rand_point_on_rect(vec_t topLeftCorner, vec_t size) {
+			auto bottomRightCorner = topLeftCorner + size;
+			return rand_vector(topLeftCorner.x, topLeftCorner.y, bottomRightCorner.x, bottomRightCorner.y);
+		}
+
+		vec_t rand_point_on_rect(vec_t center, float width, float height) {
+			return center + vec_t(rnd_normal_float() * (width / 2.f), rnd_normal_float() * (height / 2.f));
+		}
+
+		vec_t rand_point_on_circle(float circleRadius, vec_t circleCenter) {
+			return circleCenter + rand_unit_vector() * rand_float(0.f, circleRadius);
+		}
+
+		vec_t rand_point_on_torus(float innerRadius, float outerRadius, vec_t torusCenter) {
+			return torusCenter + rand_unit_vector() * rand_float(innerRadius, outerRadius);
+		}
+	}
+}
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#if defined(CH_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(CH_SIMD_X86)
+#include <cpuid.h>
+#endif
+
+namespace ch {
+	namespace simd {
+
+		constexpr const char* SIMD_ENVIRONMENT_VARIABLE = "CHARBRARY_SIMD";
+
+		constexpr std::array<const char*, static_cast<size_t>(SimdLevel::MAX_VALUE)> SIMD_LEVEL_NAMES =
+		{
+			"scalar",
+			"sse2",
+			"avx2",
+			"avx512"
+		};
+
+#ifdef CH_SIMD_X86
+		/**
+		 * \brief Executes the CPUID instruction for the given leaf (and sub-leaf 0).
+		 */
+		static std::array<unsigned int, 4> cpuid(unsigned int leaf) {
+			std::array<unsigned int, 4> registers = { 0, 0, 0, 0 };
+#ifdef _MSC_VER
+			int values[4];
+			__cpuidex(values, static_cast<int>(leaf), 0);
+			for (size_t i = 0; i < registers.size(); ++i) {
+				registers[i] = static_cast<unsigned int>(values[i]);
+			}
+#else
+			if (leaf > __get_cpuid_max(0, nullptr)) {
+				return registers;
+			}
+			__cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+#endif
+			return registers;
+		}
+
+		/**
+		 * \brief Reads the XCR0 register, which tells which vector registers are saved by the operating system.
+		 */
+		static unsigned long long read_xcr0() {
+#ifdef _MSC_VER
+			return _xgetbv(0);
+#else
+			unsigned int eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+		}
+
+		static SimdLevel query_cpu_simd_level() {
+			constexpr unsigned int SSE2_BIT = 1u << 26; // leaf 1, EDX
+			constexpr unsigned int OSXSAVE_BIT = 1u << 27; // leaf 1, ECX
+			constexpr unsigned int AVX_BIT = 1u << 28; // leaf 1, ECX
+			constexpr unsigned int AVX2_BIT = 1u << 5; // leaf 7, EBX
+			constexpr unsigned int AVX512F_BIT = 1u << 16; // leaf 7, EBX
+			constexpr unsigned long long XCR0_AVX_STATE = 0x6; // XMM + YMM
+			constexpr unsigned long long XCR0_AVX512_STATE = 0xE6; // XMM + YMM + opmask + ZMM
+
+			auto leaf1 = cpuid(1);
+			if (!(leaf1[3] & SSE2_BIT)) {
+				return SimdLevel::Scalar;
+			}
+
+			if (!(leaf1[2] & OSXSAVE_BIT) || !(leaf1[2] & AVX_BIT)) {
+				return SimdLevel::SSE2;
+			}
+
+			unsigned long long xcr0 = read_xcr0();
+			if ((xcr0 & XCR0_AVX_STATE) != XCR0_AVX_STATE) {
+				return SimdLevel::SSE2;
+			}
+
+			auto leaf7 = cpuid(7);
+			if (!(leaf7[1] & AVX2_BIT)) {
+				return SimdLevel::SSE2;
+			}
+
+			if ((leaf7[1] & AVX512F_BIT) && (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE) {
+				return SimdLevel::AVX512;
+			}
+
+			return SimdLevel::AVX2;
+		}
+#else
+		static SimdLevel query_cpu_simd_level() {
+			return SimdLevel::Scalar;
+		}
+#endif
+
+		/**
+		 * \brief Reads the CHARBRARY_SIMD environment variable. Returns an empty string if it is not set.
+		 */
+		static std::string read_simd_environment_variable() {
+#ifdef _MSC_VER
+			char* buffer = nullptr;
+			size_t length = 0;
+			std::string value;
+			if (_dupenv_s(&buffer, &length, SIMD_ENVIRONMENT_VARIABLE) == 0 && buffer != nullptr) {
+				value = buffer;
+			}
+			std::free(buffer);
+			return value;
+#else
+			const char* value = std::getenv(SIMD_ENVIRONMENT_VARIABLE);
+			return value != nullptr ? value : "";
+#endif
+		}
+
+		static SimdLevel startup_simd_level() {
+			std::string requested = read_simd_environment_variable();
+			for (size_t i = 0; i < SIMD_LEVEL_NAMES.size(); ++i) {
+				if (requested == SIMD_LEVEL_NAMES[i]) {
+					auto level = static_cast<SimdLevel>(i);
+					return level < detected_simd_level() ? level : detected_simd_level();
+				}
+			}
+			return detected_simd_level();
+		}
+
+		/**
+		 * \brief Returns a reference to the tier currently used by the kernels.
+		 */
+		static std::atomic<SimdLevel>& current_simd_level() {
+			static std::atomic<SimdLevel> level{ startup_simd_level() };
+			return level;
+		}
+
+		SimdLevel detected_simd_level() {
+			static const SimdLevel level = query_cpu_simd_level();
+			return level;
+		}
+
+		SimdLevel active_simd_level() {
+			return current_simd_level().load(std::memory_order_relaxed);
+		}
+
+		SimdLevel set_simd_level(SimdLevel level) {
+			if (level > detected_simd_level()) {
+				level = detected_simd_level();
+			}
+			current_simd_level().store(level, std::memory_order_relaxed);
+			return level;
+		}
+
+		const char* simd_level_name(SimdLevel level) {
+			return level < SimdLevel::MAX_VALUE ? SIMD_LEVEL_NAMES[static_cast<size_t>(level)] : "unknown";
+		}
+	}
+}
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace ch {
+
+	unsigned int default_thread_count() {
+		unsigned int threads = std::thread::hardware_concurrency();
+		return threads > 0 ? threads : 1;
+	}
+
+	size_t parallel_for(size_t count, const std::function<void(size_t begin, size_t end, size_t chunk)>& task, unsigned int threadCount, size_t minChunkSize) {
+		if (count == 0) {
+			return 0;
+		}
+
+		if (threadCount == 0) {
+			threadCount = default_thread_count();
+		}
+
+		minChunkSize = std::max<size_t>(minChunkSize, 1);
+		size_t chunks = std::min<size_t>(threadCount, (count + minChunkSize - 1) / minChunkSize);
+		chunks = std::max<size_t>(chunks, 1);
+		size_t chunkSize = (count + chunks - 1) / chunks;
+		chunks = (count + chunkSize - 1) / chunkSize;
+
+		std::vector<std::thread> workers;
+		workers.reserve(chunks - 1);
+		for (size_t chunk = 1; chunk < chunks; ++chunk) {
+			size_t begin = chunk * chunkSize;
+			size_t end = std::min(count, begin + chunkSize);
+			workers.emplace_back(task, begin, end, chunk);
+		}
+
+		task(0, std::min(count, chunkSize), 0);
+
+		for (auto& worker : workers) {
+			worker.join();
+		}
+
+		return chunks;
+	}
+}
+
+#include <algorithm>
+#include <limits>
+
+namespace ch {
+	namespace collision {
+		Circle enclosingCircle(const AABB& aabb) {
+			return Circle(aabb.center(), aabb.diagonalLength() / 2.f);
+		}
+
+		Circle inscribedCircle(const AABB& aabb) {
+			return Circle(aabb.center(), std::min(aabb.size.x, aabb.size.y) / 2.f);
+		}
+
+		AABB enclosingAABB(const Circle& circle) {
+			return AABB(circle.pos.x - circle.radius, circle.pos.y - circle.radius, circle.radius * 2, circle.radius * 2);
+		}
+
+		AABB enclosingAABB(const LineSegment& lineSegment) {
+			return AABB({ lineSegment.minX(), lineSegment.minY() }, lineSegment.absoluteSize());
+		}
+
+		AABB inscribedAABB(const Circle& circle) {
+			float halfSide = sqrtf(circle.radius * circle.radius / 2.f);
+			auto halfSize = vec_t(halfSide, halfSide);
+			return AABB(circle.pos - halfSize, halfSize * 2.f);
+		}
+
+		Bounds enclosingBounds(const Circle& circle) {
+			return Bounds(circle.pos.x - circle.radius, circle.pos.y - circle.radius, circle.pos.x + circle.radius, circle.pos.y + circle.radius);
+		}
+
+		Bounds enclosingBounds(const LineSegment& lineSegment) {
+			return Bounds(lineSegment.minX(), lineSegment.minY(), lineSegment.maxX(), lineSegment.maxY());
+		}
+
+		bool aabb_contains(const AABB& aabb, const vec_t& point) {
+			return aabb_contains(Bounds(aabb), point);
+		}
+
+		bool aabb_contains(const Bounds& bounds, const vec_t& point) {
+			return
+				point.x >= bounds.min.x &&
+				point.y >= bounds.min.y &&
+				point.x <= bounds.max.x &&
+				point.y <= bounds.max.y;
+		}
+
+		bool aabb_contains(const AABB& first, const AABB& other) {
+			return aabb_contains(Bounds(first), Bounds(other));
+		}
+
+		bool aabb_contains(const Bounds& first, const Bounds& other) {
+			return
+				other.min.x >= first.min.x &&
+				other.min.y >= first.min.y &&
+				other.max.x <= first.max.x &&
+				other.max.y <= first.max.y;
+		}
+
+		bool aabb_contains(const AABB& aabb, const Circle& circle) {
+			return aabb_contains(Bounds(aabb), enclosingBounds(circle));
+		}
+
+		bool aabb_contains(const Bounds& bounds, const Circle& circle) {
+			return aabb_contains(bounds, enclosingBounds(circle));
+		}
+
+		bool circle_contains(const Circle& circle, const vec_t& point) {
+			return vec_magnitude_squared(circle.pos - point) < circle.radius * circle.radius;
+		}
+
+		bool circle_contains(const Circle& first, const Circle& other) {
+			if (other.radius <= first.radius) {
+				return vec_magnitude_squared(first.pos - other.pos) <= (first.radius - other.radius) * (first.radius - other.radius);
+			}
+			return false;
+		}
+
+		bool circle_contains(const Circle& circle, const AABB& aabb) {
+			return circle_contains(circle, Bounds(aabb));
+		}
+
+		bool circle_contains(const Circle& circle, const Bounds& bounds) {
+			return
+				circle_contains(circle, bounds.min) &&
+				circle_contains(circle, vec_t(bounds.max.x, bounds.min.y)) &&
+				circle_contains(circle, vec_t(bounds.min.x, bounds.max.y)) &&
+				circle_contains(circle, bounds.max);
+		}
+
+		bool aabb_intersects(const AABB& a, const AABB& b) {
+			return aabb_intersects(Bounds(a), Bounds(b));
+		}
+
+		bool aabb_intersects(const Bounds& a, const Bounds& b) {
+			return
+				a.max.x >= b.min.x &&
+				a.max.y >= b.min.y &&
+				a.min.x <= b.max.x &&
+				a.min.y <= b.max.y;
+		}
+
+		bool aabb_intersects(const AABB& aabb, const Circle& circle) {
+			return aabb_intersects(Bounds(aabb), circle);
+		}
+
+		bool aabb_intersects(const Bounds& bounds, const Circle& circle) {
+			vec_t delta = circle.pos - closest_point_on_aabb(bounds, circle.pos);
+			return vec_magnitude_squared(delta) < circle.radius * circle.radius;
+		}
+
+		bool aabb_intersects(const AABB& aabb, const LineSegment& segment) {
+			return line_segment_aabb_clip(segment, Bounds(aabb)).intersects;
+		}
+
+		bool aabb_intersects(const Bounds& bounds, const LineSegment& segment) {
+			return line_segment_aabb_clip(segment, bounds).intersects;
+		}
+
+		bool aabb_intersects(const AABB& aabb, const PreparedSegment& segment) {
+			return aabb_intersects(Bounds(aabb), segment);
+		}
+
+		bool aabb_intersects(const Bounds& bounds, const PreparedSegment& segment) {
+			// Same slab test as clip_to_bounds(), without building the clipped segment. The
+			// direction is the same for every box, so the branches are always predicted.
+			const vec_t& start = segment.start();
+			const vec_t& inverse = segment.inverseDirection();
+			float entry = 0.f;
+			float exit = 1.f;
+
+			if (inverse.x != 0.f) {
+				float t1 = (bounds.min.x - start.x) * inverse.x;
+				float t2 = (bounds.max.x - start.x) * inverse.x;
+				entry = std::max(entry, std::min(t1, t2));
+				exit = std::min(exit, std::max(t1, t2));
+			}
+			else if (start.x < bounds.min.x || start.x > bounds.max.x) {
+				return false;
+			}
+
+			if (inverse.y != 0.f) {
+				float t1 = (bounds.min.y - start.y) * inverse.y;
+				float t2 = (bounds.max.y - start.y) * inverse.y;
+				entry = std::max(entry, std::min(t1, t2));
+				exit = std::min(exit, std::max(t1, t2));
+			}
+			else if (start.y < bounds.min.y || start.y > bounds.max.y) {
+				return false;
+			}
+
+			return entry <= exit;
+		}
+
+		bool circle_intersects(const Circle& circle, const Circle& other) {
+			return vec_magnitude_squared(circle.pos - other.pos) < (circle.radius + other.radius) * (circle.radius + other.radius);
+		}
+
+		bool circle_intersects(const Circle& circle, const AABB& aabb) {
+			return aabb_intersects(Bounds(aabb), circle);
+		}
+
+		bool circle_intersects(const Circle& circle, const Bounds& bounds) {
+			return aabb_intersects(bounds, circle);
+		}
+
+		bool circle_intersects(const Circle& circle, const LineSegment& segment) {
+			return vec_magnitude_squared(circle.pos - closest_point_on_segment(segment, circle.pos)) < circle.radius * circle.radius;
+		}
+
+		bool circle_intersects(const Circle& circle, const PreparedSegment& segment) {
+			return vec_magnitude_squared(circle.pos - closest_point_on_segment(segment, circle.pos)) < circle.radius * circle.radius;
+		}
+
+		vec_t closest_point_on_segment(const LineSegment& segment, const vec_t& point) {
+			const vec_t e = segment.end - segment.start;
+			const float lengthSquared = vec_dot_product(e, e);
+			if (lengthSquared == 0.f) {
+				return segment.start;
+			}
+			float u = vec_dot_product(point - segment.start, e) / lengthSquared;
+			u = std::min(std::max(u, 0.f), 1.f);
+			return segment.start + e * u;
+		}
+
+		vec_t closest_point_on_segment(const PreparedSegment& segment, const vec_t& point) {
+			float u = vec_dot_product(point - segment.start(), segment.direction()) * segment.inverseLengthSquared();
+			u = std::min(std::max(u, 0.f), 1.f);
+			return segment.start() + segment.direction() * u;
+		}
+
+		vec_t closest_point_on_aabb(const AABB& aabb, const vec_t& point) {
+			return closest_point_on_aabb(Bounds(aabb), point);
+		}
+
+		vec_t closest_point_on_aabb(const Bounds& bounds, const vec_t& point) {
+			return vec_t(
+				std::min(std::max(point.x, bounds.min.x), bounds.max.x),
+				std::min(std::max(point.y, bounds.min.y), bounds.max.y));
+		}
+
+		float circles_distance(const Circle& a, const Circle& b) {
+			return vec_magnitude(a.pos - b.pos) - a.radius - b.radius;
+		}
+		
+		AABBCollision aabb_collision_info(const AABB& first, const AABB& other) {
+			return aabb_collision_info(Bounds(first), Bounds(other));
+		}
+
+		AABBCollision aabb_collision_info(const Bounds& first, const Bounds& other) {
+			if (!aabb_intersects(first, other)) {
+				return AABBCollision{ NULL_VEC, NULL_VEC };
+			}
+
+			// Side of the first AABB closest to the center of the other one, on each axis (the sums are twice the centers)
+			const bool left = other.min.x + other.max.x <= first.min.x + first.max.x;
+			const bool top = other.min.y + other.max.y <= first.min.y + first.max.y;
+
+			AABBCollision collision;
+			collision.delta = vec_t(
+				std::abs(left ? first.min.x - other.max.x : first.max.x - other.min.x),
+				std::abs(top ? first.min.y - other.max.y : first.max.y - other.min.y));
+
+			// The collision is resolved along the axis with the smallest overlap
+			if (collision.delta.x > collision.delta.y) {
+				collision.normal = top ? UP_VEC : DOWN_VEC;
+			}
+			else {
+				collision.normal = left ? LEFT_VEC : RIGHT_VEC;
+			}
+
+			return collision;
+		}
+
+		CirclesCollision circles_collision_info(const Circle& first, const Circle& other) {
+			if (!circle_intersects(first, other))
+				return CirclesCollision{ NULL_VEC, 0.f };
+
+			return CirclesCollision{ vec_normalize(other.pos - first.pos), std::abs(circles_distance(first, other)) };
+		}
+
+		CircleAABBCollision circle_aabb_collision_info(const AABB& aabb, const Circle& circle) {
+			return circle_aabb_collision_info(Bounds(aabb), circle);
+		}
+
+		CircleAABBCollision circle_aabb_collision_info(const Bounds& bounds, const Circle& circle) {
+			static const CircleAABBCollision NO_COLLISION = CircleAABBCollision{ NULL_VEC, 0.f };
+
+			vec_t delta = circle.pos - closest_point_on_aabb(bounds, circle.pos);
+			float distanceSquared = vec_magnitude_squared(delta);
+
+			if (distanceSquared >= circle.radius * circle.radius) {
+				return NO_COLLISION;
+			}
+
+			if (distanceSquared > 0.f) {
+				float distance = std::sqrt(distanceSquared);
+				return CircleAABBCollision{ delta / distance, circle.radius - distance };
+			}
+
+			// The center of the circle is inside the box : the circle is pushed out through the closest side
+			float left = circle.pos.x - bounds.min.x;
+			float right = bounds.max.x - circle.pos.x;
+			float top = circle.pos.y - bounds.min.y;
+			float bottom = bounds.max.y - circle.pos.y;
+			float closestX = std::min(left, right);
+			float closestY = std::min(top, bottom);
+
+			if (closestX < closestY) {
+				return CircleAABBCollision{ left < right ? LEFT_VEC : RIGHT_VEC, circle.radius + closestX };
+			}
+			return CircleAABBCollision{ top < bottom ? UP_VEC : DOWN_VEC, circle.radius + closestY };
+		}
+
+		SegmentsIntersection line_segments_intersection_info(const LineSegment& first, const LineSegment& other) {
+			if (collision::aabb_intersects(enclosingAABB(first), enclosingAABB(other))) {
+				float slopeCurrent = first.slope();
+				float slopeOther = other.slope();
+				float YInterceptCurrent = LineSegment::YIntercept(first.start, slopeCurrent);
+				float YInterceptOther = LineSegment::YIntercept(other.start, slopeOther);
+
+				if (slopeCurrent == slopeOther) {
+					if (YInterceptCurrent == YInterceptOther) {
+
+						float minx = first.minX() < other.minX() ? first.minX() : other.minX();
+						float maxx = first.maxX() > other.maxX() ? first.maxX() : other.maxX();
+						float miny = first.minY() < other.minY() ? first.minY() : other.minY();
+						float maxy = first.maxY() > other.maxY() ? first.maxY() : other.maxY();
+
+						const vec_t* p1 = nullptr;
+						const vec_t* p2 = nullptr;
+
+						if (minx == maxx) {
+							if (first.start.y == miny || first.start.y == maxy) {
+								p1 = &first.end;
+							}
+							else {
+								p1 = &first.start;
+							}
+
+							if (other.start.y == miny || other.start.y == maxy) {
+								p2 = &other.end;
+							}
+							else {
+								p2 = &other.start;
+							}
+						}
+						else if (miny == maxy) {
+							if (first.start.x == minx || first.start.x == maxx) {
+								p1 = &first.end;
+							}
+							else {
+								p1 = &first.start;
+							}
+
+							if (other.start.x == minx || other.start.x == maxx) {
+								p2 = &other.end;
+							}
+							else {
+								p2 = &other.start;
+							}
+						}
+						else {
+							if (first.start.x == minx || first.start.x == maxx || first.start.y == miny || first.start.y == maxy) {
+								p1 = &first.end;
+							}
+							else {
+								p1 = &first.start;
+							}
+
+							if (other.start.x == minx || other.start.x == maxx || other.start.y == miny || other.start.y == maxy) {
+								p2 = &other.end;
+							}
+							else {
+								p2 = &other.start;
+							}
+						}
+
+						return SegmentsIntersection(IntersectionType::Overlapping, std::pair<vec_t, vec_t>{ *p1, *p2 });
+					}
+					else {
+						return SegmentsIntersection(IntersectionType::None);
+					}
+				}
+				else {
+					if (YInterceptCurrent == YInterceptOther) {
+
+						return SegmentsIntersection(IntersectionType::Crossing, vec_t(0, YInterceptCurrent));
+					}
+					else {
+						float commonX = (YInterceptOther - YInterceptCurrent) / (slopeCurrent - slopeOther);
+
+						if (commonX > first.minX() && commonX < first.maxX() && commonX > other.minX() && commonX < other.maxX()) {
+							float commonY = slopeCurrent * commonX + YInterceptCurrent;
+
+							return SegmentsIntersection(IntersectionType::Crossing, vec_t(commonX, commonY));
+						}
+						else {
+							return SegmentsIntersection(IntersectionType::None);
+						}
+					}
+				}
+			}
+			else {
+				return SegmentsIntersection(IntersectionType::None);
+			}
+		}
+
+		SegmentsParametricIntersection line_segments_parametric_intersection(const LineSegment& first, const LineSegment& other) {
+			const SegmentsParametricIntersection none{ IntersectionType::None, 0.f, 0.f, 0.f, 0.f };
+			const vec_t r = first.end - first.start;
+			const vec_t s = other.end - other.start;
+			const vec_t qp = other.start - first.start;
+			const float denominator = vec_cross_product(r, s);
+
+			if (denominator != 0.f) {
+				float t = vec_cross_product(qp, s) / denominator;
+				float u = vec_cross_product(qp, r) / denominator;
+				if (t < 0.f || t > 1.f || u < 0.f || u > 1.f) {
+					return none;
+				}
+				return { IntersectionType::Crossing, t, u, t, u };
+			}
+
+			// Parallel segments (or segments reduced to a point) : they must be on the same line
+			if (vec_cross_product(qp, r) != 0.f || vec_cross_product(qp, s) != 0.f) {
+				return none;
+			}
+
+			const float rr = vec_dot_product(r, r);
+			const float ss = vec_dot_product(s, s);
+			if (rr == 0.f && ss == 0.f) {
+				return qp.x == 0.f && qp.y == 0.f ? SegmentsParametricIntersection{ IntersectionType::Crossing, 0.f, 0.f, 0.f, 0.f } : none;
+			}
+			if (rr == 0.f) {
+				float u = -vec_dot_product(qp, s) / ss;
+				return u >= 0.f && u <= 1.f ? SegmentsParametricIntersection{ IntersectionType::Crossing, 0.f, u, 0.f, u } : none;
+			}
+			if (ss == 0.f) {
+				float t = vec_dot_product(qp, r) / rr;
+				return t >= 0.f && t <= 1.f ? SegmentsParametricIntersection{ IntersectionType::Crossing, t, 0.f, t, 0.f } : none;
+			}
+
+			// Collinear : project the extremities of the other segment on the first one
+			float t0 = vec_dot_product(qp, r) / rr;
+			float t1 = t0 + vec_dot_product(s, r) / rr;
+			float tStart = std::max(std::min(t0, t1), 0.f);
+			float tEnd = std::min(std::max(t0, t1), 1.f);
+			if (tStart > tEnd) {
+				return none;
+			}
+
+			float uStart = vec_dot_product(r * tStart - qp, s) / ss;
+			if (tStart == tEnd) {
+				return { IntersectionType::Crossing, tStart, uStart, tStart, uStart };
+			}
+			float uEnd = vec_dot_product(r * tEnd - qp, s) / ss;
+			return { IntersectionType::Overlapping, tStart, uStart, tEnd, uEnd };
+		}
+
+		CircleSegmentCollision circle_segment_collision_info(const LineSegment& segment, const Circle& circle) {
+			const vec_t closest = closest_point_on_segment(segment, circle.pos);
+			const float distanceSquared = vec_magnitude_squared(circle.pos - closest);
+			if (distanceSquared >= circle.radius * circle.radius) {
+				return CircleSegmentCollision{ NULL_VEC, 0.f };
+			}
+
+			vec_t normal = vec_normalize(circle.pos - closest);
+			if (normal == NULL_VEC) {
+				const vec_t e = segment.end - segment.start;
+				normal = vec_normalize(vec_t(-e.y, e.x));
+			}
+			return CircleSegmentCollision{ normal, circle.radius - std::sqrt(distanceSquared) };
+		}
+
+		bool circle_segment_time_of_impact(const Circle& circle, const vec_t& motion, const LineSegment& segment, float& time) {
+			if (circle_intersects(circle, segment)) {
+				time = 0.f;
+				return true;
+			}
+
+			const vec_t e = segment.end - segment.start;
+			const vec_t m = circle.pos - segment.start;
+			const float lengthSquared = vec_dot_product(e, e);
+			float best = std::numeric_limits<float>::infinity();
+
+			// Side of the segment : the circle touches the line at a distance of radius
+			if (lengthSquared > 0.f) {
+				vec_t normal = vec_t(-e.y, e.x) / std::sqrt(lengthSquared);
+				float side = vec_dot_product(m, normal);
+				if (side < 0.f) {
+					normal = -normal;
+					side = -side;
+				}
+				float approach = vec_dot_product(motion, normal);
+				if (approach < 0.f) {
+					float t = (side - circle.radius) / -approach;
+					float u = vec_dot_product(m + motion * t - normal * circle.radius, e) / lengthSquared;
+					if (t >= 0.f && t <= 1.f && u >= 0.f && u <= 1.f) {
+						best = t;
+					}
+				}
+			}
+
+			// Extremities of the segment : the center comes at a distance of radius from them
+			const float a = vec_dot_product(motion, motion);
+			for (const vec_t& extremity : { segment.start, segment.end }) {
+				const vec_t toCenter = circle.pos - extremity;
+				const float b = vec_dot_product(toCenter, motion);
+				const float c = vec_dot_product(toCenter, toCenter) - circle.radius * circle.radius;
+				const float discriminant = b * b - a * c;
+				if (a > 0.f && b < 0.f && discriminant >= 0.f) {
+					float t = (-b - std::sqrt(discriminant)) / a;
+					if (t <= 1.f) {
+						best = std::min(best, t);
+					}
+				}
+			}
+
+			if (best > 1.f) {
+				return false;
+			}
+			time = best;
+			return true;
+		}
+
+		CircleSweepHit circle_sweep_hit(const Circle& circle, const vec_t& motion, const LineSegment& segment, std::uint32_t index, float time) {
+			const vec_t center = circle.pos + motion * time;
+			const vec_t point = closest_point_on_segment(segment, center);
+
+			vec_t normal = vec_normalize(center - point);
+			if (normal == NULL_VEC) {
+				// The center is on the segment, push the circle back against its motion
+				const vec_t e = segment.end - segment.start;
+				normal = vec_normalize(vec_t(-e.y, e.x));
+				if (vec_dot_product(normal, motion) > 0.f) {
+					normal = -normal;
+				}
+			}
+			return CircleSweepHit{ index, time, normal, point };
+		}
+
+		bool circle_sweep(const Circle& circle, const vec_t& motion, const std::vector<LineSegment>& segments, CircleSweepHit& hit) {
+			float earliest = std::numeric_limits<float>::infinity();
+			size_t earliestIndex = segments.size();
+			for (size_t i = 0; i < segments.size(); ++i) {
+				float time;
+				if (circle_segment_time_of_impact(circle, motion, segments[i], time) && time < earliest) {
+					earliest = time;
+					earliestIndex = i;
+				}
+			}
+
+			if (earliestIndex == segments.size()) {
+				return false;
+			}
+			hit = circle_sweep_hit(circle, motion, segments[earliestIndex], static_cast<std::uint32_t>(earliestIndex), earliest);
+			return true;
+		}
+
+		/**
+		 * \brief Computes when a point moving from start to start + motion enters the bounds (slab test).
+		 *
+		 * Implementation of aabb_time_of_impact() and circle_aabb_time_of_impact(). A point moving
+		 * along a side of the bounds doesn't enter them.
+		 *
+		 * \param normal Receives the normal of the side the point enters through, pointing out of the bounds.
+		 */
+		static bool point_bounds_time_of_impact(const vec_t& start, const vec_t& motion, const Bounds& bounds, float& time, vec_t& normal) {
+			const float starts[2] = { start.x, start.y };
+			const float directions[2] = { motion.x, motion.y };
+			const float mins[2] = { bounds.min.x, bounds.min.y };
+			const float maxs[2] = { bounds.max.x, bounds.max.y };
+
+			float entry = -std::numeric_limits<float>::infinity();
+			float exit = std::numeric_limits<float>::infinity();
+			int entryAxis = -1;
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					// Parallel to the sides : the point must be strictly between them
+					if (starts[axis] <= mins[axis] || starts[axis] >= maxs[axis]) {
+						return false;
+					}
+					continue;
+				}
+
+				float t1 = (mins[axis] - starts[axis]) / directions[axis];
+				float t2 = (maxs[axis] - starts[axis]) / directions[axis];
+				if (std::min(t1, t2) > entry) {
+					entry = std::min(t1, t2);
+					entryAxis = axis;
+				}
+				exit = std::min(exit, std::max(t1, t2));
+			}
+
+			if (entryAxis < 0 || entry >= exit || entry > 1.f || exit <= 0.f) {
+				return false;
+			}
+			time = std::max(entry, 0.f);
+			normal = entryAxis == 0 ? vec_t(motion.x > 0.f ? -1.f : 1.f, 0.f) : vec_t(0.f, motion.y > 0.f ? -1.f : 1.f);
+			return true;
+		}
+
+		bool aabb_time_of_impact(const AABB& aabb, const vec_t& motion, const AABB& other, float& time, vec_t& normal) {
+			// Already overlapping (touching isn't enough, the AABBs can still move apart or along each other)
+			const AABBCollision overlap = aabb_collision_info(other, aabb);
+			if (overlap.absolutePenetrationDepthAlongNormal() > 0.f) {
+				time = 0.f;
+				normal = overlap.normal;
+				return true;
+			}
+
+			// The position of the moving AABB enters the other AABB grown by the size of the moving one (Minkowski sum)
+			return point_bounds_time_of_impact(aabb.pos, motion, Bounds(other.pos - aabb.size, other.pos + other.size), time, normal);
+		}
+
+		bool circle_aabb_time_of_impact(const Circle& circle, const vec_t& motion, const AABB& aabb, float& time, vec_t& normal) {
+			const CircleAABBCollision overlap = circle_aabb_collision_info(aabb, circle);
+			if (overlap.absoluteDepth > 0.f) {
+				time = 0.f;
+				normal = overlap.normal;
+				return true;
+			}
+
+			// The center enters the AABB grown by the radius, with rounded corners : two grown AABBs and four circles
+			const Bounds bounds(aabb);
+			const float r = circle.radius;
+			float best = std::numeric_limits<float>::infinity();
+			float t;
+			vec_t n;
+			if (point_bounds_time_of_impact(circle.pos, motion, Bounds(bounds.min.x - r, bounds.min.y, bounds.max.x + r, bounds.max.y), t, n)) {
+				best = t;
+				normal = n;
+			}
+			if (point_bounds_time_of_impact(circle.pos, motion, Bounds(bounds.min.x, bounds.min.y - r, bounds.max.x, bounds.max.y + r), t, n) && t < best) {
+				best = t;
+				normal = n;
+			}
+
+			const float a = vec_dot_product(motion, motion);
+			for (const vec_t& corner : aabb.corners()) {
+				const vec_t toCenter = circle.pos - corner;
+				const float b = vec_dot_product(toCenter, motion);
+				const float c = vec_dot_product(toCenter, toCenter) - r * r;
+				const float discriminant = b * b - a * c;
+				if (a > 0.f && b < 0.f && discriminant >= 0.f) {
+					t = std::max((-b - std::sqrt(discriminant)) / a, 0.f);
+					if (t <= 1.f && t < best) {
+						best = t;
+						normal = vec_normalize(toCenter + motion * t);
+					}
+				}
+			}
+
+			if (best > 1.f) {
+				return false;
+			}
+			time = best;
+			return true;
+		}
+
+		/**
+		 * \brief Clips the segment going from start to start + direction against the bounds.
+		 *
+		 * Implementation of every line_segment_aabb_clip() overload.
+		 *
+		 * \param inverseDirection 1 / direction on each axis. Not used along an axis where the direction is 0.
+		 */
+		static SegmentAABBClip clip_to_bounds(const vec_t& start, const vec_t& direction, const vec_t& inverseDirection, const Bounds& bounds) {
+			const float starts[2] = { start.x, start.y };
+			const float directions[2] = { direction.x, direction.y };
+			const float inverses[2] = { inverseDirection.x, inverseDirection.y };
+			const float mins[2] = { bounds.min.x, bounds.min.y };
+			const float maxs[2] = { bounds.max.x, bounds.max.y };
+
+			float entry = 0.f;
+			float exit = 1.f;
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					// Parallel to the sides : the segment must be between them
+					if (starts[axis] < mins[axis] || starts[axis] > maxs[axis]) {
+						return SegmentAABBClip{ false, 0.f, 0.f, LineSegment() };
+					}
+					continue;
+				}
+
+				float t1 = (mins[axis] - starts[axis]) * inverses[axis];
+				float t2 = (maxs[axis] - starts[axis]) * inverses[axis];
+				entry = std::max(entry, std::min(t1, t2));
+				exit = std::min(exit, std::max(t1, t2));
+			}
+
+			if (entry > exit) {
+				return SegmentAABBClip{ false, 0.f, 0.f, LineSegment() };
+			}
+			return SegmentAABBClip{ true, entry, exit, LineSegment(start + direction * entry, start + direction * exit) };
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const AABB& aabb) {
+			return line_segment_aabb_clip(segment, Bounds(aabb));
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const Bounds& bounds) {
+			const vec_t direction = segment.end - segment.start;
+			const vec_t inverseDirection(direction.x != 0.f ? 1.f / direction.x : 0.f, direction.y != 0.f ? 1.f / direction.y : 0.f);
+			return clip_to_bounds(segment.start, direction, inverseDirection, bounds);
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const AABB& aabb) {
+			return clip_to_bounds(segment.start(), segment.direction(), segment.inverseDirection(), Bounds(aabb));
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const Bounds& bounds) {
+			return clip_to_bounds(segment.start(), segment.direction(), segment.inverseDirection(), bounds);
+		}
+
+		static void project_polygon(const ConvexPolygon& polygon, const vec_t& axis, float& min, float& max) {
+			min = max = vec_dot_product(polygon.vertex(0), axis);
+			for (size_t i = 1; i < polygon.size(); ++i) {
+				float projection = vec_dot_product(polygon.vertex(i), axis);
+				min = std::min(min, projection);
+				max = std::max(max, projection);
+			}
+		}
+
+		// Returns false if the axis separates the shapes, otherwise keeps the axis if pushing the other shape along it is the shortest way so far
+		static bool sat_test_axis(const vec_t& axis, float firstMin, float firstMax, float otherMin, float otherMax, vec_t& bestNormal, float& bestDepth) {
+			float forward = firstMax - otherMin;
+			float backward = otherMax - firstMin;
+			if (forward <= 0.f || backward <= 0.f) {
+				return false;
+			}
+			float depth = std::min(forward, backward);
+			if (depth < bestDepth) {
+				bestDepth = depth;
+				bestNormal = forward < backward ? axis : -axis;
+			}
+			return true;
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& first, const ConvexPolygon& other) {
+			static const PolygonCollision NO_COLLISION = PolygonCollision{ NULL_VEC, 0.f };
+
+			if (!aabb_intersects(first.bounds(), other.bounds())) {
+				return NO_COLLISION;
+			}
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float firstMin, firstMax, otherMin, otherMax;
+
+			for (const ConvexPolygon* polygon : { &first, &other }) {
+				for (size_t i = 0; i < polygon->size(); ++i) {
+					const vec_t& axis = polygon->normal(i);
+					project_polygon(first, axis, firstMin, firstMax);
+					project_polygon(other, axis, otherMin, otherMax);
+					if (!sat_test_axis(axis, firstMin, firstMax, otherMin, otherMax, bestNormal, bestDepth)) {
+						return NO_COLLISION;
+					}
+				}
+			}
+
+			return PolygonCollision{ bestNormal, bestDepth };
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const AABB& aabb) {
+			return polygon_collision_info(polygon, Bounds(aabb));
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Bounds& bounds) {
+			static const PolygonCollision NO_COLLISION = PolygonCollision{ NULL_VEC, 0.f };
+
+			// The axes of the box come first : the polygon is projected on them with its bounds
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			const Bounds& polygonBounds = polygon.bounds();
+			if (!sat_test_axis(RIGHT_VEC, polygonBounds.min.x, polygonBounds.max.x, bounds.min.x, bounds.max.x, bestNormal, bestDepth) ||
+				!sat_test_axis(DOWN_VEC, polygonBounds.min.y, polygonBounds.max.y, bounds.min.y, bounds.max.y, bestNormal, bestDepth)) {
+				return NO_COLLISION;
+			}
+
+			const vec_t boxCenter = bounds.center();
+			const vec_t halfSize = bounds.size() / 2.f;
+			float polygonMin, polygonMax;
+
+			for (size_t i = 0; i < polygon.size(); ++i) {
+				const vec_t& axis = polygon.normal(i);
+				float center = vec_dot_product(boxCenter, axis);
+				float radius = halfSize.x * std::abs(axis.x) + halfSize.y * std::abs(axis.y);
+				project_polygon(polygon, axis, polygonMin, polygonMax);
+				if (!sat_test_axis(axis, polygonMin, polygonMax, center - radius, center + radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return PolygonCollision{ bestNormal, bestDepth };
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Circle& circle) {
+			static const PolygonCollision NO_COLLISION = PolygonCollision{ NULL_VEC, 0.f };
+
+			if (!aabb_intersects(polygon.bounds(), enclosingBounds(circle))) {
+				return NO_COLLISION;
+			}
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float polygonMin, polygonMax;
+
+			// The polygon normals, plus the axis going from the closest vertex to the center of the circle
+			size_t closestVertex = 0;
+			float closestDistance = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < polygon.size(); ++i) {
+				float distance = vec_magnitude_squared(circle.pos - polygon.vertex(i));
+				if (distance < closestDistance) {
+					closestDistance = distance;
+					closestVertex = i;
+				}
+
+				const vec_t& axis = polygon.normal(i);
+				float center = vec_dot_product(circle.pos, axis);
+				project_polygon(polygon, axis, polygonMin, polygonMax);
+				if (!sat_test_axis(axis, polygonMin, polygonMax, center - circle.radius, center + circle.radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			if (closestDistance > 0.f) {
+				const vec_t axis = (circle.pos - polygon.vertex(closestVertex)) / std::sqrt(closestDistance);
+				float center = vec_dot_product(circle.pos, axis);
+				project_polygon(polygon, axis, polygonMin, polygonMax);
+				if (!sat_test_axis(axis, polygonMin, polygonMax, center - circle.radius, center + circle.radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return PolygonCollision{ bestNormal, bestDepth };
+		}
+
+		bool polygon_intersects(const ConvexPolygon& first, const ConvexPolygon& other) {
+			return polygon_collision_info(first, other).absoluteDepth > 0.f;
+		}
+
+		bool polygon_intersects(const ConvexPolygon& polygon, const AABB& aabb) {
+			return polygon_collision_info(polygon, Bounds(aabb)).absoluteDepth > 0.f;
+		}
+
+		bool polygon_intersects(const ConvexPolygon& polygon, const Bounds& bounds) {
+			return polygon_collision_info(polygon, bounds).absoluteDepth > 0.f;
+		}
+
+		bool polygon_intersects(const ConvexPolygon& polygon, const Circle& circle) {
+			return polygon_collision_info(polygon, circle).absoluteDepth > 0.f;
+		}
+
+		// Projects a box given by its center, half size and axes : center +- radius
+		static void project_box(const vec_t& center, const vec_t& halfSize, const vec_t& axisX, const vec_t& axisY, const vec_t& axis, float& min, float& max) {
+			float projectedCenter = vec_dot_product(center, axis);
+			float radius = halfSize.x * std::abs(vec_dot_product(axisX, axis)) + halfSize.y * std::abs(vec_dot_product(axisY, axis));
+			min = projectedCenter - radius;
+			max = projectedCenter + radius;
+		}
+
+		static OBBCollision boxes_collision_info(const vec_t& firstCenter, const vec_t& firstHalfSize, const vec_t& firstX, const vec_t& firstY, const vec_t& otherCenter, const vec_t& otherHalfSize, const vec_t& otherX, const vec_t& otherY) {
+			static const OBBCollision NO_COLLISION = OBBCollision{ NULL_VEC, 0.f };
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float firstMin, firstMax, otherMin, otherMax;
+
+			for (const vec_t* axis : { &firstX, &firstY, &otherX, &otherY }) {
+				project_box(firstCenter, firstHalfSize, firstX, firstY, *axis, firstMin, firstMax);
+				project_box(otherCenter, otherHalfSize, otherX, otherY, *axis, otherMin, otherMax);
+				if (!sat_test_axis(*axis, firstMin, firstMax, otherMin, otherMax, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return OBBCollision{ bestNormal, bestDepth };
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const AABB& aabb) {
+			return obb_collision_info(obb, Bounds(aabb));
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const Bounds& bounds) {
+			return boxes_collision_info(obb.center(), obb.halfSize(), obb.axisX(), obb.axisY(), bounds.center(), bounds.size() / 2.f, RIGHT_VEC, DOWN_VEC);
+		}
+
+		OBBCollision obb_collision_info(const OBB& first, const OBB& other) {
+			return boxes_collision_info(first.center(), first.halfSize(), first.axisX(), first.axisY(), other.center(), other.halfSize(), other.axisX(), other.axisY());
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const Circle& circle) {
+			const vec_t& halfSize = obb.halfSize();
+			CircleAABBCollision local = circle_aabb_collision_info(Bounds(-halfSize, halfSize), Circle(obb.toLocal(circle.pos), circle.radius));
+			return OBBCollision{ obb.axisX() * local.normal.x + obb.axisY() * local.normal.y, local.absoluteDepth };
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const LineSegment& segment) {
+			static const OBBCollision NO_COLLISION = OBBCollision{ NULL_VEC, 0.f };
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float boxMin, boxMax;
+
+			const vec_t direction = segment.end - segment.start;
+			const vec_t segmentNormal = direction == NULL_VEC ? NULL_VEC : vec_normalize(vec_t(-direction.y, direction.x));
+
+			for (const vec_t* axis : { &obb.axisX(), &obb.axisY(), &segmentNormal }) {
+				if (*axis == NULL_VEC) {
+					continue;
+				}
+				float start = vec_dot_product(segment.start, *axis);
+				float end = vec_dot_product(segment.end, *axis);
+				project_box(obb.center(), obb.halfSize(), obb.axisX(), obb.axisY(), *axis, boxMin, boxMax);
+				if (!sat_test_axis(*axis, boxMin, boxMax, std::min(start, end), std::max(start, end), bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return OBBCollision{ bestNormal, bestDepth };
+		}
+
+		bool obb_intersects(const OBB& obb, const AABB& aabb) {
+			return obb_collision_info(obb, Bounds(aabb)).absoluteDepth > 0.f;
+		}
+
+		bool obb_intersects(const OBB& obb, const Bounds& bounds) {
+			return obb_collision_info(obb, bounds).absoluteDepth > 0.f;
+		}
+
+		bool obb_intersects(const OBB& first, const OBB& other) {
+			return obb_collision_info(first, other).absoluteDepth > 0.f;
+		}
+
+		bool obb_intersects(const OBB& obb, const Circle& circle) {
+			const vec_t local = obb.toLocal(circle.pos);
+			float dx = std::max(std::abs(local.x) - obb.halfSize().x, 0.f);
+			float dy = std::max(std::abs(local.y) - obb.halfSize().y, 0.f);
+			return dx * dx + dy * dy < circle.radius * circle.radius;
+		}
+
+		bool obb_intersects(const OBB& obb, const LineSegment& segment) {
+			return obb_collision_info(obb, segment).absoluteDepth > 0.f;
+		}
+
+		void closest_points_between_segments(const LineSegment& first, const LineSegment& other, vec_t& onFirst, vec_t& onOther) {
+			// From "Real-Time Collision Detection" by Christer Ericson (section 5.1.9)
+			const vec_t d1 = first.end - first.start;
+			const vec_t d2 = other.end - other.start;
+			const vec_t r = first.start - other.start;
+			const float a = vec_dot_product(d1, d1);
+			const float e = vec_dot_product(d2, d2);
+			const float f = vec_dot_product(d2, r);
+
+			float s = 0.f;
+			float t = 0.f;
+			if (a == 0.f && e == 0.f) {
+				// Both segments are points
+			}
+			else if (a == 0.f) {
+				t = std::min(std::max(f / e, 0.f), 1.f);
+			}
+			else {
+				const float c = vec_dot_product(d1, r);
+				if (e == 0.f) {
+					s = std::min(std::max(-c / a, 0.f), 1.f);
+				}
+				else {
+					const float b = vec_dot_product(d1, d2);
+					const float denominator = a * e - b * b;
+					s = denominator != 0.f ? std::min(std::max((b * f - c * e) / denominator, 0.f), 1.f) : 0.f;
+					t = (b * s + f) / e;
+					if (t < 0.f) {
+						t = 0.f;
+						s = std::min(std::max(-c / a, 0.f), 1.f);
+					}
+					else if (t > 1.f) {
+						t = 1.f;
+						s = std::min(std::max((b - c) / a, 0.f), 1.f);
+					}
+				}
+			}
+
+			onFirst = first.start + d1 * s;
+			onOther = other.start + d2 * t;
+		}
+
+		// Collision between the segment of a capsule and another shape (a segment, or a point), from their closest points
+		static CapsuleCollision capsule_contact(const LineSegment& segment, const vec_t& onSegment, const LineSegment& other, const vec_t& onOther, float radius) {
+			const vec_t delta = onOther - onSegment;
+			const float distanceSquared = vec_magnitude_squared(delta);
+			if (distanceSquared >= radius * radius) {
+				return CapsuleCollision{ NULL_VEC, 0.f };
+			}
+
+			// Closest points of crossing segments are only equal up to rounding : the crossing is tested exactly
+			if (distanceSquared > 0.f && line_segments_parametric_intersection(segment, other).type == IntersectionType::None) {
+				float distance = std::sqrt(distanceSquared);
+				return CapsuleCollision{ delta / distance, radius - distance };
+			}
+
+			// The segments cross : separating axis theorem on their normals, the segment of the capsule being widened by the radius
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			const vec_t direction = segment.end - segment.start;
+			const vec_t otherDirection = other.end - other.start;
+			for (const vec_t& axis : { vec_normalize(vec_t(-direction.y, direction.x)), vec_normalize(vec_t(-otherDirection.y, otherDirection.x)) }) {
+				if (axis == NULL_VEC) {
+					continue;
+				}
+				float start = vec_dot_product(segment.start, axis);
+				float end = vec_dot_product(segment.end, axis);
+				float otherStart = vec_dot_product(other.start, axis);
+				float otherEnd = vec_dot_product(other.end, axis);
+				sat_test_axis(axis, std::min(start, end) - radius, std::max(start, end) + radius, std::min(otherStart, otherEnd), std::max(otherStart, otherEnd), bestNormal, bestDepth);
+			}
+			if (bestNormal == NULL_VEC) {
+				return CapsuleCollision{ UP_VEC, radius };
+			}
+			return CapsuleCollision{ bestNormal, bestDepth };
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& first, const Capsule& other) {
+			vec_t onFirst, onOther;
+			closest_points_between_segments(first.segment, other.segment, onFirst, onOther);
+			return capsule_contact(first.segment, onFirst, other.segment, onOther, first.radius + other.radius);
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Circle& circle) {
+			const vec_t onSegment = closest_point_on_segment(capsule.segment, circle.pos);
+			return capsule_contact(capsule.segment, onSegment, LineSegment(circle.pos, circle.pos), circle.pos, capsule.radius + circle.radius);
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const LineSegment& segment) {
+			vec_t onCapsule, onSegment;
+			closest_points_between_segments(capsule.segment, segment, onCapsule, onSegment);
+			return capsule_contact(capsule.segment, onCapsule, segment, onSegment, capsule.radius);
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const AABB& aabb) {
+			return capsule_collision_info(capsule, Bounds(aabb));
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Bounds& bounds) {
+			static const CapsuleCollision NO_COLLISION = CapsuleCollision{ NULL_VEC, 0.f };
+
+			if (!aabb_intersects(capsule.bounds(), bounds)) {
+				return NO_COLLISION;
+			}
+
+			const LineSegment& segment = capsule.segment;
+			if (!line_segment_aabb_clip(segment, bounds).intersects) {
+				// The closest points of a segment and a box that don't touch are on an extremity of the segment or on a corner of the box
+				vec_t onSegment = segment.start;
+				vec_t onBox = closest_point_on_aabb(bounds, segment.start);
+				float closest = vec_magnitude_squared(onBox - onSegment);
+
+				const vec_t endOnBox = closest_point_on_aabb(bounds, segment.end);
+				if (vec_magnitude_squared(endOnBox - segment.end) < closest) {
+					onSegment = segment.end;
+					onBox = endOnBox;
+					closest = vec_magnitude_squared(endOnBox - segment.end);
+				}
+				for (const vec_t& corner : { bounds.min, vec_t(bounds.max.x, bounds.min.y), vec_t(bounds.min.x, bounds.max.y), bounds.max }) {
+					const vec_t cornerOnSegment = closest_point_on_segment(segment, corner);
+					float distance = vec_magnitude_squared(corner - cornerOnSegment);
+					if (distance < closest) {
+						onSegment = cornerOnSegment;
+						onBox = corner;
+						closest = distance;
+					}
+				}
+				return capsule_contact(segment, onSegment, LineSegment(onBox, onBox), onBox, capsule.radius);
+			}
+
+			// The segment crosses the box : separating axis theorem on the axes of the box and the normal of the segment
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			const vec_t direction = segment.end - segment.start;
+			const vec_t segmentNormal = vec_normalize(vec_t(-direction.y, direction.x));
+			const vec_t boxCenter = bounds.center();
+			const vec_t halfSize = bounds.size() / 2.f;
+
+			for (const vec_t& axis : { RIGHT_VEC, DOWN_VEC, segmentNormal }) {
+				if (axis == NULL_VEC) {
+					continue;
+				}
+				float start = vec_dot_product(segment.start, axis);
+				float end = vec_dot_product(segment.end, axis);
+				float center = vec_dot_product(boxCenter, axis);
+				float radius = halfSize.x * std::abs(axis.x) + halfSize.y * std::abs(axis.y);
+				if (!sat_test_axis(axis, std::min(start, end) - capsule.radius, std::max(start, end) + capsule.radius, center - radius, center + radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return CapsuleCollision{ bestNormal, bestDepth };
+		}
+
+		bool capsule_intersects(const Capsule& first, const Capsule& other) {
+			vec_t onFirst, onOther;
+			closest_points_between_segments(first.segment, other.segment, onFirst, onOther);
+			float radii = first.radius + other.radius;
+			return vec_magnitude_squared(onOther - onFirst) < radii * radii;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const Circle& circle) {
+			float radii = capsule.radius + circle.radius;
+			return vec_magnitude_squared(circle.pos - closest_point_on_segment(capsule.segment, circle.pos)) < radii * radii;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const LineSegment& segment) {
+			vec_t onCapsule, onSegment;
+			closest_points_between_segments(capsule.segment, segment, onCapsule, onSegment);
+			return vec_magnitude_squared(onSegment - onCapsule) < capsule.radius * capsule.radius;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const AABB& aabb) {
+			return capsule_collision_info(capsule, Bounds(aabb)).absoluteDepth > 0.f;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const Bounds& bounds) {
+			return capsule_collision_info(capsule, bounds).absoluteDepth > 0.f;
+		}
+	}
+}
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef CH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace ch {
+	namespace collision {
+
+		using AABBBatchKernel = size_t(*)(const AABB&, const AABBBatch&, std::uint8_t*);
+		using CircleBatchKernel = size_t(*)(const Circle&, const CircleBatch&, std::uint8_t*);
+		using SegmentBatchKernel = size_t(*)(const LineSegment&, const LineSegmentBatch&, std::uint8_t*, float*, float*);
+		using SegmentAABBClipBatchKernel = size_t(*)(const LineSegment&, const AABBBatch&, std::uint8_t*, float*, float*);
+		// The AVX2 and AVX-512 kernels load the indices of the pairs directly from memory
+		static_assert(sizeof(AABBIndexPair) == 2 * sizeof(std::uint32_t), "AABBIndexPair must be two packed indices");
+
+		using AABBPairBatchKernel = size_t(*)(const AABBBatch&, const AABBIndexPair*, size_t, AABBCollision*);
+		using CircleAABBBatchKernel = size_t(*)(const Circle&, const AABBBatch&, std::uint8_t*, float*, float*, float*);
+		using CircleSweepBatchKernel = void(*)(const Circle&, const vec_t&, const LineSegmentBatch&, float&, size_t&);
+		using AABBOBBBatchKernel = size_t(*)(const AABB&, const OBBBatch&, std::uint8_t*);
+		using CircleOBBBatchKernel = size_t(*)(const Circle&, const OBBBatch&, std::uint8_t*);
+		using CapsuleAABBBatchKernel = size_t(*)(const Capsule&, const AABBBatch&, std::uint8_t*);
+		using AABBPairwiseKernel = size_t(*)(const AABBBatch&, const AABBBatch&, std::uint8_t*);
+		using CirclePairwiseKernel = size_t(*)(const CircleBatch&, const CircleBatch&, std::uint8_t*);
+		using AABBCirclePairwiseKernel = size_t(*)(const AABBBatch&, const CircleBatch&, std::uint8_t*);
+		using SegmentPairwiseKernel = size_t(*)(const LineSegmentBatch&, const LineSegmentBatch&, std::uint8_t*);
+		using AABBSegmentPairwiseKernel = size_t(*)(const AABBBatch&, const LineSegmentBatch&, std::uint8_t*);
+		using CircleSegmentPairwiseKernel = size_t(*)(const CircleBatch&, const LineSegmentBatch&, std::uint8_t*);
+
+		/**
+		 * \brief Function pointers to the batched collision kernels of one SIMD tier.
+		 */
+		struct BatchCollisionKernels {
+			AABBBatchKernel aabbIntersects;
+			CircleBatchKernel circleIntersects;
+			SegmentBatchKernel segmentsIntersect;
+			CircleSweepBatchKernel circleSweep;
+			SegmentAABBClipBatchKernel segmentAABBClip;
+			CircleAABBBatchKernel circleAABBCollision;
+			AABBPairBatchKernel aabbPairCollision;
+			AABBOBBBatchKernel aabbOBBIntersects;
+			CircleOBBBatchKernel circleOBBIntersects;
+			CapsuleAABBBatchKernel capsuleAABBIntersects;
+			AABBPairwiseKernel aabbPairwise;
+			CirclePairwiseKernel circlePairwise;
+			AABBCirclePairwiseKernel aabbCirclePairwise;
+			SegmentPairwiseKernel segmentPairwise;
+			AABBSegmentPairwiseKernel aabbSegmentPairwise;
+			CircleSegmentPairwiseKernel circleSegmentPairwise;
+		};
+
+		/**
+		 * \brief Tests the AABBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The SIMD kernels use it to process the elements that don't fill a whole register.
+		 */
+		static size_t aabb_intersects_range(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results, size_t first) {
+			const float minX = aabb.pos.x;
+			const float minY = aabb.pos.y;
+			const float maxX = aabb.pos.x + aabb.size.x;
+			const float maxY = aabb.pos.y + aabb.size.y;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				bool intersects =
+					maxX >= batch.minX[i] &&
+					maxY >= batch.minY[i] &&
+					minX <= batch.maxX[i] &&
+					minY <= batch.maxY[i];
+				results[i] = intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the circles of the batch from the given index to the end, one at a time.
+		 */
+		static size_t circle_intersects_range(const Circle& circle, const CircleBatch& batch, std::uint8_t* results, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float dx = circle.pos.x - batch.x[i];
+				float dy = circle.pos.y - batch.y[i];
+				float radii = circle.radius + batch.radius[i];
+				results[i] = dx * dx + dy * dy < radii * radii ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the segment against a single segment of the batch and writes the result at the given index.
+		 * \return 1 if the segments intersect, 0 otherwise.
+		 */
+		static std::uint8_t line_segments_intersect_lane(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u, size_t index) {
+			auto intersection = line_segments_parametric_intersection(segment, batch.at(index));
+			results[index] = intersection.type != IntersectionType::None ? 1 : 0;
+			if (t) {
+				t[index] = intersection.t;
+			}
+			if (u) {
+				u[index] = intersection.u;
+			}
+			return results[index];
+		}
+
+		/**
+		 * \brief Tests the segments of the batch from the given index to the end, one at a time.
+		 */
+		static size_t line_segments_intersect_range(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				hits += line_segments_intersect_lane(segment, batch, results, t, u, i);
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Recomputes the lanes of parallel segments with the scalar function.
+		 *
+		 * The SIMD kernels only handle segments that are not parallel to the tested segment
+		 * (the common case), the collinear overlaps are left to the scalar function.
+		 */
+		static size_t fix_parallel_lanes(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u, size_t first, unsigned int parallelMask) {
+			size_t hits = 0;
+			for (size_t lane = 0; parallelMask != 0; ++lane, parallelMask >>= 1) {
+				if (parallelMask & 1u) {
+					hits += line_segments_intersect_lane(segment, batch, results, t, u, first + lane);
+				}
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Clips the segment against the AABBs of the batch from the given index to the end, one at a time.
+		 */
+		static size_t line_segment_aabb_clip_range(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				auto clip = line_segment_aabb_clip(segment, batch.bounds(i));
+				results[i] = clip.intersects ? 1 : 0;
+				if (entry) {
+					entry[i] = clip.entry;
+				}
+				if (exit) {
+					exit[i] = clip.exit;
+				}
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Computes the collisions between the circle and the AABBs of the batch from the given index to the end, one at a time.
+		 *
+		 * Works on the bounds stored in the batch (and not on batch.at(i)) so that the results match the SIMD kernels exactly.
+		 */
+		static size_t circle_aabb_collision_range(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth, size_t first) {
+			const float radiusSquared = circle.radius * circle.radius;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float dx = circle.pos.x - std::min(std::max(circle.pos.x, batch.minX[i]), batch.maxX[i]);
+				float dy = circle.pos.y - std::min(std::max(circle.pos.y, batch.minY[i]), batch.maxY[i]);
+				float distanceSquared = dx * dx + dy * dy;
+
+				vec_t normal = NULL_VEC;
+				float penetration = 0.f;
+				if (distanceSquared < radiusSquared && distanceSquared > 0.f) {
+					float distance = std::sqrt(distanceSquared);
+					normal = vec_t(dx / distance, dy / distance);
+					penetration = circle.radius - distance;
+				}
+				else if (distanceSquared < radiusSquared) {
+					float left = circle.pos.x - batch.minX[i];
+					float right = batch.maxX[i] - circle.pos.x;
+					float top = circle.pos.y - batch.minY[i];
+					float bottom = batch.maxY[i] - circle.pos.y;
+					float closestX = std::min(left, right);
+					float closestY = std::min(top, bottom);
+					if (closestX < closestY) {
+						normal = left < right ? LEFT_VEC : RIGHT_VEC;
+						penetration = circle.radius + closestX;
+					}
+					else {
+						normal = top < bottom ? UP_VEC : DOWN_VEC;
+						penetration = circle.radius + closestY;
+					}
+				}
+
+				results[i] = distanceSquared < radiusSquared ? 1 : 0;
+				if (normalX) {
+					normalX[i] = normal.x;
+				}
+				if (normalY) {
+					normalY[i] = normal.y;
+				}
+				if (depth) {
+					depth[i] = penetration;
+				}
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Computes the collisions of the pairs from the given index to the end, one at a time.
+		 *
+		 * Works on the bounds stored in the batch, like the SIMD kernels.
+		 */
+		static size_t aabb_collision_range(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < count; ++i) {
+				const std::uint32_t a = pairs[i].first;
+				const std::uint32_t b = pairs[i].second;
+
+				if (batch.maxX[a] < batch.minX[b] || batch.maxY[a] < batch.minY[b] || batch.minX[a] > batch.maxX[b] || batch.minY[a] > batch.maxY[b]) {
+					collisions[i] = AABBCollision{ NULL_VEC, NULL_VEC };
+					continue;
+				}
+
+				const bool left = batch.minX[b] + batch.maxX[b] <= batch.minX[a] + batch.maxX[a];
+				const bool top = batch.minY[b] + batch.maxY[b] <= batch.minY[a] + batch.maxY[a];
+				const vec_t delta(
+					std::abs(left ? batch.minX[a] - batch.maxX[b] : batch.maxX[a] - batch.minX[b]),
+					std::abs(top ? batch.minY[a] - batch.maxY[b] : batch.maxY[a] - batch.minY[b]));
+
+				if (delta.x > delta.y) {
+					collisions[i] = AABBCollision{ top ? UP_VEC : DOWN_VEC, delta };
+				}
+				else {
+					collisions[i] = AABBCollision{ left ? LEFT_VEC : RIGHT_VEC, delta };
+				}
+				++hits;
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Writes the collisions computed by the lanes of a register.
+		 *
+		 * \return The number of lanes that hold a collision.
+		 */
+		static size_t write_aabb_collision_lanes(const float* normalX, const float* normalY, const float* deltaX, const float* deltaY, size_t lanes, AABBCollision* collisions) {
+			size_t hits = 0;
+			for (size_t lane = 0; lane < lanes; ++lane) {
+				collisions[lane] = AABBCollision{ vec_t(normalX[lane], normalY[lane]), vec_t(deltaX[lane], deltaY[lane]) };
+				hits += (normalX[lane] != 0.f || normalY[lane] != 0.f) ? 1 : 0;
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Computes the time of impact of the moving circle on the segments of the batch from the given index to the end.
+		 *
+		 * \param earliest Earliest time of impact found so far, updated if an earlier one is found.
+		 * \param earliestIndex Index of the segment hit at the earliest time.
+		 */
+		static void circle_sweep_range(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex, size_t first) {
+			for (size_t i = first; i < batch.size(); ++i) {
+				float time;
+				if (circle_segment_time_of_impact(circle, motion, batch.at(i), time) && time < earliest) {
+					earliest = time;
+					earliestIndex = i;
+				}
+			}
+		}
+
+		/**
+		 * \brief Keeps the earliest time of impact among the lanes of a register.
+		 */
+		static void keep_earliest_lane(const float* times, size_t lanes, size_t first, float& earliest, size_t& earliestIndex) {
+			for (size_t lane = 0; lane < lanes; ++lane) {
+				if (times[lane] < earliest) {
+					earliest = times[lane];
+					earliestIndex = first + lane;
+				}
+			}
+		}
+
+		/**
+		 * \brief Tests the AABB against the OBBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The 4 axes of the separating axis theorem are the axes of the AABB and the cached axes of each OBB.
+		 */
+		static size_t aabb_obb_intersects_range(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results, size_t first) {
+			const float halfX = aabb.size.x / 2.f;
+			const float halfY = aabb.size.y / 2.f;
+			const float centerX = aabb.pos.x + halfX;
+			const float centerY = aabb.pos.y + halfY;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float tx = batch.centerX[i] - centerX;
+				float ty = batch.centerY[i] - centerY;
+				float cosine = batch.cosine[i];
+				float sine = batch.sine[i];
+				float absCosine = std::abs(cosine);
+				float absSine = std::abs(sine);
+				bool intersects =
+					std::abs(tx) < halfX + (batch.halfWidth[i] * absCosine + batch.halfHeight[i] * absSine) &&
+					std::abs(ty) < halfY + (batch.halfWidth[i] * absSine + batch.halfHeight[i] * absCosine) &&
+					std::abs(tx * cosine + ty * sine) < (halfX * absCosine + halfY * absSine) + batch.halfWidth[i] &&
+					std::abs(ty * cosine - tx * sine) < (halfX * absSine + halfY * absCosine) + batch.halfHeight[i];
+				results[i] = intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the circle against the OBBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The center of the circle is moved into the coordinates of each box, then compared with its half size.
+		 */
+		static size_t circle_obb_intersects_range(const Circle& circle, const OBBBatch& batch, std::uint8_t* results, size_t first) {
+			const float radiusSquared = circle.radius * circle.radius;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float dx = circle.pos.x - batch.centerX[i];
+				float dy = circle.pos.y - batch.centerY[i];
+				float localX = dx * batch.cosine[i] + dy * batch.sine[i];
+				float localY = dy * batch.cosine[i] - dx * batch.sine[i];
+				float outsideX = std::max(std::abs(localX) - batch.halfWidth[i], 0.f);
+				float outsideY = std::max(std::abs(localY) - batch.halfHeight[i], 0.f);
+				results[i] = outsideX * outsideX + outsideY * outsideY < radiusSquared ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Constants of a capsule shared by the lanes of the capsule vs AABB kernels.
+		 */
+		struct CapsuleBatchQuery {
+			float startX, startY; /**< Start of the segment. */
+			float directionX, directionY; /**< End of the segment minus its start. */
+			float inverseLengthSquared; /**< 1 / squared length of the segment, 0 if the segment is a point. */
+			float minX, minY, maxX, maxY; /**< Bounds of the segment. */
+			float normalX, normalY; /**< Normal of the segment (not normalized). */
+			float absNormalX, absNormalY; /**< Absolute values of the normal. */
+			float normalDotStart; /**< Projection of the start of the segment on the normal. */
+			float radiusSquared; /**< Squared radius of the capsule. */
+		};
+
+		static CapsuleBatchQuery make_capsule_batch_query(const Capsule& capsule) {
+			const LineSegment& segment = capsule.segment;
+			CapsuleBatchQuery query;
+			query.startX = segment.start.x;
+			query.startY = segment.start.y;
+			query.directionX = segment.end.x - segment.start.x;
+			query.directionY = segment.end.y - segment.start.y;
+			float lengthSquared = query.directionX * query.directionX + query.directionY * query.directionY;
+			query.inverseLengthSquared = lengthSquared == 0.f ? 0.f : 1.f / lengthSquared;
+			query.minX = segment.minX();
+			query.minY = segment.minY();
+			query.maxX = segment.maxX();
+			query.maxY = segment.maxY();
+			// A segment reduced to a point has no normal : the x axis, already tested by the bounds, keeps the strict test of the normal true when the point is inside
+			query.normalX = lengthSquared == 0.f ? 1.f : -query.directionY;
+			query.normalY = query.directionX;
+			query.absNormalX = std::abs(query.normalX);
+			query.absNormalY = std::abs(query.normalY);
+			query.normalDotStart = query.normalX * query.startX + query.normalY * query.startY;
+			query.radiusSquared = capsule.radius * capsule.radius;
+			return query;
+		}
+
+		/**
+		 * \brief Squared distance between a point and the segment of a capsule.
+		 */
+		static float capsule_batch_point_distance(const CapsuleBatchQuery& query, float x, float y) {
+			float t = std::min(std::max(((x - query.startX) * query.directionX + (y - query.startY) * query.directionY) * query.inverseLengthSquared, 0.f), 1.f);
+			float dx = (query.startX + t * query.directionX) - x;
+			float dy = (query.startY + t * query.directionY) - y;
+			return dx * dx + dy * dy;
+		}
+
+		/**
+		 * \brief Tests the capsule against the AABBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The capsule intersects a box if its segment crosses the inside of the box (separating axis theorem on
+		 * the axes of the box and the normal of the segment), or if the closest points of the segment
+		 * and the box are closer than the radius. These points are an extremity of the segment and its
+		 * closest point on the box, or a corner of the box and its closest point on the segment.
+		 */
+		static size_t capsule_aabb_intersects_range(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results, size_t first) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const float endX = query.startX + query.directionX;
+			const float endY = query.startY + query.directionY;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				const float minX = batch.minX[i];
+				const float minY = batch.minY[i];
+				const float maxX = batch.maxX[i];
+				const float maxY = batch.maxY[i];
+
+				float centerX = (minX + maxX) * 0.5f;
+				float centerY = (minY + maxY) * 0.5f;
+				float halfX = (maxX - minX) * 0.5f;
+				float halfY = (maxY - minY) * 0.5f;
+				bool crossing =
+					query.minX < maxX && query.maxX > minX && query.minY < maxY && query.maxY > minY &&
+					std::abs((query.normalX * centerX + query.normalY * centerY) - query.normalDotStart) < halfX * query.absNormalX + halfY * query.absNormalY;
+
+				float startDX = query.startX - std::min(std::max(query.startX, minX), maxX);
+				float startDY = query.startY - std::min(std::max(query.startY, minY), maxY);
+				float endDX = endX - std::min(std::max(endX, minX), maxX);
+				float endDY = endY - std::min(std::max(endY, minY), maxY);
+				float closest = std::min(startDX * startDX + startDY * startDY, endDX * endDX + endDY * endDY);
+				closest = std::min(closest, std::min(capsule_batch_point_distance(query, minX, minY), capsule_batch_point_distance(query, maxX, minY)));
+				closest = std::min(closest, std::min(capsule_batch_point_distance(query, minX, maxY), capsule_batch_point_distance(query, maxX, maxY)));
+
+				results[i] = crossing || closest < query.radiusSquared ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs of AABBs (first[i], other[i]) from the given index to the end, one at a time.
+		 */
+		static size_t aabb_intersects_pairwise_range(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < first.size(); ++i) {
+				bool intersects =
+					first.maxX[i] >= other.minX[i] &&
+					first.maxY[i] >= other.minY[i] &&
+					first.minX[i] <= other.maxX[i] &&
+					first.minY[i] <= other.maxY[i];
+				results[i] = intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs of circles (first[i], other[i]) from the given index to the end, one at a time.
+		 */
+		static size_t circle_intersects_pairwise_range(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < first.size(); ++i) {
+				float dx = first.x[i] - other.x[i];
+				float dy = first.y[i] - other.y[i];
+				float radii = first.radius[i] + other.radius[i];
+				results[i] = dx * dx + dy * dy < radii * radii ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs (aabbs[i], circles[i]) from the given index to the end, one at a time.
+		 */
+		static size_t aabb_circle_intersects_pairwise_range(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < aabbs.size(); ++i) {
+				float dx = circles.x[i] - std::min(std::max(circles.x[i], aabbs.minX[i]), aabbs.maxX[i]);
+				float dy = circles.y[i] - std::min(std::max(circles.y[i], aabbs.minY[i]), aabbs.maxY[i]);
+				results[i] = dx * dx + dy * dy < circles.radius[i] * circles.radius[i] ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests a single pair of segments (first[index], other[index]) and writes the result at the given index.
+		 * \return 1 if the segments intersect, 0 otherwise.
+		 */
+		static std::uint8_t line_segments_intersect_pairwise_lane(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results, size_t index) {
+			results[index] = line_segments_parametric_intersection(first.at(index), other.at(index)).type != IntersectionType::None ? 1 : 0;
+			return results[index];
+		}
+
+		/**
+		 * \brief Tests the pairs of segments (first[i], other[i]) from the given index to the end, one at a time.
+		 */
+		static size_t line_segments_intersect_pairwise_range(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < first.size(); ++i) {
+				hits += line_segments_intersect_pairwise_lane(first, other, results, i);
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Recomputes the lanes of parallel pairs of segments with the scalar function (see fix_parallel_lanes()).
+		 */
+		static size_t fix_parallel_pairwise_lanes(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results, size_t begin, unsigned int parallelMask) {
+			size_t hits = 0;
+			for (size_t lane = 0; parallelMask != 0; ++lane, parallelMask >>= 1) {
+				if (parallelMask & 1u) {
+					hits += line_segments_intersect_pairwise_lane(first, other, results, begin + lane);
+				}
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs (aabbs[i], segments[i]) from the given index to the end, one at a time.
+		 */
+		static size_t aabb_segment_intersects_pairwise_range(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < aabbs.size(); ++i) {
+				results[i] = line_segment_aabb_clip(segments.at(i), aabbs.bounds(i)).intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs (circles[i], segments[i]) from the given index to the end, one at a time.
+		 */
+		static size_t circle_segment_intersects_pairwise_range(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < circles.size(); ++i) {
+				results[i] = circle_intersects(circles.at(i), segments.at(i)) ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		static size_t aabb_intersects_batch_scalar(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			return aabb_intersects_range(aabb, batch, results, 0);
+		}
+
+		static size_t circle_intersects_batch_scalar(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			return circle_intersects_range(circle, batch, results, 0);
+		}
+
+		static size_t line_segments_intersect_batch_scalar(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			return line_segments_intersect_range(segment, batch, results, t, u, 0);
+		}
+
+		static size_t line_segment_aabb_clip_batch_scalar(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			return line_segment_aabb_clip_range(segment, batch, results, entry, exit, 0);
+		}
+
+		static size_t circle_aabb_collision_batch_scalar(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			return circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, 0);
+		}
+
+		static size_t aabb_collision_batch_scalar(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			return aabb_collision_range(batch, pairs, count, collisions, 0);
+		}
+
+		static void circle_sweep_batch_scalar(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex) {
+			circle_sweep_range(circle, motion, batch, earliest, earliestIndex, 0);
+		}
+
+		static size_t aabb_obb_intersects_batch_scalar(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			return aabb_obb_intersects_range(aabb, batch, results, 0);
+		}
+
+		static size_t circle_obb_intersects_batch_scalar(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			return circle_obb_intersects_range(circle, batch, results, 0);
+		}
+
+		static size_t capsule_aabb_intersects_batch_scalar(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			return capsule_aabb_intersects_range(capsule, batch, results, 0);
+		}
+
+		static size_t aabb_intersects_pairwise_scalar(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			return aabb_intersects_pairwise_range(first, other, results, 0);
+		}
+
+		static size_t circle_intersects_pairwise_scalar(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			return circle_intersects_pairwise_range(first, other, results, 0);
+		}
+
+		static size_t aabb_circle_intersects_pairwise_scalar(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			return aabb_circle_intersects_pairwise_range(aabbs, circles, results, 0);
+		}
+
+		static size_t line_segments_intersect_pairwise_scalar(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			return line_segments_intersect_pairwise_range(first, other, results, 0);
+		}
+
+		static size_t aabb_segment_intersects_pairwise_scalar(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			return aabb_segment_intersects_pairwise_range(aabbs, segments, results, 0);
+		}
+
+		static size_t circle_segment_intersects_pairwise_scalar(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			return circle_segment_intersects_pairwise_range(circles, segments, results, 0);
+		}
+
+		/**
+		 * \brief Writes the lanes of a comparison bitmask into the results array (one byte per lane).
+		 * \return The number of bits set in the mask.
+		 */
+		static size_t write_lane_mask(unsigned int mask, size_t lanes, std::uint8_t* results) {
+			size_t hits = 0;
+			for (size_t lane = 0; lane < lanes; ++lane) {
+				results[lane] = static_cast<std::uint8_t>((mask >> lane) & 1u);
+				hits += results[lane];
+			}
+			return hits;
+		}
+
+#ifdef CH_SIMD_X86
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_intersects_batch_sse2(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			const __m128 minX = _mm_set1_ps(aabb.pos.x);
+			const __m128 minY = _mm_set1_ps(aabb.pos.y);
+			const __m128 maxX = _mm_set1_ps(aabb.pos.x + aabb.size.x);
+			const __m128 maxY = _mm_set1_ps(aabb.pos.y + aabb.size.y);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 inside = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(maxX, _mm_loadu_ps(&batch.minX[i])), _mm_cmpge_ps(maxY, _mm_loadu_ps(&batch.minY[i]))),
+					_mm_and_ps(_mm_cmple_ps(minX, _mm_loadu_ps(&batch.maxX[i])), _mm_cmple_ps(minY, _mm_loadu_ps(&batch.maxY[i]))));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_intersects_batch_sse2(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 cr = _mm_set1_ps(circle.radius);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 dx = _mm_sub_ps(cx, _mm_loadu_ps(&batch.x[i]));
+				__m128 dy = _mm_sub_ps(cy, _mm_loadu_ps(&batch.y[i]));
+				__m128 radii = _mm_add_ps(cr, _mm_loadu_ps(&batch.radius[i]));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(radii, radii));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_intersects_range(circle, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t line_segments_intersect_batch_sse2(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			const __m128 ax = _mm_set1_ps(segment.start.x);
+			const __m128 ay = _mm_set1_ps(segment.start.y);
+			const __m128 rx = _mm_set1_ps(segment.end.x - segment.start.x);
+			const __m128 ry = _mm_set1_ps(segment.end.y - segment.start.y);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 bx = _mm_loadu_ps(&batch.startX[i]);
+				__m128 by = _mm_loadu_ps(&batch.startY[i]);
+				__m128 sx = _mm_sub_ps(_mm_loadu_ps(&batch.endX[i]), bx);
+				__m128 sy = _mm_sub_ps(_mm_loadu_ps(&batch.endY[i]), by);
+				__m128 qpx = _mm_sub_ps(bx, ax);
+				__m128 qpy = _mm_sub_ps(by, ay);
+
+				__m128 denominator = _mm_sub_ps(_mm_mul_ps(rx, sy), _mm_mul_ps(ry, sx));
+				__m128 tv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, sy), _mm_mul_ps(qpy, sx)), denominator);
+				__m128 uv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, ry), _mm_mul_ps(qpy, rx)), denominator);
+				__m128 crossing = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(tv, zero), _mm_cmple_ps(tv, one)),
+					_mm_and_ps(_mm_cmpge_ps(uv, zero), _mm_cmple_ps(uv, one)));
+
+				if (t) {
+					_mm_storeu_ps(t + i, _mm_and_ps(tv, crossing));
+				}
+				if (u) {
+					_mm_storeu_ps(u + i, _mm_and_ps(uv, crossing));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(crossing)), 4, results + i);
+				hits += fix_parallel_lanes(segment, batch, results, t, u, i, static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(denominator, zero))));
+			}
+			return hits + line_segments_intersect_range(segment, batch, results, t, u, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t line_segment_aabb_clip_batch_sse2(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			const vec_t direction = segment.end - segment.start;
+			const __m128 sx = _mm_set1_ps(segment.start.x);
+			const __m128 sy = _mm_set1_ps(segment.start.y);
+			const __m128 inverseX = _mm_set1_ps(direction.x != 0.f ? 1.f / direction.x : 0.f);
+			const __m128 inverseY = _mm_set1_ps(direction.y != 0.f ? 1.f / direction.y : 0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&batch.minX[i]);
+				__m128 minY = _mm_loadu_ps(&batch.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&batch.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&batch.maxY[i]);
+				__m128 tEntry = _mm_setzero_ps();
+				__m128 tExit = _mm_set1_ps(1.f);
+				__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+				// The direction is the same for every lane, so are the branches
+				if (direction.x != 0.f) {
+					__m128 t1 = _mm_mul_ps(_mm_sub_ps(minX, sx), inverseX);
+					__m128 t2 = _mm_mul_ps(_mm_sub_ps(maxX, sx), inverseX);
+					tEntry = _mm_max_ps(tEntry, _mm_min_ps(t1, t2));
+					tExit = _mm_min_ps(tExit, _mm_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(minX, sx), _mm_cmpge_ps(maxX, sx)));
+				}
+				if (direction.y != 0.f) {
+					__m128 t1 = _mm_mul_ps(_mm_sub_ps(minY, sy), inverseY);
+					__m128 t2 = _mm_mul_ps(_mm_sub_ps(maxY, sy), inverseY);
+					tEntry = _mm_max_ps(tEntry, _mm_min_ps(t1, t2));
+					tExit = _mm_min_ps(tExit, _mm_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(minY, sy), _mm_cmpge_ps(maxY, sy)));
+				}
+
+				inside = _mm_and_ps(inside, _mm_cmple_ps(tEntry, tExit));
+				if (entry) {
+					_mm_storeu_ps(entry + i, _mm_and_ps(tEntry, inside));
+				}
+				if (exit) {
+					_mm_storeu_ps(exit + i, _mm_and_ps(tExit, inside));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + line_segment_aabb_clip_range(segment, batch, results, entry, exit, i);
+		}
+
+		/**
+		 * \brief Selects a where the mask is set, b elsewhere.
+		 */
+		CH_SIMD_TARGET("sse2")
+		static __m128 select_sse2(__m128 mask, __m128 a, __m128 b) {
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_aabb_collision_batch_sse2(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 radius = _mm_set1_ps(circle.radius);
+			const __m128 radiusSquared = _mm_set1_ps(circle.radius * circle.radius);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 minusOne = _mm_set1_ps(-1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&batch.minX[i]);
+				__m128 minY = _mm_loadu_ps(&batch.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&batch.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&batch.maxY[i]);
+
+				__m128 dx = _mm_sub_ps(cx, _mm_min_ps(_mm_max_ps(cx, minX), maxX));
+				__m128 dy = _mm_sub_ps(cy, _mm_min_ps(_mm_max_ps(cy, minY), maxY));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 overlap = _mm_cmplt_ps(distanceSquared, radiusSquared);
+				__m128 outside = _mm_cmpgt_ps(distanceSquared, zero);
+
+				// Center outside of the box : the normal goes from the closest point towards the center
+				__m128 distance = _mm_sqrt_ps(distanceSquared);
+				__m128 outsideX = _mm_div_ps(dx, distance);
+				__m128 outsideY = _mm_div_ps(dy, distance);
+				__m128 outsideDepth = _mm_sub_ps(radius, distance);
+
+				// Center inside of the box : the circle is pushed out through the closest side
+				__m128 left = _mm_sub_ps(cx, minX);
+				__m128 right = _mm_sub_ps(maxX, cx);
+				__m128 top = _mm_sub_ps(cy, minY);
+				__m128 bottom = _mm_sub_ps(maxY, cy);
+				__m128 closestX = _mm_min_ps(left, right);
+				__m128 closestY = _mm_min_ps(top, bottom);
+				__m128 alongX = _mm_cmplt_ps(closestX, closestY);
+				__m128 insideX = _mm_and_ps(alongX, select_sse2(_mm_cmplt_ps(left, right), minusOne, one));
+				__m128 insideY = _mm_andnot_ps(alongX, select_sse2(_mm_cmplt_ps(top, bottom), minusOne, one));
+				__m128 insideDepth = _mm_add_ps(radius, _mm_min_ps(closestX, closestY));
+
+				if (normalX) {
+					_mm_storeu_ps(normalX + i, _mm_and_ps(overlap, select_sse2(outside, outsideX, insideX)));
+				}
+				if (normalY) {
+					_mm_storeu_ps(normalY + i, _mm_and_ps(overlap, select_sse2(outside, outsideY, insideY)));
+				}
+				if (depth) {
+					_mm_storeu_ps(depth + i, _mm_and_ps(overlap, select_sse2(outside, outsideDepth, insideDepth)));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(overlap)), 4, results + i);
+			}
+			return hits + circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_collision_batch_sse2(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 minusOne = _mm_set1_ps(-1.f);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			alignas(16) float normalX[4];
+			alignas(16) float normalY[4];
+			alignas(16) float deltaX[4];
+			alignas(16) float deltaY[4];
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				const AABBIndexPair* p = pairs + i;
+				__m128 minX1 = _mm_set_ps(batch.minX[p[3].first], batch.minX[p[2].first], batch.minX[p[1].first], batch.minX[p[0].first]);
+				__m128 minY1 = _mm_set_ps(batch.minY[p[3].first], batch.minY[p[2].first], batch.minY[p[1].first], batch.minY[p[0].first]);
+				__m128 maxX1 = _mm_set_ps(batch.maxX[p[3].first], batch.maxX[p[2].first], batch.maxX[p[1].first], batch.maxX[p[0].first]);
+				__m128 maxY1 = _mm_set_ps(batch.maxY[p[3].first], batch.maxY[p[2].first], batch.maxY[p[1].first], batch.maxY[p[0].first]);
+				__m128 minX2 = _mm_set_ps(batch.minX[p[3].second], batch.minX[p[2].second], batch.minX[p[1].second], batch.minX[p[0].second]);
+				__m128 minY2 = _mm_set_ps(batch.minY[p[3].second], batch.minY[p[2].second], batch.minY[p[1].second], batch.minY[p[0].second]);
+				__m128 maxX2 = _mm_set_ps(batch.maxX[p[3].second], batch.maxX[p[2].second], batch.maxX[p[1].second], batch.maxX[p[0].second]);
+				__m128 maxY2 = _mm_set_ps(batch.maxY[p[3].second], batch.maxY[p[2].second], batch.maxY[p[1].second], batch.maxY[p[0].second]);
+
+				__m128 intersects = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(maxX1, minX2), _mm_cmpge_ps(maxY1, minY2)),
+					_mm_and_ps(_mm_cmple_ps(minX1, maxX2), _mm_cmple_ps(minY1, maxY2)));
+
+				// Side of the first AABB closest to the center of the second one, on each axis
+				__m128 left = _mm_cmple_ps(_mm_add_ps(minX2, maxX2), _mm_add_ps(minX1, maxX1));
+				__m128 top = _mm_cmple_ps(_mm_add_ps(minY2, maxY2), _mm_add_ps(minY1, maxY1));
+				__m128 dx = _mm_andnot_ps(signMask, select_sse2(left, _mm_sub_ps(minX1, maxX2), _mm_sub_ps(maxX1, minX2)));
+				__m128 dy = _mm_andnot_ps(signMask, select_sse2(top, _mm_sub_ps(minY1, maxY2), _mm_sub_ps(maxY1, minY2)));
+				__m128 vertical = _mm_cmpgt_ps(dx, dy);
+
+				_mm_store_ps(normalX, _mm_and_ps(intersects, _mm_andnot_ps(vertical, select_sse2(left, minusOne, one))));
+				_mm_store_ps(normalY, _mm_and_ps(intersects, _mm_and_ps(vertical, select_sse2(top, minusOne, one))));
+				_mm_store_ps(deltaX, _mm_and_ps(intersects, dx));
+				_mm_store_ps(deltaY, _mm_and_ps(intersects, dy));
+				hits += write_aabb_collision_lanes(normalX, normalY, deltaX, deltaY, 4, collisions + i);
+			}
+			return hits + aabb_collision_range(batch, pairs, count, collisions, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static void circle_sweep_batch_sse2(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 r = _mm_set1_ps(circle.radius);
+			const __m128 r2 = _mm_set1_ps(circle.radius * circle.radius);
+			const __m128 dx = _mm_set1_ps(motion.x);
+			const __m128 dy = _mm_set1_ps(motion.y);
+			const __m128 dd = _mm_set1_ps(motion.x * motion.x + motion.y * motion.y);
+			const __m128 moving = _mm_cmpgt_ps(dd, _mm_setzero_ps());
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+			const __m128 signBit = _mm_set1_ps(-0.f);
+
+			size_t i = 0;
+			alignas(16) float times[4];
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 ax = _mm_loadu_ps(&batch.startX[i]);
+				__m128 ay = _mm_loadu_ps(&batch.startY[i]);
+				__m128 ex = _mm_sub_ps(_mm_loadu_ps(&batch.endX[i]), ax);
+				__m128 ey = _mm_sub_ps(_mm_loadu_ps(&batch.endY[i]), ay);
+				__m128 mx = _mm_sub_ps(cx, ax);
+				__m128 my = _mm_sub_ps(cy, ay);
+				__m128 ee = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+				__m128 notPoint = _mm_cmpgt_ps(ee, zero);
+
+				// Already intersecting (distance from the center to the closest point of the segment)
+				__m128 u0 = _mm_and_ps(_mm_div_ps(_mm_add_ps(_mm_mul_ps(mx, ex), _mm_mul_ps(my, ey)), ee), notPoint);
+				u0 = _mm_min_ps(_mm_max_ps(u0, zero), one);
+				__m128 qx = _mm_sub_ps(_mm_mul_ps(ex, u0), mx);
+				__m128 qy = _mm_sub_ps(_mm_mul_ps(ey, u0), my);
+				__m128 intersecting = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), r2);
+
+				// Side of the segment
+				__m128 length = _mm_sqrt_ps(ee);
+				__m128 nx = _mm_div_ps(_mm_xor_ps(ey, signBit), length);
+				__m128 ny = _mm_div_ps(ex, length);
+				__m128 side = _mm_add_ps(_mm_mul_ps(mx, nx), _mm_mul_ps(my, ny));
+				__m128 flip = _mm_and_ps(side, signBit);
+				nx = _mm_xor_ps(nx, flip);
+				ny = _mm_xor_ps(ny, flip);
+				side = _mm_xor_ps(side, flip);
+				__m128 approach = _mm_add_ps(_mm_mul_ps(dx, nx), _mm_mul_ps(dy, ny));
+				__m128 tSide = _mm_div_ps(_mm_sub_ps(side, r), _mm_xor_ps(approach, signBit));
+				__m128 px = _mm_sub_ps(_mm_add_ps(mx, _mm_mul_ps(dx, tSide)), _mm_mul_ps(nx, r));
+				__m128 py = _mm_sub_ps(_mm_add_ps(my, _mm_mul_ps(dy, tSide)), _mm_mul_ps(ny, r));
+				__m128 u = _mm_div_ps(_mm_add_ps(_mm_mul_ps(px, ex), _mm_mul_ps(py, ey)), ee);
+				__m128 sideHit = _mm_and_ps(_mm_and_ps(notPoint, _mm_cmplt_ps(approach, zero)),
+					_mm_and_ps(_mm_and_ps(_mm_cmpge_ps(tSide, zero), _mm_cmple_ps(tSide, one)), _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one))));
+				__m128 best = select_sse2(sideHit, tSide, infinity);
+
+				// Extremities of the segment
+				for (int extremity = 0; extremity < 2; ++extremity) {
+					__m128 tx = extremity == 0 ? mx : _mm_sub_ps(mx, ex);
+					__m128 ty = extremity == 0 ? my : _mm_sub_ps(my, ey);
+					__m128 b = _mm_add_ps(_mm_mul_ps(tx, dx), _mm_mul_ps(ty, dy));
+					__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), r2);
+					__m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(dd, c));
+					__m128 t = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(b, signBit), _mm_sqrt_ps(_mm_max_ps(discriminant, zero))), dd);
+					__m128 extremityHit = _mm_and_ps(_mm_and_ps(moving, _mm_cmplt_ps(b, zero)), _mm_and_ps(_mm_cmpge_ps(discriminant, zero), _mm_cmple_ps(t, one)));
+					best = _mm_min_ps(best, select_sse2(extremityHit, t, infinity));
+				}
+
+				best = select_sse2(intersecting, zero, best);
+				if (_mm_movemask_ps(_mm_cmplt_ps(best, _mm_set1_ps(earliest))) != 0) {
+					_mm_store_ps(times, best);
+					keep_earliest_lane(times, 4, i, earliest, earliestIndex);
+				}
+			}
+			circle_sweep_range(circle, motion, batch, earliest, earliestIndex, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_obb_intersects_batch_sse2(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			const float halfWidth = aabb.size.x / 2.f;
+			const float halfHeight = aabb.size.y / 2.f;
+			const __m128 halfX = _mm_set1_ps(halfWidth);
+			const __m128 halfY = _mm_set1_ps(halfHeight);
+			const __m128 centerX = _mm_set1_ps(aabb.pos.x + halfWidth);
+			const __m128 centerY = _mm_set1_ps(aabb.pos.y + halfHeight);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 tx = _mm_sub_ps(_mm_loadu_ps(&batch.centerX[i]), centerX);
+				__m128 ty = _mm_sub_ps(_mm_loadu_ps(&batch.centerY[i]), centerY);
+				__m128 cosine = _mm_loadu_ps(&batch.cosine[i]);
+				__m128 sine = _mm_loadu_ps(&batch.sine[i]);
+				__m128 absCosine = _mm_andnot_ps(signMask, cosine);
+				__m128 absSine = _mm_andnot_ps(signMask, sine);
+				__m128 obbHalfX = _mm_loadu_ps(&batch.halfWidth[i]);
+				__m128 obbHalfY = _mm_loadu_ps(&batch.halfHeight[i]);
+				__m128 extentX = _mm_add_ps(halfX, _mm_add_ps(_mm_mul_ps(obbHalfX, absCosine), _mm_mul_ps(obbHalfY, absSine)));
+				__m128 extentY = _mm_add_ps(halfY, _mm_add_ps(_mm_mul_ps(obbHalfX, absSine), _mm_mul_ps(obbHalfY, absCosine)));
+				__m128 extentU = _mm_add_ps(_mm_add_ps(_mm_mul_ps(halfX, absCosine), _mm_mul_ps(halfY, absSine)), obbHalfX);
+				__m128 extentV = _mm_add_ps(_mm_add_ps(_mm_mul_ps(halfX, absSine), _mm_mul_ps(halfY, absCosine)), obbHalfY);
+				__m128 projectedU = _mm_andnot_ps(signMask, _mm_add_ps(_mm_mul_ps(tx, cosine), _mm_mul_ps(ty, sine)));
+				__m128 projectedV = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_mul_ps(ty, cosine), _mm_mul_ps(tx, sine)));
+				__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, tx), extentX), _mm_cmplt_ps(_mm_andnot_ps(signMask, ty), extentY)), _mm_and_ps(_mm_cmplt_ps(projectedU, extentU), _mm_cmplt_ps(projectedV, extentV)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_obb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_obb_intersects_batch_sse2(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 radiusSquared = _mm_set1_ps(circle.radius * circle.radius);
+			const __m128 zero = _mm_set1_ps(0.f);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 dx = _mm_sub_ps(cx, _mm_loadu_ps(&batch.centerX[i]));
+				__m128 dy = _mm_sub_ps(cy, _mm_loadu_ps(&batch.centerY[i]));
+				__m128 cosine = _mm_loadu_ps(&batch.cosine[i]);
+				__m128 sine = _mm_loadu_ps(&batch.sine[i]);
+				__m128 localX = _mm_add_ps(_mm_mul_ps(dx, cosine), _mm_mul_ps(dy, sine));
+				__m128 localY = _mm_sub_ps(_mm_mul_ps(dy, cosine), _mm_mul_ps(dx, sine));
+				__m128 outsideX = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, localX), _mm_loadu_ps(&batch.halfWidth[i])), zero);
+				__m128 outsideY = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, localY), _mm_loadu_ps(&batch.halfHeight[i])), zero);
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(outsideX, outsideX), _mm_mul_ps(outsideY, outsideY));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, radiusSquared);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_obb_intersects_range(circle, batch, results, i);
+		}
+
+		/**
+		 * \brief Squared distance between a corner of the boxes of 4 lanes and the segment of a capsule.
+		 */
+		CH_SIMD_TARGET("sse2")
+		static __m128 capsule_batch_corner_distance_sse2(__m128 x, __m128 y, __m128 startX, __m128 startY, __m128 directionX, __m128 directionY, __m128 inverseLengthSquared, __m128 zero, __m128 one) {
+			__m128 t = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, startX), directionX), _mm_mul_ps(_mm_sub_ps(y, startY), directionY)), inverseLengthSquared), zero), one);
+			__m128 dx = _mm_sub_ps(_mm_add_ps(startX, _mm_mul_ps(t, directionX)), x);
+			__m128 dy = _mm_sub_ps(_mm_add_ps(startY, _mm_mul_ps(t, directionY)), y);
+			return _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t capsule_aabb_intersects_batch_sse2(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const __m128 startX = _mm_set1_ps(query.startX);
+			const __m128 startY = _mm_set1_ps(query.startY);
+			const __m128 endX = _mm_set1_ps(query.startX + query.directionX);
+			const __m128 endY = _mm_set1_ps(query.startY + query.directionY);
+			const __m128 directionX = _mm_set1_ps(query.directionX);
+			const __m128 directionY = _mm_set1_ps(query.directionY);
+			const __m128 inverseLengthSquared = _mm_set1_ps(query.inverseLengthSquared);
+			const __m128 segmentMinX = _mm_set1_ps(query.minX);
+			const __m128 segmentMinY = _mm_set1_ps(query.minY);
+			const __m128 segmentMaxX = _mm_set1_ps(query.maxX);
+			const __m128 segmentMaxY = _mm_set1_ps(query.maxY);
+			const __m128 normalX = _mm_set1_ps(query.normalX);
+			const __m128 normalY = _mm_set1_ps(query.normalY);
+			const __m128 absNormalX = _mm_set1_ps(query.absNormalX);
+			const __m128 absNormalY = _mm_set1_ps(query.absNormalY);
+			const __m128 normalDotStart = _mm_set1_ps(query.normalDotStart);
+			const __m128 radiusSquared = _mm_set1_ps(query.radiusSquared);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 zero = _mm_set1_ps(0.f);
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&batch.minX[i]);
+				__m128 minY = _mm_loadu_ps(&batch.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&batch.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&batch.maxY[i]);
+
+				__m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+				__m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+				__m128 halfX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+				__m128 halfY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+				__m128 crossing = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(segmentMinX, maxX), _mm_cmpgt_ps(segmentMaxX, minX)), _mm_and_ps(_mm_cmplt_ps(segmentMinY, maxY), _mm_cmpgt_ps(segmentMaxY, minY)));
+				crossing = _mm_and_ps(crossing, _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(normalX, centerX), _mm_mul_ps(normalY, centerY)), normalDotStart)), _mm_add_ps(_mm_mul_ps(halfX, absNormalX), _mm_mul_ps(halfY, absNormalY))));
+
+				__m128 startDX = _mm_sub_ps(startX, _mm_min_ps(_mm_max_ps(startX, minX), maxX));
+				__m128 startDY = _mm_sub_ps(startY, _mm_min_ps(_mm_max_ps(startY, minY), maxY));
+				__m128 endDX = _mm_sub_ps(endX, _mm_min_ps(_mm_max_ps(endX, minX), maxX));
+				__m128 endDY = _mm_sub_ps(endY, _mm_min_ps(_mm_max_ps(endY, minY), maxY));
+				__m128 closest = _mm_min_ps(_mm_add_ps(_mm_mul_ps(startDX, startDX), _mm_mul_ps(startDY, startDY)), _mm_add_ps(_mm_mul_ps(endDX, endDX), _mm_mul_ps(endDY, endDY)));
+				closest = _mm_min_ps(closest, _mm_min_ps(capsule_batch_corner_distance_sse2(minX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_sse2(maxX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+				closest = _mm_min_ps(closest, _mm_min_ps(capsule_batch_corner_distance_sse2(minX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_sse2(maxX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+
+				__m128 inside = _mm_or_ps(crossing, _mm_cmplt_ps(closest, radiusSquared));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + capsule_aabb_intersects_range(capsule, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_intersects_pairwise_sse2(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= first.size(); i += 4) {
+				__m128 inside = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&first.maxX[i]), _mm_loadu_ps(&other.minX[i])), _mm_cmpge_ps(_mm_loadu_ps(&first.maxY[i]), _mm_loadu_ps(&other.minY[i]))),
+					_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&first.minX[i]), _mm_loadu_ps(&other.maxX[i])), _mm_cmple_ps(_mm_loadu_ps(&first.minY[i]), _mm_loadu_ps(&other.maxY[i]))));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_intersects_pairwise_sse2(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= first.size(); i += 4) {
+				__m128 dx = _mm_sub_ps(_mm_loadu_ps(&first.x[i]), _mm_loadu_ps(&other.x[i]));
+				__m128 dy = _mm_sub_ps(_mm_loadu_ps(&first.y[i]), _mm_loadu_ps(&other.y[i]));
+				__m128 radii = _mm_add_ps(_mm_loadu_ps(&first.radius[i]), _mm_loadu_ps(&other.radius[i]));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(radii, radii));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_circle_intersects_pairwise_sse2(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= aabbs.size(); i += 4) {
+				__m128 cx = _mm_loadu_ps(&circles.x[i]);
+				__m128 cy = _mm_loadu_ps(&circles.y[i]);
+				__m128 r = _mm_loadu_ps(&circles.radius[i]);
+				__m128 dx = _mm_sub_ps(cx, _mm_min_ps(_mm_max_ps(cx, _mm_loadu_ps(&aabbs.minX[i])), _mm_loadu_ps(&aabbs.maxX[i])));
+				__m128 dy = _mm_sub_ps(cy, _mm_min_ps(_mm_max_ps(cy, _mm_loadu_ps(&aabbs.minY[i])), _mm_loadu_ps(&aabbs.maxY[i])));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(r, r));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_circle_intersects_pairwise_range(aabbs, circles, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t line_segments_intersect_pairwise_sse2(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= first.size(); i += 4) {
+				__m128 ax = _mm_loadu_ps(&first.startX[i]);
+				__m128 ay = _mm_loadu_ps(&first.startY[i]);
+				__m128 rx = _mm_sub_ps(_mm_loadu_ps(&first.endX[i]), ax);
+				__m128 ry = _mm_sub_ps(_mm_loadu_ps(&first.endY[i]), ay);
+				__m128 bx = _mm_loadu_ps(&other.startX[i]);
+				__m128 by = _mm_loadu_ps(&other.startY[i]);
+				__m128 sx = _mm_sub_ps(_mm_loadu_ps(&other.endX[i]), bx);
+				__m128 sy = _mm_sub_ps(_mm_loadu_ps(&other.endY[i]), by);
+				__m128 qpx = _mm_sub_ps(bx, ax);
+				__m128 qpy = _mm_sub_ps(by, ay);
+
+				__m128 denominator = _mm_sub_ps(_mm_mul_ps(rx, sy), _mm_mul_ps(ry, sx));
+				__m128 tv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, sy), _mm_mul_ps(qpy, sx)), denominator);
+				__m128 uv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, ry), _mm_mul_ps(qpy, rx)), denominator);
+				__m128 crossing = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(tv, zero), _mm_cmple_ps(tv, one)),
+					_mm_and_ps(_mm_cmpge_ps(uv, zero), _mm_cmple_ps(uv, one)));
+
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(crossing)), 4, results + i);
+				hits += fix_parallel_pairwise_lanes(first, other, results, i, static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(denominator, zero))));
+			}
+			return hits + line_segments_intersect_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_segment_intersects_pairwise_sse2(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= aabbs.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&aabbs.minX[i]);
+				__m128 minY = _mm_loadu_ps(&aabbs.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&aabbs.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&aabbs.maxY[i]);
+				__m128 sx = _mm_loadu_ps(&segments.startX[i]);
+				__m128 sy = _mm_loadu_ps(&segments.startY[i]);
+				__m128 dx = _mm_sub_ps(_mm_loadu_ps(&segments.endX[i]), sx);
+				__m128 dy = _mm_sub_ps(_mm_loadu_ps(&segments.endY[i]), sy);
+
+				// Each lane has its own direction : the lanes parallel to an axis are masked instead of branched on
+				__m128 parallelX = _mm_cmpeq_ps(dx, zero);
+				__m128 parallelY = _mm_cmpeq_ps(dy, zero);
+				__m128 inverseX = _mm_div_ps(one, dx);
+				__m128 inverseY = _mm_div_ps(one, dy);
+
+				__m128 t1 = _mm_mul_ps(_mm_sub_ps(minX, sx), inverseX);
+				__m128 t2 = _mm_mul_ps(_mm_sub_ps(maxX, sx), inverseX);
+				__m128 tEntry = _mm_max_ps(zero, select_sse2(parallelX, zero, _mm_min_ps(t1, t2)));
+				__m128 tExit = _mm_min_ps(one, select_sse2(parallelX, one, _mm_max_ps(t1, t2)));
+				t1 = _mm_mul_ps(_mm_sub_ps(minY, sy), inverseY);
+				t2 = _mm_mul_ps(_mm_sub_ps(maxY, sy), inverseY);
+				tEntry = _mm_max_ps(tEntry, select_sse2(parallelY, zero, _mm_min_ps(t1, t2)));
+				tExit = _mm_min_ps(tExit, select_sse2(parallelY, one, _mm_max_ps(t1, t2)));
+
+				__m128 betweenX = _mm_and_ps(_mm_cmple_ps(minX, sx), _mm_cmpge_ps(maxX, sx));
+				__m128 betweenY = _mm_and_ps(_mm_cmple_ps(minY, sy), _mm_cmpge_ps(maxY, sy));
+				__m128 inside = _mm_and_ps(
+					_mm_and_ps(select_sse2(parallelX, betweenX, _mm_castsi128_ps(_mm_set1_epi32(-1))), select_sse2(parallelY, betweenY, _mm_castsi128_ps(_mm_set1_epi32(-1)))),
+					_mm_cmple_ps(tEntry, tExit));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_segment_intersects_pairwise_range(aabbs, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_segment_intersects_pairwise_sse2(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= circles.size(); i += 4) {
+				__m128 cx = _mm_loadu_ps(&circles.x[i]);
+				__m128 cy = _mm_loadu_ps(&circles.y[i]);
+				__m128 r = _mm_loadu_ps(&circles.radius[i]);
+				__m128 sx = _mm_loadu_ps(&segments.startX[i]);
+				__m128 sy = _mm_loadu_ps(&segments.startY[i]);
+				__m128 ex = _mm_sub_ps(_mm_loadu_ps(&segments.endX[i]), sx);
+				__m128 ey = _mm_sub_ps(_mm_loadu_ps(&segments.endY[i]), sy);
+
+				// Closest point of the segment, its start if the segment is a point
+				__m128 lengthSquared = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+				__m128 u = _mm_div_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(cx, sx), ex), _mm_mul_ps(_mm_sub_ps(cy, sy), ey)), lengthSquared);
+				u = select_sse2(_mm_cmpeq_ps(lengthSquared, zero), zero, _mm_min_ps(_mm_max_ps(u, zero), one));
+				__m128 dx = _mm_sub_ps(cx, _mm_add_ps(sx, _mm_mul_ps(ex, u)));
+				__m128 dy = _mm_sub_ps(cy, _mm_add_ps(sy, _mm_mul_ps(ey, u)));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(r, r));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_segment_intersects_pairwise_range(circles, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_intersects_batch_avx2(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			const __m256 minX = _mm256_set1_ps(aabb.pos.x);
+			const __m256 minY = _mm256_set1_ps(aabb.pos.y);
+			const __m256 maxX = _mm256_set1_ps(aabb.pos.x + aabb.size.x);
+			const __m256 maxY = _mm256_set1_ps(aabb.pos.y + aabb.size.y);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 inside = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(maxX, _mm256_loadu_ps(&batch.minX[i]), _CMP_GE_OQ), _mm256_cmp_ps(maxY, _mm256_loadu_ps(&batch.minY[i]), _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(minX, _mm256_loadu_ps(&batch.maxX[i]), _CMP_LE_OQ), _mm256_cmp_ps(minY, _mm256_loadu_ps(&batch.maxY[i]), _CMP_LE_OQ)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_intersects_batch_avx2(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 cr = _mm256_set1_ps(circle.radius);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 dx = _mm256_sub_ps(cx, _mm256_loadu_ps(&batch.x[i]));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_loadu_ps(&batch.y[i]));
+				__m256 radii = _mm256_add_ps(cr, _mm256_loadu_ps(&batch.radius[i]));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radii, radii), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_intersects_range(circle, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t line_segments_intersect_batch_avx2(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			const __m256 ax = _mm256_set1_ps(segment.start.x);
+			const __m256 ay = _mm256_set1_ps(segment.start.y);
+			const __m256 rx = _mm256_set1_ps(segment.end.x - segment.start.x);
+			const __m256 ry = _mm256_set1_ps(segment.end.y - segment.start.y);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 bx = _mm256_loadu_ps(&batch.startX[i]);
+				__m256 by = _mm256_loadu_ps(&batch.startY[i]);
+				__m256 sx = _mm256_sub_ps(_mm256_loadu_ps(&batch.endX[i]), bx);
+				__m256 sy = _mm256_sub_ps(_mm256_loadu_ps(&batch.endY[i]), by);
+				__m256 qpx = _mm256_sub_ps(bx, ax);
+				__m256 qpy = _mm256_sub_ps(by, ay);
+
+				__m256 denominator = _mm256_sub_ps(_mm256_mul_ps(rx, sy), _mm256_mul_ps(ry, sx));
+				__m256 tv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, sy), _mm256_mul_ps(qpy, sx)), denominator);
+				__m256 uv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, ry), _mm256_mul_ps(qpy, rx)), denominator);
+				__m256 crossing = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(tv, zero, _CMP_GE_OQ), _mm256_cmp_ps(tv, one, _CMP_LE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(uv, zero, _CMP_GE_OQ), _mm256_cmp_ps(uv, one, _CMP_LE_OQ)));
+
+				if (t) {
+					_mm256_storeu_ps(t + i, _mm256_and_ps(tv, crossing));
+				}
+				if (u) {
+					_mm256_storeu_ps(u + i, _mm256_and_ps(uv, crossing));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(crossing)), 8, results + i);
+				hits += fix_parallel_lanes(segment, batch, results, t, u, i, static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(denominator, zero, _CMP_EQ_OQ))));
+			}
+			return hits + line_segments_intersect_range(segment, batch, results, t, u, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t line_segment_aabb_clip_batch_avx2(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			const vec_t direction = segment.end - segment.start;
+			const __m256 sx = _mm256_set1_ps(segment.start.x);
+			const __m256 sy = _mm256_set1_ps(segment.start.y);
+			const __m256 inverseX = _mm256_set1_ps(direction.x != 0.f ? 1.f / direction.x : 0.f);
+			const __m256 inverseY = _mm256_set1_ps(direction.y != 0.f ? 1.f / direction.y : 0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&batch.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&batch.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&batch.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&batch.maxY[i]);
+				__m256 tEntry = _mm256_setzero_ps();
+				__m256 tExit = _mm256_set1_ps(1.f);
+				__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+				// The direction is the same for every lane, so are the branches
+				if (direction.x != 0.f) {
+					__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(minX, sx), inverseX);
+					__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(maxX, sx), inverseX);
+					tEntry = _mm256_max_ps(tEntry, _mm256_min_ps(t1, t2));
+					tExit = _mm256_min_ps(tExit, _mm256_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(minX, sx, _CMP_LE_OQ), _mm256_cmp_ps(maxX, sx, _CMP_GE_OQ)));
+				}
+				if (direction.y != 0.f) {
+					__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(minY, sy), inverseY);
+					__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(maxY, sy), inverseY);
+					tEntry = _mm256_max_ps(tEntry, _mm256_min_ps(t1, t2));
+					tExit = _mm256_min_ps(tExit, _mm256_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(minY, sy, _CMP_LE_OQ), _mm256_cmp_ps(maxY, sy, _CMP_GE_OQ)));
+				}
+
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(tEntry, tExit, _CMP_LE_OQ));
+				if (entry) {
+					_mm256_storeu_ps(entry + i, _mm256_and_ps(tEntry, inside));
+				}
+				if (exit) {
+					_mm256_storeu_ps(exit + i, _mm256_and_ps(tExit, inside));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + line_segment_aabb_clip_range(segment, batch, results, entry, exit, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_aabb_collision_batch_avx2(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 radius = _mm256_set1_ps(circle.radius);
+			const __m256 radiusSquared = _mm256_set1_ps(circle.radius * circle.radius);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 minusOne = _mm256_set1_ps(-1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&batch.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&batch.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&batch.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&batch.maxY[i]);
+
+				__m256 dx = _mm256_sub_ps(cx, _mm256_min_ps(_mm256_max_ps(cx, minX), maxX));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_min_ps(_mm256_max_ps(cy, minY), maxY));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 overlap = _mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				__m256 outside = _mm256_cmp_ps(distanceSquared, zero, _CMP_GT_OQ);
+
+				// Center outside of the box : the normal goes from the closest point towards the center
+				__m256 distance = _mm256_sqrt_ps(distanceSquared);
+				__m256 outsideX = _mm256_div_ps(dx, distance);
+				__m256 outsideY = _mm256_div_ps(dy, distance);
+				__m256 outsideDepth = _mm256_sub_ps(radius, distance);
+
+				// Center inside of the box : the circle is pushed out through the closest side
+				__m256 left = _mm256_sub_ps(cx, minX);
+				__m256 right = _mm256_sub_ps(maxX, cx);
+				__m256 top = _mm256_sub_ps(cy, minY);
+				__m256 bottom = _mm256_sub_ps(maxY, cy);
+				__m256 closestX = _mm256_min_ps(left, right);
+				__m256 closestY = _mm256_min_ps(top, bottom);
+				__m256 alongX = _mm256_cmp_ps(closestX, closestY, _CMP_LT_OQ);
+				__m256 insideX = _mm256_and_ps(alongX, _mm256_blendv_ps(one, minusOne, _mm256_cmp_ps(left, right, _CMP_LT_OQ)));
+				__m256 insideY = _mm256_andnot_ps(alongX, _mm256_blendv_ps(one, minusOne, _mm256_cmp_ps(top, bottom, _CMP_LT_OQ)));
+				__m256 insideDepth = _mm256_add_ps(radius, _mm256_min_ps(closestX, closestY));
+
+				if (normalX) {
+					_mm256_storeu_ps(normalX + i, _mm256_and_ps(overlap, _mm256_blendv_ps(insideX, outsideX, outside)));
+				}
+				if (normalY) {
+					_mm256_storeu_ps(normalY + i, _mm256_and_ps(overlap, _mm256_blendv_ps(insideY, outsideY, outside)));
+				}
+				if (depth) {
+					_mm256_storeu_ps(depth + i, _mm256_and_ps(overlap, _mm256_blendv_ps(insideDepth, outsideDepth, outside)));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(overlap)), 8, results + i);
+			}
+			return hits + circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, i);
+		}
+
+		/**
+		 * \brief Splits 8 consecutive pairs into the indices of the first and of the second AABBs.
+		 */
+		CH_SIMD_TARGET("avx2")
+		static void load_pair_indices_avx2(const AABBIndexPair* pairs, __m256i& first, __m256i& second) {
+			const __m256i evenThenOdd = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			__m256i low = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs)), evenThenOdd);
+			__m256i high = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs + 4)), evenThenOdd);
+			first = _mm256_permute2x128_si256(low, high, 0x20);
+			second = _mm256_permute2x128_si256(low, high, 0x31);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_collision_batch_avx2(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 minusOne = _mm256_set1_ps(-1.f);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			alignas(32) float normalX[8];
+			alignas(32) float normalY[8];
+			alignas(32) float deltaX[8];
+			alignas(32) float deltaY[8];
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256i first, second;
+				load_pair_indices_avx2(pairs + i, first, second);
+				__m256 minX1 = _mm256_i32gather_ps(batch.minX.data(), first, 4);
+				__m256 minY1 = _mm256_i32gather_ps(batch.minY.data(), first, 4);
+				__m256 maxX1 = _mm256_i32gather_ps(batch.maxX.data(), first, 4);
+				__m256 maxY1 = _mm256_i32gather_ps(batch.maxY.data(), first, 4);
+				__m256 minX2 = _mm256_i32gather_ps(batch.minX.data(), second, 4);
+				__m256 minY2 = _mm256_i32gather_ps(batch.minY.data(), second, 4);
+				__m256 maxX2 = _mm256_i32gather_ps(batch.maxX.data(), second, 4);
+				__m256 maxY2 = _mm256_i32gather_ps(batch.maxY.data(), second, 4);
+
+				__m256 intersects = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(maxX1, minX2, _CMP_GE_OQ), _mm256_cmp_ps(maxY1, minY2, _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(minX1, maxX2, _CMP_LE_OQ), _mm256_cmp_ps(minY1, maxY2, _CMP_LE_OQ)));
+
+				// Side of the first AABB closest to the center of the second one, on each axis
+				__m256 left = _mm256_cmp_ps(_mm256_add_ps(minX2, maxX2), _mm256_add_ps(minX1, maxX1), _CMP_LE_OQ);
+				__m256 top = _mm256_cmp_ps(_mm256_add_ps(minY2, maxY2), _mm256_add_ps(minY1, maxY1), _CMP_LE_OQ);
+				__m256 dx = _mm256_andnot_ps(signMask, _mm256_blendv_ps(_mm256_sub_ps(maxX1, minX2), _mm256_sub_ps(minX1, maxX2), left));
+				__m256 dy = _mm256_andnot_ps(signMask, _mm256_blendv_ps(_mm256_sub_ps(maxY1, minY2), _mm256_sub_ps(minY1, maxY2), top));
+				__m256 vertical = _mm256_cmp_ps(dx, dy, _CMP_GT_OQ);
+
+				_mm256_store_ps(normalX, _mm256_and_ps(intersects, _mm256_andnot_ps(vertical, _mm256_blendv_ps(one, minusOne, left))));
+				_mm256_store_ps(normalY, _mm256_and_ps(intersects, _mm256_and_ps(vertical, _mm256_blendv_ps(one, minusOne, top))));
+				_mm256_store_ps(deltaX, _mm256_and_ps(intersects, dx));
+				_mm256_store_ps(deltaY, _mm256_and_ps(intersects, dy));
+				hits += write_aabb_collision_lanes(normalX, normalY, deltaX, deltaY, 8, collisions + i);
+			}
+			return hits + aabb_collision_range(batch, pairs, count, collisions, i);
+		}
+
+		/**
+		 * \brief Selects a where the mask is set, b elsewhere.
+		 */
+		CH_SIMD_TARGET("avx2")
+		static __m256 select_avx2(__m256 mask, __m256 a, __m256 b) {
+			return _mm256_blendv_ps(b, a, mask);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static void circle_sweep_batch_avx2(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 r = _mm256_set1_ps(circle.radius);
+			const __m256 r2 = _mm256_set1_ps(circle.radius * circle.radius);
+			const __m256 dx = _mm256_set1_ps(motion.x);
+			const __m256 dy = _mm256_set1_ps(motion.y);
+			const __m256 dd = _mm256_set1_ps(motion.x * motion.x + motion.y * motion.y);
+			const __m256 moving = _mm256_cmp_ps(dd, _mm256_setzero_ps(), _CMP_GT_OQ);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+			const __m256 signBit = _mm256_set1_ps(-0.f);
+
+			size_t i = 0;
+			alignas(32) float times[8];
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 ax = _mm256_loadu_ps(&batch.startX[i]);
+				__m256 ay = _mm256_loadu_ps(&batch.startY[i]);
+				__m256 ex = _mm256_sub_ps(_mm256_loadu_ps(&batch.endX[i]), ax);
+				__m256 ey = _mm256_sub_ps(_mm256_loadu_ps(&batch.endY[i]), ay);
+				__m256 mx = _mm256_sub_ps(cx, ax);
+				__m256 my = _mm256_sub_ps(cy, ay);
+				__m256 ee = _mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey));
+				__m256 notPoint = _mm256_cmp_ps(ee, zero, _CMP_GT_OQ);
+
+				// Already intersecting (distance from the center to the closest point of the segment)
+				__m256 u0 = _mm256_and_ps(_mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(mx, ex), _mm256_mul_ps(my, ey)), ee), notPoint);
+				u0 = _mm256_min_ps(_mm256_max_ps(u0, zero), one);
+				__m256 qx = _mm256_sub_ps(_mm256_mul_ps(ex, u0), mx);
+				__m256 qy = _mm256_sub_ps(_mm256_mul_ps(ey, u0), my);
+				__m256 intersecting = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(qx, qx), _mm256_mul_ps(qy, qy)), r2, _CMP_LT_OQ);
+
+				// Side of the segment
+				__m256 length = _mm256_sqrt_ps(ee);
+				__m256 nx = _mm256_div_ps(_mm256_xor_ps(ey, signBit), length);
+				__m256 ny = _mm256_div_ps(ex, length);
+				__m256 side = _mm256_add_ps(_mm256_mul_ps(mx, nx), _mm256_mul_ps(my, ny));
+				__m256 flip = _mm256_and_ps(side, signBit);
+				nx = _mm256_xor_ps(nx, flip);
+				ny = _mm256_xor_ps(ny, flip);
+				side = _mm256_xor_ps(side, flip);
+				__m256 approach = _mm256_add_ps(_mm256_mul_ps(dx, nx), _mm256_mul_ps(dy, ny));
+				__m256 tSide = _mm256_div_ps(_mm256_sub_ps(side, r), _mm256_xor_ps(approach, signBit));
+				__m256 px = _mm256_sub_ps(_mm256_add_ps(mx, _mm256_mul_ps(dx, tSide)), _mm256_mul_ps(nx, r));
+				__m256 py = _mm256_sub_ps(_mm256_add_ps(my, _mm256_mul_ps(dy, tSide)), _mm256_mul_ps(ny, r));
+				__m256 u = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(px, ex), _mm256_mul_ps(py, ey)), ee);
+				__m256 sideHit = _mm256_and_ps(_mm256_and_ps(notPoint, _mm256_cmp_ps(approach, zero, _CMP_LT_OQ)),
+					_mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(tSide, zero, _CMP_GE_OQ), _mm256_cmp_ps(tSide, one, _CMP_LE_OQ)), _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ))));
+				__m256 best = select_avx2(sideHit, tSide, infinity);
+
+				// Extremities of the segment
+				for (int extremity = 0; extremity < 2; ++extremity) {
+					__m256 tx = extremity == 0 ? mx : _mm256_sub_ps(mx, ex);
+					__m256 ty = extremity == 0 ? my : _mm256_sub_ps(my, ey);
+					__m256 b = _mm256_add_ps(_mm256_mul_ps(tx, dx), _mm256_mul_ps(ty, dy));
+					__m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(tx, tx), _mm256_mul_ps(ty, ty)), r2);
+					__m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(dd, c));
+					__m256 t = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(b, signBit), _mm256_sqrt_ps(_mm256_max_ps(discriminant, zero))), dd);
+					__m256 extremityHit = _mm256_and_ps(_mm256_and_ps(moving, _mm256_cmp_ps(b, zero, _CMP_LT_OQ)), _mm256_and_ps(_mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, one, _CMP_LE_OQ)));
+					best = _mm256_min_ps(best, select_avx2(extremityHit, t, infinity));
+				}
+
+				best = select_avx2(intersecting, zero, best);
+				if (_mm256_movemask_ps(_mm256_cmp_ps(best, _mm256_set1_ps(earliest), _CMP_LT_OQ)) != 0) {
+					_mm256_store_ps(times, best);
+					keep_earliest_lane(times, 8, i, earliest, earliestIndex);
+				}
+			}
+			circle_sweep_range(circle, motion, batch, earliest, earliestIndex, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_obb_intersects_batch_avx2(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			const float halfWidth = aabb.size.x / 2.f;
+			const float halfHeight = aabb.size.y / 2.f;
+			const __m256 halfX = _mm256_set1_ps(halfWidth);
+			const __m256 halfY = _mm256_set1_ps(halfHeight);
+			const __m256 centerX = _mm256_set1_ps(aabb.pos.x + halfWidth);
+			const __m256 centerY = _mm256_set1_ps(aabb.pos.y + halfHeight);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 tx = _mm256_sub_ps(_mm256_loadu_ps(&batch.centerX[i]), centerX);
+				__m256 ty = _mm256_sub_ps(_mm256_loadu_ps(&batch.centerY[i]), centerY);
+				__m256 cosine = _mm256_loadu_ps(&batch.cosine[i]);
+				__m256 sine = _mm256_loadu_ps(&batch.sine[i]);
+				__m256 absCosine = _mm256_andnot_ps(signMask, cosine);
+				__m256 absSine = _mm256_andnot_ps(signMask, sine);
+				__m256 obbHalfX = _mm256_loadu_ps(&batch.halfWidth[i]);
+				__m256 obbHalfY = _mm256_loadu_ps(&batch.halfHeight[i]);
+				__m256 extentX = _mm256_add_ps(halfX, _mm256_add_ps(_mm256_mul_ps(obbHalfX, absCosine), _mm256_mul_ps(obbHalfY, absSine)));
+				__m256 extentY = _mm256_add_ps(halfY, _mm256_add_ps(_mm256_mul_ps(obbHalfX, absSine), _mm256_mul_ps(obbHalfY, absCosine)));
+				__m256 extentU = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(halfX, absCosine), _mm256_mul_ps(halfY, absSine)), obbHalfX);
+				__m256 extentV = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(halfX, absSine), _mm256_mul_ps(halfY, absCosine)), obbHalfY);
+				__m256 projectedU = _mm256_andnot_ps(signMask, _mm256_add_ps(_mm256_mul_ps(tx, cosine), _mm256_mul_ps(ty, sine)));
+				__m256 projectedV = _mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_mul_ps(ty, cosine), _mm256_mul_ps(tx, sine)));
+				__m256 inside = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, tx), extentX, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, ty), extentY, _CMP_LT_OQ)), _mm256_and_ps(_mm256_cmp_ps(projectedU, extentU, _CMP_LT_OQ), _mm256_cmp_ps(projectedV, extentV, _CMP_LT_OQ)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_obb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_obb_intersects_batch_avx2(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 radiusSquared = _mm256_set1_ps(circle.radius * circle.radius);
+			const __m256 zero = _mm256_set1_ps(0.f);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 dx = _mm256_sub_ps(cx, _mm256_loadu_ps(&batch.centerX[i]));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_loadu_ps(&batch.centerY[i]));
+				__m256 cosine = _mm256_loadu_ps(&batch.cosine[i]);
+				__m256 sine = _mm256_loadu_ps(&batch.sine[i]);
+				__m256 localX = _mm256_add_ps(_mm256_mul_ps(dx, cosine), _mm256_mul_ps(dy, sine));
+				__m256 localY = _mm256_sub_ps(_mm256_mul_ps(dy, cosine), _mm256_mul_ps(dx, sine));
+				__m256 outsideX = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, localX), _mm256_loadu_ps(&batch.halfWidth[i])), zero);
+				__m256 outsideY = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, localY), _mm256_loadu_ps(&batch.halfHeight[i])), zero);
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(outsideX, outsideX), _mm256_mul_ps(outsideY, outsideY));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_obb_intersects_range(circle, batch, results, i);
+		}
+
+		/**
+		 * \brief Squared distance between a corner of the boxes of 8 lanes and the segment of a capsule.
+		 */
+		CH_SIMD_TARGET("avx2")
+		static __m256 capsule_batch_corner_distance_avx2(__m256 x, __m256 y, __m256 startX, __m256 startY, __m256 directionX, __m256 directionY, __m256 inverseLengthSquared, __m256 zero, __m256 one) {
+			__m256 t = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(x, startX), directionX), _mm256_mul_ps(_mm256_sub_ps(y, startY), directionY)), inverseLengthSquared), zero), one);
+			__m256 dx = _mm256_sub_ps(_mm256_add_ps(startX, _mm256_mul_ps(t, directionX)), x);
+			__m256 dy = _mm256_sub_ps(_mm256_add_ps(startY, _mm256_mul_ps(t, directionY)), y);
+			return _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t capsule_aabb_intersects_batch_avx2(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const __m256 startX = _mm256_set1_ps(query.startX);
+			const __m256 startY = _mm256_set1_ps(query.startY);
+			const __m256 endX = _mm256_set1_ps(query.startX + query.directionX);
+			const __m256 endY = _mm256_set1_ps(query.startY + query.directionY);
+			const __m256 directionX = _mm256_set1_ps(query.directionX);
+			const __m256 directionY = _mm256_set1_ps(query.directionY);
+			const __m256 inverseLengthSquared = _mm256_set1_ps(query.inverseLengthSquared);
+			const __m256 segmentMinX = _mm256_set1_ps(query.minX);
+			const __m256 segmentMinY = _mm256_set1_ps(query.minY);
+			const __m256 segmentMaxX = _mm256_set1_ps(query.maxX);
+			const __m256 segmentMaxY = _mm256_set1_ps(query.maxY);
+			const __m256 normalX = _mm256_set1_ps(query.normalX);
+			const __m256 normalY = _mm256_set1_ps(query.normalY);
+			const __m256 absNormalX = _mm256_set1_ps(query.absNormalX);
+			const __m256 absNormalY = _mm256_set1_ps(query.absNormalY);
+			const __m256 normalDotStart = _mm256_set1_ps(query.normalDotStart);
+			const __m256 radiusSquared = _mm256_set1_ps(query.radiusSquared);
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 zero = _mm256_set1_ps(0.f);
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&batch.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&batch.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&batch.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&batch.maxY[i]);
+
+				__m256 centerX = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+				__m256 centerY = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+				__m256 halfX = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+				__m256 halfY = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+				__m256 crossing = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(segmentMinX, maxX, _CMP_LT_OQ), _mm256_cmp_ps(segmentMaxX, minX, _CMP_GT_OQ)), _mm256_and_ps(_mm256_cmp_ps(segmentMinY, maxY, _CMP_LT_OQ), _mm256_cmp_ps(segmentMaxY, minY, _CMP_GT_OQ)));
+				crossing = _mm256_and_ps(crossing, _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(normalX, centerX), _mm256_mul_ps(normalY, centerY)), normalDotStart)), _mm256_add_ps(_mm256_mul_ps(halfX, absNormalX), _mm256_mul_ps(halfY, absNormalY)), _CMP_LT_OQ));
+
+				__m256 startDX = _mm256_sub_ps(startX, _mm256_min_ps(_mm256_max_ps(startX, minX), maxX));
+				__m256 startDY = _mm256_sub_ps(startY, _mm256_min_ps(_mm256_max_ps(startY, minY), maxY));
+				__m256 endDX = _mm256_sub_ps(endX, _mm256_min_ps(_mm256_max_ps(endX, minX), maxX));
+				__m256 endDY = _mm256_sub_ps(endY, _mm256_min_ps(_mm256_max_ps(endY, minY), maxY));
+				__m256 closest = _mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(startDX, startDX), _mm256_mul_ps(startDY, startDY)), _mm256_add_ps(_mm256_mul_ps(endDX, endDX), _mm256_mul_ps(endDY, endDY)));
+				closest = _mm256_min_ps(closest, _mm256_min_ps(capsule_batch_corner_distance_avx2(minX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx2(maxX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+				closest = _mm256_min_ps(closest, _mm256_min_ps(capsule_batch_corner_distance_avx2(minX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx2(maxX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+
+				__m256 inside = _mm256_or_ps(crossing, _mm256_cmp_ps(closest, radiusSquared, _CMP_LT_OQ));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + capsule_aabb_intersects_range(capsule, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_intersects_pairwise_avx2(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= first.size(); i += 8) {
+				__m256 inside = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&first.maxX[i]), _mm256_loadu_ps(&other.minX[i]), _CMP_GE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&first.maxY[i]), _mm256_loadu_ps(&other.minY[i]), _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&first.minX[i]), _mm256_loadu_ps(&other.maxX[i]), _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&first.minY[i]), _mm256_loadu_ps(&other.maxY[i]), _CMP_LE_OQ)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_intersects_pairwise_avx2(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= first.size(); i += 8) {
+				__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&first.x[i]), _mm256_loadu_ps(&other.x[i]));
+				__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&first.y[i]), _mm256_loadu_ps(&other.y[i]));
+				__m256 radii = _mm256_add_ps(_mm256_loadu_ps(&first.radius[i]), _mm256_loadu_ps(&other.radius[i]));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radii, radii), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_circle_intersects_pairwise_avx2(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= aabbs.size(); i += 8) {
+				__m256 cx = _mm256_loadu_ps(&circles.x[i]);
+				__m256 cy = _mm256_loadu_ps(&circles.y[i]);
+				__m256 r = _mm256_loadu_ps(&circles.radius[i]);
+				__m256 dx = _mm256_sub_ps(cx, _mm256_min_ps(_mm256_max_ps(cx, _mm256_loadu_ps(&aabbs.minX[i])), _mm256_loadu_ps(&aabbs.maxX[i])));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_min_ps(_mm256_max_ps(cy, _mm256_loadu_ps(&aabbs.minY[i])), _mm256_loadu_ps(&aabbs.maxY[i])));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(r, r), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_circle_intersects_pairwise_range(aabbs, circles, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t line_segments_intersect_pairwise_avx2(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= first.size(); i += 8) {
+				__m256 ax = _mm256_loadu_ps(&first.startX[i]);
+				__m256 ay = _mm256_loadu_ps(&first.startY[i]);
+				__m256 rx = _mm256_sub_ps(_mm256_loadu_ps(&first.endX[i]), ax);
+				__m256 ry = _mm256_sub_ps(_mm256_loadu_ps(&first.endY[i]), ay);
+				__m256 bx = _mm256_loadu_ps(&other.startX[i]);
+				__m256 by = _mm256_loadu_ps(&other.startY[i]);
+				__m256 sx = _mm256_sub_ps(_mm256_loadu_ps(&other.endX[i]), bx);
+				__m256 sy = _mm256_sub_ps(_mm256_loadu_ps(&other.endY[i]), by);
+				__m256 qpx = _mm256_sub_ps(bx, ax);
+				__m256 qpy = _mm256_sub_ps(by, ay);
+
+				__m256 denominator = _mm256_sub_ps(_mm256_mul_ps(rx, sy), _mm256_mul_ps(ry, sx));
+				__m256 tv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, sy), _mm256_mul_ps(qpy, sx)), denominator);
+				__m256 uv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, ry), _mm256_mul_ps(qpy, rx)), denominator);
+				__m256 crossing = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(tv, zero, _CMP_GE_OQ), _mm256_cmp_ps(tv, one, _CMP_LE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(uv, zero, _CMP_GE_OQ), _mm256_cmp_ps(uv, one, _CMP_LE_OQ)));
+
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(crossing)), 8, results + i);
+				hits += fix_parallel_pairwise_lanes(first, other, results, i, static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(denominator, zero, _CMP_EQ_OQ))));
+			}
+			return hits + line_segments_intersect_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_segment_intersects_pairwise_avx2(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= aabbs.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&aabbs.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&aabbs.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&aabbs.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&aabbs.maxY[i]);
+				__m256 sx = _mm256_loadu_ps(&segments.startX[i]);
+				__m256 sy = _mm256_loadu_ps(&segments.startY[i]);
+				__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&segments.endX[i]), sx);
+				__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&segments.endY[i]), sy);
+
+				// Each lane has its own direction : the lanes parallel to an axis are masked instead of branched on
+				__m256 parallelX = _mm256_cmp_ps(dx, zero, _CMP_EQ_OQ);
+				__m256 parallelY = _mm256_cmp_ps(dy, zero, _CMP_EQ_OQ);
+				__m256 inverseX = _mm256_div_ps(one, dx);
+				__m256 inverseY = _mm256_div_ps(one, dy);
+
+				__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(minX, sx), inverseX);
+				__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(maxX, sx), inverseX);
+				__m256 tEntry = _mm256_max_ps(zero, select_avx2(parallelX, zero, _mm256_min_ps(t1, t2)));
+				__m256 tExit = _mm256_min_ps(one, select_avx2(parallelX, one, _mm256_max_ps(t1, t2)));
+				t1 = _mm256_mul_ps(_mm256_sub_ps(minY, sy), inverseY);
+				t2 = _mm256_mul_ps(_mm256_sub_ps(maxY, sy), inverseY);
+				tEntry = _mm256_max_ps(tEntry, select_avx2(parallelY, zero, _mm256_min_ps(t1, t2)));
+				tExit = _mm256_min_ps(tExit, select_avx2(parallelY, one, _mm256_max_ps(t1, t2)));
+
+				__m256 betweenX = _mm256_and_ps(_mm256_cmp_ps(minX, sx, _CMP_LE_OQ), _mm256_cmp_ps(maxX, sx, _CMP_GE_OQ));
+				__m256 betweenY = _mm256_and_ps(_mm256_cmp_ps(minY, sy, _CMP_LE_OQ), _mm256_cmp_ps(maxY, sy, _CMP_GE_OQ));
+				__m256 inside = _mm256_and_ps(
+					_mm256_and_ps(select_avx2(parallelX, betweenX, _mm256_castsi256_ps(_mm256_set1_epi32(-1))), select_avx2(parallelY, betweenY, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))),
+					_mm256_cmp_ps(tEntry, tExit, _CMP_LE_OQ));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_segment_intersects_pairwise_range(aabbs, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_segment_intersects_pairwise_avx2(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= circles.size(); i += 8) {
+				__m256 cx = _mm256_loadu_ps(&circles.x[i]);
+				__m256 cy = _mm256_loadu_ps(&circles.y[i]);
+				__m256 r = _mm256_loadu_ps(&circles.radius[i]);
+				__m256 sx = _mm256_loadu_ps(&segments.startX[i]);
+				__m256 sy = _mm256_loadu_ps(&segments.startY[i]);
+				__m256 ex = _mm256_sub_ps(_mm256_loadu_ps(&segments.endX[i]), sx);
+				__m256 ey = _mm256_sub_ps(_mm256_loadu_ps(&segments.endY[i]), sy);
+
+				// Closest point of the segment, its start if the segment is a point
+				__m256 lengthSquared = _mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey));
+				__m256 u = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(cx, sx), ex), _mm256_mul_ps(_mm256_sub_ps(cy, sy), ey)), lengthSquared);
+				u = select_avx2(_mm256_cmp_ps(lengthSquared, zero, _CMP_EQ_OQ), zero, _mm256_min_ps(_mm256_max_ps(u, zero), one));
+				__m256 dx = _mm256_sub_ps(cx, _mm256_add_ps(sx, _mm256_mul_ps(ex, u)));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_add_ps(sy, _mm256_mul_ps(ey, u)));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(r, r), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_segment_intersects_pairwise_range(circles, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t aabb_intersects_batch_avx512(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			const __m512 minX = _mm512_set1_ps(aabb.pos.x);
+			const __m512 minY = _mm512_set1_ps(aabb.pos.y);
+			const __m512 maxX = _mm512_set1_ps(aabb.pos.x + aabb.size.x);
+			const __m512 maxY = _mm512_set1_ps(aabb.pos.y + aabb.size.y);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__mmask16 inside = _mm512_cmp_ps_mask(maxX, _mm512_loadu_ps(&batch.minX[i]), _CMP_GE_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, maxY, _mm512_loadu_ps(&batch.minY[i]), _CMP_GE_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, minX, _mm512_loadu_ps(&batch.maxX[i]), _CMP_LE_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, minY, _mm512_loadu_ps(&batch.maxY[i]), _CMP_LE_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + aabb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t circle_intersects_batch_avx512(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			const __m512 cx = _mm512_set1_ps(circle.pos.x);
+			const __m512 cy = _mm512_set1_ps(circle.pos.y);
+			const __m512 cr = _mm512_set1_ps(circle.radius);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 dx = _mm512_sub_ps(cx, _mm512_loadu_ps(&batch.x[i]));
+				__m512 dy = _mm512_sub_ps(cy, _mm512_loadu_ps(&batch.y[i]));
+				__m512 radii = _mm512_add_ps(cr, _mm512_loadu_ps(&batch.radius[i]));
+				__m512 distanceSquared = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+				__mmask16 inside = _mm512_cmp_ps_mask(distanceSquared, _mm512_mul_ps(radii, radii), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + circle_intersects_range(circle, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t line_segments_intersect_batch_avx512(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			const __m512 ax = _mm512_set1_ps(segment.start.x);
+			const __m512 ay = _mm512_set1_ps(segment.start.y);
+			const __m512 rx = _mm512_set1_ps(segment.end.x - segment.start.x);
+			const __m512 ry = _mm512_set1_ps(segment.end.y - segment.start.y);
+			const __m512 zero = _mm512_setzero_ps();
+			const __m512 one = _mm512_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 bx = _mm512_loadu_ps(&batch.startX[i]);
+				__m512 by = _mm512_loadu_ps(&batch.startY[i]);
+				__m512 sx = _mm512_sub_ps(_mm512_loadu_ps(&batch.endX[i]), bx);
+				__m512 sy = _mm512_sub_ps(_mm512_loadu_ps(&batch.endY[i]), by);
+				__m512 qpx = _mm512_sub_ps(bx, ax);
+				__m512 qpy = _mm512_sub_ps(by, ay);
+
+				__m512 denominator = _mm512_sub_ps(_mm512_mul_ps(rx, sy), _mm512_mul_ps(ry, sx));
+				__m512 tv = _mm512_div_ps(_mm512_sub_ps(_mm512_mul_ps(qpx, sy), _mm512_mul_ps(qpy, sx)), denominator);
+				__m512 uv = _mm512_div_ps(_mm512_sub_ps(_mm512_mul_ps(qpx, ry), _mm512_mul_ps(qpy, rx)), denominator);
+				__mmask16 crossing = _mm512_cmp_ps_mask(tv, zero, _CMP_GE_OQ);
+				crossing = _mm512_mask_cmp_ps_mask(crossing, tv, one, _CMP_LE_OQ);
+				crossing = _mm512_mask_cmp_ps_mask(crossing, uv, zero, _CMP_GE_OQ);
+				crossing = _mm512_mask_cmp_ps_mask(crossing, uv, one, _CMP_LE_OQ);
+
+				if (t) {
+					_mm512_storeu_ps(t + i, _mm512_maskz_mov_ps(crossing, tv));
+				}
+				if (u) {
+					_mm512_storeu_ps(u + i, _mm512_maskz_mov_ps(crossing, uv));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(crossing), 16, results + i);
+				hits += fix_parallel_lanes(segment, batch, results, t, u, i, static_cast<unsigned int>(_mm512_cmp_ps_mask(denominator, zero, _CMP_EQ_OQ)));
+			}
+			return hits + line_segments_intersect_range(segment, batch, results, t, u, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t line_segment_aabb_clip_batch_avx512(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			const vec_t direction = segment.end - segment.start;
+			const __m512 sx = _mm512_set1_ps(segment.start.x);
+			const __m512 sy = _mm512_set1_ps(segment.start.y);
+			const __m512 inverseX = _mm512_set1_ps(direction.x != 0.f ? 1.f / direction.x : 0.f);
+			const __m512 inverseY = _mm512_set1_ps(direction.y != 0.f ? 1.f / direction.y : 0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 minX = _mm512_loadu_ps(&batch.minX[i]);
+				__m512 minY = _mm512_loadu_ps(&batch.minY[i]);
+				__m512 maxX = _mm512_loadu_ps(&batch.maxX[i]);
+				__m512 maxY = _mm512_loadu_ps(&batch.maxY[i]);
+				__m512 tEntry = _mm512_setzero_ps();
+				__m512 tExit = _mm512_set1_ps(1.f);
+				__mmask16 inside = 0xFFFF;
+
+				// The direction is the same for every lane, so are the branches
+				if (direction.x != 0.f) {
+					__m512 t1 = _mm512_mul_ps(_mm512_sub_ps(minX, sx), inverseX);
+					__m512 t2 = _mm512_mul_ps(_mm512_sub_ps(maxX, sx), inverseX);
+					tEntry = _mm512_max_ps(tEntry, _mm512_min_ps(t1, t2));
+					tExit = _mm512_min_ps(tExit, _mm512_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm512_mask_cmp_ps_mask(inside, minX, sx, _CMP_LE_OQ);
+					inside = _mm512_mask_cmp_ps_mask(inside, maxX, sx, _CMP_GE_OQ);
+				}
+				if (direction.y != 0.f) {
+					__m512 t1 = _mm512_mul_ps(_mm512_sub_ps(minY, sy), inverseY);
+					__m512 t2 = _mm512_mul_ps(_mm512_sub_ps(maxY, sy), inverseY);
+					tEntry = _mm512_max_ps(tEntry, _mm512_min_ps(t1, t2));
+					tExit = _mm512_min_ps(tExit, _mm512_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm512_mask_cmp_ps_mask(inside, minY, sy, _CMP_LE_OQ);
+					inside = _mm512_mask_cmp_ps_mask(inside, maxY, sy, _CMP_GE_OQ);
+				}
+
+				inside = _mm512_mask_cmp_ps_mask(inside, tEntry, tExit, _CMP_LE_OQ);
+				if (entry) {
+					_mm512_storeu_ps(entry + i, _mm512_maskz_mov_ps(inside, tEntry));
+				}
+				if (exit) {
+					_mm512_storeu_ps(exit + i, _mm512_maskz_mov_ps(inside, tExit));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + line_segment_aabb_clip_range(segment, batch, results, entry, exit, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t circle_aabb_collision_batch_avx512(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			const __m512 cx = _mm512_set1_ps(circle.pos.x);
+			const __m512 cy = _mm512_set1_ps(circle.pos.y);
+			const __m512 radius = _mm512_set1_ps(circle.radius);
+			const __m512 radiusSquared = _mm512_set1_ps(circle.radius * circle.radius);
+			const __m512 zero = _mm512_setzero_ps();
+			const __m512 one = _mm512_set1_ps(1.f);
+			const __m512 minusOne = _mm512_set1_ps(-1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 minX = _mm512_loadu_ps(&batch.minX[i]);
+				__m512 minY = _mm512_loadu_ps(&batch.minY[i]);
+				__m512 maxX = _mm512_loadu_ps(&batch.maxX[i]);
+				__m512 maxY = _mm512_loadu_ps(&batch.maxY[i]);
+
+				__m512 dx = _mm512_sub_ps(cx, _mm512_min_ps(_mm512_max_ps(cx, minX), maxX));
+				__m512 dy = _mm512_sub_ps(cy, _mm512_min_ps(_mm512_max_ps(cy, minY), maxY));
+				__m512 distanceSquared = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+				__mmask16 overlap = _mm512_cmp_ps_mask(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				__mmask16 outside = _mm512_cmp_ps_mask(distanceSquared, zero, _CMP_GT_OQ);
+
+				// Center outside of the box : the normal goes from the closest point towards the center
+				__m512 distance = _mm512_sqrt_ps(distanceSquared);
+				__m512 outsideX = _mm512_div_ps(dx, distance);
+				__m512 outsideY = _mm512_div_ps(dy, distance);
+				__m512 outsideDepth = _mm512_sub_ps(radius, distance);
+
+				// Center inside of the box : the circle is pushed out through the closest side
+				__m512 left = _mm512_sub_ps(cx, minX);
+				__m512 right = _mm512_sub_ps(maxX, cx);
+				__m512 top = _mm512_sub_ps(cy, minY);
+				__m512 bottom = _mm512_sub_ps(maxY, cy);
+				__m512 closestX = _mm512_min_ps(left, right);
+				__m512 closestY = _mm512_min_ps(top, bottom);
+				__mmask16 alongX = _mm512_cmp_ps_mask(closestX, closestY, _CMP_LT_OQ);
+				__m512 insideX = _mm512_maskz_mov_ps(alongX, _mm512_mask_blend_ps(_mm512_cmp_ps_mask(left, right, _CMP_LT_OQ), one, minusOne));
+				__m512 insideY = _mm512_maskz_mov_ps(static_cast<__mmask16>(~alongX), _mm512_mask_blend_ps(_mm512_cmp_ps_mask(top, bottom, _CMP_LT_OQ), one, minusOne));
+				__m512 insideDepth = _mm512_add_ps(radius, _mm512_min_ps(closestX, closestY));
+
+				if (normalX) {
+					_mm512_storeu_ps(normalX + i, _mm512_maskz_mov_ps(overlap, _mm512_mask_blend_ps(outside, insideX, outsideX)));
+				}
+				if (normalY) {
+					_mm512_storeu_ps(normalY + i, _mm512_maskz_mov_ps(overlap, _mm512_mask_blend_ps(outside, insideY, outsideY)));
+				}
+				if (depth) {
+					_mm512_storeu_ps(depth + i, _mm512_maskz_mov_ps(overlap, _mm512_mask_blend_ps(outside, insideDepth, outsideDepth)));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(overlap), 16, results + i);
+			}
+			return hits + circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t aabb_collision_batch_avx512(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			const __m512i evenIndices = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+			const __m512i oddIndices = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+			const __m512 one = _mm512_set1_ps(1.f);
+			const __m512 minusOne = _mm512_set1_ps(-1.f);
+
+			alignas(64) float normalX[16];
+			alignas(64) float normalY[16];
+			alignas(64) float deltaX[16];
+			alignas(64) float deltaY[16];
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= count; i += 16) {
+				__m512i low = _mm512_loadu_si512(pairs + i);
+				__m512i high = _mm512_loadu_si512(pairs + i + 8);
+				__m512i first = _mm512_permutex2var_epi32(low, evenIndices, high);
+				__m512i second = _mm512_permutex2var_epi32(low, oddIndices, high);
+				__m512 minX1 = _mm512_i32gather_ps(first, batch.minX.data(), 4);
+				__m512 minY1 = _mm512_i32gather_ps(first, batch.minY.data(), 4);
+				__m512 maxX1 = _mm512_i32gather_ps(first, batch.maxX.data(), 4);
+				__m512 maxY1 = _mm512_i32gather_ps(first, batch.maxY.data(), 4);
+				__m512 minX2 = _mm512_i32gather_ps(second, batch.minX.data(), 4);
+				__m512 minY2 = _mm512_i32gather_ps(second, batch.minY.data(), 4);
+				__m512 maxX2 = _mm512_i32gather_ps(second, batch.maxX.data(), 4);
+				__m512 maxY2 = _mm512_i32gather_ps(second, batch.maxY.data(), 4);
+
+				__mmask16 intersects = _mm512_cmp_ps_mask(maxX1, minX2, _CMP_GE_OQ);
+				intersects = _mm512_mask_cmp_ps_mask(intersects, maxY1, minY2, _CMP_GE_OQ);
+				intersects = _mm512_mask_cmp_ps_mask(intersects, minX1, maxX2, _CMP_LE_OQ);
+				intersects = _mm512_mask_cmp_ps_mask(intersects, minY1, maxY2, _CMP_LE_OQ);
+
+				// Side of the first AABB closest to the center of the second one, on each axis
+				__mmask16 left = _mm512_cmp_ps_mask(_mm512_add_ps(minX2, maxX2), _mm512_add_ps(minX1, maxX1), _CMP_LE_OQ);
+				__mmask16 top = _mm512_cmp_ps_mask(_mm512_add_ps(minY2, maxY2), _mm512_add_ps(minY1, maxY1), _CMP_LE_OQ);
+				__m512 dx = _mm512_abs_ps(_mm512_mask_blend_ps(left, _mm512_sub_ps(maxX1, minX2), _mm512_sub_ps(minX1, maxX2)));
+				__m512 dy = _mm512_abs_ps(_mm512_mask_blend_ps(top, _mm512_sub_ps(maxY1, minY2), _mm512_sub_ps(minY1, maxY2)));
+				__mmask16 vertical = _mm512_cmp_ps_mask(dx, dy, _CMP_GT_OQ);
+
+				_mm512_store_ps(normalX, _mm512_maskz_mov_ps(intersects & static_cast<__mmask16>(~vertical), _mm512_mask_blend_ps(left, one, minusOne)));
+				_mm512_store_ps(normalY, _mm512_maskz_mov_ps(intersects & vertical, _mm512_mask_blend_ps(top, one, minusOne)));
+				_mm512_store_ps(deltaX, _mm512_maskz_mov_ps(intersects, dx));
+				_mm512_store_ps(deltaY, _mm512_maskz_mov_ps(intersects, dy));
+				hits += write_aabb_collision_lanes(normalX, normalY, deltaX, deltaY, 16, collisions + i);
+			}
+			return hits + aabb_collision_range(batch, pairs, count, collisions, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t aabb_obb_intersects_batch_avx512(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			const float halfWidth = aabb.size.x / 2.f;
+			const float halfHeight = aabb.size.y / 2.f;
+			const __m512 halfX = _mm512_set1_ps(halfWidth);
+			const __m512 halfY = _mm512_set1_ps(halfHeight);
+			const __m512 centerX = _mm512_set1_ps(aabb.pos.x + halfWidth);
+			const __m512 centerY = _mm512_set1_ps(aabb.pos.y + halfHeight);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 tx = _mm512_sub_ps(_mm512_loadu_ps(&batch.centerX[i]), centerX);
+				__m512 ty = _mm512_sub_ps(_mm512_loadu_ps(&batch.centerY[i]), centerY);
+				__m512 cosine = _mm512_loadu_ps(&batch.cosine[i]);
+				__m512 sine = _mm512_loadu_ps(&batch.sine[i]);
+				__m512 absCosine = _mm512_abs_ps(cosine);
+				__m512 absSine = _mm512_abs_ps(sine);
+				__m512 obbHalfX = _mm512_loadu_ps(&batch.halfWidth[i]);
+				__m512 obbHalfY = _mm512_loadu_ps(&batch.halfHeight[i]);
+				__m512 extentX = _mm512_add_ps(halfX, _mm512_add_ps(_mm512_mul_ps(obbHalfX, absCosine), _mm512_mul_ps(obbHalfY, absSine)));
+				__m512 extentY = _mm512_add_ps(halfY, _mm512_add_ps(_mm512_mul_ps(obbHalfX, absSine), _mm512_mul_ps(obbHalfY, absCosine)));
+				__m512 extentU = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(halfX, absCosine), _mm512_mul_ps(halfY, absSine)), obbHalfX);
+				__m512 extentV = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(halfX, absSine), _mm512_mul_ps(halfY, absCosine)), obbHalfY);
+				__m512 projectedU = _mm512_abs_ps(_mm512_add_ps(_mm512_mul_ps(tx, cosine), _mm512_mul_ps(ty, sine)));
+				__m512 projectedV = _mm512_abs_ps(_mm512_sub_ps(_mm512_mul_ps(ty, cosine), _mm512_mul_ps(tx, sine)));
+				__mmask16 inside = _mm512_cmp_ps_mask(_mm512_abs_ps(tx), extentX, _CMP_LT_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, _mm512_abs_ps(ty), extentY, _CMP_LT_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, projectedU, extentU, _CMP_LT_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, projectedV, extentV, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + aabb_obb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t circle_obb_intersects_batch_avx512(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			const __m512 cx = _mm512_set1_ps(circle.pos.x);
+			const __m512 cy = _mm512_set1_ps(circle.pos.y);
+			const __m512 radiusSquared = _mm512_set1_ps(circle.radius * circle.radius);
+			const __m512 zero = _mm512_set1_ps(0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 dx = _mm512_sub_ps(cx, _mm512_loadu_ps(&batch.centerX[i]));
+				__m512 dy = _mm512_sub_ps(cy, _mm512_loadu_ps(&batch.centerY[i]));
+				__m512 cosine = _mm512_loadu_ps(&batch.cosine[i]);
+				__m512 sine = _mm512_loadu_ps(&batch.sine[i]);
+				__m512 localX = _mm512_add_ps(_mm512_mul_ps(dx, cosine), _mm512_mul_ps(dy, sine));
+				__m512 localY = _mm512_sub_ps(_mm512_mul_ps(dy, cosine), _mm512_mul_ps(dx, sine));
+				__m512 outsideX = _mm512_max_ps(_mm512_sub_ps(_mm512_abs_ps(localX), _mm512_loadu_ps(&batch.halfWidth[i])), zero);
+				__m512 outsideY = _mm512_max_ps(_mm512_sub_ps(_mm512_abs_ps(localY), _mm512_loadu_ps(&batch.halfHeight[i])), zero);
+				__m512 distanceSquared = _mm512_add_ps(_mm512_mul_ps(outsideX, outsideX), _mm512_mul_ps(outsideY, outsideY));
+				__mmask16 inside = _mm512_cmp_ps_mask(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + circle_obb_intersects_range(circle, batch, results, i);
+		}
+
+		/**
+		 * \brief Squared distance between a corner of the boxes of 16 lanes and the segment of a capsule.
+		 */
+		CH_SIMD_TARGET("avx512f")
+		static __m512 capsule_batch_corner_distance_avx512(__m512 x, __m512 y, __m512 startX, __m512 startY, __m512 directionX, __m512 directionY, __m512 inverseLengthSquared, __m512 zero, __m512 one) {
+			__m512 t = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_sub_ps(x, startX), directionX), _mm512_mul_ps(_mm512_sub_ps(y, startY), directionY)), inverseLengthSquared), zero), one);
+			__m512 dx = _mm512_sub_ps(_mm512_add_ps(startX, _mm512_mul_ps(t, directionX)), x);
+			__m512 dy = _mm512_sub_ps(_mm512_add_ps(startY, _mm512_mul_ps(t, directionY)), y);
+			return _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t capsule_aabb_intersects_batch_avx512(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const __m512 startX = _mm512_set1_ps(query.startX);
+			const __m512 startY = _mm512_set1_ps(query.startY);
+			const __m512 endX = _mm512_set1_ps(query.startX + query.directionX);
+			const __m512 endY = _mm512_set1_ps(query.startY + query.directionY);
+			const __m512 directionX = _mm512_set1_ps(query.directionX);
+			const __m512 directionY = _mm512_set1_ps(query.directionY);
+			const __m512 inverseLengthSquared = _mm512_set1_ps(query.inverseLengthSquared);
+			const __m512 segmentMinX = _mm512_set1_ps(query.minX);
+			const __m512 segmentMinY = _mm512_set1_ps(query.minY);
+			const __m512 segmentMaxX = _mm512_set1_ps(query.maxX);
+			const __m512 segmentMaxY = _mm512_set1_ps(query.maxY);
+			const __m512 normalX = _mm512_set1_ps(query.normalX);
+			const __m512 normalY = _mm512_set1_ps(query.normalY);
+			const __m512 absNormalX = _mm512_set1_ps(query.absNormalX);
+			const __m512 absNormalY = _mm512_set1_ps(query.absNormalY);
+			const __m512 normalDotStart = _mm512_set1_ps(query.normalDotStart);
+			const __m512 radiusSquared = _mm512_set1_ps(query.radiusSquared);
+			const __m512 half = _mm512_set1_ps(0.5f);
+			const __m512 zero = _mm512_set1_ps(0.f);
+			const __m512 one = _mm512_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 minX = _mm512_loadu_ps(&batch.minX[i]);
+				__m512 minY = _mm512_loadu_ps(&batch.minY[i]);
+				__m512 maxX = _mm512_loadu_ps(&batch.maxX[i]);
+				__m512 maxY = _mm512_loadu_ps(&batch.maxY[i]);
+
+				__m512 centerX = _mm512_mul_ps(_mm512_add_ps(minX, maxX), half);
+				__m512 centerY = _mm512_mul_ps(_mm512_add_ps(minY, maxY), half);
+				__m512 halfX = _mm512_mul_ps(_mm512_sub_ps(maxX, minX), half);
+				__m512 halfY = _mm512_mul_ps(_mm512_sub_ps(maxY, minY), half);
+				__mmask16 crossing = _mm512_cmp_ps_mask(segmentMinX, maxX, _CMP_LT_OQ) & _mm512_cmp_ps_mask(segmentMaxX, minX, _CMP_GT_OQ) & _mm512_cmp_ps_mask(segmentMinY, maxY, _CMP_LT_OQ) & _mm512_cmp_ps_mask(segmentMaxY, minY, _CMP_GT_OQ);
+				crossing &= _mm512_cmp_ps_mask(_mm512_abs_ps(_mm512_sub_ps(_mm512_add_ps(_mm512_mul_ps(normalX, centerX), _mm512_mul_ps(normalY, centerY)), normalDotStart)), _mm512_add_ps(_mm512_mul_ps(halfX, absNormalX), _mm512_mul_ps(halfY, absNormalY)), _CMP_LT_OQ);
+
+				__m512 startDX = _mm512_sub_ps(startX, _mm512_min_ps(_mm512_max_ps(startX, minX), maxX));
+				__m512 startDY = _mm512_sub_ps(startY, _mm512_min_ps(_mm512_max_ps(startY, minY), maxY));
+				__m512 endDX = _mm512_sub_ps(endX, _mm512_min_ps(_mm512_max_ps(endX, minX), maxX));
+				__m512 endDY = _mm512_sub_ps(endY, _mm512_min_ps(_mm512_max_ps(endY, minY), maxY));
+				__m512 closest = _mm512_min_ps(_mm512_add_ps(_mm512_mul_ps(startDX, startDX), _mm512_mul_ps(startDY, startDY)), _mm512_add_ps(_mm512_mul_ps(endDX, endDX), _mm512_mul_ps(endDY, endDY)));
+				closest = _mm512_min_ps(closest, _mm512_min_ps(capsule_batch_corner_distance_avx512(minX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx512(maxX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+				closest = _mm512_min_ps(closest, _mm512_min_ps(capsule_batch_corner_distance_avx512(minX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx512(maxX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+
+				__mmask16 inside = crossing | _mm512_cmp_ps_mask(closest, radiusSquared, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + capsule_aabb_intersects_range(capsule, batch, results, i);
+		}
+#endif
+
+		/**
+		 * \brief Throws if the two batches given to a pairwise function don't have the same size.
+		 */
+		static void check_pairwise_sizes(size_t firstSize, size_t otherSize) {
+			if (firstSize != otherSize) {
+				throw std::invalid_argument("Invalid argument : the batches of a pairwise test must have the same size.");
+			}
+		}
+
+		/**
+		 * \brief Returns the kernels matching the active SIMD tier.
+		 */
+		static const BatchCollisionKernels& batch_collision_kernels() {
+			static const std::array<BatchCollisionKernels, static_cast<size_t>(simd::SimdLevel::MAX_VALUE)> KERNELS =
+			{
+#ifdef CH_SIMD_X86
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_sse2, circle_intersects_batch_sse2, line_segments_intersect_batch_sse2, circle_sweep_batch_sse2, line_segment_aabb_clip_batch_sse2, circle_aabb_collision_batch_sse2, aabb_collision_batch_sse2, aabb_obb_intersects_batch_sse2, circle_obb_intersects_batch_sse2, capsule_aabb_intersects_batch_sse2, aabb_intersects_pairwise_sse2, circle_intersects_pairwise_sse2, aabb_circle_intersects_pairwise_sse2, line_segments_intersect_pairwise_sse2, aabb_segment_intersects_pairwise_sse2, circle_segment_intersects_pairwise_sse2 },
+				BatchCollisionKernels{ aabb_intersects_batch_avx2, circle_intersects_batch_avx2, line_segments_intersect_batch_avx2, circle_sweep_batch_avx2, line_segment_aabb_clip_batch_avx2, circle_aabb_collision_batch_avx2, aabb_collision_batch_avx2, aabb_obb_intersects_batch_avx2, circle_obb_intersects_batch_avx2, capsule_aabb_intersects_batch_avx2, aabb_intersects_pairwise_avx2, circle_intersects_pairwise_avx2, aabb_circle_intersects_pairwise_avx2, line_segments_intersect_pairwise_avx2, aabb_segment_intersects_pairwise_avx2, circle_segment_intersects_pairwise_avx2 },
+				BatchCollisionKernels{ aabb_intersects_batch_avx512, circle_intersects_batch_avx512, line_segments_intersect_batch_avx512, circle_sweep_batch_avx2, line_segment_aabb_clip_batch_avx512, circle_aabb_collision_batch_avx512, aabb_collision_batch_avx512, aabb_obb_intersects_batch_avx512, circle_obb_intersects_batch_avx512, capsule_aabb_intersects_batch_avx512, aabb_intersects_pairwise_avx2, circle_intersects_pairwise_avx2, aabb_circle_intersects_pairwise_avx2, line_segments_intersect_pairwise_avx2, aabb_segment_intersects_pairwise_avx2, circle_segment_intersects_pairwise_avx2 }
+#else
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar }
+#endif
+			};
+			return KERNELS[static_cast<size_t>(simd::active_simd_level())];
+		}
+
+		size_t aabb_intersects_batch(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().aabbIntersects(aabb, batch, results);
+		}
+
+		size_t circle_intersects_batch(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().circleIntersects(circle, batch, results);
+		}
+
+		size_t line_segments_intersect_batch(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			return batch_collision_kernels().segmentsIntersect(segment, batch, results, t, u);
+		}
+
+		size_t line_segments_intersect_batch(const LineSegmentBatch& first, const LineSegmentBatch& other, std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs) {
+			pairs.clear();
+			const SegmentBatchKernel kernel = batch_collision_kernels().segmentsIntersect;
+			std::vector<std::uint8_t> results(other.size());
+
+			for (size_t i = 0; i < first.size(); ++i) {
+				if (kernel(first.at(i), other, results.data(), nullptr, nullptr) == 0) {
+					continue;
+				}
+				for (size_t j = 0; j < other.size(); ++j) {
+					if (results[j]) {
+						pairs.emplace_back(static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j));
+					}
+				}
+			}
+			return pairs.size();
+		}
+
+		bool circle_sweep_batch(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, CircleSweepHit& hit) {
+			float earliest = std::numeric_limits<float>::infinity();
+			size_t earliestIndex = batch.size();
+			batch_collision_kernels().circleSweep(circle, motion, batch, earliest, earliestIndex);
+
+			if (earliestIndex == batch.size()) {
+				return false;
+			}
+			hit = circle_sweep_hit(circle, motion, batch.at(earliestIndex), static_cast<std::uint32_t>(earliestIndex), earliest);
+			return true;
+		}
+
+		size_t line_segment_aabb_clip_batch(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			return batch_collision_kernels().segmentAABBClip(segment, batch, results, entry, exit);
+		}
+
+		size_t circle_aabb_collision_batch(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			return batch_collision_kernels().circleAABBCollision(circle, batch, results, normalX, normalY, depth);
+		}
+
+		size_t aabb_collision_batch(const AABBBatch& batch, const std::vector<AABBIndexPair>& pairs, std::vector<AABBCollision>& collisions) {
+			collisions.resize(pairs.size());
+			return batch_collision_kernels().aabbPairCollision(batch, pairs.data(), pairs.size(), collisions.data());
+		}
+
+		size_t obb_intersects_batch(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().aabbOBBIntersects(aabb, batch, results);
+		}
+
+		size_t obb_intersects_batch(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().circleOBBIntersects(circle, batch, results);
+		}
+
+		size_t capsule_aabb_intersects_batch(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().capsuleAABBIntersects(capsule, batch, results);
+		}
+
+		size_t aabb_intersects_pairwise(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			check_pairwise_sizes(first.size(), other.size());
+			return batch_collision_kernels().aabbPairwise(first, other, results);
+		}
+
+		size_t circle_intersects_pairwise(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			check_pairwise_sizes(first.size(), other.size());
+			return batch_collision_kernels().circlePairwise(first, other, results);
+		}
+
+		size_t aabb_circle_intersects_pairwise(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			check_pairwise_sizes(aabbs.size(), circles.size());
+			return batch_collision_kernels().aabbCirclePairwise(aabbs, circles, results);
+		}
+
+		size_t line_segments_intersect_pairwise(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			check_pairwise_sizes(first.size(), other.size());
+			return batch_collision_kernels().segmentPairwise(first, other, results);
+		}
+
+		size_t aabb_segment_intersects_pairwise(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			check_pairwise_sizes(aabbs.size(), segments.size());
+			return batch_collision_kernels().aabbSegmentPairwise(aabbs, segments, results);
+		}
+
+		size_t circle_segment_intersects_pairwise(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			check_pairwise_sizes(circles.size(), segments.size());
+			return batch_collision_kernels().circleSegmentPairwise(circles, segments, results);
+		}
+	}
+}
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace ch {
+	namespace collision {
+
+		constexpr std::uint32_t GJK_MAX_ITERATIONS = 32; /**< Maximum number of support points computed by GJK. */
+		constexpr std::uint32_t EPA_MAX_VERTICES = 32; /**< Maximum number of vertices of the EPA polytope. */
+		constexpr float GJK_TOLERANCE = 1e-5f; /**< Minimum progress along the search direction, in world units. */
+
+		vec_t support_point(const AABB& aabb, const vec_t& direction) {
+			return support_point(Bounds(aabb), direction);
+		}
+
+		vec_t support_point(const Bounds& bounds, const vec_t& direction) {
+			return vec_t(direction.x >= 0.f ? bounds.max.x : bounds.min.x, direction.y >= 0.f ? bounds.max.y : bounds.min.y);
+		}
+
+		vec_t support_point(const Circle& circle, const vec_t& direction) {
+			return circle.pos + vec_normalize(direction) * circle.radius;
+		}
+
+		vec_t support_point(const LineSegment& segment, const vec_t& direction) {
+			return vec_dot_product(segment.end - segment.start, direction) > 0.f ? segment.end : segment.start;
+		}
+
+		vec_t support_point(const ConvexPolygon& polygon, const vec_t& direction) {
+			size_t farthest = 0;
+			float farthestProjection = vec_dot_product(polygon.vertex(0), direction);
+			for (size_t i = 1; i < polygon.size(); ++i) {
+				float projection = vec_dot_product(polygon.vertex(i), direction);
+				if (projection > farthestProjection) {
+					farthestProjection = projection;
+					farthest = i;
+				}
+			}
+			return polygon.vertex(farthest);
+		}
+
+		vec_t support_point(const OBB& obb, const vec_t& direction) {
+			float x = vec_dot_product(direction, obb.axisX()) >= 0.f ? obb.halfSize().x : -obb.halfSize().x;
+			float y = vec_dot_product(direction, obb.axisY()) >= 0.f ? obb.halfSize().y : -obb.halfSize().y;
+			return obb.toWorld(vec_t(x, y));
+		}
+
+		vec_t support_point(const Capsule& capsule, const vec_t& direction) {
+			return support_point(capsule.segment, direction) + vec_normalize(direction) * capsule.radius;
+		}
+
+		/**
+		 * \brief A vertex of the Minkowski difference of the cores of two shapes.
+		 */
+		struct GJKVertex {
+			vec_t onFirst; /**< Support point of the first shape. */
+			vec_t onOther; /**< Support point of the other shape, in the opposite direction. */
+			vec_t point; /**< onFirst - onOther. */
+			vec_t direction; /**< Direction that produced the vertex. */
+		};
+
+		/**
+		 * \brief The simplex of GJK, reduced to the vertices closest to the origin by gjk_solve().
+		 */
+		struct GJKSimplex {
+			std::array<GJKVertex, 3> vertices; /**< The vertices, only the first count are used. */
+			std::array<float, 3> weights; /**< Barycentric coordinates of the point of the simplex closest to the origin. */
+			std::uint32_t count; /**< Number of vertices. */
+		};
+
+		static GJKVertex gjk_support(const SupportShape& first, const SupportShape& other, const vec_t& direction) {
+			GJKVertex vertex;
+			vertex.onFirst = first.support(direction);
+			vertex.onOther = other.support(-direction);
+			vertex.point = vertex.onFirst - vertex.onOther;
+			vertex.direction = direction;
+			return vertex;
+		}
+
+		static bool gjk_contains(const GJKSimplex& simplex, const vec_t& point) {
+			for (std::uint32_t i = 0; i < simplex.count; ++i) {
+				if (simplex.vertices[i].point == point) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Keeps the vertices of the segment closest to the origin (Voronoi regions of the segment)
+		static void gjk_solve2(GJKSimplex& simplex) {
+			const vec_t w1 = simplex.vertices[0].point;
+			const vec_t w2 = simplex.vertices[1].point;
+			const vec_t e12 = w2 - w1;
+
+			float d12_2 = -vec_dot_product(w1, e12);
+			if (d12_2 <= 0.f) {
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+				return;
+			}
+
+			float d12_1 = vec_dot_product(w2, e12);
+			if (d12_1 <= 0.f) {
+				simplex.vertices[0] = simplex.vertices[1];
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+				return;
+			}
+
+			float inverse = 1.f / (d12_1 + d12_2);
+			simplex.weights[0] = d12_1 * inverse;
+			simplex.weights[1] = d12_2 * inverse;
+		}
+
+		// Keeps the vertices of the triangle closest to the origin (Voronoi regions of the triangle)
+		static void gjk_solve3(GJKSimplex& simplex) {
+			const vec_t w1 = simplex.vertices[0].point;
+			const vec_t w2 = simplex.vertices[1].point;
+			const vec_t w3 = simplex.vertices[2].point;
+
+			const vec_t e12 = w2 - w1;
+			float d12_1 = vec_dot_product(w2, e12);
+			float d12_2 = -vec_dot_product(w1, e12);
+
+			const vec_t e13 = w3 - w1;
+			float d13_1 = vec_dot_product(w3, e13);
+			float d13_2 = -vec_dot_product(w1, e13);
+
+			const vec_t e23 = w3 - w2;
+			float d23_1 = vec_dot_product(w3, e23);
+			float d23_2 = -vec_dot_product(w2, e23);
+
+			float n123 = vec_cross_product(e12, e13);
+			float d123_1 = n123 * vec_cross_product(w2, w3);
+			float d123_2 = n123 * vec_cross_product(w3, w1);
+			float d123_3 = n123 * vec_cross_product(w1, w2);
+
+			if (d12_2 <= 0.f && d13_2 <= 0.f) {
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+			}
+			else if (d12_1 > 0.f && d12_2 > 0.f && d123_3 <= 0.f) {
+				float inverse = 1.f / (d12_1 + d12_2);
+				simplex.weights[0] = d12_1 * inverse;
+				simplex.weights[1] = d12_2 * inverse;
+				simplex.count = 2;
+			}
+			else if (d13_1 > 0.f && d13_2 > 0.f && d123_2 <= 0.f) {
+				float inverse = 1.f / (d13_1 + d13_2);
+				simplex.weights[0] = d13_1 * inverse;
+				simplex.weights[1] = d13_2 * inverse;
+				simplex.vertices[1] = simplex.vertices[2];
+				simplex.count = 2;
+			}
+			else if (d12_1 <= 0.f && d23_2 <= 0.f) {
+				simplex.vertices[0] = simplex.vertices[1];
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+			}
+			else if (d13_1 <= 0.f && d23_1 <= 0.f) {
+				simplex.vertices[0] = simplex.vertices[2];
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+			}
+			else if (d23_1 > 0.f && d23_2 > 0.f && d123_1 <= 0.f) {
+				float inverse = 1.f / (d23_1 + d23_2);
+				simplex.vertices[0] = simplex.vertices[2];
+				simplex.weights[0] = d23_2 * inverse;
+				simplex.weights[1] = d23_1 * inverse;
+				simplex.count = 2;
+			}
+			else {
+				// The origin is inside the triangle
+				float inverse = 1.f / (d123_1 + d123_2 + d123_3);
+				simplex.weights[0] = d123_1 * inverse;
+				simplex.weights[1] = d123_2 * inverse;
+				simplex.weights[2] = d123_3 * inverse;
+			}
+		}
+
+		static void gjk_solve(GJKSimplex& simplex) {
+			if (simplex.count == 1) {
+				simplex.weights[0] = 1.f;
+			}
+			else if (simplex.count == 2) {
+				gjk_solve2(simplex);
+			}
+			else if (simplex.count == 3) {
+				gjk_solve3(simplex);
+			}
+		}
+
+		static vec_t gjk_closest_point(const GJKSimplex& simplex) {
+			vec_t closest(0.f, 0.f);
+			for (std::uint32_t i = 0; i < simplex.count; ++i) {
+				closest += simplex.vertices[i].point * simplex.weights[i];
+			}
+			return closest;
+		}
+
+		// Runs GJK on the cores of the shapes and leaves the final simplex in the given one
+		static GJKResult gjk_run(const SupportShape& first, const SupportShape& other, GJKCache* cache, GJKSimplex& simplex) {
+			simplex.count = 0;
+			if (cache != nullptr) {
+				for (std::uint32_t i = 0; i < cache->count; ++i) {
+					GJKVertex vertex = gjk_support(first, other, cache->directions[i]);
+					if (!gjk_contains(simplex, vertex.point)) {
+						simplex.vertices[simplex.count++] = vertex;
+					}
+				}
+			}
+			if (simplex.count == 0) {
+				simplex.vertices[simplex.count++] = gjk_support(first, other, RIGHT_VEC);
+			}
+
+			std::uint32_t iterations = 0;
+			gjk_solve(simplex);
+			while (simplex.count < 3 && iterations < GJK_MAX_ITERATIONS) {
+				const vec_t closest = gjk_closest_point(simplex);
+
+				// Search towards the origin, perpendicularly to the segment when there are 2 vertices
+				vec_t direction = -closest;
+				bool onSegment = false;
+				if (simplex.count == 2) {
+					const vec_t e12 = simplex.vertices[1].point - simplex.vertices[0].point;
+					float side = vec_cross_product(e12, -simplex.vertices[0].point);
+					direction = side > 0.f ? vec_t(-e12.y, e12.x) : vec_t(e12.y, -e12.x);
+					onSegment = side == 0.f;
+				}
+				if (direction == NULL_VEC) {
+					// The origin is a vertex of the Minkowski difference : the cores touch
+					break;
+				}
+
+				GJKVertex vertex = gjk_support(first, other, direction);
+				++iterations;
+				bool progress = !gjk_contains(simplex, vertex.point) && vec_dot_product(vertex.point - closest, direction) > GJK_TOLERANCE * vec_magnitude(direction);
+				if (!progress && onSegment) {
+					// The origin is on the segment : it is inside the cores unless the segment is on their boundary on both sides
+					vertex = gjk_support(first, other, -direction);
+					++iterations;
+					progress = !gjk_contains(simplex, vertex.point) && vec_dot_product(vertex.point - closest, -direction) > GJK_TOLERANCE * vec_magnitude(direction);
+				}
+				if (!progress) {
+					break;
+				}
+
+				simplex.vertices[simplex.count++] = vertex;
+				gjk_solve(simplex);
+			}
+
+			if (cache != nullptr) {
+				cache->count = simplex.count;
+				for (std::uint32_t i = 0; i < simplex.count; ++i) {
+					cache->directions[i] = simplex.vertices[i].direction;
+				}
+			}
+
+			vec_t onFirst(0.f, 0.f);
+			vec_t onOther(0.f, 0.f);
+			for (std::uint32_t i = 0; i < simplex.count; ++i) {
+				onFirst += simplex.vertices[i].onFirst * simplex.weights[i];
+				onOther += simplex.vertices[i].onOther * simplex.weights[i];
+			}
+
+			const float radii = first.radius() + other.radius();
+			if (simplex.count == 3) {
+				return GJKResult{ true, 0.f, onFirst, onOther, iterations };
+			}
+
+			float coreDistance = vec_magnitude(onOther - onFirst);
+			if (coreDistance > 0.f) {
+				const vec_t normal = (onOther - onFirst) / coreDistance;
+				onFirst += normal * first.radius();
+				onOther -= normal * other.radius();
+			}
+			return GJKResult{ coreDistance < radii, std::max(coreDistance - radii, 0.f), onFirst, onOther, iterations };
+		}
+
+		GJKResult gjk_distance(const SupportShape& first, const SupportShape& other, GJKCache* cache) {
+			GJKSimplex simplex;
+			return gjk_run(first, other, cache, simplex);
+		}
+
+		bool gjk_intersects(const SupportShape& first, const SupportShape& other, GJKCache* cache) {
+			return gjk_distance(first, other, cache).intersects;
+		}
+
+		// Expands the simplex of overlapping cores until the edge of the Minkowski difference closest to the origin is found
+		static ConvexCollision epa_collision_info(const SupportShape& first, const SupportShape& other, const GJKSimplex& simplex, float radii) {
+			std::array<GJKVertex, EPA_MAX_VERTICES> polytope;
+			std::uint32_t count = simplex.count;
+			for (std::uint32_t i = 0; i < count; ++i) {
+				polytope[i] = simplex.vertices[i];
+			}
+
+			// The cores only touch : the simplex is completed into a triangle that has the origin on its boundary
+			if (count == 1) {
+				polytope[1] = gjk_support(first, other, RIGHT_VEC);
+				if (polytope[1].point == polytope[0].point) {
+					polytope[1] = gjk_support(first, other, LEFT_VEC);
+				}
+				count = polytope[1].point == polytope[0].point ? 1 : 2;
+			}
+			if (count == 2) {
+				const vec_t e = polytope[1].point - polytope[0].point;
+				const vec_t perpendicular(-e.y, e.x);
+				polytope[2] = gjk_support(first, other, perpendicular);
+				if (vec_cross_product(e, polytope[2].point - polytope[0].point) == 0.f) {
+					polytope[2] = gjk_support(first, other, -perpendicular);
+				}
+				if (vec_cross_product(e, polytope[2].point - polytope[0].point) != 0.f) {
+					count = 3;
+				}
+			}
+			if (count < 3) {
+				// The Minkowski difference is flat (parallel segments, points) : push the other shape perpendicularly to it
+				const vec_t e = polytope[count - 1].point - polytope[0].point;
+				const vec_t normal = e == NULL_VEC ? UP_VEC : vec_normalize(vec_t(-e.y, e.x));
+				return ConvexCollision{ normal, radii };
+			}
+
+			// Counter-clockwise order : the outward normal of the edge a -> b is (e.y, -e.x)
+			if (vec_cross_product(polytope[1].point - polytope[0].point, polytope[2].point - polytope[0].point) < 0.f) {
+				std::swap(polytope[1], polytope[2]);
+			}
+
+			while (true) {
+				std::uint32_t closestEdge = 0;
+				float closestDistance = std::numeric_limits<float>::max();
+				vec_t closestNormal = NULL_VEC;
+				for (std::uint32_t i = 0; i < count; ++i) {
+					const vec_t& a = polytope[i].point;
+					const vec_t e = polytope[(i + 1) % count].point - a;
+					const float length = vec_magnitude(e);
+					if (length == 0.f) {
+						continue;
+					}
+					const vec_t normal = vec_t(e.y, -e.x) / length;
+					float distance = vec_dot_product(normal, a);
+					if (distance < closestDistance) {
+						closestDistance = distance;
+						closestEdge = i;
+						closestNormal = normal;
+					}
+				}
+
+				GJKVertex vertex = gjk_support(first, other, closestNormal);
+				if (count == EPA_MAX_VERTICES || vec_dot_product(vertex.point, closestNormal) - closestDistance <= GJK_TOLERANCE) {
+					return ConvexCollision{ closestNormal, std::max(closestDistance, 0.f) + radii };
+				}
+
+				for (std::uint32_t i = count; i > closestEdge + 1; --i) {
+					polytope[i] = polytope[i - 1];
+				}
+				polytope[closestEdge + 1] = vertex;
+				++count;
+			}
+		}
+
+		// Computes the collision of shapes that GJK found intersecting, from its final simplex
+		static ConvexCollision gjk_penetration(const SupportShape& first, const SupportShape& other, const GJKSimplex& simplex) {
+			const float radii = first.radius() + other.radius();
+			if (simplex.count < 3) {
+				// Only the radii overlap : the normal goes from the core of the first shape to the core of the other one
+				const vec_t delta = -gjk_closest_point(simplex);
+				const float coreDistance = vec_magnitude(delta);
+				if (coreDistance > 0.f) {
+					return ConvexCollision{ delta / coreDistance, radii - coreDistance };
+				}
+			}
+			return epa_collision_info(first, other, simplex, radii);
+		}
+
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, GJKCache* cache) {
+			static const ConvexCollision NO_COLLISION = ConvexCollision{ NULL_VEC, 0.f };
+
+			GJKSimplex simplex;
+			if (!gjk_run(first, other, cache, simplex).intersects) {
+				return NO_COLLISION;
+			}
+			return gjk_penetration(first, other, simplex);
+		}
+
+		bool separated_along_axis(const SupportShape& first, const SupportShape& other, const vec_t& axis) {
+			const float length = vec_magnitude(axis);
+			float firstMax = vec_dot_product(first.support(axis), axis) + first.radius() * length;
+			float otherMin = vec_dot_product(other.support(-axis), axis) - other.radius() * length;
+			return firstMax <= otherMin;
+		}
+
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, PairContact& contact) {
+			static const ConvexCollision NO_COLLISION = ConvexCollision{ NULL_VEC, 0.f };
+
+			if (contact.separatingAxis != NULL_VEC && separated_along_axis(first, other, contact.separatingAxis)) {
+				return NO_COLLISION;
+			}
+
+			GJKSimplex simplex;
+			const GJKResult result = gjk_run(first, other, &contact.gjk, simplex);
+			if (!result.intersects) {
+				// The vector between the closest points separates the shapes
+				contact.separatingAxis = result.pointOnOther - result.pointOnFirst;
+				return NO_COLLISION;
+			}
+			contact.separatingAxis = NULL_VEC;
+			return gjk_penetration(first, other, simplex);
+		}
+	}
+}
+
+namespace ch {
+
+	/**
+	 * \brief Index of the combination of two shape types, in the order of the types.
+	 */
+	constexpr std::uint8_t SHAPE_COMBINATIONS[3][3] = {
+		{ 0, 1, 2 }, // AABB-AABB, AABB-Circle, AABB-LineSegment
+		{ 1, 3, 4 }, // Circle-Circle, Circle-LineSegment
+		{ 2, 4, 5 }  // LineSegment-LineSegment
+	};
+
+	static size_t shape_combination(ShapeType first, ShapeType other) {
+		return SHAPE_COMBINATIONS[static_cast<size_t>(first)][static_cast<size_t>(other)];
+	}
+
+	/**
+	 * \brief Copies the AABBs at the given indices of the source batch into the target batch.
+	 */
+	static void gather_shapes(const AABBBatch& source, const std::uint32_t* indices, size_t count, AABBBatch& target) {
+		target.minX.resize(count);
+		target.minY.resize(count);
+		target.maxX.resize(count);
+		target.maxY.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			target.minX[i] = source.minX[indices[i]];
+			target.minY[i] = source.minY[indices[i]];
+			target.maxX[i] = source.maxX[indices[i]];
+			target.maxY[i] = source.maxY[indices[i]];
+		}
+	}
+
+	/**
+	 * \brief Copies the circles at the given indices of the source batch into the target batch.
+	 */
+	static void gather_shapes(const CircleBatch& source, const std::uint32_t* indices, size_t count, CircleBatch& target) {
+		target.x.resize(count);
+		target.y.resize(count);
+		target.radius.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			target.x[i] = source.x[indices[i]];
+			target.y[i] = source.y[indices[i]];
+			target.radius[i] = source.radius[indices[i]];
+		}
+	}
+
+	/**
+	 * \brief Copies the segments at the given indices of the source batch into the target batch.
+	 */
+	static void gather_shapes(const LineSegmentBatch& source, const std::uint32_t* indices, size_t count, LineSegmentBatch& target) {
+		target.startX.resize(count);
+		target.startY.resize(count);
+		target.endX.resize(count);
+		target.endY.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			target.startX[i] = source.startX[indices[i]];
+			target.startY[i] = source.startY[indices[i]];
+			target.endX[i] = source.endX[indices[i]];
+			target.endY[i] = source.endY[indices[i]];
+		}
+	}
+
+	ShapePairDispatcher::ShapePairDispatcher() :
+		combinationStarts_(),
+		order_(),
+		firstIndices_(),
+		otherIndices_(),
+		sortedResults_(),
+		aabbs_(),
+		circles_(),
+		segments_()
+	{
+		combinationStarts_.fill(0);
+	}
+
+	size_t ShapePairDispatcher::intersects(const AABBBatch& aabbs, const CircleBatch& circles, const LineSegmentBatch& segments, const std::vector<ShapePair>& pairs, std::vector<std::uint8_t>& results) {
+		const size_t count = pairs.size();
+		results.resize(count);
+		order_.resize(count);
+		firstIndices_.resize(count);
+		otherIndices_.resize(count);
+		sortedResults_.resize(count);
+
+		// Counting sort of the pairs by combination
+		std::array<std::uint32_t, COMBINATION_COUNT> next{};
+		for (const ShapePair& pair : pairs) {
+			++next[shape_combination(pair.first.type, pair.other.type)];
+		}
+		std::uint32_t start = 0;
+		for (size_t c = 0; c < COMBINATION_COUNT; ++c) {
+			combinationStarts_[c] = start;
+			start += next[c];
+			next[c] = combinationStarts_[c];
+		}
+		combinationStarts_[COMBINATION_COUNT] = start;
+
+		for (size_t i = 0; i < count; ++i) {
+			const ShapePair& pair = pairs[i];
+			const bool swapped = pair.first.type > pair.other.type;
+			const std::uint32_t position = next[shape_combination(pair.first.type, pair.other.type)]++;
+			order_[position] = static_cast<std::uint32_t>(i);
+			firstIndices_[position] = swapped ? pair.other.index : pair.first.index;
+			otherIndices_[position] = swapped ? pair.first.index : pair.other.index;
+		}
+
+		// Each combination is gathered into contiguous batches and tested with a single kernel call
+		size_t hits = 0;
+		for (size_t c = 0; c < COMBINATION_COUNT; ++c) {
+			const size_t first = combinationStarts_[c];
+			const size_t size = combinationStarts_[c + 1] - first;
+			if (size == 0) {
+				continue;
+			}
+
+			const std::uint32_t* firstIndices = firstIndices_.data() + first;
+			const std::uint32_t* otherIndices = otherIndices_.data() + first;
+			std::uint8_t* combinationResults = sortedResults_.data() + first;
+			switch (c) {
+			case 0:
+				gather_shapes(aabbs, firstIndices, size, aabbs_[0]);
+				gather_shapes(aabbs, otherIndices, size, aabbs_[1]);
+				hits += collision::aabb_intersects_pairwise(aabbs_[0], aabbs_[1], combinationResults);
+				break;
+			case 1:
+				gather_shapes(aabbs, firstIndices, size, aabbs_[0]);
+				gather_shapes(circles, otherIndices, size, circles_[1]);
+				hits += collision::aabb_circle_intersects_pairwise(aabbs_[0], circles_[1], combinationResults);
+				break;
+			case 2:
+				gather_shapes(aabbs, firstIndices, size, aabbs_[0]);
+				gather_shapes(segments, otherIndices, size, segments_[1]);
+				hits += collision::aabb_segment_intersects_pairwise(aabbs_[0], segments_[1], combinationResults);
+				break;
+			case 3:
+				gather_shapes(circles, firstIndices, size, circles_[0]);
+				gather_shapes(circles, otherIndices, size, circles_[1]);
+				hits += collision::circle_intersects_pairwise(circles_[0], circles_[1], combinationResults);
+				break;
+			case 4:
+				gather_shapes(circles, firstIndices, size, circles_[0]);
+				gather_shapes(segments, otherIndices, size, segments_[1]);
+				hits += collision::circle_segment_intersects_pairwise(circles_[0], segments_[1], combinationResults);
+				break;
+			default:
+				gather_shapes(segments, firstIndices, size, segments_[0]);
+				gather_shapes(segments, otherIndices, size, segments_[1]);
+				hits += collision::line_segments_intersect_pairwise(segments_[0], segments_[1], combinationResults);
+				break;
+			}
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			results[order_[i]] = sortedResults_[i];
+		}
+		return hits;
+	}
+
+	size_t ShapePairDispatcher::combinationSize(ShapeType first, ShapeType other) const {
+		const size_t c = shape_combination(first, other);
+		return combinationStarts_[c + 1] - combinationStarts_[c];
+	}
+}
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ch {
+
+	constexpr std::uint64_t PAIR_CACHE_EMPTY_KEY = 0xFFFFFFFFFFFFFFFFull; /**< Key of the empty slots (a pair of the same handle, which get() rejects). */
+	constexpr size_t PAIR_CACHE_MIN_SLOTS = 16;
+
+	/**
+	 * \brief Key of a pair of handles, independent of their order.
+	 */
+	static std::uint64_t pair_cache_key(std::uint32_t first, std::uint32_t other) {
+		return (static_cast<std::uint64_t>(std::min(first, other)) << 32) | std::max(first, other);
+	}
+
+	/**
+	 * \brief Mixes the bits of a key (finalizer of MurmurHash3), so that close handles end up in distant slots.
+	 */
+	static std::uint64_t pair_cache_hash(std::uint64_t key) {
+		key ^= key >> 33;
+		key *= 0xFF51AFD7ED558CCDull;
+		key ^= key >> 33;
+		key *= 0xC4CEB9FE1A85EC53ull;
+		key ^= key >> 33;
+		return key;
+	}
+
+	PairCache::PairCache(size_t capacity) : keys_(), contacts_(), size_(0), frame_(1) {
+		// At most half of the slots are used, which keeps the probe sequences short
+		size_t slots = PAIR_CACHE_MIN_SLOTS;
+		while (slots < capacity * 2) {
+			slots *= 2;
+		}
+		keys_.assign(slots, PAIR_CACHE_EMPTY_KEY);
+		contacts_.resize(slots);
+	}
+
+	void PairCache::newFrame() {
+		++frame_;
+	}
+
+	PairContact& PairCache::get(std::uint32_t first, std::uint32_t other) {
+		if (first == other) {
+			throw std::invalid_argument("Invalid argument : a pair must reference two different handles.");
+		}
+
+		const std::uint64_t key = pair_cache_key(first, other);
+		size_t slot = findSlot(key);
+		if (keys_[slot] == PAIR_CACHE_EMPTY_KEY) {
+			if ((size_ + 1) * 2 > keys_.size()) {
+				grow();
+				slot = findSlot(key);
+			}
+			keys_[slot] = key;
+			contacts_[slot] = PairContact{ std::min(first, other), std::max(first, other), NULL_VEC, 0.f, NULL_VEC, GJKCache(), 0, 0, 0, false };
+			++size_;
+		}
+
+		PairContact& contact = contacts_[slot];
+		contact.seenFrame = frame_;
+		return contact;
+	}
+
+	const PairContact* PairCache::find(std::uint32_t first, std::uint32_t other) const {
+		if (first == other) {
+			return nullptr;
+		}
+		size_t slot = findSlot(pair_cache_key(first, other));
+		return keys_[slot] == PAIR_CACHE_EMPTY_KEY ? nullptr : &contacts_[slot];
+	}
+
+	void PairCache::setContact(PairContact& contact, const vec_t& normal, float depth) {
+		if (normal == NULL_VEC) {
+			return;
+		}
+		contact.normal = normal;
+		contact.depth = depth;
+		contact.touchFrame = frame_;
+	}
+
+	void PairCache::endFrame(std::vector<ContactEvent>& events) {
+		events.clear();
+
+		size_t slot = 0;
+		while (slot < keys_.size()) {
+			if (keys_[slot] == PAIR_CACHE_EMPTY_KEY) {
+				++slot;
+				continue;
+			}
+
+			PairContact& contact = contacts_[slot];
+			if (contact.seenFrame != frame_) {
+				// The pair left the broadphase. The slot is filled by the next pairs and is checked again.
+				if (contact.touching) {
+					events.push_back(ContactEvent{ ContactEventType::End, contact.first, contact.other });
+				}
+				erase(slot);
+				continue;
+			}
+
+			const bool touching = contact.touchFrame == frame_;
+			if (touching && !contact.touching) {
+				contact.beginFrame = frame_;
+				events.push_back(ContactEvent{ ContactEventType::Begin, contact.first, contact.other });
+			}
+			else if (!touching && contact.touching) {
+				contact.beginFrame = 0;
+				events.push_back(ContactEvent{ ContactEventType::End, contact.first, contact.other });
+			}
+			contact.touching = touching;
+			++slot;
+		}
+	}
+
+	void PairCache::clear() {
+		std::fill(keys_.begin(), keys_.end(), PAIR_CACHE_EMPTY_KEY);
+		size_ = 0;
+	}
+
+	size_t PairCache::size() const {
+		return size_;
+	}
+
+	std::uint32_t PairCache::frame() const {
+		return frame_;
+	}
+
+	size_t PairCache::findSlot(std::uint64_t key) const {
+		const size_t mask = keys_.size() - 1;
+		size_t slot = static_cast<size_t>(pair_cache_hash(key)) & mask;
+		while (keys_[slot] != key && keys_[slot] != PAIR_CACHE_EMPTY_KEY) {
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	void PairCache::grow() {
+		std::vector<std::uint64_t> keys(keys_.size() * 2, PAIR_CACHE_EMPTY_KEY);
+		std::vector<PairContact> contacts(contacts_.size() * 2);
+		keys.swap(keys_);
+		contacts.swap(contacts_);
+
+		for (size_t i = 0; i < keys.size(); ++i) {
+			if (keys[i] != PAIR_CACHE_EMPTY_KEY) {
+				size_t slot = findSlot(keys[i]);
+				keys_[slot] = keys[i];
+				contacts_[slot] = contacts[i];
+			}
+		}
+	}
+
+	void PairCache::erase(size_t slot) {
+		// Backward shift deletion : a pair can fill the hole if the hole is between its home slot and its slot
+		const size_t mask = keys_.size() - 1;
+		size_t hole = slot;
+		for (size_t i = (slot + 1) & mask; keys_[i] != PAIR_CACHE_EMPTY_KEY; i = (i + 1) & mask) {
+			const size_t home = static_cast<size_t>(pair_cache_hash(keys_[i])) & mask;
+			if (((i - home) & mask) >= ((i - hole) & mask)) {
+				keys_[hole] = keys_[i];
+				contacts_[hole] = contacts_[i];
+				hole = i;
+			}
+		}
+		keys_[hole] = PAIR_CACHE_EMPTY_KEY;
+		--size_;
+	}
+}
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace ch {
+
+	SleepManager::SleepManager(float velocityThreshold, float displacementThreshold, float timeToSleep) :
+		velocityThreshold_(velocityThreshold),
+		displacementThreshold_(displacementThreshold),
+		timeToSleep_(timeToSleep),
+		states_(),
+		positions_(),
+		previousPositions_(),
+		velocities_(),
+		restTimes_(),
+		nextInIsland_(),
+		parents_(),
+		islandSizes_(),
+		islandRestTimes_(),
+		contacts_(),
+		awakeBodies_(),
+		freeBodies_(),
+		removedBodies_(),
+		islandCount_(0),
+		size_(0)
+	{}
+
+	std::uint32_t SleepManager::add(const vec_t& position, bool isStatic) {
+		std::uint32_t body;
+		if (!freeBodies_.empty()) {
+			body = freeBodies_.back();
+			freeBodies_.pop_back();
+		}
+		else {
+			body = static_cast<std::uint32_t>(states_.size());
+			states_.push_back(BodyState::Removed);
+			positions_.emplace_back();
+			previousPositions_.emplace_back();
+			velocities_.emplace_back();
+			restTimes_.push_back(0.f);
+			nextInIsland_.push_back(body);
+			parents_.push_back(body);
+			islandSizes_.push_back(1);
+			islandRestTimes_.push_back(0.f);
+		}
+
+		states_[body] = isStatic ? BodyState::Static : BodyState::Awake;
+		positions_[body] = position;
+		previousPositions_[body] = position;
+		velocities_[body] = NULL_VEC;
+		restTimes_[body] = 0.f;
+		nextInIsland_[body] = body;
+		if (!isStatic) {
+			awakeBodies_.insert(std::lower_bound(awakeBodies_.begin(), awakeBodies_.end(), body), body);
+		}
+		++size_;
+		return body;
+	}
+
+	void SleepManager::remove(std::uint32_t body) {
+		checkBody(body);
+		if (states_[body] == BodyState::Sleeping) {
+			// The bodies resting on the removed one may fall
+			wakeIsland(body);
+		}
+		if (states_[body] == BodyState::Awake) {
+			awakeBodies_.erase(std::lower_bound(awakeBodies_.begin(), awakeBodies_.end(), body));
+		}
+		states_[body] = BodyState::Removed;
+		// The identifier is reused after step(), once the contacts of the tick are forgotten
+		removedBodies_.push_back(body);
+		--size_;
+	}
+
+	void SleepManager::setMotion(std::uint32_t body, const vec_t& position, const vec_t& velocity) {
+		checkBody(body);
+		if (states_[body] == BodyState::Sleeping && vec_magnitude_squared(position - previousPositions_[body]) > displacementThreshold_ * displacementThreshold_) {
+			wakeIsland(body);
+		}
+		positions_[body] = position;
+		velocities_[body] = velocity;
+	}
+
+	void SleepManager::addContact(std::uint32_t first, std::uint32_t other) {
+		checkBody(first);
+		checkBody(other);
+		if (first == other) {
+			return;
+		}
+
+		if (states_[first] == BodyState::Awake && states_[other] == BodyState::Sleeping) {
+			wakeIsland(other);
+		}
+		else if (states_[other] == BodyState::Awake && states_[first] == BodyState::Sleeping) {
+			wakeIsland(first);
+		}
+
+		// The contacts with static bodies don't link the islands
+		if (states_[first] == BodyState::Awake && states_[other] == BodyState::Awake) {
+			contacts_.push_back(first);
+			contacts_.push_back(other);
+		}
+	}
+
+	void SleepManager::wake(std::uint32_t body) {
+		checkBody(body);
+		if (states_[body] == BodyState::Sleeping) {
+			wakeIsland(body);
+		}
+	}
+
+	void SleepManager::step(float dt) {
+		const float velocityThreshold2 = velocityThreshold_ * velocityThreshold_;
+		const float displacementThreshold2 = displacementThreshold_ * displacementThreshold_;
+
+		// Motion tracking, and one island per awake body
+		for (std::uint32_t body : awakeBodies_) {
+			const bool moving = vec_magnitude_squared(velocities_[body]) > velocityThreshold2
+				|| vec_magnitude_squared(positions_[body] - previousPositions_[body]) > displacementThreshold2;
+			restTimes_[body] = moving ? 0.f : restTimes_[body] + dt;
+			previousPositions_[body] = positions_[body];
+
+			parents_[body] = body;
+			islandSizes_[body] = 1;
+			islandRestTimes_[body] = std::numeric_limits<float>::max();
+			nextInIsland_[body] = body;
+		}
+
+		// The bodies of a pair may have been removed since the contact was added
+		for (size_t i = 0; i < contacts_.size(); i += 2) {
+			if (states_[contacts_[i]] == BodyState::Awake && states_[contacts_[i + 1]] == BodyState::Awake) {
+				unite(contacts_[i], contacts_[i + 1]);
+			}
+		}
+		contacts_.clear();
+
+		// Links the bodies of each island in a circular list starting at its root, so that a sleeping island can be woken up
+		islandCount_ = 0;
+		for (std::uint32_t body : awakeBodies_) {
+			const std::uint32_t root = findRoot(body);
+			islandRestTimes_[root] = std::min(islandRestTimes_[root], restTimes_[body]);
+			if (root == body) {
+				++islandCount_;
+			}
+			else {
+				nextInIsland_[body] = nextInIsland_[root];
+				nextInIsland_[root] = body;
+			}
+		}
+
+		for (std::uint32_t body : awakeBodies_) {
+			if (parents_[body] != body || islandRestTimes_[body] < timeToSleep_) {
+				continue;
+			}
+			std::uint32_t islandBody = body;
+			do {
+				states_[islandBody] = BodyState::Sleeping;
+				velocities_[islandBody] = NULL_VEC;
+				islandBody = nextInIsland_[islandBody];
+			} while (islandBody != body);
+		}
+
+		updateAwakeBodies();
+		freeBodies_.insert(freeBodies_.end(), removedBodies_.begin(), removedBodies_.end());
+		removedBodies_.clear();
+	}
+
+	bool SleepManager::isAwake(std::uint32_t body) const {
+		checkBody(body);
+		return states_[body] == BodyState::Awake;
+	}
+
+	bool SleepManager::isStatic(std::uint32_t body) const {
+		checkBody(body);
+		return states_[body] == BodyState::Static;
+	}
+
+	bool SleepManager::needsCollision(std::uint32_t first, std::uint32_t other) const {
+		return isAwake(first) || isAwake(other);
+	}
+
+	const std::vector<std::uint32_t>& SleepManager::awakeBodies() const {
+		return awakeBodies_;
+	}
+
+	size_t SleepManager::islandCount() const {
+		return islandCount_;
+	}
+
+	size_t SleepManager::size() const {
+		return size_;
+	}
+
+	void SleepManager::checkBody(std::uint32_t body) const {
+		if (body >= states_.size() || states_[body] == BodyState::Removed) {
+			throw std::invalid_argument("Invalid argument : the body doesn't exist.");
+		}
+	}
+
+	std::uint32_t SleepManager::findRoot(std::uint32_t body) {
+		while (parents_[body] != body) {
+			parents_[body] = parents_[parents_[body]];
+			body = parents_[body];
+		}
+		return body;
+	}
+
+	void SleepManager::unite(std::uint32_t first, std::uint32_t other) {
+		std::uint32_t firstRoot = findRoot(first);
+		std::uint32_t otherRoot = findRoot(other);
+		if (firstRoot == otherRoot) {
+			return;
+		}
+		if (islandSizes_[firstRoot] < islandSizes_[otherRoot]) {
+			std::swap(firstRoot, otherRoot);
+		}
+		parents_[otherRoot] = firstRoot;
+		islandSizes_[firstRoot] += islandSizes_[otherRoot];
+	}
+
+	void SleepManager::wakeIsland(std::uint32_t body) {
+		std::uint32_t islandBody = body;
+		do {
+			states_[islandBody] = BodyState::Awake;
+			restTimes_[islandBody] = 0.f;
+			awakeBodies_.push_back(islandBody);
+			islandBody = nextInIsland_[islandBody];
+		} while (islandBody != body);
+		std::sort(awakeBodies_.begin(), awakeBodies_.end());
+	}
+
+	void SleepManager::updateAwakeBodies() {
+		awakeBodies_.erase(std::remove_if(awakeBodies_.begin(), awakeBodies_.end(), [&](std::uint32_t body) {
+			return states_[body] != BodyState::Awake;
+		}), awakeBodies_.end());
+	}
+}
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace ch {
+
+	constexpr float CONTACT_SOLVER_CORRECTION_FACTOR = 0.2f; /**< Part of the remaining penetration corrected by a position iteration. */
+	constexpr float CONTACT_SOLVER_WARM_START_COSINE = 0.9f; /**< Cosine of the largest angle between the normals of a pair on two ticks for its impulses to be reused. */
+	constexpr size_t CONTACT_SOLVER_COLORS = 64; /**< Colors available to the parallel iterations, the contacts that don't fit in them are solved on a single thread. */
+	constexpr size_t CONTACT_SOLVER_MIN_CHUNK_SIZE = 256;
+
+	/**
+	 * \brief Point where the threads of a solve() wait for each other before going to the next color.
+	 */
+	struct ContactSolverBarrier {
+		unsigned int threadCount; /**< Number of threads that must arrive before any of them goes on. */
+		std::atomic<unsigned int> arrived; /**< Number of threads waiting. */
+		std::atomic<unsigned int> generation; /**< Number of times every thread arrived. */
+	};
+
+	/**
+	 * \brief Waits until every thread of the barrier called this function.
+	 *
+	 * The threads spin (yielding) instead of sleeping : a color only takes a few microseconds to solve.
+	 */
+	static void contact_solver_wait(ContactSolverBarrier& barrier) {
+		const unsigned int generation = barrier.generation.load(std::memory_order_acquire);
+		if (barrier.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == barrier.threadCount) {
+			barrier.arrived.store(0, std::memory_order_relaxed);
+			barrier.generation.fetch_add(1, std::memory_order_release);
+			return;
+		}
+		while (barrier.generation.load(std::memory_order_acquire) == generation) {
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	 * \brief Key of a pair of bodies, independent of their order.
+	 */
+	static std::uint64_t contact_solver_key(std::uint32_t first, std::uint32_t other) {
+		return (static_cast<std::uint64_t>(std::min(first, other)) << 32) | std::max(first, other);
+	}
+
+	/**
+	 * \brief Applies an impulse to the other body of a contact and the opposite impulse to the first one.
+	 *
+	 * The static bodies are never written : the contacts of a color can share them while being solved in parallel.
+	 */
+	static void contact_solver_apply(std::vector<vec_t>& values, std::uint32_t first, std::uint32_t other, const vec_t& impulse, float firstInverseMass, float otherInverseMass) {
+		if (firstInverseMass > 0.f) {
+			values[first] -= impulse * firstInverseMass;
+		}
+		if (otherInverseMass > 0.f) {
+			values[other] += impulse * otherInverseMass;
+		}
+	}
+
+	ContactSolver::ContactSolver(unsigned int velocityIterations, unsigned int positionIterations, float slop, float restitutionThreshold, unsigned int threadCount) :
+		velocityIterations_(velocityIterations),
+		positionIterations_(positionIterations),
+		slop_(slop),
+		restitutionThreshold_(restitutionThreshold),
+		threadCount_(threadCount),
+		firsts_(),
+		others_(),
+		normals_(),
+		depths_(),
+		restitutions_(),
+		frictions_(),
+		masses_(),
+		velocityBiases_(),
+		normalImpulses_(),
+		tangentImpulses_(),
+		order_(),
+		colorStarts_(),
+		bodyColors_(),
+		startPositions_(),
+		warmKeys_(),
+		warmNormals_(),
+		warmNormalImpulses_(),
+		warmTangentImpulses_()
+	{}
+
+	void ContactSolver::newFrame() {
+		// The impulses are kept sorted by pair, so that prepare() finds them with a binary search
+		order_.resize(firsts_.size());
+		std::iota(order_.begin(), order_.end(), 0);
+		std::sort(order_.begin(), order_.end(), [&](std::uint32_t a, std::uint32_t b) {
+			return contact_solver_key(firsts_[a], others_[a]) < contact_solver_key(firsts_[b], others_[b]);
+		});
+
+		warmKeys_.clear();
+		warmNormals_.clear();
+		warmNormalImpulses_.clear();
+		warmTangentImpulses_.clear();
+		for (std::uint32_t contact : order_) {
+			warmKeys_.push_back(contact_solver_key(firsts_[contact], others_[contact]));
+			// Normal oriented from the lowest body to the highest one
+			warmNormals_.push_back(firsts_[contact] < others_[contact] ? normals_[contact] : -normals_[contact]);
+			warmNormalImpulses_.push_back(normalImpulses_[contact]);
+			warmTangentImpulses_.push_back(tangentImpulses_[contact]);
+		}
+
+		firsts_.clear();
+		others_.clear();
+		normals_.clear();
+		depths_.clear();
+		restitutions_.clear();
+		frictions_.clear();
+		masses_.clear();
+		velocityBiases_.clear();
+		normalImpulses_.clear();
+		tangentImpulses_.clear();
+		order_.clear();
+		colorStarts_.clear();
+	}
+
+	void ContactSolver::addContact(std::uint32_t first, std::uint32_t other, const vec_t& normal, float depth, float restitution, float friction) {
+		if (first == other) {
+			throw std::invalid_argument("Invalid argument : a contact must reference two different bodies.");
+		}
+		if (normal == NULL_VEC) {
+			return;
+		}
+
+		firsts_.push_back(first);
+		others_.push_back(other);
+		normals_.push_back(normal);
+		depths_.push_back(depth);
+		restitutions_.push_back(restitution);
+		frictions_.push_back(friction);
+		masses_.push_back(0.f);
+		velocityBiases_.push_back(0.f);
+		normalImpulses_.push_back(0.f);
+		tangentImpulses_.push_back(0.f);
+	}
+
+	void ContactSolver::addContact(std::uint32_t first, std::uint32_t other, const AABBCollision& collision, float restitution, float friction) {
+		addContact(first, other, collision.normal, collision.absolutePenetrationDepthAlongNormal(), restitution, friction);
+	}
+
+	void ContactSolver::addContact(std::uint32_t first, std::uint32_t other, const CirclesCollision& collision, float restitution, float friction) {
+		addContact(first, other, collision.normal, collision.absoluteDepth, restitution, friction);
+	}
+
+	void ContactSolver::addContact(std::uint32_t aabb, std::uint32_t circle, const CircleAABBCollision& collision, float restitution, float friction) {
+		addContact(aabb, circle, collision.normal, collision.absoluteDepth, restitution, friction);
+	}
+
+	void ContactSolver::solve(std::vector<vec_t>& positions, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses, float dt) {
+		if (positions.size() != velocities.size() || positions.size() != inverseMasses.size()) {
+			throw std::invalid_argument("Invalid argument : the positions, velocities and inverse masses must have the same size.");
+		}
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			if (firsts_[contact] >= positions.size() || others_[contact] >= positions.size()) {
+				throw std::invalid_argument("Invalid argument : a contact references a body that doesn't exist.");
+			}
+		}
+
+		color(inverseMasses);
+		prepare(velocities, inverseMasses);
+		startPositions_ = positions;
+
+		// Only as many threads as the largest color needs
+		unsigned int threads = threadCount_ == 0 ? default_thread_count() : threadCount_;
+		size_t largestColor = 0;
+		for (size_t color = 0; color + 1 < colorStarts_.size() && color < CONTACT_SOLVER_COLORS; ++color) {
+			largestColor = std::max(largestColor, colorStarts_[color + 1] - colorStarts_[color]);
+		}
+		threads = static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(threads, (largestColor + CONTACT_SOLVER_MIN_CHUNK_SIZE - 1) / CONTACT_SOLVER_MIN_CHUNK_SIZE)));
+
+		// A single parallel region for the whole solve, the threads wait for each other between the colors
+		ContactSolverBarrier barrier{ threads, { 0 }, { 0 } };
+		parallel_for(threads, [&](size_t thread, size_t, size_t) {
+			for (unsigned int iteration = 0; iteration < velocityIterations_; ++iteration) {
+				forEachColor(thread, barrier, [&](size_t contact) {
+					solveVelocity(contact, velocities, inverseMasses);
+				});
+			}
+
+			const size_t bodiesPerThread = (positions.size() + threads - 1) / threads;
+			for (size_t body = thread * bodiesPerThread; body < std::min(positions.size(), (thread + 1) * bodiesPerThread); ++body) {
+				positions[body] += velocities[body] * dt;
+			}
+			if (threads > 1) {
+				contact_solver_wait(barrier);
+			}
+
+			for (unsigned int iteration = 0; iteration < positionIterations_; ++iteration) {
+				forEachColor(thread, barrier, [&](size_t contact) {
+					solvePosition(contact, positions, inverseMasses);
+				});
+			}
+		}, threads, 1);
+	}
+
+	size_t ContactSolver::size() const {
+		return firsts_.size();
+	}
+
+	size_t ContactSolver::colorCount() const {
+		return colorStarts_.empty() ? 0 : colorStarts_.size() - 1;
+	}
+
+	float ContactSolver::normalImpulse(size_t contact) const {
+		return normalImpulses_.at(contact);
+	}
+
+	float ContactSolver::tangentImpulse(size_t contact) const {
+		return tangentImpulses_.at(contact);
+	}
+
+	void ContactSolver::prepare(std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses) {
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			const std::uint32_t first = firsts_[contact];
+			const std::uint32_t other = others_[contact];
+			const vec_t& normal = normals_[contact];
+
+			const float inverseMass = inverseMasses[first] + inverseMasses[other];
+			masses_[contact] = inverseMass > 0.f ? 1.f / inverseMass : 0.f;
+
+			// The contact bounces if the bodies approach each other fast enough
+			const float normalSpeed = vec_dot_product(velocities[other] - velocities[first], normal);
+			velocityBiases_[contact] = normalSpeed < -restitutionThreshold_ ? -restitutions_[contact] * normalSpeed : 0.f;
+
+			// Warm starting
+			const std::uint64_t key = contact_solver_key(first, other);
+			auto it = std::lower_bound(warmKeys_.begin(), warmKeys_.end(), key);
+			if (it == warmKeys_.end() || *it != key) {
+				continue;
+			}
+			const size_t warm = it - warmKeys_.begin();
+			const vec_t warmNormal = first < other ? warmNormals_[warm] : -warmNormals_[warm];
+			if (vec_dot_product(warmNormal, normal) < CONTACT_SOLVER_WARM_START_COSINE) {
+				continue;
+			}
+			normalImpulses_[contact] = warmNormalImpulses_[warm];
+			tangentImpulses_[contact] = warmTangentImpulses_[warm];
+
+			const vec_t impulse = normal * normalImpulses_[contact] + vec_t(-normal.y, normal.x) * tangentImpulses_[contact];
+			contact_solver_apply(velocities, first, other, impulse, inverseMasses[first], inverseMasses[other]);
+		}
+	}
+
+	void ContactSolver::color(const std::vector<float>& inverseMasses) {
+		// Greedy coloring : each contact takes the first color that none of the contacts of its dynamic bodies use
+		bodyColors_.assign(inverseMasses.size(), 0);
+		std::vector<std::uint8_t> colors(firsts_.size());
+		std::vector<size_t> counts(CONTACT_SOLVER_COLORS + 1, 0);
+		size_t colorCount = 0;
+
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			const std::uint32_t first = firsts_[contact];
+			const std::uint32_t other = others_[contact];
+			// Static bodies aren't written by the contacts, they can be shared by contacts of the same color
+			const bool firstDynamic = inverseMasses[first] > 0.f;
+			const bool otherDynamic = inverseMasses[other] > 0.f;
+
+			const std::uint64_t used = (firstDynamic ? bodyColors_[first] : 0) | (otherDynamic ? bodyColors_[other] : 0);
+			size_t color = 0;
+			while (color < CONTACT_SOLVER_COLORS && (used >> color) & 1) {
+				++color;
+			}
+			if (color < CONTACT_SOLVER_COLORS) {
+				const std::uint64_t bit = std::uint64_t(1) << color;
+				if (firstDynamic) {
+					bodyColors_[first] |= bit;
+				}
+				if (otherDynamic) {
+					bodyColors_[other] |= bit;
+				}
+			}
+
+			colors[contact] = static_cast<std::uint8_t>(color);
+			++counts[color];
+			colorCount = std::max(colorCount, color + 1);
+		}
+
+		// Counting sort of the contacts by color
+		colorStarts_.assign(colorCount + 1, 0);
+		for (size_t color = 0; color < colorCount; ++color) {
+			colorStarts_[color + 1] = colorStarts_[color] + counts[color];
+		}
+		std::vector<size_t> next(colorStarts_.begin(), colorStarts_.end() - 1);
+		order_.resize(firsts_.size());
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			order_[next[colors[contact]]++] = static_cast<std::uint32_t>(contact);
+		}
+	}
+
+	template<typename Function>
+	void ContactSolver::forEachColor(size_t thread, ContactSolverBarrier& barrier, const Function& function) const {
+		for (size_t color = 0; color + 1 < colorStarts_.size(); ++color) {
+			const size_t start = colorStarts_[color];
+			const size_t count = colorStarts_[color + 1] - start;
+			// Same chunks as parallel_for(). The contacts that didn't fit in the colors share bodies : one thread only
+			const size_t chunks = color < CONTACT_SOLVER_COLORS ? std::max<size_t>(1, std::min<size_t>(barrier.threadCount, (count + CONTACT_SOLVER_MIN_CHUNK_SIZE - 1) / CONTACT_SOLVER_MIN_CHUNK_SIZE)) : 1;
+			const size_t chunkSize = (count + chunks - 1) / chunks;
+			for (size_t i = start + thread * chunkSize; i < start + std::min(count, (thread + 1) * chunkSize); ++i) {
+				function(order_[i]);
+			}
+			if (barrier.threadCount > 1) {
+				contact_solver_wait(barrier);
+			}
+		}
+	}
+
+	void ContactSolver::solveVelocity(size_t contact, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses) {
+		const std::uint32_t first = firsts_[contact];
+		const std::uint32_t other = others_[contact];
+		const vec_t& normal = normals_[contact];
+		const vec_t tangent(-normal.y, normal.x);
+		const float firstInverseMass = inverseMasses[first];
+		const float otherInverseMass = inverseMasses[other];
+		const float mass = masses_[contact];
+
+		// Friction, bounded by the normal impulse
+		vec_t relativeVelocity = velocities[other] - velocities[first];
+		const float maxFriction = frictions_[contact] * normalImpulses_[contact];
+		const float previousTangentImpulse = tangentImpulses_[contact];
+		tangentImpulses_[contact] = std::max(-maxFriction, std::min(maxFriction, previousTangentImpulse - mass * vec_dot_product(relativeVelocity, tangent)));
+		const vec_t tangentImpulse = tangent * (tangentImpulses_[contact] - previousTangentImpulse);
+		contact_solver_apply(velocities, first, other, tangentImpulse, firstInverseMass, otherInverseMass);
+
+		// The accumulated normal impulse can only push the bodies apart
+		relativeVelocity = velocities[other] - velocities[first];
+		const float previousNormalImpulse = normalImpulses_[contact];
+		normalImpulses_[contact] = std::max(0.f, previousNormalImpulse + mass * (velocityBiases_[contact] - vec_dot_product(relativeVelocity, normal)));
+		const vec_t normalImpulse = normal * (normalImpulses_[contact] - previousNormalImpulse);
+		contact_solver_apply(velocities, first, other, normalImpulse, firstInverseMass, otherInverseMass);
+	}
+
+	void ContactSolver::solvePosition(size_t contact, std::vector<vec_t>& positions, const std::vector<float>& inverseMasses) {
+		const std::uint32_t first = firsts_[contact];
+		const std::uint32_t other = others_[contact];
+		const vec_t& normal = normals_[contact];
+
+		// Penetration left after the bodies moved since the beginning of the tick
+		const vec_t displacement = (positions[other] - startPositions_[other]) - (positions[first] - startPositions_[first]);
+		const float depth = depths_[contact] - vec_dot_product(displacement, normal);
+		if (depth <= slop_) {
+			return;
+		}
+
+		const vec_t correction = normal * (CONTACT_SOLVER_CORRECTION_FACTOR * (depth - slop_) * masses_[contact]);
+		contact_solver_apply(positions, first, other, correction, inverseMasses[first], inverseMasses[other]);
+	}
+}
+
+#include <algorithm>
+#include <numeric>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr unsigned int RADIX_BITS = 8;
+		constexpr size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+		constexpr std::uint32_t RADIX_MASK = static_cast<std::uint32_t>(RADIX_BUCKETS - 1);
+		constexpr size_t RADIX_MIN_CHUNK_SIZE = 16384;
+		constexpr float MORTON_GRID_MAX = 65535.f;
+
+		/**
+		 * \brief Inserts a 0 bit between each of the 16 lowest bits of the given value.
+		 */
+		static std::uint32_t spread_bits(std::uint32_t v) {
+			v &= 0x0000FFFF;
+			v = (v | (v << 8)) & 0x00FF00FF;
+			v = (v | (v << 4)) & 0x0F0F0F0F;
+			v = (v | (v << 2)) & 0x33333333;
+			v = (v | (v << 1)) & 0x55555555;
+			return v;
+		}
+
+		/**
+		 * \brief Maps a coordinate to the [0, 65535] range of the quantization grid.
+		 */
+		static std::uint32_t quantize(float value, float min, float size) {
+			if (size <= 0.f) {
+				return 0;
+			}
+			float normalized = (value - min) / size * MORTON_GRID_MAX;
+			normalized = std::min(std::max(normalized, 0.f), MORTON_GRID_MAX);
+			return static_cast<std::uint32_t>(normalized);
+		}
+
+		std::uint32_t morton_encode(std::uint32_t x, std::uint32_t y) {
+			return spread_bits(x) | (spread_bits(y) << 1);
+		}
+
+		std::uint32_t morton_code(const vec_t& point, const AABB& worldBounds) {
+			return morton_encode(
+				quantize(point.x, worldBounds.pos.x, worldBounds.size.x),
+				quantize(point.y, worldBounds.pos.y, worldBounds.size.y));
+		}
+
+		std::vector<std::uint32_t> morton_codes(const std::vector<AABB>& aabbs, const AABB& worldBounds) {
+			std::vector<std::uint32_t> codes(aabbs.size());
+			for (size_t i = 0; i < aabbs.size(); ++i) {
+				codes[i] = morton_code(aabbs[i].center(), worldBounds);
+			}
+			return codes;
+		}
+
+		std::vector<std::uint32_t> morton_codes(const std::vector<Circle>& circles, const AABB& worldBounds) {
+			std::vector<std::uint32_t> codes(circles.size());
+			for (size_t i = 0; i < circles.size(); ++i) {
+				codes[i] = morton_code(circles[i].pos, worldBounds);
+			}
+			return codes;
+		}
+
+		void radix_sort(std::vector<std::uint32_t>& keys, std::vector<std::uint32_t>& values, unsigned int threadCount) {
+			if (threadCount == 0) {
+				threadCount = default_thread_count();
+			}
+
+			const size_t count = keys.size();
+			std::vector<std::uint32_t> sortedKeys(count);
+			std::vector<std::uint32_t> sortedValues(count);
+
+			// One histogram per chunk, so that the threads never write to the same counters
+			std::vector<size_t> histograms(threadCount * RADIX_BUCKETS);
+
+			for (unsigned int shift = 0; shift < 32; shift += RADIX_BITS) {
+				std::fill(histograms.begin(), histograms.end(), 0);
+
+				size_t chunks = parallel_for(count, [&](size_t begin, size_t end, size_t chunk) {
+					size_t* histogram = &histograms[chunk * RADIX_BUCKETS];
+					for (size_t i = begin; i < end; ++i) {
+						++histogram[(keys[i] >> shift) & RADIX_MASK];
+					}
+				}, threadCount, RADIX_MIN_CHUNK_SIZE);
+
+				// Exclusive prefix sum, ordered by digit then by chunk, to keep the sort stable
+				bool singleDigit = false;
+				size_t offset = 0;
+				for (size_t digit = 0; digit < RADIX_BUCKETS; ++digit) {
+					size_t digitCount = 0;
+					for (size_t chunk = 0; chunk < chunks; ++chunk) {
+						size_t& counter = histograms[chunk * RADIX_BUCKETS + digit];
+						size_t chunkCount = counter;
+						counter = offset;
+						offset += chunkCount;
+						digitCount += chunkCount;
+					}
+					singleDigit = singleDigit || digitCount == count;
+				}
+
+				if (singleDigit) {
+					continue;
+				}
+
+				parallel_for(count, [&](size_t begin, size_t end, size_t chunk) {
+					size_t* positions = &histograms[chunk * RADIX_BUCKETS];
+					for (size_t i = begin; i < end; ++i) {
+						size_t position = positions[(keys[i] >> shift) & RADIX_MASK]++;
+						sortedKeys[position] = keys[i];
+						sortedValues[position] = values[i];
+					}
+				}, threadCount, RADIX_MIN_CHUNK_SIZE);
+
+				keys.swap(sortedKeys);
+				values.swap(sortedValues);
+			}
+		}
+
+		/**
+		 * \brief Sorts the given Morton codes and returns the resulting permutation.
+		 */
+		static std::vector<std::uint32_t> sort_morton_codes(std::vector<std::uint32_t>& codes, unsigned int threadCount) {
+			std::vector<std::uint32_t> permutation(codes.size());
+			std::iota(permutation.begin(), permutation.end(), 0);
+			radix_sort(codes, permutation, threadCount);
+			return permutation;
+		}
+
+		std::vector<std::uint32_t> morton_order(const std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount) {
+			auto codes = morton_codes(aabbs, worldBounds);
+			return sort_morton_codes(codes, threadCount);
+		}
+
+		std::vector<std::uint32_t> morton_order(const std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount) {
+			auto codes = morton_codes(circles, worldBounds);
+			return sort_morton_codes(codes, threadCount);
+		}
+
+		std::vector<std::uint32_t> morton_sort(std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount) {
+			auto permutation = morton_order(aabbs, worldBounds, threadCount);
+			apply_permutation(aabbs, permutation);
+			return permutation;
+		}
+
+		std::vector<std::uint32_t> morton_sort(std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount) {
+			auto permutation = morton_order(circles, worldBounds, threadCount);
+			apply_permutation(circles, permutation);
+			return permutation;
+		}
+	}
+}
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ch {
+	namespace spatial {
+
+		constexpr size_t LBVH_MIN_CHUNK_SIZE = 4096;
+
+		/**
+		 * \brief Counts the number of leading zero bits of a 32-bit value (32 for 0).
+		 */
+		static int count_leading_zeros(std::uint32_t value) {
+			if (value == 0) {
+				return 32;
+			}
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanReverse(&index, value);
+			return 31 - static_cast<int>(index);
+#else
+			return __builtin_clz(value);
+#endif
+		}
+
+		/**
+		 * \brief Computes where a segment enters the bounds of a node (slab test).
+		 *
+		 * \param tMax The test fails if the entry point is further than this value along the segment.
+		 * \param entry Receives the entry position along the segment (0 if the segment starts inside the bounds).
+		 * \return True if the segment crosses the bounds before tMax.
+		 */
+		static bool lbvh_segment_entry(const vec_t& origin, const vec_t& direction, const LBVHNode& node, float tMax, float& entry) {
+			float tMin = 0.f;
+
+			const float origins[2] = { origin.x, origin.y };
+			const float directions[2] = { direction.x, direction.y };
+			const float mins[2] = { node.minX, node.minY };
+			const float maxs[2] = { node.maxX, node.maxY };
+
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+						return false;
+					}
+					continue;
+				}
+
+				float inverse = 1.f / directions[axis];
+				float t1 = (mins[axis] - origins[axis]) * inverse;
+				float t2 = (maxs[axis] - origins[axis]) * inverse;
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+				if (tMin > tMax) {
+					return false;
+				}
+			}
+
+			entry = tMin;
+			return true;
+		}
+
+		LBVH::LBVH() : nodes_(), bounds_(), codes_(), order_(), parents_(), rangeFirst_(), rangeLast_(), visits_() {}
+
+		void LBVH::build(const std::vector<AABB>& aabbs, unsigned int threadCount) {
+			bounds_.resize(aabbs.size());
+			for (size_t i = 0; i < aabbs.size(); ++i) {
+				bounds_[i] = Bounds(aabbs[i]);
+			}
+			build(bounds_, threadCount);
+		}
+
+		void LBVH::build(const std::vector<Bounds>& bounds, unsigned int threadCount) {
+			const size_t count = bounds.size();
+			nodes_.resize(count > 0 ? 2 * count - 1 : 0);
+			if (count == 0) {
+				return;
+			}
+			if (threadCount == 0) {
+				threadCount = default_thread_count();
+			}
+
+			const size_t internalCount = count - 1;
+			codes_.resize(count);
+			order_.resize(count);
+			parents_.resize(nodes_.size());
+			rangeFirst_.resize(internalCount);
+			rangeLast_.resize(internalCount);
+			if (visits_.size() < internalCount) {
+				visits_ = std::vector<std::atomic<std::uint32_t>>(internalCount);
+			}
+
+			// 1. Bounds of the centers, used to quantize the Morton codes
+			std::vector<Bounds> chunkBounds(threadCount);
+			size_t chunks = parallel_for(count, [&](size_t begin, size_t end, size_t chunk) {
+				vec_t min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+				vec_t max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+				for (size_t i = begin; i < end; ++i) {
+					vec_t center = bounds[i].center();
+					min = vec_t(std::min(min.x, center.x), std::min(min.y, center.y));
+					max = vec_t(std::max(max.x, center.x), std::max(max.y, center.y));
+				}
+				chunkBounds[chunk] = Bounds(min, max);
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			vec_t worldMin = chunkBounds[0].min;
+			vec_t worldMax = chunkBounds[0].max;
+			for (size_t chunk = 1; chunk < chunks; ++chunk) {
+				worldMin = vec_t(std::min(worldMin.x, chunkBounds[chunk].min.x), std::min(worldMin.y, chunkBounds[chunk].min.y));
+				worldMax = vec_t(std::max(worldMax.x, chunkBounds[chunk].max.x), std::max(worldMax.y, chunkBounds[chunk].max.y));
+			}
+			const AABB world(worldMin, worldMax - worldMin);
+
+			// 2. Morton codes, sorted
+			parallel_for(count, [&](size_t begin, size_t end, size_t) {
+				for (size_t i = begin; i < end; ++i) {
+					codes_[i] = morton_code(bounds[i].center(), world);
+					order_[i] = static_cast<std::uint32_t>(i);
+				}
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			radix_sort(codes_, order_, threadCount);
+
+			// 3. Leaves and internal nodes. Every internal node is built independently.
+			parents_[0] = INVALID_INDEX;
+			parallel_for(count, [&](size_t begin, size_t end, size_t) {
+				for (size_t i = begin; i < end; ++i) {
+					const Bounds& leafBounds = bounds[order_[i]];
+					LBVHNode& leaf = nodes_[internalCount + i];
+					leaf.minX = leafBounds.min.x;
+					leaf.minY = leafBounds.min.y;
+					leaf.maxX = leafBounds.max.x;
+					leaf.maxY = leafBounds.max.y;
+					leaf.child = order_[i];
+
+					if (i < internalCount) {
+						visits_[i].store(0, std::memory_order_relaxed);
+						buildInternalNode(static_cast<std::int64_t>(i));
+					}
+				}
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			// 4. Escape links : the next node in depth-first order once the subtree of a node is done.
+			// If a node covers the leaves up to r, the next subtree starts at leaf r + 1. It is
+			// the internal node r + 1 if that node's range starts at r + 1, the leaf r + 1 otherwise.
+			const auto escapeAfter = [&](std::uint32_t last) {
+				if (last + 1 >= count) {
+					return INVALID_INDEX;
+				}
+				if (last + 1 < internalCount && rangeFirst_[last + 1] == last + 1) {
+					return last + 1;
+				}
+				return static_cast<std::uint32_t>(internalCount + last + 1);
+			};
+
+			parallel_for(count, [&](size_t begin, size_t end, size_t) {
+				for (size_t i = begin; i < end; ++i) {
+					nodes_[internalCount + i].escape = escapeAfter(static_cast<std::uint32_t>(i));
+					if (i < internalCount) {
+						nodes_[i].escape = escapeAfter(rangeLast_[i]);
+					}
+				}
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			// 5. Bounds, from the leaves up to the root
+			if (internalCount > 0) {
+				parallel_for(count, [&](size_t begin, size_t end, size_t) {
+					for (size_t i = begin; i < end; ++i) {
+						propagateBounds(static_cast<std::uint32_t>(internalCount + i));
+					}
+				}, threadCount, LBVH_MIN_CHUNK_SIZE);
+			}
+		}
+
+		int LBVH::commonPrefix(std::int64_t i, std::int64_t j) const {
+			if (j < 0 || j >= static_cast<std::int64_t>(codes_.size())) {
+				return -1;
+			}
+			std::uint32_t a = codes_[static_cast<size_t>(i)];
+			std::uint32_t b = codes_[static_cast<size_t>(j)];
+			if (a == b) {
+				// Identical codes are told apart by their position in the sorted array
+				return 32 + count_leading_zeros(static_cast<std::uint32_t>(i ^ j));
+			}
+			return count_leading_zeros(a ^ b);
+		}
+
+		void LBVH::buildInternalNode(std::int64_t i) {
+			const std::int64_t internalCount = static_cast<std::int64_t>(codes_.size()) - 1;
+
+			// Direction of the range covered by the node
+			const std::int64_t d = commonPrefix(i, i + 1) - commonPrefix(i, i - 1) >= 0 ? 1 : -1;
+			const int minPrefix = commonPrefix(i, i - d);
+
+			// Upper bound of the length of the range, then binary search of the other end
+			std::int64_t maxLength = 2;
+			while (commonPrefix(i, i + maxLength * d) > minPrefix) {
+				maxLength *= 2;
+			}
+			std::int64_t length = 0;
+			for (std::int64_t step = maxLength / 2; step >= 1; step /= 2) {
+				if (commonPrefix(i, i + (length + step) * d) > minPrefix) {
+					length += step;
+				}
+			}
+			const std::int64_t j = i + length * d;
+
+			// Binary search of the split position
+			const int nodePrefix = commonPrefix(i, j);
+			std::int64_t split = 0;
+			std::int64_t step = length;
+			do {
+				step = (step + 1) / 2;
+				if (split + step < length && commonPrefix(i, i + (split + step) * d) > nodePrefix) {
+					split += step;
+				}
+			} while (step > 1);
+			const std::int64_t gamma = i + split * d + std::min<std::int64_t>(d, 0);
+
+			const std::int64_t first = std::min(i, j);
+			const std::int64_t last = std::max(i, j);
+			const std::uint32_t left = static_cast<std::uint32_t>(first == gamma ? internalCount + gamma : gamma);
+			const std::uint32_t right = static_cast<std::uint32_t>(last == gamma + 1 ? internalCount + gamma + 1 : gamma + 1);
+
+			LBVHNode& node = nodes_[static_cast<size_t>(i)];
+			node.child = left;
+			rangeFirst_[static_cast<size_t>(i)] = static_cast<std::uint32_t>(first);
+			rangeLast_[static_cast<size_t>(i)] = static_cast<std::uint32_t>(last);
+			parents_[left] = static_cast<std::uint32_t>(i);
+			parents_[right] = static_cast<std::uint32_t>(i);
+		}
+
+		void LBVH::propagateBounds(std::uint32_t leaf) {
+			std::uint32_t node = parents_[leaf];
+			while (node != INVALID_INDEX) {
+				// The first child to arrive stops, the second one computes the bounds of the parent
+				if (visits_[node].fetch_add(1, std::memory_order_acq_rel) == 0) {
+					return;
+				}
+
+				// The escape node of a left child is always its right sibling
+				const LBVHNode& left = nodes_[nodes_[node].child];
+				const LBVHNode& right = nodes_[left.escape];
+
+				LBVHNode& current = nodes_[node];
+				current.minX = std::min(left.minX, right.minX);
+				current.minY = std::min(left.minY, right.minY);
+				current.maxX = std::max(left.maxX, right.maxX);
+				current.maxY = std::max(left.maxY, right.maxY);
+
+				node = parents_[node];
+			}
+		}
+
+		void LBVH::query(const AABB& aabb, std::vector<std::uint32_t>& results) const {
+			query(Bounds(aabb), results);
+		}
+
+		void LBVH::query(const Bounds& bounds, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			const float minX = bounds.min.x;
+			const float minY = bounds.min.y;
+			const float maxX = bounds.max.x;
+			const float maxY = bounds.max.y;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				bool overlaps = maxX >= node.minX && maxY >= node.minY && minX <= node.maxX && minY <= node.maxY;
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps) {
+					results.push_back(node.child);
+				}
+				index = node.escape;
+			}
+		}
+
+		void LBVH::query(const Circle& circle, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			const float radiusSquared = circle.radius * circle.radius;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				float dx = std::max(std::max(node.minX - circle.pos.x, 0.f), circle.pos.x - node.maxX);
+				float dy = std::max(std::max(node.minY - circle.pos.y, 0.f), circle.pos.y - node.maxY);
+				bool overlaps = dx * dx + dy * dy < radiusSquared;
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps) {
+					results.push_back(node.child);
+				}
+				index = node.escape;
+			}
+		}
+
+		void LBVH::query(const LineSegment& segment, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			const vec_t direction = segment.end - segment.start;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				float entry;
+				bool overlaps = lbvh_segment_entry(segment.start, direction, node, 1.f, entry);
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps) {
+					results.push_back(node.child);
+				}
+				index = node.escape;
+			}
+		}
+
+		bool LBVH::raycast(const LineSegment& ray, RaycastHit& hit) const {
+			const vec_t direction = ray.end - ray.start;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			float closest = 1.f;
+			std::uint32_t closestIndex = INVALID_INDEX;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				float entry;
+				// Subtrees further than the closest hit found so far are skipped
+				bool overlaps = lbvh_segment_entry(ray.start, direction, node, closest, entry);
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps && (closestIndex == INVALID_INDEX || entry < closest)) {
+					closest = entry;
+					closestIndex = node.child;
+				}
+				index = node.escape;
+			}
+
+			if (closestIndex == INVALID_INDEX) {
+				return false;
+			}
+
+			hit = RaycastHit{ closestIndex, closest, ray.start + direction * closest };
+			return true;
+		}
+
+		const std::vector<LBVHNode>& LBVH::nodes() const {
+			return nodes_;
+		}
+
+		size_t LBVH::size() const {
+			return nodes_.empty() ? 0 : (nodes_.size() + 1) / 2;
+		}
+	}
+}
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr float SAH_TRAVERSAL_COST = 1.f; /**< Cost of visiting a node, relative to testing one segment. */
+		constexpr std::uint32_t SAH_MAX_DEPTH = 64; /**< Deeper nodes are split in the middle, which bounds the depth of the tree. */
+		constexpr std::uint32_t SEGMENT_BVH_STACK_SIZE = 128; /**< Larger than the deepest possible tree (SAH_MAX_DEPTH + 32). */
+		constexpr char SEGMENT_BVH_MAGIC[4] = { 'C', 'H', 'S', 'B' };
+		constexpr std::uint32_t SEGMENT_BVH_VERSION = 1;
+
+		/**
+		 * \brief Bounds and center of a segment, used while building a SegmentBVH.
+		 */
+		struct SegmentBVHReference {
+			float minX, minY, maxX, maxY;
+			float center[2];
+			std::uint32_t index;
+		};
+
+		/**
+		 * \brief Half of the perimeter of the given bounds, used as the "surface area" of the heuristic.
+		 */
+		static float half_perimeter(float minX, float minY, float maxX, float maxY) {
+			return (maxX - minX) + (maxY - minY);
+		}
+
+		/**
+		 * \brief Builds the node covering the references [begin, end) and its subtree.
+		 * \return The index of the node.
+		 */
+		static std::uint32_t build_segment_bvh_node(std::vector<SegmentBVHReference>& references, std::vector<float>& costs, size_t begin, size_t end, std::uint32_t depth, std::uint32_t maxLeafSize, std::vector<SegmentBVHNode>& nodes) {
+			const std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+			nodes.emplace_back();
+
+			SegmentBVHNode node{};
+			node.minX = node.minY = std::numeric_limits<float>::max();
+			node.maxX = node.maxY = std::numeric_limits<float>::lowest();
+			for (size_t i = begin; i < end; ++i) {
+				node.minX = std::min(node.minX, references[i].minX);
+				node.minY = std::min(node.minY, references[i].minY);
+				node.maxX = std::max(node.maxX, references[i].maxX);
+				node.maxY = std::max(node.maxY, references[i].maxY);
+			}
+
+			const size_t count = end - begin;
+			const float area = half_perimeter(node.minX, node.minY, node.maxX, node.maxY);
+
+			// Sweep along both axes to find the split with the lowest cost. The cost of a child is
+			// the probability of hitting it (its area relative to the parent) times its segment count.
+			float bestCost = std::numeric_limits<float>::max();
+			std::uint32_t bestAxis = 0;
+			size_t bestSplit = begin + count / 2;
+			const bool useHeuristic = depth < SAH_MAX_DEPTH && area > 0.f && count > 1;
+
+			for (std::uint32_t axis = 0; useHeuristic && axis < 2; ++axis) {
+				std::sort(references.begin() + begin, references.begin() + end, [axis](const SegmentBVHReference& a, const SegmentBVHReference& b) {
+					return a.center[axis] < b.center[axis];
+				});
+
+				// Right side costs, from the end
+				float minX = std::numeric_limits<float>::max(), minY = minX;
+				float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+				for (size_t i = end - 1; i > begin; --i) {
+					minX = std::min(minX, references[i].minX);
+					minY = std::min(minY, references[i].minY);
+					maxX = std::max(maxX, references[i].maxX);
+					maxY = std::max(maxY, references[i].maxY);
+					costs[i] = half_perimeter(minX, minY, maxX, maxY) * static_cast<float>(end - i);
+				}
+
+				// Left side costs, from the beginning
+				minX = minY = std::numeric_limits<float>::max();
+				maxX = maxY = std::numeric_limits<float>::lowest();
+				for (size_t i = begin + 1; i < end; ++i) {
+					minX = std::min(minX, references[i - 1].minX);
+					minY = std::min(minY, references[i - 1].minY);
+					maxX = std::max(maxX, references[i - 1].maxX);
+					maxY = std::max(maxY, references[i - 1].maxY);
+					float cost = SAH_TRAVERSAL_COST + (half_perimeter(minX, minY, maxX, maxY) * static_cast<float>(i - begin) + costs[i]) / area;
+					if (cost < bestCost) {
+						bestCost = cost;
+						bestAxis = axis;
+						bestSplit = i;
+					}
+				}
+			}
+
+			if (count <= maxLeafSize && (!useHeuristic || bestCost >= static_cast<float>(count))) {
+				node.firstOrRight = static_cast<std::uint32_t>(begin);
+				node.count = static_cast<std::uint32_t>(count);
+				nodes[index] = node;
+				return index;
+			}
+
+			if (useHeuristic && bestAxis != 1) {
+				std::sort(references.begin() + begin, references.begin() + end, [bestAxis](const SegmentBVHReference& a, const SegmentBVHReference& b) {
+					return a.center[bestAxis] < b.center[bestAxis];
+				});
+			}
+
+			node.axis = bestAxis;
+			build_segment_bvh_node(references, costs, begin, bestSplit, depth + 1, maxLeafSize, nodes);
+			node.firstOrRight = build_segment_bvh_node(references, costs, bestSplit, end, depth + 1, maxLeafSize, nodes);
+			nodes[index] = node;
+			return index;
+		}
+
+		/**
+		 * \brief Computes where a ray enters the bounds of a node (slab test).
+		 * \return True if the ray crosses the bounds before tMax.
+		 */
+		static bool segment_bvh_node_entry(const vec_t& origin, const vec_t& direction, const SegmentBVHNode& node, float tMax) {
+			float tMin = 0.f;
+
+			const float origins[2] = { origin.x, origin.y };
+			const float directions[2] = { direction.x, direction.y };
+			const float mins[2] = { node.minX, node.minY };
+			const float maxs[2] = { node.maxX, node.maxY };
+
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+						return false;
+					}
+					continue;
+				}
+
+				float inverse = 1.f / directions[axis];
+				float t1 = (mins[axis] - origins[axis]) * inverse;
+				float t2 = (maxs[axis] - origins[axis]) * inverse;
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+				if (tMin > tMax) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * \brief Computes where a ray (origin + t * direction, t in [0, 1]) crosses a segment.
+		 *
+		 * If the ray and the segment are collinear and overlapping, t is the start of the overlap.
+		 * A ray of length 0 never hits anything.
+		 *
+		 * \return True if the ray crosses the segment, false otherwise.
+		 */
+		static bool segment_bvh_ray_hit(const vec_t& origin, const vec_t& direction, const LineSegment& segment, float& t) {
+			const vec_t side = segment.end - segment.start;
+			const vec_t toSegment = segment.start - origin;
+			const float denominator = direction.x * side.y - direction.y * side.x;
+			const float toSegmentCrossSide = toSegment.x * side.y - toSegment.y * side.x;
+			const float toSegmentCrossDirection = toSegment.x * direction.y - toSegment.y * direction.x;
+
+			if (denominator != 0.f) {
+				float rayT = toSegmentCrossSide / denominator;
+				float segmentT = toSegmentCrossDirection / denominator;
+				if (rayT < 0.f || rayT > 1.f || segmentT < 0.f || segmentT > 1.f) {
+					return false;
+				}
+				t = rayT;
+				return true;
+			}
+
+			const float lengthSquared = direction.x * direction.x + direction.y * direction.y;
+			if (toSegmentCrossDirection != 0.f || lengthSquared == 0.f) {
+				return false; // Parallel or degenerate ray
+			}
+
+			// Collinear : project the extremities of the segment on the ray
+			float t0 = (toSegment.x * direction.x + toSegment.y * direction.y) / lengthSquared;
+			float t1 = t0 + (side.x * direction.x + side.y * direction.y) / lengthSquared;
+			float first = std::max(std::min(t0, t1), 0.f);
+			if (first > std::min(std::max(t0, t1), 1.f)) {
+				return false;
+			}
+			t = first;
+			return true;
+		}
+
+		/**
+		 * \brief Appends the bytes of a value to a buffer.
+		 */
+		template <typename T>
+		static void segment_bvh_write(std::vector<std::uint8_t>& buffer, const T* values, size_t count) {
+			const size_t offset = buffer.size();
+			buffer.resize(offset + sizeof(T) * count);
+			if (count > 0) {
+				std::memcpy(buffer.data() + offset, values, sizeof(T) * count);
+			}
+		}
+
+		/**
+		 * \brief Reads values from a buffer and advances the reading position.
+		 */
+		template <typename T>
+		static void segment_bvh_read(const std::vector<std::uint8_t>& buffer, size_t& offset, T* values, size_t count) {
+			if (count > 0) {
+				std::memcpy(values, buffer.data() + offset, sizeof(T) * count);
+			}
+			offset += sizeof(T) * count;
+		}
+
+		SegmentBVH::SegmentBVH() : nodes_(), segments_(), indices_() {}
+
+		void SegmentBVH::build(const std::vector<LineSegment>& segments, std::uint32_t maxLeafSize) {
+			nodes_.clear();
+			segments_.clear();
+			indices_.clear();
+			if (segments.empty()) {
+				return;
+			}
+
+			std::vector<SegmentBVHReference> references(segments.size());
+			for (size_t i = 0; i < segments.size(); ++i) {
+				const LineSegment& segment = segments[i];
+				SegmentBVHReference& reference = references[i];
+				reference.minX = segment.minX();
+				reference.minY = segment.minY();
+				reference.maxX = segment.maxX();
+				reference.maxY = segment.maxY();
+				reference.center[0] = (reference.minX + reference.maxX) / 2.f;
+				reference.center[1] = (reference.minY + reference.maxY) / 2.f;
+				reference.index = static_cast<std::uint32_t>(i);
+			}
+
+			std::vector<float> costs(segments.size());
+			nodes_.reserve(2 * segments.size());
+			build_segment_bvh_node(references, costs, 0, references.size(), 0, std::max<std::uint32_t>(maxLeafSize, 1), nodes_);
+			nodes_.shrink_to_fit();
+
+			// In depth-first order, the subtree of a node ends right before its escape node.
+			// The escape node of a left child is its right sibling.
+			for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+				nodes_[i].escape = INVALID_INDEX;
+			}
+			for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+				const SegmentBVHNode& node = nodes_[i];
+				if (node.count == 0) {
+					nodes_[i + 1].escape = node.firstOrRight;
+					nodes_[node.firstOrRight].escape = node.escape;
+				}
+			}
+
+			segments_.reserve(segments.size());
+			indices_.reserve(segments.size());
+			for (const auto& reference : references) {
+				segments_.push_back(segments[reference.index]);
+				indices_.push_back(reference.index);
+			}
+		}
+
+		bool SegmentBVH::closestHit(const LineSegment& ray, RaycastHit& hit) const {
+			if (nodes_.empty()) {
+				return false;
+			}
+
+			const vec_t direction = ray.end - ray.start;
+			const float directions[2] = { direction.x, direction.y };
+
+			float closest = std::numeric_limits<float>::max();
+			std::uint32_t closestSegment = INVALID_INDEX;
+
+			std::uint32_t stack[SEGMENT_BVH_STACK_SIZE];
+			std::uint32_t stackSize = 0;
+			stack[stackSize++] = 0;
+
+			while (stackSize > 0) {
+				const std::uint32_t index = stack[--stackSize];
+				const SegmentBVHNode& node = nodes_[index];
+				if (!segment_bvh_node_entry(ray.start, direction, node, std::min(closest, 1.f))) {
+					continue;
+				}
+
+				if (node.count > 0) {
+					for (std::uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+						float t;
+						if (segment_bvh_ray_hit(ray.start, direction, segments_[i], t) && t < closest) {
+							closest = t;
+							closestSegment = i;
+						}
+					}
+					continue;
+				}
+
+				// Visit the child that is closer to the ray origin first
+				const std::uint32_t left = index + 1;
+				const std::uint32_t right = node.firstOrRight;
+				if (directions[node.axis] < 0.f) {
+					stack[stackSize++] = left;
+					stack[stackSize++] = right;
+				}
+				else {
+					stack[stackSize++] = right;
+					stack[stackSize++] = left;
+				}
+			}
+
+			if (closestSegment == INVALID_INDEX) {
+				return false;
+			}
+
+			hit.index = indices_[closestSegment];
+			hit.t = closest;
+			hit.point = ray.start + direction * closest;
+			return true;
+		}
+
+		bool SegmentBVH::anyHit(const LineSegment& ray) const {
+			const vec_t direction = ray.end - ray.start;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const SegmentBVHNode& node = nodes_[index];
+				if (!segment_bvh_node_entry(ray.start, direction, node, 1.f)) {
+					index = node.escape;
+					continue;
+				}
+
+				if (node.count == 0) {
+					++index;
+					continue;
+				}
+
+				for (std::uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+					float t;
+					if (segment_bvh_ray_hit(ray.start, direction, segments_[i], t)) {
+						return true;
+					}
+				}
+				index = node.escape;
+			}
+			return false;
+		}
+
+		std::vector<std::uint8_t> SegmentBVH::serialize() const {
+			const std::uint32_t header[3] = {
+				SEGMENT_BVH_VERSION,
+				static_cast<std::uint32_t>(nodes_.size()),
+				static_cast<std::uint32_t>(segments_.size())
+			};
+
+			std::vector<float> coordinates;
+			coordinates.reserve(segments_.size() * 4);
+			for (const auto& segment : segments_) {
+				coordinates.insert(coordinates.end(), { segment.start.x, segment.start.y, segment.end.x, segment.end.y });
+			}
+
+			std::vector<std::uint8_t> buffer;
+			buffer.reserve(sizeof(SEGMENT_BVH_MAGIC) + sizeof(header) + nodes_.size() * sizeof(SegmentBVHNode) + segments_.size() * (4 * sizeof(float) + sizeof(std::uint32_t)));
+			segment_bvh_write(buffer, SEGMENT_BVH_MAGIC, 4);
+			segment_bvh_write(buffer, header, 3);
+			segment_bvh_write(buffer, nodes_.data(), nodes_.size());
+			segment_bvh_write(buffer, coordinates.data(), coordinates.size());
+			segment_bvh_write(buffer, indices_.data(), indices_.size());
+			return buffer;
+		}
+
+		SegmentBVH SegmentBVH::deserialize(const std::vector<std::uint8_t>& data) {
+			const size_t headerSize = sizeof(SEGMENT_BVH_MAGIC) + 3 * sizeof(std::uint32_t);
+			if (data.size() < headerSize) {
+				throw std::invalid_argument("Invalid argument : SegmentBVH data is truncated");
+			}
+
+			size_t offset = 0;
+			char magic[4];
+			std::uint32_t header[3];
+			segment_bvh_read(data, offset, magic, 4);
+			segment_bvh_read(data, offset, header, 3);
+			if (std::memcmp(magic, SEGMENT_BVH_MAGIC, 4) != 0 || header[0] != SEGMENT_BVH_VERSION) {
+				throw std::invalid_argument("Invalid argument : not a SegmentBVH or unsupported version");
+			}
+
+			const std::uint32_t nodeCount = header[1];
+			const std::uint32_t segmentCount = header[2];
+			const std::uint64_t expectedSize = headerSize + std::uint64_t(nodeCount) * sizeof(SegmentBVHNode) + std::uint64_t(segmentCount) * (4 * sizeof(float) + sizeof(std::uint32_t));
+			if (data.size() != expectedSize) {
+				throw std::invalid_argument("Invalid argument : SegmentBVH data has the wrong size");
+			}
+
+			SegmentBVH bvh;
+			bvh.nodes_.resize(nodeCount);
+			segment_bvh_read(data, offset, bvh.nodes_.data(), nodeCount);
+
+			std::vector<float> coordinates(size_t(segmentCount) * 4);
+			segment_bvh_read(data, offset, coordinates.data(), coordinates.size());
+			bvh.segments_.reserve(segmentCount);
+			for (size_t i = 0; i < segmentCount; ++i) {
+				bvh.segments_.emplace_back(vec_t(coordinates[i * 4], coordinates[i * 4 + 1]), vec_t(coordinates[i * 4 + 2], coordinates[i * 4 + 3]));
+			}
+
+			bvh.indices_.resize(segmentCount);
+			segment_bvh_read(data, offset, bvh.indices_.data(), segmentCount);
+
+			// Make sure that the queries never read out of bounds or overflow the traversal stack
+			bool valid = (nodeCount == 0) == (segmentCount == 0);
+			std::vector<std::uint32_t> depths(nodeCount, 0);
+			for (std::uint32_t i = 0; valid && i < nodeCount; ++i) {
+				const SegmentBVHNode& node = bvh.nodes_[i];
+				bool validEscape = node.escape == INVALID_INDEX || (node.escape > i && node.escape < nodeCount);
+				bool validChildren = node.count > 0
+					? node.firstOrRight <= segmentCount && node.count <= segmentCount - node.firstOrRight
+					: node.axis < 2 && node.firstOrRight > i + 1 && node.firstOrRight < nodeCount && depths[i] + 2 < SEGMENT_BVH_STACK_SIZE;
+				valid = validEscape && validChildren;
+				if (valid && node.count == 0) {
+					depths[i + 1] = std::max(depths[i + 1], depths[i] + 1);
+					depths[node.firstOrRight] = std::max(depths[node.firstOrRight], depths[i] + 1);
+				}
+			}
+			for (std::uint32_t i = 0; valid && i < segmentCount; ++i) {
+				valid = bvh.indices_[i] < segmentCount;
+			}
+			if (!valid) {
+				throw std::invalid_argument("Invalid argument : SegmentBVH data is corrupted");
+			}
+			return bvh;
+		}
+
+		const std::vector<SegmentBVHNode>& SegmentBVH::nodes() const {
+			return nodes_;
+		}
+
+		size_t SegmentBVH::size() const {
+			return segments_.size();
+		}
+	}
+}
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		SensorSystem::SensorSystem() :
+			types_(),
+			aabbs_(),
+			circles_(),
+			requireContainment_(),
+			overlaps_(),
+			freeSensors_(),
+			removedSensors_(),
+			candidates_(),
+			broadphase_(),
+			size_(0)
+		{}
+
+		std::uint32_t SensorSystem::add(const AABB& region, bool requireContainment) {
+			std::uint32_t sensor = allocate(requireContainment);
+			set(sensor, region);
+			return sensor;
+		}
+
+		std::uint32_t SensorSystem::add(const Circle& region, bool requireContainment) {
+			std::uint32_t sensor = allocate(requireContainment);
+			set(sensor, region);
+			return sensor;
+		}
+
+		void SensorSystem::set(std::uint32_t sensor, const AABB& region) {
+			checkSensor(sensor);
+			types_[sensor] = ShapeType::AABB;
+			aabbs_[sensor] = region;
+		}
+
+		void SensorSystem::set(std::uint32_t sensor, const Circle& region) {
+			checkSensor(sensor);
+			types_[sensor] = ShapeType::Circle;
+			circles_[sensor] = region;
+		}
+
+		void SensorSystem::remove(std::uint32_t sensor) {
+			checkSensor(sensor);
+			types_[sensor] = ShapeType::MAX_VALUE;
+			removedSensors_.push_back(sensor);
+			--size_;
+		}
+
+		void SensorSystem::update(const LBVH& broadphase, const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays) {
+			events.clear();
+
+			for (std::uint32_t sensor = 0; sensor < types_.size(); ++sensor) {
+				std::vector<std::uint32_t>& previous = overlaps_[sensor];
+				const ShapeType type = types_[sensor];
+
+				if (type == ShapeType::MAX_VALUE) {
+					// Removed sensor (or free identifier) : everything that was inside exits
+					for (std::uint32_t entity : previous) {
+						events.push_back(SensorEvent{ SensorEventType::Exit, sensor, entity });
+					}
+					previous.clear();
+					continue;
+				}
+
+				if (type == ShapeType::AABB) {
+					const AABB& region = aabbs_[sensor];
+					broadphase.query(region, candidates_);
+					if (requireContainment_[sensor]) {
+						candidates_.erase(std::remove_if(candidates_.begin(), candidates_.end(), [&](std::uint32_t entity) {
+							return !collision::aabb_contains(region, entities[entity]);
+						}), candidates_.end());
+					}
+				}
+				else {
+					const Circle& region = circles_[sensor];
+					broadphase.query(region, candidates_);
+					if (requireContainment_[sensor]) {
+						candidates_.erase(std::remove_if(candidates_.begin(), candidates_.end(), [&](std::uint32_t entity) {
+							return !collision::circle_contains(region, entities[entity]);
+						}), candidates_.end());
+					}
+				}
+				std::sort(candidates_.begin(), candidates_.end());
+
+				// Merge of the sorted overlaps of the previous tick with the new ones
+				size_t i = 0;
+				size_t j = 0;
+				while (i < previous.size() || j < candidates_.size()) {
+					if (j == candidates_.size() || (i < previous.size() && previous[i] < candidates_[j])) {
+						events.push_back(SensorEvent{ SensorEventType::Exit, sensor, previous[i++] });
+					}
+					else if (i == previous.size() || candidates_[j] < previous[i]) {
+						events.push_back(SensorEvent{ SensorEventType::Enter, sensor, candidates_[j++] });
+					}
+					else {
+						if (reportStays) {
+							events.push_back(SensorEvent{ SensorEventType::Stay, sensor, previous[i] });
+						}
+						++i;
+						++j;
+					}
+				}
+
+				// The buffer of the previous overlaps is reused by the next query
+				previous.swap(candidates_);
+			}
+
+			freeSensors_.insert(freeSensors_.end(), removedSensors_.begin(), removedSensors_.end());
+			removedSensors_.clear();
+		}
+
+		void SensorSystem::update(const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays) {
+			broadphase_.build(entities);
+			update(broadphase_, entities, events, reportStays);
+		}
+
+		const std::vector<std::uint32_t>& SensorSystem::overlaps(std::uint32_t sensor) const {
+			checkSensor(sensor);
+			return overlaps_[sensor];
+		}
+
+		size_t SensorSystem::size() const {
+			return size_;
+		}
+
+		void SensorSystem::checkSensor(std::uint32_t sensor) const {
+			if (sensor >= types_.size() || types_[sensor] == ShapeType::MAX_VALUE) {
+				throw std::invalid_argument("Invalid argument : the sensor doesn't exist.");
+			}
+		}
+
+		std::uint32_t SensorSystem::allocate(bool requireContainment) {
+			std::uint32_t sensor;
+			if (!freeSensors_.empty()) {
+				sensor = freeSensors_.back();
+				freeSensors_.pop_back();
+			}
+			else {
+				sensor = static_cast<std::uint32_t>(types_.size());
+				types_.push_back(ShapeType::MAX_VALUE);
+				aabbs_.emplace_back();
+				circles_.emplace_back();
+				requireContainment_.push_back(0);
+				overlaps_.emplace_back();
+			}
+			// Valid type until set() is called, so that checkSensor() accepts the new sensor
+			types_[sensor] = ShapeType::AABB;
+			requireContainment_[sensor] = requireContainment ? 1 : 0;
+			++size_;
+			return sensor;
+		}
+	}
+}
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr size_t KINEMATIC_MOVER_RESERVED_CANDIDATES = 64;
+
+		/**
+		 * \return The bounds of the area swept by the AABB, grown by the margin.
+		 */
+		static Bounds kinematic_swept_bounds(const AABB& aabb, const vec_t& motion, float margin) {
+			const Bounds bounds(aabb);
+			return Bounds(
+				std::min(bounds.min.x, bounds.min.x + motion.x) - margin, std::min(bounds.min.y, bounds.min.y + motion.y) - margin,
+				std::max(bounds.max.x, bounds.max.x + motion.x) + margin, std::max(bounds.max.y, bounds.max.y + motion.y) + margin);
+		}
+
+		/**
+		 * \return The bounds of the area swept by the circle, grown by the margin.
+		 */
+		static Bounds kinematic_swept_bounds(const Circle& circle, const vec_t& motion, float margin) {
+			const float r = circle.radius + margin;
+			return Bounds(
+				std::min(circle.pos.x, circle.pos.x + motion.x) - r, std::min(circle.pos.y, circle.pos.y + motion.y) - r,
+				std::max(circle.pos.x, circle.pos.x + motion.x) + r, std::max(circle.pos.y, circle.pos.y + motion.y) + r);
+		}
+
+		static bool kinematic_time_of_impact(const AABB& aabb, const vec_t& motion, const AABB& obstacle, float& time, vec_t& normal) {
+			return collision::aabb_time_of_impact(aabb, motion, obstacle, time, normal);
+		}
+
+		static bool kinematic_time_of_impact(const Circle& circle, const vec_t& motion, const AABB& obstacle, float& time, vec_t& normal) {
+			return collision::circle_aabb_time_of_impact(circle, motion, obstacle, time, normal);
+		}
+
+		/**
+		 * \brief Tests if the side of an obstacle is covered by another candidate, where the moving shape overlaps the obstacle.
+		 *
+		 * Pushing the shape out through such a side only moves it into the other obstacle (e.g. the seam between two tiles of a floor).
+		 *
+		 * \param direction Direction of the push out of the obstacle (UP_VEC, DOWN_VEC, LEFT_VEC or RIGHT_VEC).
+		 * \param overlap Intersection of the bounds of the shape and of the obstacle.
+		 */
+		static bool kinematic_side_covered(const std::vector<std::uint32_t>& candidates, const std::vector<AABB>& obstacles, std::uint32_t index, const vec_t& direction, const Bounds& overlap) {
+			const Bounds obstacle(obstacles[index]);
+			const vec_t middle = overlap.center();
+			for (std::uint32_t candidate : candidates) {
+				if (candidate == index) {
+					continue;
+				}
+				const Bounds other(obstacles[candidate]);
+				if (direction.x != 0.f) {
+					const float side = direction.x > 0.f ? obstacle.max.x : obstacle.min.x;
+					const bool across = direction.x > 0.f ? other.min.x <= side && side < other.max.x : other.min.x < side && side <= other.max.x;
+					if (across && other.min.y < middle.y && middle.y < other.max.y) {
+						return true;
+					}
+				}
+				else {
+					const float side = direction.y > 0.f ? obstacle.max.y : obstacle.min.y;
+					const bool across = direction.y > 0.f ? other.min.y <= side && side < other.max.y : other.min.y < side && side <= other.max.y;
+					if (across && other.min.x < middle.x && middle.x < other.max.x) {
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * \brief Finds the candidate the AABB overlaps the most and how to push the AABB out of it.
+		 * \param index Receives the index of the obstacle.
+		 * \param normal Receives the direction towards which the AABB must be pushed.
+		 * \return The penetration depth, 0 if the AABB doesn't overlap any candidate.
+		 */
+		static float kinematic_deepest_penetration(const AABB& aabb, const std::vector<std::uint32_t>& candidates, const std::vector<AABB>& obstacles, std::uint32_t& index, vec_t& normal) {
+			const Bounds bounds(aabb);
+			const vec_t center = bounds.center();
+			float largestArea = 0.f;
+			float deepest = 0.f;
+			for (std::uint32_t candidate : candidates) {
+				const Bounds obstacle(obstacles[candidate]);
+				const Bounds overlap(std::max(bounds.min.x, obstacle.min.x), std::max(bounds.min.y, obstacle.min.y), std::min(bounds.max.x, obstacle.max.x), std::min(bounds.max.y, obstacle.max.y));
+				const float area = (overlap.max.x - overlap.min.x) * (overlap.max.y - overlap.min.y);
+				if (overlap.max.x <= overlap.min.x || overlap.max.y <= overlap.min.y || area <= largestArea) {
+					continue;
+				}
+
+				// Push out along each axis, towards the side of the obstacle closest to the center of the AABB
+				const vec_t obstacleCenter = obstacle.center();
+				const bool left = center.x < obstacleCenter.x;
+				const bool up = center.y < obstacleCenter.y;
+				const float depthX = left ? bounds.max.x - obstacle.min.x : obstacle.max.x - bounds.min.x;
+				const float depthY = up ? bounds.max.y - obstacle.min.y : obstacle.max.y - bounds.min.y;
+				const bool coveredX = kinematic_side_covered(candidates, obstacles, candidate, left ? LEFT_VEC : RIGHT_VEC, overlap);
+				const bool coveredY = kinematic_side_covered(candidates, obstacles, candidate, up ? UP_VEC : DOWN_VEC, overlap);
+				const bool alongX = coveredX == coveredY ? depthX < depthY : coveredY;
+
+				largestArea = area;
+				deepest = alongX ? depthX : depthY;
+				normal = alongX ? (left ? LEFT_VEC : RIGHT_VEC) : (up ? UP_VEC : DOWN_VEC);
+				index = candidate;
+			}
+			return deepest;
+		}
+
+		/**
+		 * \brief Finds the candidate the circle overlaps the most and how to push the circle out of it.
+		 * \param index Receives the index of the obstacle.
+		 * \param normal Receives the direction towards which the circle must be pushed.
+		 * \return The penetration depth, 0 if the circle doesn't overlap any candidate.
+		 */
+		static float kinematic_deepest_penetration(const Circle& circle, const std::vector<std::uint32_t>& candidates, const std::vector<AABB>& obstacles, std::uint32_t& index, vec_t& normal) {
+			float deepest = 0.f;
+			for (std::uint32_t candidate : candidates) {
+				const Bounds obstacle(obstacles[candidate]);
+				CircleAABBCollision collision = collision::circle_aabb_collision_info(obstacle, circle);
+				if (collision.absoluteDepth <= deepest) {
+					continue;
+				}
+
+				// Center outside of the obstacle, closest to a corner on a covered side : the circle is pushed out through the other side instead
+				const vec_t closest(std::max(obstacle.min.x, std::min(circle.pos.x, obstacle.max.x)), std::max(obstacle.min.y, std::min(circle.pos.y, obstacle.max.y)));
+				const bool cornerX = closest.x == obstacle.min.x || closest.x == obstacle.max.x;
+				const bool cornerY = closest.y == obstacle.min.y || closest.y == obstacle.max.y;
+				if (cornerX && cornerY && collision.normal.x != 0.f && collision.normal.y != 0.f) {
+					const Bounds overlap(
+						std::max(circle.pos.x - circle.radius, obstacle.min.x), std::max(circle.pos.y - circle.radius, obstacle.min.y),
+						std::min(circle.pos.x + circle.radius, obstacle.max.x), std::min(circle.pos.y + circle.radius, obstacle.max.y));
+					const vec_t sideX = collision.normal.x < 0.f ? LEFT_VEC : RIGHT_VEC;
+					const vec_t sideY = collision.normal.y < 0.f ? UP_VEC : DOWN_VEC;
+					if (kinematic_side_covered(candidates, obstacles, candidate, sideX, overlap)) {
+						collision = CircleAABBCollision{ sideY, circle.radius - std::abs(circle.pos.y - closest.y) };
+					}
+					else if (kinematic_side_covered(candidates, obstacles, candidate, sideY, overlap)) {
+						collision = CircleAABBCollision{ sideX, circle.radius - std::abs(circle.pos.x - closest.x) };
+					}
+				}
+
+				if (collision.absoluteDepth > deepest) {
+					deepest = collision.absoluteDepth;
+					normal = collision.normal;
+					index = candidate;
+				}
+			}
+			return deepest;
+		}
+
+		/**
+		 * \return The distance the AABB must be pushed along an axis-aligned direction to leave the obstacle.
+		 */
+		static float kinematic_penetration_along(const AABB& aabb, const AABB& obstacle, const vec_t& direction) {
+			const Bounds bounds(aabb);
+			const Bounds other(obstacle);
+			if (direction.x != 0.f) {
+				return direction.x > 0.f ? other.max.x - bounds.min.x : bounds.max.x - other.min.x;
+			}
+			return direction.y > 0.f ? other.max.y - bounds.min.y : bounds.max.y - other.min.y;
+		}
+
+		/**
+		 * \return The distance the circle must be pushed along an axis-aligned direction to leave the obstacle.
+		 */
+		static float kinematic_penetration_along(const Circle& circle, const AABB& obstacle, const vec_t& direction) {
+			return kinematic_penetration_along(AABB(circle.pos - vec_t(circle.radius, circle.radius), vec_t(circle.radius, circle.radius) * 2.f), obstacle, direction);
+		}
+
+		KinematicMover::KinematicMover(std::uint32_t maxIterations, float skinWidth) : maxIterations_(maxIterations), skinWidth_(skinWidth), candidates_() {
+			if (maxIterations == 0 || maxIterations > MAX_SLIDE_ITERATIONS) {
+				throw std::invalid_argument("Invalid argument : the number of iterations must be between 1 and MAX_SLIDE_ITERATIONS.");
+			}
+			candidates_.reserve(KINEMATIC_MOVER_RESERVED_CANDIDATES);
+		}
+
+		template<typename Shape>
+		MoveResult KinematicMover::move(Shape shape, vec_t motion, const LBVH& broadphase, const std::vector<AABB>& obstacles) {
+			MoveResult result;
+			const vec_t initialMotion = motion;
+
+			// Pushes the shape out of the obstacles it already overlaps, the deepest overlap first
+			vec_t previousNormal = NULL_VEC;
+			for (std::uint32_t iteration = 0; iteration < maxIterations_; ++iteration) {
+				broadphase.query(kinematic_swept_bounds(shape, NULL_VEC, 0.f), candidates_);
+				std::uint32_t index = 0;
+				vec_t normal;
+				float depth = kinematic_deepest_penetration(shape, candidates_, obstacles, index, normal);
+				if (depth <= 0.f) {
+					break;
+				}
+
+				// Pushed back where the previous push came from : the shape is inside a solid area, it keeps going through it instead
+				if (vec_dot_product(normal, previousNormal) < 0.f && (previousNormal.x == 0.f || previousNormal.y == 0.f)) {
+					normal = previousNormal;
+					depth = kinematic_penetration_along(shape, obstacles[index], normal);
+				}
+				previousNormal = normal;
+
+				shape.pos += normal * (depth + skinWidth_);
+				if (result.contactCount < MAX_SLIDE_ITERATIONS) {
+					result.contacts[result.contactCount++] = SlideContact{ index, normal, shape.pos };
+				}
+				const float approach = vec_dot_product(motion, normal);
+				if (approach < 0.f) {
+					motion -= normal * approach;
+				}
+			}
+
+			for (std::uint32_t iteration = 0; iteration < maxIterations_ && motion != NULL_VEC; ++iteration) {
+				broadphase.query(kinematic_swept_bounds(shape, motion, skinWidth_), candidates_);
+
+				// First obstacle hit along the motion
+				float earliest = 2.f;
+				vec_t earliestNormal;
+				std::uint32_t earliestIndex = 0;
+				for (std::uint32_t index : candidates_) {
+					float time;
+					vec_t normal;
+					if (kinematic_time_of_impact(shape, motion, obstacles[index], time, normal) && time < earliest) {
+						earliest = time;
+						earliestNormal = normal;
+						earliestIndex = index;
+					}
+				}
+
+				if (earliest > 1.f) {
+					shape.pos += motion;
+					motion = NULL_VEC;
+					break;
+				}
+
+				// Stops at skinWidth from the obstacle, along the motion
+				const float length = vec_magnitude(motion);
+				const float travelled = std::max(earliest - skinWidth_ / length, 0.f);
+				shape.pos += motion * travelled;
+				if (result.contactCount < MAX_SLIDE_ITERATIONS) {
+					result.contacts[result.contactCount++] = SlideContact{ earliestIndex, earliestNormal, shape.pos };
+				}
+
+				// Slides along the obstacle with the motion left, unless it goes back against the initial motion
+				motion *= 1.f - travelled;
+				const float approach = vec_dot_product(motion, earliestNormal);
+				if (approach < 0.f) {
+					motion -= earliestNormal * approach;
+				}
+				if (vec_dot_product(motion, initialMotion) <= 0.f) {
+					motion = NULL_VEC;
+				}
+			}
+
+			result.position = shape.pos;
+			return result;
+		}
+
+		MoveResult KinematicMover::moveAndSlide(const AABB& aabb, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles) {
+			return move(aabb, motion, broadphase, obstacles);
+		}
+
+		MoveResult KinematicMover::moveAndSlide(const Circle& circle, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles) {
+			return move(circle, motion, broadphase, obstacles);
+		}
+	}
+}
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Counts the number of trailing zero bits of a non-zero 64-bit value.
+		 */
+		static int count_trailing_zeros(std::uint64_t value) {
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return static_cast<int>(index);
+#else
+			return __builtin_ctzll(value);
+#endif
+		}
+
+		/**
+		 * \return The bits of a word covering the columns first to last (included) of a row, the word starting at column word * 64.
+		 */
+		static std::uint64_t tile_map_word_mask(std::uint32_t word, std::uint32_t first, std::uint32_t last) {
+			const std::uint32_t low = first > word * 64 ? first - word * 64 : 0;
+			const std::uint32_t high = std::min<std::uint32_t>(last - word * 64, 63);
+			return (~std::uint64_t(0) << low) & (~std::uint64_t(0) >> (63 - high));
+		}
+
+		/**
+		 * \brief Calls the function with the coordinates of every solid tile of the range, row by row.
+		 */
+		template<typename Function>
+		static void tile_map_for_each_solid(const std::vector<std::uint64_t>& solid, std::uint32_t wordsPerRow, std::uint32_t x0, std::uint32_t y0, std::uint32_t x1, std::uint32_t y1, const Function& function) {
+			for (std::uint32_t y = y0; y <= y1; ++y) {
+				for (std::uint32_t word = x0 / 64; word <= x1 / 64; ++word) {
+					std::uint64_t bits = solid[y * wordsPerRow + word] & tile_map_word_mask(word, x0, x1);
+					while (bits != 0) {
+						function(word * 64 + count_trailing_zeros(bits), y);
+						bits &= bits - 1;
+					}
+				}
+			}
+		}
+
+		TileMap::TileMap(std::uint32_t width, std::uint32_t height, const vec_t& tileSize, const vec_t& origin) :
+			width_(width),
+			height_(height),
+			wordsPerRow_((width + 63) / 64),
+			tileSize_(tileSize),
+			origin_(origin),
+			solid_()
+		{
+			if (width == 0 || height == 0) {
+				throw std::invalid_argument("Invalid argument : the tile map must contain at least one tile.");
+			}
+			if (tileSize.x <= 0.f || tileSize.y <= 0.f) {
+				throw std::invalid_argument("Invalid argument : the size of the tiles must be positive.");
+			}
+			solid_.assign(static_cast<size_t>(wordsPerRow_) * height, 0);
+		}
+
+		void TileMap::setSolid(std::uint32_t x, std::uint32_t y, bool solid) {
+			if (x >= width_ || y >= height_) {
+				throw std::out_of_range("The tile is outside of the tile map.");
+			}
+			const std::uint64_t bit = std::uint64_t(1) << (x % 64);
+			std::uint64_t& word = solid_[y * wordsPerRow_ + x / 64];
+			word = solid ? word | bit : word & ~bit;
+		}
+
+		bool TileMap::isSolid(std::int64_t x, std::int64_t y) const {
+			if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+				return false;
+			}
+			return (solid_[y * wordsPerRow_ + x / 64] >> (x % 64)) & 1;
+		}
+
+		Bounds TileMap::tileBounds(std::uint32_t x, std::uint32_t y) const {
+			const vec_t min(origin_.x + x * tileSize_.x, origin_.y + y * tileSize_.y);
+			return Bounds(min, min + tileSize_);
+		}
+
+		bool TileMap::intersects(const AABB& aabb) const {
+			std::uint32_t x0, y0, x1, y1;
+			if (!tileRange(Bounds(aabb), x0, y0, x1, y1)) {
+				return false;
+			}
+			for (std::uint32_t y = y0; y <= y1; ++y) {
+				if (anySolid(y, x0, x1)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool TileMap::intersects(const Circle& circle) const {
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return false;
+			}
+			bool found = false;
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				found = found || collision::aabb_intersects(tileBounds(x, y), circle);
+			});
+			return found;
+		}
+
+		void TileMap::query(const AABB& aabb, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			std::uint32_t x0, y0, x1, y1;
+			if (!tileRange(Bounds(aabb), x0, y0, x1, y1)) {
+				return;
+			}
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				results.push_back(x + y * width_);
+			});
+		}
+
+		void TileMap::query(const Circle& circle, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return;
+			}
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				if (collision::aabb_intersects(tileBounds(x, y), circle)) {
+					results.push_back(x + y * width_);
+				}
+			});
+		}
+
+		vec_t TileMap::resolve(const AABB& aabb, std::uint32_t maxIterations) const {
+			Bounds bounds(aabb);
+			vec_t translation = NULL_VEC;
+			for (std::uint32_t iteration = 0; iteration < maxIterations; ++iteration) {
+				vec_t normal;
+				const float depth = deepestPenetration(bounds, normal);
+				if (depth <= 0.f) {
+					break;
+				}
+				translation += normal * depth;
+				bounds.move(normal * depth);
+			}
+			return translation;
+		}
+
+		vec_t TileMap::resolve(const Circle& circle, std::uint32_t maxIterations) const {
+			Circle moved = circle;
+			vec_t translation = NULL_VEC;
+			vec_t previousNormal = NULL_VEC;
+			for (std::uint32_t iteration = 0; iteration < maxIterations; ++iteration) {
+				vec_t normal;
+				float depth = deepestPenetration(moved, normal);
+				if (depth <= 0.f) {
+					break;
+				}
+
+				// Pushed back where the previous push came from (concave corner) : the circle keeps the previous push and leaves the tile along the other axis
+				if (vec_dot_product(normal, previousNormal) < 0.f && (previousNormal.x == 0.f || previousNormal.y == 0.f)) {
+					const float along = previousNormal.x == 0.f ? normal.x : normal.y;
+					if (along == 0.f) {
+						break;
+					}
+					normal = previousNormal.x == 0.f ? (along < 0.f ? LEFT_VEC : RIGHT_VEC) : (along < 0.f ? UP_VEC : DOWN_VEC);
+					depth = penetrationAlong(moved, normal);
+					if (depth <= 0.f) {
+						break;
+					}
+				}
+				previousNormal = normal;
+
+				translation += normal * depth;
+				moved.pos += normal * depth;
+			}
+			return translation;
+		}
+
+		bool TileMap::raycast(const LineSegment& ray, RaycastHit& hit) const {
+			const SegmentAABBClip clip = collision::line_segment_aabb_clip(ray, bounds());
+			if (!clip.intersects) {
+				return false;
+			}
+
+			// Tile where the ray enters the grid
+			const vec_t direction = ray.end - ray.start;
+			float t = clip.entry;
+			const vec_t entry = ray.start + direction * t;
+			std::int64_t x = std::min<std::int64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(std::floor((entry.x - origin_.x) / tileSize_.x)), 0), width_ - 1);
+			std::int64_t y = std::min<std::int64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(std::floor((entry.y - origin_.y) / tileSize_.y)), 0), height_ - 1);
+
+			// Position along the ray of the next vertical and horizontal tile sides, and distance between two of them
+			const float infinity = std::numeric_limits<float>::infinity();
+			const int stepX = direction.x > 0.f ? 1 : (direction.x < 0.f ? -1 : 0);
+			const int stepY = direction.y > 0.f ? 1 : (direction.y < 0.f ? -1 : 0);
+			const float deltaX = stepX != 0 ? tileSize_.x / std::abs(direction.x) : infinity;
+			const float deltaY = stepY != 0 ? tileSize_.y / std::abs(direction.y) : infinity;
+			float nextX = stepX != 0 ? (origin_.x + (x + (stepX > 0 ? 1 : 0)) * tileSize_.x - ray.start.x) / direction.x : infinity;
+			float nextY = stepY != 0 ? (origin_.y + (y + (stepY > 0 ? 1 : 0)) * tileSize_.y - ray.start.y) / direction.y : infinity;
+
+			while (true) {
+				if (isSolid(x, y)) {
+					hit = RaycastHit{ static_cast<std::uint32_t>(x + y * width_), t, ray.start + direction * t };
+					return true;
+				}
+
+				if (nextX < nextY) {
+					t = nextX;
+					x += stepX;
+					nextX += deltaX;
+				}
+				else {
+					t = nextY;
+					y += stepY;
+					nextY += deltaY;
+				}
+				if (t > clip.exit || x < 0 || y < 0 || x >= width_ || y >= height_) {
+					return false;
+				}
+			}
+		}
+
+		std::uint32_t TileMap::width() const {
+			return width_;
+		}
+
+		std::uint32_t TileMap::height() const {
+			return height_;
+		}
+
+		vec_t TileMap::tileSize() const {
+			return tileSize_;
+		}
+
+		Bounds TileMap::bounds() const {
+			return Bounds(origin_, origin_ + vec_t(width_ * tileSize_.x, height_ * tileSize_.y));
+		}
+
+		bool TileMap::tileRange(const Bounds& bounds, std::uint32_t& x0, std::uint32_t& y0, std::uint32_t& x1, std::uint32_t& y1) const {
+			// Tiles only touched by the bounds are excluded : the last tile is the one before the ceiling of the max side
+			const float minX = (bounds.min.x - origin_.x) / tileSize_.x;
+			const float minY = (bounds.min.y - origin_.y) / tileSize_.y;
+			const float maxX = (bounds.max.x - origin_.x) / tileSize_.x;
+			const float maxY = (bounds.max.y - origin_.y) / tileSize_.y;
+			if (maxX <= 0.f || maxY <= 0.f || minX >= width_ || minY >= height_ || maxX <= minX || maxY <= minY) {
+				return false;
+			}
+
+			x0 = static_cast<std::uint32_t>(std::max(std::floor(minX), 0.f));
+			y0 = static_cast<std::uint32_t>(std::max(std::floor(minY), 0.f));
+			x1 = static_cast<std::uint32_t>(std::min(std::ceil(maxX), static_cast<float>(width_))) - 1;
+			y1 = static_cast<std::uint32_t>(std::min(std::ceil(maxY), static_cast<float>(height_))) - 1;
+			return true;
+		}
+
+		bool TileMap::anySolid(std::uint32_t y, std::uint32_t x0, std::uint32_t x1) const {
+			const std::uint64_t* row = &solid_[y * wordsPerRow_];
+			for (std::uint32_t word = x0 / 64; word <= x1 / 64; ++word) {
+				if (row[word] & tile_map_word_mask(word, x0, x1)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		float TileMap::deepestPenetration(const Bounds& bounds, vec_t& normal) const {
+			std::uint32_t x0, y0, x1, y1;
+			if (!tileRange(bounds, x0, y0, x1, y1)) {
+				return 0.f;
+			}
+
+			float largestArea = 0.f;
+			float deepest = 0.f;
+			const vec_t center = bounds.center();
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				const Bounds tile = tileBounds(x, y);
+				const float area = (std::min(bounds.max.x, tile.max.x) - std::max(bounds.min.x, tile.min.x)) * (std::min(bounds.max.y, tile.max.y) - std::max(bounds.min.y, tile.min.y));
+				if (area <= largestArea) {
+					return;
+				}
+
+				// Push out along each axis, towards the side of the tile closest to the center of the AABB
+				const vec_t tileCenter = tile.center();
+				const bool left = center.x < tileCenter.x;
+				const bool up = center.y < tileCenter.y;
+				const float depthX = left ? bounds.max.x - tile.min.x : tile.max.x - bounds.min.x;
+				const float depthY = up ? bounds.max.y - tile.min.y : tile.max.y - bounds.min.y;
+
+				// The sides shared with a solid neighbour are inside the solid area : pushing through them only moves the AABB into the neighbour
+				const bool blockedX = isSolid(static_cast<std::int64_t>(x) + (left ? -1 : 1), y);
+				const bool blockedY = isSolid(x, static_cast<std::int64_t>(y) + (up ? -1 : 1));
+				const bool alongX = blockedX == blockedY ? depthX < depthY : blockedY;
+
+				largestArea = area;
+				deepest = alongX ? depthX : depthY;
+				normal = alongX ? (left ? LEFT_VEC : RIGHT_VEC) : (up ? UP_VEC : DOWN_VEC);
+			});
+			return deepest;
+		}
+
+		float TileMap::deepestPenetration(const Circle& circle, vec_t& normal) const {
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return 0.f;
+			}
+
+			float deepest = 0.f;
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				const Bounds tile = tileBounds(x, y);
+				CircleAABBCollision collision = collision::circle_aabb_collision_info(tile, circle);
+				if (collision.absoluteDepth <= deepest) {
+					return;
+				}
+
+				// Center outside of the tile, closest to a corner shared with a solid neighbour : the corner is inside the solid area, the circle is pushed out through the side instead
+				const vec_t closest(std::max(tile.min.x, std::min(circle.pos.x, tile.max.x)), std::max(tile.min.y, std::min(circle.pos.y, tile.max.y)));
+				const bool cornerX = closest.x == tile.min.x || closest.x == tile.max.x;
+				const bool cornerY = closest.y == tile.min.y || closest.y == tile.max.y;
+				if (cornerX && cornerY && collision.normal.x != 0.f && collision.normal.y != 0.f) {
+					const std::int64_t sideX = static_cast<std::int64_t>(x) + (collision.normal.x < 0.f ? -1 : 1);
+					const std::int64_t sideY = static_cast<std::int64_t>(y) + (collision.normal.y < 0.f ? -1 : 1);
+					if (isSolid(sideX, y)) {
+						collision = CircleAABBCollision{ collision.normal.y < 0.f ? UP_VEC : DOWN_VEC, circle.radius - std::abs(circle.pos.y - closest.y) };
+					}
+					else if (isSolid(x, sideY)) {
+						collision = CircleAABBCollision{ collision.normal.x < 0.f ? LEFT_VEC : RIGHT_VEC, circle.radius - std::abs(circle.pos.x - closest.x) };
+					}
+				}
+
+				if (collision.absoluteDepth > deepest) {
+					deepest = collision.absoluteDepth;
+					normal = collision.normal;
+				}
+			});
+			return deepest;
+		}
+
+		float TileMap::penetrationAlong(const Circle& circle, const vec_t& direction) const {
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return 0.f;
+			}
+
+			float deepest = 0.f;
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				const Bounds tile = tileBounds(x, y);
+				if (vec_dot_product(circle.pos - tile.center(), direction) < 0.f) {
+					return;
+				}
+
+				// Distance from the center to the tile across the axis, then half the width of the circle at that distance
+				const bool alongX = direction.x != 0.f;
+				const float across = alongX ? std::max({ tile.min.y - circle.pos.y, circle.pos.y - tile.max.y, 0.f }) : std::max({ tile.min.x - circle.pos.x, circle.pos.x - tile.max.x, 0.f });
+				if (across >= circle.radius) {
+					return;
+				}
+				const float reach = std::sqrt(circle.radius * circle.radius - across * across);
+				const float depth = alongX
+					? (direction.x > 0.f ? tile.max.x + reach - circle.pos.x : circle.pos.x + reach - tile.min.x)
+					: (direction.y > 0.f ? tile.max.y + reach - circle.pos.y : circle.pos.y + reach - tile.min.y);
+				deepest = std::max(deepest, depth);
+			});
+			return deepest;
+		}
+	}
+}
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ch {
+
+	CollisionMask::CollisionMask(std::uint32_t width, std::uint32_t height, const std::vector<std::uint8_t>& alpha, std::uint8_t threshold) :
+		width_(width),
+		height_(height),
+		wordsPerRow_((width + 63) / 64 + 1),
+		shiftedRows_()
+	{
+		if (width == 0 || height == 0) {
+			throw std::invalid_argument("Invalid argument : the collision mask must contain at least one pixel.");
+		}
+		if (alpha.size() != static_cast<size_t>(width) * height) {
+			throw std::invalid_argument("Invalid argument : the alpha channel must contain width * height values.");
+		}
+
+		const size_t rowsPerShift = static_cast<size_t>(wordsPerRow_) * height;
+		shiftedRows_.assign(64 * rowsPerShift, 0);
+
+		// Shift 0 : the pixels, the last word of each row stays empty
+		for (std::uint32_t y = 0; y < height; ++y) {
+			for (std::uint32_t x = 0; x < width; ++x) {
+				if (alpha[x + static_cast<size_t>(y) * width] > threshold) {
+					shiftedRows_[y * wordsPerRow_ + x / 64] |= std::uint64_t(1) << (x % 64);
+				}
+			}
+		}
+
+		// Shift s : pixel x of a row moves to bit x + s, the high bits of a word carry over to the next one
+		for (std::uint32_t shift = 1; shift < 64; ++shift) {
+			for (std::uint32_t y = 0; y < height; ++y) {
+				const std::uint64_t* source = shiftedRow(0, y);
+				std::uint64_t* destination = &shiftedRows_[shift * rowsPerShift + y * wordsPerRow_];
+				destination[0] = source[0] << shift;
+				for (std::uint32_t word = 1; word < wordsPerRow_; ++word) {
+					destination[word] = (source[word] << shift) | (source[word - 1] >> (64 - shift));
+				}
+			}
+		}
+	}
+
+	bool CollisionMask::isSolid(std::int64_t x, std::int64_t y) const {
+		if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+			return false;
+		}
+		return (shiftedRow(0, static_cast<std::uint32_t>(y))[x / 64] >> (x % 64)) & 1;
+	}
+
+	AABB CollisionMask::aabb(const vec_t& position) const {
+		return AABB(vec_t(std::floor(position.x), std::floor(position.y)), vec_t(static_cast<float>(width_), static_cast<float>(height_)));
+	}
+
+	bool CollisionMask::intersects(const vec_t& position, const CollisionMask& other, const vec_t& otherPosition) const {
+		if (!collision::aabb_intersects(aabb(position), other.aabb(otherPosition))) {
+			return false;
+		}
+
+		// The mask on the left is read as is, the one on the right is read shifted by the distance between them
+		const bool otherOnTheRight = std::floor(otherPosition.x) >= std::floor(position.x);
+		const CollisionMask& left = otherOnTheRight ? *this : other;
+		const CollisionMask& right = otherOnTheRight ? other : *this;
+		const std::int64_t leftX = static_cast<std::int64_t>(std::floor(otherOnTheRight ? position.x : otherPosition.x));
+		const std::int64_t leftY = static_cast<std::int64_t>(std::floor(otherOnTheRight ? position.y : otherPosition.y));
+		const std::int64_t dx = static_cast<std::int64_t>(std::floor(otherOnTheRight ? otherPosition.x : position.x)) - leftX;
+		const std::int64_t dy = static_cast<std::int64_t>(std::floor(otherOnTheRight ? otherPosition.y : position.y)) - leftY;
+
+		// Overlap of the masks, in the pixels of the left one. Only touching : no pixel in common.
+		const std::int64_t x0 = dx;
+		const std::int64_t x1 = std::min<std::int64_t>(left.width_, dx + right.width_);
+		const std::int64_t y0 = std::max<std::int64_t>(0, dy);
+		const std::int64_t y1 = std::min<std::int64_t>(left.height_, dy + right.height_);
+		if (x0 >= x1 || y0 >= y1) {
+			return false;
+		}
+
+		// Word w of the left row lines up with word w - dx / 64 of the right row shifted by dx % 64
+		const std::uint32_t shift = static_cast<std::uint32_t>(dx % 64);
+		const std::uint32_t wordOffset = static_cast<std::uint32_t>(dx / 64);
+		const std::uint32_t firstWord = static_cast<std::uint32_t>(x0 / 64);
+		const std::uint32_t lastWord = static_cast<std::uint32_t>((x1 - 1) / 64);
+		for (std::int64_t y = y0; y < y1; ++y) {
+			const std::uint64_t* leftRow = left.shiftedRow(0, static_cast<std::uint32_t>(y));
+			const std::uint64_t* rightRow = right.shiftedRow(shift, static_cast<std::uint32_t>(y - dy));
+			for (std::uint32_t word = firstWord; word <= lastWord; ++word) {
+				if ((leftRow[word] & rightRow[word - wordOffset]) != 0) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	std::uint32_t CollisionMask::width() const {
+		return width_;
+	}
+
+	std::uint32_t CollisionMask::height() const {
+		return height_;
+	}
+
+	const std::uint64_t* CollisionMask::shiftedRow(std::uint32_t shift, std::uint32_t y) const {
+		return &shiftedRows_[(static_cast<size_t>(shift) * height_ + y) * wordsPerRow_];
+	}
+}
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr size_t DISTANCE_FIELD_MIN_ROWS_PER_TASK = 16;
+		constexpr std::uint32_t DISTANCE_FIELD_NO_SHAPE = 0xFFFFFFFF;
+
+		/**
+		 * \brief Computes the signed distance from a point to a shape of the geometry.
+		 * \param shape Index of the shape : the AABBs come first, then the circles, then the segments.
+		 */
+		static float distance_field_shape_distance(const std::vector<AABB>& aabbs, const std::vector<Circle>& circles, const std::vector<LineSegment>& segments, std::uint32_t shape, const vec_t& point) {
+			if (shape < aabbs.size()) {
+				const vec_t halfSize = aabbs[shape].size / 2.f;
+				const vec_t center = aabbs[shape].pos + halfSize;
+				const vec_t q(std::abs(point.x - center.x) - halfSize.x, std::abs(point.y - center.y) - halfSize.y);
+				return vec_magnitude(vec_t(std::max(q.x, 0.f), std::max(q.y, 0.f))) + std::min(std::max(q.x, q.y), 0.f);
+			}
+			shape -= static_cast<std::uint32_t>(aabbs.size());
+			if (shape < circles.size()) {
+				return vec_magnitude(point - circles[shape].pos) - circles[shape].radius;
+			}
+			shape -= static_cast<std::uint32_t>(circles.size());
+			return vec_magnitude(point - collision::closest_point_on_segment(segments[shape], point));
+		}
 
-			auto otherCenter = other.center();
+		DistanceField::DistanceField(const Bounds& area, float cellSize) :
+			origin_(area.min),
+			cellSize_(cellSize),
+			columns_(0),
+			rows_(0),
+			distances_()
+		{
+			if (!(cellSize > 0.f)) {
+				throw std::invalid_argument("Invalid argument : the size of the cells must be positive.");
+			}
+			if (!(area.max.x > area.min.x) || !(area.max.y > area.min.y)) {
+				throw std::invalid_argument("Invalid argument : the area of the distance field must not be empty.");
+			}
+			columns_ = static_cast<std::uint32_t>(std::ceil((area.max.x - area.min.x) / cellSize)) + 1;
+			rows_ = static_cast<std::uint32_t>(std::ceil((area.max.y - area.min.y) / cellSize)) + 1;
+			distances_.assign(static_cast<size_t>(columns_) * rows_, std::numeric_limits<float>::max());
+		}
 
-			float closestCornerDistanceSquared = std::numeric_limits<float>::infinity();
+		void DistanceField::bake(const std::vector<AABB>& aabbs, const std::vector<Circle>& circles, const std::vector<LineSegment>& segments, unsigned int threadCount) {
+			const size_t nodeCount = static_cast<size_t>(columns_) * rows_;
+			const size_t shapeCount = aabbs.size() + circles.size() + segments.size();
+			std::vector<std::uint32_t> nearest(nodeCount, DISTANCE_FIELD_NO_SHAPE);
+			std::fill(distances_.begin(), distances_.end(), std::numeric_limits<float>::max());
+
+			// 1. Seeds : exact distance from the nodes around each shape (at least the closest nodes of the grid)
+			for (std::uint32_t shape = 0; shape < shapeCount; ++shape) {
+				Bounds bounds;
+				if (shape < aabbs.size()) {
+					bounds = Bounds(aabbs[shape]);
+				}
+				else if (shape < aabbs.size() + circles.size()) {
+					const Circle& circle = circles[shape - aabbs.size()];
+					bounds = Bounds(circle.pos - vec_t(circle.radius, circle.radius), circle.pos + vec_t(circle.radius, circle.radius));
+				}
+				else {
+					bounds = collision::enclosingBounds(segments[shape - aabbs.size() - circles.size()]);
+				}
 
-			Corner closestCorner = Corner::MAX_VALUE;
+				const vec_t min = (bounds.min - origin_) / cellSize_ - vec_t(1.f, 1.f);
+				const vec_t max = (bounds.max - origin_) / cellSize_ + vec_t(1.f, 1.f);
+				const std::uint32_t x0 = static_cast<std::uint32_t>(std::clamp(std::ceil(min.x), 0.f, static_cast<float>(columns_ - 1)));
+				const std::uint32_t y0 = static_cast<std::uint32_t>(std::clamp(std::ceil(min.y), 0.f, static_cast<float>(rows_ - 1)));
+				const std::uint32_t x1 = static_cast<std::uint32_t>(std::clamp(std::floor(max.x), 0.f, static_cast<float>(columns_ - 1)));
+				const std::uint32_t y1 = static_cast<std::uint32_t>(std::clamp(std::floor(max.y), 0.f, static_cast<float>(rows_ - 1)));
+				for (std::uint32_t y = y0; y <= y1; ++y) {
+					for (std::uint32_t x = x0; x <= x1; ++x) {
+						const size_t node = x + static_cast<size_t>(y) * columns_;
+						const float distance = distance_field_shape_distance(aabbs, circles, segments, shape, nodePosition(x, y));
+						if (distance < distances_[node]) {
+							distances_[node] = distance;
+							nearest[node] = shape;
+						}
+					}
+				}
+			}
 
-			for (size_t i = 0; i < static_cast<size_t>(Corner::MAX_VALUE); ++i) {
-				float distanceToOtherCenterSquared = vec_magnitude(currentCorners[i] - otherCenter);
+			if (shapeCount == 0) {
+				return;
+			}
 
-				if (distanceToOtherCenterSquared < closestCornerDistanceSquared) {
-					closestCornerDistanceSquared = distanceToOtherCenterSquared;
-					closestCorner = static_cast<Corner>(i);
-				}
+			// 2. Jump flooding : each node tries the shapes of the nodes at decreasing powers of two
+			std::vector<std::uint32_t> nextNearest(nodeCount);
+			std::vector<float> nextDistances(nodeCount);
+			const auto pass = [&](std::int64_t step) {
+				std::atomic<bool> changed(false);
+				parallel_for(rows_, [&](size_t begin, size_t end, size_t) {
+					bool rowsChanged = false;
+					for (size_t y = begin; y < end; ++y) {
+						for (std::uint32_t x = 0; x < columns_; ++x) {
+							const size_t node = x + y * columns_;
+							const vec_t position = nodePosition(x, static_cast<std::uint32_t>(y));
+							std::uint32_t bestShape = nearest[node];
+							float bestDistance = distances_[node];
+							for (std::int64_t ny = static_cast<std::int64_t>(y) - step; ny <= static_cast<std::int64_t>(y) + step; ny += step) {
+								for (std::int64_t nx = static_cast<std::int64_t>(x) - step; nx <= static_cast<std::int64_t>(x) + step; nx += step) {
+									if (nx < 0 || ny < 0 || nx >= columns_ || ny >= rows_) {
+										continue;
+									}
+									const std::uint32_t shape = nearest[nx + ny * columns_];
+									if (shape == DISTANCE_FIELD_NO_SHAPE || shape == bestShape) {
+										continue;
+									}
+									const float distance = distance_field_shape_distance(aabbs, circles, segments, shape, position);
+									if (distance < bestDistance) {
+										bestDistance = distance;
+										bestShape = shape;
+										rowsChanged = true;
+									}
+								}
+							}
+							nextNearest[node] = bestShape;
+							nextDistances[node] = bestDistance;
+						}
+					}
+					if (rowsChanged) {
+						changed = true;
+					}
+				}, threadCount, DISTANCE_FIELD_MIN_ROWS_PER_TASK);
+
+				nearest.swap(nextNearest);
+				distances_.swap(nextDistances);
+				return changed.load();
+			};
+
+			std::int64_t step = 1;
+			while (step * 2 < std::max(columns_, rows_)) {
+				step *= 2;
+			}
+			for (; step > 1; step /= 2) {
+				pass(step);
+			}
+
+			// 3. Jump flooding misses the closest shape of a few nodes : the shapes are spread to the neighbours until nothing changes
+			while (pass(1)) {
 			}
+		}
 
-			Corner oppositeCorner = diagonally_opposed_corner(closestCorner);
+		float DistanceField::distance(const vec_t& point) const {
+			std::uint32_t x, y;
+			vec_t fraction;
+			const float outside = locate(point, x, y, fraction);
+			const size_t node = x + static_cast<size_t>(y) * columns_;
+			const float top = distances_[node] + (distances_[node + 1] - distances_[node]) * fraction.x;
+			const float bottom = distances_[node + columns_] + (distances_[node + columns_ + 1] - distances_[node + columns_]) * fraction.x;
+			return top + (bottom - top) * fraction.y + outside;
+		}
 
-			auto c1 = currentCorners[static_cast<size_t>(closestCorner)];
-			auto c2 = otherCorners[static_cast<size_t>(oppositeCorner)];
-			vec_t delta = c1 - c2;
-			delta = vec_abs(delta);
+		vec_t DistanceField::normal(const vec_t& point) const {
+			std::uint32_t x, y;
+			vec_t fraction;
+			locate(point, x, y, fraction);
+			const size_t node = x + static_cast<size_t>(y) * columns_;
+			const float d00 = distances_[node];
+			const float d10 = distances_[node + 1];
+			const float d01 = distances_[node + columns_];
+			const float d11 = distances_[node + columns_ + 1];
+
+			// Derivatives of the bilinear interpolation
+			const vec_t gradient((d10 - d00) * (1.f - fraction.y) + (d11 - d01) * fraction.y, (d01 - d00) * (1.f - fraction.x) + (d11 - d10) * fraction.x);
+			if (!(vec_magnitude_squared(gradient) > 0.f)) {
+				return NULL_VEC;
+			}
+			return vec_normalize(gradient);
+		}
 
-			AABBCollision collision;
-			collision.delta = delta;
+		bool DistanceField::intersects(const Circle& circle) const {
+			return distance(circle.pos) < circle.radius;
+		}
 
-			if (delta.x > delta.y) {
-				if (closestCorner == Corner::TopLeft || closestCorner == Corner::TopRight)
-					collision.normal = UP_VEC;
-				else
-					collision.normal = DOWN_VEC;
+		float DistanceField::penetration(const Circle& circle, vec_t& normal) const {
+			const float depth = circle.radius - distance(circle.pos);
+			if (!(depth > 0.f)) {
+				return 0.f;
 			}
-			else {
-				if (closestCorner == Corner::TopLeft || closestCorner == Corner::BottomLeft)
-					collision.normal = LEFT_VEC;
-				else
-					collision.normal = RIGHT_VEC;
+			normal = this->normal(circle.pos);
+			return depth;
+		}
+
+		vec_t DistanceField::resolve(const Circle& circle) const {
+			vec_t normal;
+			const float depth = penetration(circle, normal);
+			return depth > 0.f ? normal * depth : NULL_VEC;
+		}
+
+		float DistanceField::nodeDistance(std::uint32_t x, std::uint32_t y) const {
+			if (x >= columns_ || y >= rows_) {
+				throw std::out_of_range("The node is outside of the distance field.");
 			}
+			return distances_[x + static_cast<size_t>(y) * columns_];
+		}
 
-			return collision;
+		vec_t DistanceField::nodePosition(std::uint32_t x, std::uint32_t y) const {
+			return vec_t(origin_.x + x * cellSize_, origin_.y + y * cellSize_);
 		}
 
-		CirclesCollision circles_collision_info(const Circle& first, const Circle& other) {
-			if (!circle_intersects(first, other))
-				return CirclesCollision{ NULL_VEC, 0.f };
+		std::uint32_t DistanceField::columns() const {
+			return columns_;
+		}
 
-			return CirclesCollision{ vec_normalize(other.pos - first.pos), std::abs(circles_distance(first, other)) };
+		std::uint32_t DistanceField::rows() const {
+			return rows_;
 		}
 
-		CircleAABBCollision circle_aabb_collision_info(const AABB& aabb, const Circle& circle) {
-			static const CircleAABBCollision NO_COLLISION = CircleAABBCollision{ NULL_VEC, 0.f };
+		float DistanceField::cellSize() const {
+			return cellSize_;
+		}
 
-			if (!aabb_intersects(aabb, enclosingAABB(circle))) {
-				return NO_COLLISION;
+		float DistanceField::locate(const vec_t& point, std::uint32_t& x, std::uint32_t& y, vec_t& fraction) const {
+			const vec_t local = (point - origin_) / cellSize_;
+			const vec_t clamped(std::clamp(local.x, 0.f, static_cast<float>(columns_ - 1)), std::clamp(local.y, 0.f, static_cast<float>(rows_ - 1)));
+			x = std::min(static_cast<std::uint32_t>(clamped.x), columns_ - 2);
+			y = std::min(static_cast<std::uint32_t>(clamped.y), rows_ - 2);
+			fraction = vec_t(clamped.x - x, clamped.y - y);
+			return vec_magnitude(local - clamped) * cellSize_;
+		}
+	}
+}
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_set>
+
+namespace ch {
+	namespace collision {
+
+		constexpr size_t SEGMENTS_INTERSECTION_MIN_CHUNK_SIZE = 1024;
+		constexpr std::uint32_t SEGMENTS_SWEEP_NONE = 0xFFFFFFFF;
+
+		/**
+		 * \brief A point of the sweep, in double precision so that the float coordinates of the segments are exact.
+		 */
+		struct SegmentsSweepPoint {
+			double x, y;
+		};
+
+		/**
+		 * \brief A segment with its extremities ordered along the sweep (smallest x first, then smallest y).
+		 */
+		struct SegmentsSweepSegment {
+			SegmentsSweepPoint start, end;
+		};
+
+		/**
+		 * \brief Node of the sweep line : a treap of the segments crossing the sweep line, from the lowest to the highest.
+		 *
+		 * Node i holds segment i, the order of the nodes is only given by the links.
+		 */
+		struct SegmentsSweepNode {
+			std::uint32_t left, right, parent;
+			std::uint32_t priority;
+		};
+
+		/**
+		 * \brief The segments crossing the sweep line.
+		 */
+		struct SegmentsSweepStatus {
+			std::vector<SegmentsSweepNode> nodes;
+			std::uint32_t root;
+		};
+
+		/**
+		 * \brief Extremity of a segment, or crossing of two neighbouring segments, still to be swept.
+		 */
+		struct SegmentsSweepEvent {
+			SegmentsSweepPoint point;
+			std::uint32_t below; /**< Segment of the extremity, or lower segment of the crossing. */
+			std::uint32_t above; /**< SEGMENTS_SWEEP_NONE for an extremity, upper segment of the crossing otherwise. */
+			bool start; /**< For an extremity, true if it's the start of the segment. */
+		};
+
+		/**
+		 * \return true if the point a is swept before the point b.
+		 */
+		static bool segments_sweep_before(const SegmentsSweepPoint& a, const SegmentsSweepPoint& b) {
+			return a.x < b.x || (a.x == b.x && a.y < b.y);
+		}
+
+		/**
+		 * \brief Computes the exact sign of a sum of doubles.
+		 *
+		 * The sum is first computed naively, and only summed again without rounding errors (as an
+		 * expansion of non-overlapping components) when it's too close to 0 to trust its sign.
+		 */
+		static int segments_sweep_sign(const double* terms, size_t count) {
+			double sum = 0.0;
+			double magnitude = 0.0;
+			for (size_t i = 0; i < count; ++i) {
+				sum += terms[i];
+				magnitude += std::abs(terms[i]);
+			}
+			if (std::abs(sum) > magnitude * 1e-14) {
+				return sum > 0.0 ? 1 : -1;
+			}
+
+			double expansion[8];
+			size_t length = 0;
+			for (size_t i = 0; i < count; ++i) {
+				double carry = terms[i];
+				for (size_t j = 0; j < length; ++j) {
+					const double total = carry + expansion[j];
+					const double bigger = total - carry;
+					const double error = (carry - (total - bigger)) + (expansion[j] - bigger);
+					expansion[j] = error;
+					carry = total;
+				}
+				expansion[length++] = carry;
+			}
+			for (size_t i = length; i > 0; --i) {
+				if (expansion[i - 1] != 0.0) {
+					return expansion[i - 1] > 0.0 ? 1 : -1;
+				}
+			}
+			return 0;
+		}
+
+		/**
+		 * \brief Exact orientation of the point c relative to the line going from a to b.
+		 *
+		 * The products of two float coordinates are exact in double precision, so the cross product
+		 * is expanded into such products before being summed.
+		 *
+		 * \return 1 if c is above the line (to its left), -1 if it's below, 0 if it's on the line.
+		 */
+		static int segments_sweep_orientation(const SegmentsSweepPoint& a, const SegmentsSweepPoint& b, const SegmentsSweepPoint& c) {
+			const double terms[6] = { b.x * c.y, -b.x * a.y, -a.x * c.y, -b.y * c.x, b.y * a.x, a.y * c.x };
+			return segments_sweep_sign(terms, 6);
+		}
+
+		/**
+		 * \return 1 if the segment a is steeper than the segment b after the point where they meet, -1 if it's less steep, 0 if they're parallel.
+		 */
+		static int segments_sweep_compare_slopes(const SegmentsSweepSegment& a, const SegmentsSweepSegment& b) {
+			// Sign of cross(b.end - b.start, a.end - a.start)
+			const double terms[8] = {
+				b.end.x * a.end.y, -b.end.x * a.start.y, -b.start.x * a.end.y, b.start.x * a.start.y,
+				-b.end.y * a.end.x, b.end.y * a.start.x, b.start.y * a.end.x, -b.start.y * a.start.x
+			};
+			return segments_sweep_sign(terms, 8);
+		}
+
+		static std::uint32_t segments_sweep_first(const SegmentsSweepStatus& status, std::uint32_t node) {
+			while (status.nodes[node].left != SEGMENTS_SWEEP_NONE) {
+				node = status.nodes[node].left;
+			}
+			return node;
+		}
+
+		static std::uint32_t segments_sweep_last(const SegmentsSweepStatus& status, std::uint32_t node) {
+			while (status.nodes[node].right != SEGMENTS_SWEEP_NONE) {
+				node = status.nodes[node].right;
+			}
+			return node;
+		}
+
+		/**
+		 * \return The segment just above the given one on the sweep line, SEGMENTS_SWEEP_NONE if it's the highest.
+		 */
+		static std::uint32_t segments_sweep_next(const SegmentsSweepStatus& status, std::uint32_t node) {
+			if (status.nodes[node].right != SEGMENTS_SWEEP_NONE) {
+				return segments_sweep_first(status, status.nodes[node].right);
+			}
+			std::uint32_t parent = status.nodes[node].parent;
+			while (parent != SEGMENTS_SWEEP_NONE && status.nodes[parent].right == node) {
+				node = parent;
+				parent = status.nodes[node].parent;
+			}
+			return parent;
+		}
+
+		/**
+		 * \return The segment just below the given one on the sweep line, SEGMENTS_SWEEP_NONE if it's the lowest.
+		 */
+		static std::uint32_t segments_sweep_previous(const SegmentsSweepStatus& status, std::uint32_t node) {
+			if (status.nodes[node].left != SEGMENTS_SWEEP_NONE) {
+				return segments_sweep_last(status, status.nodes[node].left);
+			}
+			std::uint32_t parent = status.nodes[node].parent;
+			while (parent != SEGMENTS_SWEEP_NONE && status.nodes[parent].left == node) {
+				node = parent;
+				parent = status.nodes[node].parent;
 			}
+			return parent;
+		}
 
-			if ((circle.pos.x > aabb.pos.x && circle.pos.x < aabb.pos.x + aabb.size.x) ||
-				(circle.pos.y > aabb.pos.y && circle.pos.y < aabb.pos.y + aabb.size.y)) {
-				auto aabbColl = aabb_collision_info(aabb, enclosingAABB(circle));
-				return CircleAABBCollision{ aabbColl.normal, aabbColl.absolutePenetrationDepthAlongNormal() };
+		/**
+		 * \brief Moves a node up, in place of its parent.
+		 */
+		static void segments_sweep_rotate_up(SegmentsSweepStatus& status, std::uint32_t node) {
+			SegmentsSweepNode& child = status.nodes[node];
+			const std::uint32_t parent = child.parent;
+			SegmentsSweepNode& top = status.nodes[parent];
+			const std::uint32_t grandParent = top.parent;
+
+			if (top.left == node) {
+				top.left = child.right;
+				if (child.right != SEGMENTS_SWEEP_NONE) {
+					status.nodes[child.right].parent = parent;
+				}
+				child.right = parent;
 			}
 			else {
-				auto corners = aabb.corners();
-				for (const auto& corner : corners) {
-					if (circle_contains(circle, corner)) {
-						auto dir = vec_normalize(circle.pos - corner);
-						float depth = circle.radius - vec_magnitude(circle.pos - corner);
-						return CircleAABBCollision{ dir, depth };
-					}
+				top.right = child.left;
+				if (child.left != SEGMENTS_SWEEP_NONE) {
+					status.nodes[child.left].parent = parent;
 				}
+				child.left = parent;
 			}
+			top.parent = node;
+			child.parent = grandParent;
 
-			return NO_COLLISION;
+			if (grandParent == SEGMENTS_SWEEP_NONE) {
+				status.root = node;
+			}
+			else if (status.nodes[grandParent].left == parent) {
+				status.nodes[grandParent].left = node;
+			}
+			else {
+				status.nodes[grandParent].right = node;
+			}
 		}
 
-		SegmentsIntersection line_segments_intersection_info(const LineSegment& first, const LineSegment& other) {
-			if (collision::aabb_intersects(enclosingAABB(first), enclosingAABB(other))) {
-				float slopeCurrent = first.slope();
-				float slopeOther = other.slope();
-				float YInterceptCurrent = LineSegment::YIntercept(first.start, slopeCurrent);
-				float YInterceptOther = LineSegment::YIntercept(other.start, slopeOther);
+		/**
+		 * \brief Inserts a segment just above another one on the sweep line.
+		 * \param after The segment below, SEGMENTS_SWEEP_NONE to insert the segment below all the others.
+		 */
+		static void segments_sweep_insert(SegmentsSweepStatus& status, std::uint32_t node, std::uint32_t after) {
+			SegmentsSweepNode& inserted = status.nodes[node];
+			inserted.left = SEGMENTS_SWEEP_NONE;
+			inserted.right = SEGMENTS_SWEEP_NONE;
+			inserted.parent = SEGMENTS_SWEEP_NONE;
+			if (status.root == SEGMENTS_SWEEP_NONE) {
+				status.root = node;
+				return;
+			}
 
-				if (slopeCurrent == slopeOther) {
-					if (YInterceptCurrent == YInterceptOther) {
+			if (after == SEGMENTS_SWEEP_NONE) {
+				inserted.parent = segments_sweep_first(status, status.root);
+				status.nodes[inserted.parent].left = node;
+			}
+			else if (status.nodes[after].right == SEGMENTS_SWEEP_NONE) {
+				inserted.parent = after;
+				status.nodes[after].right = node;
+			}
+			else {
+				inserted.parent = segments_sweep_first(status, status.nodes[after].right);
+				status.nodes[inserted.parent].left = node;
+			}
 
-						float minx = first.minX() < other.minX() ? first.minX() : other.minX();
-						float maxx = first.maxX() > other.maxX() ? first.maxX() : other.maxX();
-						float miny = first.minY() < other.minY() ? first.minY() : other.minY();
-						float maxy = first.maxY() > other.maxY() ? first.maxY() : other.maxY();
+			while (inserted.parent != SEGMENTS_SWEEP_NONE && status.nodes[inserted.parent].priority < inserted.priority) {
+				segments_sweep_rotate_up(status, node);
+			}
+		}
 
-						const vec_t* p1 = nullptr;
-						const vec_t* p2 = nullptr;
+		/**
+		 * \brief Removes a segment from the sweep line.
+		 */
+		static void segments_sweep_erase(SegmentsSweepStatus& status, std::uint32_t node) {
+			SegmentsSweepNode& erased = status.nodes[node];
+			while (erased.left != SEGMENTS_SWEEP_NONE && erased.right != SEGMENTS_SWEEP_NONE) {
+				const std::uint32_t left = erased.left;
+				const std::uint32_t right = erased.right;
+				segments_sweep_rotate_up(status, status.nodes[left].priority > status.nodes[right].priority ? left : right);
+			}
 
-						if (minx == maxx) {
-							if (first.start.y == miny || first.start.y == maxy) {
-								p1 = &first.end;
-							}
-							else {
-								p1 = &first.start;
-							}
+			const std::uint32_t child = erased.left != SEGMENTS_SWEEP_NONE ? erased.left : erased.right;
+			if (child != SEGMENTS_SWEEP_NONE) {
+				status.nodes[child].parent = erased.parent;
+			}
+			if (erased.parent == SEGMENTS_SWEEP_NONE) {
+				status.root = child;
+			}
+			else if (status.nodes[erased.parent].left == node) {
+				status.nodes[erased.parent].left = child;
+			}
+			else {
+				status.nodes[erased.parent].right = child;
+			}
+			erased.left = SEGMENTS_SWEEP_NONE;
+			erased.right = SEGMENTS_SWEEP_NONE;
+			erased.parent = SEGMENTS_SWEEP_NONE;
+		}
 
-							if (other.start.y == miny || other.start.y == maxy) {
-								p2 = &other.end;
-							}
-							else {
-								p2 = &other.start;
-							}
-						}
-						else if (miny == maxy) {
-							if (first.start.x == minx || first.start.x == maxx) {
-								p1 = &first.end;
-							}
-							else {
-								p1 = &first.start;
-							}
+		/**
+		 * \brief Finds the lowest segment of the sweep line that isn't below the point.
+		 * \return SEGMENTS_SWEEP_NONE if every segment is below the point.
+		 */
+		static std::uint32_t segments_sweep_locate(const SegmentsSweepStatus& status, const std::vector<SegmentsSweepSegment>& segments, const SegmentsSweepPoint& point) {
+			std::uint32_t found = SEGMENTS_SWEEP_NONE;
+			std::uint32_t node = status.root;
+			while (node != SEGMENTS_SWEEP_NONE) {
+				if (segments_sweep_orientation(segments[node].start, segments[node].end, point) > 0) {
+					node = status.nodes[node].right;
+				}
+				else {
+					found = node;
+					node = status.nodes[node].left;
+				}
+			}
+			return found;
+		}
 
-							if (other.start.x == minx || other.start.x == maxx) {
-								p2 = &other.end;
-							}
-							else {
-								p2 = &other.start;
-							}
-						}
-						else {
-							if (first.start.x == minx || first.start.x == maxx || first.start.y == miny || first.start.y == maxy) {
-								p1 = &first.end;
-							}
-							else {
-								p1 = &first.start;
-							}
+		static std::uint64_t segments_sweep_pair_key(std::uint32_t first, std::uint32_t other) {
+			return first < other ? (static_cast<std::uint64_t>(first) << 32) | other : (static_cast<std::uint64_t>(other) << 32) | first;
+		}
 
-							if (other.start.x == minx || other.start.x == maxx || other.start.y == miny || other.start.y == maxy) {
-								p2 = &other.end;
-							}
-							else {
-								p2 = &other.start;
-							}
-						}
+		/**
+		 * \brief Finds every pair of segments that meet, with a Bentley-Ottmann sweep.
+		 *
+		 * The sweep line goes through the extremities of the segments and the crossings of neighbouring
+		 * segments, from the smallest x to the largest (then from the smallest y, so vertical segments
+		 * are swept from bottom to top). The segments crossing the sweep line are kept from the lowest
+		 * to the highest in a treap, whose order is only ever changed by inserting a segment at a
+		 * position found with exact orientations, or by swapping two neighbours at their crossing.
+		 *
+		 * Segments that meet at an extremity (one ending or starting on the other, collinear overlaps)
+		 * are found exactly, when the sweep line reaches the extremity. Crossings inside both segments
+		 * are found when the segments become neighbours, which needs the crossing points : they are
+		 * only rounded to double precision, which can swap the order of two events within a rounding
+		 * error of each other.
+		 *
+		 * \return The pairs, first index in the high bits, in no particular order.
+		 */
+		static std::vector<std::uint64_t> segments_sweep_pairs(const std::vector<LineSegment>& input) {
+			const std::uint32_t count = static_cast<std::uint32_t>(input.size());
+			std::vector<SegmentsSweepSegment> segments(count);
+			std::vector<SegmentsSweepEvent> extremities;
+			extremities.reserve(2 * static_cast<size_t>(count));
+			for (std::uint32_t i = 0; i < count; ++i) {
+				SegmentsSweepPoint start{ input[i].start.x, input[i].start.y };
+				SegmentsSweepPoint end{ input[i].end.x, input[i].end.y };
+				if (segments_sweep_before(end, start)) {
+					std::swap(start, end);
+				}
+				segments[i] = SegmentsSweepSegment{ start, end };
+				extremities.push_back(SegmentsSweepEvent{ start, i, SEGMENTS_SWEEP_NONE, true });
+				extremities.push_back(SegmentsSweepEvent{ end, i, SEGMENTS_SWEEP_NONE, false });
+			}
+			std::sort(extremities.begin(), extremities.end(), [](const SegmentsSweepEvent& a, const SegmentsSweepEvent& b) {
+				return segments_sweep_before(a.point, b.point);
+			});
+
+			SegmentsSweepStatus status{ std::vector<SegmentsSweepNode>(count), SEGMENTS_SWEEP_NONE };
+			for (std::uint32_t i = 0; i < count; ++i) {
+				// Deterministic pseudo-random priorities (splitmix)
+				std::uint64_t hash = (i + 1) * 0x9E3779B97F4A7C15ull;
+				hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+				hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+				status.nodes[i] = SegmentsSweepNode{ SEGMENTS_SWEEP_NONE, SEGMENTS_SWEEP_NONE, SEGMENTS_SWEEP_NONE, static_cast<std::uint32_t>(hash >> 32) };
+			}
 
-						return SegmentsIntersection(IntersectionType::Overlapping, std::pair<vec_t, vec_t>{ *p1, *p2 });
-					}
-					else {
-						return SegmentsIntersection(IntersectionType::None);
+			std::vector<std::uint64_t> pairs;
+			std::unordered_set<std::uint64_t> found;
+			const auto report = [&](std::uint32_t first, std::uint32_t other) {
+				const std::uint64_t key = segments_sweep_pair_key(first, other);
+				if (found.insert(key).second) {
+					pairs.push_back(key);
+				}
+			};
+
+			// Crossings, the earliest first
+			const auto later = [](const SegmentsSweepEvent& a, const SegmentsSweepEvent& b) {
+				return segments_sweep_before(b.point, a.point);
+			};
+			std::priority_queue<SegmentsSweepEvent, std::vector<SegmentsSweepEvent>, decltype(later)> crossings(later);
+			SegmentsSweepPoint sweep{ -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+
+			// Schedules the crossing of two neighbours, if they cross inside both segments and haven't been swapped yet
+			const auto schedule = [&](std::uint32_t below, std::uint32_t above) {
+				if (below == SEGMENTS_SWEEP_NONE || above == SEGMENTS_SWEEP_NONE || found.count(segments_sweep_pair_key(below, above)) != 0) {
+					return;
+				}
+				const SegmentsSweepSegment& a = segments[below];
+				const SegmentsSweepSegment& b = segments[above];
+				if (segments_sweep_orientation(a.start, a.end, b.start) * segments_sweep_orientation(a.start, a.end, b.end) >= 0 ||
+					segments_sweep_orientation(b.start, b.end, a.start) * segments_sweep_orientation(b.start, b.end, a.end) >= 0) {
+					return;
+				}
+
+				const double dx = a.end.x - a.start.x, dy = a.end.y - a.start.y;
+				const double ex = b.end.x - b.start.x, ey = b.end.y - b.start.y;
+				const double t = ((b.start.x - a.start.x) * ey - (b.start.y - a.start.y) * ex) / (dx * ey - dy * ex);
+				SegmentsSweepPoint point{ a.start.x + dx * t, a.start.y + dy * t };
+				if (segments_sweep_before(point, sweep)) {
+					point = sweep;
+				}
+				crossings.push(SegmentsSweepEvent{ point, below, above, false });
+			};
+
+			std::vector<std::uint32_t> starting, through, ending, reordered;
+			size_t next = 0;
+			while (next < extremities.size() || !crossings.empty()) {
+				if (!crossings.empty() && (next == extremities.size() || !segments_sweep_before(extremities[next].point, crossings.top().point))) {
+					// Crossing of two neighbours : they swap places, if they're still neighbours
+					const SegmentsSweepEvent crossing = crossings.top();
+					crossings.pop();
+					sweep = crossing.point;
+					if (segments_sweep_next(status, crossing.below) != crossing.above || found.count(segments_sweep_pair_key(crossing.below, crossing.above)) != 0) {
+						continue;
 					}
+					report(crossing.below, crossing.above);
+					segments_sweep_erase(status, crossing.above);
+					segments_sweep_insert(status, crossing.above, segments_sweep_previous(status, crossing.below));
+					schedule(segments_sweep_previous(status, crossing.above), crossing.above);
+					schedule(crossing.below, segments_sweep_next(status, crossing.below));
+					continue;
 				}
-				else {
-					if (YInterceptCurrent == YInterceptOther) {
 
-						return SegmentsIntersection(IntersectionType::Crossing, vec_t(0, YInterceptCurrent));
+				// Every extremity at this point
+				const SegmentsSweepPoint point = extremities[next].point;
+				sweep = point;
+				starting.clear();
+				ending.clear();
+				for (; next < extremities.size() && extremities[next].point.x == point.x && extremities[next].point.y == point.y; ++next) {
+					(extremities[next].start ? starting : ending).push_back(extremities[next].below);
+				}
+
+				// Segments of the sweep line going through the point : they're neighbours, the segments ending here among them
+				through.clear();
+				const std::uint32_t located = segments_sweep_locate(status, segments, point);
+				std::uint32_t below = located == SEGMENTS_SWEEP_NONE ? (status.root == SEGMENTS_SWEEP_NONE ? SEGMENTS_SWEEP_NONE : segments_sweep_last(status, status.root)) : segments_sweep_previous(status, located);
+				std::uint32_t above = located;
+				while (above != SEGMENTS_SWEEP_NONE && segments_sweep_orientation(segments[above].start, segments[above].end, point) == 0) {
+					through.push_back(above);
+					above = segments_sweep_next(status, above);
+				}
+
+				// Every segment starting here meets every segment going through or starting here
+				for (size_t i = 0; i < starting.size(); ++i) {
+					for (std::uint32_t segment : through) {
+						report(starting[i], segment);
 					}
-					else {
-						float commonX = (YInterceptOther - YInterceptCurrent) / (slopeCurrent - slopeOther);
+					for (size_t j = i + 1; j < starting.size(); ++j) {
+						report(starting[i], starting[j]);
+					}
+				}
 
-						if (commonX > first.minX() && commonX < first.maxX() && commonX > other.minX() && commonX < other.maxX()) {
-							float commonY = slopeCurrent * commonX + YInterceptCurrent;
+				// Segments ending here meet every segment going through, the others cross here unless they're collinear (then they already met)
+				for (size_t i = 0; i < through.size(); ++i) {
+					const bool endsHere = segments[through[i]].end.x == point.x && segments[through[i]].end.y == point.y;
+					for (size_t j = i + 1; j < through.size(); ++j) {
+						const bool otherEndsHere = segments[through[j]].end.x == point.x && segments[through[j]].end.y == point.y;
+						if (endsHere || otherEndsHere || segments_sweep_compare_slopes(segments[through[i]], segments[through[j]]) != 0) {
+							report(through[i], through[j]);
+						}
+					}
+				}
 
-							return SegmentsIntersection(IntersectionType::Crossing, vec_t(commonX, commonY));
+				// The segments going on after the point are put back, from the least steep to the steepest
+				reordered.clear();
+				for (std::uint32_t segment : through) {
+					segments_sweep_erase(status, segment);
+					if (!(segments[segment].end.x == point.x && segments[segment].end.y == point.y)) {
+						reordered.push_back(segment);
+					}
+				}
+				for (std::uint32_t segment : starting) {
+					if (segments_sweep_before(point, segments[segment].end)) {
+						reordered.push_back(segment);
+					}
+				}
+				std::sort(reordered.begin(), reordered.end(), [&](std::uint32_t a, std::uint32_t b) {
+					const int steeper = segments_sweep_compare_slopes(segments[a], segments[b]);
+					return steeper != 0 ? steeper < 0 : a < b;
+				});
+
+				// Segments ending here that weren't found next to the point (rounding of the crossings) still leave the sweep line
+				for (std::uint32_t segment : ending) {
+					if (status.nodes[segment].parent != SEGMENTS_SWEEP_NONE || status.root == segment) {
+						if (below == segment) {
+							below = segments_sweep_previous(status, segment);
 						}
-						else {
-							return SegmentsIntersection(IntersectionType::None);
+						if (above == segment) {
+							above = segments_sweep_next(status, segment);
 						}
+						segments_sweep_erase(status, segment);
 					}
 				}
+
+				for (std::uint32_t segment : reordered) {
+					segments_sweep_insert(status, segment, below);
+					schedule(below, segment);
+					below = segment;
+				}
+				schedule(below, above);
 			}
-			else {
-				return SegmentsIntersection(IntersectionType::None);
+			return pairs;
+		}
+
+		std::vector<IndexedSegmentsIntersection> all_line_segments_intersections(const std::vector<LineSegment>& segments, unsigned int threadCount) {
+			if (threadCount == 0) {
+				threadCount = default_thread_count();
+			}
+
+			std::vector<std::uint64_t> pairs = segments_sweep_pairs(segments);
+			std::sort(pairs.begin(), pairs.end());
+
+			// Every chunk fills its own array, the arrays are then concatenated in order
+			std::vector<std::vector<IndexedSegmentsIntersection>> chunkResults(threadCount);
+			size_t chunks = parallel_for(pairs.size(), [&](size_t begin, size_t end, size_t chunk) {
+				auto& results = chunkResults[chunk];
+				for (size_t i = begin; i < end; ++i) {
+					const std::uint32_t firstIndex = static_cast<std::uint32_t>(pairs[i] >> 32);
+					const std::uint32_t otherIndex = static_cast<std::uint32_t>(pairs[i]);
+					const LineSegment& first = segments[firstIndex];
+					const vec_t direction = first.end - first.start;
+
+					auto parameters = line_segments_parametric_intersection(first, segments[otherIndex]);
+					if (parameters.type == IntersectionType::Crossing) {
+						results.push_back({ firstIndex, otherIndex, SegmentsIntersection(IntersectionType::Crossing, first.start + direction * parameters.t) });
+					}
+					else if (parameters.type == IntersectionType::Overlapping) {
+						std::pair<vec_t, vec_t> overlap{ first.start + direction * parameters.t, first.start + direction * parameters.tEnd };
+						results.push_back({ firstIndex, otherIndex, SegmentsIntersection(IntersectionType::Overlapping, overlap) });
+					}
+				}
+			}, threadCount, SEGMENTS_INTERSECTION_MIN_CHUNK_SIZE);
+
+			std::vector<IndexedSegmentsIntersection> intersections;
+			size_t total = 0;
+			for (size_t chunk = 0; chunk < chunks; ++chunk) {
+				total += chunkResults[chunk].size();
+			}
+			intersections.reserve(total);
+			// SegmentsIntersection can't be assigned, only copy constructed
+			for (size_t chunk = 0; chunk < chunks; ++chunk) {
+				for (const auto& intersection : chunkResults[chunk]) {
+					intersections.push_back(intersection);
+				}
 			}
+			return intersections;
 		}
 	}
 }
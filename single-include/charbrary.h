@@ -212,6 +212,16 @@ namespace ch {
 	 */
 	float vec_dot_product(vec_t a, vec_t b);
 
+	/**
+	 * \brief Computes the 2D cross product of 2 vectors (a.x * b.y - a.y * b.x).
+	 *
+	 * The result is positive if b is rotated clockwise from a on a screen (Y axis going
+	 * down), negative if it is rotated counterclockwise, and 0 if the vectors are parallel.
+	 *
+	 * \return The result of the cross product, a scalar.
+	 */
+	float vec_cross_product(vec_t a, vec_t b);
+
 	/**
 	 * \brief Makes the components of the vector positive.
 	 * \return A vector whose components are positive numbers.
@@ -256,6 +266,42 @@ namespace ch {
 	static const ch::vec_t NULL_VEC = { 0.f,0.f };
 }
 
+#include <cstddef>
+
+namespace ch {
+	/**
+	 * \brief Computes the magnitude of many vectors.
+	 *
+	 * Batched equivalent of vec_magnitude(). The vectors are given as two arrays, one
+	 * for the X components and one for the Y components. The implementation (scalar,
+	 * SSE2, AVX2 or AVX-512) is chosen at runtime depending on ch::simd::active_simd_level().
+	 *
+	 * \param x X components of the vectors.
+	 * \param y Y components of the vectors.
+	 * \param magnitudes Output array receiving the magnitude of each vector.
+	 * \param count Number of vectors.
+	 */
+	void vec_magnitude_batch(const float* x, const float* y, float* magnitudes, size_t count);
+
+	/**
+	 * \brief Computes the dot product of many pairs of vectors.
+	 *
+	 * Batched equivalent of vec_dot_product(). products[i] receives the dot product of (ax[i], ay[i]) and (bx[i], by[i]).
+	 */
+	void vec_dot_product_batch(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count);
+
+	/**
+	 * \brief Normalizes many vectors in place.
+	 *
+	 * Batched equivalent of vec_normalize(). Null vectors stay null.
+	 *
+	 * \param x X components of the vectors, overwritten with the normalized components.
+	 * \param y Y components of the vectors, overwritten with the normalized components.
+	 * \param count Number of vectors.
+	 */
+	void vec_normalize_batch(float* x, float* y, size_t count);
+}
+
 namespace ch {
 	/**
 	 * \brief Represents an AABB's corner.
@@ -506,6 +552,108 @@ namespace ch {
 	bool operator!=(const AABB& left, const AABB& right);
 }
 
+namespace ch {
+
+	/**
+	 * \brief Represents an Axis-Aligned-Bounding-Box by its minimum and maximum corners.
+	 *
+	 * An AABB stores a position and a size, so every collision test has to add them
+	 * together to find the right and bottom sides. Bounds store the sides directly, which
+	 * turns the tests into plain comparisons. Use them for shapes that are tested often
+	 * (broadphase, batches, etc...).
+	 *
+	 * Converting an AABB to Bounds and back gives the same AABB, unless the additions
+	 * and subtractions involved are rounded (very large positions or very small sizes).
+	 */
+	class Bounds {
+
+	public:
+
+		vec_t min; /**< Top-left corner of the bounds (smallest coordinates). */
+
+		vec_t max; /**< Bottom-right corner of the bounds (largest coordinates). */
+
+	public:
+
+		/**
+		 * \brief Constructs new bounds with default values.
+		 *
+		 * By default, both corners are at 0,0.
+		 */
+		Bounds();
+
+		/**
+		 * \brief Constructs new bounds from 2 corners.
+		 * \param min_ Top-left corner.
+		 * \param max_ Bottom-right corner.
+		 */
+		Bounds(const vec_t& min_, const vec_t& max_);
+
+		/**
+		 * \brief Constructs new bounds from 4 values.
+		 *
+		 * \param minX Left side.
+		 * \param minY Top side.
+		 * \param maxX Right side.
+		 * \param maxY Bottom side.
+		 */
+		Bounds(float minX, float minY, float maxX, float maxY);
+
+		/**
+		 * \brief Constructs the bounds of an AABB.
+		 */
+		explicit Bounds(const AABB& aabb);
+
+		/**
+		 * \brief Converts the bounds to an AABB.
+		 * \return An AABB covering the same area.
+		 */
+		AABB toAABB() const;
+
+		/**
+		 * \brief Moves the bounds by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
+
+		/**
+		 * \brief Returns the center of the bounds.
+		 * \return The position of the center.
+		 */
+		vec_t center() const;
+
+		/**
+		 * \brief Returns the size of the bounds.
+		 * \return The width (X) and the height (Y) of the bounds.
+		 */
+		vec_t size() const;
+
+		/**
+		 * \brief Computes the perimeter of the bounds.
+		 * \return The perimeter of the bounds.
+		 */
+		float perimeter() const;
+
+		/**
+		 * \brief Computes the area of the bounds.
+		 * \return The area of the bounds.
+		 */
+		float area() const;
+	};
+
+	/**
+	 * \brief Overload of the equality operator.
+	 * \return True if left and right are equal, false otherwise.
+	 */
+	bool operator==(const Bounds& left, const Bounds& right);
+
+	/**
+	 * \brief Overload of the inequality operator.
+	 * \return True if left and right are different, false otherwise.
+	 */
+	bool operator!=(const Bounds& left, const Bounds& right);
+}
+
 #include <string>
 
 namespace ch {
@@ -678,270 +826,3440 @@ namespace ch {
 	bool operator!=(const LineSegment& left, const LineSegment& right);
 }
 
-#include <chrono>
-
 namespace ch {
 
 	/**
-	 * \brief Represents a stopwatch.
+	 * \brief A line segment with cached values, for segments tested many times.
 	 *
-	 * A utility class that encapsulates time measurement in a very simple interface.
+	 * A LineSegment recomputes its direction, its length and its bounds every time they
+	 * are needed. A PreparedSegment computes them once when it is constructed, along with
+	 * the inverse of its direction, so that testing it against a box only takes a few
+	 * multiplications (think of a laser tested against thousands of boxes).
+	 *
+	 * The cached values can't get out of sync : a PreparedSegment can't be modified,
+	 * build a new one when the segment moves.
 	 */
-	class Stopwatch {
+	class PreparedSegment {
+
 	public:
-		using time_point = std::chrono::time_point<std::chrono::system_clock>;
 
 		/**
-		 * \brief Constructs a new Stopwatch and starts it
+		 * \brief Constructs a prepared segment from 2 points.
+		 * \param startPoint First point of the segment.
+		 * \param endPoint Second point of the segment.
 		 */
-		Stopwatch();
+		PreparedSegment(const vec_t& startPoint, const vec_t& endPoint);
 
 		/**
-		 * \brief Starts measuring time.
+		 * \brief Constructs a prepared segment from a LineSegment.
 		 */
-		void start();
+		explicit PreparedSegment(const LineSegment& segment);
 
 		/**
-		 * \brief reset() is a convenient alias for the start() method.
+		 * \return The first point of the segment.
 		 */
-		void reset();
+		const vec_t& start() const;
 
 		/**
-		 * \brief Stops measuring time.
-		 * \note Stopping the watch is not necessary to get the elapsed time. 
+		 * \return The second point of the segment.
 		 */
-		void stop();
+		const vec_t& end() const;
 
 		/**
-		 * \brief Returns the elapsed time in seconds.
-		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 * \return The vector going from the start to the end of the segment (not normalized).
 		 */
-		long elapsedSeconds();
+		const vec_t& direction() const;
 
 		/**
-		 * \brief Returns the elapsed time in milliseconds.
-		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 * \return 1 / direction() on each axis, 0 on an axis along which the direction is 0.
 		 */
-		long elapsedMilliseconds();
+		const vec_t& inverseDirection() const;
 
 		/**
-		 * \brief Returns the elapsed time in microseconds.
-		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 * \return The length of the segment.
 		 */
-		long elapsedMicroseconds();
+		float length() const;
 
 		/**
-		 * \brief Returns the elapsed time in nanoseconds.
-		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 * \return 1 / squared length of the segment, 0 if the segment is a point.
 		 */
-		long elapsedNanoseconds();
+		float inverseLengthSquared() const;
 
-	private:
+		/**
+		 * \return The smallest bounds containing both points of the segment.
+		 */
+		const Bounds& bounds() const;
 
 		/**
-		 * \brief Returns a time_point representing the current moment.
+		 * \return The segment as a LineSegment.
 		 */
-		time_point now() const;
+		LineSegment segment() const;
 
-		time_point start_; /**< Time at which the stopwatch started measuring */
-		time_point end_; /**< Time at which the stopwatch stopped measuring */
+	private:
+
+		vec_t start_; /**< First point of the segment. */
+		vec_t end_; /**< Second point of the segment. */
+		vec_t direction_; /**< end_ - start_. */
+		vec_t inverseDirection_; /**< 1 / direction_ on each axis (0 if the direction is 0). */
+		float length_; /**< Length of the segment. */
+		float inverseLengthSquared_; /**< 1 / squared length (0 if the segment is a point). */
+		Bounds bounds_; /**< Bounds of the segment. */
 	};
 }
 
+#include <array>
 #include <vector>
 
-namespace ch { 
+namespace ch {
 
-	//! Contains random number generation (RNG) utils
-	namespace rand {
+	/**
+	 * \brief Represents a convex polygon with a small number of vertices.
+	 *
+	 * The vertices are stored inside the object (no allocation), along with the normal of
+	 * every edge and the bounds of the polygon, so the collision tests (see
+	 * collision::polygon_collision_info()) don't have to recompute them.
+	 *
+	 * The vertices are reordered at construction so that they always turn in the same
+	 * direction : the normal of the edge going from vertex(i) to vertex(i + 1) points out
+	 * of the polygon.
+	 */
+	class ConvexPolygon {
 
-		/**
-		 * \brief Generates a random integer within the given boundaries. The lower and upper limits are inclusive, meaning they are included in the range of possible values.
-		 */
-		int rand_int(int lowerInc, int upperInc);
+	public:
+
+		static constexpr size_t MAX_VERTICES = 8; /**< Maximum number of vertices of a polygon. */
+
+	public:
 
 		/**
-		 * \brief Generates a random float within the given boundaries. The lower and upper limits are inclusive, meaning they are included in the range of possible values.
+		 * \brief Constructs a polygon from its vertices.
+		 *
+		 * \param vertices The vertices, in clockwise or counter-clockwise order.
+		 * \throws std::invalid_argument If there are less than 3 or more than MAX_VERTICES vertices,
+		 * 		   or if the polygon is not convex (or is flat, has two equal consecutive vertices or crosses itself).
 		 */
-		float rand_float(float min, float max);
+		ConvexPolygon(const std::vector<vec_t>& vertices);
 
 		/**
-		* \brief Returns a random boolean.
-		*/
-		bool rand_bit();
-		 
-		/**
-		* \brief Returns a boolean with the given probability of being true.
-		*/
-		bool rand_bit(float probability);
+		 * \brief Constructs a polygon from the 4 corners of an AABB.
+		 */
+		explicit ConvexPolygon(const AABB& aabb);
 
 		/**
-		* \brief Generates a random normalized float (between -1 and 1).
-		*/
-		float rnd_normal_float();
+		 * \brief Moves the polygon by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
 
 		/**
-		 * \brief Generates a random angle in degrees (between 0 and 360).
+		 * \brief Rotates the polygon around its center.
+		 * \param angle Angle in degrees.
 		 */
-		float rnd_angle_deg();
+		void rotate(float angle);
 
 		/**
-		 * \brief Generates a random angle in radians (between 0 and 2*pi).
+		 * \return The vertex at the given index.
 		 */
-		float rnd_angle_rad();
+		const vec_t& vertex(size_t index) const;
 
 		/**
-		 * \brief Generates a vector with random XY values within the given boundaries.
+		 * \return The outward unit normal of the edge going from vertex(index) to vertex(index + 1).
 		 */
-		vec_t rand_vector(float minX, float maxX, float minY, float maxY);
+		const vec_t& normal(size_t index) const;
 
 		/**
-		 * \brief Generates a random unit vector.
+		 * \return The number of vertices (and of edges) of the polygon.
 		 */
-		vec_t rand_unit_vector();
+		size_t size() const;
 
 		/**
-		 * \brief Generates a random point located on the given rectangle.
+		 * \return The average of the vertices.
 		 */
-		vec_t rand_point_on_rect(vec_t topLeftCorner, vec_t size);
+		vec_t center() const;
 
 		/**
-		 * \brief Generates a random point located on the given rectangle.
+		 * \return The bounds of the polygon.
 		 */
-		vec_t rand_point_on_rect(vec_t center, float width, float height);
+		const Bounds& bounds() const;
 
 		/**
-		 * \brief Generates a random point located on the given circle.
+		 * \return The smallest AABB containing the polygon.
 		 */
-		vec_t rand_point_on_circle(float circleRadius, vec_t circleCenter = { 0.f,0.f });
+		AABB aabb() const;
+
+	private:
 
 		/**
-		 * \brief Generates a random point located on the given taurus (taurus = donut).
+		 * \brief Recomputes the normals and the bounds from the vertices.
 		 */
-		vec_t rand_point_on_torus(float innerRadius, float outerRadius, vec_t torusCenter = { 0.f,0.f });
-	}
-}
-
-namespace ch {
+		void update();
 
-	/**
-	 * \brief Contains information about a collision between 2 circles.
-	 */
-	struct CirclesCollision {
-		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
-		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+		std::array<vec_t, MAX_VERTICES> vertices_; /**< The vertices, only the first count_ are used. */
+		std::array<vec_t, MAX_VERTICES> normals_; /**< Outward normal of each edge. */
+		size_t count_; /**< Number of vertices. */
+		Bounds bounds_; /**< Bounds of the vertices. */
 	};
 }
 
+#include <array>
+
 namespace ch {
 
 	/**
-	 * \brief Contains information about a collision between an AABB and a circle.
+	 * \brief Represents an oriented bounding box : a rectangle rotated around its center.
+	 *
+	 * The cosine and the sine of the rotation are computed when the angle changes and kept
+	 * in the box as its two local axes, so the collision tests (see collision::obb_collision_info())
+	 * only need dot products.
 	 */
-	struct CircleAABBCollision {
-		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
-		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
-	};
-}
+	class OBB {
 
-namespace ch {
+	public:
 
-	//! Contains collision detection utils for 2D shapes (AABBs, circles, lines)
-	namespace collision {
+		/**
+		 * \brief Constructs an OBB.
+		 *
+		 * \param center Position of the center of the box.
+		 * \param halfSize Half of the width (X) and half of the height (Y) of the box, before the rotation.
+		 * \param angle Rotation of the box in degrees.
+		 */
+		OBB(const vec_t& center, const vec_t& halfSize, float angle = 0.f);
 
-		/** \return A circle that contains the given AABB. */
-		Circle enclosingCircle(const AABB& aabb);
+		/**
+		 * \brief Constructs a non-rotated OBB covering the given AABB.
+		 */
+		explicit OBB(const AABB& aabb);
 
-		/** \return A circle contained in the given AABB. */
-		Circle inscribedCircle(const AABB& aabb);
+		/**
+		 * \brief Moves the box by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
 
-		/** \return An AABB that contains the given circle. */
-		AABB enclosingAABB(const Circle& circle);
+		/**
+		 * \brief Moves the center of the box to the given position.
+		 */
+		void setCenter(const vec_t& center);
 
-		/** \return The smallest enclosing AABB that contains both points of the segment. */
-		AABB enclosingAABB(const LineSegment& lineSegment);
+		/**
+		 * \brief Changes the rotation of the box.
+		 * \param angle Angle in degrees.
+		 */
+		void setAngle(float angle);
 
-		/** \return An AABB contained in the given circle. */
-		AABB inscribedAABB(const Circle& circle);
-			
-		/** \returns True if the given point is inside the AABB, false otherwise. */
-		bool aabb_contains(const AABB& aabb, const vec_t& point);
+		/**
+		 * \brief Rotates the box around its center.
+		 * \param angle Angle in degrees, added to the current rotation.
+		 */
+		void rotate(float angle);
 
-		/** \returns True if the first AABB contains the other AABB, false otherwise. */
-		bool aabb_contains(const AABB& first, const AABB& other);
+		/**
+		 * \return The position of the center of the box.
+		 */
+		const vec_t& center() const;
 
-		/** \returns True if the AABB contains the circle, false otherwise. */
-		bool aabb_contains(const AABB& aabb, const Circle& circle);
+		/**
+		 * \return Half of the width (X) and half of the height (Y) of the box.
+		 */
+		const vec_t& halfSize() const;
 
-		/** \returns True if the circle contains the point, false otherwise. */
-		bool circle_contains(const Circle& circle, const vec_t& point);
+		/**
+		 * \return The rotation of the box in degrees.
+		 */
+		float angle() const;
 
-		/** \returns True if the first circle contains the other, false otherwise. */
-		bool circle_contains(const Circle& first, const Circle& other);
+		/**
+		 * \return The local X axis of the box : (cos(angle), sin(angle)).
+		 */
+		const vec_t& axisX() const;
 
-		/** \returns True if the circle contains the AABB, false otherwise. */
-		bool circle_contains(const Circle& circle, const AABB& aabb);
+		/**
+		 * \return The local Y axis of the box : (-sin(angle), cos(angle)).
+		 */
+		const vec_t& axisY() const;
 
-		/** \returns True if the given AABBs intersect, false otherwise. */
-		bool aabb_intersects(const AABB& a, const AABB& b);
+		/**
+		 * \brief Computes the position of every corner of the box.
+		 *
+		 * The corners are ordered like the Corner enum, as they would be if the box wasn't rotated.
+		 *
+		 * \return An array containing all 4 corners of the box.
+		 */
+		std::array<vec_t, static_cast<size_t>(Corner::MAX_VALUE)> corners() const;
 
-		/** \returns True if the AABB and the circle intersect, false otherwise. */
+		/**
+		 * \return The smallest bounds containing the box.
+		 */
+		Bounds bounds() const;
+
+		/**
+		 * \return The smallest AABB containing the box.
+		 */
+		AABB aabb() const;
+
+		/**
+		 * \brief Converts a position into the coordinates of the box (relative to its center, along its axes).
+		 */
+		vec_t toLocal(const vec_t& point) const;
+
+		/**
+		 * \brief Converts a position in the coordinates of the box back into world coordinates.
+		 */
+		vec_t toWorld(const vec_t& point) const;
+
+	private:
+
+		vec_t center_; /**< Position of the center. */
+		vec_t halfSize_; /**< Half of the size before the rotation. */
+		float angle_; /**< Rotation in degrees. */
+		vec_t axisX_; /**< Cached (cos, sin) of the rotation. */
+		vec_t axisY_; /**< Cached (-sin, cos) of the rotation. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Represents a capsule : every point closer than a radius to a line segment.
+	 *
+	 * A capsule is a rectangle with two half circles at its extremities. It is the usual
+	 * hitbox of characters, as it slides over steps and corners.
+	 */
+	class Capsule {
+
+	public:
+
+		LineSegment segment; /**< The segment going through the middle of the capsule, from the center of one half circle to the other. */
+
+		float radius; /**< The radius of the half circles (and half of the width of the capsule). */
+
+	public:
+
+		/**
+		 * \brief Constructs a new capsule with default values.
+		 *
+		 * The new capsule will be reduced to a point positioned at 0,0.
+		 */
+		Capsule();
+
+		/**
+		 * \brief Constructs a new capsule from a segment and a radius.
+		 * \param segment_ Segment going through the middle of the capsule.
+		 * \param radius_ Radius of the capsule.
+		 */
+		Capsule(const LineSegment& segment_, float radius_);
+
+		/**
+		 * \brief Constructs a new capsule from the extremities of its segment and a radius.
+		 */
+		Capsule(const vec_t& start, const vec_t& end, float radius_);
+
+		/**
+		 * \brief Moves the capsule by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
+
+		/**
+		 * \return The middle of the segment of the capsule.
+		 */
+		vec_t center() const;
+
+		/**
+		 * \return The smallest bounds containing the capsule.
+		 */
+		Bounds bounds() const;
+
+		/**
+		 * \return The smallest AABB containing the capsule.
+		 */
+		AABB aabb() const;
+	};
+
+	/**
+	 * \brief Overload of the equality operator between 2 capsules.
+	 * \return True if both capsules have the same segment and radius.
+	 */
+	bool operator==(const Capsule& left, const Capsule& right);
+
+	/**
+	 * \brief Overload of the inequality operator between 2 capsules.
+	 * \return The opposite of operator==().
+	 */
+	bool operator!=(const Capsule& left, const Capsule& right);
+}
+
+namespace ch {
+
+	/**
+	 * \brief A convex shape seen through its support mapping, as used by collision::gjk_distance().
+	 *
+	 * The support mapping of a shape gives its farthest point in a direction. Rounded shapes
+	 * (circles and capsules) are split into a core shape (the center of the circle, the segment of
+	 * the capsule) and a radius : GJK runs on the cores, which converges in a few iterations, and
+	 * the radii are added at the end.
+	 *
+	 * A SupportShape only references the shape it was built from, which must outlive it.
+	 */
+	class SupportShape {
+
+	public:
+
+		/**
+		 * \brief Function returning the farthest point of a shape in a direction.
+		 *
+		 * The direction is not normalized and is never a null vector.
+		 */
+		using SupportMapping = vec_t(*)(const void* shape, const vec_t& direction);
+
+	public:
+
+		/** \brief References an AABB. */
+		SupportShape(const AABB& aabb);
+
+		/** \brief References bounds. */
+		SupportShape(const Bounds& bounds);
+
+		/** \brief References a circle (a point and a radius). */
+		SupportShape(const Circle& circle);
+
+		/** \brief References a line segment. */
+		SupportShape(const LineSegment& segment);
+
+		/** \brief References a convex polygon. */
+		SupportShape(const ConvexPolygon& polygon);
+
+		/** \brief References an OBB. */
+		SupportShape(const OBB& obb);
+
+		/** \brief References a capsule (a segment and a radius). */
+		SupportShape(const Capsule& capsule);
+
+		/**
+		 * \brief References any convex shape through its support mapping.
+		 *
+		 * \param shape The shape, given back to the support mapping.
+		 * \param mapping The support mapping of the core of the shape.
+		 * \param radius Radius added around the core of the shape.
+		 */
+		SupportShape(const void* shape, SupportMapping mapping, float radius = 0.f);
+
+		/**
+		 * \return The farthest point of the core of the shape in the given direction.
+		 */
+		vec_t support(const vec_t& direction) const;
+
+		/**
+		 * \return The radius added around the core of the shape.
+		 */
+		float radius() const;
+
+	private:
+
+		const void* shape_; /**< The referenced shape. */
+		SupportMapping mapping_; /**< Support mapping of the core of the shape. */
+		float radius_; /**< Radius around the core. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Represents an intersection between 2 segments as positions along the segments.
+	 *
+	 * A position t on the first segment corresponds to the point first.start + t * (first.end - first.start),
+	 * with t between 0 and 1. The same goes for u on the other segment.
+	 *
+	 * - type equals IntersectionType::None -> There is no intersection, the other members are 0.
+	 * - type equals IntersectionType::Crossing -> The segments cross at the point located at t on the
+	 *   first segment and at u on the other one. tEnd and uEnd are equal to t and u.
+	 * - type equals IntersectionType::Overlapping -> The segments are collinear and overlapping. The
+	 *   overlapping range goes from t to tEnd on the first segment (t < tEnd), which corresponds to the
+	 *   range from u to uEnd on the other segment.
+	 */
+	struct SegmentsParametricIntersection {
+		IntersectionType type; /**< Type of the intersection. */
+		float t; /**< Position of the intersection (or start of the overlap) on the first segment. */
+		float u; /**< Position of the intersection (or start of the overlap) on the other segment. */
+		float tEnd; /**< End of the overlap on the first segment. */
+		float uEnd; /**< End of the overlap on the other segment. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about a collision between a line segment and a circle.
+	 */
+	struct CircleSegmentCollision {
+		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
+		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+	};
+}
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about the first line segment hit by a moving circle.
+	 */
+	struct CircleSweepHit {
+		std::uint32_t index; /**< Index of the segment that was hit. */
+		float time; /**< Time of impact, between 0 (start of the motion) and 1 (end of the motion). */
+		vec_t normal; /**< Direction towards which the circle is pushed by the segment (unit vector). */
+		vec_t point; /**< Contact point, on the segment. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains the part of a line segment located inside an AABB.
+	 *
+	 * Positions along the segment go from 0 (segment.start) to 1 (segment.end).
+	 */
+	struct SegmentAABBClip {
+		bool intersects; /**< True if the segment crosses or touches the AABB. The other members are only meaningful if it does. */
+		float entry; /**< Position where the segment enters the AABB (0 if it starts inside). */
+		float exit; /**< Position where the segment leaves the AABB (1 if it ends inside). */
+		LineSegment clipped; /**< The part of the segment inside the AABB, from entry to exit. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about a collision between a convex polygon and another shape.
+	 */
+	struct PolygonCollision {
+		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
+		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about a collision between an OBB and another shape.
+	 */
+	struct OBBCollision {
+		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
+		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about a collision between a capsule and another shape.
+	 */
+	struct CapsuleCollision {
+		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
+		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about a collision between two convex shapes, as computed by collision::gjk_collision_info().
+	 */
+	struct ConvexCollision {
+		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
+		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+	};
+}
+
+#include <array>
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Remembers the simplex found by collision::gjk_distance() for a pair of shapes.
+	 *
+	 * The cache stores the search directions that produced the vertices of the last simplex.
+	 * When the same pair is tested again (usually on the next frame), the simplex is rebuilt
+	 * from these directions instead of from scratch, so a pair that barely moved converges
+	 * in one or two iterations. Keep one cache per pair of shapes.
+	 */
+	struct GJKCache {
+		std::array<vec_t, 3> directions; /**< Search direction of each vertex of the simplex. */
+		std::uint32_t count = 0; /**< Number of vertices in the simplex, 0 if the cache is empty. */
+	};
+}
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Contains the result of collision::gjk_distance().
+	 */
+	struct GJKResult {
+		bool intersects; /**< True if the shapes overlap. Shapes that only touch do not overlap. */
+		float distance; /**< Distance between the shapes, 0 if they overlap. */
+		vec_t pointOnFirst; /**< Point of the first shape closest to the other shape. Only meaningful if the shapes don't overlap. */
+		vec_t pointOnOther; /**< Point of the other shape closest to the first shape. Only meaningful if the shapes don't overlap. */
+		std::uint32_t iterations; /**< Number of support points computed to reach the result. */
+	};
+}
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief The data remembered by a PairCache for a pair of shapes, from one tick to the next.
+	 *
+	 * The contact is expressed with the shape of handle first as the first shape : the normal is the
+	 * direction towards which the shape of handle other needs to be pushed.
+	 */
+	struct PairContact {
+		std::uint32_t first; /**< Lowest handle of the pair. */
+		std::uint32_t other; /**< Highest handle of the pair. */
+		vec_t normal; /**< Normal of the last contact, NULL_VEC if the shapes have never touched. */
+		float depth; /**< Penetration depth of the last contact. */
+		vec_t separatingAxis; /**< Axis that separated the shapes the last time they were tested, NULL_VEC if they were touching. */
+		GJKCache gjk; /**< Simplex of the last GJK query on the pair. */
+		std::uint32_t seenFrame; /**< Last frame the pair was reported by the broadphase (see PairCache::get()). */
+		std::uint32_t touchFrame; /**< Last frame the shapes were touching, 0 if never. */
+		std::uint32_t beginFrame; /**< Frame the current contact began, 0 if the shapes aren't touching. */
+		bool touching; /**< True if the shapes were touching at the end of the last frame. */
+	};
+}
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Represents the type of a ContactEvent.
+	 */
+	enum class ContactEventType {
+		Begin, /**< The shapes started touching during the frame. */
+		End, /**< The shapes stopped touching during the frame (or the pair left the broadphase). */
+		MAX_VALUE
+	};
+
+	/**
+	 * \brief Reports a change of the contact state of a pair, as returned by PairCache::endFrame().
+	 */
+	struct ContactEvent {
+		ContactEventType type; /**< Whether the contact began or ended. */
+		std::uint32_t first; /**< Lowest handle of the pair. */
+		std::uint32_t other; /**< Highest handle of the pair. */
+	};
+}
+
+#include <cstdint>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Represents the type of a SensorEvent.
+		 */
+		enum class SensorEventType {
+			Enter, /**< The entity started overlapping the sensor during the tick. */
+			Stay, /**< The entity was already overlapping the sensor and still does. Only reported on demand. */
+			Exit, /**< The entity stopped overlapping the sensor during the tick (or the sensor was removed). */
+			MAX_VALUE
+		};
+
+		/**
+		 * \brief Reports a change of the overlap between a sensor and an entity, as returned by SensorSystem::update().
+		 */
+		struct SensorEvent {
+			SensorEventType type; /**< Whether the entity entered, stayed in or exited the sensor. */
+			std::uint32_t sensor; /**< Identifier of the sensor, as returned by SensorSystem::add(). */
+			std::uint32_t entity; /**< Index of the entity in the array given to SensorSystem::update(). */
+		};
+	}
+}
+
+#include <array>
+#include <cstdint>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr std::uint32_t MAX_SLIDE_ITERATIONS = 8; /**< Largest number of iterations (and contacts) of a KinematicMover. */
+
+		/**
+		 * \brief An obstacle hit by a KinematicMover during a move.
+		 */
+		struct SlideContact {
+			std::uint32_t index; /**< Index of the obstacle, in the array given to KinematicMover::moveAndSlide(). */
+			vec_t normal; /**< Direction towards which the moving shape is pushed by the obstacle (unit vector). */
+			vec_t position; /**< Position of the moving shape when it hit the obstacle. */
+		};
+
+		/**
+		 * \brief Result of KinematicMover::moveAndSlide().
+		 *
+		 * The contacts are stored in a fixed array, so a move never allocates memory.
+		 */
+		struct MoveResult {
+			vec_t position; /**< Final position of the moving shape (top-left corner of an AABB, center of a circle). */
+			std::array<SlideContact, MAX_SLIDE_ITERATIONS> contacts; /**< Obstacles hit during the move, in order. */
+			std::uint32_t contactCount = 0; /**< Number of contacts. */
+		};
+	}
+}
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about the closest shape hit by a ray (a LineSegment going from start to end).
+	 */
+	struct RaycastHit {
+		std::uint32_t index; /**< Index of the shape that was hit, in the array the structure was built from. */
+		float t; /**< Position of the hit along the ray, between 0 (ray start) and 1 (ray end). */
+		vec_t point; /**< Position of the hit. */
+	};
+}
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many AABBs in a structure-of-arrays layout.
+	 *
+	 * Instead of storing a position and a size per box, the batch stores the boundaries
+	 * of every box in four contiguous arrays (min X, min Y, max X and max Y). This is the
+	 * layout expected by the batched collision functions, which can then test several boxes
+	 * at once with SIMD instructions.
+	 */
+	class AABBBatch {
+
+	public:
+
+		std::vector<float> minX; /**< Left side of each box. */
+		std::vector<float> minY; /**< Top side of each box. */
+		std::vector<float> maxX; /**< Right side of each box. */
+		std::vector<float> maxY; /**< Bottom side of each box. */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		AABBBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given AABBs.
+		 */
+		AABBBatch(const std::vector<AABB>& aabbs);
+
+		/**
+		 * \brief Adds an AABB at the end of the batch.
+		 */
+		void push_back(const AABB& aabb);
+
+		/**
+		 * \brief Adds bounds at the end of the batch.
+		 */
+		void push_back(const Bounds& bounds);
+
+		/**
+		 * \brief Replaces the AABB at the given index.
+		 */
+		void set(size_t index, const AABB& aabb);
+
+		/**
+		 * \brief Replaces the box at the given index.
+		 */
+		void set(size_t index, const Bounds& bounds);
+
+		/**
+		 * \brief Rebuilds the AABB stored at the given index.
+		 */
+		AABB at(size_t index) const;
+
+		/**
+		 * \brief Returns the bounds stored at the given index, without any rounding.
+		 */
+		Bounds bounds(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of AABBs.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every AABB from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of AABBs in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any AABB.
+		 */
+		bool empty() const;
+	};
+}
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many circles in a structure-of-arrays layout.
+	 *
+	 * The center coordinates and the radius of every circle are stored in three contiguous
+	 * arrays. This is the layout expected by the batched collision functions.
+	 */
+	class CircleBatch {
+
+	public:
+
+		std::vector<float> x; /**< X position of the center of each circle. */
+		std::vector<float> y; /**< Y position of the center of each circle. */
+		std::vector<float> radius; /**< Radius of each circle. */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		CircleBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given circles.
+		 */
+		CircleBatch(const std::vector<Circle>& circles);
+
+		/**
+		 * \brief Adds a circle at the end of the batch.
+		 */
+		void push_back(const Circle& circle);
+
+		/**
+		 * \brief Replaces the circle at the given index.
+		 */
+		void set(size_t index, const Circle& circle);
+
+		/**
+		 * \brief Rebuilds the circle stored at the given index.
+		 */
+		Circle at(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of circles.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every circle from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of circles in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any circle.
+		 */
+		bool empty() const;
+	};
+}
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many line segments in a structure-of-arrays layout.
+	 *
+	 * The extremities of every segment are stored in four contiguous arrays, which is the
+	 * layout expected by the batched segment intersection functions.
+	 */
+	class LineSegmentBatch {
+
+	public:
+
+		std::vector<float> startX; /**< X coordinate of the first point of each segment. */
+		std::vector<float> startY; /**< Y coordinate of the first point of each segment. */
+		std::vector<float> endX; /**< X coordinate of the second point of each segment. */
+		std::vector<float> endY; /**< Y coordinate of the second point of each segment. */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		LineSegmentBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given segments.
+		 */
+		LineSegmentBatch(const std::vector<LineSegment>& segments);
+
+		/**
+		 * \brief Adds a segment at the end of the batch.
+		 */
+		void push_back(const LineSegment& segment);
+
+		/**
+		 * \brief Replaces the segment at the given index.
+		 */
+		void set(size_t index, const LineSegment& segment);
+
+		/**
+		 * \brief Rebuilds the segment stored at the given index.
+		 */
+		LineSegment at(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of segments.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every segment from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of segments in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any segment.
+		 */
+		bool empty() const;
+	};
+}
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many OBBs in a structure-of-arrays layout.
+	 *
+	 * The center, the half size and the cosine and sine of the rotation of every box are
+	 * stored in six contiguous arrays. This is the layout expected by the batched collision
+	 * functions, which never compute the rotation of the boxes again.
+	 */
+	class OBBBatch {
+
+	public:
+
+		std::vector<float> centerX; /**< X position of the center of each box. */
+		std::vector<float> centerY; /**< Y position of the center of each box. */
+		std::vector<float> halfWidth; /**< Half of the width of each box. */
+		std::vector<float> halfHeight; /**< Half of the height of each box. */
+		std::vector<float> cosine; /**< Cosine of the rotation of each box (X component of its local X axis). */
+		std::vector<float> sine; /**< Sine of the rotation of each box (Y component of its local X axis). */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		OBBBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given OBBs.
+		 */
+		OBBBatch(const std::vector<OBB>& obbs);
+
+		/**
+		 * \brief Adds an OBB at the end of the batch.
+		 */
+		void push_back(const OBB& obb);
+
+		/**
+		 * \brief Replaces the OBB at the given index.
+		 */
+		void set(size_t index, const OBB& obb);
+
+		/**
+		 * \brief Rebuilds the OBB stored at the given index.
+		 *
+		 * The angle of the box is computed back from its cosine and sine.
+		 */
+		OBB at(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of OBBs.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every OBB from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of OBBs in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any OBB.
+		 */
+		bool empty() const;
+	};
+}
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Represents the type of a shape referenced by a ShapeRef.
+	 */
+	enum class ShapeType : std::uint8_t {
+		AABB, /**< An AABB, stored in an AABBBatch. */
+		Circle, /**< A circle, stored in a CircleBatch. */
+		LineSegment, /**< A line segment, stored in a LineSegmentBatch. */
+		MAX_VALUE
+	};
+
+	/**
+	 * \brief References a shape stored in the batch matching its type.
+	 */
+	struct ShapeRef {
+		ShapeType type; /**< Type of the shape, which tells in which batch it is stored. */
+		std::uint32_t index; /**< Index of the shape in its batch. */
+	};
+
+	/**
+	 * \brief A candidate pair of shapes of any type, as returned by a broadphase.
+	 */
+	struct ShapePair {
+		ShapeRef first; /**< The first shape of the pair. */
+		ShapeRef other; /**< The other shape of the pair. */
+	};
+}
+
+#include <chrono>
+
+namespace ch {
+
+	/**
+	 * \brief Represents a stopwatch.
+	 *
+	 * A utility class that encapsulates time measurement in a very simple interface.
+	 */
+	class Stopwatch {
+	public:
+		using time_point = std::chrono::time_point<std::chrono::system_clock>;
+
+		/**
+		 * \brief Constructs a new Stopwatch and starts it
+		 */
+		Stopwatch();
+
+		/**
+		 * \brief Starts measuring time.
+		 */
+		void start();
+
+		/**
+		 * \brief reset() is a convenient alias for the start() method.
+		 */
+		void reset();
+
+		/**
+		 * \brief Stops measuring time.
+		 * \note Stopping the watch is not necessary to get the elapsed time. 
+		 */
+		void stop();
+
+		/**
+		 * \brief Returns the elapsed time in seconds.
+		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 */
+		long elapsedSeconds();
+
+		/**
+		 * \brief Returns the elapsed time in milliseconds.
+		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 */
+		long elapsedMilliseconds();
+
+		/**
+		 * \brief Returns the elapsed time in microseconds.
+		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 */
+		long elapsedMicroseconds();
+
+		/**
+		 * \brief Returns the elapsed time in nanoseconds.
+		 * \note Stopping the watch is not necessary to get the elapsed time.
+		 */
+		long elapsedNanoseconds();
+
+	private:
+
+		/**
+		 * \brief Returns a time_point representing the current moment.
+		 */
+		time_point now() const;
+
+		time_point start_; /**< Time at which the stopwatch started measuring */
+		time_point end_; /**< Time at which the stopwatch stopped measuring */
+	};
+}
+
+#include <vector>
+
+namespace ch { 
+
+	//! Contains random number generation (RNG) utils
+	namespace rand {
+
+		/**
+		 * \brief Generates a random integer within the given boundaries. The lower and upper limits are inclusive, meaning they are included in the range of possible values.
+		 */
+		int rand_int(int lowerInc, int upperInc);
+
+		/**
+		 * \brief Generates a random float within the given boundaries. The lower and upper limits are inclusive, meaning they are included in the range of possible values.
+		 */
+		float rand_float(float min, float max);
+
+		/**
+		* \brief Returns a random boolean.
+		*/
+		bool rand_bit();
+		 
+		/**
+		* \brief Returns a boolean with the given probability of being true.
+		*/
+		bool rand_bit(float probability);
+
+		/**
+		* \brief Generates a random normalized float (between -1 and 1).
+		*/
+		float rnd_normal_float();
+
+		/**
+		 * \brief Generates a random angle in degrees (between 0 and 360).
+		 */
+		float rnd_angle_deg();
+
+		/**
+		 * \brief Generates a random angle in radians (between 0 and 2*pi).
+		 */
+		float rnd_angle_rad();
+
+		/**
+		 * \brief Generates a vector with random XY values within the given boundaries.
+		 */
+		vec_t rand_vector(float minX, float maxX, float minY, float maxY);
+
+		/**
+		 * \brief Generates a random unit vector.
+		 */
+		vec_t rand_unit_vector();
+
+		/**
+		 * \brief Generates a random point located on the given rectangle.
+		 */
+		vec_t rand_point_on_rect(vec_t topLeftCorner, vec_t size);
+
+		/**
+		 * \brief Generates a random point located on the given rectangle.
+		 */
+		vec_t rand_point_on_rect(vec_t center, float width, float height);
+
+		/**
+		 * \brief Generates a random point located on the given circle.
+		 */
+		vec_t rand_point_on_circle(float circleRadius, vec_t circleCenter = { 0.f,0.f });
+
+		/**
+		 * \brief Generates a random point located on the given taurus (taurus = donut).
+		 */
+		vec_t rand_point_on_torus(float innerRadius, float outerRadius, vec_t torusCenter = { 0.f,0.f });
+	}
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CH_SIMD_X86 1
+#endif
+
+// GCC and Clang only emit SSE/AVX instructions inside functions marked with the matching target.
+// MSVC accepts the intrinsics anywhere, so the attribute is simply dropped.
+#if defined(__GNUC__) || defined(__clang__)
+#define CH_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CH_SIMD_TARGET(isa)
+#endif
+
+namespace ch {
+
+	//! Contains utilities to detect the SIMD instruction sets supported by the CPU and to select the batched kernels
+	namespace simd {
+
+		/**
+		 * \brief Represents a tier of SIMD instructions.
+		 *
+		 * The tiers are ordered : a CPU supporting a tier also supports all the tiers below it.
+		 */
+		enum class SimdLevel {
+			Scalar, /**< Plain C++ code, available everywhere. */
+			SSE2, /**< 128-bit vectors (4 floats). */
+			AVX2, /**< 256-bit vectors (8 floats). */
+			AVX512, /**< 512-bit vectors (16 floats), AVX-512F. */
+			MAX_VALUE
+		};
+
+		/**
+		 * \brief Returns the highest SIMD tier supported by the CPU and the operating system.
+		 *
+		 * The CPU is only queried once, the result is cached for the lifetime of the program.
+		 */
+		SimdLevel detected_simd_level();
+
+		/**
+		 * \brief Returns the SIMD tier used by the batched kernels.
+		 *
+		 * By default, this is the detected tier. It can be lowered by setting the environment
+		 * variable CHARBRARY_SIMD to "scalar", "sse2", "avx2" or "avx512" before starting the
+		 * program, which is useful to benchmark each tier on the same machine.
+		 * A tier higher than the detected one is never selected.
+		 */
+		SimdLevel active_simd_level();
+
+		/**
+		 * \brief Changes the SIMD tier used by the batched kernels.
+		 *
+		 * \param level The requested tier. It is clamped to the detected tier.
+		 * \return The tier that is actually used from now on.
+		 */
+		SimdLevel set_simd_level(SimdLevel level);
+
+		/**
+		 * \brief Returns a readable name for the given tier ("scalar", "sse2", "avx2" or "avx512").
+		 */
+		const char* simd_level_name(SimdLevel level);
+	}
+}
+
+#include <cstddef>
+#include <functional>
+
+namespace ch {
+
+	/**
+	 * \brief Returns the number of threads used by the parallel algorithms when none is specified.
+	 *
+	 * This is the number of hardware threads reported by the system (at least 1).
+	 */
+	unsigned int default_thread_count();
+
+	/**
+	 * \brief Splits a range of indices in contiguous chunks and processes each chunk on its own thread.
+	 *
+	 * The calling thread processes the first chunk itself and the function returns once every chunk
+	 * has been processed. The chunks are as large as possible, there is at most one chunk per thread.
+	 *
+	 * \param count Number of indices to process (from 0 to count - 1).
+	 * \param task Function called once per chunk with the first index, the index past the last one and
+	 * 		  the index of the chunk (between 0 and the number of chunks - 1).
+	 * \param threadCount Maximum number of threads to use. 0 means default_thread_count().
+	 * \param minChunkSize Chunks are never smaller than this, so small ranges are processed on fewer threads.
+	 * \return The number of chunks the range was split into.
+	 */
+	size_t parallel_for(size_t count, const std::function<void(size_t begin, size_t end, size_t chunk)>& task, unsigned int threadCount = 0, size_t minChunkSize = 1024);
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about a collision between 2 circles.
+	 */
+	struct CirclesCollision {
+		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
+		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+	};
+}
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about a collision between an AABB and a circle.
+	 */
+	struct CircleAABBCollision {
+		vec_t normal; /**< The collision normal, a vector representing the direction of the collision. */
+		float absoluteDepth; /**< The depth of the collision (always positive). Can be used with the normal to determine the collision correction. */
+	};
+}
+
+#include <vector>
+
+namespace ch {
+
+	//! Contains collision detection utils for 2D shapes (AABBs, circles, lines)
+	namespace collision {
+
+		/** \return A circle that contains the given AABB. */
+		Circle enclosingCircle(const AABB& aabb);
+
+		/** \return A circle contained in the given AABB. */
+		Circle inscribedCircle(const AABB& aabb);
+
+		/** \return An AABB that contains the given circle. */
+		AABB enclosingAABB(const Circle& circle);
+
+		/** \return The smallest enclosing AABB that contains both points of the segment. */
+		AABB enclosingAABB(const LineSegment& lineSegment);
+
+		/** \return An AABB contained in the given circle. */
+		AABB inscribedAABB(const Circle& circle);
+
+		/** \return The bounds of the given circle. */
+		Bounds enclosingBounds(const Circle& circle);
+
+		/** \return The smallest bounds that contain both points of the segment. */
+		Bounds enclosingBounds(const LineSegment& lineSegment);
+			
+		/** \returns True if the given point is inside the AABB, false otherwise. */
+		bool aabb_contains(const AABB& aabb, const vec_t& point);
+
+		/** \returns True if the given point is inside the bounds, false otherwise. */
+		bool aabb_contains(const Bounds& bounds, const vec_t& point);
+
+		/** \returns True if the first AABB contains the other AABB, false otherwise. */
+		bool aabb_contains(const AABB& first, const AABB& other);
+
+		/** \returns True if the first bounds contain the other bounds, false otherwise. */
+		bool aabb_contains(const Bounds& first, const Bounds& other);
+
+		/** \returns True if the AABB contains the circle, false otherwise. */
+		bool aabb_contains(const AABB& aabb, const Circle& circle);
+
+		/** \returns True if the bounds contain the circle, false otherwise. */
+		bool aabb_contains(const Bounds& bounds, const Circle& circle);
+
+		/** \returns True if the circle contains the point, false otherwise. */
+		bool circle_contains(const Circle& circle, const vec_t& point);
+
+		/** \returns True if the first circle contains the other, false otherwise. */
+		bool circle_contains(const Circle& first, const Circle& other);
+
+		/** \returns True if the circle contains the AABB, false otherwise. */
+		bool circle_contains(const Circle& circle, const AABB& aabb);
+
+		/** \returns True if the circle contains the bounds, false otherwise. */
+		bool circle_contains(const Circle& circle, const Bounds& bounds);
+
+		/** \returns True if the given AABBs intersect, false otherwise. */
+		bool aabb_intersects(const AABB& a, const AABB& b);
+
+		/** \returns True if the given bounds intersect, false otherwise. */
+		bool aabb_intersects(const Bounds& a, const Bounds& b);
+
+		/** \returns True if the AABB and the circle intersect, false otherwise. */
 		bool aabb_intersects(const AABB& aabb, const Circle& circle);
 
-		/** \returns True if the circles intersect, false otherwise. */
-		bool circle_intersects(const Circle& circle, const Circle& other);
+		/** \returns True if the bounds and the circle intersect, false otherwise. */
+		bool aabb_intersects(const Bounds& bounds, const Circle& circle);
+
+		/** \returns True if the line segment crosses or touches the AABB, false otherwise. */
+		bool aabb_intersects(const AABB& aabb, const LineSegment& segment);
+
+		/** \returns True if the line segment crosses or touches the bounds, false otherwise. */
+		bool aabb_intersects(const Bounds& bounds, const LineSegment& segment);
+
+		/** \returns True if the prepared segment crosses or touches the AABB, false otherwise. */
+		bool aabb_intersects(const AABB& aabb, const PreparedSegment& segment);
+
+		/** \returns True if the prepared segment crosses or touches the bounds, false otherwise. */
+		bool aabb_intersects(const Bounds& bounds, const PreparedSegment& segment);
+
+		/** \returns True if the circles intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const Circle& other);
+
+		/** \returns True if the Circle and the AABB intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const AABB& aabb);
+
+		/** \returns True if the circle and the bounds intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const Bounds& bounds);
+
+		/** \returns True if the circle and the line segment intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const LineSegment& segment);
+
+		/** \returns True if the circle and the prepared segment intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const PreparedSegment& segment);
+
+		/** \returns The point of the segment that is the closest to the given point. */
+		vec_t closest_point_on_segment(const LineSegment& segment, const vec_t& point);
+
+		/** \returns The point of the prepared segment that is the closest to the given point. */
+		vec_t closest_point_on_segment(const PreparedSegment& segment, const vec_t& point);
+
+		/** \returns The point of the AABB that is the closest to the given point (the point itself if it is inside the AABB). */
+		vec_t closest_point_on_aabb(const AABB& aabb, const vec_t& point);
+
+		/** \returns The point of the bounds that is the closest to the given point. */
+		vec_t closest_point_on_aabb(const Bounds& bounds, const vec_t& point);
+
+		/** \returns The distance separating two circles (negative if overlapping) */
+		float circles_distance(const Circle& a, const Circle& b);
+
+		/**
+		 * \brief Checks if the first AABB collides with the other one.
+		 *
+		 * In case of a collision, this function returns an instance of AABBCollision containing the collision normal and the delta (overlap).
+		 * The collision normal is the direction (a unit vector) towards which the other AABB needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 *
+		 * \returns An AABBCollision containing information about the collision.
+		 */
+		AABBCollision aabb_collision_info(const AABB& first, const AABB& other);
+
+		/** \brief Same as aabb_collision_info(const AABB&, const AABB&), for bounds. */
+		AABBCollision aabb_collision_info(const Bounds& first, const Bounds& other);
+
+		/**
+		 * \brief Checks if the first circle collides with the other one.
+		 *
+		 * In case of a collision, this function returns an instance of CirclesCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other circle needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 *
+		 * \returns A CirclesCollision object containing information about the collision.
+		 */
+		CirclesCollision circles_collision_info(const Circle& first, const Circle& other);
+
+		/**
+		 * \brief Checks if an AABB and a circle collide with each other.
+		 *
+		 * In case of a collision, this function returns an instance of CircleAABBCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the *circle* needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 *
+		 * The normal goes from the point of the AABB closest to the center of the circle towards the center. If the center
+		 * is inside the AABB, the circle is pushed out through the closest side.
+		 *
+		 * \returns A CircleAABBCollision object containing information about the collision.
+		 */
+		CircleAABBCollision circle_aabb_collision_info(const AABB& aabb, const Circle& circle);
+
+		/** \brief Same as circle_aabb_collision_info(const AABB&, const Circle&), for bounds. */
+		CircleAABBCollision circle_aabb_collision_info(const Bounds& bounds, const Circle& circle);
+
+		/**
+		 * \brief Checks if the given line segments are intersecting.
+		 *
+		 * This methods generates a SegmentsIntersection instance representing the
+		 * state of intersection between the 2 segments.
+		 *
+		 * \note See the SegmentsIntersection class to learn how to interpret the
+		 *  	 result of this method.
+		 * 
+		 * \return A SegmentsIntersection giving information about the intersection.
+		 */
+		SegmentsIntersection line_segments_intersection_info(const LineSegment& first, const LineSegment& other);
+
+		/**
+		 * \brief Computes the intersection of 2 line segments as positions along the segments.
+		 *
+		 * Unlike line_segments_intersection_info(), this method uses cross products instead of
+		 * slopes : there are no special cases for vertical segments and no divisions before the
+		 * segments are known to be non-parallel. Segments that touch at a single point (including
+		 * collinear segments sharing an extremity) are crossing. A segment reduced to a point
+		 * crosses the other segment if the point is located on it.
+		 *
+		 * \note See the SegmentsParametricIntersection struct to learn how to interpret the
+		 * 		 result of this method.
+		 *
+		 * \return A SegmentsParametricIntersection giving information about the intersection.
+		 */
+		SegmentsParametricIntersection line_segments_parametric_intersection(const LineSegment& first, const LineSegment& other);
+
+		/**
+		 * \brief Checks if a line segment and a circle collide with each other.
+		 *
+		 * In case of a collision, this function returns an instance of CircleSegmentCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the *circle* needs to be pushed in order to resolve the collision.
+		 * If the center of the circle is on the segment, the circle is pushed perpendicularly to the segment.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 *
+		 * \returns A CircleSegmentCollision object containing information about the collision.
+		 */
+		CircleSegmentCollision circle_segment_collision_info(const LineSegment& segment, const Circle& circle);
+
+		/**
+		 * \brief Computes when a moving circle hits a line segment.
+		 *
+		 * The circle moves from circle.pos to circle.pos + motion. If the circle already
+		 * intersects the segment before moving, the time of impact is 0.
+		 *
+		 * \param time Receives the time of impact, between 0 and 1.
+		 * \return True if the circle hits the segment during the motion, false otherwise.
+		 */
+		bool circle_segment_time_of_impact(const Circle& circle, const vec_t& motion, const LineSegment& segment, float& time);
+
+		/**
+		 * \brief Computes when a moving AABB hits another AABB.
+		 *
+		 * The AABB moves from aabb.pos to aabb.pos + motion. If the AABBs already overlap
+		 * before moving, the time of impact is 0 and the normal is the one of aabb_collision_info(other, aabb).
+		 * An AABB touching the other one only hits it if it moves towards it : it can slide along its side.
+		 *
+		 * \param time Receives the time of impact, between 0 and 1.
+		 * \param normal Receives the direction towards which the moving AABB is pushed by the other one (unit vector).
+		 * \return True if the moving AABB hits the other one during the motion, false otherwise.
+		 */
+		bool aabb_time_of_impact(const AABB& aabb, const vec_t& motion, const AABB& other, float& time, vec_t& normal);
+
+		/**
+		 * \brief Computes when a moving circle hits an AABB.
+		 *
+		 * The circle moves from circle.pos to circle.pos + motion. If the circle already overlaps
+		 * the AABB before moving, the time of impact is 0 and the normal is the one of circle_aabb_collision_info(aabb, circle).
+		 * The circle hits either a side of the AABB or one of its rounded corners.
+		 *
+		 * \param time Receives the time of impact, between 0 and 1.
+		 * \param normal Receives the direction towards which the circle is pushed by the AABB (unit vector).
+		 * \return True if the circle hits the AABB during the motion, false otherwise.
+		 */
+		bool circle_aabb_time_of_impact(const Circle& circle, const vec_t& motion, const AABB& aabb, float& time, vec_t& normal);
+
+		/**
+		 * \brief Finds the first line segment hit by a moving circle.
+		 *
+		 * The circle moves from circle.pos to circle.pos + motion. Use the batched version
+		 * (circle_sweep_batch()) for large segment arrays.
+		 *
+		 * \param hit Receives the index of the segment, the time of impact, the normal and the contact point.
+		 * \return True if a segment was hit, false otherwise (hit is left untouched).
+		 */
+		bool circle_sweep(const Circle& circle, const vec_t& motion, const std::vector<LineSegment>& segments, CircleSweepHit& hit);
+
+		/**
+		 * \brief Computes the contact information of a moving circle that hits a segment at the given time.
+		 * \return The hit, with the given index and time.
+		 */
+		CircleSweepHit circle_sweep_hit(const Circle& circle, const vec_t& motion, const LineSegment& segment, std::uint32_t index, float time);
+
+		/**
+		 * \brief Clips a line segment against an AABB (Liang-Barsky algorithm).
+		 *
+		 * The segment is tested directly against the 2 pairs of parallel sides of the AABB
+		 * instead of being intersected with each side. A segment that only touches the AABB
+		 * intersects it.
+		 *
+		 * \note See the SegmentAABBClip struct to learn how to interpret the result of this method.
+		 *
+		 * \returns A SegmentAABBClip containing the entry and exit positions and the clipped segment.
+		 */
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const AABB& aabb);
+
+		/** \brief Same as line_segment_aabb_clip(const LineSegment&, const AABB&), for bounds. */
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const Bounds& bounds);
+
+		/** \brief Same as line_segment_aabb_clip(const LineSegment&, const AABB&), without recomputing the inverse direction of the segment. */
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const AABB& aabb);
+
+		/** \brief Same as line_segment_aabb_clip(const LineSegment&, const AABB&), for a prepared segment and bounds. */
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const Bounds& bounds);
+
+		/**
+		 * \brief Checks if two convex polygons collide with each other (separating axis theorem).
+		 *
+		 * In case of a collision, this function returns an instance of PolygonCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision. Polygons that only touch do not collide.
+		 *
+		 * The bounds of the polygons are compared first, so distant polygons are rejected without projecting them.
+		 *
+		 * \returns A PolygonCollision object containing information about the collision.
+		 */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& first, const ConvexPolygon& other);
+
+		/** \brief Same as polygon_collision_info(const ConvexPolygon&, const ConvexPolygon&), against an AABB. */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const AABB& aabb);
+
+		/** \brief Same as polygon_collision_info(const ConvexPolygon&, const ConvexPolygon&), against bounds. */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Bounds& bounds);
+
+		/** \brief Same as polygon_collision_info(const ConvexPolygon&, const ConvexPolygon&), against a circle. */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Circle& circle);
+
+		/** \returns True if the polygons collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& first, const ConvexPolygon& other);
+
+		/** \returns True if the polygon and the AABB collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& polygon, const AABB& aabb);
+
+		/** \returns True if the polygon and the bounds collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& polygon, const Bounds& bounds);
+
+		/** \returns True if the polygon and the circle collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& polygon, const Circle& circle);
+
+		/**
+		 * \brief Checks if an OBB collides with an AABB (separating axis theorem on the 4 axes of the boxes).
+		 *
+		 * In case of a collision, this function returns an instance of OBBCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision. Shapes that only touch do not collide.
+		 *
+		 * \returns An OBBCollision object containing information about the collision.
+		 */
+		OBBCollision obb_collision_info(const OBB& obb, const AABB& aabb);
+
+		/** \brief Same as obb_collision_info(const OBB&, const AABB&), against bounds. */
+		OBBCollision obb_collision_info(const OBB& obb, const Bounds& bounds);
+
+		/** \brief Same as obb_collision_info(const OBB&, const AABB&), against another OBB. */
+		OBBCollision obb_collision_info(const OBB& first, const OBB& other);
+
+		/**
+		 * \brief Same as obb_collision_info(const OBB&, const AABB&), against a circle.
+		 *
+		 * The circle is moved into the coordinates of the box and tested like with circle_aabb_collision_info().
+		 */
+		OBBCollision obb_collision_info(const OBB& obb, const Circle& circle);
+
+		/** \brief Same as obb_collision_info(const OBB&, const AABB&), against a line segment (the normal of the segment is the third axis). */
+		OBBCollision obb_collision_info(const OBB& obb, const LineSegment& segment);
+
+		/** \returns True if the OBB and the AABB collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const AABB& aabb);
+
+		/** \returns True if the OBB and the bounds collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const Bounds& bounds);
+
+		/** \returns True if the OBBs collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& first, const OBB& other);
+
+		/** \returns True if the OBB and the circle collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const Circle& circle);
+
+		/** \returns True if the OBB and the line segment collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const LineSegment& segment);
+
+		/**
+		 * \brief Finds the closest points between two line segments.
+		 *
+		 * If the segments cross, both points are at the intersection. If they are parallel, one
+		 * of the pairs of closest points is returned.
+		 *
+		 * \param onFirst Receives the point of the first segment closest to the other segment.
+		 * \param onOther Receives the point of the other segment closest to the first segment.
+		 */
+		void closest_points_between_segments(const LineSegment& first, const LineSegment& other, vec_t& onFirst, vec_t& onOther);
+
+		/**
+		 * \brief Checks if two capsules collide with each other.
+		 *
+		 * In case of a collision, this function returns an instance of CapsuleCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision. Shapes that only touch do not collide.
+		 *
+		 * The normal goes from the closest point of the segment of the capsule to the closest point of the other shape. If the
+		 * segments cross, the collision is found with the separating axis theorem on the normals of both segments : the other
+		 * shape is pushed until it's far enough from the line of the segment of the capsule, or its line far enough from the
+		 * segment of the capsule, whichever is shorter.
+		 *
+		 * \returns A CapsuleCollision object containing information about the collision.
+		 */
+		CapsuleCollision capsule_collision_info(const Capsule& first, const Capsule& other);
+
+		/** \brief Same as capsule_collision_info(const Capsule&, const Capsule&), against a circle. */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Circle& circle);
+
+		/** \brief Same as capsule_collision_info(const Capsule&, const Capsule&), against a line segment. */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const LineSegment& segment);
+
+		/**
+		 * \brief Same as capsule_collision_info(const Capsule&, const Capsule&), against an AABB.
+		 *
+		 * If the segment of the capsule crosses the AABB, the collision is found with the separating axis
+		 * theorem on the axes of the AABB and the normal of the segment.
+		 */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const AABB& aabb);
+
+		/** \brief Same as capsule_collision_info(const Capsule&, const AABB&), against bounds. */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Bounds& bounds);
+
+		/** \returns True if the capsules collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& first, const Capsule& other);
+
+		/** \returns True if the capsule and the circle collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const Circle& circle);
+
+		/** \returns True if the capsule and the line segment collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const LineSegment& segment);
+
+		/** \returns True if the capsule and the AABB collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const AABB& aabb);
+
+		/** \returns True if the capsule and the bounds collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const Bounds& bounds);
+	}
+}
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ch {
+	namespace collision {
+
+		/**
+		 * \brief A pair of indices of AABBs in an AABBBatch, as returned by a broadphase.
+		 */
+		using AABBIndexPair = std::pair<std::uint32_t, std::uint32_t>;
+
+		/**
+		 * \brief Tests one AABB against every AABB of a batch.
+		 *
+		 * This is the batched equivalent of aabb_intersects(const AABB&, const AABB&). The
+		 * implementation (scalar, SSE2, AVX2 or AVX-512) is chosen at runtime depending on
+		 * ch::simd::active_simd_level().
+		 *
+		 * \param aabb The AABB tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the AABB intersects the i-th AABB of the batch, 0 otherwise.
+		 * \return The number of intersecting AABBs.
+		 */
+		size_t aabb_intersects_batch(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one circle against every circle of a batch.
+		 *
+		 * This is the batched equivalent of circle_intersects(const Circle&, const Circle&).
+		 *
+		 * \param circle The circle tested against the batch.
+		 * \param batch The circles to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the circle intersects the i-th circle of the batch, 0 otherwise.
+		 * \return The number of intersecting circles.
+		 */
+		size_t circle_intersects_batch(const Circle& circle, const CircleBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one line segment against every segment of a batch.
+		 *
+		 * This is the batched equivalent of line_segments_parametric_intersection(). Segments
+		 * that cross or overlap are intersecting. Depending on the compiler, the SIMD kernels may
+		 * fuse multiplications and additions, so t and u can differ from the scalar function in
+		 * their last bits.
+		 *
+		 * \param segment The segment tested against the batch.
+		 * \param batch The segments to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the segment intersects the i-th segment of the batch, 0 otherwise.
+		 * \param t Optional output array of at least batch.size() elements. t[i] receives the position
+		 * 		  of the intersection (or of the start of the overlap) along the segment, 0 if there is none.
+		 * \param u Optional output array, same as t but along the i-th segment of the batch.
+		 * \return The number of intersecting segments.
+		 */
+		size_t line_segments_intersect_batch(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t = nullptr, float* u = nullptr);
+
+		/**
+		 * \brief Tests every segment of a batch against every segment of another batch.
+		 *
+		 * \param pairs Cleared, then filled with the (index in first, index in other) pairs of
+		 * 		  intersecting segments, sorted by index in first then by index in other.
+		 * \return The number of intersecting pairs.
+		 */
+		size_t line_segments_intersect_batch(const LineSegmentBatch& first, const LineSegmentBatch& other, std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs);
+
+		/**
+		 * \brief Clips one line segment against every AABB of a batch.
+		 *
+		 * This is the batched equivalent of line_segment_aabb_clip().
+		 *
+		 * \param segment The segment tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the segment crosses or touches the i-th AABB of the batch, 0 otherwise.
+		 * \param entry Optional output array of at least batch.size() elements. entry[i] receives the position
+		 * 		  where the segment enters the i-th AABB, 0 if it doesn't intersect it.
+		 * \param exit Optional output array, same as entry but for the position where the segment leaves the AABB.
+		 * \return The number of intersected AABBs.
+		 */
+		size_t line_segment_aabb_clip_batch(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry = nullptr, float* exit = nullptr);
+
+		/**
+		 * \brief Computes the collision between one circle and every AABB of a batch.
+		 *
+		 * This is the batched equivalent of circle_aabb_collision_info().
+		 *
+		 * \param circle The circle tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the circle collides with the i-th AABB of the batch, 0 otherwise.
+		 * \param normalX Optional output array of at least batch.size() elements. normalX[i] receives the X component
+		 * 		  of the normal towards which the circle must be pushed out of the i-th AABB, 0 if they don't collide.
+		 * \param normalY Optional output array, same as normalX but for the Y component of the normal.
+		 * \param depth Optional output array, same as normalX but for the penetration depth.
+		 * \return The number of AABBs colliding with the circle.
+		 */
+		size_t circle_aabb_collision_batch(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX = nullptr, float* normalY = nullptr, float* depth = nullptr);
+
+		/**
+		 * \brief Computes the collision of every pair of AABBs of a list.
+		 *
+		 * This is the batched equivalent of aabb_collision_info(), meant to be used as the
+		 * narrowphase of a broadphase that outputs pairs of indices.
+		 *
+		 * \param batch The AABBs referenced by the pairs.
+		 * \param pairs The pairs to test. Both indices must be lower than batch.size().
+		 * \param collisions Resized to pairs.size(). collisions[i] receives the collision between the
+		 * 		  AABBs of the i-th pair, as computed by aabb_collision_info(batch.at(first), batch.at(second)).
+		 * \return The number of colliding pairs.
+		 */
+		size_t aabb_collision_batch(const AABBBatch& batch, const std::vector<AABBIndexPair>& pairs, std::vector<AABBCollision>& collisions);
+
+		/**
+		 * \brief Tests one AABB against every OBB of a batch.
+		 *
+		 * This is the batched equivalent of obb_intersects(const OBB&, const AABB&). The boxes are
+		 * projected on their 4 axes using the cosines and sines stored in the batch.
+		 *
+		 * \param aabb The AABB tested against the batch.
+		 * \param batch The OBBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the AABB intersects the i-th OBB of the batch, 0 otherwise.
+		 * \return The number of intersecting OBBs.
+		 */
+		size_t obb_intersects_batch(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one circle against every OBB of a batch.
+		 *
+		 * This is the batched equivalent of obb_intersects(const OBB&, const Circle&).
+		 *
+		 * \param circle The circle tested against the batch.
+		 * \param batch The OBBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the circle intersects the i-th OBB of the batch, 0 otherwise.
+		 * \return The number of intersecting OBBs.
+		 */
+		size_t obb_intersects_batch(const Circle& circle, const OBBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one capsule against every AABB of a batch.
+		 *
+		 * This is the batched equivalent of capsule_intersects(const Capsule&, const AABB&), meant to
+		 * test a character against the level geometry.
+		 *
+		 * \param capsule The capsule tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the capsule intersects the i-th AABB of the batch, 0 otherwise.
+		 * \return The number of intersecting AABBs.
+		 */
+		size_t capsule_aabb_intersects_batch(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests every pair of AABBs (first[i], other[i]) of two batches of the same size.
+		 *
+		 * Unlike the functions above, which test one shape against a whole batch, the pairwise
+		 * functions test the i-th element of a batch against the i-th element of the other batch.
+		 * They are meant to process the candidate pairs of a broadphase once gathered by shape type
+		 * (see ShapePairDispatcher). The AVX-512 tier uses the AVX2 kernels.
+		 *
+		 * \param results Output array of at least first.size() elements. results[i] is set to 1
+		 * 		  if first[i] and other[i] intersect (see aabb_intersects()), 0 otherwise.
+		 * \throws std::invalid_argument If the batches don't have the same size.
+		 * \return The number of intersecting pairs.
+		 */
+		size_t aabb_intersects_pairwise(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs of circles (see circle_intersects(const Circle&, const Circle&)). */
+		size_t circle_intersects_pairwise(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs (aabbs[i], circles[i]) (see aabb_intersects(const AABB&, const Circle&)). */
+		size_t aabb_circle_intersects_pairwise(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs of segments (see line_segments_intersect_batch()). */
+		size_t line_segments_intersect_pairwise(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs (aabbs[i], segments[i]) (see aabb_intersects(const AABB&, const LineSegment&)). */
+		size_t aabb_segment_intersects_pairwise(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs (circles[i], segments[i]) (see circle_intersects(const Circle&, const LineSegment&)). */
+		size_t circle_segment_intersects_pairwise(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results);
+
+		/**
+		 * \brief Finds the first segment of a batch hit by a moving circle.
+		 *
+		 * This is the batched equivalent of circle_sweep(). The circle moves from circle.pos
+		 * to circle.pos + motion. The AVX-512 tier uses the AVX2 kernel.
+		 *
+		 * \param hit Receives the index of the segment, the time of impact, the normal and the contact point.
+		 * \return True if a segment was hit, false otherwise (hit is left untouched).
+		 */
+		bool circle_sweep_batch(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, CircleSweepHit& hit);
+	}
+}
+
+namespace ch {
+	namespace collision {
+
+		/**
+		 * \brief Support mapping of an AABB : the corner of the AABB that is the farthest in the given direction.
+		 */
+		vec_t support_point(const AABB& aabb, const vec_t& direction);
+
+		/** \brief Same as support_point(const AABB&, const vec_t&), for bounds. */
+		vec_t support_point(const Bounds& bounds, const vec_t& direction);
+
+		/** \brief Support mapping of a circle : the point of the circle that is the farthest in the given direction. */
+		vec_t support_point(const Circle& circle, const vec_t& direction);
+
+		/** \brief Support mapping of a line segment : the extremity that is the farthest in the given direction. */
+		vec_t support_point(const LineSegment& segment, const vec_t& direction);
+
+		/** \brief Support mapping of a convex polygon : the vertex that is the farthest in the given direction. */
+		vec_t support_point(const ConvexPolygon& polygon, const vec_t& direction);
+
+		/** \brief Support mapping of an OBB : the corner of the OBB that is the farthest in the given direction. */
+		vec_t support_point(const OBB& obb, const vec_t& direction);
+
+		/** \brief Support mapping of a capsule : the point of the capsule that is the farthest in the given direction. */
+		vec_t support_point(const Capsule& capsule, const vec_t& direction);
+
+		/**
+		 * \brief Computes the distance between two convex shapes with the GJK algorithm.
+		 *
+		 * GJK searches the point of the Minkowski difference of the shapes closest to the origin,
+		 * using only the support mappings of the shapes, so any pair of convex shapes can be tested
+		 * with the same function. Use the shape specific functions (see collision_functions.h) when
+		 * they exist, as they are faster.
+		 *
+		 * \param cache Optional simplex cache of the pair. If it isn't empty, the search starts from
+		 * 		  the simplex of the previous call. It receives the final simplex.
+		 * \return A GJKResult containing the distance and the closest points.
+		 */
+		GJKResult gjk_distance(const SupportShape& first, const SupportShape& other, GJKCache* cache = nullptr);
+
+		/**
+		 * \return True if the shapes overlap (see gjk_distance()).
+		 */
+		bool gjk_intersects(const SupportShape& first, const SupportShape& other, GJKCache* cache = nullptr);
+
+		/**
+		 * \brief Computes the collision between two convex shapes with the GJK and EPA algorithms.
+		 *
+		 * In case of a collision, this function returns an instance of ConvexCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 *
+		 * If only the radii of the shapes overlap, the normal goes from the core of the first shape to the core of
+		 * the other one. If the cores overlap, the expanding polytope algorithm (EPA) finds the shortest way out of
+		 * the Minkowski difference of the cores.
+		 *
+		 * \param cache Optional simplex cache of the pair (see gjk_distance()).
+		 * \return A ConvexCollision containing information about the collision.
+		 */
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, GJKCache* cache = nullptr);
+
+		/**
+		 * \brief Checks if an axis separates two convex shapes.
+		 *
+		 * Only needs one support point per shape, which makes it a cheap early out when the axis
+		 * separated the shapes on the previous tick (see PairContact::separatingAxis).
+		 *
+		 * \param axis The axis, pointing from the first shape towards the other one. It doesn't need to be normalized.
+		 * \return True if the shapes are separated (or touching) along the axis, false otherwise.
+		 */
+		bool separated_along_axis(const SupportShape& first, const SupportShape& other, const vec_t& axis);
+
+		/**
+		 * \brief Same as gjk_collision_info(const SupportShape&, const SupportShape&, GJKCache*), starting from the data of the previous tick.
+		 *
+		 * If the separating axis of the contact still separates the shapes, the function returns
+		 * without running GJK. Otherwise GJK starts from the simplex of the contact. The separating
+		 * axis and the simplex of the contact are updated for the next tick, the normal and the
+		 * depth are left to PairCache::setContact().
+		 *
+		 * \param contact The contact of the pair, as returned by PairCache::get(). The first shape
+		 * 		  must be the shape of handle contact.first.
+		 * \return A ConvexCollision containing information about the collision.
+		 */
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, PairContact& contact);
+	}
+}
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Tests lists of candidate pairs that mix AABBs, circles and line segments.
+	 *
+	 * Testing a mixed list one pair at a time means switching on the types of every pair,
+	 * which prevents any vectorization. Instead, the dispatcher sorts the pairs by type
+	 * combination (AABB-AABB, AABB-circle, AABB-segment, circle-circle, circle-segment and
+	 * segment-segment) with a counting sort, gathers the shapes of each combination into
+	 * contiguous batches and tests them with the pairwise batched functions (see
+	 * collision::aabb_intersects_pairwise()). The results are then scattered back in the
+	 * order of the pairs.
+	 *
+	 * All the intermediate buffers are kept between calls : once they have grown to the
+	 * size of the largest list, testing a list doesn't allocate any memory. Keep one
+	 * dispatcher per thread.
+	 */
+	class ShapePairDispatcher {
+
+	public:
+
+		static constexpr size_t COMBINATION_COUNT = 6; /**< Number of unordered pairs of shape types. */
+
+	public:
+
+		/**
+		 * \brief Constructs a dispatcher with empty buffers.
+		 */
+		ShapePairDispatcher();
+
+		/**
+		 * \brief Tests every pair of the list.
+		 *
+		 * The shapes referenced by the pairs are read from the batch matching their type. A pair
+		 * gives the same result as the scalar function of its types, whatever the order of its shapes.
+		 *
+		 * \param aabbs The AABBs referenced by the pairs.
+		 * \param circles The circles referenced by the pairs.
+		 * \param segments The segments referenced by the pairs.
+		 * \param pairs The pairs to test. Every index must be lower than the size of its batch.
+		 * \param results Resized to pairs.size(). results[i] is set to 1 if the shapes of the i-th pair intersect, 0 otherwise.
+		 * \return The number of intersecting pairs.
+		 */
+		size_t intersects(const AABBBatch& aabbs, const CircleBatch& circles, const LineSegmentBatch& segments, const std::vector<ShapePair>& pairs, std::vector<std::uint8_t>& results);
+
+		/**
+		 * \return The number of pairs of the given types (in any order) in the last list tested.
+		 */
+		size_t combinationSize(ShapeType first, ShapeType other) const;
+
+	private:
+
+		std::array<std::uint32_t, COMBINATION_COUNT + 1> combinationStarts_; /**< Start of each combination in order_, followed by the number of pairs. */
+		std::vector<std::uint32_t> order_; /**< Index of each pair in the list, sorted by combination. */
+		std::vector<std::uint32_t> firstIndices_; /**< Index of the shape of lowest type of each pair, in the order of order_. */
+		std::vector<std::uint32_t> otherIndices_; /**< Index of the other shape of each pair, in the order of order_. */
+		std::vector<std::uint8_t> sortedResults_; /**< Results of the pairs, in the order of order_. */
+		std::array<AABBBatch, 2> aabbs_; /**< AABBs of the combination being tested, gathered from the pairs. */
+		std::array<CircleBatch, 2> circles_; /**< Circles of the combination being tested. */
+		std::array<LineSegmentBatch, 2> segments_; /**< Segments of the combination being tested. */
+	};
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Remembers the contacts of the pairs of shapes from one tick to the next.
+	 *
+	 * Most of the pairs reported by a broadphase on a tick were already reported on the
+	 * previous one. The cache stores, for each pair of handles, the last contact, the last
+	 * separating axis and the simplex of the last GJK query, so that the narrowphase can start
+	 * from them (see collision::gjk_collision_info(const SupportShape&, const SupportShape&, PairContact&)).
+	 * It also tracks the contact state of the pairs to report when contacts begin and end.
+	 *
+	 * The pairs are stored in an open addressing hash table (linear probing) keyed by the two
+	 * handles. The order of the handles doesn't matter : (a, b) and (b, a) are the same pair.
+	 *
+	 * Usage, once per tick :
+	 * - newFrame()
+	 * - for each pair of the broadphase : get(), narrowphase, setContact() if the shapes touch
+	 * - endFrame(), which reports the events and forgets the pairs that weren't reported
+	 */
+	class PairCache {
+
+	public:
+
+		/**
+		 * \brief Constructs an empty cache.
+		 * \param capacity Number of pairs the cache can store before growing.
+		 */
+		PairCache(size_t capacity = 64);
+
+		/**
+		 * \brief Starts a new frame (tick).
+		 */
+		void newFrame();
+
+		/**
+		 * \brief Returns the contact of the given pair, inserting it if the pair is new.
+		 *
+		 * Marks the pair as reported during the current frame. The returned reference is
+		 * invalidated by the next call to get() or endFrame().
+		 *
+		 * \throws std::invalid_argument If both handles are the same.
+		 */
+		PairContact& get(std::uint32_t first, std::uint32_t other);
+
+		/**
+		 * \return The contact of the given pair, nullptr if the pair isn't in the cache.
+		 */
+		const PairContact* find(std::uint32_t first, std::uint32_t other) const;
+
+		/**
+		 * \brief Records that the shapes of the pair touch during the current frame.
+		 *
+		 * Does nothing if the normal is NULL_VEC (no collision), so the result of a collision
+		 * function can be given directly.
+		 */
+		void setContact(PairContact& contact, const vec_t& normal, float depth);
+
+		/**
+		 * \brief Ends the current frame.
+		 *
+		 * Updates the contact state of the pairs and forgets the pairs that weren't reported
+		 * during the frame.
+		 *
+		 * \param events Cleared, then filled with the contacts that began or ended during the frame.
+		 */
+		void endFrame(std::vector<ContactEvent>& events);
+
+		/**
+		 * \brief Forgets every pair, without reporting any event.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of pairs in the cache.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return The current frame, starting at 1.
+		 */
+		std::uint32_t frame() const;
+
+	private:
+
+		/**
+		 * \return The slot of the given key, or the empty slot where it would be inserted.
+		 */
+		size_t findSlot(std::uint64_t key) const;
+
+		/**
+		 * \brief Doubles the number of slots and reinserts every pair.
+		 */
+		void grow();
+
+		/**
+		 * \brief Removes the pair of the given slot, shifting back the pairs that follow it.
+		 */
+		void erase(size_t slot);
+
+		std::vector<std::uint64_t> keys_; /**< Key of each slot, PAIR_CACHE_EMPTY_KEY if the slot is empty. */
+		std::vector<PairContact> contacts_; /**< Contact of each slot. */
+		size_t size_; /**< Number of pairs in the cache. */
+		std::uint32_t frame_; /**< Current frame. */
+	};
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Puts the bodies at rest to sleep, so that they can be skipped by the broadphase and the narrowphase.
+	 *
+	 * The manager tracks the motion of each body : a body rests while its speed and the distance
+	 * it moves during a tick are below the thresholds. The bodies touching each other (directly or
+	 * through other bodies) form an island, built from the contacts of the tick with a union-find.
+	 * An island falls asleep once all its bodies have rested for timeToSleep seconds, and wakes up
+	 * as a whole as soon as one of its bodies is touched by an awake body, moved or woken.
+	 *
+	 * Static bodies (walls, floors...) never sleep and don't link the islands : two crates resting
+	 * on the same floor are in different islands.
+	 *
+	 * Usage, once per tick :
+	 * - broadphase over awakeBodies() (the sleeping bodies keep their place in the broadphase)
+	 * - narrowphase of the pairs for which needsCollision() is true, addContact() for the pairs that touch
+	 * - integration of the awake bodies, setMotion() with their new position and velocity
+	 * - step()
+	 */
+	class SleepManager {
+
+	public:
+
+		/**
+		 * \brief Constructs a manager without any body.
+		 * \param velocityThreshold Speed below which a body rests.
+		 * \param displacementThreshold Distance below which a body rests, between two steps.
+		 * \param timeToSleep Time (in seconds) all the bodies of an island must rest before the island falls asleep.
+		 */
+		SleepManager(float velocityThreshold = 0.05f, float displacementThreshold = 0.01f, float timeToSleep = 0.5f);
+
+		/**
+		 * \brief Adds an awake body.
+		 * \return The identifier of the body. The identifiers of removed bodies are reused.
+		 */
+		std::uint32_t add(const vec_t& position, bool isStatic = false);
+
+		/**
+		 * \brief Removes a body, waking up its island.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		void remove(std::uint32_t body);
+
+		/**
+		 * \brief Gives the position and velocity of a body after the integration of the tick.
+		 *
+		 * A sleeping body whose position is moved further than the displacement threshold from
+		 * where it fell asleep (a teleport for example) wakes up its island.
+		 *
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		void setMotion(std::uint32_t body, const vec_t& position, const vec_t& velocity);
+
+		/**
+		 * \brief Records that two bodies touch during the current tick.
+		 *
+		 * A sleeping body touched by an awake body that isn't static wakes up its island.
+		 *
+		 * \throws std::invalid_argument If one of the bodies doesn't exist.
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other);
+
+		/**
+		 * \brief Wakes up the island of a body. Does nothing for a static or awake body.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		void wake(std::uint32_t body);
+
+		/**
+		 * \brief Ends the current tick.
+		 *
+		 * Updates the rest time of the awake bodies, builds the islands from the contacts of
+		 * the tick and puts to sleep the islands whose bodies all rested long enough. Then
+		 * forgets the contacts.
+		 *
+		 * \param dt Duration of the tick, in seconds.
+		 */
+		void step(float dt);
+
+		/**
+		 * \return true if the body is awake. Static bodies are never awake.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		bool isAwake(std::uint32_t body) const;
+
+		/**
+		 * \return true if the body is static.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		bool isStatic(std::uint32_t body) const;
+
+		/**
+		 * \return true if the narrowphase must test the pair, which is when at least one of the bodies is awake.
+		 * \throws std::invalid_argument If one of the bodies doesn't exist.
+		 */
+		bool needsCollision(std::uint32_t first, std::uint32_t other) const;
+
+		/**
+		 * \return The awake bodies after the last step() (or add()), sorted by identifier.
+		 * Only these bodies must be updated in the broadphase and integrated.
+		 */
+		const std::vector<std::uint32_t>& awakeBodies() const;
+
+		/**
+		 * \return The number of islands of awake bodies built by the last step(), including the ones that fell asleep.
+		 */
+		size_t islandCount() const;
+
+		/**
+		 * \return The number of bodies, static bodies included.
+		 */
+		size_t size() const;
+
+	private:
+
+		/**
+		 * \brief State of a body.
+		 */
+		enum class BodyState : std::uint8_t {
+			Awake,
+			Sleeping,
+			Static,
+			Removed,
+			MAX_VALUE
+		};
+
+		/**
+		 * \brief Throws if the body doesn't exist.
+		 */
+		void checkBody(std::uint32_t body) const;
+
+		/**
+		 * \return The root of the island of the body, halving the path to it.
+		 */
+		std::uint32_t findRoot(std::uint32_t body);
+
+		/**
+		 * \brief Merges the islands of two bodies (union by size).
+		 */
+		void unite(std::uint32_t first, std::uint32_t other);
+
+		/**
+		 * \brief Wakes up every body of the sleeping island of the given body.
+		 */
+		void wakeIsland(std::uint32_t body);
+
+		/**
+		 * \brief Removes the bodies that fell asleep from the list of the awake bodies.
+		 */
+		void updateAwakeBodies();
+
+		float velocityThreshold_; /**< Speed below which a body rests. */
+		float displacementThreshold_; /**< Distance below which a body rests, between two steps. */
+		float timeToSleep_; /**< Time the bodies of an island must rest before the island falls asleep. */
+
+		std::vector<BodyState> states_; /**< State of each body. */
+		std::vector<vec_t> positions_; /**< Position of each body given to setMotion(). */
+		std::vector<vec_t> previousPositions_; /**< Position of each body during the previous step(), or where it fell asleep. */
+		std::vector<vec_t> velocities_; /**< Velocity of each body given to setMotion(). */
+		std::vector<float> restTimes_; /**< Time each body has been resting. */
+		std::vector<std::uint32_t> nextInIsland_; /**< Next body of the island of each body (circular list). */
+		std::vector<std::uint32_t> parents_; /**< Parent of each body in the union-find. */
+		std::vector<std::uint32_t> islandSizes_; /**< Number of bodies of the island of each root in the union-find. */
+		std::vector<float> islandRestTimes_; /**< Shortest rest time of the bodies of the island of each root. */
+		std::vector<std::uint32_t> contacts_; /**< Pairs of awake bodies that touch during the current tick, two identifiers per pair. */
+		std::vector<std::uint32_t> awakeBodies_; /**< Awake bodies, sorted by identifier. */
+		std::vector<std::uint32_t> freeBodies_; /**< Identifiers of the bodies removed before the last step(). */
+		std::vector<std::uint32_t> removedBodies_; /**< Identifiers of the bodies removed since the last step(). */
+		size_t islandCount_; /**< Number of islands built by the last step(). */
+		size_t size_; /**< Number of bodies. */
+	};
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	struct ContactSolverBarrier;
+
+	/**
+	 * \brief Resolves the contacts between bodies with impulses (sequential impulses).
+	 *
+	 * Instead of pushing the colliding bodies apart, the solver changes their velocities so
+	 * that they stop approaching each other (with restitution and friction), then corrects the
+	 * remaining penetration with a few position iterations. The bodies only translate : the
+	 * collision structs don't give a contact point, so no angular velocity is involved.
+	 *
+	 * The contacts are stored in arrays (one array per field) and colored so that two contacts of
+	 * the same color never share a dynamic body : the contacts of a color are independent and are
+	 * solved in parallel, the colors one after the other. The threads are started once per solve()
+	 * and wait for each other between the colors. The result doesn't depend on the number of threads.
+	 *
+	 * The impulses of the previous tick are used as the starting point of the pairs that are
+	 * still touching (warm starting), which makes stacks of bodies converge in few iterations.
+	 *
+	 * Usage, once per tick :
+	 * - newFrame()
+	 * - addContact() for every pair of colliding bodies (see collision::aabb_collision_info() for example)
+	 * - external forces added to the velocities, then solve()
+	 */
+	class ContactSolver {
+
+	public:
 
-		/** \returns True if the Circle and the AABB intersect, false otherwise. */
-		bool circle_intersects(const Circle& circle, const AABB& aabb);
+		/**
+		 * \brief Constructs a solver without any contact.
+		 * \param velocityIterations Number of passes over the contacts to solve the velocities.
+		 * \param positionIterations Number of passes over the contacts to correct the penetration.
+		 * \param slop Penetration that is allowed and left uncorrected, which prevents resting contacts from jittering.
+		 * \param restitutionThreshold Approach speed under which the contacts don't bounce.
+		 * \param threadCount Maximum number of threads to use. 0 means default_thread_count().
+		 */
+		ContactSolver(unsigned int velocityIterations = 8, unsigned int positionIterations = 3, float slop = 0.01f, float restitutionThreshold = 1.f, unsigned int threadCount = 1);
 
-		/** \returns The distance separating two circles (negative if overlapping) */
-		float circles_distance(const Circle& a, const Circle& b);
+		/**
+		 * \brief Starts a new tick : forgets the contacts and keeps their impulses for warm starting.
+		 */
+		void newFrame();
 
 		/**
-		 * \brief Checks if the first AABB collides with the other one.
+		 * \brief Adds a contact between two bodies. Does nothing if the normal is NULL_VEC (no collision).
 		 *
-		 * In case of a collision, this function returns an instance of AABBCollision containing the collision normal and the delta (overlap).
-		 * The collision normal is the direction (a unit vector) towards which the other AABB needs to be pushed in order to resolve the collision.
-		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 * \param first Index of the first body.
+		 * \param other Index of the other body, the one pushed along the normal.
+		 * \param normal Normal of the collision, unit vector.
+		 * \param depth Penetration depth of the collision (positive).
+		 * \param restitution Bounciness of the contact (0 : no bounce, 1 : elastic).
+		 * \param friction Coefficient of friction of the contact.
+		 * \throws std::invalid_argument If both bodies are the same.
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other, const vec_t& normal, float depth, float restitution, float friction);
+
+		/**
+		 * \brief Same as addContact(std::uint32_t, std::uint32_t, const vec_t&, float, float, float), from the result of collision::aabb_collision_info(first, other).
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other, const AABBCollision& collision, float restitution, float friction);
+
+		/**
+		 * \brief Same as addContact(std::uint32_t, std::uint32_t, const vec_t&, float, float, float), from the result of collision::circles_collision_info(first, other).
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other, const CirclesCollision& collision, float restitution, float friction);
+
+		/**
+		 * \brief Same as addContact(std::uint32_t, std::uint32_t, const vec_t&, float, float, float), from the result of collision::circle_aabb_collision_info(aabb, circle).
+		 * \param aabb Index of the body of the AABB.
+		 * \param circle Index of the body of the circle.
+		 */
+		void addContact(std::uint32_t aabb, std::uint32_t circle, const CircleAABBCollision& collision, float restitution, float friction);
+
+		/**
+		 * \brief Solves the contacts of the tick and moves the bodies.
 		 *
-		 * \returns An AABBCollision containing information about the collision.
+		 * The positions of every body are integrated with their velocities, including the bodies
+		 * without any contact.
+		 *
+		 * \param positions Position of each body, indexed by the identifiers given to addContact().
+		 * \param velocities Velocity of each body, including the external forces (gravity...) of the tick.
+		 * \param inverseMasses Inverse of the mass of each body. 0 for static bodies, which are never moved by the contacts.
+		 * \param dt Duration of the tick, in seconds.
+		 * \throws std::invalid_argument If the arrays don't have the same size or if a contact references a body out of them.
 		 */
-		AABBCollision aabb_collision_info(const AABB& first, const AABB& other);
+		void solve(std::vector<vec_t>& positions, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses, float dt);
 
 		/**
-		 * \brief Checks if the first circle collides with the other one.
+		 * \return The number of contacts of the tick.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return The number of colors used by the last solve().
+		 */
+		size_t colorCount() const;
+
+		/**
+		 * \return The impulse applied along the normal of a contact by the last solve(), in the order the contacts were added.
+		 * \throws std::out_of_range If the contact doesn't exist.
+		 */
+		float normalImpulse(size_t contact) const;
+
+		/**
+		 * \return The friction impulse applied to a contact by the last solve(), in the order the contacts were added.
+		 * \throws std::out_of_range If the contact doesn't exist.
+		 */
+		float tangentImpulse(size_t contact) const;
+
+	private:
+
+		/**
+		 * \brief Computes the masses and biases of the contacts and applies the impulses of the previous tick.
+		 */
+		void prepare(std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses);
+
+		/**
+		 * \brief Assigns a color to every contact and sorts the contacts by color.
+		 */
+		void color(const std::vector<float>& inverseMasses);
+
+		/**
+		 * \brief Calls the function on the part of every color given to a thread of solve(), color after color.
 		 *
-		 * In case of a collision, this function returns an instance of CirclesCollision containing the collision normal and the penetration depth.
-		 * The collision normal is the direction (a unit vector) towards which the other circle needs to be pushed in order to resolve the collision.
-		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 * Every thread of the barrier must call it : they wait for each other at the end of each color.
 		 *
-		 * \returns A CirclesCollision object containing information about the collision.
+		 * \param thread Index of the calling thread, between 0 and the number of threads of the barrier - 1.
 		 */
-		CirclesCollision circles_collision_info(const Circle& first, const Circle& other);
+		template<typename Function>
+		void forEachColor(size_t thread, ContactSolverBarrier& barrier, const Function& function) const;
 
 		/**
-		 * \brief Checks if an AABB and a circle collide with each other.
+		 * \brief Applies the friction and normal impulses that stop the bodies of a contact from approaching each other.
+		 */
+		void solveVelocity(size_t contact, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses);
+
+		/**
+		 * \brief Moves the bodies of a contact to correct part of their remaining penetration.
+		 */
+		void solvePosition(size_t contact, std::vector<vec_t>& positions, const std::vector<float>& inverseMasses);
+
+		unsigned int velocityIterations_; /**< Number of passes over the contacts to solve the velocities. */
+		unsigned int positionIterations_; /**< Number of passes over the contacts to correct the penetration. */
+		float slop_; /**< Penetration left uncorrected. */
+		float restitutionThreshold_; /**< Approach speed under which the contacts don't bounce. */
+		unsigned int threadCount_; /**< Maximum number of threads to use. */
+
+		std::vector<std::uint32_t> firsts_; /**< First body of each contact. */
+		std::vector<std::uint32_t> others_; /**< Other body of each contact, pushed along the normal. */
+		std::vector<vec_t> normals_; /**< Normal of each contact. */
+		std::vector<float> depths_; /**< Penetration depth of each contact at the beginning of the tick. */
+		std::vector<float> restitutions_; /**< Restitution of each contact. */
+		std::vector<float> frictions_; /**< Coefficient of friction of each contact. */
+		std::vector<float> masses_; /**< Effective mass of each contact (the inverse of the sum of the inverse masses of its bodies). */
+		std::vector<float> velocityBiases_; /**< Normal speed each contact must reach, to bounce. */
+		std::vector<float> normalImpulses_; /**< Accumulated normal impulse of each contact. */
+		std::vector<float> tangentImpulses_; /**< Accumulated friction impulse of each contact. */
+
+		std::vector<std::uint32_t> order_; /**< Contacts sorted by color. */
+		std::vector<size_t> colorStarts_; /**< Index in order_ of the first contact of each color, plus the total count. */
+		std::vector<std::uint64_t> bodyColors_; /**< Colors already used by the contacts of each body, one bit per color. */
+		std::vector<vec_t> startPositions_; /**< Positions of the bodies at the beginning of solve(). */
+
+		std::vector<std::uint64_t> warmKeys_; /**< Sorted keys of the pairs of the previous tick. */
+		std::vector<vec_t> warmNormals_; /**< Normal of each pair of the previous tick. */
+		std::vector<float> warmNormalImpulses_; /**< Normal impulse of each pair of the previous tick. */
+		std::vector<float> warmTangentImpulses_; /**< Friction impulse of each pair of the previous tick. */
+	};
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	//! Contains spatial sorting and partitioning utils (Morton codes, bounding volume hierarchies)
+	namespace spatial {
+
+		/**
+		 * \brief Interleaves the bits of two 16-bit coordinates into a 32-bit Morton code (Z-order).
 		 *
-		 * In case of a collision, this function returns an instance of CircleAABBCollision containing the collision normal and the penetration depth.
-		 * The collision normal is the direction (a unit vector) towards which the *circle* needs to be pushed in order to resolve the collision.
-		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 * The bits of x occupy the even positions and the bits of y the odd positions. Points
+		 * that are close to each other in 2D tend to have close Morton codes.
 		 *
-		 * \returns A CircleAABBCollision object containing information about the collision.
+		 * \param x Quantized X coordinate (only the 16 lowest bits are used).
+		 * \param y Quantized Y coordinate (only the 16 lowest bits are used).
+		 * \return The Morton code of the coordinates.
 		 */
-		CircleAABBCollision circle_aabb_collision_info(const AABB& aabb, const Circle& circle);
+		std::uint32_t morton_encode(std::uint32_t x, std::uint32_t y);
 
 		/**
-		 * \brief Checks if the given line segments are intersecting.
+		 * \brief Computes the Morton code of a point located inside the given world bounds.
 		 *
-		 * This methods generates a SegmentsIntersection instance representing the
-		 * state of intersection between the 2 segments.
+		 * The point is quantized on a 65536 x 65536 grid covering the world bounds. Points
+		 * outside of the bounds are clamped to the closest border.
 		 *
-		 * \note See the SegmentsIntersection class to learn how to interpret the
-		 *  	 result of this method.
-		 * 
-		 * \return A SegmentsIntersection giving information about the intersection.
+		 * \return The Morton code of the point.
 		 */
-		SegmentsIntersection line_segments_intersection_info(const LineSegment& first, const LineSegment& other);
+		std::uint32_t morton_code(const vec_t& point, const AABB& worldBounds);
+
+		/**
+		 * \return The Morton code of the center of every AABB.
+		 */
+		std::vector<std::uint32_t> morton_codes(const std::vector<AABB>& aabbs, const AABB& worldBounds);
+
+		/**
+		 * \return The Morton code of the center of every circle.
+		 */
+		std::vector<std::uint32_t> morton_codes(const std::vector<Circle>& circles, const AABB& worldBounds);
+
+		/**
+		 * \brief Sorts keys in ascending order and moves the associated values along with them.
+		 *
+		 * This is a stable least-significant-digit radix sort (8 bits per pass). Each pass is
+		 * split between several threads. Passes on digits that are equal for every key are skipped.
+		 *
+		 * \param keys The keys to sort.
+		 * \param values The values associated to each key (same size as keys).
+		 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+		 */
+		void radix_sort(std::vector<std::uint32_t>& keys, std::vector<std::uint32_t>& values, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Computes the order in which the AABBs should be stored to follow the Z-order curve.
+		 *
+		 * \return A permutation : the i-th element of the sorted array is aabbs[permutation[i]].
+		 */
+		std::vector<std::uint32_t> morton_order(const std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Computes the order in which the circles should be stored to follow the Z-order curve.
+		 *
+		 * \return A permutation : the i-th element of the sorted array is circles[permutation[i]].
+		 */
+		std::vector<std::uint32_t> morton_order(const std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Reorders an array according to a permutation.
+		 *
+		 * After the call, values[i] contains what was previously stored at values[permutation[i]].
+		 * Use it to reorder the arrays that are associated with a shape array (entity ids, velocities, etc...).
+		 */
+		template <typename T>
+		void apply_permutation(std::vector<T>& values, const std::vector<std::uint32_t>& permutation) {
+			std::vector<T> reordered;
+			reordered.reserve(permutation.size());
+			for (auto index : permutation) {
+				reordered.push_back(values[index]);
+			}
+			values.swap(reordered);
+		}
+
+		/**
+		 * \brief Sorts the AABBs along the Z-order curve so that boxes that are close in space are also close in memory.
+		 *
+		 * \return The permutation that was applied (see apply_permutation()).
+		 */
+		std::vector<std::uint32_t> morton_sort(std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Sorts the circles along the Z-order curve so that circles that are close in space are also close in memory.
+		 *
+		 * \return The permutation that was applied (see apply_permutation()).
+		 */
+		std::vector<std::uint32_t> morton_sort(std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount = 0);
+	}
+}
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief A node of a LBVH, stored in a flat array.
+		 *
+		 * The hierarchy is traversed without a stack : when a node is rejected (or when a leaf
+		 * has been processed), the traversal jumps to the escape node, which is the next node
+		 * to visit once the subtree of the current node is done.
+		 */
+		struct LBVHNode {
+			float minX; /**< Left side of the bounds of the node. */
+			float minY; /**< Top side of the bounds of the node. */
+			float maxX; /**< Right side of the bounds of the node. */
+			float maxY; /**< Bottom side of the bounds of the node. */
+			std::uint32_t child; /**< Internal node : index of the left child. Leaf : index of the AABB in the array given to LBVH::build(). */
+			std::uint32_t escape; /**< Index of the node to visit after this subtree, LBVH::INVALID_INDEX at the end of the traversal. */
+		};
+
+		/**
+		 * \brief Linear bounding volume hierarchy over AABBs.
+		 *
+		 * The hierarchy is built from the Morton codes of the AABBs (see morton_functions.h)
+		 * following the method described by Tero Karras in "Maximizing Parallelism in the
+		 * Construction of BVHs, Octrees, and k-d Trees". Every step of the build is split
+		 * between several threads, and the internal buffers are reused between builds, so the
+		 * whole hierarchy can be rebuilt from scratch every tick instead of being refitted.
+		 *
+		 * The nodes are stored in a flat array : the n - 1 internal nodes come first (the root
+		 * is node 0), followed by the n leaves.
+		 */
+		class LBVH {
+
+		public:
+
+			static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFF; /**< Marks the absence of a node. */
+
+		public:
+
+			/**
+			 * \brief Constructs an empty hierarchy.
+			 */
+			LBVH();
+
+			/**
+			 * \brief Rebuilds the hierarchy from the given AABBs.
+			 *
+			 * The query functions return indices in this array.
+			 *
+			 * \param aabbs The AABBs to store in the hierarchy.
+			 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+			 */
+			void build(const std::vector<AABB>& aabbs, unsigned int threadCount = 0);
+
+			/**
+			 * \brief Rebuilds the hierarchy from the given bounds.
+			 *
+			 * Same as build(const std::vector<AABB>&, unsigned int), without converting the AABBs first.
+			 */
+			void build(const std::vector<Bounds>& bounds, unsigned int threadCount = 0);
+
+			/**
+			 * \brief Finds the AABBs that intersect the given AABB (see collision::aabb_intersects()).
+			 * \param results Cleared, then filled with the indices of the intersecting AABBs.
+			 */
+			void query(const AABB& aabb, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the AABBs that intersect the given bounds.
+			 * \param results Cleared, then filled with the indices of the intersecting AABBs.
+			 */
+			void query(const Bounds& bounds, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the AABBs that intersect the given circle.
+			 * \param results Cleared, then filled with the indices of the intersecting AABBs.
+			 */
+			void query(const Circle& circle, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the AABBs crossed by the given segment.
+			 * \param results Cleared, then filled with the indices of the crossed AABBs.
+			 */
+			void query(const LineSegment& segment, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the first AABB hit by a ray going from ray.start to ray.end.
+			 *
+			 * \param hit Receives the index of the AABB and the position where the ray enters it.
+			 * 		  A ray starting inside an AABB hits it at t = 0.
+			 * \return True if an AABB was hit, false otherwise (hit is left untouched).
+			 */
+			bool raycast(const LineSegment& ray, RaycastHit& hit) const;
+
+			/**
+			 * \return The nodes of the hierarchy. Empty if the hierarchy was built from an empty array.
+			 */
+			const std::vector<LBVHNode>& nodes() const;
+
+			/**
+			 * \return The number of AABBs stored in the hierarchy.
+			 */
+			size_t size() const;
+
+		private:
+
+			/**
+			 * \brief Builds the internal node at the given index (Karras' algorithm).
+			 */
+			void buildInternalNode(std::int64_t index);
+
+			/**
+			 * \brief Computes the bounds of the parents of the given leaf, up to the root.
+			 */
+			void propagateBounds(std::uint32_t leaf);
+
+			/**
+			 * \brief Length of the common prefix of the keys i and j (-1 if j is out of range).
+			 */
+			int commonPrefix(std::int64_t i, std::int64_t j) const;
+
+			std::vector<LBVHNode> nodes_; /**< Internal nodes followed by the leaves. */
+			std::vector<Bounds> bounds_; /**< Bounds of the AABBs given to build(), reused between builds. */
+			std::vector<std::uint32_t> codes_; /**< Sorted Morton codes of the leaves. */
+			std::vector<std::uint32_t> order_; /**< Index of the AABB stored in each leaf. */
+			std::vector<std::uint32_t> parents_; /**< Parent of each node. */
+			std::vector<std::uint32_t> rangeFirst_; /**< First leaf covered by each internal node. */
+			std::vector<std::uint32_t> rangeLast_; /**< Last leaf covered by each internal node. */
+			std::vector<std::atomic<std::uint32_t>> visits_; /**< Number of children whose bounds are known, per internal node. */
+		};
+	}
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief A node of a SegmentBVH (32 bytes), stored in a flat array in depth-first order.
+		 *
+		 * The left child of an internal node is always the node that follows it in the array.
+		 */
+		struct SegmentBVHNode {
+			float minX; /**< Left side of the bounds of the node. */
+			float minY; /**< Top side of the bounds of the node. */
+			float maxX; /**< Right side of the bounds of the node. */
+			float maxY; /**< Bottom side of the bounds of the node. */
+			std::uint32_t firstOrRight; /**< Internal node : index of the right child. Leaf : index of the first segment of the leaf. */
+			std::uint32_t count; /**< Number of segments in the leaf, 0 for an internal node. */
+			std::uint32_t axis; /**< Axis along which the children were split (0 for X, 1 for Y). */
+			std::uint32_t escape; /**< Index of the node to visit after this subtree, SegmentBVH::INVALID_INDEX at the end of the traversal. */
+		};
+
+		/**
+		 * \brief Static bounding volume hierarchy over line segments (level geometry, walls, etc...).
+		 *
+		 * The hierarchy is built once using the surface area heuristic (in 2D, the perimeter
+		 * of the bounds is used as the surface area), which makes the build slower than a LBVH
+		 * but the queries faster. It can be built offline and saved with serialize(), then
+		 * loaded with deserialize().
+		 *
+		 * Queries treat a LineSegment as a ray going from start to end.
+		 */
+		class SegmentBVH {
+
+		public:
+
+			static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFF; /**< Marks the absence of a node. */
+
+		public:
+
+			/**
+			 * \brief Constructs an empty hierarchy.
+			 */
+			SegmentBVH();
+
+			/**
+			 * \brief Rebuilds the hierarchy from the given segments.
+			 *
+			 * The queries return indices in this array.
+			 *
+			 * \param segments The segments to store in the hierarchy.
+			 * \param maxLeafSize Maximum number of segments per leaf.
+			 */
+			void build(const std::vector<LineSegment>& segments, std::uint32_t maxLeafSize = 4);
+
+			/**
+			 * \brief Finds the first segment crossed by a ray going from ray.start to ray.end.
+			 *
+			 * \param hit Receives the index of the segment and the position of the hit along the ray.
+			 * 		  If the ray overlaps a collinear segment, the hit is where the overlap starts.
+			 * \return True if a segment was hit, false otherwise (hit is left untouched).
+			 */
+			bool closestHit(const LineSegment& ray, RaycastHit& hit) const;
+
+			/**
+			 * \brief Checks if the given segment crosses any segment of the hierarchy.
+			 *
+			 * Faster than closestHit() as it stops at the first intersection found. Useful for
+			 * line-of-sight tests.
+			 *
+			 * \return True if a segment is crossed, false otherwise.
+			 */
+			bool anyHit(const LineSegment& ray) const;
+
+			/**
+			 * \brief Writes the hierarchy into a byte buffer.
+			 *
+			 * The buffer contains the nodes and the segments as they are stored in memory, in the
+			 * byte order of the machine, so it must be loaded on a machine with the same byte order.
+			 *
+			 * \return The serialized hierarchy.
+			 */
+			std::vector<std::uint8_t> serialize() const;
+
+			/**
+			 * \brief Loads a hierarchy written by serialize().
+			 *
+			 * \throws std::invalid_argument If the buffer does not contain a valid hierarchy.
+			 * \return The loaded hierarchy.
+			 */
+			static SegmentBVH deserialize(const std::vector<std::uint8_t>& data);
+
+			/**
+			 * \return The nodes of the hierarchy. Empty if the hierarchy was built from an empty array.
+			 */
+			const std::vector<SegmentBVHNode>& nodes() const;
+
+			/**
+			 * \return The number of segments stored in the hierarchy.
+			 */
+			size_t size() const;
+
+		private:
+
+			std::vector<SegmentBVHNode> nodes_; /**< Nodes in depth-first order, the root is node 0. */
+			std::vector<LineSegment> segments_; /**< Segments, in the order of the leaves. */
+			std::vector<std::uint32_t> indices_; /**< Index of each segment in the array given to build(). */
+		};
+	}
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Trigger volumes (AABB or circle regions) that report the entities entering and exiting them.
+		 *
+		 * Every tick, each sensor asks a broadphase (a LBVH built over the AABBs of the entities)
+		 * for the entities it overlaps, instead of testing every entity. The overlaps of each
+		 * sensor are kept sorted, so the events are found by merging the sorted overlaps of the
+		 * previous tick with the new ones : the cost of a tick depends on the number of overlaps,
+		 * not on the number of sensors times the number of entities.
+		 *
+		 * By default an entity overlaps a sensor as soon as their shapes intersect. A sensor
+		 * created with requireContainment only reports the entities that are completely inside it
+		 * (see collision::aabb_contains() and collision::circle_contains()).
+		 */
+		class SensorSystem {
+
+		public:
+
+			/**
+			 * \brief Constructs a system without any sensor.
+			 */
+			SensorSystem();
+
+			/**
+			 * \brief Adds an AABB sensor.
+			 * \return The identifier of the sensor. The identifiers of removed sensors are reused.
+			 */
+			std::uint32_t add(const AABB& region, bool requireContainment = false);
+
+			/**
+			 * \brief Adds a circle sensor.
+			 * \return The identifier of the sensor. The identifiers of removed sensors are reused.
+			 */
+			std::uint32_t add(const Circle& region, bool requireContainment = false);
+
+			/**
+			 * \brief Moves or resizes a sensor. It becomes an AABB sensor if it was a circle sensor.
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			void set(std::uint32_t sensor, const AABB& region);
+
+			/**
+			 * \brief Moves or resizes a sensor. It becomes a circle sensor if it was an AABB sensor.
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			void set(std::uint32_t sensor, const Circle& region);
+
+			/**
+			 * \brief Removes a sensor. The entities overlapping it are reported as exiting on the next update().
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			void remove(std::uint32_t sensor);
+
+			/**
+			 * \brief Finds the entities overlapping each sensor and reports the changes since the last update.
+			 *
+			 * \param broadphase A LBVH built from the entities.
+			 * \param entities The AABBs of the entities, in the order they were given to LBVH::build().
+			 * 		  The index of an entity must stay the same from one tick to the next.
+			 * \param events Cleared, then filled with the events of the tick, sorted by sensor then by entity.
+			 * \param reportStays If true, a Stay event is also reported for every entity that was already overlapping a sensor.
+			 */
+			void update(const LBVH& broadphase, const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays = false);
+
+			/**
+			 * \brief Same as update(const LBVH&, const std::vector<AABB>&, std::vector<SensorEvent>&, bool), with a LBVH built internally from the entities.
+			 */
+			void update(const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays = false);
+
+			/**
+			 * \return The entities overlapping the sensor during the last update, sorted by index.
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			const std::vector<std::uint32_t>& overlaps(std::uint32_t sensor) const;
+
+			/**
+			 * \return The number of sensors.
+			 */
+			size_t size() const;
+
+		private:
+
+			/**
+			 * \brief Throws if the sensor doesn't exist.
+			 */
+			void checkSensor(std::uint32_t sensor) const;
+
+			/**
+			 * \brief Allocates a sensor, reusing the identifier of a removed sensor if possible.
+			 */
+			std::uint32_t allocate(bool requireContainment);
+
+			std::vector<ShapeType> types_; /**< Type of the region of each sensor, ShapeType::MAX_VALUE for removed sensors. */
+			std::vector<AABB> aabbs_; /**< Region of each AABB sensor. */
+			std::vector<Circle> circles_; /**< Region of each circle sensor. */
+			std::vector<std::uint8_t> requireContainment_; /**< Whether each sensor only reports the entities it contains. */
+			std::vector<std::vector<std::uint32_t>> overlaps_; /**< Sorted entities overlapping each sensor during the last update. */
+			std::vector<std::uint32_t> freeSensors_; /**< Identifiers of the removed sensors whose exits have been reported. */
+			std::vector<std::uint32_t> removedSensors_; /**< Identifiers of the sensors removed since the last update. */
+			std::vector<std::uint32_t> candidates_; /**< Results of the broadphase, reused between sensors. */
+			LBVH broadphase_; /**< LBVH used by update(const std::vector<AABB>&, std::vector<SensorEvent>&, bool). */
+			size_t size_; /**< Number of sensors. */
+		};
+	}
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Moves a kinematic shape (a character) among static obstacles, sliding along the ones it hits.
+		 *
+		 * Instead of moving the shape then pushing it out of the obstacles it overlaps, the shape is
+		 * swept along its motion (see collision::aabb_time_of_impact() and collision::circle_aabb_time_of_impact())
+		 * against the obstacles found by a broadphase query. The shape stops at the first obstacle it
+		 * hits, the motion left is projected on the side of the obstacle, and the sweep is repeated
+		 * with this motion, up to maxIterations times.
+		 *
+		 * The shape stops at skinWidth from the obstacles, so that it can slide along them (a
+		 * character walking on the floor) without hitting them again. A shape that already overlaps
+		 * obstacles before moving is pushed out of them first : out of the obstacle it overlaps the
+		 * most, then the obstacles are queried again, up to maxIterations times. A side of an obstacle
+		 * covered by another obstacle (the seam between two tiles of a floor) never pushes the shape.
+		 *
+		 * The results of the broadphase queries are stored in a buffer reused between moves and the
+		 * contacts in a fixed array : a move doesn't allocate memory once the buffer is large enough.
+		 */
+		class KinematicMover {
+
+		public:
+
+			/**
+			 * \brief Constructs a mover.
+			 * \param maxIterations Largest number of sweeps of a move, between 1 and MAX_SLIDE_ITERATIONS.
+			 * \param skinWidth Distance kept between the shape and the obstacles.
+			 * \throws std::invalid_argument If maxIterations is out of range.
+			 */
+			KinematicMover(std::uint32_t maxIterations = 4, float skinWidth = 0.01f);
+
+			/**
+			 * \brief Moves an AABB and slides it along the obstacles it hits.
+			 *
+			 * \param aabb The AABB, at its position before the move.
+			 * \param motion The motion of the tick.
+			 * \param broadphase A LBVH built from the obstacles.
+			 * \param obstacles The obstacles, in the order they were given to LBVH::build().
+			 * \return The position of the AABB after the move and the obstacles it hit.
+			 */
+			MoveResult moveAndSlide(const AABB& aabb, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles);
+
+			/**
+			 * \brief Moves a circle and slides it along the obstacles it hits.
+			 *
+			 * \param circle The circle, at its position before the move.
+			 * \param motion The motion of the tick.
+			 * \param broadphase A LBVH built from the obstacles.
+			 * \param obstacles The obstacles, in the order they were given to LBVH::build().
+			 * \return The position of the center of the circle after the move and the obstacles it hit.
+			 */
+			MoveResult moveAndSlide(const Circle& circle, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles);
+
+		private:
+
+			/**
+			 * \brief Implementation of both moveAndSlide() overloads.
+			 */
+			template<typename Shape>
+			MoveResult move(Shape shape, vec_t motion, const LBVH& broadphase, const std::vector<AABB>& obstacles);
+
+			std::uint32_t maxIterations_; /**< Largest number of sweeps of a move. */
+			float skinWidth_; /**< Distance kept between the shape and the obstacles. */
+			std::vector<std::uint32_t> candidates_; /**< Results of the broadphase queries, reused between moves. */
+		};
+	}
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Collision layer made of a grid of solid or empty tiles.
+		 *
+		 * The solidity of the tiles is stored in a bit array (one bit per tile, each row padded to
+		 * a multiple of 64 tiles). The queries compute the range of tiles covered by the shape and
+		 * only read the bits of these tiles, a whole word at a time along a row : the tiles are
+		 * never converted to AABBs.
+		 *
+		 * Tile (x, y) covers the area from origin + (x * tileSize.x, y * tileSize.y) to
+		 * origin + ((x + 1) * tileSize.x, (y + 1) * tileSize.y). Index x + y * width() identifies
+		 * a tile in the results of the queries. Everything outside of the grid is empty.
+		 *
+		 * A shape that only touches a solid tile doesn't collide with it, so that a character can
+		 * stand on the ground or slide along a wall.
+		 */
+		class TileMap {
+
+		public:
+
+			/**
+			 * \brief Constructs a grid of empty tiles.
+			 * \param width Number of columns.
+			 * \param height Number of rows.
+			 * \param tileSize Size of a tile.
+			 * \param origin Position of the top-left corner of the grid.
+			 * \throws std::invalid_argument If the grid is empty or if the size of the tiles isn't positive.
+			 */
+			TileMap(std::uint32_t width, std::uint32_t height, const vec_t& tileSize, const vec_t& origin = vec_t(0.f, 0.f));
+
+			/**
+			 * \brief Makes a tile solid or empty.
+			 * \throws std::out_of_range If the tile is outside of the grid.
+			 */
+			void setSolid(std::uint32_t x, std::uint32_t y, bool solid = true);
+
+			/**
+			 * \return true if the tile is solid, false if it's empty or outside of the grid.
+			 */
+			bool isSolid(std::int64_t x, std::int64_t y) const;
+
+			/**
+			 * \return The area covered by a tile.
+			 */
+			Bounds tileBounds(std::uint32_t x, std::uint32_t y) const;
+
+			/**
+			 * \return true if the AABB overlaps a solid tile.
+			 */
+			bool intersects(const AABB& aabb) const;
+
+			/**
+			 * \return true if the circle overlaps a solid tile.
+			 */
+			bool intersects(const Circle& circle) const;
+
+			/**
+			 * \brief Finds the solid tiles overlapped by the AABB.
+			 * \param results Cleared, then filled with the indices of the tiles, row by row.
+			 */
+			void query(const AABB& aabb, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the solid tiles overlapped by the circle.
+			 * \param results Cleared, then filled with the indices of the tiles, row by row.
+			 */
+			void query(const Circle& circle, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Computes the translation (minimum translation vector) that pushes the AABB out of the solid tiles.
+			 *
+			 * The AABB is pushed out of the tile it overlaps the most, then the tiles are tested
+			 * again, up to maxIterations times. A tile never pushes the AABB towards a neighbouring
+			 * solid tile : an AABB sinking into a flat floor is pushed up, even at the seam
+			 * between two tiles.
+			 *
+			 * \return The translation to apply to the AABB, NULL_VEC if it doesn't overlap any solid tile.
+			 */
+			vec_t resolve(const AABB& aabb, std::uint32_t maxIterations = 4) const;
+
+			/**
+			 * \brief Computes the translation that pushes the circle out of the solid tiles.
+			 *
+			 * Same as resolve(const AABB&, std::uint32_t), with a circle. In a concave corner, the push out
+			 * of a tile can move the circle back into the tile of the previous push : the circle then keeps
+			 * the previous push and leaves the new tile along the other axis. A circle squeezed between two
+			 * opposite sides (a gap narrower than the circle) can't be pushed out : the translation stops
+			 * there and the circle still overlaps a solid tile, as when maxIterations is reached first.
+			 *
+			 * \return The translation to apply to the center of the circle, NULL_VEC if it doesn't overlap any solid tile.
+			 */
+			vec_t resolve(const Circle& circle, std::uint32_t maxIterations = 4) const;
+
+			/**
+			 * \brief Finds the first solid tile hit by a ray going from ray.start to ray.end.
+			 *
+			 * The tiles crossed by the ray are visited in order (digital differential analyzer) and
+			 * the traversal stops at the first solid one.
+			 *
+			 * \param hit Receives the index of the tile and the position where the ray enters it.
+			 * 		  A ray starting inside a solid tile hits it at t = 0.
+			 * \return True if a solid tile was hit, false otherwise (hit is left untouched).
+			 */
+			bool raycast(const LineSegment& ray, RaycastHit& hit) const;
+
+			/**
+			 * \return The number of columns.
+			 */
+			std::uint32_t width() const;
+
+			/**
+			 * \return The number of rows.
+			 */
+			std::uint32_t height() const;
+
+			/**
+			 * \return The size of a tile.
+			 */
+			vec_t tileSize() const;
+
+			/**
+			 * \return The area covered by the grid.
+			 */
+			Bounds bounds() const;
+
+		private:
+
+			/**
+			 * \brief Computes the range of tiles strictly overlapped by the bounds, clamped to the grid.
+			 * \return false if the bounds don't overlap the grid.
+			 */
+			bool tileRange(const Bounds& bounds, std::uint32_t& x0, std::uint32_t& y0, std::uint32_t& x1, std::uint32_t& y1) const;
+
+			/**
+			 * \return true if a tile of the row between columns x0 and x1 (included) is solid.
+			 */
+			bool anySolid(std::uint32_t y, std::uint32_t x0, std::uint32_t x1) const;
+
+			/**
+			 * \brief Computes the push out of the solid tile the AABB overlaps the most.
+			 * \return The penetration depth, 0 if the AABB doesn't overlap any solid tile.
+			 */
+			float deepestPenetration(const Bounds& bounds, vec_t& normal) const;
+
+			/**
+			 * \brief Computes the push out of the solid tile the circle overlaps the most.
+			 * \return The penetration depth, 0 if the circle doesn't overlap any solid tile.
+			 */
+			float deepestPenetration(const Circle& circle, vec_t& normal) const;
+
+			/**
+			 * \brief Computes how far the circle must move along an axis to leave the solid tiles it overlaps behind it.
+			 * \param direction LEFT_VEC, RIGHT_VEC, UP_VEC or DOWN_VEC.
+			 * \return The distance, 0 if the circle doesn't overlap any solid tile behind it.
+			 */
+			float penetrationAlong(const Circle& circle, const vec_t& direction) const;
+
+			std::uint32_t width_; /**< Number of columns. */
+			std::uint32_t height_; /**< Number of rows. */
+			std::uint32_t wordsPerRow_; /**< Number of 64-bit words of a row. */
+			vec_t tileSize_; /**< Size of a tile. */
+			vec_t origin_; /**< Top-left corner of the grid. */
+			std::vector<std::uint64_t> solid_; /**< Solidity of the tiles, one bit per tile, row by row. */
+		};
+	}
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Pixel-perfect collision shape : a grid of solid or empty pixels, placed at a position.
+	 *
+	 * A mask placed at a position covers the AABB aabb(position), each pixel being a 1x1 square.
+	 * Positions are rounded down to whole pixels, the masks don't rotate nor scale.
+	 *
+	 * The pixels are stored one bit per pixel, each row padded to a multiple of 64 pixels. The mask
+	 * also keeps its rows shifted by every offset from 0 to 63 pixels, so that two masks can be
+	 * tested 64 pixels at a time with a single AND whatever their relative position. This costs
+	 * 64 times the memory of the pixels (32 KiB for a 64x64 mask) : the masks are meant for sprites.
+	 */
+	class CollisionMask {
+
+	public:
+
+		/**
+		 * \brief Constructs a mask from the alpha channel of a sprite.
+		 * \param width Number of columns.
+		 * \param height Number of rows.
+		 * \param alpha Alpha of each pixel, row by row (pixel (x, y) at x + y * width).
+		 * \param threshold Pixels with an alpha greater than this value are solid.
+		 * \throws std::invalid_argument If the mask is empty or if the size of alpha isn't width * height.
+		 */
+		CollisionMask(std::uint32_t width, std::uint32_t height, const std::vector<std::uint8_t>& alpha, std::uint8_t threshold = 0);
+
+		/**
+		 * \return true if the pixel is solid, false if it's empty or outside of the mask.
+		 */
+		bool isSolid(std::int64_t x, std::int64_t y) const;
+
+		/**
+		 * \return The AABB covered by the mask placed at the position.
+		 */
+		AABB aabb(const vec_t& position) const;
+
+		/**
+		 * \brief Tests if two masks have a solid pixel in common.
+		 *
+		 * The AABBs of the masks are tested first, then only the rows and words of their overlap
+		 * are compared. Returns as soon as a common pixel is found.
+		 *
+		 * \param position Position of this mask.
+		 * \param other The other mask.
+		 * \param otherPosition Position of the other mask.
+		 * \return true if the masks overlap.
+		 */
+		bool intersects(const vec_t& position, const CollisionMask& other, const vec_t& otherPosition) const;
+
+		/**
+		 * \return The number of columns.
+		 */
+		std::uint32_t width() const;
+
+		/**
+		 * \return The number of rows.
+		 */
+		std::uint32_t height() const;
+
+	private:
+
+		/**
+		 * \return The first word of a row of the pixels shifted by a number of pixels to the right.
+		 */
+		const std::uint64_t* shiftedRow(std::uint32_t shift, std::uint32_t y) const;
+
+		std::uint32_t width_; /**< Number of columns. */
+		std::uint32_t height_; /**< Number of rows. */
+		std::uint32_t wordsPerRow_; /**< Number of 64-bit words of a shifted row (one more than needed for the pixels). */
+		std::vector<std::uint64_t> shiftedRows_; /**< The rows shifted by 0 to 63 pixels, one bit per pixel. */
+	};
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Signed distance field of static geometry, baked once and queried in constant time.
+		 *
+		 * The field stores, at each node of a regular grid covering an area, the signed distance to the
+		 * closest AABB, circle or line segment of the geometry : negative inside an AABB or a circle,
+		 * positive outside. Line segments have no inside. Where shapes overlap, the distance is the
+		 * smallest of the distances to each shape, so deep inside overlapping shapes the depth is
+		 * underestimated.
+		 *
+		 * The queries interpolate the four nodes around a point (bilinear sampling), whatever the amount of
+		 * geometry. The interpolation is exact along flat walls and rounds the corners : the error is
+		 * below the size of a cell.
+		 *
+		 * The bake seeds the nodes near each shape with their exact distance to it, then spreads the
+		 * closest shape to the rest of the grid with jump flooding, one row per task. Each node ends up
+		 * with the exact distance to a shape, that is the closest one except in rare cases where another
+		 * shape is almost as close. The geometry should be inside of the area : a shape outside of it only
+		 * reaches the nodes of the border that are the closest to it, and can be hidden by other shapes.
+		 */
+		class DistanceField {
+
+		public:
+
+			/**
+			 * \brief Constructs a field without geometry (every distance is std::numeric_limits<float>::max()).
+			 * \param area The area covered by the field. Nodes are placed every cellSize from area.min, up to area.max at least.
+			 * \param cellSize Distance between two nodes.
+			 * \throws std::invalid_argument If the area is empty or if the size of the cells isn't positive.
+			 */
+			DistanceField(const Bounds& area, float cellSize);
+
+			/**
+			 * \brief Computes the distance from each node to the geometry, replacing the previous geometry.
+			 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+			 */
+			void bake(const std::vector<AABB>& aabbs, const std::vector<Circle>& circles, const std::vector<LineSegment>& segments, unsigned int threadCount = 0);
+
+			/**
+			 * \brief Samples the signed distance at a point.
+			 *
+			 * Outside of the area of the field, the distance is sampled at the closest point of the area and the
+			 * distance to this point is added.
+			 */
+			float distance(const vec_t& point) const;
+
+			/**
+			 * \brief Samples the direction in which the distance increases the fastest at a point.
+			 * \return A normalized vector pointing away from the geometry, NULL_VEC if the field is flat there.
+			 */
+			vec_t normal(const vec_t& point) const;
+
+			/**
+			 * \return true if the circle overlaps the geometry.
+			 */
+			bool intersects(const Circle& circle) const;
+
+			/**
+			 * \brief Computes how deep the circle is into the geometry.
+			 * \param normal Receives the direction in which to push the circle out, if it overlaps the geometry.
+			 * \return The penetration depth, 0 if the circle doesn't overlap the geometry.
+			 */
+			float penetration(const Circle& circle, vec_t& normal) const;
+
+			/**
+			 * \return The translation that pushes the circle out of the geometry, NULL_VEC if it doesn't overlap it.
+			 */
+			vec_t resolve(const Circle& circle) const;
+
+			/**
+			 * \return The value stored at a node.
+			 * \throws std::out_of_range If the node is outside of the grid.
+			 */
+			float nodeDistance(std::uint32_t x, std::uint32_t y) const;
+
+			/**
+			 * \return The position of a node.
+			 */
+			vec_t nodePosition(std::uint32_t x, std::uint32_t y) const;
+
+			/**
+			 * \return The number of nodes along the x axis.
+			 */
+			std::uint32_t columns() const;
+
+			/**
+			 * \return The number of nodes along the y axis.
+			 */
+			std::uint32_t rows() const;
+
+			/**
+			 * \return The distance between two nodes.
+			 */
+			float cellSize() const;
+
+		private:
+
+			/**
+			 * \brief Finds the cell containing the point, clamped to the grid.
+			 * \param x Receives the column of the top-left node of the cell.
+			 * \param y Receives the row of the top-left node of the cell.
+			 * \param fraction Receives the position of the point in the cell, between 0 and 1.
+			 * \return The distance between the point and the grid.
+			 */
+			float locate(const vec_t& point, std::uint32_t& x, std::uint32_t& y, vec_t& fraction) const;
+
+			vec_t origin_; /**< Position of node (0, 0). */
+			float cellSize_; /**< Distance between two nodes. */
+			std::uint32_t columns_; /**< Number of nodes along the x axis. */
+			std::uint32_t rows_; /**< Number of nodes along the y axis. */
+			std::vector<float> distances_; /**< Signed distance at each node, row by row. */
+		};
+	}
+}
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace collision {
+
+		/**
+		 * \brief An intersection found between 2 segments of an array.
+		 */
+		struct IndexedSegmentsIntersection {
+			std::uint32_t first; /**< Index of the first segment. */
+			std::uint32_t second; /**< Index of the second segment (always greater than first). */
+			SegmentsIntersection intersection; /**< The intersection, either IntersectionType::Crossing or IntersectionType::Overlapping. */
+		};
+
+		/**
+		 * \brief Finds every pair of intersecting segments in an array.
+		 *
+		 * Instead of testing every pair of segments (n² tests), a sweep line (Bentley-Ottmann) goes
+		 * through the extremities of the segments and the crossings it finds, only testing segments
+		 * that are neighbours on the sweep line. The cost is O((n + k) log n) for k intersections,
+		 * whatever the layout of the segments (long parallel walls included). Segments meeting at an
+		 * extremity or overlapping are found with exact orientation tests; crossing points are rounded,
+		 * so crossings closer than the rounding error to another event can be swept out of order.
+		 *
+		 * The sweep runs on a single thread, the intersections of the pairs found are then computed
+		 * with line_segments_parametric_intersection() on several threads.
+		 *
+		 * Points of the intersections are computed from the first segment of each pair. For
+		 * overlapping segments, resultingSegment goes in the direction of the first segment.
+		 *
+		 * \param segments The segments to test.
+		 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+		 * \return Every intersection, sorted by first index then by second index.
+		 */
+		std::vector<IndexedSegmentsIntersection> all_line_segments_intersections(const std::vector<LineSegment>& segments, unsigned int threadCount = 0);
 	}
 }
 
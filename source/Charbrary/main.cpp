@@ -23,17 +23,62 @@ limitations under the License. */
 
 #include "src/vector_type_definition.h"
 #include "src/vector_maths_functions.h"
+#include "src/batch_vector_maths_functions.h"
 
 #include "src/Corner.h"
 #include "src/AABB.h"
+#include "src/Bounds.h"
 #include "src/Circle.h"
 #include "src/LineSegment.h"
+#include "src/PreparedSegment.h"
+#include "src/ConvexPolygon.h"
+#include "src/OBB.h"
+#include "src/Capsule.h"
+#include "src/SupportShape.h"
 #include "src/SegmentsIntersection.h"
+#include "src/SegmentsParametricIntersection.h"
+#include "src/CircleSegmentCollision.h"
+#include "src/CircleSweepHit.h"
+#include "src/SegmentAABBClip.h"
+#include "src/PolygonCollision.h"
+#include "src/OBBCollision.h"
+#include "src/CapsuleCollision.h"
+#include "src/ConvexCollision.h"
+#include "src/GJKCache.h"
+#include "src/GJKResult.h"
+#include "src/PairContact.h"
+#include "src/ContactEvent.h"
+#include "src/SensorEvent.h"
+#include "src/MoveResult.h"
+#include "src/RaycastHit.h"
+#include "src/AABBBatch.h"
+#include "src/CircleBatch.h"
+#include "src/LineSegmentBatch.h"
+#include "src/OBBBatch.h"
+#include "src/ShapePair.h"
 
 #include "src/Stopwatch.h"
 #include "src/rng_functions.h"
+#include "src/cpu_features.h"
+#include "src/parallel_functions.h"
 
 #include "src/collision_functions.h"
+#include "src/batch_collision_functions.h"
+#include "src/gjk_functions.h"
+#include "src/ShapePairDispatcher.h"
+#include "src/PairCache.h"
+#include "src/SleepManager.h"
+#include "src/ContactSolver.h"
+
+#include "src/morton_functions.h"
+#include "src/LBVH.h"
+#include "src/SegmentBVH.h"
+#include "src/SensorSystem.h"
+#include "src/KinematicMover.h"
+#include "src/TileMap.h"
+#include "src/CollisionMask.h"
+#include "src/DistanceField.h"
+#include "src/segments_intersection_functions.h"
 
 // END CHARBRARY.H
 // BEGIN CHARBRARY.CPP
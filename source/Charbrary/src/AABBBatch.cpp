@@ -0,0 +1,71 @@
+#include "AABBBatch.h"
+
+namespace ch {
+
+	AABBBatch::AABBBatch() : minX(), minY(), maxX(), maxY() {}
+
+	AABBBatch::AABBBatch(const std::vector<AABB>& aabbs) : AABBBatch() {
+		reserve(aabbs.size());
+		for (const auto& aabb : aabbs) {
+			push_back(aabb);
+		}
+	}
+
+	void AABBBatch::push_back(const AABB& aabb) {
+		minX.push_back(aabb.pos.x);
+		minY.push_back(aabb.pos.y);
+		maxX.push_back(aabb.pos.x + aabb.size.x);
+		maxY.push_back(aabb.pos.y + aabb.size.y);
+	}
+
+	void AABBBatch::push_back(const Bounds& bounds) {
+		minX.push_back(bounds.min.x);
+		minY.push_back(bounds.min.y);
+		maxX.push_back(bounds.max.x);
+		maxY.push_back(bounds.max.y);
+	}
+
+	void AABBBatch::set(size_t index, const AABB& aabb) {
+		minX[index] = aabb.pos.x;
+		minY[index] = aabb.pos.y;
+		maxX[index] = aabb.pos.x + aabb.size.x;
+		maxY[index] = aabb.pos.y + aabb.size.y;
+	}
+
+	void AABBBatch::set(size_t index, const Bounds& bounds) {
+		minX[index] = bounds.min.x;
+		minY[index] = bounds.min.y;
+		maxX[index] = bounds.max.x;
+		maxY[index] = bounds.max.y;
+	}
+
+	AABB AABBBatch::at(size_t index) const {
+		return AABB(minX[index], minY[index], maxX[index] - minX[index], maxY[index] - minY[index]);
+	}
+
+	Bounds AABBBatch::bounds(size_t index) const {
+		return Bounds(minX[index], minY[index], maxX[index], maxY[index]);
+	}
+
+	void AABBBatch::reserve(size_t capacity) {
+		minX.reserve(capacity);
+		minY.reserve(capacity);
+		maxX.reserve(capacity);
+		maxY.reserve(capacity);
+	}
+
+	void AABBBatch::clear() {
+		minX.clear();
+		minY.clear();
+		maxX.clear();
+		maxY.clear();
+	}
+
+	size_t AABBBatch::size() const {
+		return minX.size();
+	}
+
+	bool AABBBatch::empty() const {
+		return minX.empty();
+	}
+}
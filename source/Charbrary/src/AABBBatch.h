@@ -0,0 +1,89 @@
+#pragma once
+
+#include "AABB.h"
+#include "Bounds.h"
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many AABBs in a structure-of-arrays layout.
+	 *
+	 * Instead of storing a position and a size per box, the batch stores the boundaries
+	 * of every box in four contiguous arrays (min X, min Y, max X and max Y). This is the
+	 * layout expected by the batched collision functions, which can then test several boxes
+	 * at once with SIMD instructions.
+	 */
+	class AABBBatch {
+
+	public:
+
+		std::vector<float> minX; /**< Left side of each box. */
+		std::vector<float> minY; /**< Top side of each box. */
+		std::vector<float> maxX; /**< Right side of each box. */
+		std::vector<float> maxY; /**< Bottom side of each box. */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		AABBBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given AABBs.
+		 */
+		AABBBatch(const std::vector<AABB>& aabbs);
+
+		/**
+		 * \brief Adds an AABB at the end of the batch.
+		 */
+		void push_back(const AABB& aabb);
+
+		/**
+		 * \brief Adds bounds at the end of the batch.
+		 */
+		void push_back(const Bounds& bounds);
+
+		/**
+		 * \brief Replaces the AABB at the given index.
+		 */
+		void set(size_t index, const AABB& aabb);
+
+		/**
+		 * \brief Replaces the box at the given index.
+		 */
+		void set(size_t index, const Bounds& bounds);
+
+		/**
+		 * \brief Rebuilds the AABB stored at the given index.
+		 */
+		AABB at(size_t index) const;
+
+		/**
+		 * \brief Returns the bounds stored at the given index, without any rounding.
+		 */
+		Bounds bounds(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of AABBs.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every AABB from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of AABBs in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any AABB.
+		 */
+		bool empty() const;
+	};
+}
@@ -0,0 +1,45 @@
+#include "Bounds.h"
+
+namespace ch {
+
+	Bounds::Bounds() : min(0.f, 0.f), max(0.f, 0.f) {}
+
+	Bounds::Bounds(const vec_t& min_, const vec_t& max_) : min(min_), max(max_) {}
+
+	Bounds::Bounds(float minX, float minY, float maxX, float maxY) : min(minX, minY), max(maxX, maxY) {}
+
+	Bounds::Bounds(const AABB& aabb) : min(aabb.pos), max(aabb.pos + aabb.size) {}
+
+	AABB Bounds::toAABB() const {
+		return AABB(min, max - min);
+	}
+
+	void Bounds::move(const vec_t& movement) {
+		min += movement;
+		max += movement;
+	}
+
+	vec_t Bounds::center() const {
+		return (min + max) / 2.f;
+	}
+
+	vec_t Bounds::size() const {
+		return max - min;
+	}
+
+	float Bounds::perimeter() const {
+		return 2 * (max.x - min.x + max.y - min.y);
+	}
+
+	float Bounds::area() const {
+		return (max.x - min.x) * (max.y - min.y);
+	}
+
+	bool operator==(const Bounds& left, const Bounds& right) {
+		return left.min == right.min && left.max == right.max;
+	}
+
+	bool operator!=(const Bounds& left, const Bounds& right) {
+		return !(left == right);
+	}
+}
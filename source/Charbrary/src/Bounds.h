@@ -0,0 +1,106 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABB.h"
+
+namespace ch {
+
+	/**
+	 * \brief Represents an Axis-Aligned-Bounding-Box by its minimum and maximum corners.
+	 *
+	 * An AABB stores a position and a size, so every collision test has to add them
+	 * together to find the right and bottom sides. Bounds store the sides directly, which
+	 * turns the tests into plain comparisons. Use them for shapes that are tested often
+	 * (broadphase, batches, etc...).
+	 *
+	 * Converting an AABB to Bounds and back gives the same AABB, unless the additions
+	 * and subtractions involved are rounded (very large positions or very small sizes).
+	 */
+	class Bounds {
+
+	public:
+
+		vec_t min; /**< Top-left corner of the bounds (smallest coordinates). */
+
+		vec_t max; /**< Bottom-right corner of the bounds (largest coordinates). */
+
+	public:
+
+		/**
+		 * \brief Constructs new bounds with default values.
+		 *
+		 * By default, both corners are at 0,0.
+		 */
+		Bounds();
+
+		/**
+		 * \brief Constructs new bounds from 2 corners.
+		 * \param min_ Top-left corner.
+		 * \param max_ Bottom-right corner.
+		 */
+		Bounds(const vec_t& min_, const vec_t& max_);
+
+		/**
+		 * \brief Constructs new bounds from 4 values.
+		 *
+		 * \param minX Left side.
+		 * \param minY Top side.
+		 * \param maxX Right side.
+		 * \param maxY Bottom side.
+		 */
+		Bounds(float minX, float minY, float maxX, float maxY);
+
+		/**
+		 * \brief Constructs the bounds of an AABB.
+		 */
+		explicit Bounds(const AABB& aabb);
+
+		/**
+		 * \brief Converts the bounds to an AABB.
+		 * \return An AABB covering the same area.
+		 */
+		AABB toAABB() const;
+
+		/**
+		 * \brief Moves the bounds by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
+
+		/**
+		 * \brief Returns the center of the bounds.
+		 * \return The position of the center.
+		 */
+		vec_t center() const;
+
+		/**
+		 * \brief Returns the size of the bounds.
+		 * \return The width (X) and the height (Y) of the bounds.
+		 */
+		vec_t size() const;
+
+		/**
+		 * \brief Computes the perimeter of the bounds.
+		 * \return The perimeter of the bounds.
+		 */
+		float perimeter() const;
+
+		/**
+		 * \brief Computes the area of the bounds.
+		 * \return The area of the bounds.
+		 */
+		float area() const;
+	};
+
+	/**
+	 * \brief Overload of the equality operator.
+	 * \return True if left and right are equal, false otherwise.
+	 */
+	bool operator==(const Bounds& left, const Bounds& right);
+
+	/**
+	 * \brief Overload of the inequality operator.
+	 * \return True if left and right are different, false otherwise.
+	 */
+	bool operator!=(const Bounds& left, const Bounds& right);
+}
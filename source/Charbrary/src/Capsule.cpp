@@ -0,0 +1,39 @@
+#include "Capsule.h"
+
+namespace ch {
+
+	Capsule::Capsule() : segment(), radius(0.f) {}
+
+	Capsule::Capsule(const LineSegment& segment_, float radius_) : segment(segment_), radius(radius_) {}
+
+	Capsule::Capsule(const vec_t& start, const vec_t& end, float radius_) : segment(start, end), radius(radius_) {}
+
+	void Capsule::move(const vec_t& movement) {
+		segment.start += movement;
+		segment.end += movement;
+	}
+
+	vec_t Capsule::center() const {
+		return (segment.start + segment.end) / 2.f;
+	}
+
+	Bounds Capsule::bounds() const {
+		return Bounds(
+			segment.minX() - radius,
+			segment.minY() - radius,
+			segment.maxX() + radius,
+			segment.maxY() + radius);
+	}
+
+	AABB Capsule::aabb() const {
+		return bounds().toAABB();
+	}
+
+	bool operator==(const Capsule& left, const Capsule& right) {
+		return left.radius == right.radius && left.segment == right.segment;
+	}
+
+	bool operator!=(const Capsule& left, const Capsule& right) {
+		return !(left == right);
+	}
+}
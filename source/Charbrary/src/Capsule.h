@@ -0,0 +1,78 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABB.h"
+#include "Bounds.h"
+#include "LineSegment.h"
+
+namespace ch {
+
+	/**
+	 * \brief Represents a capsule : every point closer than a radius to a line segment.
+	 *
+	 * A capsule is a rectangle with two half circles at its extremities. It is the usual
+	 * hitbox of characters, as it slides over steps and corners.
+	 */
+	class Capsule {
+
+	public:
+
+		LineSegment segment; /**< The segment going through the middle of the capsule, from the center of one half circle to the other. */
+
+		float radius; /**< The radius of the half circles (and half of the width of the capsule). */
+
+	public:
+
+		/**
+		 * \brief Constructs a new capsule with default values.
+		 *
+		 * The new capsule will be reduced to a point positioned at 0,0.
+		 */
+		Capsule();
+
+		/**
+		 * \brief Constructs a new capsule from a segment and a radius.
+		 * \param segment_ Segment going through the middle of the capsule.
+		 * \param radius_ Radius of the capsule.
+		 */
+		Capsule(const LineSegment& segment_, float radius_);
+
+		/**
+		 * \brief Constructs a new capsule from the extremities of its segment and a radius.
+		 */
+		Capsule(const vec_t& start, const vec_t& end, float radius_);
+
+		/**
+		 * \brief Moves the capsule by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
+
+		/**
+		 * \return The middle of the segment of the capsule.
+		 */
+		vec_t center() const;
+
+		/**
+		 * \return The smallest bounds containing the capsule.
+		 */
+		Bounds bounds() const;
+
+		/**
+		 * \return The smallest AABB containing the capsule.
+		 */
+		AABB aabb() const;
+	};
+
+	/**
+	 * \brief Overload of the equality operator between 2 capsules.
+	 * \return True if both capsules have the same segment and radius.
+	 */
+	bool operator==(const Capsule& left, const Capsule& right);
+
+	/**
+	 * \brief Overload of the inequality operator between 2 capsules.
+	 * \return The opposite of operator==().
+	 */
+	bool operator!=(const Capsule& left, const Capsule& right);
+}
@@ -0,0 +1,49 @@
+#include "CircleBatch.h"
+
+namespace ch {
+
+	CircleBatch::CircleBatch() : x(), y(), radius() {}
+
+	CircleBatch::CircleBatch(const std::vector<Circle>& circles) : CircleBatch() {
+		reserve(circles.size());
+		for (const auto& circle : circles) {
+			push_back(circle);
+		}
+	}
+
+	void CircleBatch::push_back(const Circle& circle) {
+		x.push_back(circle.pos.x);
+		y.push_back(circle.pos.y);
+		radius.push_back(circle.radius);
+	}
+
+	void CircleBatch::set(size_t index, const Circle& circle) {
+		x[index] = circle.pos.x;
+		y[index] = circle.pos.y;
+		radius[index] = circle.radius;
+	}
+
+	Circle CircleBatch::at(size_t index) const {
+		return Circle({ x[index], y[index] }, radius[index]);
+	}
+
+	void CircleBatch::reserve(size_t capacity) {
+		x.reserve(capacity);
+		y.reserve(capacity);
+		radius.reserve(capacity);
+	}
+
+	void CircleBatch::clear() {
+		x.clear();
+		y.clear();
+		radius.clear();
+	}
+
+	size_t CircleBatch::size() const {
+		return x.size();
+	}
+
+	bool CircleBatch::empty() const {
+		return x.empty();
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Circle.h"
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many circles in a structure-of-arrays layout.
+	 *
+	 * The center coordinates and the radius of every circle are stored in three contiguous
+	 * arrays. This is the layout expected by the batched collision functions.
+	 */
+	class CircleBatch {
+
+	public:
+
+		std::vector<float> x; /**< X position of the center of each circle. */
+		std::vector<float> y; /**< Y position of the center of each circle. */
+		std::vector<float> radius; /**< Radius of each circle. */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		CircleBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given circles.
+		 */
+		CircleBatch(const std::vector<Circle>& circles);
+
+		/**
+		 * \brief Adds a circle at the end of the batch.
+		 */
+		void push_back(const Circle& circle);
+
+		/**
+		 * \brief Replaces the circle at the given index.
+		 */
+		void set(size_t index, const Circle& circle);
+
+		/**
+		 * \brief Rebuilds the circle stored at the given index.
+		 */
+		Circle at(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of circles.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every circle from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of circles in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any circle.
+		 */
+		bool empty() const;
+	};
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "vector_type_definition.h"
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about the first line segment hit by a moving circle.
+	 */
+	struct CircleSweepHit {
+		std::uint32_t index; /**< Index of the segment that was hit. */
+		float time; /**< Time of impact, between 0 (start of the motion) and 1 (end of the motion). */
+		vec_t normal; /**< Direction towards which the circle is pushed by the segment (unit vector). */
+		vec_t point; /**< Contact point, on the segment. */
+	};
+}
@@ -0,0 +1,110 @@
+#include "CollisionMask.h"
+#include "collision_functions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ch {
+
+	CollisionMask::CollisionMask(std::uint32_t width, std::uint32_t height, const std::vector<std::uint8_t>& alpha, std::uint8_t threshold) :
+		width_(width),
+		height_(height),
+		wordsPerRow_((width + 63) / 64 + 1),
+		shiftedRows_()
+	{
+		if (width == 0 || height == 0) {
+			throw std::invalid_argument("Invalid argument : the collision mask must contain at least one pixel.");
+		}
+		if (alpha.size() != static_cast<size_t>(width) * height) {
+			throw std::invalid_argument("Invalid argument : the alpha channel must contain width * height values.");
+		}
+
+		const size_t rowsPerShift = static_cast<size_t>(wordsPerRow_) * height;
+		shiftedRows_.assign(64 * rowsPerShift, 0);
+
+		// Shift 0 : the pixels, the last word of each row stays empty
+		for (std::uint32_t y = 0; y < height; ++y) {
+			for (std::uint32_t x = 0; x < width; ++x) {
+				if (alpha[x + static_cast<size_t>(y) * width] > threshold) {
+					shiftedRows_[y * wordsPerRow_ + x / 64] |= std::uint64_t(1) << (x % 64);
+				}
+			}
+		}
+
+		// Shift s : pixel x of a row moves to bit x + s, the high bits of a word carry over to the next one
+		for (std::uint32_t shift = 1; shift < 64; ++shift) {
+			for (std::uint32_t y = 0; y < height; ++y) {
+				const std::uint64_t* source = shiftedRow(0, y);
+				std::uint64_t* destination = &shiftedRows_[shift * rowsPerShift + y * wordsPerRow_];
+				destination[0] = source[0] << shift;
+				for (std::uint32_t word = 1; word < wordsPerRow_; ++word) {
+					destination[word] = (source[word] << shift) | (source[word - 1] >> (64 - shift));
+				}
+			}
+		}
+	}
+
+	bool CollisionMask::isSolid(std::int64_t x, std::int64_t y) const {
+		if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+			return false;
+		}
+		return (shiftedRow(0, static_cast<std::uint32_t>(y))[x / 64] >> (x % 64)) & 1;
+	}
+
+	AABB CollisionMask::aabb(const vec_t& position) const {
+		return AABB(vec_t(std::floor(position.x), std::floor(position.y)), vec_t(static_cast<float>(width_), static_cast<float>(height_)));
+	}
+
+	bool CollisionMask::intersects(const vec_t& position, const CollisionMask& other, const vec_t& otherPosition) const {
+		if (!collision::aabb_intersects(aabb(position), other.aabb(otherPosition))) {
+			return false;
+		}
+
+		// The mask on the left is read as is, the one on the right is read shifted by the distance between them
+		const bool otherOnTheRight = std::floor(otherPosition.x) >= std::floor(position.x);
+		const CollisionMask& left = otherOnTheRight ? *this : other;
+		const CollisionMask& right = otherOnTheRight ? other : *this;
+		const std::int64_t leftX = static_cast<std::int64_t>(std::floor(otherOnTheRight ? position.x : otherPosition.x));
+		const std::int64_t leftY = static_cast<std::int64_t>(std::floor(otherOnTheRight ? position.y : otherPosition.y));
+		const std::int64_t dx = static_cast<std::int64_t>(std::floor(otherOnTheRight ? otherPosition.x : position.x)) - leftX;
+		const std::int64_t dy = static_cast<std::int64_t>(std::floor(otherOnTheRight ? otherPosition.y : position.y)) - leftY;
+
+		// Overlap of the masks, in the pixels of the left one. Only touching : no pixel in common.
+		const std::int64_t x0 = dx;
+		const std::int64_t x1 = std::min<std::int64_t>(left.width_, dx + right.width_);
+		const std::int64_t y0 = std::max<std::int64_t>(0, dy);
+		const std::int64_t y1 = std::min<std::int64_t>(left.height_, dy + right.height_);
+		if (x0 >= x1 || y0 >= y1) {
+			return false;
+		}
+
+		// Word w of the left row lines up with word w - dx / 64 of the right row shifted by dx % 64
+		const std::uint32_t shift = static_cast<std::uint32_t>(dx % 64);
+		const std::uint32_t wordOffset = static_cast<std::uint32_t>(dx / 64);
+		const std::uint32_t firstWord = static_cast<std::uint32_t>(x0 / 64);
+		const std::uint32_t lastWord = static_cast<std::uint32_t>((x1 - 1) / 64);
+		for (std::int64_t y = y0; y < y1; ++y) {
+			const std::uint64_t* leftRow = left.shiftedRow(0, static_cast<std::uint32_t>(y));
+			const std::uint64_t* rightRow = right.shiftedRow(shift, static_cast<std::uint32_t>(y - dy));
+			for (std::uint32_t word = firstWord; word <= lastWord; ++word) {
+				if ((leftRow[word] & rightRow[word - wordOffset]) != 0) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	std::uint32_t CollisionMask::width() const {
+		return width_;
+	}
+
+	std::uint32_t CollisionMask::height() const {
+		return height_;
+	}
+
+	const std::uint64_t* CollisionMask::shiftedRow(std::uint32_t shift, std::uint32_t y) const {
+		return &shiftedRows_[(static_cast<size_t>(shift) * height_ + y) * wordsPerRow_];
+	}
+}
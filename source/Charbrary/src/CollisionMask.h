@@ -0,0 +1,80 @@
+#pragma once
+
+#include "AABB.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Pixel-perfect collision shape : a grid of solid or empty pixels, placed at a position.
+	 *
+	 * A mask placed at a position covers the AABB aabb(position), each pixel being a 1x1 square.
+	 * Positions are rounded down to whole pixels, the masks don't rotate nor scale.
+	 *
+	 * The pixels are stored one bit per pixel, each row padded to a multiple of 64 pixels. The mask
+	 * also keeps its rows shifted by every offset from 0 to 63 pixels, so that two masks can be
+	 * tested 64 pixels at a time with a single AND whatever their relative position. This costs
+	 * 64 times the memory of the pixels (32 KiB for a 64x64 mask) : the masks are meant for sprites.
+	 */
+	class CollisionMask {
+
+	public:
+
+		/**
+		 * \brief Constructs a mask from the alpha channel of a sprite.
+		 * \param width Number of columns.
+		 * \param height Number of rows.
+		 * \param alpha Alpha of each pixel, row by row (pixel (x, y) at x + y * width).
+		 * \param threshold Pixels with an alpha greater than this value are solid.
+		 * \throws std::invalid_argument If the mask is empty or if the size of alpha isn't width * height.
+		 */
+		CollisionMask(std::uint32_t width, std::uint32_t height, const std::vector<std::uint8_t>& alpha, std::uint8_t threshold = 0);
+
+		/**
+		 * \return true if the pixel is solid, false if it's empty or outside of the mask.
+		 */
+		bool isSolid(std::int64_t x, std::int64_t y) const;
+
+		/**
+		 * \return The AABB covered by the mask placed at the position.
+		 */
+		AABB aabb(const vec_t& position) const;
+
+		/**
+		 * \brief Tests if two masks have a solid pixel in common.
+		 *
+		 * The AABBs of the masks are tested first, then only the rows and words of their overlap
+		 * are compared. Returns as soon as a common pixel is found.
+		 *
+		 * \param position Position of this mask.
+		 * \param other The other mask.
+		 * \param otherPosition Position of the other mask.
+		 * \return true if the masks overlap.
+		 */
+		bool intersects(const vec_t& position, const CollisionMask& other, const vec_t& otherPosition) const;
+
+		/**
+		 * \return The number of columns.
+		 */
+		std::uint32_t width() const;
+
+		/**
+		 * \return The number of rows.
+		 */
+		std::uint32_t height() const;
+
+	private:
+
+		/**
+		 * \return The first word of a row of the pixels shifted by a number of pixels to the right.
+		 */
+		const std::uint64_t* shiftedRow(std::uint32_t shift, std::uint32_t y) const;
+
+		std::uint32_t width_; /**< Number of columns. */
+		std::uint32_t height_; /**< Number of rows. */
+		std::uint32_t wordsPerRow_; /**< Number of 64-bit words of a shifted row (one more than needed for the pixels). */
+		std::vector<std::uint64_t> shiftedRows_; /**< The rows shifted by 0 to 63 pixels, one bit per pixel. */
+	};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Represents the type of a ContactEvent.
+	 */
+	enum class ContactEventType {
+		Begin, /**< The shapes started touching during the frame. */
+		End, /**< The shapes stopped touching during the frame (or the pair left the broadphase). */
+		MAX_VALUE
+	};
+
+	/**
+	 * \brief Reports a change of the contact state of a pair, as returned by PairCache::endFrame().
+	 */
+	struct ContactEvent {
+		ContactEventType type; /**< Whether the contact began or ended. */
+		std::uint32_t first; /**< Lowest handle of the pair. */
+		std::uint32_t other; /**< Highest handle of the pair. */
+	};
+}
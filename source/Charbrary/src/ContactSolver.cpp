@@ -0,0 +1,356 @@
+#include "ContactSolver.h"
+#include "Constants.h"
+#include "vector_maths_functions.h"
+#include "parallel_functions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace ch {
+
+	constexpr float CONTACT_SOLVER_CORRECTION_FACTOR = 0.2f; /**< Part of the remaining penetration corrected by a position iteration. */
+	constexpr float CONTACT_SOLVER_WARM_START_COSINE = 0.9f; /**< Cosine of the largest angle between the normals of a pair on two ticks for its impulses to be reused. */
+	constexpr size_t CONTACT_SOLVER_COLORS = 64; /**< Colors available to the parallel iterations, the contacts that don't fit in them are solved on a single thread. */
+	constexpr size_t CONTACT_SOLVER_MIN_CHUNK_SIZE = 256;
+
+	/**
+	 * \brief Point where the threads of a solve() wait for each other before going to the next color.
+	 */
+	struct ContactSolverBarrier {
+		unsigned int threadCount; /**< Number of threads that must arrive before any of them goes on. */
+		std::atomic<unsigned int> arrived; /**< Number of threads waiting. */
+		std::atomic<unsigned int> generation; /**< Number of times every thread arrived. */
+	};
+
+	/**
+	 * \brief Waits until every thread of the barrier called this function.
+	 *
+	 * The threads spin (yielding) instead of sleeping : a color only takes a few microseconds to solve.
+	 */
+	static void contact_solver_wait(ContactSolverBarrier& barrier) {
+		const unsigned int generation = barrier.generation.load(std::memory_order_acquire);
+		if (barrier.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == barrier.threadCount) {
+			barrier.arrived.store(0, std::memory_order_relaxed);
+			barrier.generation.fetch_add(1, std::memory_order_release);
+			return;
+		}
+		while (barrier.generation.load(std::memory_order_acquire) == generation) {
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	 * \brief Key of a pair of bodies, independent of their order.
+	 */
+	static std::uint64_t contact_solver_key(std::uint32_t first, std::uint32_t other) {
+		return (static_cast<std::uint64_t>(std::min(first, other)) << 32) | std::max(first, other);
+	}
+
+	/**
+	 * \brief Applies an impulse to the other body of a contact and the opposite impulse to the first one.
+	 *
+	 * The static bodies are never written : the contacts of a color can share them while being solved in parallel.
+	 */
+	static void contact_solver_apply(std::vector<vec_t>& values, std::uint32_t first, std::uint32_t other, const vec_t& impulse, float firstInverseMass, float otherInverseMass) {
+		if (firstInverseMass > 0.f) {
+			values[first] -= impulse * firstInverseMass;
+		}
+		if (otherInverseMass > 0.f) {
+			values[other] += impulse * otherInverseMass;
+		}
+	}
+
+	ContactSolver::ContactSolver(unsigned int velocityIterations, unsigned int positionIterations, float slop, float restitutionThreshold, unsigned int threadCount) :
+		velocityIterations_(velocityIterations),
+		positionIterations_(positionIterations),
+		slop_(slop),
+		restitutionThreshold_(restitutionThreshold),
+		threadCount_(threadCount),
+		firsts_(),
+		others_(),
+		normals_(),
+		depths_(),
+		restitutions_(),
+		frictions_(),
+		masses_(),
+		velocityBiases_(),
+		normalImpulses_(),
+		tangentImpulses_(),
+		order_(),
+		colorStarts_(),
+		bodyColors_(),
+		startPositions_(),
+		warmKeys_(),
+		warmNormals_(),
+		warmNormalImpulses_(),
+		warmTangentImpulses_()
+	{}
+
+	void ContactSolver::newFrame() {
+		// The impulses are kept sorted by pair, so that prepare() finds them with a binary search
+		order_.resize(firsts_.size());
+		std::iota(order_.begin(), order_.end(), 0);
+		std::sort(order_.begin(), order_.end(), [&](std::uint32_t a, std::uint32_t b) {
+			return contact_solver_key(firsts_[a], others_[a]) < contact_solver_key(firsts_[b], others_[b]);
+		});
+
+		warmKeys_.clear();
+		warmNormals_.clear();
+		warmNormalImpulses_.clear();
+		warmTangentImpulses_.clear();
+		for (std::uint32_t contact : order_) {
+			warmKeys_.push_back(contact_solver_key(firsts_[contact], others_[contact]));
+			// Normal oriented from the lowest body to the highest one
+			warmNormals_.push_back(firsts_[contact] < others_[contact] ? normals_[contact] : -normals_[contact]);
+			warmNormalImpulses_.push_back(normalImpulses_[contact]);
+			warmTangentImpulses_.push_back(tangentImpulses_[contact]);
+		}
+
+		firsts_.clear();
+		others_.clear();
+		normals_.clear();
+		depths_.clear();
+		restitutions_.clear();
+		frictions_.clear();
+		masses_.clear();
+		velocityBiases_.clear();
+		normalImpulses_.clear();
+		tangentImpulses_.clear();
+		order_.clear();
+		colorStarts_.clear();
+	}
+
+	void ContactSolver::addContact(std::uint32_t first, std::uint32_t other, const vec_t& normal, float depth, float restitution, float friction) {
+		if (first == other) {
+			throw std::invalid_argument("Invalid argument : a contact must reference two different bodies.");
+		}
+		if (normal == NULL_VEC) {
+			return;
+		}
+
+		firsts_.push_back(first);
+		others_.push_back(other);
+		normals_.push_back(normal);
+		depths_.push_back(depth);
+		restitutions_.push_back(restitution);
+		frictions_.push_back(friction);
+		masses_.push_back(0.f);
+		velocityBiases_.push_back(0.f);
+		normalImpulses_.push_back(0.f);
+		tangentImpulses_.push_back(0.f);
+	}
+
+	void ContactSolver::addContact(std::uint32_t first, std::uint32_t other, const AABBCollision& collision, float restitution, float friction) {
+		addContact(first, other, collision.normal, collision.absolutePenetrationDepthAlongNormal(), restitution, friction);
+	}
+
+	void ContactSolver::addContact(std::uint32_t first, std::uint32_t other, const CirclesCollision& collision, float restitution, float friction) {
+		addContact(first, other, collision.normal, collision.absoluteDepth, restitution, friction);
+	}
+
+	void ContactSolver::addContact(std::uint32_t aabb, std::uint32_t circle, const CircleAABBCollision& collision, float restitution, float friction) {
+		addContact(aabb, circle, collision.normal, collision.absoluteDepth, restitution, friction);
+	}
+
+	void ContactSolver::solve(std::vector<vec_t>& positions, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses, float dt) {
+		if (positions.size() != velocities.size() || positions.size() != inverseMasses.size()) {
+			throw std::invalid_argument("Invalid argument : the positions, velocities and inverse masses must have the same size.");
+		}
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			if (firsts_[contact] >= positions.size() || others_[contact] >= positions.size()) {
+				throw std::invalid_argument("Invalid argument : a contact references a body that doesn't exist.");
+			}
+		}
+
+		color(inverseMasses);
+		prepare(velocities, inverseMasses);
+		startPositions_ = positions;
+
+		// Only as many threads as the largest color needs
+		unsigned int threads = threadCount_ == 0 ? default_thread_count() : threadCount_;
+		size_t largestColor = 0;
+		for (size_t color = 0; color + 1 < colorStarts_.size() && color < CONTACT_SOLVER_COLORS; ++color) {
+			largestColor = std::max(largestColor, colorStarts_[color + 1] - colorStarts_[color]);
+		}
+		threads = static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(threads, (largestColor + CONTACT_SOLVER_MIN_CHUNK_SIZE - 1) / CONTACT_SOLVER_MIN_CHUNK_SIZE)));
+
+		// A single parallel region for the whole solve, the threads wait for each other between the colors
+		ContactSolverBarrier barrier{ threads, { 0 }, { 0 } };
+		parallel_for(threads, [&](size_t thread, size_t, size_t) {
+			for (unsigned int iteration = 0; iteration < velocityIterations_; ++iteration) {
+				forEachColor(thread, barrier, [&](size_t contact) {
+					solveVelocity(contact, velocities, inverseMasses);
+				});
+			}
+
+			const size_t bodiesPerThread = (positions.size() + threads - 1) / threads;
+			for (size_t body = thread * bodiesPerThread; body < std::min(positions.size(), (thread + 1) * bodiesPerThread); ++body) {
+				positions[body] += velocities[body] * dt;
+			}
+			if (threads > 1) {
+				contact_solver_wait(barrier);
+			}
+
+			for (unsigned int iteration = 0; iteration < positionIterations_; ++iteration) {
+				forEachColor(thread, barrier, [&](size_t contact) {
+					solvePosition(contact, positions, inverseMasses);
+				});
+			}
+		}, threads, 1);
+	}
+
+	size_t ContactSolver::size() const {
+		return firsts_.size();
+	}
+
+	size_t ContactSolver::colorCount() const {
+		return colorStarts_.empty() ? 0 : colorStarts_.size() - 1;
+	}
+
+	float ContactSolver::normalImpulse(size_t contact) const {
+		return normalImpulses_.at(contact);
+	}
+
+	float ContactSolver::tangentImpulse(size_t contact) const {
+		return tangentImpulses_.at(contact);
+	}
+
+	void ContactSolver::prepare(std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses) {
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			const std::uint32_t first = firsts_[contact];
+			const std::uint32_t other = others_[contact];
+			const vec_t& normal = normals_[contact];
+
+			const float inverseMass = inverseMasses[first] + inverseMasses[other];
+			masses_[contact] = inverseMass > 0.f ? 1.f / inverseMass : 0.f;
+
+			// The contact bounces if the bodies approach each other fast enough
+			const float normalSpeed = vec_dot_product(velocities[other] - velocities[first], normal);
+			velocityBiases_[contact] = normalSpeed < -restitutionThreshold_ ? -restitutions_[contact] * normalSpeed : 0.f;
+
+			// Warm starting
+			const std::uint64_t key = contact_solver_key(first, other);
+			auto it = std::lower_bound(warmKeys_.begin(), warmKeys_.end(), key);
+			if (it == warmKeys_.end() || *it != key) {
+				continue;
+			}
+			const size_t warm = it - warmKeys_.begin();
+			const vec_t warmNormal = first < other ? warmNormals_[warm] : -warmNormals_[warm];
+			if (vec_dot_product(warmNormal, normal) < CONTACT_SOLVER_WARM_START_COSINE) {
+				continue;
+			}
+			normalImpulses_[contact] = warmNormalImpulses_[warm];
+			tangentImpulses_[contact] = warmTangentImpulses_[warm];
+
+			const vec_t impulse = normal * normalImpulses_[contact] + vec_t(-normal.y, normal.x) * tangentImpulses_[contact];
+			contact_solver_apply(velocities, first, other, impulse, inverseMasses[first], inverseMasses[other]);
+		}
+	}
+
+	void ContactSolver::color(const std::vector<float>& inverseMasses) {
+		// Greedy coloring : each contact takes the first color that none of the contacts of its dynamic bodies use
+		bodyColors_.assign(inverseMasses.size(), 0);
+		std::vector<std::uint8_t> colors(firsts_.size());
+		std::vector<size_t> counts(CONTACT_SOLVER_COLORS + 1, 0);
+		size_t colorCount = 0;
+
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			const std::uint32_t first = firsts_[contact];
+			const std::uint32_t other = others_[contact];
+			// Static bodies aren't written by the contacts, they can be shared by contacts of the same color
+			const bool firstDynamic = inverseMasses[first] > 0.f;
+			const bool otherDynamic = inverseMasses[other] > 0.f;
+
+			const std::uint64_t used = (firstDynamic ? bodyColors_[first] : 0) | (otherDynamic ? bodyColors_[other] : 0);
+			size_t color = 0;
+			while (color < CONTACT_SOLVER_COLORS && (used >> color) & 1) {
+				++color;
+			}
+			if (color < CONTACT_SOLVER_COLORS) {
+				const std::uint64_t bit = std::uint64_t(1) << color;
+				if (firstDynamic) {
+					bodyColors_[first] |= bit;
+				}
+				if (otherDynamic) {
+					bodyColors_[other] |= bit;
+				}
+			}
+
+			colors[contact] = static_cast<std::uint8_t>(color);
+			++counts[color];
+			colorCount = std::max(colorCount, color + 1);
+		}
+
+		// Counting sort of the contacts by color
+		colorStarts_.assign(colorCount + 1, 0);
+		for (size_t color = 0; color < colorCount; ++color) {
+			colorStarts_[color + 1] = colorStarts_[color] + counts[color];
+		}
+		std::vector<size_t> next(colorStarts_.begin(), colorStarts_.end() - 1);
+		order_.resize(firsts_.size());
+		for (size_t contact = 0; contact < firsts_.size(); ++contact) {
+			order_[next[colors[contact]]++] = static_cast<std::uint32_t>(contact);
+		}
+	}
+
+	template<typename Function>
+	void ContactSolver::forEachColor(size_t thread, ContactSolverBarrier& barrier, const Function& function) const {
+		for (size_t color = 0; color + 1 < colorStarts_.size(); ++color) {
+			const size_t start = colorStarts_[color];
+			const size_t count = colorStarts_[color + 1] - start;
+			// Same chunks as parallel_for(). The contacts that didn't fit in the colors share bodies : one thread only
+			const size_t chunks = color < CONTACT_SOLVER_COLORS ? std::max<size_t>(1, std::min<size_t>(barrier.threadCount, (count + CONTACT_SOLVER_MIN_CHUNK_SIZE - 1) / CONTACT_SOLVER_MIN_CHUNK_SIZE)) : 1;
+			const size_t chunkSize = (count + chunks - 1) / chunks;
+			for (size_t i = start + thread * chunkSize; i < start + std::min(count, (thread + 1) * chunkSize); ++i) {
+				function(order_[i]);
+			}
+			if (barrier.threadCount > 1) {
+				contact_solver_wait(barrier);
+			}
+		}
+	}
+
+	void ContactSolver::solveVelocity(size_t contact, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses) {
+		const std::uint32_t first = firsts_[contact];
+		const std::uint32_t other = others_[contact];
+		const vec_t& normal = normals_[contact];
+		const vec_t tangent(-normal.y, normal.x);
+		const float firstInverseMass = inverseMasses[first];
+		const float otherInverseMass = inverseMasses[other];
+		const float mass = masses_[contact];
+
+		// Friction, bounded by the normal impulse
+		vec_t relativeVelocity = velocities[other] - velocities[first];
+		const float maxFriction = frictions_[contact] * normalImpulses_[contact];
+		const float previousTangentImpulse = tangentImpulses_[contact];
+		tangentImpulses_[contact] = std::max(-maxFriction, std::min(maxFriction, previousTangentImpulse - mass * vec_dot_product(relativeVelocity, tangent)));
+		const vec_t tangentImpulse = tangent * (tangentImpulses_[contact] - previousTangentImpulse);
+		contact_solver_apply(velocities, first, other, tangentImpulse, firstInverseMass, otherInverseMass);
+
+		// The accumulated normal impulse can only push the bodies apart
+		relativeVelocity = velocities[other] - velocities[first];
+		const float previousNormalImpulse = normalImpulses_[contact];
+		normalImpulses_[contact] = std::max(0.f, previousNormalImpulse + mass * (velocityBiases_[contact] - vec_dot_product(relativeVelocity, normal)));
+		const vec_t normalImpulse = normal * (normalImpulses_[contact] - previousNormalImpulse);
+		contact_solver_apply(velocities, first, other, normalImpulse, firstInverseMass, otherInverseMass);
+	}
+
+	void ContactSolver::solvePosition(size_t contact, std::vector<vec_t>& positions, const std::vector<float>& inverseMasses) {
+		const std::uint32_t first = firsts_[contact];
+		const std::uint32_t other = others_[contact];
+		const vec_t& normal = normals_[contact];
+
+		// Penetration left after the bodies moved since the beginning of the tick
+		const vec_t displacement = (positions[other] - startPositions_[other]) - (positions[first] - startPositions_[first]);
+		const float depth = depths_[contact] - vec_dot_product(displacement, normal);
+		if (depth <= slop_) {
+			return;
+		}
+
+		const vec_t correction = normal * (CONTACT_SOLVER_CORRECTION_FACTOR * (depth - slop_) * masses_[contact]);
+		contact_solver_apply(positions, first, other, correction, inverseMasses[first], inverseMasses[other]);
+	}
+}
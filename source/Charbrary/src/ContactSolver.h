@@ -0,0 +1,180 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABBCollision.h"
+#include "CirclesCollision.h"
+#include "CircleAABBCollision.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	struct ContactSolverBarrier;
+
+	/**
+	 * \brief Resolves the contacts between bodies with impulses (sequential impulses).
+	 *
+	 * Instead of pushing the colliding bodies apart, the solver changes their velocities so
+	 * that they stop approaching each other (with restitution and friction), then corrects the
+	 * remaining penetration with a few position iterations. The bodies only translate : the
+	 * collision structs don't give a contact point, so no angular velocity is involved.
+	 *
+	 * The contacts are stored in arrays (one array per field) and colored so that two contacts of
+	 * the same color never share a dynamic body : the contacts of a color are independent and are
+	 * solved in parallel, the colors one after the other. The threads are started once per solve()
+	 * and wait for each other between the colors. The result doesn't depend on the number of threads.
+	 *
+	 * The impulses of the previous tick are used as the starting point of the pairs that are
+	 * still touching (warm starting), which makes stacks of bodies converge in few iterations.
+	 *
+	 * Usage, once per tick :
+	 * - newFrame()
+	 * - addContact() for every pair of colliding bodies (see collision::aabb_collision_info() for example)
+	 * - external forces added to the velocities, then solve()
+	 */
+	class ContactSolver {
+
+	public:
+
+		/**
+		 * \brief Constructs a solver without any contact.
+		 * \param velocityIterations Number of passes over the contacts to solve the velocities.
+		 * \param positionIterations Number of passes over the contacts to correct the penetration.
+		 * \param slop Penetration that is allowed and left uncorrected, which prevents resting contacts from jittering.
+		 * \param restitutionThreshold Approach speed under which the contacts don't bounce.
+		 * \param threadCount Maximum number of threads to use. 0 means default_thread_count().
+		 */
+		ContactSolver(unsigned int velocityIterations = 8, unsigned int positionIterations = 3, float slop = 0.01f, float restitutionThreshold = 1.f, unsigned int threadCount = 1);
+
+		/**
+		 * \brief Starts a new tick : forgets the contacts and keeps their impulses for warm starting.
+		 */
+		void newFrame();
+
+		/**
+		 * \brief Adds a contact between two bodies. Does nothing if the normal is NULL_VEC (no collision).
+		 *
+		 * \param first Index of the first body.
+		 * \param other Index of the other body, the one pushed along the normal.
+		 * \param normal Normal of the collision, unit vector.
+		 * \param depth Penetration depth of the collision (positive).
+		 * \param restitution Bounciness of the contact (0 : no bounce, 1 : elastic).
+		 * \param friction Coefficient of friction of the contact.
+		 * \throws std::invalid_argument If both bodies are the same.
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other, const vec_t& normal, float depth, float restitution, float friction);
+
+		/**
+		 * \brief Same as addContact(std::uint32_t, std::uint32_t, const vec_t&, float, float, float), from the result of collision::aabb_collision_info(first, other).
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other, const AABBCollision& collision, float restitution, float friction);
+
+		/**
+		 * \brief Same as addContact(std::uint32_t, std::uint32_t, const vec_t&, float, float, float), from the result of collision::circles_collision_info(first, other).
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other, const CirclesCollision& collision, float restitution, float friction);
+
+		/**
+		 * \brief Same as addContact(std::uint32_t, std::uint32_t, const vec_t&, float, float, float), from the result of collision::circle_aabb_collision_info(aabb, circle).
+		 * \param aabb Index of the body of the AABB.
+		 * \param circle Index of the body of the circle.
+		 */
+		void addContact(std::uint32_t aabb, std::uint32_t circle, const CircleAABBCollision& collision, float restitution, float friction);
+
+		/**
+		 * \brief Solves the contacts of the tick and moves the bodies.
+		 *
+		 * The positions of every body are integrated with their velocities, including the bodies
+		 * without any contact.
+		 *
+		 * \param positions Position of each body, indexed by the identifiers given to addContact().
+		 * \param velocities Velocity of each body, including the external forces (gravity...) of the tick.
+		 * \param inverseMasses Inverse of the mass of each body. 0 for static bodies, which are never moved by the contacts.
+		 * \param dt Duration of the tick, in seconds.
+		 * \throws std::invalid_argument If the arrays don't have the same size or if a contact references a body out of them.
+		 */
+		void solve(std::vector<vec_t>& positions, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses, float dt);
+
+		/**
+		 * \return The number of contacts of the tick.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return The number of colors used by the last solve().
+		 */
+		size_t colorCount() const;
+
+		/**
+		 * \return The impulse applied along the normal of a contact by the last solve(), in the order the contacts were added.
+		 * \throws std::out_of_range If the contact doesn't exist.
+		 */
+		float normalImpulse(size_t contact) const;
+
+		/**
+		 * \return The friction impulse applied to a contact by the last solve(), in the order the contacts were added.
+		 * \throws std::out_of_range If the contact doesn't exist.
+		 */
+		float tangentImpulse(size_t contact) const;
+
+	private:
+
+		/**
+		 * \brief Computes the masses and biases of the contacts and applies the impulses of the previous tick.
+		 */
+		void prepare(std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses);
+
+		/**
+		 * \brief Assigns a color to every contact and sorts the contacts by color.
+		 */
+		void color(const std::vector<float>& inverseMasses);
+
+		/**
+		 * \brief Calls the function on the part of every color given to a thread of solve(), color after color.
+		 *
+		 * Every thread of the barrier must call it : they wait for each other at the end of each color.
+		 *
+		 * \param thread Index of the calling thread, between 0 and the number of threads of the barrier - 1.
+		 */
+		template<typename Function>
+		void forEachColor(size_t thread, ContactSolverBarrier& barrier, const Function& function) const;
+
+		/**
+		 * \brief Applies the friction and normal impulses that stop the bodies of a contact from approaching each other.
+		 */
+		void solveVelocity(size_t contact, std::vector<vec_t>& velocities, const std::vector<float>& inverseMasses);
+
+		/**
+		 * \brief Moves the bodies of a contact to correct part of their remaining penetration.
+		 */
+		void solvePosition(size_t contact, std::vector<vec_t>& positions, const std::vector<float>& inverseMasses);
+
+		unsigned int velocityIterations_; /**< Number of passes over the contacts to solve the velocities. */
+		unsigned int positionIterations_; /**< Number of passes over the contacts to correct the penetration. */
+		float slop_; /**< Penetration left uncorrected. */
+		float restitutionThreshold_; /**< Approach speed under which the contacts don't bounce. */
+		unsigned int threadCount_; /**< Maximum number of threads to use. */
+
+		std::vector<std::uint32_t> firsts_; /**< First body of each contact. */
+		std::vector<std::uint32_t> others_; /**< Other body of each contact, pushed along the normal. */
+		std::vector<vec_t> normals_; /**< Normal of each contact. */
+		std::vector<float> depths_; /**< Penetration depth of each contact at the beginning of the tick. */
+		std::vector<float> restitutions_; /**< Restitution of each contact. */
+		std::vector<float> frictions_; /**< Coefficient of friction of each contact. */
+		std::vector<float> masses_; /**< Effective mass of each contact (the inverse of the sum of the inverse masses of its bodies). */
+		std::vector<float> velocityBiases_; /**< Normal speed each contact must reach, to bounce. */
+		std::vector<float> normalImpulses_; /**< Accumulated normal impulse of each contact. */
+		std::vector<float> tangentImpulses_; /**< Accumulated friction impulse of each contact. */
+
+		std::vector<std::uint32_t> order_; /**< Contacts sorted by color. */
+		std::vector<size_t> colorStarts_; /**< Index in order_ of the first contact of each color, plus the total count. */
+		std::vector<std::uint64_t> bodyColors_; /**< Colors already used by the contacts of each body, one bit per color. */
+		std::vector<vec_t> startPositions_; /**< Positions of the bodies at the beginning of solve(). */
+
+		std::vector<std::uint64_t> warmKeys_; /**< Sorted keys of the pairs of the previous tick. */
+		std::vector<vec_t> warmNormals_; /**< Normal of each pair of the previous tick. */
+		std::vector<float> warmNormalImpulses_; /**< Normal impulse of each pair of the previous tick. */
+		std::vector<float> warmTangentImpulses_; /**< Friction impulse of each pair of the previous tick. */
+	};
+}
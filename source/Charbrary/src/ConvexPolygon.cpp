@@ -0,0 +1,99 @@
+#include "ConvexPolygon.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ch {
+
+	ConvexPolygon::ConvexPolygon(const std::vector<vec_t>& vertices) : vertices_(), normals_(), count_(vertices.size()), bounds_() {
+		if (count_ < 3 || count_ > MAX_VERTICES) {
+			throw std::invalid_argument("Invalid argument : a ConvexPolygon must have between 3 and MAX_VERTICES vertices");
+		}
+
+		// Every vertex must be on the inner side of every edge : the polygon turns once, in the direction of its area
+		float area = 0.f;
+		for (size_t i = 0; i < count_; ++i) {
+			area += vec_cross_product(vertices[i], vertices[(i + 1) % count_]);
+		}
+		if (area == 0.f) {
+			throw std::invalid_argument("Invalid argument : the vertices of a ConvexPolygon must form a convex polygon");
+		}
+		for (size_t i = 0; i < count_; ++i) {
+			const vec_t edge = vertices[(i + 1) % count_] - vertices[i];
+			if (edge == NULL_VEC) {
+				throw std::invalid_argument("Invalid argument : two consecutive vertices of a ConvexPolygon can't be equal");
+			}
+			for (size_t j = 0; j < count_; ++j) {
+				if (vec_cross_product(edge, vertices[j] - vertices[i]) * area < 0.f) {
+					throw std::invalid_argument("Invalid argument : the vertices of a ConvexPolygon must form a convex polygon");
+				}
+			}
+		}
+
+		// The vertices are stored in the order that makes the area positive
+		for (size_t i = 0; i < count_; ++i) {
+			vertices_[i] = area > 0.f ? vertices[i] : vertices[count_ - 1 - i];
+		}
+		update();
+	}
+
+	ConvexPolygon::ConvexPolygon(const AABB& aabb) : ConvexPolygon(std::vector<vec_t>{
+		aabb.corner(Corner::TopLeft),
+		aabb.corner(Corner::TopRight),
+		aabb.corner(Corner::BottomRight),
+		aabb.corner(Corner::BottomLeft) }) {}
+
+	void ConvexPolygon::move(const vec_t& movement) {
+		for (size_t i = 0; i < count_; ++i) {
+			vertices_[i] += movement;
+		}
+		bounds_.move(movement);
+	}
+
+	void ConvexPolygon::rotate(float angle) {
+		const vec_t pivot = center();
+		for (size_t i = 0; i < count_; ++i) {
+			vertices_[i] = pivot + vec_rotate(vertices_[i] - pivot, angle);
+		}
+		update();
+	}
+
+	const vec_t& ConvexPolygon::vertex(size_t index) const {
+		return vertices_[index];
+	}
+
+	const vec_t& ConvexPolygon::normal(size_t index) const {
+		return normals_[index];
+	}
+
+	size_t ConvexPolygon::size() const {
+		return count_;
+	}
+
+	vec_t ConvexPolygon::center() const {
+		vec_t sum(0.f, 0.f);
+		for (size_t i = 0; i < count_; ++i) {
+			sum += vertices_[i];
+		}
+		return sum / static_cast<float>(count_);
+	}
+
+	const Bounds& ConvexPolygon::bounds() const {
+		return bounds_;
+	}
+
+	AABB ConvexPolygon::aabb() const {
+		return bounds_.toAABB();
+	}
+
+	void ConvexPolygon::update() {
+		bounds_ = Bounds(vertices_[0], vertices_[0]);
+		for (size_t i = 0; i < count_; ++i) {
+			const vec_t& current = vertices_[i];
+			const vec_t edge = vertices_[(i + 1) % count_] - current;
+			normals_[i] = vec_normalize(vec_t(edge.y, -edge.x));
+			bounds_.min = vec_t(std::min(bounds_.min.x, current.x), std::min(bounds_.min.y, current.y));
+			bounds_.max = vec_t(std::max(bounds_.max.x, current.x), std::max(bounds_.max.y, current.y));
+		}
+	}
+}
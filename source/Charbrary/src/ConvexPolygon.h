@@ -0,0 +1,99 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABB.h"
+#include "Bounds.h"
+
+#include <array>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Represents a convex polygon with a small number of vertices.
+	 *
+	 * The vertices are stored inside the object (no allocation), along with the normal of
+	 * every edge and the bounds of the polygon, so the collision tests (see
+	 * collision::polygon_collision_info()) don't have to recompute them.
+	 *
+	 * The vertices are reordered at construction so that they always turn in the same
+	 * direction : the normal of the edge going from vertex(i) to vertex(i + 1) points out
+	 * of the polygon.
+	 */
+	class ConvexPolygon {
+
+	public:
+
+		static constexpr size_t MAX_VERTICES = 8; /**< Maximum number of vertices of a polygon. */
+
+	public:
+
+		/**
+		 * \brief Constructs a polygon from its vertices.
+		 *
+		 * \param vertices The vertices, in clockwise or counter-clockwise order.
+		 * \throws std::invalid_argument If there are less than 3 or more than MAX_VERTICES vertices,
+		 * 		   or if the polygon is not convex (or is flat, has two equal consecutive vertices or crosses itself).
+		 */
+		ConvexPolygon(const std::vector<vec_t>& vertices);
+
+		/**
+		 * \brief Constructs a polygon from the 4 corners of an AABB.
+		 */
+		explicit ConvexPolygon(const AABB& aabb);
+
+		/**
+		 * \brief Moves the polygon by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
+
+		/**
+		 * \brief Rotates the polygon around its center.
+		 * \param angle Angle in degrees.
+		 */
+		void rotate(float angle);
+
+		/**
+		 * \return The vertex at the given index.
+		 */
+		const vec_t& vertex(size_t index) const;
+
+		/**
+		 * \return The outward unit normal of the edge going from vertex(index) to vertex(index + 1).
+		 */
+		const vec_t& normal(size_t index) const;
+
+		/**
+		 * \return The number of vertices (and of edges) of the polygon.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return The average of the vertices.
+		 */
+		vec_t center() const;
+
+		/**
+		 * \return The bounds of the polygon.
+		 */
+		const Bounds& bounds() const;
+
+		/**
+		 * \return The smallest AABB containing the polygon.
+		 */
+		AABB aabb() const;
+
+	private:
+
+		/**
+		 * \brief Recomputes the normals and the bounds from the vertices.
+		 */
+		void update();
+
+		std::array<vec_t, MAX_VERTICES> vertices_; /**< The vertices, only the first count_ are used. */
+		std::array<vec_t, MAX_VERTICES> normals_; /**< Outward normal of each edge. */
+		size_t count_; /**< Number of vertices. */
+		Bounds bounds_; /**< Bounds of the vertices. */
+	};
+}
@@ -0,0 +1,234 @@
+#include "DistanceField.h"
+#include "Constants.h"
+#include "collision_functions.h"
+#include "parallel_functions.h"
+#include "vector_maths_functions.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr size_t DISTANCE_FIELD_MIN_ROWS_PER_TASK = 16;
+		constexpr std::uint32_t DISTANCE_FIELD_NO_SHAPE = 0xFFFFFFFF;
+
+		/**
+		 * \brief Computes the signed distance from a point to a shape of the geometry.
+		 * \param shape Index of the shape : the AABBs come first, then the circles, then the segments.
+		 */
+		static float distance_field_shape_distance(const std::vector<AABB>& aabbs, const std::vector<Circle>& circles, const std::vector<LineSegment>& segments, std::uint32_t shape, const vec_t& point) {
+			if (shape < aabbs.size()) {
+				const vec_t halfSize = aabbs[shape].size / 2.f;
+				const vec_t center = aabbs[shape].pos + halfSize;
+				const vec_t q(std::abs(point.x - center.x) - halfSize.x, std::abs(point.y - center.y) - halfSize.y);
+				return vec_magnitude(vec_t(std::max(q.x, 0.f), std::max(q.y, 0.f))) + std::min(std::max(q.x, q.y), 0.f);
+			}
+			shape -= static_cast<std::uint32_t>(aabbs.size());
+			if (shape < circles.size()) {
+				return vec_magnitude(point - circles[shape].pos) - circles[shape].radius;
+			}
+			shape -= static_cast<std::uint32_t>(circles.size());
+			return vec_magnitude(point - collision::closest_point_on_segment(segments[shape], point));
+		}
+
+		DistanceField::DistanceField(const Bounds& area, float cellSize) :
+			origin_(area.min),
+			cellSize_(cellSize),
+			columns_(0),
+			rows_(0),
+			distances_()
+		{
+			if (!(cellSize > 0.f)) {
+				throw std::invalid_argument("Invalid argument : the size of the cells must be positive.");
+			}
+			if (!(area.max.x > area.min.x) || !(area.max.y > area.min.y)) {
+				throw std::invalid_argument("Invalid argument : the area of the distance field must not be empty.");
+			}
+			columns_ = static_cast<std::uint32_t>(std::ceil((area.max.x - area.min.x) / cellSize)) + 1;
+			rows_ = static_cast<std::uint32_t>(std::ceil((area.max.y - area.min.y) / cellSize)) + 1;
+			distances_.assign(static_cast<size_t>(columns_) * rows_, std::numeric_limits<float>::max());
+		}
+
+		void DistanceField::bake(const std::vector<AABB>& aabbs, const std::vector<Circle>& circles, const std::vector<LineSegment>& segments, unsigned int threadCount) {
+			const size_t nodeCount = static_cast<size_t>(columns_) * rows_;
+			const size_t shapeCount = aabbs.size() + circles.size() + segments.size();
+			std::vector<std::uint32_t> nearest(nodeCount, DISTANCE_FIELD_NO_SHAPE);
+			std::fill(distances_.begin(), distances_.end(), std::numeric_limits<float>::max());
+
+			// 1. Seeds : exact distance from the nodes around each shape (at least the closest nodes of the grid)
+			for (std::uint32_t shape = 0; shape < shapeCount; ++shape) {
+				Bounds bounds;
+				if (shape < aabbs.size()) {
+					bounds = Bounds(aabbs[shape]);
+				}
+				else if (shape < aabbs.size() + circles.size()) {
+					const Circle& circle = circles[shape - aabbs.size()];
+					bounds = Bounds(circle.pos - vec_t(circle.radius, circle.radius), circle.pos + vec_t(circle.radius, circle.radius));
+				}
+				else {
+					bounds = collision::enclosingBounds(segments[shape - aabbs.size() - circles.size()]);
+				}
+
+				const vec_t min = (bounds.min - origin_) / cellSize_ - vec_t(1.f, 1.f);
+				const vec_t max = (bounds.max - origin_) / cellSize_ + vec_t(1.f, 1.f);
+				const std::uint32_t x0 = static_cast<std::uint32_t>(std::clamp(std::ceil(min.x), 0.f, static_cast<float>(columns_ - 1)));
+				const std::uint32_t y0 = static_cast<std::uint32_t>(std::clamp(std::ceil(min.y), 0.f, static_cast<float>(rows_ - 1)));
+				const std::uint32_t x1 = static_cast<std::uint32_t>(std::clamp(std::floor(max.x), 0.f, static_cast<float>(columns_ - 1)));
+				const std::uint32_t y1 = static_cast<std::uint32_t>(std::clamp(std::floor(max.y), 0.f, static_cast<float>(rows_ - 1)));
+				for (std::uint32_t y = y0; y <= y1; ++y) {
+					for (std::uint32_t x = x0; x <= x1; ++x) {
+						const size_t node = x + static_cast<size_t>(y) * columns_;
+						const float distance = distance_field_shape_distance(aabbs, circles, segments, shape, nodePosition(x, y));
+						if (distance < distances_[node]) {
+							distances_[node] = distance;
+							nearest[node] = shape;
+						}
+					}
+				}
+			}
+
+			if (shapeCount == 0) {
+				return;
+			}
+
+			// 2. Jump flooding : each node tries the shapes of the nodes at decreasing powers of two
+			std::vector<std::uint32_t> nextNearest(nodeCount);
+			std::vector<float> nextDistances(nodeCount);
+			const auto pass = [&](std::int64_t step) {
+				std::atomic<bool> changed(false);
+				parallel_for(rows_, [&](size_t begin, size_t end, size_t) {
+					bool rowsChanged = false;
+					for (size_t y = begin; y < end; ++y) {
+						for (std::uint32_t x = 0; x < columns_; ++x) {
+							const size_t node = x + y * columns_;
+							const vec_t position = nodePosition(x, static_cast<std::uint32_t>(y));
+							std::uint32_t bestShape = nearest[node];
+							float bestDistance = distances_[node];
+							for (std::int64_t ny = static_cast<std::int64_t>(y) - step; ny <= static_cast<std::int64_t>(y) + step; ny += step) {
+								for (std::int64_t nx = static_cast<std::int64_t>(x) - step; nx <= static_cast<std::int64_t>(x) + step; nx += step) {
+									if (nx < 0 || ny < 0 || nx >= columns_ || ny >= rows_) {
+										continue;
+									}
+									const std::uint32_t shape = nearest[nx + ny * columns_];
+									if (shape == DISTANCE_FIELD_NO_SHAPE || shape == bestShape) {
+										continue;
+									}
+									const float distance = distance_field_shape_distance(aabbs, circles, segments, shape, position);
+									if (distance < bestDistance) {
+										bestDistance = distance;
+										bestShape = shape;
+										rowsChanged = true;
+									}
+								}
+							}
+							nextNearest[node] = bestShape;
+							nextDistances[node] = bestDistance;
+						}
+					}
+					if (rowsChanged) {
+						changed = true;
+					}
+				}, threadCount, DISTANCE_FIELD_MIN_ROWS_PER_TASK);
+
+				nearest.swap(nextNearest);
+				distances_.swap(nextDistances);
+				return changed.load();
+			};
+
+			std::int64_t step = 1;
+			while (step * 2 < std::max(columns_, rows_)) {
+				step *= 2;
+			}
+			for (; step > 1; step /= 2) {
+				pass(step);
+			}
+
+			// 3. Jump flooding misses the closest shape of a few nodes : the shapes are spread to the neighbours until nothing changes
+			while (pass(1)) {
+			}
+		}
+
+		float DistanceField::distance(const vec_t& point) const {
+			std::uint32_t x, y;
+			vec_t fraction;
+			const float outside = locate(point, x, y, fraction);
+			const size_t node = x + static_cast<size_t>(y) * columns_;
+			const float top = distances_[node] + (distances_[node + 1] - distances_[node]) * fraction.x;
+			const float bottom = distances_[node + columns_] + (distances_[node + columns_ + 1] - distances_[node + columns_]) * fraction.x;
+			return top + (bottom - top) * fraction.y + outside;
+		}
+
+		vec_t DistanceField::normal(const vec_t& point) const {
+			std::uint32_t x, y;
+			vec_t fraction;
+			locate(point, x, y, fraction);
+			const size_t node = x + static_cast<size_t>(y) * columns_;
+			const float d00 = distances_[node];
+			const float d10 = distances_[node + 1];
+			const float d01 = distances_[node + columns_];
+			const float d11 = distances_[node + columns_ + 1];
+
+			// Derivatives of the bilinear interpolation
+			const vec_t gradient((d10 - d00) * (1.f - fraction.y) + (d11 - d01) * fraction.y, (d01 - d00) * (1.f - fraction.x) + (d11 - d10) * fraction.x);
+			if (!(vec_magnitude_squared(gradient) > 0.f)) {
+				return NULL_VEC;
+			}
+			return vec_normalize(gradient);
+		}
+
+		bool DistanceField::intersects(const Circle& circle) const {
+			return distance(circle.pos) < circle.radius;
+		}
+
+		float DistanceField::penetration(const Circle& circle, vec_t& normal) const {
+			const float depth = circle.radius - distance(circle.pos);
+			if (!(depth > 0.f)) {
+				return 0.f;
+			}
+			normal = this->normal(circle.pos);
+			return depth;
+		}
+
+		vec_t DistanceField::resolve(const Circle& circle) const {
+			vec_t normal;
+			const float depth = penetration(circle, normal);
+			return depth > 0.f ? normal * depth : NULL_VEC;
+		}
+
+		float DistanceField::nodeDistance(std::uint32_t x, std::uint32_t y) const {
+			if (x >= columns_ || y >= rows_) {
+				throw std::out_of_range("The node is outside of the distance field.");
+			}
+			return distances_[x + static_cast<size_t>(y) * columns_];
+		}
+
+		vec_t DistanceField::nodePosition(std::uint32_t x, std::uint32_t y) const {
+			return vec_t(origin_.x + x * cellSize_, origin_.y + y * cellSize_);
+		}
+
+		std::uint32_t DistanceField::columns() const {
+			return columns_;
+		}
+
+		std::uint32_t DistanceField::rows() const {
+			return rows_;
+		}
+
+		float DistanceField::cellSize() const {
+			return cellSize_;
+		}
+
+		float DistanceField::locate(const vec_t& point, std::uint32_t& x, std::uint32_t& y, vec_t& fraction) const {
+			const vec_t local = (point - origin_) / cellSize_;
+			const vec_t clamped(std::clamp(local.x, 0.f, static_cast<float>(columns_ - 1)), std::clamp(local.y, 0.f, static_cast<float>(rows_ - 1)));
+			x = std::min(static_cast<std::uint32_t>(clamped.x), columns_ - 2);
+			y = std::min(static_cast<std::uint32_t>(clamped.y), rows_ - 2);
+			fraction = vec_t(clamped.x - x, clamped.y - y);
+			return vec_magnitude(local - clamped) * cellSize_;
+		}
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "AABB.h"
+#include "Bounds.h"
+#include "Circle.h"
+#include "LineSegment.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Signed distance field of static geometry, baked once and queried in constant time.
+		 *
+		 * The field stores, at each node of a regular grid covering an area, the signed distance to the
+		 * closest AABB, circle or line segment of the geometry : negative inside an AABB or a circle,
+		 * positive outside. Line segments have no inside. Where shapes overlap, the distance is the
+		 * smallest of the distances to each shape, so deep inside overlapping shapes the depth is
+		 * underestimated.
+		 *
+		 * The queries interpolate the four nodes around a point (bilinear sampling), whatever the amount of
+		 * geometry. The interpolation is exact along flat walls and rounds the corners : the error is
+		 * below the size of a cell.
+		 *
+		 * The bake seeds the nodes near each shape with their exact distance to it, then spreads the
+		 * closest shape to the rest of the grid with jump flooding, one row per task. Each node ends up
+		 * with the exact distance to a shape, that is the closest one except in rare cases where another
+		 * shape is almost as close. The geometry should be inside of the area : a shape outside of it only
+		 * reaches the nodes of the border that are the closest to it, and can be hidden by other shapes.
+		 */
+		class DistanceField {
+
+		public:
+
+			/**
+			 * \brief Constructs a field without geometry (every distance is std::numeric_limits<float>::max()).
+			 * \param area The area covered by the field. Nodes are placed every cellSize from area.min, up to area.max at least.
+			 * \param cellSize Distance between two nodes.
+			 * \throws std::invalid_argument If the area is empty or if the size of the cells isn't positive.
+			 */
+			DistanceField(const Bounds& area, float cellSize);
+
+			/**
+			 * \brief Computes the distance from each node to the geometry, replacing the previous geometry.
+			 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+			 */
+			void bake(const std::vector<AABB>& aabbs, const std::vector<Circle>& circles, const std::vector<LineSegment>& segments, unsigned int threadCount = 0);
+
+			/**
+			 * \brief Samples the signed distance at a point.
+			 *
+			 * Outside of the area of the field, the distance is sampled at the closest point of the area and the
+			 * distance to this point is added.
+			 */
+			float distance(const vec_t& point) const;
+
+			/**
+			 * \brief Samples the direction in which the distance increases the fastest at a point.
+			 * \return A normalized vector pointing away from the geometry, NULL_VEC if the field is flat there.
+			 */
+			vec_t normal(const vec_t& point) const;
+
+			/**
+			 * \return true if the circle overlaps the geometry.
+			 */
+			bool intersects(const Circle& circle) const;
+
+			/**
+			 * \brief Computes how deep the circle is into the geometry.
+			 * \param normal Receives the direction in which to push the circle out, if it overlaps the geometry.
+			 * \return The penetration depth, 0 if the circle doesn't overlap the geometry.
+			 */
+			float penetration(const Circle& circle, vec_t& normal) const;
+
+			/**
+			 * \return The translation that pushes the circle out of the geometry, NULL_VEC if it doesn't overlap it.
+			 */
+			vec_t resolve(const Circle& circle) const;
+
+			/**
+			 * \return The value stored at a node.
+			 * \throws std::out_of_range If the node is outside of the grid.
+			 */
+			float nodeDistance(std::uint32_t x, std::uint32_t y) const;
+
+			/**
+			 * \return The position of a node.
+			 */
+			vec_t nodePosition(std::uint32_t x, std::uint32_t y) const;
+
+			/**
+			 * \return The number of nodes along the x axis.
+			 */
+			std::uint32_t columns() const;
+
+			/**
+			 * \return The number of nodes along the y axis.
+			 */
+			std::uint32_t rows() const;
+
+			/**
+			 * \return The distance between two nodes.
+			 */
+			float cellSize() const;
+
+		private:
+
+			/**
+			 * \brief Finds the cell containing the point, clamped to the grid.
+			 * \param x Receives the column of the top-left node of the cell.
+			 * \param y Receives the row of the top-left node of the cell.
+			 * \param fraction Receives the position of the point in the cell, between 0 and 1.
+			 * \return The distance between the point and the grid.
+			 */
+			float locate(const vec_t& point, std::uint32_t& x, std::uint32_t& y, vec_t& fraction) const;
+
+			vec_t origin_; /**< Position of node (0, 0). */
+			float cellSize_; /**< Distance between two nodes. */
+			std::uint32_t columns_; /**< Number of nodes along the x axis. */
+			std::uint32_t rows_; /**< Number of nodes along the y axis. */
+			std::vector<float> distances_; /**< Signed distance at each node, row by row. */
+		};
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "vector_type_definition.h"
+
+#include <array>
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Remembers the simplex found by collision::gjk_distance() for a pair of shapes.
+	 *
+	 * The cache stores the search directions that produced the vertices of the last simplex.
+	 * When the same pair is tested again (usually on the next frame), the simplex is rebuilt
+	 * from these directions instead of from scratch, so a pair that barely moved converges
+	 * in one or two iterations. Keep one cache per pair of shapes.
+	 */
+	struct GJKCache {
+		std::array<vec_t, 3> directions; /**< Search direction of each vertex of the simplex. */
+		std::uint32_t count = 0; /**< Number of vertices in the simplex, 0 if the cache is empty. */
+	};
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "vector_type_definition.h"
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Contains the result of collision::gjk_distance().
+	 */
+	struct GJKResult {
+		bool intersects; /**< True if the shapes overlap. Shapes that only touch do not overlap. */
+		float distance; /**< Distance between the shapes, 0 if they overlap. */
+		vec_t pointOnFirst; /**< Point of the first shape closest to the other shape. Only meaningful if the shapes don't overlap. */
+		vec_t pointOnOther; /**< Point of the other shape closest to the first shape. Only meaningful if the shapes don't overlap. */
+		std::uint32_t iterations; /**< Number of support points computed to reach the result. */
+	};
+}
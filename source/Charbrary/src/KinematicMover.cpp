@@ -0,0 +1,269 @@
+#include "KinematicMover.h"
+#include "Constants.h"
+#include "collision_functions.h"
+#include "vector_maths_functions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr size_t KINEMATIC_MOVER_RESERVED_CANDIDATES = 64;
+
+		/**
+		 * \return The bounds of the area swept by the AABB, grown by the margin.
+		 */
+		static Bounds kinematic_swept_bounds(const AABB& aabb, const vec_t& motion, float margin) {
+			const Bounds bounds(aabb);
+			return Bounds(
+				std::min(bounds.min.x, bounds.min.x + motion.x) - margin, std::min(bounds.min.y, bounds.min.y + motion.y) - margin,
+				std::max(bounds.max.x, bounds.max.x + motion.x) + margin, std::max(bounds.max.y, bounds.max.y + motion.y) + margin);
+		}
+
+		/**
+		 * \return The bounds of the area swept by the circle, grown by the margin.
+		 */
+		static Bounds kinematic_swept_bounds(const Circle& circle, const vec_t& motion, float margin) {
+			const float r = circle.radius + margin;
+			return Bounds(
+				std::min(circle.pos.x, circle.pos.x + motion.x) - r, std::min(circle.pos.y, circle.pos.y + motion.y) - r,
+				std::max(circle.pos.x, circle.pos.x + motion.x) + r, std::max(circle.pos.y, circle.pos.y + motion.y) + r);
+		}
+
+		static bool kinematic_time_of_impact(const AABB& aabb, const vec_t& motion, const AABB& obstacle, float& time, vec_t& normal) {
+			return collision::aabb_time_of_impact(aabb, motion, obstacle, time, normal);
+		}
+
+		static bool kinematic_time_of_impact(const Circle& circle, const vec_t& motion, const AABB& obstacle, float& time, vec_t& normal) {
+			return collision::circle_aabb_time_of_impact(circle, motion, obstacle, time, normal);
+		}
+
+		/**
+		 * \brief Tests if the side of an obstacle is covered by another candidate, where the moving shape overlaps the obstacle.
+		 *
+		 * Pushing the shape out through such a side only moves it into the other obstacle (e.g. the seam between two tiles of a floor).
+		 *
+		 * \param direction Direction of the push out of the obstacle (UP_VEC, DOWN_VEC, LEFT_VEC or RIGHT_VEC).
+		 * \param overlap Intersection of the bounds of the shape and of the obstacle.
+		 */
+		static bool kinematic_side_covered(const std::vector<std::uint32_t>& candidates, const std::vector<AABB>& obstacles, std::uint32_t index, const vec_t& direction, const Bounds& overlap) {
+			const Bounds obstacle(obstacles[index]);
+			const vec_t middle = overlap.center();
+			for (std::uint32_t candidate : candidates) {
+				if (candidate == index) {
+					continue;
+				}
+				const Bounds other(obstacles[candidate]);
+				if (direction.x != 0.f) {
+					const float side = direction.x > 0.f ? obstacle.max.x : obstacle.min.x;
+					const bool across = direction.x > 0.f ? other.min.x <= side && side < other.max.x : other.min.x < side && side <= other.max.x;
+					if (across && other.min.y < middle.y && middle.y < other.max.y) {
+						return true;
+					}
+				}
+				else {
+					const float side = direction.y > 0.f ? obstacle.max.y : obstacle.min.y;
+					const bool across = direction.y > 0.f ? other.min.y <= side && side < other.max.y : other.min.y < side && side <= other.max.y;
+					if (across && other.min.x < middle.x && middle.x < other.max.x) {
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * \brief Finds the candidate the AABB overlaps the most and how to push the AABB out of it.
+		 * \param index Receives the index of the obstacle.
+		 * \param normal Receives the direction towards which the AABB must be pushed.
+		 * \return The penetration depth, 0 if the AABB doesn't overlap any candidate.
+		 */
+		static float kinematic_deepest_penetration(const AABB& aabb, const std::vector<std::uint32_t>& candidates, const std::vector<AABB>& obstacles, std::uint32_t& index, vec_t& normal) {
+			const Bounds bounds(aabb);
+			const vec_t center = bounds.center();
+			float largestArea = 0.f;
+			float deepest = 0.f;
+			for (std::uint32_t candidate : candidates) {
+				const Bounds obstacle(obstacles[candidate]);
+				const Bounds overlap(std::max(bounds.min.x, obstacle.min.x), std::max(bounds.min.y, obstacle.min.y), std::min(bounds.max.x, obstacle.max.x), std::min(bounds.max.y, obstacle.max.y));
+				const float area = (overlap.max.x - overlap.min.x) * (overlap.max.y - overlap.min.y);
+				if (overlap.max.x <= overlap.min.x || overlap.max.y <= overlap.min.y || area <= largestArea) {
+					continue;
+				}
+
+				// Push out along each axis, towards the side of the obstacle closest to the center of the AABB
+				const vec_t obstacleCenter = obstacle.center();
+				const bool left = center.x < obstacleCenter.x;
+				const bool up = center.y < obstacleCenter.y;
+				const float depthX = left ? bounds.max.x - obstacle.min.x : obstacle.max.x - bounds.min.x;
+				const float depthY = up ? bounds.max.y - obstacle.min.y : obstacle.max.y - bounds.min.y;
+				const bool coveredX = kinematic_side_covered(candidates, obstacles, candidate, left ? LEFT_VEC : RIGHT_VEC, overlap);
+				const bool coveredY = kinematic_side_covered(candidates, obstacles, candidate, up ? UP_VEC : DOWN_VEC, overlap);
+				const bool alongX = coveredX == coveredY ? depthX < depthY : coveredY;
+
+				largestArea = area;
+				deepest = alongX ? depthX : depthY;
+				normal = alongX ? (left ? LEFT_VEC : RIGHT_VEC) : (up ? UP_VEC : DOWN_VEC);
+				index = candidate;
+			}
+			return deepest;
+		}
+
+		/**
+		 * \brief Finds the candidate the circle overlaps the most and how to push the circle out of it.
+		 * \param index Receives the index of the obstacle.
+		 * \param normal Receives the direction towards which the circle must be pushed.
+		 * \return The penetration depth, 0 if the circle doesn't overlap any candidate.
+		 */
+		static float kinematic_deepest_penetration(const Circle& circle, const std::vector<std::uint32_t>& candidates, const std::vector<AABB>& obstacles, std::uint32_t& index, vec_t& normal) {
+			float deepest = 0.f;
+			for (std::uint32_t candidate : candidates) {
+				const Bounds obstacle(obstacles[candidate]);
+				CircleAABBCollision collision = collision::circle_aabb_collision_info(obstacle, circle);
+				if (collision.absoluteDepth <= deepest) {
+					continue;
+				}
+
+				// Center outside of the obstacle, closest to a corner on a covered side : the circle is pushed out through the other side instead
+				const vec_t closest(std::max(obstacle.min.x, std::min(circle.pos.x, obstacle.max.x)), std::max(obstacle.min.y, std::min(circle.pos.y, obstacle.max.y)));
+				const bool cornerX = closest.x == obstacle.min.x || closest.x == obstacle.max.x;
+				const bool cornerY = closest.y == obstacle.min.y || closest.y == obstacle.max.y;
+				if (cornerX && cornerY && collision.normal.x != 0.f && collision.normal.y != 0.f) {
+					const Bounds overlap(
+						std::max(circle.pos.x - circle.radius, obstacle.min.x), std::max(circle.pos.y - circle.radius, obstacle.min.y),
+						std::min(circle.pos.x + circle.radius, obstacle.max.x), std::min(circle.pos.y + circle.radius, obstacle.max.y));
+					const vec_t sideX = collision.normal.x < 0.f ? LEFT_VEC : RIGHT_VEC;
+					const vec_t sideY = collision.normal.y < 0.f ? UP_VEC : DOWN_VEC;
+					if (kinematic_side_covered(candidates, obstacles, candidate, sideX, overlap)) {
+						collision = CircleAABBCollision{ sideY, circle.radius - std::abs(circle.pos.y - closest.y) };
+					}
+					else if (kinematic_side_covered(candidates, obstacles, candidate, sideY, overlap)) {
+						collision = CircleAABBCollision{ sideX, circle.radius - std::abs(circle.pos.x - closest.x) };
+					}
+				}
+
+				if (collision.absoluteDepth > deepest) {
+					deepest = collision.absoluteDepth;
+					normal = collision.normal;
+					index = candidate;
+				}
+			}
+			return deepest;
+		}
+
+		/**
+		 * \return The distance the AABB must be pushed along an axis-aligned direction to leave the obstacle.
+		 */
+		static float kinematic_penetration_along(const AABB& aabb, const AABB& obstacle, const vec_t& direction) {
+			const Bounds bounds(aabb);
+			const Bounds other(obstacle);
+			if (direction.x != 0.f) {
+				return direction.x > 0.f ? other.max.x - bounds.min.x : bounds.max.x - other.min.x;
+			}
+			return direction.y > 0.f ? other.max.y - bounds.min.y : bounds.max.y - other.min.y;
+		}
+
+		/**
+		 * \return The distance the circle must be pushed along an axis-aligned direction to leave the obstacle.
+		 */
+		static float kinematic_penetration_along(const Circle& circle, const AABB& obstacle, const vec_t& direction) {
+			return kinematic_penetration_along(AABB(circle.pos - vec_t(circle.radius, circle.radius), vec_t(circle.radius, circle.radius) * 2.f), obstacle, direction);
+		}
+
+		KinematicMover::KinematicMover(std::uint32_t maxIterations, float skinWidth) : maxIterations_(maxIterations), skinWidth_(skinWidth), candidates_() {
+			if (maxIterations == 0 || maxIterations > MAX_SLIDE_ITERATIONS) {
+				throw std::invalid_argument("Invalid argument : the number of iterations must be between 1 and MAX_SLIDE_ITERATIONS.");
+			}
+			candidates_.reserve(KINEMATIC_MOVER_RESERVED_CANDIDATES);
+		}
+
+		template<typename Shape>
+		MoveResult KinematicMover::move(Shape shape, vec_t motion, const LBVH& broadphase, const std::vector<AABB>& obstacles) {
+			MoveResult result;
+			const vec_t initialMotion = motion;
+
+			// Pushes the shape out of the obstacles it already overlaps, the deepest overlap first
+			vec_t previousNormal = NULL_VEC;
+			for (std::uint32_t iteration = 0; iteration < maxIterations_; ++iteration) {
+				broadphase.query(kinematic_swept_bounds(shape, NULL_VEC, 0.f), candidates_);
+				std::uint32_t index = 0;
+				vec_t normal;
+				float depth = kinematic_deepest_penetration(shape, candidates_, obstacles, index, normal);
+				if (depth <= 0.f) {
+					break;
+				}
+
+				// Pushed back where the previous push came from : the shape is inside a solid area, it keeps going through it instead
+				if (vec_dot_product(normal, previousNormal) < 0.f && (previousNormal.x == 0.f || previousNormal.y == 0.f)) {
+					normal = previousNormal;
+					depth = kinematic_penetration_along(shape, obstacles[index], normal);
+				}
+				previousNormal = normal;
+
+				shape.pos += normal * (depth + skinWidth_);
+				if (result.contactCount < MAX_SLIDE_ITERATIONS) {
+					result.contacts[result.contactCount++] = SlideContact{ index, normal, shape.pos };
+				}
+				const float approach = vec_dot_product(motion, normal);
+				if (approach < 0.f) {
+					motion -= normal * approach;
+				}
+			}
+
+			for (std::uint32_t iteration = 0; iteration < maxIterations_ && motion != NULL_VEC; ++iteration) {
+				broadphase.query(kinematic_swept_bounds(shape, motion, skinWidth_), candidates_);
+
+				// First obstacle hit along the motion
+				float earliest = 2.f;
+				vec_t earliestNormal;
+				std::uint32_t earliestIndex = 0;
+				for (std::uint32_t index : candidates_) {
+					float time;
+					vec_t normal;
+					if (kinematic_time_of_impact(shape, motion, obstacles[index], time, normal) && time < earliest) {
+						earliest = time;
+						earliestNormal = normal;
+						earliestIndex = index;
+					}
+				}
+
+				if (earliest > 1.f) {
+					shape.pos += motion;
+					motion = NULL_VEC;
+					break;
+				}
+
+				// Stops at skinWidth from the obstacle, along the motion
+				const float length = vec_magnitude(motion);
+				const float travelled = std::max(earliest - skinWidth_ / length, 0.f);
+				shape.pos += motion * travelled;
+				if (result.contactCount < MAX_SLIDE_ITERATIONS) {
+					result.contacts[result.contactCount++] = SlideContact{ earliestIndex, earliestNormal, shape.pos };
+				}
+
+				// Slides along the obstacle with the motion left, unless it goes back against the initial motion
+				motion *= 1.f - travelled;
+				const float approach = vec_dot_product(motion, earliestNormal);
+				if (approach < 0.f) {
+					motion -= earliestNormal * approach;
+				}
+				if (vec_dot_product(motion, initialMotion) <= 0.f) {
+					motion = NULL_VEC;
+				}
+			}
+
+			result.position = shape.pos;
+			return result;
+		}
+
+		MoveResult KinematicMover::moveAndSlide(const AABB& aabb, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles) {
+			return move(aabb, motion, broadphase, obstacles);
+		}
+
+		MoveResult KinematicMover::moveAndSlide(const Circle& circle, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles) {
+			return move(circle, motion, broadphase, obstacles);
+		}
+	}
+}
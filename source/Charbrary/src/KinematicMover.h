@@ -0,0 +1,79 @@
+#pragma once
+
+#include "AABB.h"
+#include "Circle.h"
+#include "LBVH.h"
+#include "MoveResult.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Moves a kinematic shape (a character) among static obstacles, sliding along the ones it hits.
+		 *
+		 * Instead of moving the shape then pushing it out of the obstacles it overlaps, the shape is
+		 * swept along its motion (see collision::aabb_time_of_impact() and collision::circle_aabb_time_of_impact())
+		 * against the obstacles found by a broadphase query. The shape stops at the first obstacle it
+		 * hits, the motion left is projected on the side of the obstacle, and the sweep is repeated
+		 * with this motion, up to maxIterations times.
+		 *
+		 * The shape stops at skinWidth from the obstacles, so that it can slide along them (a
+		 * character walking on the floor) without hitting them again. A shape that already overlaps
+		 * obstacles before moving is pushed out of them first : out of the obstacle it overlaps the
+		 * most, then the obstacles are queried again, up to maxIterations times. A side of an obstacle
+		 * covered by another obstacle (the seam between two tiles of a floor) never pushes the shape.
+		 *
+		 * The results of the broadphase queries are stored in a buffer reused between moves and the
+		 * contacts in a fixed array : a move doesn't allocate memory once the buffer is large enough.
+		 */
+		class KinematicMover {
+
+		public:
+
+			/**
+			 * \brief Constructs a mover.
+			 * \param maxIterations Largest number of sweeps of a move, between 1 and MAX_SLIDE_ITERATIONS.
+			 * \param skinWidth Distance kept between the shape and the obstacles.
+			 * \throws std::invalid_argument If maxIterations is out of range.
+			 */
+			KinematicMover(std::uint32_t maxIterations = 4, float skinWidth = 0.01f);
+
+			/**
+			 * \brief Moves an AABB and slides it along the obstacles it hits.
+			 *
+			 * \param aabb The AABB, at its position before the move.
+			 * \param motion The motion of the tick.
+			 * \param broadphase A LBVH built from the obstacles.
+			 * \param obstacles The obstacles, in the order they were given to LBVH::build().
+			 * \return The position of the AABB after the move and the obstacles it hit.
+			 */
+			MoveResult moveAndSlide(const AABB& aabb, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles);
+
+			/**
+			 * \brief Moves a circle and slides it along the obstacles it hits.
+			 *
+			 * \param circle The circle, at its position before the move.
+			 * \param motion The motion of the tick.
+			 * \param broadphase A LBVH built from the obstacles.
+			 * \param obstacles The obstacles, in the order they were given to LBVH::build().
+			 * \return The position of the center of the circle after the move and the obstacles it hit.
+			 */
+			MoveResult moveAndSlide(const Circle& circle, const vec_t& motion, const LBVH& broadphase, const std::vector<AABB>& obstacles);
+
+		private:
+
+			/**
+			 * \brief Implementation of both moveAndSlide() overloads.
+			 */
+			template<typename Shape>
+			MoveResult move(Shape shape, vec_t motion, const LBVH& broadphase, const std::vector<AABB>& obstacles);
+
+			std::uint32_t maxIterations_; /**< Largest number of sweeps of a move. */
+			float skinWidth_; /**< Distance kept between the shape and the obstacles. */
+			std::vector<std::uint32_t> candidates_; /**< Results of the broadphase queries, reused between moves. */
+		};
+	}
+}
@@ -0,0 +1,372 @@
+#include "LBVH.h"
+#include "morton_functions.h"
+#include "parallel_functions.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ch {
+	namespace spatial {
+
+		constexpr size_t LBVH_MIN_CHUNK_SIZE = 4096;
+
+		/**
+		 * \brief Counts the number of leading zero bits of a 32-bit value (32 for 0).
+		 */
+		static int count_leading_zeros(std::uint32_t value) {
+			if (value == 0) {
+				return 32;
+			}
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanReverse(&index, value);
+			return 31 - static_cast<int>(index);
+#else
+			return __builtin_clz(value);
+#endif
+		}
+
+		/**
+		 * \brief Computes where a segment enters the bounds of a node (slab test).
+		 *
+		 * \param tMax The test fails if the entry point is further than this value along the segment.
+		 * \param entry Receives the entry position along the segment (0 if the segment starts inside the bounds).
+		 * \return True if the segment crosses the bounds before tMax.
+		 */
+		static bool lbvh_segment_entry(const vec_t& origin, const vec_t& direction, const LBVHNode& node, float tMax, float& entry) {
+			float tMin = 0.f;
+
+			const float origins[2] = { origin.x, origin.y };
+			const float directions[2] = { direction.x, direction.y };
+			const float mins[2] = { node.minX, node.minY };
+			const float maxs[2] = { node.maxX, node.maxY };
+
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+						return false;
+					}
+					continue;
+				}
+
+				float inverse = 1.f / directions[axis];
+				float t1 = (mins[axis] - origins[axis]) * inverse;
+				float t2 = (maxs[axis] - origins[axis]) * inverse;
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+				if (tMin > tMax) {
+					return false;
+				}
+			}
+
+			entry = tMin;
+			return true;
+		}
+
+		LBVH::LBVH() : nodes_(), bounds_(), codes_(), order_(), parents_(), rangeFirst_(), rangeLast_(), visits_() {}
+
+		void LBVH::build(const std::vector<AABB>& aabbs, unsigned int threadCount) {
+			bounds_.resize(aabbs.size());
+			for (size_t i = 0; i < aabbs.size(); ++i) {
+				bounds_[i] = Bounds(aabbs[i]);
+			}
+			build(bounds_, threadCount);
+		}
+
+		void LBVH::build(const std::vector<Bounds>& bounds, unsigned int threadCount) {
+			const size_t count = bounds.size();
+			nodes_.resize(count > 0 ? 2 * count - 1 : 0);
+			if (count == 0) {
+				return;
+			}
+			if (threadCount == 0) {
+				threadCount = default_thread_count();
+			}
+
+			const size_t internalCount = count - 1;
+			codes_.resize(count);
+			order_.resize(count);
+			parents_.resize(nodes_.size());
+			rangeFirst_.resize(internalCount);
+			rangeLast_.resize(internalCount);
+			if (visits_.size() < internalCount) {
+				visits_ = std::vector<std::atomic<std::uint32_t>>(internalCount);
+			}
+
+			// 1. Bounds of the centers, used to quantize the Morton codes
+			std::vector<Bounds> chunkBounds(threadCount);
+			size_t chunks = parallel_for(count, [&](size_t begin, size_t end, size_t chunk) {
+				vec_t min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+				vec_t max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+				for (size_t i = begin; i < end; ++i) {
+					vec_t center = bounds[i].center();
+					min = vec_t(std::min(min.x, center.x), std::min(min.y, center.y));
+					max = vec_t(std::max(max.x, center.x), std::max(max.y, center.y));
+				}
+				chunkBounds[chunk] = Bounds(min, max);
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			vec_t worldMin = chunkBounds[0].min;
+			vec_t worldMax = chunkBounds[0].max;
+			for (size_t chunk = 1; chunk < chunks; ++chunk) {
+				worldMin = vec_t(std::min(worldMin.x, chunkBounds[chunk].min.x), std::min(worldMin.y, chunkBounds[chunk].min.y));
+				worldMax = vec_t(std::max(worldMax.x, chunkBounds[chunk].max.x), std::max(worldMax.y, chunkBounds[chunk].max.y));
+			}
+			const AABB world(worldMin, worldMax - worldMin);
+
+			// 2. Morton codes, sorted
+			parallel_for(count, [&](size_t begin, size_t end, size_t) {
+				for (size_t i = begin; i < end; ++i) {
+					codes_[i] = morton_code(bounds[i].center(), world);
+					order_[i] = static_cast<std::uint32_t>(i);
+				}
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			radix_sort(codes_, order_, threadCount);
+
+			// 3. Leaves and internal nodes. Every internal node is built independently.
+			parents_[0] = INVALID_INDEX;
+			parallel_for(count, [&](size_t begin, size_t end, size_t) {
+				for (size_t i = begin; i < end; ++i) {
+					const Bounds& leafBounds = bounds[order_[i]];
+					LBVHNode& leaf = nodes_[internalCount + i];
+					leaf.minX = leafBounds.min.x;
+					leaf.minY = leafBounds.min.y;
+					leaf.maxX = leafBounds.max.x;
+					leaf.maxY = leafBounds.max.y;
+					leaf.child = order_[i];
+
+					if (i < internalCount) {
+						visits_[i].store(0, std::memory_order_relaxed);
+						buildInternalNode(static_cast<std::int64_t>(i));
+					}
+				}
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			// 4. Escape links : the next node in depth-first order once the subtree of a node is done.
+			// If a node covers the leaves up to r, the next subtree starts at leaf r + 1. It is
+			// the internal node r + 1 if that node's range starts at r + 1, the leaf r + 1 otherwise.
+			const auto escapeAfter = [&](std::uint32_t last) {
+				if (last + 1 >= count) {
+					return INVALID_INDEX;
+				}
+				if (last + 1 < internalCount && rangeFirst_[last + 1] == last + 1) {
+					return last + 1;
+				}
+				return static_cast<std::uint32_t>(internalCount + last + 1);
+			};
+
+			parallel_for(count, [&](size_t begin, size_t end, size_t) {
+				for (size_t i = begin; i < end; ++i) {
+					nodes_[internalCount + i].escape = escapeAfter(static_cast<std::uint32_t>(i));
+					if (i < internalCount) {
+						nodes_[i].escape = escapeAfter(rangeLast_[i]);
+					}
+				}
+			}, threadCount, LBVH_MIN_CHUNK_SIZE);
+
+			// 5. Bounds, from the leaves up to the root
+			if (internalCount > 0) {
+				parallel_for(count, [&](size_t begin, size_t end, size_t) {
+					for (size_t i = begin; i < end; ++i) {
+						propagateBounds(static_cast<std::uint32_t>(internalCount + i));
+					}
+				}, threadCount, LBVH_MIN_CHUNK_SIZE);
+			}
+		}
+
+		int LBVH::commonPrefix(std::int64_t i, std::int64_t j) const {
+			if (j < 0 || j >= static_cast<std::int64_t>(codes_.size())) {
+				return -1;
+			}
+			std::uint32_t a = codes_[static_cast<size_t>(i)];
+			std::uint32_t b = codes_[static_cast<size_t>(j)];
+			if (a == b) {
+				// Identical codes are told apart by their position in the sorted array
+				return 32 + count_leading_zeros(static_cast<std::uint32_t>(i ^ j));
+			}
+			return count_leading_zeros(a ^ b);
+		}
+
+		void LBVH::buildInternalNode(std::int64_t i) {
+			const std::int64_t internalCount = static_cast<std::int64_t>(codes_.size()) - 1;
+
+			// Direction of the range covered by the node
+			const std::int64_t d = commonPrefix(i, i + 1) - commonPrefix(i, i - 1) >= 0 ? 1 : -1;
+			const int minPrefix = commonPrefix(i, i - d);
+
+			// Upper bound of the length of the range, then binary search of the other end
+			std::int64_t maxLength = 2;
+			while (commonPrefix(i, i + maxLength * d) > minPrefix) {
+				maxLength *= 2;
+			}
+			std::int64_t length = 0;
+			for (std::int64_t step = maxLength / 2; step >= 1; step /= 2) {
+				if (commonPrefix(i, i + (length + step) * d) > minPrefix) {
+					length += step;
+				}
+			}
+			const std::int64_t j = i + length * d;
+
+			// Binary search of the split position
+			const int nodePrefix = commonPrefix(i, j);
+			std::int64_t split = 0;
+			std::int64_t step = length;
+			do {
+				step = (step + 1) / 2;
+				if (split + step < length && commonPrefix(i, i + (split + step) * d) > nodePrefix) {
+					split += step;
+				}
+			} while (step > 1);
+			const std::int64_t gamma = i + split * d + std::min<std::int64_t>(d, 0);
+
+			const std::int64_t first = std::min(i, j);
+			const std::int64_t last = std::max(i, j);
+			const std::uint32_t left = static_cast<std::uint32_t>(first == gamma ? internalCount + gamma : gamma);
+			const std::uint32_t right = static_cast<std::uint32_t>(last == gamma + 1 ? internalCount + gamma + 1 : gamma + 1);
+
+			LBVHNode& node = nodes_[static_cast<size_t>(i)];
+			node.child = left;
+			rangeFirst_[static_cast<size_t>(i)] = static_cast<std::uint32_t>(first);
+			rangeLast_[static_cast<size_t>(i)] = static_cast<std::uint32_t>(last);
+			parents_[left] = static_cast<std::uint32_t>(i);
+			parents_[right] = static_cast<std::uint32_t>(i);
+		}
+
+		void LBVH::propagateBounds(std::uint32_t leaf) {
+			std::uint32_t node = parents_[leaf];
+			while (node != INVALID_INDEX) {
+				// The first child to arrive stops, the second one computes the bounds of the parent
+				if (visits_[node].fetch_add(1, std::memory_order_acq_rel) == 0) {
+					return;
+				}
+
+				// The escape node of a left child is always its right sibling
+				const LBVHNode& left = nodes_[nodes_[node].child];
+				const LBVHNode& right = nodes_[left.escape];
+
+				LBVHNode& current = nodes_[node];
+				current.minX = std::min(left.minX, right.minX);
+				current.minY = std::min(left.minY, right.minY);
+				current.maxX = std::max(left.maxX, right.maxX);
+				current.maxY = std::max(left.maxY, right.maxY);
+
+				node = parents_[node];
+			}
+		}
+
+		void LBVH::query(const AABB& aabb, std::vector<std::uint32_t>& results) const {
+			query(Bounds(aabb), results);
+		}
+
+		void LBVH::query(const Bounds& bounds, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			const float minX = bounds.min.x;
+			const float minY = bounds.min.y;
+			const float maxX = bounds.max.x;
+			const float maxY = bounds.max.y;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				bool overlaps = maxX >= node.minX && maxY >= node.minY && minX <= node.maxX && minY <= node.maxY;
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps) {
+					results.push_back(node.child);
+				}
+				index = node.escape;
+			}
+		}
+
+		void LBVH::query(const Circle& circle, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			const float radiusSquared = circle.radius * circle.radius;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				float dx = std::max(std::max(node.minX - circle.pos.x, 0.f), circle.pos.x - node.maxX);
+				float dy = std::max(std::max(node.minY - circle.pos.y, 0.f), circle.pos.y - node.maxY);
+				bool overlaps = dx * dx + dy * dy < radiusSquared;
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps) {
+					results.push_back(node.child);
+				}
+				index = node.escape;
+			}
+		}
+
+		void LBVH::query(const LineSegment& segment, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			const vec_t direction = segment.end - segment.start;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				float entry;
+				bool overlaps = lbvh_segment_entry(segment.start, direction, node, 1.f, entry);
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps) {
+					results.push_back(node.child);
+				}
+				index = node.escape;
+			}
+		}
+
+		bool LBVH::raycast(const LineSegment& ray, RaycastHit& hit) const {
+			const vec_t direction = ray.end - ray.start;
+			const std::uint32_t firstLeaf = static_cast<std::uint32_t>(size()) - 1;
+
+			float closest = 1.f;
+			std::uint32_t closestIndex = INVALID_INDEX;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const LBVHNode& node = nodes_[index];
+				float entry;
+				// Subtrees further than the closest hit found so far are skipped
+				bool overlaps = lbvh_segment_entry(ray.start, direction, node, closest, entry);
+				if (overlaps && index < firstLeaf) {
+					index = node.child;
+					continue;
+				}
+				if (overlaps && (closestIndex == INVALID_INDEX || entry < closest)) {
+					closest = entry;
+					closestIndex = node.child;
+				}
+				index = node.escape;
+			}
+
+			if (closestIndex == INVALID_INDEX) {
+				return false;
+			}
+
+			hit = RaycastHit{ closestIndex, closest, ray.start + direction * closest };
+			return true;
+		}
+
+		const std::vector<LBVHNode>& LBVH::nodes() const {
+			return nodes_;
+		}
+
+		size_t LBVH::size() const {
+			return nodes_.empty() ? 0 : (nodes_.size() + 1) / 2;
+		}
+	}
+}
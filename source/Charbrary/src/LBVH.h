@@ -0,0 +1,144 @@
+#pragma once
+
+#include "AABB.h"
+#include "Bounds.h"
+#include "Circle.h"
+#include "LineSegment.h"
+#include "RaycastHit.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief A node of a LBVH, stored in a flat array.
+		 *
+		 * The hierarchy is traversed without a stack : when a node is rejected (or when a leaf
+		 * has been processed), the traversal jumps to the escape node, which is the next node
+		 * to visit once the subtree of the current node is done.
+		 */
+		struct LBVHNode {
+			float minX; /**< Left side of the bounds of the node. */
+			float minY; /**< Top side of the bounds of the node. */
+			float maxX; /**< Right side of the bounds of the node. */
+			float maxY; /**< Bottom side of the bounds of the node. */
+			std::uint32_t child; /**< Internal node : index of the left child. Leaf : index of the AABB in the array given to LBVH::build(). */
+			std::uint32_t escape; /**< Index of the node to visit after this subtree, LBVH::INVALID_INDEX at the end of the traversal. */
+		};
+
+		/**
+		 * \brief Linear bounding volume hierarchy over AABBs.
+		 *
+		 * The hierarchy is built from the Morton codes of the AABBs (see morton_functions.h)
+		 * following the method described by Tero Karras in "Maximizing Parallelism in the
+		 * Construction of BVHs, Octrees, and k-d Trees". Every step of the build is split
+		 * between several threads, and the internal buffers are reused between builds, so the
+		 * whole hierarchy can be rebuilt from scratch every tick instead of being refitted.
+		 *
+		 * The nodes are stored in a flat array : the n - 1 internal nodes come first (the root
+		 * is node 0), followed by the n leaves.
+		 */
+		class LBVH {
+
+		public:
+
+			static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFF; /**< Marks the absence of a node. */
+
+		public:
+
+			/**
+			 * \brief Constructs an empty hierarchy.
+			 */
+			LBVH();
+
+			/**
+			 * \brief Rebuilds the hierarchy from the given AABBs.
+			 *
+			 * The query functions return indices in this array.
+			 *
+			 * \param aabbs The AABBs to store in the hierarchy.
+			 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+			 */
+			void build(const std::vector<AABB>& aabbs, unsigned int threadCount = 0);
+
+			/**
+			 * \brief Rebuilds the hierarchy from the given bounds.
+			 *
+			 * Same as build(const std::vector<AABB>&, unsigned int), without converting the AABBs first.
+			 */
+			void build(const std::vector<Bounds>& bounds, unsigned int threadCount = 0);
+
+			/**
+			 * \brief Finds the AABBs that intersect the given AABB (see collision::aabb_intersects()).
+			 * \param results Cleared, then filled with the indices of the intersecting AABBs.
+			 */
+			void query(const AABB& aabb, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the AABBs that intersect the given bounds.
+			 * \param results Cleared, then filled with the indices of the intersecting AABBs.
+			 */
+			void query(const Bounds& bounds, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the AABBs that intersect the given circle.
+			 * \param results Cleared, then filled with the indices of the intersecting AABBs.
+			 */
+			void query(const Circle& circle, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the AABBs crossed by the given segment.
+			 * \param results Cleared, then filled with the indices of the crossed AABBs.
+			 */
+			void query(const LineSegment& segment, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the first AABB hit by a ray going from ray.start to ray.end.
+			 *
+			 * \param hit Receives the index of the AABB and the position where the ray enters it.
+			 * 		  A ray starting inside an AABB hits it at t = 0.
+			 * \return True if an AABB was hit, false otherwise (hit is left untouched).
+			 */
+			bool raycast(const LineSegment& ray, RaycastHit& hit) const;
+
+			/**
+			 * \return The nodes of the hierarchy. Empty if the hierarchy was built from an empty array.
+			 */
+			const std::vector<LBVHNode>& nodes() const;
+
+			/**
+			 * \return The number of AABBs stored in the hierarchy.
+			 */
+			size_t size() const;
+
+		private:
+
+			/**
+			 * \brief Builds the internal node at the given index (Karras' algorithm).
+			 */
+			void buildInternalNode(std::int64_t index);
+
+			/**
+			 * \brief Computes the bounds of the parents of the given leaf, up to the root.
+			 */
+			void propagateBounds(std::uint32_t leaf);
+
+			/**
+			 * \brief Length of the common prefix of the keys i and j (-1 if j is out of range).
+			 */
+			int commonPrefix(std::int64_t i, std::int64_t j) const;
+
+			std::vector<LBVHNode> nodes_; /**< Internal nodes followed by the leaves. */
+			std::vector<Bounds> bounds_; /**< Bounds of the AABBs given to build(), reused between builds. */
+			std::vector<std::uint32_t> codes_; /**< Sorted Morton codes of the leaves. */
+			std::vector<std::uint32_t> order_; /**< Index of the AABB stored in each leaf. */
+			std::vector<std::uint32_t> parents_; /**< Parent of each node. */
+			std::vector<std::uint32_t> rangeFirst_; /**< First leaf covered by each internal node. */
+			std::vector<std::uint32_t> rangeLast_; /**< Last leaf covered by each internal node. */
+			std::vector<std::atomic<std::uint32_t>> visits_; /**< Number of children whose bounds are known, per internal node. */
+		};
+	}
+}
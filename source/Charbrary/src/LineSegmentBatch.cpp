@@ -0,0 +1,53 @@
+#include "LineSegmentBatch.h"
+
+namespace ch {
+
+	LineSegmentBatch::LineSegmentBatch() : startX(), startY(), endX(), endY() {}
+
+	LineSegmentBatch::LineSegmentBatch(const std::vector<LineSegment>& segments) : LineSegmentBatch() {
+		reserve(segments.size());
+		for (const auto& segment : segments) {
+			push_back(segment);
+		}
+	}
+
+	void LineSegmentBatch::push_back(const LineSegment& segment) {
+		startX.push_back(segment.start.x);
+		startY.push_back(segment.start.y);
+		endX.push_back(segment.end.x);
+		endY.push_back(segment.end.y);
+	}
+
+	void LineSegmentBatch::set(size_t index, const LineSegment& segment) {
+		startX[index] = segment.start.x;
+		startY[index] = segment.start.y;
+		endX[index] = segment.end.x;
+		endY[index] = segment.end.y;
+	}
+
+	LineSegment LineSegmentBatch::at(size_t index) const {
+		return LineSegment({ startX[index], startY[index] }, { endX[index], endY[index] });
+	}
+
+	void LineSegmentBatch::reserve(size_t capacity) {
+		startX.reserve(capacity);
+		startY.reserve(capacity);
+		endX.reserve(capacity);
+		endY.reserve(capacity);
+	}
+
+	void LineSegmentBatch::clear() {
+		startX.clear();
+		startY.clear();
+		endX.clear();
+		endY.clear();
+	}
+
+	size_t LineSegmentBatch::size() const {
+		return startX.size();
+	}
+
+	bool LineSegmentBatch::empty() const {
+		return startX.empty();
+	}
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "LineSegment.h"
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many line segments in a structure-of-arrays layout.
+	 *
+	 * The extremities of every segment are stored in four contiguous arrays, which is the
+	 * layout expected by the batched segment intersection functions.
+	 */
+	class LineSegmentBatch {
+
+	public:
+
+		std::vector<float> startX; /**< X coordinate of the first point of each segment. */
+		std::vector<float> startY; /**< Y coordinate of the first point of each segment. */
+		std::vector<float> endX; /**< X coordinate of the second point of each segment. */
+		std::vector<float> endY; /**< Y coordinate of the second point of each segment. */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		LineSegmentBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given segments.
+		 */
+		LineSegmentBatch(const std::vector<LineSegment>& segments);
+
+		/**
+		 * \brief Adds a segment at the end of the batch.
+		 */
+		void push_back(const LineSegment& segment);
+
+		/**
+		 * \brief Replaces the segment at the given index.
+		 */
+		void set(size_t index, const LineSegment& segment);
+
+		/**
+		 * \brief Rebuilds the segment stored at the given index.
+		 */
+		LineSegment at(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of segments.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every segment from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of segments in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any segment.
+		 */
+		bool empty() const;
+	};
+}
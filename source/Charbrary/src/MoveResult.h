@@ -0,0 +1,33 @@
+#pragma once
+
+#include "vector_type_definition.h"
+
+#include <array>
+#include <cstdint>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr std::uint32_t MAX_SLIDE_ITERATIONS = 8; /**< Largest number of iterations (and contacts) of a KinematicMover. */
+
+		/**
+		 * \brief An obstacle hit by a KinematicMover during a move.
+		 */
+		struct SlideContact {
+			std::uint32_t index; /**< Index of the obstacle, in the array given to KinematicMover::moveAndSlide(). */
+			vec_t normal; /**< Direction towards which the moving shape is pushed by the obstacle (unit vector). */
+			vec_t position; /**< Position of the moving shape when it hit the obstacle. */
+		};
+
+		/**
+		 * \brief Result of KinematicMover::moveAndSlide().
+		 *
+		 * The contacts are stored in a fixed array, so a move never allocates memory.
+		 */
+		struct MoveResult {
+			vec_t position; /**< Final position of the moving shape (top-left corner of an AABB, center of a circle). */
+			std::array<SlideContact, MAX_SLIDE_ITERATIONS> contacts; /**< Obstacles hit during the move, in order. */
+			std::uint32_t contactCount = 0; /**< Number of contacts. */
+		};
+	}
+}
@@ -0,0 +1,82 @@
+#include "OBB.h"
+
+#include <cmath>
+
+namespace ch {
+
+	OBB::OBB(const vec_t& center, const vec_t& halfSize, float angle) : center_(center), halfSize_(halfSize), angle_(0.f), axisX_(RIGHT_VEC), axisY_(DOWN_VEC) {
+		setAngle(angle);
+	}
+
+	OBB::OBB(const AABB& aabb) : OBB(aabb.center(), aabb.size / 2.f) {}
+
+	void OBB::move(const vec_t& movement) {
+		center_ += movement;
+	}
+
+	void OBB::setCenter(const vec_t& center) {
+		center_ = center;
+	}
+
+	void OBB::setAngle(float angle) {
+		angle_ = angle;
+		float radians = angle * FLT_PI / 180.f;
+		float cosine = std::cos(radians);
+		float sine = std::sin(radians);
+		axisX_ = vec_t(cosine, sine);
+		axisY_ = vec_t(-sine, cosine);
+	}
+
+	void OBB::rotate(float angle) {
+		setAngle(angle_ + angle);
+	}
+
+	const vec_t& OBB::center() const {
+		return center_;
+	}
+
+	const vec_t& OBB::halfSize() const {
+		return halfSize_;
+	}
+
+	float OBB::angle() const {
+		return angle_;
+	}
+
+	const vec_t& OBB::axisX() const {
+		return axisX_;
+	}
+
+	const vec_t& OBB::axisY() const {
+		return axisY_;
+	}
+
+	std::array<vec_t, static_cast<size_t>(Corner::MAX_VALUE)> OBB::corners() const {
+		return {
+			toWorld(vec_t(-halfSize_.x, -halfSize_.y)),
+			toWorld(vec_t(halfSize_.x, -halfSize_.y)),
+			toWorld(vec_t(-halfSize_.x, halfSize_.y)),
+			toWorld(vec_t(halfSize_.x, halfSize_.y))
+		};
+	}
+
+	Bounds OBB::bounds() const {
+		vec_t extent(
+			halfSize_.x * std::abs(axisX_.x) + halfSize_.y * std::abs(axisY_.x),
+			halfSize_.x * std::abs(axisX_.y) + halfSize_.y * std::abs(axisY_.y));
+		return Bounds(center_ - extent, center_ + extent);
+	}
+
+	AABB OBB::aabb() const {
+		return bounds().toAABB();
+	}
+
+	vec_t OBB::toLocal(const vec_t& point) const {
+		vec_t delta = point - center_;
+		return vec_t(vec_dot_product(delta, axisX_), vec_dot_product(delta, axisY_));
+	}
+
+	vec_t OBB::toWorld(const vec_t& point) const {
+		return center_ + axisX_ * point.x + axisY_ * point.y;
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABB.h"
+#include "Bounds.h"
+
+#include <array>
+
+namespace ch {
+
+	/**
+	 * \brief Represents an oriented bounding box : a rectangle rotated around its center.
+	 *
+	 * The cosine and the sine of the rotation are computed when the angle changes and kept
+	 * in the box as its two local axes, so the collision tests (see collision::obb_collision_info())
+	 * only need dot products.
+	 */
+	class OBB {
+
+	public:
+
+		/**
+		 * \brief Constructs an OBB.
+		 *
+		 * \param center Position of the center of the box.
+		 * \param halfSize Half of the width (X) and half of the height (Y) of the box, before the rotation.
+		 * \param angle Rotation of the box in degrees.
+		 */
+		OBB(const vec_t& center, const vec_t& halfSize, float angle = 0.f);
+
+		/**
+		 * \brief Constructs a non-rotated OBB covering the given AABB.
+		 */
+		explicit OBB(const AABB& aabb);
+
+		/**
+		 * \brief Moves the box by the given movement vector.
+		 * \param movement Vector representing the displacement.
+		 */
+		void move(const vec_t& movement);
+
+		/**
+		 * \brief Moves the center of the box to the given position.
+		 */
+		void setCenter(const vec_t& center);
+
+		/**
+		 * \brief Changes the rotation of the box.
+		 * \param angle Angle in degrees.
+		 */
+		void setAngle(float angle);
+
+		/**
+		 * \brief Rotates the box around its center.
+		 * \param angle Angle in degrees, added to the current rotation.
+		 */
+		void rotate(float angle);
+
+		/**
+		 * \return The position of the center of the box.
+		 */
+		const vec_t& center() const;
+
+		/**
+		 * \return Half of the width (X) and half of the height (Y) of the box.
+		 */
+		const vec_t& halfSize() const;
+
+		/**
+		 * \return The rotation of the box in degrees.
+		 */
+		float angle() const;
+
+		/**
+		 * \return The local X axis of the box : (cos(angle), sin(angle)).
+		 */
+		const vec_t& axisX() const;
+
+		/**
+		 * \return The local Y axis of the box : (-sin(angle), cos(angle)).
+		 */
+		const vec_t& axisY() const;
+
+		/**
+		 * \brief Computes the position of every corner of the box.
+		 *
+		 * The corners are ordered like the Corner enum, as they would be if the box wasn't rotated.
+		 *
+		 * \return An array containing all 4 corners of the box.
+		 */
+		std::array<vec_t, static_cast<size_t>(Corner::MAX_VALUE)> corners() const;
+
+		/**
+		 * \return The smallest bounds containing the box.
+		 */
+		Bounds bounds() const;
+
+		/**
+		 * \return The smallest AABB containing the box.
+		 */
+		AABB aabb() const;
+
+		/**
+		 * \brief Converts a position into the coordinates of the box (relative to its center, along its axes).
+		 */
+		vec_t toLocal(const vec_t& point) const;
+
+		/**
+		 * \brief Converts a position in the coordinates of the box back into world coordinates.
+		 */
+		vec_t toWorld(const vec_t& point) const;
+
+	private:
+
+		vec_t center_; /**< Position of the center. */
+		vec_t halfSize_; /**< Half of the size before the rotation. */
+		float angle_; /**< Rotation in degrees. */
+		vec_t axisX_; /**< Cached (cos, sin) of the rotation. */
+		vec_t axisY_; /**< Cached (-sin, cos) of the rotation. */
+	};
+}
@@ -0,0 +1,64 @@
+#include "OBBBatch.h"
+
+#include <cmath>
+
+namespace ch {
+
+	OBBBatch::OBBBatch() : centerX(), centerY(), halfWidth(), halfHeight(), cosine(), sine() {}
+
+	OBBBatch::OBBBatch(const std::vector<OBB>& obbs) : OBBBatch() {
+		reserve(obbs.size());
+		for (const auto& obb : obbs) {
+			push_back(obb);
+		}
+	}
+
+	void OBBBatch::push_back(const OBB& obb) {
+		centerX.push_back(obb.center().x);
+		centerY.push_back(obb.center().y);
+		halfWidth.push_back(obb.halfSize().x);
+		halfHeight.push_back(obb.halfSize().y);
+		cosine.push_back(obb.axisX().x);
+		sine.push_back(obb.axisX().y);
+	}
+
+	void OBBBatch::set(size_t index, const OBB& obb) {
+		centerX[index] = obb.center().x;
+		centerY[index] = obb.center().y;
+		halfWidth[index] = obb.halfSize().x;
+		halfHeight[index] = obb.halfSize().y;
+		cosine[index] = obb.axisX().x;
+		sine[index] = obb.axisX().y;
+	}
+
+	OBB OBBBatch::at(size_t index) const {
+		float angle = std::atan2(sine[index], cosine[index]) * 180.f / FLT_PI;
+		return OBB({ centerX[index], centerY[index] }, { halfWidth[index], halfHeight[index] }, angle);
+	}
+
+	void OBBBatch::reserve(size_t capacity) {
+		centerX.reserve(capacity);
+		centerY.reserve(capacity);
+		halfWidth.reserve(capacity);
+		halfHeight.reserve(capacity);
+		cosine.reserve(capacity);
+		sine.reserve(capacity);
+	}
+
+	void OBBBatch::clear() {
+		centerX.clear();
+		centerY.clear();
+		halfWidth.clear();
+		halfHeight.clear();
+		cosine.clear();
+		sine.clear();
+	}
+
+	size_t OBBBatch::size() const {
+		return centerX.size();
+	}
+
+	bool OBBBatch::empty() const {
+		return centerX.empty();
+	}
+}
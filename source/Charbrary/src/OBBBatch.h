@@ -0,0 +1,76 @@
+#pragma once
+
+#include "OBB.h"
+
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Stores many OBBs in a structure-of-arrays layout.
+	 *
+	 * The center, the half size and the cosine and sine of the rotation of every box are
+	 * stored in six contiguous arrays. This is the layout expected by the batched collision
+	 * functions, which never compute the rotation of the boxes again.
+	 */
+	class OBBBatch {
+
+	public:
+
+		std::vector<float> centerX; /**< X position of the center of each box. */
+		std::vector<float> centerY; /**< Y position of the center of each box. */
+		std::vector<float> halfWidth; /**< Half of the width of each box. */
+		std::vector<float> halfHeight; /**< Half of the height of each box. */
+		std::vector<float> cosine; /**< Cosine of the rotation of each box (X component of its local X axis). */
+		std::vector<float> sine; /**< Sine of the rotation of each box (Y component of its local X axis). */
+
+	public:
+
+		/**
+		 * \brief Constructs an empty batch.
+		 */
+		OBBBatch();
+
+		/**
+		 * \brief Constructs a batch containing a copy of the given OBBs.
+		 */
+		OBBBatch(const std::vector<OBB>& obbs);
+
+		/**
+		 * \brief Adds an OBB at the end of the batch.
+		 */
+		void push_back(const OBB& obb);
+
+		/**
+		 * \brief Replaces the OBB at the given index.
+		 */
+		void set(size_t index, const OBB& obb);
+
+		/**
+		 * \brief Rebuilds the OBB stored at the given index.
+		 *
+		 * The angle of the box is computed back from its cosine and sine.
+		 */
+		OBB at(size_t index) const;
+
+		/**
+		 * \brief Reserves memory for the given amount of OBBs.
+		 */
+		void reserve(size_t capacity);
+
+		/**
+		 * \brief Removes every OBB from the batch.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of OBBs in the batch.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return True if the batch doesn't contain any OBB.
+		 */
+		bool empty() const;
+	};
+}
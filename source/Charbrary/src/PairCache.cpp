@@ -0,0 +1,170 @@
+#include "PairCache.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ch {
+
+	constexpr std::uint64_t PAIR_CACHE_EMPTY_KEY = 0xFFFFFFFFFFFFFFFFull; /**< Key of the empty slots (a pair of the same handle, which get() rejects). */
+	constexpr size_t PAIR_CACHE_MIN_SLOTS = 16;
+
+	/**
+	 * \brief Key of a pair of handles, independent of their order.
+	 */
+	static std::uint64_t pair_cache_key(std::uint32_t first, std::uint32_t other) {
+		return (static_cast<std::uint64_t>(std::min(first, other)) << 32) | std::max(first, other);
+	}
+
+	/**
+	 * \brief Mixes the bits of a key (finalizer of MurmurHash3), so that close handles end up in distant slots.
+	 */
+	static std::uint64_t pair_cache_hash(std::uint64_t key) {
+		key ^= key >> 33;
+		key *= 0xFF51AFD7ED558CCDull;
+		key ^= key >> 33;
+		key *= 0xC4CEB9FE1A85EC53ull;
+		key ^= key >> 33;
+		return key;
+	}
+
+	PairCache::PairCache(size_t capacity) : keys_(), contacts_(), size_(0), frame_(1) {
+		// At most half of the slots are used, which keeps the probe sequences short
+		size_t slots = PAIR_CACHE_MIN_SLOTS;
+		while (slots < capacity * 2) {
+			slots *= 2;
+		}
+		keys_.assign(slots, PAIR_CACHE_EMPTY_KEY);
+		contacts_.resize(slots);
+	}
+
+	void PairCache::newFrame() {
+		++frame_;
+	}
+
+	PairContact& PairCache::get(std::uint32_t first, std::uint32_t other) {
+		if (first == other) {
+			throw std::invalid_argument("Invalid argument : a pair must reference two different handles.");
+		}
+
+		const std::uint64_t key = pair_cache_key(first, other);
+		size_t slot = findSlot(key);
+		if (keys_[slot] == PAIR_CACHE_EMPTY_KEY) {
+			if ((size_ + 1) * 2 > keys_.size()) {
+				grow();
+				slot = findSlot(key);
+			}
+			keys_[slot] = key;
+			contacts_[slot] = PairContact{ std::min(first, other), std::max(first, other), NULL_VEC, 0.f, NULL_VEC, GJKCache(), 0, 0, 0, false };
+			++size_;
+		}
+
+		PairContact& contact = contacts_[slot];
+		contact.seenFrame = frame_;
+		return contact;
+	}
+
+	const PairContact* PairCache::find(std::uint32_t first, std::uint32_t other) const {
+		if (first == other) {
+			return nullptr;
+		}
+		size_t slot = findSlot(pair_cache_key(first, other));
+		return keys_[slot] == PAIR_CACHE_EMPTY_KEY ? nullptr : &contacts_[slot];
+	}
+
+	void PairCache::setContact(PairContact& contact, const vec_t& normal, float depth) {
+		if (normal == NULL_VEC) {
+			return;
+		}
+		contact.normal = normal;
+		contact.depth = depth;
+		contact.touchFrame = frame_;
+	}
+
+	void PairCache::endFrame(std::vector<ContactEvent>& events) {
+		events.clear();
+
+		size_t slot = 0;
+		while (slot < keys_.size()) {
+			if (keys_[slot] == PAIR_CACHE_EMPTY_KEY) {
+				++slot;
+				continue;
+			}
+
+			PairContact& contact = contacts_[slot];
+			if (contact.seenFrame != frame_) {
+				// The pair left the broadphase. The slot is filled by the next pairs and is checked again.
+				if (contact.touching) {
+					events.push_back(ContactEvent{ ContactEventType::End, contact.first, contact.other });
+				}
+				erase(slot);
+				continue;
+			}
+
+			const bool touching = contact.touchFrame == frame_;
+			if (touching && !contact.touching) {
+				contact.beginFrame = frame_;
+				events.push_back(ContactEvent{ ContactEventType::Begin, contact.first, contact.other });
+			}
+			else if (!touching && contact.touching) {
+				contact.beginFrame = 0;
+				events.push_back(ContactEvent{ ContactEventType::End, contact.first, contact.other });
+			}
+			contact.touching = touching;
+			++slot;
+		}
+	}
+
+	void PairCache::clear() {
+		std::fill(keys_.begin(), keys_.end(), PAIR_CACHE_EMPTY_KEY);
+		size_ = 0;
+	}
+
+	size_t PairCache::size() const {
+		return size_;
+	}
+
+	std::uint32_t PairCache::frame() const {
+		return frame_;
+	}
+
+	size_t PairCache::findSlot(std::uint64_t key) const {
+		const size_t mask = keys_.size() - 1;
+		size_t slot = static_cast<size_t>(pair_cache_hash(key)) & mask;
+		while (keys_[slot] != key && keys_[slot] != PAIR_CACHE_EMPTY_KEY) {
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	void PairCache::grow() {
+		std::vector<std::uint64_t> keys(keys_.size() * 2, PAIR_CACHE_EMPTY_KEY);
+		std::vector<PairContact> contacts(contacts_.size() * 2);
+		keys.swap(keys_);
+		contacts.swap(contacts_);
+
+		for (size_t i = 0; i < keys.size(); ++i) {
+			if (keys[i] != PAIR_CACHE_EMPTY_KEY) {
+				size_t slot = findSlot(keys[i]);
+				keys_[slot] = keys[i];
+				contacts_[slot] = contacts[i];
+			}
+		}
+	}
+
+	void PairCache::erase(size_t slot) {
+		// Backward shift deletion : a pair can fill the hole if the hole is between its home slot and its slot
+		const size_t mask = keys_.size() - 1;
+		size_t hole = slot;
+		for (size_t i = (slot + 1) & mask; keys_[i] != PAIR_CACHE_EMPTY_KEY; i = (i + 1) & mask) {
+			const size_t home = static_cast<size_t>(pair_cache_hash(keys_[i])) & mask;
+			if (((i - home) & mask) >= ((i - hole) & mask)) {
+				keys_[hole] = keys_[i];
+				contacts_[hole] = contacts_[i];
+				hole = i;
+			}
+		}
+		keys_[hole] = PAIR_CACHE_EMPTY_KEY;
+		--size_;
+	}
+}
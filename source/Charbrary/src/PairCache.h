@@ -0,0 +1,114 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "PairContact.h"
+#include "ContactEvent.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Remembers the contacts of the pairs of shapes from one tick to the next.
+	 *
+	 * Most of the pairs reported by a broadphase on a tick were already reported on the
+	 * previous one. The cache stores, for each pair of handles, the last contact, the last
+	 * separating axis and the simplex of the last GJK query, so that the narrowphase can start
+	 * from them (see collision::gjk_collision_info(const SupportShape&, const SupportShape&, PairContact&)).
+	 * It also tracks the contact state of the pairs to report when contacts begin and end.
+	 *
+	 * The pairs are stored in an open addressing hash table (linear probing) keyed by the two
+	 * handles. The order of the handles doesn't matter : (a, b) and (b, a) are the same pair.
+	 *
+	 * Usage, once per tick :
+	 * - newFrame()
+	 * - for each pair of the broadphase : get(), narrowphase, setContact() if the shapes touch
+	 * - endFrame(), which reports the events and forgets the pairs that weren't reported
+	 */
+	class PairCache {
+
+	public:
+
+		/**
+		 * \brief Constructs an empty cache.
+		 * \param capacity Number of pairs the cache can store before growing.
+		 */
+		PairCache(size_t capacity = 64);
+
+		/**
+		 * \brief Starts a new frame (tick).
+		 */
+		void newFrame();
+
+		/**
+		 * \brief Returns the contact of the given pair, inserting it if the pair is new.
+		 *
+		 * Marks the pair as reported during the current frame. The returned reference is
+		 * invalidated by the next call to get() or endFrame().
+		 *
+		 * \throws std::invalid_argument If both handles are the same.
+		 */
+		PairContact& get(std::uint32_t first, std::uint32_t other);
+
+		/**
+		 * \return The contact of the given pair, nullptr if the pair isn't in the cache.
+		 */
+		const PairContact* find(std::uint32_t first, std::uint32_t other) const;
+
+		/**
+		 * \brief Records that the shapes of the pair touch during the current frame.
+		 *
+		 * Does nothing if the normal is NULL_VEC (no collision), so the result of a collision
+		 * function can be given directly.
+		 */
+		void setContact(PairContact& contact, const vec_t& normal, float depth);
+
+		/**
+		 * \brief Ends the current frame.
+		 *
+		 * Updates the contact state of the pairs and forgets the pairs that weren't reported
+		 * during the frame.
+		 *
+		 * \param events Cleared, then filled with the contacts that began or ended during the frame.
+		 */
+		void endFrame(std::vector<ContactEvent>& events);
+
+		/**
+		 * \brief Forgets every pair, without reporting any event.
+		 */
+		void clear();
+
+		/**
+		 * \return The number of pairs in the cache.
+		 */
+		size_t size() const;
+
+		/**
+		 * \return The current frame, starting at 1.
+		 */
+		std::uint32_t frame() const;
+
+	private:
+
+		/**
+		 * \return The slot of the given key, or the empty slot where it would be inserted.
+		 */
+		size_t findSlot(std::uint64_t key) const;
+
+		/**
+		 * \brief Doubles the number of slots and reinserts every pair.
+		 */
+		void grow();
+
+		/**
+		 * \brief Removes the pair of the given slot, shifting back the pairs that follow it.
+		 */
+		void erase(size_t slot);
+
+		std::vector<std::uint64_t> keys_; /**< Key of each slot, PAIR_CACHE_EMPTY_KEY if the slot is empty. */
+		std::vector<PairContact> contacts_; /**< Contact of each slot. */
+		size_t size_; /**< Number of pairs in the cache. */
+		std::uint32_t frame_; /**< Current frame. */
+	};
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "GJKCache.h"
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief The data remembered by a PairCache for a pair of shapes, from one tick to the next.
+	 *
+	 * The contact is expressed with the shape of handle first as the first shape : the normal is the
+	 * direction towards which the shape of handle other needs to be pushed.
+	 */
+	struct PairContact {
+		std::uint32_t first; /**< Lowest handle of the pair. */
+		std::uint32_t other; /**< Highest handle of the pair. */
+		vec_t normal; /**< Normal of the last contact, NULL_VEC if the shapes have never touched. */
+		float depth; /**< Penetration depth of the last contact. */
+		vec_t separatingAxis; /**< Axis that separated the shapes the last time they were tested, NULL_VEC if they were touching. */
+		GJKCache gjk; /**< Simplex of the last GJK query on the pair. */
+		std::uint32_t seenFrame; /**< Last frame the pair was reported by the broadphase (see PairCache::get()). */
+		std::uint32_t touchFrame; /**< Last frame the shapes were touching, 0 if never. */
+		std::uint32_t beginFrame; /**< Frame the current contact began, 0 if the shapes aren't touching. */
+		bool touching; /**< True if the shapes were touching at the end of the last frame. */
+	};
+}
@@ -0,0 +1,56 @@
+#include "PreparedSegment.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ch {
+
+	PreparedSegment::PreparedSegment(const vec_t& startPoint, const vec_t& endPoint) :
+		start_(startPoint),
+		end_(endPoint),
+		direction_(endPoint - startPoint),
+		inverseDirection_(direction_.x != 0.f ? 1.f / direction_.x : 0.f, direction_.y != 0.f ? 1.f / direction_.y : 0.f),
+		length_(vec_magnitude(direction_)),
+		inverseLengthSquared_(0.f),
+		bounds_(std::min(startPoint.x, endPoint.x), std::min(startPoint.y, endPoint.y), std::max(startPoint.x, endPoint.x), std::max(startPoint.y, endPoint.y))
+	{
+		const float lengthSquared = vec_dot_product(direction_, direction_);
+		if (lengthSquared != 0.f) {
+			inverseLengthSquared_ = 1.f / lengthSquared;
+		}
+	}
+
+	PreparedSegment::PreparedSegment(const LineSegment& segment) : PreparedSegment(segment.start, segment.end) {}
+
+	const vec_t& PreparedSegment::start() const {
+		return start_;
+	}
+
+	const vec_t& PreparedSegment::end() const {
+		return end_;
+	}
+
+	const vec_t& PreparedSegment::direction() const {
+		return direction_;
+	}
+
+	const vec_t& PreparedSegment::inverseDirection() const {
+		return inverseDirection_;
+	}
+
+	float PreparedSegment::length() const {
+		return length_;
+	}
+
+	float PreparedSegment::inverseLengthSquared() const {
+		return inverseLengthSquared_;
+	}
+
+	const Bounds& PreparedSegment::bounds() const {
+		return bounds_;
+	}
+
+	LineSegment PreparedSegment::segment() const {
+		return LineSegment(start_, end_);
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "LineSegment.h"
+#include "Bounds.h"
+
+namespace ch {
+
+	/**
+	 * \brief A line segment with cached values, for segments tested many times.
+	 *
+	 * A LineSegment recomputes its direction, its length and its bounds every time they
+	 * are needed. A PreparedSegment computes them once when it is constructed, along with
+	 * the inverse of its direction, so that testing it against a box only takes a few
+	 * multiplications (think of a laser tested against thousands of boxes).
+	 *
+	 * The cached values can't get out of sync : a PreparedSegment can't be modified,
+	 * build a new one when the segment moves.
+	 */
+	class PreparedSegment {
+
+	public:
+
+		/**
+		 * \brief Constructs a prepared segment from 2 points.
+		 * \param startPoint First point of the segment.
+		 * \param endPoint Second point of the segment.
+		 */
+		PreparedSegment(const vec_t& startPoint, const vec_t& endPoint);
+
+		/**
+		 * \brief Constructs a prepared segment from a LineSegment.
+		 */
+		explicit PreparedSegment(const LineSegment& segment);
+
+		/**
+		 * \return The first point of the segment.
+		 */
+		const vec_t& start() const;
+
+		/**
+		 * \return The second point of the segment.
+		 */
+		const vec_t& end() const;
+
+		/**
+		 * \return The vector going from the start to the end of the segment (not normalized).
+		 */
+		const vec_t& direction() const;
+
+		/**
+		 * \return 1 / direction() on each axis, 0 on an axis along which the direction is 0.
+		 */
+		const vec_t& inverseDirection() const;
+
+		/**
+		 * \return The length of the segment.
+		 */
+		float length() const;
+
+		/**
+		 * \return 1 / squared length of the segment, 0 if the segment is a point.
+		 */
+		float inverseLengthSquared() const;
+
+		/**
+		 * \return The smallest bounds containing both points of the segment.
+		 */
+		const Bounds& bounds() const;
+
+		/**
+		 * \return The segment as a LineSegment.
+		 */
+		LineSegment segment() const;
+
+	private:
+
+		vec_t start_; /**< First point of the segment. */
+		vec_t end_; /**< Second point of the segment. */
+		vec_t direction_; /**< end_ - start_. */
+		vec_t inverseDirection_; /**< 1 / direction_ on each axis (0 if the direction is 0). */
+		float length_; /**< Length of the segment. */
+		float inverseLengthSquared_; /**< 1 / squared length (0 if the segment is a point). */
+		Bounds bounds_; /**< Bounds of the segment. */
+	};
+}
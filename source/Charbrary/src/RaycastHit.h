@@ -0,0 +1,17 @@
+#pragma once
+
+#include "vector_type_definition.h"
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Contains information about the closest shape hit by a ray (a LineSegment going from start to end).
+	 */
+	struct RaycastHit {
+		std::uint32_t index; /**< Index of the shape that was hit, in the array the structure was built from. */
+		float t; /**< Position of the hit along the ray, between 0 (ray start) and 1 (ray end). */
+		vec_t point; /**< Position of the hit. */
+	};
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "LineSegment.h"
+
+namespace ch {
+
+	/**
+	 * \brief Contains the part of a line segment located inside an AABB.
+	 *
+	 * Positions along the segment go from 0 (segment.start) to 1 (segment.end).
+	 */
+	struct SegmentAABBClip {
+		bool intersects; /**< True if the segment crosses or touches the AABB. The other members are only meaningful if it does. */
+		float entry; /**< Position where the segment enters the AABB (0 if it starts inside). */
+		float exit; /**< Position where the segment leaves the AABB (1 if it ends inside). */
+		LineSegment clipped; /**< The part of the segment inside the AABB, from entry to exit. */
+	};
+}
@@ -0,0 +1,433 @@
+#include "SegmentBVH.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr float SAH_TRAVERSAL_COST = 1.f; /**< Cost of visiting a node, relative to testing one segment. */
+		constexpr std::uint32_t SAH_MAX_DEPTH = 64; /**< Deeper nodes are split in the middle, which bounds the depth of the tree. */
+		constexpr std::uint32_t SEGMENT_BVH_STACK_SIZE = 128; /**< Larger than the deepest possible tree (SAH_MAX_DEPTH + 32). */
+		constexpr char SEGMENT_BVH_MAGIC[4] = { 'C', 'H', 'S', 'B' };
+		constexpr std::uint32_t SEGMENT_BVH_VERSION = 1;
+
+		/**
+		 * \brief Bounds and center of a segment, used while building a SegmentBVH.
+		 */
+		struct SegmentBVHReference {
+			float minX, minY, maxX, maxY;
+			float center[2];
+			std::uint32_t index;
+		};
+
+		/**
+		 * \brief Half of the perimeter of the given bounds, used as the "surface area" of the heuristic.
+		 */
+		static float half_perimeter(float minX, float minY, float maxX, float maxY) {
+			return (maxX - minX) + (maxY - minY);
+		}
+
+		/**
+		 * \brief Builds the node covering the references [begin, end) and its subtree.
+		 * \return The index of the node.
+		 */
+		static std::uint32_t build_segment_bvh_node(std::vector<SegmentBVHReference>& references, std::vector<float>& costs, size_t begin, size_t end, std::uint32_t depth, std::uint32_t maxLeafSize, std::vector<SegmentBVHNode>& nodes) {
+			const std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+			nodes.emplace_back();
+
+			SegmentBVHNode node{};
+			node.minX = node.minY = std::numeric_limits<float>::max();
+			node.maxX = node.maxY = std::numeric_limits<float>::lowest();
+			for (size_t i = begin; i < end; ++i) {
+				node.minX = std::min(node.minX, references[i].minX);
+				node.minY = std::min(node.minY, references[i].minY);
+				node.maxX = std::max(node.maxX, references[i].maxX);
+				node.maxY = std::max(node.maxY, references[i].maxY);
+			}
+
+			const size_t count = end - begin;
+			const float area = half_perimeter(node.minX, node.minY, node.maxX, node.maxY);
+
+			// Sweep along both axes to find the split with the lowest cost. The cost of a child is
+			// the probability of hitting it (its area relative to the parent) times its segment count.
+			float bestCost = std::numeric_limits<float>::max();
+			std::uint32_t bestAxis = 0;
+			size_t bestSplit = begin + count / 2;
+			const bool useHeuristic = depth < SAH_MAX_DEPTH && area > 0.f && count > 1;
+
+			for (std::uint32_t axis = 0; useHeuristic && axis < 2; ++axis) {
+				std::sort(references.begin() + begin, references.begin() + end, [axis](const SegmentBVHReference& a, const SegmentBVHReference& b) {
+					return a.center[axis] < b.center[axis];
+				});
+
+				// Right side costs, from the end
+				float minX = std::numeric_limits<float>::max(), minY = minX;
+				float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+				for (size_t i = end - 1; i > begin; --i) {
+					minX = std::min(minX, references[i].minX);
+					minY = std::min(minY, references[i].minY);
+					maxX = std::max(maxX, references[i].maxX);
+					maxY = std::max(maxY, references[i].maxY);
+					costs[i] = half_perimeter(minX, minY, maxX, maxY) * static_cast<float>(end - i);
+				}
+
+				// Left side costs, from the beginning
+				minX = minY = std::numeric_limits<float>::max();
+				maxX = maxY = std::numeric_limits<float>::lowest();
+				for (size_t i = begin + 1; i < end; ++i) {
+					minX = std::min(minX, references[i - 1].minX);
+					minY = std::min(minY, references[i - 1].minY);
+					maxX = std::max(maxX, references[i - 1].maxX);
+					maxY = std::max(maxY, references[i - 1].maxY);
+					float cost = SAH_TRAVERSAL_COST + (half_perimeter(minX, minY, maxX, maxY) * static_cast<float>(i - begin) + costs[i]) / area;
+					if (cost < bestCost) {
+						bestCost = cost;
+						bestAxis = axis;
+						bestSplit = i;
+					}
+				}
+			}
+
+			if (count <= maxLeafSize && (!useHeuristic || bestCost >= static_cast<float>(count))) {
+				node.firstOrRight = static_cast<std::uint32_t>(begin);
+				node.count = static_cast<std::uint32_t>(count);
+				nodes[index] = node;
+				return index;
+			}
+
+			if (useHeuristic && bestAxis != 1) {
+				std::sort(references.begin() + begin, references.begin() + end, [bestAxis](const SegmentBVHReference& a, const SegmentBVHReference& b) {
+					return a.center[bestAxis] < b.center[bestAxis];
+				});
+			}
+
+			node.axis = bestAxis;
+			build_segment_bvh_node(references, costs, begin, bestSplit, depth + 1, maxLeafSize, nodes);
+			node.firstOrRight = build_segment_bvh_node(references, costs, bestSplit, end, depth + 1, maxLeafSize, nodes);
+			nodes[index] = node;
+			return index;
+		}
+
+		/**
+		 * \brief Computes where a ray enters the bounds of a node (slab test).
+		 * \return True if the ray crosses the bounds before tMax.
+		 */
+		static bool segment_bvh_node_entry(const vec_t& origin, const vec_t& direction, const SegmentBVHNode& node, float tMax) {
+			float tMin = 0.f;
+
+			const float origins[2] = { origin.x, origin.y };
+			const float directions[2] = { direction.x, direction.y };
+			const float mins[2] = { node.minX, node.minY };
+			const float maxs[2] = { node.maxX, node.maxY };
+
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					if (origins[axis] < mins[axis] || origins[axis] > maxs[axis]) {
+						return false;
+					}
+					continue;
+				}
+
+				float inverse = 1.f / directions[axis];
+				float t1 = (mins[axis] - origins[axis]) * inverse;
+				float t2 = (maxs[axis] - origins[axis]) * inverse;
+				tMin = std::max(tMin, std::min(t1, t2));
+				tMax = std::min(tMax, std::max(t1, t2));
+				if (tMin > tMax) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * \brief Computes where a ray (origin + t * direction, t in [0, 1]) crosses a segment.
+		 *
+		 * If the ray and the segment are collinear and overlapping, t is the start of the overlap.
+		 * A ray of length 0 never hits anything.
+		 *
+		 * \return True if the ray crosses the segment, false otherwise.
+		 */
+		static bool segment_bvh_ray_hit(const vec_t& origin, const vec_t& direction, const LineSegment& segment, float& t) {
+			const vec_t side = segment.end - segment.start;
+			const vec_t toSegment = segment.start - origin;
+			const float denominator = direction.x * side.y - direction.y * side.x;
+			const float toSegmentCrossSide = toSegment.x * side.y - toSegment.y * side.x;
+			const float toSegmentCrossDirection = toSegment.x * direction.y - toSegment.y * direction.x;
+
+			if (denominator != 0.f) {
+				float rayT = toSegmentCrossSide / denominator;
+				float segmentT = toSegmentCrossDirection / denominator;
+				if (rayT < 0.f || rayT > 1.f || segmentT < 0.f || segmentT > 1.f) {
+					return false;
+				}
+				t = rayT;
+				return true;
+			}
+
+			const float lengthSquared = direction.x * direction.x + direction.y * direction.y;
+			if (toSegmentCrossDirection != 0.f || lengthSquared == 0.f) {
+				return false; // Parallel or degenerate ray
+			}
+
+			// Collinear : project the extremities of the segment on the ray
+			float t0 = (toSegment.x * direction.x + toSegment.y * direction.y) / lengthSquared;
+			float t1 = t0 + (side.x * direction.x + side.y * direction.y) / lengthSquared;
+			float first = std::max(std::min(t0, t1), 0.f);
+			if (first > std::min(std::max(t0, t1), 1.f)) {
+				return false;
+			}
+			t = first;
+			return true;
+		}
+
+		/**
+		 * \brief Appends the bytes of a value to a buffer.
+		 */
+		template <typename T>
+		static void segment_bvh_write(std::vector<std::uint8_t>& buffer, const T* values, size_t count) {
+			const size_t offset = buffer.size();
+			buffer.resize(offset + sizeof(T) * count);
+			if (count > 0) {
+				std::memcpy(buffer.data() + offset, values, sizeof(T) * count);
+			}
+		}
+
+		/**
+		 * \brief Reads values from a buffer and advances the reading position.
+		 */
+		template <typename T>
+		static void segment_bvh_read(const std::vector<std::uint8_t>& buffer, size_t& offset, T* values, size_t count) {
+			if (count > 0) {
+				std::memcpy(values, buffer.data() + offset, sizeof(T) * count);
+			}
+			offset += sizeof(T) * count;
+		}
+
+		SegmentBVH::SegmentBVH() : nodes_(), segments_(), indices_() {}
+
+		void SegmentBVH::build(const std::vector<LineSegment>& segments, std::uint32_t maxLeafSize) {
+			nodes_.clear();
+			segments_.clear();
+			indices_.clear();
+			if (segments.empty()) {
+				return;
+			}
+
+			std::vector<SegmentBVHReference> references(segments.size());
+			for (size_t i = 0; i < segments.size(); ++i) {
+				const LineSegment& segment = segments[i];
+				SegmentBVHReference& reference = references[i];
+				reference.minX = segment.minX();
+				reference.minY = segment.minY();
+				reference.maxX = segment.maxX();
+				reference.maxY = segment.maxY();
+				reference.center[0] = (reference.minX + reference.maxX) / 2.f;
+				reference.center[1] = (reference.minY + reference.maxY) / 2.f;
+				reference.index = static_cast<std::uint32_t>(i);
+			}
+
+			std::vector<float> costs(segments.size());
+			nodes_.reserve(2 * segments.size());
+			build_segment_bvh_node(references, costs, 0, references.size(), 0, std::max<std::uint32_t>(maxLeafSize, 1), nodes_);
+			nodes_.shrink_to_fit();
+
+			// In depth-first order, the subtree of a node ends right before its escape node.
+			// The escape node of a left child is its right sibling.
+			for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+				nodes_[i].escape = INVALID_INDEX;
+			}
+			for (std::uint32_t i = 0; i < nodes_.size(); ++i) {
+				const SegmentBVHNode& node = nodes_[i];
+				if (node.count == 0) {
+					nodes_[i + 1].escape = node.firstOrRight;
+					nodes_[node.firstOrRight].escape = node.escape;
+				}
+			}
+
+			segments_.reserve(segments.size());
+			indices_.reserve(segments.size());
+			for (const auto& reference : references) {
+				segments_.push_back(segments[reference.index]);
+				indices_.push_back(reference.index);
+			}
+		}
+
+		bool SegmentBVH::closestHit(const LineSegment& ray, RaycastHit& hit) const {
+			if (nodes_.empty()) {
+				return false;
+			}
+
+			const vec_t direction = ray.end - ray.start;
+			const float directions[2] = { direction.x, direction.y };
+
+			float closest = std::numeric_limits<float>::max();
+			std::uint32_t closestSegment = INVALID_INDEX;
+
+			std::uint32_t stack[SEGMENT_BVH_STACK_SIZE];
+			std::uint32_t stackSize = 0;
+			stack[stackSize++] = 0;
+
+			while (stackSize > 0) {
+				const std::uint32_t index = stack[--stackSize];
+				const SegmentBVHNode& node = nodes_[index];
+				if (!segment_bvh_node_entry(ray.start, direction, node, std::min(closest, 1.f))) {
+					continue;
+				}
+
+				if (node.count > 0) {
+					for (std::uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+						float t;
+						if (segment_bvh_ray_hit(ray.start, direction, segments_[i], t) && t < closest) {
+							closest = t;
+							closestSegment = i;
+						}
+					}
+					continue;
+				}
+
+				// Visit the child that is closer to the ray origin first
+				const std::uint32_t left = index + 1;
+				const std::uint32_t right = node.firstOrRight;
+				if (directions[node.axis] < 0.f) {
+					stack[stackSize++] = left;
+					stack[stackSize++] = right;
+				}
+				else {
+					stack[stackSize++] = right;
+					stack[stackSize++] = left;
+				}
+			}
+
+			if (closestSegment == INVALID_INDEX) {
+				return false;
+			}
+
+			hit.index = indices_[closestSegment];
+			hit.t = closest;
+			hit.point = ray.start + direction * closest;
+			return true;
+		}
+
+		bool SegmentBVH::anyHit(const LineSegment& ray) const {
+			const vec_t direction = ray.end - ray.start;
+
+			std::uint32_t index = nodes_.empty() ? INVALID_INDEX : 0;
+			while (index != INVALID_INDEX) {
+				const SegmentBVHNode& node = nodes_[index];
+				if (!segment_bvh_node_entry(ray.start, direction, node, 1.f)) {
+					index = node.escape;
+					continue;
+				}
+
+				if (node.count == 0) {
+					++index;
+					continue;
+				}
+
+				for (std::uint32_t i = node.firstOrRight; i < node.firstOrRight + node.count; ++i) {
+					float t;
+					if (segment_bvh_ray_hit(ray.start, direction, segments_[i], t)) {
+						return true;
+					}
+				}
+				index = node.escape;
+			}
+			return false;
+		}
+
+		std::vector<std::uint8_t> SegmentBVH::serialize() const {
+			const std::uint32_t header[3] = {
+				SEGMENT_BVH_VERSION,
+				static_cast<std::uint32_t>(nodes_.size()),
+				static_cast<std::uint32_t>(segments_.size())
+			};
+
+			std::vector<float> coordinates;
+			coordinates.reserve(segments_.size() * 4);
+			for (const auto& segment : segments_) {
+				coordinates.insert(coordinates.end(), { segment.start.x, segment.start.y, segment.end.x, segment.end.y });
+			}
+
+			std::vector<std::uint8_t> buffer;
+			buffer.reserve(sizeof(SEGMENT_BVH_MAGIC) + sizeof(header) + nodes_.size() * sizeof(SegmentBVHNode) + segments_.size() * (4 * sizeof(float) + sizeof(std::uint32_t)));
+			segment_bvh_write(buffer, SEGMENT_BVH_MAGIC, 4);
+			segment_bvh_write(buffer, header, 3);
+			segment_bvh_write(buffer, nodes_.data(), nodes_.size());
+			segment_bvh_write(buffer, coordinates.data(), coordinates.size());
+			segment_bvh_write(buffer, indices_.data(), indices_.size());
+			return buffer;
+		}
+
+		SegmentBVH SegmentBVH::deserialize(const std::vector<std::uint8_t>& data) {
+			const size_t headerSize = sizeof(SEGMENT_BVH_MAGIC) + 3 * sizeof(std::uint32_t);
+			if (data.size() < headerSize) {
+				throw std::invalid_argument("Invalid argument : SegmentBVH data is truncated");
+			}
+
+			size_t offset = 0;
+			char magic[4];
+			std::uint32_t header[3];
+			segment_bvh_read(data, offset, magic, 4);
+			segment_bvh_read(data, offset, header, 3);
+			if (std::memcmp(magic, SEGMENT_BVH_MAGIC, 4) != 0 || header[0] != SEGMENT_BVH_VERSION) {
+				throw std::invalid_argument("Invalid argument : not a SegmentBVH or unsupported version");
+			}
+
+			const std::uint32_t nodeCount = header[1];
+			const std::uint32_t segmentCount = header[2];
+			const std::uint64_t expectedSize = headerSize + std::uint64_t(nodeCount) * sizeof(SegmentBVHNode) + std::uint64_t(segmentCount) * (4 * sizeof(float) + sizeof(std::uint32_t));
+			if (data.size() != expectedSize) {
+				throw std::invalid_argument("Invalid argument : SegmentBVH data has the wrong size");
+			}
+
+			SegmentBVH bvh;
+			bvh.nodes_.resize(nodeCount);
+			segment_bvh_read(data, offset, bvh.nodes_.data(), nodeCount);
+
+			std::vector<float> coordinates(size_t(segmentCount) * 4);
+			segment_bvh_read(data, offset, coordinates.data(), coordinates.size());
+			bvh.segments_.reserve(segmentCount);
+			for (size_t i = 0; i < segmentCount; ++i) {
+				bvh.segments_.emplace_back(vec_t(coordinates[i * 4], coordinates[i * 4 + 1]), vec_t(coordinates[i * 4 + 2], coordinates[i * 4 + 3]));
+			}
+
+			bvh.indices_.resize(segmentCount);
+			segment_bvh_read(data, offset, bvh.indices_.data(), segmentCount);
+
+			// Make sure that the queries never read out of bounds or overflow the traversal stack
+			bool valid = (nodeCount == 0) == (segmentCount == 0);
+			std::vector<std::uint32_t> depths(nodeCount, 0);
+			for (std::uint32_t i = 0; valid && i < nodeCount; ++i) {
+				const SegmentBVHNode& node = bvh.nodes_[i];
+				bool validEscape = node.escape == INVALID_INDEX || (node.escape > i && node.escape < nodeCount);
+				bool validChildren = node.count > 0
+					? node.firstOrRight <= segmentCount && node.count <= segmentCount - node.firstOrRight
+					: node.axis < 2 && node.firstOrRight > i + 1 && node.firstOrRight < nodeCount && depths[i] + 2 < SEGMENT_BVH_STACK_SIZE;
+				valid = validEscape && validChildren;
+				if (valid && node.count == 0) {
+					depths[i + 1] = std::max(depths[i + 1], depths[i] + 1);
+					depths[node.firstOrRight] = std::max(depths[node.firstOrRight], depths[i] + 1);
+				}
+			}
+			for (std::uint32_t i = 0; valid && i < segmentCount; ++i) {
+				valid = bvh.indices_[i] < segmentCount;
+			}
+			if (!valid) {
+				throw std::invalid_argument("Invalid argument : SegmentBVH data is corrupted");
+			}
+			return bvh;
+		}
+
+		const std::vector<SegmentBVHNode>& SegmentBVH::nodes() const {
+			return nodes_;
+		}
+
+		size_t SegmentBVH::size() const {
+			return segments_.size();
+		}
+	}
+}
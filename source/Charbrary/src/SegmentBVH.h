@@ -0,0 +1,115 @@
+#pragma once
+
+#include "LineSegment.h"
+#include "RaycastHit.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief A node of a SegmentBVH (32 bytes), stored in a flat array in depth-first order.
+		 *
+		 * The left child of an internal node is always the node that follows it in the array.
+		 */
+		struct SegmentBVHNode {
+			float minX; /**< Left side of the bounds of the node. */
+			float minY; /**< Top side of the bounds of the node. */
+			float maxX; /**< Right side of the bounds of the node. */
+			float maxY; /**< Bottom side of the bounds of the node. */
+			std::uint32_t firstOrRight; /**< Internal node : index of the right child. Leaf : index of the first segment of the leaf. */
+			std::uint32_t count; /**< Number of segments in the leaf, 0 for an internal node. */
+			std::uint32_t axis; /**< Axis along which the children were split (0 for X, 1 for Y). */
+			std::uint32_t escape; /**< Index of the node to visit after this subtree, SegmentBVH::INVALID_INDEX at the end of the traversal. */
+		};
+
+		/**
+		 * \brief Static bounding volume hierarchy over line segments (level geometry, walls, etc...).
+		 *
+		 * The hierarchy is built once using the surface area heuristic (in 2D, the perimeter
+		 * of the bounds is used as the surface area), which makes the build slower than a LBVH
+		 * but the queries faster. It can be built offline and saved with serialize(), then
+		 * loaded with deserialize().
+		 *
+		 * Queries treat a LineSegment as a ray going from start to end.
+		 */
+		class SegmentBVH {
+
+		public:
+
+			static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFF; /**< Marks the absence of a node. */
+
+		public:
+
+			/**
+			 * \brief Constructs an empty hierarchy.
+			 */
+			SegmentBVH();
+
+			/**
+			 * \brief Rebuilds the hierarchy from the given segments.
+			 *
+			 * The queries return indices in this array.
+			 *
+			 * \param segments The segments to store in the hierarchy.
+			 * \param maxLeafSize Maximum number of segments per leaf.
+			 */
+			void build(const std::vector<LineSegment>& segments, std::uint32_t maxLeafSize = 4);
+
+			/**
+			 * \brief Finds the first segment crossed by a ray going from ray.start to ray.end.
+			 *
+			 * \param hit Receives the index of the segment and the position of the hit along the ray.
+			 * 		  If the ray overlaps a collinear segment, the hit is where the overlap starts.
+			 * \return True if a segment was hit, false otherwise (hit is left untouched).
+			 */
+			bool closestHit(const LineSegment& ray, RaycastHit& hit) const;
+
+			/**
+			 * \brief Checks if the given segment crosses any segment of the hierarchy.
+			 *
+			 * Faster than closestHit() as it stops at the first intersection found. Useful for
+			 * line-of-sight tests.
+			 *
+			 * \return True if a segment is crossed, false otherwise.
+			 */
+			bool anyHit(const LineSegment& ray) const;
+
+			/**
+			 * \brief Writes the hierarchy into a byte buffer.
+			 *
+			 * The buffer contains the nodes and the segments as they are stored in memory, in the
+			 * byte order of the machine, so it must be loaded on a machine with the same byte order.
+			 *
+			 * \return The serialized hierarchy.
+			 */
+			std::vector<std::uint8_t> serialize() const;
+
+			/**
+			 * \brief Loads a hierarchy written by serialize().
+			 *
+			 * \throws std::invalid_argument If the buffer does not contain a valid hierarchy.
+			 * \return The loaded hierarchy.
+			 */
+			static SegmentBVH deserialize(const std::vector<std::uint8_t>& data);
+
+			/**
+			 * \return The nodes of the hierarchy. Empty if the hierarchy was built from an empty array.
+			 */
+			const std::vector<SegmentBVHNode>& nodes() const;
+
+			/**
+			 * \return The number of segments stored in the hierarchy.
+			 */
+			size_t size() const;
+
+		private:
+
+			std::vector<SegmentBVHNode> nodes_; /**< Nodes in depth-first order, the root is node 0. */
+			std::vector<LineSegment> segments_; /**< Segments, in the order of the leaves. */
+			std::vector<std::uint32_t> indices_; /**< Index of each segment in the array given to build(). */
+		};
+	}
+}
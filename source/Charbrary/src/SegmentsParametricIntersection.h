@@ -0,0 +1,27 @@
+#pragma once
+
+#include "SegmentsIntersection.h"
+
+namespace ch {
+
+	/**
+	 * \brief Represents an intersection between 2 segments as positions along the segments.
+	 *
+	 * A position t on the first segment corresponds to the point first.start + t * (first.end - first.start),
+	 * with t between 0 and 1. The same goes for u on the other segment.
+	 *
+	 * - type equals IntersectionType::None -> There is no intersection, the other members are 0.
+	 * - type equals IntersectionType::Crossing -> The segments cross at the point located at t on the
+	 *   first segment and at u on the other one. tEnd and uEnd are equal to t and u.
+	 * - type equals IntersectionType::Overlapping -> The segments are collinear and overlapping. The
+	 *   overlapping range goes from t to tEnd on the first segment (t < tEnd), which corresponds to the
+	 *   range from u to uEnd on the other segment.
+	 */
+	struct SegmentsParametricIntersection {
+		IntersectionType type; /**< Type of the intersection. */
+		float t; /**< Position of the intersection (or start of the overlap) on the first segment. */
+		float u; /**< Position of the intersection (or start of the overlap) on the other segment. */
+		float tEnd; /**< End of the overlap on the first segment. */
+		float uEnd; /**< End of the overlap on the other segment. */
+	};
+}
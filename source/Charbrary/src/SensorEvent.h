@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Represents the type of a SensorEvent.
+		 */
+		enum class SensorEventType {
+			Enter, /**< The entity started overlapping the sensor during the tick. */
+			Stay, /**< The entity was already overlapping the sensor and still does. Only reported on demand. */
+			Exit, /**< The entity stopped overlapping the sensor during the tick (or the sensor was removed). */
+			MAX_VALUE
+		};
+
+		/**
+		 * \brief Reports a change of the overlap between a sensor and an entity, as returned by SensorSystem::update().
+		 */
+		struct SensorEvent {
+			SensorEventType type; /**< Whether the entity entered, stayed in or exited the sensor. */
+			std::uint32_t sensor; /**< Identifier of the sensor, as returned by SensorSystem::add(). */
+			std::uint32_t entity; /**< Index of the entity in the array given to SensorSystem::update(). */
+		};
+	}
+}
@@ -0,0 +1,158 @@
+#include "SensorSystem.h"
+#include "collision_functions.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace ch {
+	namespace spatial {
+
+		SensorSystem::SensorSystem() :
+			types_(),
+			aabbs_(),
+			circles_(),
+			requireContainment_(),
+			overlaps_(),
+			freeSensors_(),
+			removedSensors_(),
+			candidates_(),
+			broadphase_(),
+			size_(0)
+		{}
+
+		std::uint32_t SensorSystem::add(const AABB& region, bool requireContainment) {
+			std::uint32_t sensor = allocate(requireContainment);
+			set(sensor, region);
+			return sensor;
+		}
+
+		std::uint32_t SensorSystem::add(const Circle& region, bool requireContainment) {
+			std::uint32_t sensor = allocate(requireContainment);
+			set(sensor, region);
+			return sensor;
+		}
+
+		void SensorSystem::set(std::uint32_t sensor, const AABB& region) {
+			checkSensor(sensor);
+			types_[sensor] = ShapeType::AABB;
+			aabbs_[sensor] = region;
+		}
+
+		void SensorSystem::set(std::uint32_t sensor, const Circle& region) {
+			checkSensor(sensor);
+			types_[sensor] = ShapeType::Circle;
+			circles_[sensor] = region;
+		}
+
+		void SensorSystem::remove(std::uint32_t sensor) {
+			checkSensor(sensor);
+			types_[sensor] = ShapeType::MAX_VALUE;
+			removedSensors_.push_back(sensor);
+			--size_;
+		}
+
+		void SensorSystem::update(const LBVH& broadphase, const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays) {
+			events.clear();
+
+			for (std::uint32_t sensor = 0; sensor < types_.size(); ++sensor) {
+				std::vector<std::uint32_t>& previous = overlaps_[sensor];
+				const ShapeType type = types_[sensor];
+
+				if (type == ShapeType::MAX_VALUE) {
+					// Removed sensor (or free identifier) : everything that was inside exits
+					for (std::uint32_t entity : previous) {
+						events.push_back(SensorEvent{ SensorEventType::Exit, sensor, entity });
+					}
+					previous.clear();
+					continue;
+				}
+
+				if (type == ShapeType::AABB) {
+					const AABB& region = aabbs_[sensor];
+					broadphase.query(region, candidates_);
+					if (requireContainment_[sensor]) {
+						candidates_.erase(std::remove_if(candidates_.begin(), candidates_.end(), [&](std::uint32_t entity) {
+							return !collision::aabb_contains(region, entities[entity]);
+						}), candidates_.end());
+					}
+				}
+				else {
+					const Circle& region = circles_[sensor];
+					broadphase.query(region, candidates_);
+					if (requireContainment_[sensor]) {
+						candidates_.erase(std::remove_if(candidates_.begin(), candidates_.end(), [&](std::uint32_t entity) {
+							return !collision::circle_contains(region, entities[entity]);
+						}), candidates_.end());
+					}
+				}
+				std::sort(candidates_.begin(), candidates_.end());
+
+				// Merge of the sorted overlaps of the previous tick with the new ones
+				size_t i = 0;
+				size_t j = 0;
+				while (i < previous.size() || j < candidates_.size()) {
+					if (j == candidates_.size() || (i < previous.size() && previous[i] < candidates_[j])) {
+						events.push_back(SensorEvent{ SensorEventType::Exit, sensor, previous[i++] });
+					}
+					else if (i == previous.size() || candidates_[j] < previous[i]) {
+						events.push_back(SensorEvent{ SensorEventType::Enter, sensor, candidates_[j++] });
+					}
+					else {
+						if (reportStays) {
+							events.push_back(SensorEvent{ SensorEventType::Stay, sensor, previous[i] });
+						}
+						++i;
+						++j;
+					}
+				}
+
+				// The buffer of the previous overlaps is reused by the next query
+				previous.swap(candidates_);
+			}
+
+			freeSensors_.insert(freeSensors_.end(), removedSensors_.begin(), removedSensors_.end());
+			removedSensors_.clear();
+		}
+
+		void SensorSystem::update(const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays) {
+			broadphase_.build(entities);
+			update(broadphase_, entities, events, reportStays);
+		}
+
+		const std::vector<std::uint32_t>& SensorSystem::overlaps(std::uint32_t sensor) const {
+			checkSensor(sensor);
+			return overlaps_[sensor];
+		}
+
+		size_t SensorSystem::size() const {
+			return size_;
+		}
+
+		void SensorSystem::checkSensor(std::uint32_t sensor) const {
+			if (sensor >= types_.size() || types_[sensor] == ShapeType::MAX_VALUE) {
+				throw std::invalid_argument("Invalid argument : the sensor doesn't exist.");
+			}
+		}
+
+		std::uint32_t SensorSystem::allocate(bool requireContainment) {
+			std::uint32_t sensor;
+			if (!freeSensors_.empty()) {
+				sensor = freeSensors_.back();
+				freeSensors_.pop_back();
+			}
+			else {
+				sensor = static_cast<std::uint32_t>(types_.size());
+				types_.push_back(ShapeType::MAX_VALUE);
+				aabbs_.emplace_back();
+				circles_.emplace_back();
+				requireContainment_.push_back(0);
+				overlaps_.emplace_back();
+			}
+			// Valid type until set() is called, so that checkSensor() accepts the new sensor
+			types_[sensor] = ShapeType::AABB;
+			requireContainment_[sensor] = requireContainment ? 1 : 0;
+			++size_;
+			return sensor;
+		}
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "AABB.h"
+#include "Circle.h"
+#include "ShapePair.h"
+#include "SensorEvent.h"
+#include "LBVH.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Trigger volumes (AABB or circle regions) that report the entities entering and exiting them.
+		 *
+		 * Every tick, each sensor asks a broadphase (a LBVH built over the AABBs of the entities)
+		 * for the entities it overlaps, instead of testing every entity. The overlaps of each
+		 * sensor are kept sorted, so the events are found by merging the sorted overlaps of the
+		 * previous tick with the new ones : the cost of a tick depends on the number of overlaps,
+		 * not on the number of sensors times the number of entities.
+		 *
+		 * By default an entity overlaps a sensor as soon as their shapes intersect. A sensor
+		 * created with requireContainment only reports the entities that are completely inside it
+		 * (see collision::aabb_contains() and collision::circle_contains()).
+		 */
+		class SensorSystem {
+
+		public:
+
+			/**
+			 * \brief Constructs a system without any sensor.
+			 */
+			SensorSystem();
+
+			/**
+			 * \brief Adds an AABB sensor.
+			 * \return The identifier of the sensor. The identifiers of removed sensors are reused.
+			 */
+			std::uint32_t add(const AABB& region, bool requireContainment = false);
+
+			/**
+			 * \brief Adds a circle sensor.
+			 * \return The identifier of the sensor. The identifiers of removed sensors are reused.
+			 */
+			std::uint32_t add(const Circle& region, bool requireContainment = false);
+
+			/**
+			 * \brief Moves or resizes a sensor. It becomes an AABB sensor if it was a circle sensor.
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			void set(std::uint32_t sensor, const AABB& region);
+
+			/**
+			 * \brief Moves or resizes a sensor. It becomes a circle sensor if it was an AABB sensor.
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			void set(std::uint32_t sensor, const Circle& region);
+
+			/**
+			 * \brief Removes a sensor. The entities overlapping it are reported as exiting on the next update().
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			void remove(std::uint32_t sensor);
+
+			/**
+			 * \brief Finds the entities overlapping each sensor and reports the changes since the last update.
+			 *
+			 * \param broadphase A LBVH built from the entities.
+			 * \param entities The AABBs of the entities, in the order they were given to LBVH::build().
+			 * 		  The index of an entity must stay the same from one tick to the next.
+			 * \param events Cleared, then filled with the events of the tick, sorted by sensor then by entity.
+			 * \param reportStays If true, a Stay event is also reported for every entity that was already overlapping a sensor.
+			 */
+			void update(const LBVH& broadphase, const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays = false);
+
+			/**
+			 * \brief Same as update(const LBVH&, const std::vector<AABB>&, std::vector<SensorEvent>&, bool), with a LBVH built internally from the entities.
+			 */
+			void update(const std::vector<AABB>& entities, std::vector<SensorEvent>& events, bool reportStays = false);
+
+			/**
+			 * \return The entities overlapping the sensor during the last update, sorted by index.
+			 * \throws std::invalid_argument If the sensor doesn't exist.
+			 */
+			const std::vector<std::uint32_t>& overlaps(std::uint32_t sensor) const;
+
+			/**
+			 * \return The number of sensors.
+			 */
+			size_t size() const;
+
+		private:
+
+			/**
+			 * \brief Throws if the sensor doesn't exist.
+			 */
+			void checkSensor(std::uint32_t sensor) const;
+
+			/**
+			 * \brief Allocates a sensor, reusing the identifier of a removed sensor if possible.
+			 */
+			std::uint32_t allocate(bool requireContainment);
+
+			std::vector<ShapeType> types_; /**< Type of the region of each sensor, ShapeType::MAX_VALUE for removed sensors. */
+			std::vector<AABB> aabbs_; /**< Region of each AABB sensor. */
+			std::vector<Circle> circles_; /**< Region of each circle sensor. */
+			std::vector<std::uint8_t> requireContainment_; /**< Whether each sensor only reports the entities it contains. */
+			std::vector<std::vector<std::uint32_t>> overlaps_; /**< Sorted entities overlapping each sensor during the last update. */
+			std::vector<std::uint32_t> freeSensors_; /**< Identifiers of the removed sensors whose exits have been reported. */
+			std::vector<std::uint32_t> removedSensors_; /**< Identifiers of the sensors removed since the last update. */
+			std::vector<std::uint32_t> candidates_; /**< Results of the broadphase, reused between sensors. */
+			LBVH broadphase_; /**< LBVH used by update(const std::vector<AABB>&, std::vector<SensorEvent>&, bool). */
+			size_t size_; /**< Number of sensors. */
+		};
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ch {
+
+	/**
+	 * \brief Represents the type of a shape referenced by a ShapeRef.
+	 */
+	enum class ShapeType : std::uint8_t {
+		AABB, /**< An AABB, stored in an AABBBatch. */
+		Circle, /**< A circle, stored in a CircleBatch. */
+		LineSegment, /**< A line segment, stored in a LineSegmentBatch. */
+		MAX_VALUE
+	};
+
+	/**
+	 * \brief References a shape stored in the batch matching its type.
+	 */
+	struct ShapeRef {
+		ShapeType type; /**< Type of the shape, which tells in which batch it is stored. */
+		std::uint32_t index; /**< Index of the shape in its batch. */
+	};
+
+	/**
+	 * \brief A candidate pair of shapes of any type, as returned by a broadphase.
+	 */
+	struct ShapePair {
+		ShapeRef first; /**< The first shape of the pair. */
+		ShapeRef other; /**< The other shape of the pair. */
+	};
+}
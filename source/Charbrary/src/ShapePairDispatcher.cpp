@@ -0,0 +1,164 @@
+#include "ShapePairDispatcher.h"
+#include "batch_collision_functions.h"
+
+namespace ch {
+
+	/**
+	 * \brief Index of the combination of two shape types, in the order of the types.
+	 */
+	constexpr std::uint8_t SHAPE_COMBINATIONS[3][3] = {
+		{ 0, 1, 2 }, // AABB-AABB, AABB-Circle, AABB-LineSegment
+		{ 1, 3, 4 }, // Circle-Circle, Circle-LineSegment
+		{ 2, 4, 5 }  // LineSegment-LineSegment
+	};
+
+	static size_t shape_combination(ShapeType first, ShapeType other) {
+		return SHAPE_COMBINATIONS[static_cast<size_t>(first)][static_cast<size_t>(other)];
+	}
+
+	/**
+	 * \brief Copies the AABBs at the given indices of the source batch into the target batch.
+	 */
+	static void gather_shapes(const AABBBatch& source, const std::uint32_t* indices, size_t count, AABBBatch& target) {
+		target.minX.resize(count);
+		target.minY.resize(count);
+		target.maxX.resize(count);
+		target.maxY.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			target.minX[i] = source.minX[indices[i]];
+			target.minY[i] = source.minY[indices[i]];
+			target.maxX[i] = source.maxX[indices[i]];
+			target.maxY[i] = source.maxY[indices[i]];
+		}
+	}
+
+	/**
+	 * \brief Copies the circles at the given indices of the source batch into the target batch.
+	 */
+	static void gather_shapes(const CircleBatch& source, const std::uint32_t* indices, size_t count, CircleBatch& target) {
+		target.x.resize(count);
+		target.y.resize(count);
+		target.radius.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			target.x[i] = source.x[indices[i]];
+			target.y[i] = source.y[indices[i]];
+			target.radius[i] = source.radius[indices[i]];
+		}
+	}
+
+	/**
+	 * \brief Copies the segments at the given indices of the source batch into the target batch.
+	 */
+	static void gather_shapes(const LineSegmentBatch& source, const std::uint32_t* indices, size_t count, LineSegmentBatch& target) {
+		target.startX.resize(count);
+		target.startY.resize(count);
+		target.endX.resize(count);
+		target.endY.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			target.startX[i] = source.startX[indices[i]];
+			target.startY[i] = source.startY[indices[i]];
+			target.endX[i] = source.endX[indices[i]];
+			target.endY[i] = source.endY[indices[i]];
+		}
+	}
+
+	ShapePairDispatcher::ShapePairDispatcher() :
+		combinationStarts_(),
+		order_(),
+		firstIndices_(),
+		otherIndices_(),
+		sortedResults_(),
+		aabbs_(),
+		circles_(),
+		segments_()
+	{
+		combinationStarts_.fill(0);
+	}
+
+	size_t ShapePairDispatcher::intersects(const AABBBatch& aabbs, const CircleBatch& circles, const LineSegmentBatch& segments, const std::vector<ShapePair>& pairs, std::vector<std::uint8_t>& results) {
+		const size_t count = pairs.size();
+		results.resize(count);
+		order_.resize(count);
+		firstIndices_.resize(count);
+		otherIndices_.resize(count);
+		sortedResults_.resize(count);
+
+		// Counting sort of the pairs by combination
+		std::array<std::uint32_t, COMBINATION_COUNT> next{};
+		for (const ShapePair& pair : pairs) {
+			++next[shape_combination(pair.first.type, pair.other.type)];
+		}
+		std::uint32_t start = 0;
+		for (size_t c = 0; c < COMBINATION_COUNT; ++c) {
+			combinationStarts_[c] = start;
+			start += next[c];
+			next[c] = combinationStarts_[c];
+		}
+		combinationStarts_[COMBINATION_COUNT] = start;
+
+		for (size_t i = 0; i < count; ++i) {
+			const ShapePair& pair = pairs[i];
+			const bool swapped = pair.first.type > pair.other.type;
+			const std::uint32_t position = next[shape_combination(pair.first.type, pair.other.type)]++;
+			order_[position] = static_cast<std::uint32_t>(i);
+			firstIndices_[position] = swapped ? pair.other.index : pair.first.index;
+			otherIndices_[position] = swapped ? pair.first.index : pair.other.index;
+		}
+
+		// Each combination is gathered into contiguous batches and tested with a single kernel call
+		size_t hits = 0;
+		for (size_t c = 0; c < COMBINATION_COUNT; ++c) {
+			const size_t first = combinationStarts_[c];
+			const size_t size = combinationStarts_[c + 1] - first;
+			if (size == 0) {
+				continue;
+			}
+
+			const std::uint32_t* firstIndices = firstIndices_.data() + first;
+			const std::uint32_t* otherIndices = otherIndices_.data() + first;
+			std::uint8_t* combinationResults = sortedResults_.data() + first;
+			switch (c) {
+			case 0:
+				gather_shapes(aabbs, firstIndices, size, aabbs_[0]);
+				gather_shapes(aabbs, otherIndices, size, aabbs_[1]);
+				hits += collision::aabb_intersects_pairwise(aabbs_[0], aabbs_[1], combinationResults);
+				break;
+			case 1:
+				gather_shapes(aabbs, firstIndices, size, aabbs_[0]);
+				gather_shapes(circles, otherIndices, size, circles_[1]);
+				hits += collision::aabb_circle_intersects_pairwise(aabbs_[0], circles_[1], combinationResults);
+				break;
+			case 2:
+				gather_shapes(aabbs, firstIndices, size, aabbs_[0]);
+				gather_shapes(segments, otherIndices, size, segments_[1]);
+				hits += collision::aabb_segment_intersects_pairwise(aabbs_[0], segments_[1], combinationResults);
+				break;
+			case 3:
+				gather_shapes(circles, firstIndices, size, circles_[0]);
+				gather_shapes(circles, otherIndices, size, circles_[1]);
+				hits += collision::circle_intersects_pairwise(circles_[0], circles_[1], combinationResults);
+				break;
+			case 4:
+				gather_shapes(circles, firstIndices, size, circles_[0]);
+				gather_shapes(segments, otherIndices, size, segments_[1]);
+				hits += collision::circle_segment_intersects_pairwise(circles_[0], segments_[1], combinationResults);
+				break;
+			default:
+				gather_shapes(segments, firstIndices, size, segments_[0]);
+				gather_shapes(segments, otherIndices, size, segments_[1]);
+				hits += collision::line_segments_intersect_pairwise(segments_[0], segments_[1], combinationResults);
+				break;
+			}
+		}
+
+		for (size_t i = 0; i < count; ++i) {
+			results[order_[i]] = sortedResults_[i];
+		}
+		return hits;
+	}
+
+	size_t ShapePairDispatcher::combinationSize(ShapeType first, ShapeType other) const {
+		const size_t c = shape_combination(first, other);
+		return combinationStarts_[c + 1] - combinationStarts_[c];
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ShapePair.h"
+#include "AABBBatch.h"
+#include "CircleBatch.h"
+#include "LineSegmentBatch.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Tests lists of candidate pairs that mix AABBs, circles and line segments.
+	 *
+	 * Testing a mixed list one pair at a time means switching on the types of every pair,
+	 * which prevents any vectorization. Instead, the dispatcher sorts the pairs by type
+	 * combination (AABB-AABB, AABB-circle, AABB-segment, circle-circle, circle-segment and
+	 * segment-segment) with a counting sort, gathers the shapes of each combination into
+	 * contiguous batches and tests them with the pairwise batched functions (see
+	 * collision::aabb_intersects_pairwise()). The results are then scattered back in the
+	 * order of the pairs.
+	 *
+	 * All the intermediate buffers are kept between calls : once they have grown to the
+	 * size of the largest list, testing a list doesn't allocate any memory. Keep one
+	 * dispatcher per thread.
+	 */
+	class ShapePairDispatcher {
+
+	public:
+
+		static constexpr size_t COMBINATION_COUNT = 6; /**< Number of unordered pairs of shape types. */
+
+	public:
+
+		/**
+		 * \brief Constructs a dispatcher with empty buffers.
+		 */
+		ShapePairDispatcher();
+
+		/**
+		 * \brief Tests every pair of the list.
+		 *
+		 * The shapes referenced by the pairs are read from the batch matching their type. A pair
+		 * gives the same result as the scalar function of its types, whatever the order of its shapes.
+		 *
+		 * \param aabbs The AABBs referenced by the pairs.
+		 * \param circles The circles referenced by the pairs.
+		 * \param segments The segments referenced by the pairs.
+		 * \param pairs The pairs to test. Every index must be lower than the size of its batch.
+		 * \param results Resized to pairs.size(). results[i] is set to 1 if the shapes of the i-th pair intersect, 0 otherwise.
+		 * \return The number of intersecting pairs.
+		 */
+		size_t intersects(const AABBBatch& aabbs, const CircleBatch& circles, const LineSegmentBatch& segments, const std::vector<ShapePair>& pairs, std::vector<std::uint8_t>& results);
+
+		/**
+		 * \return The number of pairs of the given types (in any order) in the last list tested.
+		 */
+		size_t combinationSize(ShapeType first, ShapeType other) const;
+
+	private:
+
+		std::array<std::uint32_t, COMBINATION_COUNT + 1> combinationStarts_; /**< Start of each combination in order_, followed by the number of pairs. */
+		std::vector<std::uint32_t> order_; /**< Index of each pair in the list, sorted by combination. */
+		std::vector<std::uint32_t> firstIndices_; /**< Index of the shape of lowest type of each pair, in the order of order_. */
+		std::vector<std::uint32_t> otherIndices_; /**< Index of the other shape of each pair, in the order of order_. */
+		std::vector<std::uint8_t> sortedResults_; /**< Results of the pairs, in the order of order_. */
+		std::array<AABBBatch, 2> aabbs_; /**< AABBs of the combination being tested, gathered from the pairs. */
+		std::array<CircleBatch, 2> circles_; /**< Circles of the combination being tested. */
+		std::array<LineSegmentBatch, 2> segments_; /**< Segments of the combination being tested. */
+	};
+}
@@ -0,0 +1,241 @@
+#include "SleepManager.h"
+#include "Constants.h"
+#include "vector_maths_functions.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace ch {
+
+	SleepManager::SleepManager(float velocityThreshold, float displacementThreshold, float timeToSleep) :
+		velocityThreshold_(velocityThreshold),
+		displacementThreshold_(displacementThreshold),
+		timeToSleep_(timeToSleep),
+		states_(),
+		positions_(),
+		previousPositions_(),
+		velocities_(),
+		restTimes_(),
+		nextInIsland_(),
+		parents_(),
+		islandSizes_(),
+		islandRestTimes_(),
+		contacts_(),
+		awakeBodies_(),
+		freeBodies_(),
+		removedBodies_(),
+		islandCount_(0),
+		size_(0)
+	{}
+
+	std::uint32_t SleepManager::add(const vec_t& position, bool isStatic) {
+		std::uint32_t body;
+		if (!freeBodies_.empty()) {
+			body = freeBodies_.back();
+			freeBodies_.pop_back();
+		}
+		else {
+			body = static_cast<std::uint32_t>(states_.size());
+			states_.push_back(BodyState::Removed);
+			positions_.emplace_back();
+			previousPositions_.emplace_back();
+			velocities_.emplace_back();
+			restTimes_.push_back(0.f);
+			nextInIsland_.push_back(body);
+			parents_.push_back(body);
+			islandSizes_.push_back(1);
+			islandRestTimes_.push_back(0.f);
+		}
+
+		states_[body] = isStatic ? BodyState::Static : BodyState::Awake;
+		positions_[body] = position;
+		previousPositions_[body] = position;
+		velocities_[body] = NULL_VEC;
+		restTimes_[body] = 0.f;
+		nextInIsland_[body] = body;
+		if (!isStatic) {
+			awakeBodies_.insert(std::lower_bound(awakeBodies_.begin(), awakeBodies_.end(), body), body);
+		}
+		++size_;
+		return body;
+	}
+
+	void SleepManager::remove(std::uint32_t body) {
+		checkBody(body);
+		if (states_[body] == BodyState::Sleeping) {
+			// The bodies resting on the removed one may fall
+			wakeIsland(body);
+		}
+		if (states_[body] == BodyState::Awake) {
+			awakeBodies_.erase(std::lower_bound(awakeBodies_.begin(), awakeBodies_.end(), body));
+		}
+		states_[body] = BodyState::Removed;
+		// The identifier is reused after step(), once the contacts of the tick are forgotten
+		removedBodies_.push_back(body);
+		--size_;
+	}
+
+	void SleepManager::setMotion(std::uint32_t body, const vec_t& position, const vec_t& velocity) {
+		checkBody(body);
+		if (states_[body] == BodyState::Sleeping && vec_magnitude_squared(position - previousPositions_[body]) > displacementThreshold_ * displacementThreshold_) {
+			wakeIsland(body);
+		}
+		positions_[body] = position;
+		velocities_[body] = velocity;
+	}
+
+	void SleepManager::addContact(std::uint32_t first, std::uint32_t other) {
+		checkBody(first);
+		checkBody(other);
+		if (first == other) {
+			return;
+		}
+
+		if (states_[first] == BodyState::Awake && states_[other] == BodyState::Sleeping) {
+			wakeIsland(other);
+		}
+		else if (states_[other] == BodyState::Awake && states_[first] == BodyState::Sleeping) {
+			wakeIsland(first);
+		}
+
+		// The contacts with static bodies don't link the islands
+		if (states_[first] == BodyState::Awake && states_[other] == BodyState::Awake) {
+			contacts_.push_back(first);
+			contacts_.push_back(other);
+		}
+	}
+
+	void SleepManager::wake(std::uint32_t body) {
+		checkBody(body);
+		if (states_[body] == BodyState::Sleeping) {
+			wakeIsland(body);
+		}
+	}
+
+	void SleepManager::step(float dt) {
+		const float velocityThreshold2 = velocityThreshold_ * velocityThreshold_;
+		const float displacementThreshold2 = displacementThreshold_ * displacementThreshold_;
+
+		// Motion tracking, and one island per awake body
+		for (std::uint32_t body : awakeBodies_) {
+			const bool moving = vec_magnitude_squared(velocities_[body]) > velocityThreshold2
+				|| vec_magnitude_squared(positions_[body] - previousPositions_[body]) > displacementThreshold2;
+			restTimes_[body] = moving ? 0.f : restTimes_[body] + dt;
+			previousPositions_[body] = positions_[body];
+
+			parents_[body] = body;
+			islandSizes_[body] = 1;
+			islandRestTimes_[body] = std::numeric_limits<float>::max();
+			nextInIsland_[body] = body;
+		}
+
+		// The bodies of a pair may have been removed since the contact was added
+		for (size_t i = 0; i < contacts_.size(); i += 2) {
+			if (states_[contacts_[i]] == BodyState::Awake && states_[contacts_[i + 1]] == BodyState::Awake) {
+				unite(contacts_[i], contacts_[i + 1]);
+			}
+		}
+		contacts_.clear();
+
+		// Links the bodies of each island in a circular list starting at its root, so that a sleeping island can be woken up
+		islandCount_ = 0;
+		for (std::uint32_t body : awakeBodies_) {
+			const std::uint32_t root = findRoot(body);
+			islandRestTimes_[root] = std::min(islandRestTimes_[root], restTimes_[body]);
+			if (root == body) {
+				++islandCount_;
+			}
+			else {
+				nextInIsland_[body] = nextInIsland_[root];
+				nextInIsland_[root] = body;
+			}
+		}
+
+		for (std::uint32_t body : awakeBodies_) {
+			if (parents_[body] != body || islandRestTimes_[body] < timeToSleep_) {
+				continue;
+			}
+			std::uint32_t islandBody = body;
+			do {
+				states_[islandBody] = BodyState::Sleeping;
+				velocities_[islandBody] = NULL_VEC;
+				islandBody = nextInIsland_[islandBody];
+			} while (islandBody != body);
+		}
+
+		updateAwakeBodies();
+		freeBodies_.insert(freeBodies_.end(), removedBodies_.begin(), removedBodies_.end());
+		removedBodies_.clear();
+	}
+
+	bool SleepManager::isAwake(std::uint32_t body) const {
+		checkBody(body);
+		return states_[body] == BodyState::Awake;
+	}
+
+	bool SleepManager::isStatic(std::uint32_t body) const {
+		checkBody(body);
+		return states_[body] == BodyState::Static;
+	}
+
+	bool SleepManager::needsCollision(std::uint32_t first, std::uint32_t other) const {
+		return isAwake(first) || isAwake(other);
+	}
+
+	const std::vector<std::uint32_t>& SleepManager::awakeBodies() const {
+		return awakeBodies_;
+	}
+
+	size_t SleepManager::islandCount() const {
+		return islandCount_;
+	}
+
+	size_t SleepManager::size() const {
+		return size_;
+	}
+
+	void SleepManager::checkBody(std::uint32_t body) const {
+		if (body >= states_.size() || states_[body] == BodyState::Removed) {
+			throw std::invalid_argument("Invalid argument : the body doesn't exist.");
+		}
+	}
+
+	std::uint32_t SleepManager::findRoot(std::uint32_t body) {
+		while (parents_[body] != body) {
+			parents_[body] = parents_[parents_[body]];
+			body = parents_[body];
+		}
+		return body;
+	}
+
+	void SleepManager::unite(std::uint32_t first, std::uint32_t other) {
+		std::uint32_t firstRoot = findRoot(first);
+		std::uint32_t otherRoot = findRoot(other);
+		if (firstRoot == otherRoot) {
+			return;
+		}
+		if (islandSizes_[firstRoot] < islandSizes_[otherRoot]) {
+			std::swap(firstRoot, otherRoot);
+		}
+		parents_[otherRoot] = firstRoot;
+		islandSizes_[firstRoot] += islandSizes_[otherRoot];
+	}
+
+	void SleepManager::wakeIsland(std::uint32_t body) {
+		std::uint32_t islandBody = body;
+		do {
+			states_[islandBody] = BodyState::Awake;
+			restTimes_[islandBody] = 0.f;
+			awakeBodies_.push_back(islandBody);
+			islandBody = nextInIsland_[islandBody];
+		} while (islandBody != body);
+		std::sort(awakeBodies_.begin(), awakeBodies_.end());
+	}
+
+	void SleepManager::updateAwakeBodies() {
+		awakeBodies_.erase(std::remove_if(awakeBodies_.begin(), awakeBodies_.end(), [&](std::uint32_t body) {
+			return states_[body] != BodyState::Awake;
+		}), awakeBodies_.end());
+	}
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "vector_type_definition.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	/**
+	 * \brief Puts the bodies at rest to sleep, so that they can be skipped by the broadphase and the narrowphase.
+	 *
+	 * The manager tracks the motion of each body : a body rests while its speed and the distance
+	 * it moves during a tick are below the thresholds. The bodies touching each other (directly or
+	 * through other bodies) form an island, built from the contacts of the tick with a union-find.
+	 * An island falls asleep once all its bodies have rested for timeToSleep seconds, and wakes up
+	 * as a whole as soon as one of its bodies is touched by an awake body, moved or woken.
+	 *
+	 * Static bodies (walls, floors...) never sleep and don't link the islands : two crates resting
+	 * on the same floor are in different islands.
+	 *
+	 * Usage, once per tick :
+	 * - broadphase over awakeBodies() (the sleeping bodies keep their place in the broadphase)
+	 * - narrowphase of the pairs for which needsCollision() is true, addContact() for the pairs that touch
+	 * - integration of the awake bodies, setMotion() with their new position and velocity
+	 * - step()
+	 */
+	class SleepManager {
+
+	public:
+
+		/**
+		 * \brief Constructs a manager without any body.
+		 * \param velocityThreshold Speed below which a body rests.
+		 * \param displacementThreshold Distance below which a body rests, between two steps.
+		 * \param timeToSleep Time (in seconds) all the bodies of an island must rest before the island falls asleep.
+		 */
+		SleepManager(float velocityThreshold = 0.05f, float displacementThreshold = 0.01f, float timeToSleep = 0.5f);
+
+		/**
+		 * \brief Adds an awake body.
+		 * \return The identifier of the body. The identifiers of removed bodies are reused.
+		 */
+		std::uint32_t add(const vec_t& position, bool isStatic = false);
+
+		/**
+		 * \brief Removes a body, waking up its island.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		void remove(std::uint32_t body);
+
+		/**
+		 * \brief Gives the position and velocity of a body after the integration of the tick.
+		 *
+		 * A sleeping body whose position is moved further than the displacement threshold from
+		 * where it fell asleep (a teleport for example) wakes up its island.
+		 *
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		void setMotion(std::uint32_t body, const vec_t& position, const vec_t& velocity);
+
+		/**
+		 * \brief Records that two bodies touch during the current tick.
+		 *
+		 * A sleeping body touched by an awake body that isn't static wakes up its island.
+		 *
+		 * \throws std::invalid_argument If one of the bodies doesn't exist.
+		 */
+		void addContact(std::uint32_t first, std::uint32_t other);
+
+		/**
+		 * \brief Wakes up the island of a body. Does nothing for a static or awake body.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		void wake(std::uint32_t body);
+
+		/**
+		 * \brief Ends the current tick.
+		 *
+		 * Updates the rest time of the awake bodies, builds the islands from the contacts of
+		 * the tick and puts to sleep the islands whose bodies all rested long enough. Then
+		 * forgets the contacts.
+		 *
+		 * \param dt Duration of the tick, in seconds.
+		 */
+		void step(float dt);
+
+		/**
+		 * \return true if the body is awake. Static bodies are never awake.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		bool isAwake(std::uint32_t body) const;
+
+		/**
+		 * \return true if the body is static.
+		 * \throws std::invalid_argument If the body doesn't exist.
+		 */
+		bool isStatic(std::uint32_t body) const;
+
+		/**
+		 * \return true if the narrowphase must test the pair, which is when at least one of the bodies is awake.
+		 * \throws std::invalid_argument If one of the bodies doesn't exist.
+		 */
+		bool needsCollision(std::uint32_t first, std::uint32_t other) const;
+
+		/**
+		 * \return The awake bodies after the last step() (or add()), sorted by identifier.
+		 * Only these bodies must be updated in the broadphase and integrated.
+		 */
+		const std::vector<std::uint32_t>& awakeBodies() const;
+
+		/**
+		 * \return The number of islands of awake bodies built by the last step(), including the ones that fell asleep.
+		 */
+		size_t islandCount() const;
+
+		/**
+		 * \return The number of bodies, static bodies included.
+		 */
+		size_t size() const;
+
+	private:
+
+		/**
+		 * \brief State of a body.
+		 */
+		enum class BodyState : std::uint8_t {
+			Awake,
+			Sleeping,
+			Static,
+			Removed,
+			MAX_VALUE
+		};
+
+		/**
+		 * \brief Throws if the body doesn't exist.
+		 */
+		void checkBody(std::uint32_t body) const;
+
+		/**
+		 * \return The root of the island of the body, halving the path to it.
+		 */
+		std::uint32_t findRoot(std::uint32_t body);
+
+		/**
+		 * \brief Merges the islands of two bodies (union by size).
+		 */
+		void unite(std::uint32_t first, std::uint32_t other);
+
+		/**
+		 * \brief Wakes up every body of the sleeping island of the given body.
+		 */
+		void wakeIsland(std::uint32_t body);
+
+		/**
+		 * \brief Removes the bodies that fell asleep from the list of the awake bodies.
+		 */
+		void updateAwakeBodies();
+
+		float velocityThreshold_; /**< Speed below which a body rests. */
+		float displacementThreshold_; /**< Distance below which a body rests, between two steps. */
+		float timeToSleep_; /**< Time the bodies of an island must rest before the island falls asleep. */
+
+		std::vector<BodyState> states_; /**< State of each body. */
+		std::vector<vec_t> positions_; /**< Position of each body given to setMotion(). */
+		std::vector<vec_t> previousPositions_; /**< Position of each body during the previous step(), or where it fell asleep. */
+		std::vector<vec_t> velocities_; /**< Velocity of each body given to setMotion(). */
+		std::vector<float> restTimes_; /**< Time each body has been resting. */
+		std::vector<std::uint32_t> nextInIsland_; /**< Next body of the island of each body (circular list). */
+		std::vector<std::uint32_t> parents_; /**< Parent of each body in the union-find. */
+		std::vector<std::uint32_t> islandSizes_; /**< Number of bodies of the island of each root in the union-find. */
+		std::vector<float> islandRestTimes_; /**< Shortest rest time of the bodies of the island of each root. */
+		std::vector<std::uint32_t> contacts_; /**< Pairs of awake bodies that touch during the current tick, two identifiers per pair. */
+		std::vector<std::uint32_t> awakeBodies_; /**< Awake bodies, sorted by identifier. */
+		std::vector<std::uint32_t> freeBodies_; /**< Identifiers of the bodies removed before the last step(). */
+		std::vector<std::uint32_t> removedBodies_; /**< Identifiers of the bodies removed since the last step(). */
+		size_t islandCount_; /**< Number of islands built by the last step(). */
+		size_t size_; /**< Number of bodies. */
+	};
+}
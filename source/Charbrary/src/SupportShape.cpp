@@ -0,0 +1,57 @@
+#include "SupportShape.h"
+#include "gjk_functions.h"
+
+namespace ch {
+
+	static vec_t support_shape_aabb(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const AABB*>(shape), direction);
+	}
+
+	static vec_t support_shape_bounds(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const Bounds*>(shape), direction);
+	}
+
+	static vec_t support_shape_circle(const void* shape, const vec_t& /*direction*/) {
+		return static_cast<const Circle*>(shape)->pos;
+	}
+
+	static vec_t support_shape_segment(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const LineSegment*>(shape), direction);
+	}
+
+	static vec_t support_shape_polygon(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const ConvexPolygon*>(shape), direction);
+	}
+
+	static vec_t support_shape_obb(const void* shape, const vec_t& direction) {
+		return collision::support_point(*static_cast<const OBB*>(shape), direction);
+	}
+
+	static vec_t support_shape_capsule(const void* shape, const vec_t& direction) {
+		return collision::support_point(static_cast<const Capsule*>(shape)->segment, direction);
+	}
+
+	SupportShape::SupportShape(const AABB& aabb) : SupportShape(&aabb, support_shape_aabb) {}
+
+	SupportShape::SupportShape(const Bounds& bounds) : SupportShape(&bounds, support_shape_bounds) {}
+
+	SupportShape::SupportShape(const Circle& circle) : SupportShape(&circle, support_shape_circle, circle.radius) {}
+
+	SupportShape::SupportShape(const LineSegment& segment) : SupportShape(&segment, support_shape_segment) {}
+
+	SupportShape::SupportShape(const ConvexPolygon& polygon) : SupportShape(&polygon, support_shape_polygon) {}
+
+	SupportShape::SupportShape(const OBB& obb) : SupportShape(&obb, support_shape_obb) {}
+
+	SupportShape::SupportShape(const Capsule& capsule) : SupportShape(&capsule, support_shape_capsule, capsule.radius) {}
+
+	SupportShape::SupportShape(const void* shape, SupportMapping mapping, float radius) : shape_(shape), mapping_(mapping), radius_(radius) {}
+
+	vec_t SupportShape::support(const vec_t& direction) const {
+		return mapping_(shape_, direction);
+	}
+
+	float SupportShape::radius() const {
+		return radius_;
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABB.h"
+#include "Bounds.h"
+#include "Circle.h"
+#include "LineSegment.h"
+#include "ConvexPolygon.h"
+#include "OBB.h"
+#include "Capsule.h"
+
+namespace ch {
+
+	/**
+	 * \brief A convex shape seen through its support mapping, as used by collision::gjk_distance().
+	 *
+	 * The support mapping of a shape gives its farthest point in a direction. Rounded shapes
+	 * (circles and capsules) are split into a core shape (the center of the circle, the segment of
+	 * the capsule) and a radius : GJK runs on the cores, which converges in a few iterations, and
+	 * the radii are added at the end.
+	 *
+	 * A SupportShape only references the shape it was built from, which must outlive it.
+	 */
+	class SupportShape {
+
+	public:
+
+		/**
+		 * \brief Function returning the farthest point of a shape in a direction.
+		 *
+		 * The direction is not normalized and is never a null vector.
+		 */
+		using SupportMapping = vec_t(*)(const void* shape, const vec_t& direction);
+
+	public:
+
+		/** \brief References an AABB. */
+		SupportShape(const AABB& aabb);
+
+		/** \brief References bounds. */
+		SupportShape(const Bounds& bounds);
+
+		/** \brief References a circle (a point and a radius). */
+		SupportShape(const Circle& circle);
+
+		/** \brief References a line segment. */
+		SupportShape(const LineSegment& segment);
+
+		/** \brief References a convex polygon. */
+		SupportShape(const ConvexPolygon& polygon);
+
+		/** \brief References an OBB. */
+		SupportShape(const OBB& obb);
+
+		/** \brief References a capsule (a segment and a radius). */
+		SupportShape(const Capsule& capsule);
+
+		/**
+		 * \brief References any convex shape through its support mapping.
+		 *
+		 * \param shape The shape, given back to the support mapping.
+		 * \param mapping The support mapping of the core of the shape.
+		 * \param radius Radius added around the core of the shape.
+		 */
+		SupportShape(const void* shape, SupportMapping mapping, float radius = 0.f);
+
+		/**
+		 * \return The farthest point of the core of the shape in the given direction.
+		 */
+		vec_t support(const vec_t& direction) const;
+
+		/**
+		 * \return The radius added around the core of the shape.
+		 */
+		float radius() const;
+
+	private:
+
+		const void* shape_; /**< The referenced shape. */
+		SupportMapping mapping_; /**< Support mapping of the core of the shape. */
+		float radius_; /**< Radius around the core. */
+	};
+}
@@ -0,0 +1,380 @@
+#include "TileMap.h"
+#include "Constants.h"
+#include "collision_functions.h"
+#include "vector_maths_functions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Counts the number of trailing zero bits of a non-zero 64-bit value.
+		 */
+		static int count_trailing_zeros(std::uint64_t value) {
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward64(&index, value);
+			return static_cast<int>(index);
+#else
+			return __builtin_ctzll(value);
+#endif
+		}
+
+		/**
+		 * \return The bits of a word covering the columns first to last (included) of a row, the word starting at column word * 64.
+		 */
+		static std::uint64_t tile_map_word_mask(std::uint32_t word, std::uint32_t first, std::uint32_t last) {
+			const std::uint32_t low = first > word * 64 ? first - word * 64 : 0;
+			const std::uint32_t high = std::min<std::uint32_t>(last - word * 64, 63);
+			return (~std::uint64_t(0) << low) & (~std::uint64_t(0) >> (63 - high));
+		}
+
+		/**
+		 * \brief Calls the function with the coordinates of every solid tile of the range, row by row.
+		 */
+		template<typename Function>
+		static void tile_map_for_each_solid(const std::vector<std::uint64_t>& solid, std::uint32_t wordsPerRow, std::uint32_t x0, std::uint32_t y0, std::uint32_t x1, std::uint32_t y1, const Function& function) {
+			for (std::uint32_t y = y0; y <= y1; ++y) {
+				for (std::uint32_t word = x0 / 64; word <= x1 / 64; ++word) {
+					std::uint64_t bits = solid[y * wordsPerRow + word] & tile_map_word_mask(word, x0, x1);
+					while (bits != 0) {
+						function(word * 64 + count_trailing_zeros(bits), y);
+						bits &= bits - 1;
+					}
+				}
+			}
+		}
+
+		TileMap::TileMap(std::uint32_t width, std::uint32_t height, const vec_t& tileSize, const vec_t& origin) :
+			width_(width),
+			height_(height),
+			wordsPerRow_((width + 63) / 64),
+			tileSize_(tileSize),
+			origin_(origin),
+			solid_()
+		{
+			if (width == 0 || height == 0) {
+				throw std::invalid_argument("Invalid argument : the tile map must contain at least one tile.");
+			}
+			if (tileSize.x <= 0.f || tileSize.y <= 0.f) {
+				throw std::invalid_argument("Invalid argument : the size of the tiles must be positive.");
+			}
+			solid_.assign(static_cast<size_t>(wordsPerRow_) * height, 0);
+		}
+
+		void TileMap::setSolid(std::uint32_t x, std::uint32_t y, bool solid) {
+			if (x >= width_ || y >= height_) {
+				throw std::out_of_range("The tile is outside of the tile map.");
+			}
+			const std::uint64_t bit = std::uint64_t(1) << (x % 64);
+			std::uint64_t& word = solid_[y * wordsPerRow_ + x / 64];
+			word = solid ? word | bit : word & ~bit;
+		}
+
+		bool TileMap::isSolid(std::int64_t x, std::int64_t y) const {
+			if (x < 0 || y < 0 || x >= width_ || y >= height_) {
+				return false;
+			}
+			return (solid_[y * wordsPerRow_ + x / 64] >> (x % 64)) & 1;
+		}
+
+		Bounds TileMap::tileBounds(std::uint32_t x, std::uint32_t y) const {
+			const vec_t min(origin_.x + x * tileSize_.x, origin_.y + y * tileSize_.y);
+			return Bounds(min, min + tileSize_);
+		}
+
+		bool TileMap::intersects(const AABB& aabb) const {
+			std::uint32_t x0, y0, x1, y1;
+			if (!tileRange(Bounds(aabb), x0, y0, x1, y1)) {
+				return false;
+			}
+			for (std::uint32_t y = y0; y <= y1; ++y) {
+				if (anySolid(y, x0, x1)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		bool TileMap::intersects(const Circle& circle) const {
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return false;
+			}
+			bool found = false;
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				found = found || collision::aabb_intersects(tileBounds(x, y), circle);
+			});
+			return found;
+		}
+
+		void TileMap::query(const AABB& aabb, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			std::uint32_t x0, y0, x1, y1;
+			if (!tileRange(Bounds(aabb), x0, y0, x1, y1)) {
+				return;
+			}
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				results.push_back(x + y * width_);
+			});
+		}
+
+		void TileMap::query(const Circle& circle, std::vector<std::uint32_t>& results) const {
+			results.clear();
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return;
+			}
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				if (collision::aabb_intersects(tileBounds(x, y), circle)) {
+					results.push_back(x + y * width_);
+				}
+			});
+		}
+
+		vec_t TileMap::resolve(const AABB& aabb, std::uint32_t maxIterations) const {
+			Bounds bounds(aabb);
+			vec_t translation = NULL_VEC;
+			for (std::uint32_t iteration = 0; iteration < maxIterations; ++iteration) {
+				vec_t normal;
+				const float depth = deepestPenetration(bounds, normal);
+				if (depth <= 0.f) {
+					break;
+				}
+				translation += normal * depth;
+				bounds.move(normal * depth);
+			}
+			return translation;
+		}
+
+		vec_t TileMap::resolve(const Circle& circle, std::uint32_t maxIterations) const {
+			Circle moved = circle;
+			vec_t translation = NULL_VEC;
+			vec_t previousNormal = NULL_VEC;
+			for (std::uint32_t iteration = 0; iteration < maxIterations; ++iteration) {
+				vec_t normal;
+				float depth = deepestPenetration(moved, normal);
+				if (depth <= 0.f) {
+					break;
+				}
+
+				// Pushed back where the previous push came from (concave corner) : the circle keeps the previous push and leaves the tile along the other axis
+				if (vec_dot_product(normal, previousNormal) < 0.f && (previousNormal.x == 0.f || previousNormal.y == 0.f)) {
+					const float along = previousNormal.x == 0.f ? normal.x : normal.y;
+					if (along == 0.f) {
+						break;
+					}
+					normal = previousNormal.x == 0.f ? (along < 0.f ? LEFT_VEC : RIGHT_VEC) : (along < 0.f ? UP_VEC : DOWN_VEC);
+					depth = penetrationAlong(moved, normal);
+					if (depth <= 0.f) {
+						break;
+					}
+				}
+				previousNormal = normal;
+
+				translation += normal * depth;
+				moved.pos += normal * depth;
+			}
+			return translation;
+		}
+
+		bool TileMap::raycast(const LineSegment& ray, RaycastHit& hit) const {
+			const SegmentAABBClip clip = collision::line_segment_aabb_clip(ray, bounds());
+			if (!clip.intersects) {
+				return false;
+			}
+
+			// Tile where the ray enters the grid
+			const vec_t direction = ray.end - ray.start;
+			float t = clip.entry;
+			const vec_t entry = ray.start + direction * t;
+			std::int64_t x = std::min<std::int64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(std::floor((entry.x - origin_.x) / tileSize_.x)), 0), width_ - 1);
+			std::int64_t y = std::min<std::int64_t>(std::max<std::int64_t>(static_cast<std::int64_t>(std::floor((entry.y - origin_.y) / tileSize_.y)), 0), height_ - 1);
+
+			// Position along the ray of the next vertical and horizontal tile sides, and distance between two of them
+			const float infinity = std::numeric_limits<float>::infinity();
+			const int stepX = direction.x > 0.f ? 1 : (direction.x < 0.f ? -1 : 0);
+			const int stepY = direction.y > 0.f ? 1 : (direction.y < 0.f ? -1 : 0);
+			const float deltaX = stepX != 0 ? tileSize_.x / std::abs(direction.x) : infinity;
+			const float deltaY = stepY != 0 ? tileSize_.y / std::abs(direction.y) : infinity;
+			float nextX = stepX != 0 ? (origin_.x + (x + (stepX > 0 ? 1 : 0)) * tileSize_.x - ray.start.x) / direction.x : infinity;
+			float nextY = stepY != 0 ? (origin_.y + (y + (stepY > 0 ? 1 : 0)) * tileSize_.y - ray.start.y) / direction.y : infinity;
+
+			while (true) {
+				if (isSolid(x, y)) {
+					hit = RaycastHit{ static_cast<std::uint32_t>(x + y * width_), t, ray.start + direction * t };
+					return true;
+				}
+
+				if (nextX < nextY) {
+					t = nextX;
+					x += stepX;
+					nextX += deltaX;
+				}
+				else {
+					t = nextY;
+					y += stepY;
+					nextY += deltaY;
+				}
+				if (t > clip.exit || x < 0 || y < 0 || x >= width_ || y >= height_) {
+					return false;
+				}
+			}
+		}
+
+		std::uint32_t TileMap::width() const {
+			return width_;
+		}
+
+		std::uint32_t TileMap::height() const {
+			return height_;
+		}
+
+		vec_t TileMap::tileSize() const {
+			return tileSize_;
+		}
+
+		Bounds TileMap::bounds() const {
+			return Bounds(origin_, origin_ + vec_t(width_ * tileSize_.x, height_ * tileSize_.y));
+		}
+
+		bool TileMap::tileRange(const Bounds& bounds, std::uint32_t& x0, std::uint32_t& y0, std::uint32_t& x1, std::uint32_t& y1) const {
+			// Tiles only touched by the bounds are excluded : the last tile is the one before the ceiling of the max side
+			const float minX = (bounds.min.x - origin_.x) / tileSize_.x;
+			const float minY = (bounds.min.y - origin_.y) / tileSize_.y;
+			const float maxX = (bounds.max.x - origin_.x) / tileSize_.x;
+			const float maxY = (bounds.max.y - origin_.y) / tileSize_.y;
+			if (maxX <= 0.f || maxY <= 0.f || minX >= width_ || minY >= height_ || maxX <= minX || maxY <= minY) {
+				return false;
+			}
+
+			x0 = static_cast<std::uint32_t>(std::max(std::floor(minX), 0.f));
+			y0 = static_cast<std::uint32_t>(std::max(std::floor(minY), 0.f));
+			x1 = static_cast<std::uint32_t>(std::min(std::ceil(maxX), static_cast<float>(width_))) - 1;
+			y1 = static_cast<std::uint32_t>(std::min(std::ceil(maxY), static_cast<float>(height_))) - 1;
+			return true;
+		}
+
+		bool TileMap::anySolid(std::uint32_t y, std::uint32_t x0, std::uint32_t x1) const {
+			const std::uint64_t* row = &solid_[y * wordsPerRow_];
+			for (std::uint32_t word = x0 / 64; word <= x1 / 64; ++word) {
+				if (row[word] & tile_map_word_mask(word, x0, x1)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		float TileMap::deepestPenetration(const Bounds& bounds, vec_t& normal) const {
+			std::uint32_t x0, y0, x1, y1;
+			if (!tileRange(bounds, x0, y0, x1, y1)) {
+				return 0.f;
+			}
+
+			float largestArea = 0.f;
+			float deepest = 0.f;
+			const vec_t center = bounds.center();
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				const Bounds tile = tileBounds(x, y);
+				const float area = (std::min(bounds.max.x, tile.max.x) - std::max(bounds.min.x, tile.min.x)) * (std::min(bounds.max.y, tile.max.y) - std::max(bounds.min.y, tile.min.y));
+				if (area <= largestArea) {
+					return;
+				}
+
+				// Push out along each axis, towards the side of the tile closest to the center of the AABB
+				const vec_t tileCenter = tile.center();
+				const bool left = center.x < tileCenter.x;
+				const bool up = center.y < tileCenter.y;
+				const float depthX = left ? bounds.max.x - tile.min.x : tile.max.x - bounds.min.x;
+				const float depthY = up ? bounds.max.y - tile.min.y : tile.max.y - bounds.min.y;
+
+				// The sides shared with a solid neighbour are inside the solid area : pushing through them only moves the AABB into the neighbour
+				const bool blockedX = isSolid(static_cast<std::int64_t>(x) + (left ? -1 : 1), y);
+				const bool blockedY = isSolid(x, static_cast<std::int64_t>(y) + (up ? -1 : 1));
+				const bool alongX = blockedX == blockedY ? depthX < depthY : blockedY;
+
+				largestArea = area;
+				deepest = alongX ? depthX : depthY;
+				normal = alongX ? (left ? LEFT_VEC : RIGHT_VEC) : (up ? UP_VEC : DOWN_VEC);
+			});
+			return deepest;
+		}
+
+		float TileMap::deepestPenetration(const Circle& circle, vec_t& normal) const {
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return 0.f;
+			}
+
+			float deepest = 0.f;
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				const Bounds tile = tileBounds(x, y);
+				CircleAABBCollision collision = collision::circle_aabb_collision_info(tile, circle);
+				if (collision.absoluteDepth <= deepest) {
+					return;
+				}
+
+				// Center outside of the tile, closest to a corner shared with a solid neighbour : the corner is inside the solid area, the circle is pushed out through the side instead
+				const vec_t closest(std::max(tile.min.x, std::min(circle.pos.x, tile.max.x)), std::max(tile.min.y, std::min(circle.pos.y, tile.max.y)));
+				const bool cornerX = closest.x == tile.min.x || closest.x == tile.max.x;
+				const bool cornerY = closest.y == tile.min.y || closest.y == tile.max.y;
+				if (cornerX && cornerY && collision.normal.x != 0.f && collision.normal.y != 0.f) {
+					const std::int64_t sideX = static_cast<std::int64_t>(x) + (collision.normal.x < 0.f ? -1 : 1);
+					const std::int64_t sideY = static_cast<std::int64_t>(y) + (collision.normal.y < 0.f ? -1 : 1);
+					if (isSolid(sideX, y)) {
+						collision = CircleAABBCollision{ collision.normal.y < 0.f ? UP_VEC : DOWN_VEC, circle.radius - std::abs(circle.pos.y - closest.y) };
+					}
+					else if (isSolid(x, sideY)) {
+						collision = CircleAABBCollision{ collision.normal.x < 0.f ? LEFT_VEC : RIGHT_VEC, circle.radius - std::abs(circle.pos.x - closest.x) };
+					}
+				}
+
+				if (collision.absoluteDepth > deepest) {
+					deepest = collision.absoluteDepth;
+					normal = collision.normal;
+				}
+			});
+			return deepest;
+		}
+
+		float TileMap::penetrationAlong(const Circle& circle, const vec_t& direction) const {
+			std::uint32_t x0, y0, x1, y1;
+			const vec_t extent(circle.radius, circle.radius);
+			if (!tileRange(Bounds(circle.pos - extent, circle.pos + extent), x0, y0, x1, y1)) {
+				return 0.f;
+			}
+
+			float deepest = 0.f;
+			tile_map_for_each_solid(solid_, wordsPerRow_, x0, y0, x1, y1, [&](std::uint32_t x, std::uint32_t y) {
+				const Bounds tile = tileBounds(x, y);
+				if (vec_dot_product(circle.pos - tile.center(), direction) < 0.f) {
+					return;
+				}
+
+				// Distance from the center to the tile across the axis, then half the width of the circle at that distance
+				const bool alongX = direction.x != 0.f;
+				const float across = alongX ? std::max({ tile.min.y - circle.pos.y, circle.pos.y - tile.max.y, 0.f }) : std::max({ tile.min.x - circle.pos.x, circle.pos.x - tile.max.x, 0.f });
+				if (across >= circle.radius) {
+					return;
+				}
+				const float reach = std::sqrt(circle.radius * circle.radius - across * across);
+				const float depth = alongX
+					? (direction.x > 0.f ? tile.max.x + reach - circle.pos.x : circle.pos.x + reach - tile.min.x)
+					: (direction.y > 0.f ? tile.max.y + reach - circle.pos.y : circle.pos.y + reach - tile.min.y);
+				deepest = std::max(deepest, depth);
+			});
+			return deepest;
+		}
+	}
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "AABB.h"
+#include "Bounds.h"
+#include "Circle.h"
+#include "LineSegment.h"
+#include "RaycastHit.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace spatial {
+
+		/**
+		 * \brief Collision layer made of a grid of solid or empty tiles.
+		 *
+		 * The solidity of the tiles is stored in a bit array (one bit per tile, each row padded to
+		 * a multiple of 64 tiles). The queries compute the range of tiles covered by the shape and
+		 * only read the bits of these tiles, a whole word at a time along a row : the tiles are
+		 * never converted to AABBs.
+		 *
+		 * Tile (x, y) covers the area from origin + (x * tileSize.x, y * tileSize.y) to
+		 * origin + ((x + 1) * tileSize.x, (y + 1) * tileSize.y). Index x + y * width() identifies
+		 * a tile in the results of the queries. Everything outside of the grid is empty.
+		 *
+		 * A shape that only touches a solid tile doesn't collide with it, so that a character can
+		 * stand on the ground or slide along a wall.
+		 */
+		class TileMap {
+
+		public:
+
+			/**
+			 * \brief Constructs a grid of empty tiles.
+			 * \param width Number of columns.
+			 * \param height Number of rows.
+			 * \param tileSize Size of a tile.
+			 * \param origin Position of the top-left corner of the grid.
+			 * \throws std::invalid_argument If the grid is empty or if the size of the tiles isn't positive.
+			 */
+			TileMap(std::uint32_t width, std::uint32_t height, const vec_t& tileSize, const vec_t& origin = vec_t(0.f, 0.f));
+
+			/**
+			 * \brief Makes a tile solid or empty.
+			 * \throws std::out_of_range If the tile is outside of the grid.
+			 */
+			void setSolid(std::uint32_t x, std::uint32_t y, bool solid = true);
+
+			/**
+			 * \return true if the tile is solid, false if it's empty or outside of the grid.
+			 */
+			bool isSolid(std::int64_t x, std::int64_t y) const;
+
+			/**
+			 * \return The area covered by a tile.
+			 */
+			Bounds tileBounds(std::uint32_t x, std::uint32_t y) const;
+
+			/**
+			 * \return true if the AABB overlaps a solid tile.
+			 */
+			bool intersects(const AABB& aabb) const;
+
+			/**
+			 * \return true if the circle overlaps a solid tile.
+			 */
+			bool intersects(const Circle& circle) const;
+
+			/**
+			 * \brief Finds the solid tiles overlapped by the AABB.
+			 * \param results Cleared, then filled with the indices of the tiles, row by row.
+			 */
+			void query(const AABB& aabb, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Finds the solid tiles overlapped by the circle.
+			 * \param results Cleared, then filled with the indices of the tiles, row by row.
+			 */
+			void query(const Circle& circle, std::vector<std::uint32_t>& results) const;
+
+			/**
+			 * \brief Computes the translation (minimum translation vector) that pushes the AABB out of the solid tiles.
+			 *
+			 * The AABB is pushed out of the tile it overlaps the most, then the tiles are tested
+			 * again, up to maxIterations times. A tile never pushes the AABB towards a neighbouring
+			 * solid tile : an AABB sinking into a flat floor is pushed up, even at the seam
+			 * between two tiles.
+			 *
+			 * \return The translation to apply to the AABB, NULL_VEC if it doesn't overlap any solid tile.
+			 */
+			vec_t resolve(const AABB& aabb, std::uint32_t maxIterations = 4) const;
+
+			/**
+			 * \brief Computes the translation that pushes the circle out of the solid tiles.
+			 *
+			 * Same as resolve(const AABB&, std::uint32_t), with a circle. In a concave corner, the push out
+			 * of a tile can move the circle back into the tile of the previous push : the circle then keeps
+			 * the previous push and leaves the new tile along the other axis. A circle squeezed between two
+			 * opposite sides (a gap narrower than the circle) can't be pushed out : the translation stops
+			 * there and the circle still overlaps a solid tile, as when maxIterations is reached first.
+			 *
+			 * \return The translation to apply to the center of the circle, NULL_VEC if it doesn't overlap any solid tile.
+			 */
+			vec_t resolve(const Circle& circle, std::uint32_t maxIterations = 4) const;
+
+			/**
+			 * \brief Finds the first solid tile hit by a ray going from ray.start to ray.end.
+			 *
+			 * The tiles crossed by the ray are visited in order (digital differential analyzer) and
+			 * the traversal stops at the first solid one.
+			 *
+			 * \param hit Receives the index of the tile and the position where the ray enters it.
+			 * 		  A ray starting inside a solid tile hits it at t = 0.
+			 * \return True if a solid tile was hit, false otherwise (hit is left untouched).
+			 */
+			bool raycast(const LineSegment& ray, RaycastHit& hit) const;
+
+			/**
+			 * \return The number of columns.
+			 */
+			std::uint32_t width() const;
+
+			/**
+			 * \return The number of rows.
+			 */
+			std::uint32_t height() const;
+
+			/**
+			 * \return The size of a tile.
+			 */
+			vec_t tileSize() const;
+
+			/**
+			 * \return The area covered by the grid.
+			 */
+			Bounds bounds() const;
+
+		private:
+
+			/**
+			 * \brief Computes the range of tiles strictly overlapped by the bounds, clamped to the grid.
+			 * \return false if the bounds don't overlap the grid.
+			 */
+			bool tileRange(const Bounds& bounds, std::uint32_t& x0, std::uint32_t& y0, std::uint32_t& x1, std::uint32_t& y1) const;
+
+			/**
+			 * \return true if a tile of the row between columns x0 and x1 (included) is solid.
+			 */
+			bool anySolid(std::uint32_t y, std::uint32_t x0, std::uint32_t x1) const;
+
+			/**
+			 * \brief Computes the push out of the solid tile the AABB overlaps the most.
+			 * \return The penetration depth, 0 if the AABB doesn't overlap any solid tile.
+			 */
+			float deepestPenetration(const Bounds& bounds, vec_t& normal) const;
+
+			/**
+			 * \brief Computes the push out of the solid tile the circle overlaps the most.
+			 * \return The penetration depth, 0 if the circle doesn't overlap any solid tile.
+			 */
+			float deepestPenetration(const Circle& circle, vec_t& normal) const;
+
+			/**
+			 * \brief Computes how far the circle must move along an axis to leave the solid tiles it overlaps behind it.
+			 * \param direction LEFT_VEC, RIGHT_VEC, UP_VEC or DOWN_VEC.
+			 * \return The distance, 0 if the circle doesn't overlap any solid tile behind it.
+			 */
+			float penetrationAlong(const Circle& circle, const vec_t& direction) const;
+
+			std::uint32_t width_; /**< Number of columns. */
+			std::uint32_t height_; /**< Number of rows. */
+			std::uint32_t wordsPerRow_; /**< Number of 64-bit words of a row. */
+			vec_t tileSize_; /**< Size of a tile. */
+			vec_t origin_; /**< Top-left corner of the grid. */
+			std::vector<std::uint64_t> solid_; /**< Solidity of the tiles, one bit per tile, row by row. */
+		};
+	}
+}
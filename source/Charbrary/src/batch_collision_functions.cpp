@@ -0,0 +1,2270 @@
+#include "batch_collision_functions.h"
+#include "cpu_features.h"
+#include "collision_functions.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef CH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace ch {
+	namespace collision {
+
+		using AABBBatchKernel = size_t(*)(const AABB&, const AABBBatch&, std::uint8_t*);
+		using CircleBatchKernel = size_t(*)(const Circle&, const CircleBatch&, std::uint8_t*);
+		using SegmentBatchKernel = size_t(*)(const LineSegment&, const LineSegmentBatch&, std::uint8_t*, float*, float*);
+		using SegmentAABBClipBatchKernel = size_t(*)(const LineSegment&, const AABBBatch&, std::uint8_t*, float*, float*);
+		// The AVX2 and AVX-512 kernels load the indices of the pairs directly from memory
+		static_assert(sizeof(AABBIndexPair) == 2 * sizeof(std::uint32_t), "AABBIndexPair must be two packed indices");
+
+		using AABBPairBatchKernel = size_t(*)(const AABBBatch&, const AABBIndexPair*, size_t, AABBCollision*);
+		using CircleAABBBatchKernel = size_t(*)(const Circle&, const AABBBatch&, std::uint8_t*, float*, float*, float*);
+		using CircleSweepBatchKernel = void(*)(const Circle&, const vec_t&, const LineSegmentBatch&, float&, size_t&);
+		using AABBOBBBatchKernel = size_t(*)(const AABB&, const OBBBatch&, std::uint8_t*);
+		using CircleOBBBatchKernel = size_t(*)(const Circle&, const OBBBatch&, std::uint8_t*);
+		using CapsuleAABBBatchKernel = size_t(*)(const Capsule&, const AABBBatch&, std::uint8_t*);
+		using AABBPairwiseKernel = size_t(*)(const AABBBatch&, const AABBBatch&, std::uint8_t*);
+		using CirclePairwiseKernel = size_t(*)(const CircleBatch&, const CircleBatch&, std::uint8_t*);
+		using AABBCirclePairwiseKernel = size_t(*)(const AABBBatch&, const CircleBatch&, std::uint8_t*);
+		using SegmentPairwiseKernel = size_t(*)(const LineSegmentBatch&, const LineSegmentBatch&, std::uint8_t*);
+		using AABBSegmentPairwiseKernel = size_t(*)(const AABBBatch&, const LineSegmentBatch&, std::uint8_t*);
+		using CircleSegmentPairwiseKernel = size_t(*)(const CircleBatch&, const LineSegmentBatch&, std::uint8_t*);
+
+		/**
+		 * \brief Function pointers to the batched collision kernels of one SIMD tier.
+		 */
+		struct BatchCollisionKernels {
+			AABBBatchKernel aabbIntersects;
+			CircleBatchKernel circleIntersects;
+			SegmentBatchKernel segmentsIntersect;
+			CircleSweepBatchKernel circleSweep;
+			SegmentAABBClipBatchKernel segmentAABBClip;
+			CircleAABBBatchKernel circleAABBCollision;
+			AABBPairBatchKernel aabbPairCollision;
+			AABBOBBBatchKernel aabbOBBIntersects;
+			CircleOBBBatchKernel circleOBBIntersects;
+			CapsuleAABBBatchKernel capsuleAABBIntersects;
+			AABBPairwiseKernel aabbPairwise;
+			CirclePairwiseKernel circlePairwise;
+			AABBCirclePairwiseKernel aabbCirclePairwise;
+			SegmentPairwiseKernel segmentPairwise;
+			AABBSegmentPairwiseKernel aabbSegmentPairwise;
+			CircleSegmentPairwiseKernel circleSegmentPairwise;
+		};
+
+		/**
+		 * \brief Tests the AABBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The SIMD kernels use it to process the elements that don't fill a whole register.
+		 */
+		static size_t aabb_intersects_range(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results, size_t first) {
+			const float minX = aabb.pos.x;
+			const float minY = aabb.pos.y;
+			const float maxX = aabb.pos.x + aabb.size.x;
+			const float maxY = aabb.pos.y + aabb.size.y;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				bool intersects =
+					maxX >= batch.minX[i] &&
+					maxY >= batch.minY[i] &&
+					minX <= batch.maxX[i] &&
+					minY <= batch.maxY[i];
+				results[i] = intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the circles of the batch from the given index to the end, one at a time.
+		 */
+		static size_t circle_intersects_range(const Circle& circle, const CircleBatch& batch, std::uint8_t* results, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float dx = circle.pos.x - batch.x[i];
+				float dy = circle.pos.y - batch.y[i];
+				float radii = circle.radius + batch.radius[i];
+				results[i] = dx * dx + dy * dy < radii * radii ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the segment against a single segment of the batch and writes the result at the given index.
+		 * \return 1 if the segments intersect, 0 otherwise.
+		 */
+		static std::uint8_t line_segments_intersect_lane(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u, size_t index) {
+			auto intersection = line_segments_parametric_intersection(segment, batch.at(index));
+			results[index] = intersection.type != IntersectionType::None ? 1 : 0;
+			if (t) {
+				t[index] = intersection.t;
+			}
+			if (u) {
+				u[index] = intersection.u;
+			}
+			return results[index];
+		}
+
+		/**
+		 * \brief Tests the segments of the batch from the given index to the end, one at a time.
+		 */
+		static size_t line_segments_intersect_range(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				hits += line_segments_intersect_lane(segment, batch, results, t, u, i);
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Recomputes the lanes of parallel segments with the scalar function.
+		 *
+		 * The SIMD kernels only handle segments that are not parallel to the tested segment
+		 * (the common case), the collinear overlaps are left to the scalar function.
+		 */
+		static size_t fix_parallel_lanes(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u, size_t first, unsigned int parallelMask) {
+			size_t hits = 0;
+			for (size_t lane = 0; parallelMask != 0; ++lane, parallelMask >>= 1) {
+				if (parallelMask & 1u) {
+					hits += line_segments_intersect_lane(segment, batch, results, t, u, first + lane);
+				}
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Clips the segment against the AABBs of the batch from the given index to the end, one at a time.
+		 */
+		static size_t line_segment_aabb_clip_range(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				auto clip = line_segment_aabb_clip(segment, batch.bounds(i));
+				results[i] = clip.intersects ? 1 : 0;
+				if (entry) {
+					entry[i] = clip.entry;
+				}
+				if (exit) {
+					exit[i] = clip.exit;
+				}
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Computes the collisions between the circle and the AABBs of the batch from the given index to the end, one at a time.
+		 *
+		 * Works on the bounds stored in the batch (and not on batch.at(i)) so that the results match the SIMD kernels exactly.
+		 */
+		static size_t circle_aabb_collision_range(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth, size_t first) {
+			const float radiusSquared = circle.radius * circle.radius;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float dx = circle.pos.x - std::min(std::max(circle.pos.x, batch.minX[i]), batch.maxX[i]);
+				float dy = circle.pos.y - std::min(std::max(circle.pos.y, batch.minY[i]), batch.maxY[i]);
+				float distanceSquared = dx * dx + dy * dy;
+
+				vec_t normal = NULL_VEC;
+				float penetration = 0.f;
+				if (distanceSquared < radiusSquared && distanceSquared > 0.f) {
+					float distance = std::sqrt(distanceSquared);
+					normal = vec_t(dx / distance, dy / distance);
+					penetration = circle.radius - distance;
+				}
+				else if (distanceSquared < radiusSquared) {
+					float left = circle.pos.x - batch.minX[i];
+					float right = batch.maxX[i] - circle.pos.x;
+					float top = circle.pos.y - batch.minY[i];
+					float bottom = batch.maxY[i] - circle.pos.y;
+					float closestX = std::min(left, right);
+					float closestY = std::min(top, bottom);
+					if (closestX < closestY) {
+						normal = left < right ? LEFT_VEC : RIGHT_VEC;
+						penetration = circle.radius + closestX;
+					}
+					else {
+						normal = top < bottom ? UP_VEC : DOWN_VEC;
+						penetration = circle.radius + closestY;
+					}
+				}
+
+				results[i] = distanceSquared < radiusSquared ? 1 : 0;
+				if (normalX) {
+					normalX[i] = normal.x;
+				}
+				if (normalY) {
+					normalY[i] = normal.y;
+				}
+				if (depth) {
+					depth[i] = penetration;
+				}
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Computes the collisions of the pairs from the given index to the end, one at a time.
+		 *
+		 * Works on the bounds stored in the batch, like the SIMD kernels.
+		 */
+		static size_t aabb_collision_range(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions, size_t first) {
+			size_t hits = 0;
+			for (size_t i = first; i < count; ++i) {
+				const std::uint32_t a = pairs[i].first;
+				const std::uint32_t b = pairs[i].second;
+
+				if (batch.maxX[a] < batch.minX[b] || batch.maxY[a] < batch.minY[b] || batch.minX[a] > batch.maxX[b] || batch.minY[a] > batch.maxY[b]) {
+					collisions[i] = AABBCollision{ NULL_VEC, NULL_VEC };
+					continue;
+				}
+
+				const bool left = batch.minX[b] + batch.maxX[b] <= batch.minX[a] + batch.maxX[a];
+				const bool top = batch.minY[b] + batch.maxY[b] <= batch.minY[a] + batch.maxY[a];
+				const vec_t delta(
+					std::abs(left ? batch.minX[a] - batch.maxX[b] : batch.maxX[a] - batch.minX[b]),
+					std::abs(top ? batch.minY[a] - batch.maxY[b] : batch.maxY[a] - batch.minY[b]));
+
+				if (delta.x > delta.y) {
+					collisions[i] = AABBCollision{ top ? UP_VEC : DOWN_VEC, delta };
+				}
+				else {
+					collisions[i] = AABBCollision{ left ? LEFT_VEC : RIGHT_VEC, delta };
+				}
+				++hits;
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Writes the collisions computed by the lanes of a register.
+		 *
+		 * \return The number of lanes that hold a collision.
+		 */
+		static size_t write_aabb_collision_lanes(const float* normalX, const float* normalY, const float* deltaX, const float* deltaY, size_t lanes, AABBCollision* collisions) {
+			size_t hits = 0;
+			for (size_t lane = 0; lane < lanes; ++lane) {
+				collisions[lane] = AABBCollision{ vec_t(normalX[lane], normalY[lane]), vec_t(deltaX[lane], deltaY[lane]) };
+				hits += (normalX[lane] != 0.f || normalY[lane] != 0.f) ? 1 : 0;
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Computes the time of impact of the moving circle on the segments of the batch from the given index to the end.
+		 *
+		 * \param earliest Earliest time of impact found so far, updated if an earlier one is found.
+		 * \param earliestIndex Index of the segment hit at the earliest time.
+		 */
+		static void circle_sweep_range(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex, size_t first) {
+			for (size_t i = first; i < batch.size(); ++i) {
+				float time;
+				if (circle_segment_time_of_impact(circle, motion, batch.at(i), time) && time < earliest) {
+					earliest = time;
+					earliestIndex = i;
+				}
+			}
+		}
+
+		/**
+		 * \brief Keeps the earliest time of impact among the lanes of a register.
+		 */
+		static void keep_earliest_lane(const float* times, size_t lanes, size_t first, float& earliest, size_t& earliestIndex) {
+			for (size_t lane = 0; lane < lanes; ++lane) {
+				if (times[lane] < earliest) {
+					earliest = times[lane];
+					earliestIndex = first + lane;
+				}
+			}
+		}
+
+		/**
+		 * \brief Tests the AABB against the OBBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The 4 axes of the separating axis theorem are the axes of the AABB and the cached axes of each OBB.
+		 */
+		static size_t aabb_obb_intersects_range(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results, size_t first) {
+			const float halfX = aabb.size.x / 2.f;
+			const float halfY = aabb.size.y / 2.f;
+			const float centerX = aabb.pos.x + halfX;
+			const float centerY = aabb.pos.y + halfY;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float tx = batch.centerX[i] - centerX;
+				float ty = batch.centerY[i] - centerY;
+				float cosine = batch.cosine[i];
+				float sine = batch.sine[i];
+				float absCosine = std::abs(cosine);
+				float absSine = std::abs(sine);
+				bool intersects =
+					std::abs(tx) < halfX + (batch.halfWidth[i] * absCosine + batch.halfHeight[i] * absSine) &&
+					std::abs(ty) < halfY + (batch.halfWidth[i] * absSine + batch.halfHeight[i] * absCosine) &&
+					std::abs(tx * cosine + ty * sine) < (halfX * absCosine + halfY * absSine) + batch.halfWidth[i] &&
+					std::abs(ty * cosine - tx * sine) < (halfX * absSine + halfY * absCosine) + batch.halfHeight[i];
+				results[i] = intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the circle against the OBBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The center of the circle is moved into the coordinates of each box, then compared with its half size.
+		 */
+		static size_t circle_obb_intersects_range(const Circle& circle, const OBBBatch& batch, std::uint8_t* results, size_t first) {
+			const float radiusSquared = circle.radius * circle.radius;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				float dx = circle.pos.x - batch.centerX[i];
+				float dy = circle.pos.y - batch.centerY[i];
+				float localX = dx * batch.cosine[i] + dy * batch.sine[i];
+				float localY = dy * batch.cosine[i] - dx * batch.sine[i];
+				float outsideX = std::max(std::abs(localX) - batch.halfWidth[i], 0.f);
+				float outsideY = std::max(std::abs(localY) - batch.halfHeight[i], 0.f);
+				results[i] = outsideX * outsideX + outsideY * outsideY < radiusSquared ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Constants of a capsule shared by the lanes of the capsule vs AABB kernels.
+		 */
+		struct CapsuleBatchQuery {
+			float startX, startY; /**< Start of the segment. */
+			float directionX, directionY; /**< End of the segment minus its start. */
+			float inverseLengthSquared; /**< 1 / squared length of the segment, 0 if the segment is a point. */
+			float minX, minY, maxX, maxY; /**< Bounds of the segment. */
+			float normalX, normalY; /**< Normal of the segment (not normalized). */
+			float absNormalX, absNormalY; /**< Absolute values of the normal. */
+			float normalDotStart; /**< Projection of the start of the segment on the normal. */
+			float radiusSquared; /**< Squared radius of the capsule. */
+		};
+
+		static CapsuleBatchQuery make_capsule_batch_query(const Capsule& capsule) {
+			const LineSegment& segment = capsule.segment;
+			CapsuleBatchQuery query;
+			query.startX = segment.start.x;
+			query.startY = segment.start.y;
+			query.directionX = segment.end.x - segment.start.x;
+			query.directionY = segment.end.y - segment.start.y;
+			float lengthSquared = query.directionX * query.directionX + query.directionY * query.directionY;
+			query.inverseLengthSquared = lengthSquared == 0.f ? 0.f : 1.f / lengthSquared;
+			query.minX = segment.minX();
+			query.minY = segment.minY();
+			query.maxX = segment.maxX();
+			query.maxY = segment.maxY();
+			// A segment reduced to a point has no normal : the x axis, already tested by the bounds, keeps the strict test of the normal true when the point is inside
+			query.normalX = lengthSquared == 0.f ? 1.f : -query.directionY;
+			query.normalY = query.directionX;
+			query.absNormalX = std::abs(query.normalX);
+			query.absNormalY = std::abs(query.normalY);
+			query.normalDotStart = query.normalX * query.startX + query.normalY * query.startY;
+			query.radiusSquared = capsule.radius * capsule.radius;
+			return query;
+		}
+
+		/**
+		 * \brief Squared distance between a point and the segment of a capsule.
+		 */
+		static float capsule_batch_point_distance(const CapsuleBatchQuery& query, float x, float y) {
+			float t = std::min(std::max(((x - query.startX) * query.directionX + (y - query.startY) * query.directionY) * query.inverseLengthSquared, 0.f), 1.f);
+			float dx = (query.startX + t * query.directionX) - x;
+			float dy = (query.startY + t * query.directionY) - y;
+			return dx * dx + dy * dy;
+		}
+
+		/**
+		 * \brief Tests the capsule against the AABBs of the batch from the given index to the end, one at a time.
+		 *
+		 * The capsule intersects a box if its segment crosses the inside of the box (separating axis theorem on
+		 * the axes of the box and the normal of the segment), or if the closest points of the segment
+		 * and the box are closer than the radius. These points are an extremity of the segment and its
+		 * closest point on the box, or a corner of the box and its closest point on the segment.
+		 */
+		static size_t capsule_aabb_intersects_range(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results, size_t first) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const float endX = query.startX + query.directionX;
+			const float endY = query.startY + query.directionY;
+
+			size_t hits = 0;
+			for (size_t i = first; i < batch.size(); ++i) {
+				const float minX = batch.minX[i];
+				const float minY = batch.minY[i];
+				const float maxX = batch.maxX[i];
+				const float maxY = batch.maxY[i];
+
+				float centerX = (minX + maxX) * 0.5f;
+				float centerY = (minY + maxY) * 0.5f;
+				float halfX = (maxX - minX) * 0.5f;
+				float halfY = (maxY - minY) * 0.5f;
+				bool crossing =
+					query.minX < maxX && query.maxX > minX && query.minY < maxY && query.maxY > minY &&
+					std::abs((query.normalX * centerX + query.normalY * centerY) - query.normalDotStart) < halfX * query.absNormalX + halfY * query.absNormalY;
+
+				float startDX = query.startX - std::min(std::max(query.startX, minX), maxX);
+				float startDY = query.startY - std::min(std::max(query.startY, minY), maxY);
+				float endDX = endX - std::min(std::max(endX, minX), maxX);
+				float endDY = endY - std::min(std::max(endY, minY), maxY);
+				float closest = std::min(startDX * startDX + startDY * startDY, endDX * endDX + endDY * endDY);
+				closest = std::min(closest, std::min(capsule_batch_point_distance(query, minX, minY), capsule_batch_point_distance(query, maxX, minY)));
+				closest = std::min(closest, std::min(capsule_batch_point_distance(query, minX, maxY), capsule_batch_point_distance(query, maxX, maxY)));
+
+				results[i] = crossing || closest < query.radiusSquared ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs of AABBs (first[i], other[i]) from the given index to the end, one at a time.
+		 */
+		static size_t aabb_intersects_pairwise_range(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < first.size(); ++i) {
+				bool intersects =
+					first.maxX[i] >= other.minX[i] &&
+					first.maxY[i] >= other.minY[i] &&
+					first.minX[i] <= other.maxX[i] &&
+					first.minY[i] <= other.maxY[i];
+				results[i] = intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs of circles (first[i], other[i]) from the given index to the end, one at a time.
+		 */
+		static size_t circle_intersects_pairwise_range(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < first.size(); ++i) {
+				float dx = first.x[i] - other.x[i];
+				float dy = first.y[i] - other.y[i];
+				float radii = first.radius[i] + other.radius[i];
+				results[i] = dx * dx + dy * dy < radii * radii ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs (aabbs[i], circles[i]) from the given index to the end, one at a time.
+		 */
+		static size_t aabb_circle_intersects_pairwise_range(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < aabbs.size(); ++i) {
+				float dx = circles.x[i] - std::min(std::max(circles.x[i], aabbs.minX[i]), aabbs.maxX[i]);
+				float dy = circles.y[i] - std::min(std::max(circles.y[i], aabbs.minY[i]), aabbs.maxY[i]);
+				results[i] = dx * dx + dy * dy < circles.radius[i] * circles.radius[i] ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests a single pair of segments (first[index], other[index]) and writes the result at the given index.
+		 * \return 1 if the segments intersect, 0 otherwise.
+		 */
+		static std::uint8_t line_segments_intersect_pairwise_lane(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results, size_t index) {
+			results[index] = line_segments_parametric_intersection(first.at(index), other.at(index)).type != IntersectionType::None ? 1 : 0;
+			return results[index];
+		}
+
+		/**
+		 * \brief Tests the pairs of segments (first[i], other[i]) from the given index to the end, one at a time.
+		 */
+		static size_t line_segments_intersect_pairwise_range(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < first.size(); ++i) {
+				hits += line_segments_intersect_pairwise_lane(first, other, results, i);
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Recomputes the lanes of parallel pairs of segments with the scalar function (see fix_parallel_lanes()).
+		 */
+		static size_t fix_parallel_pairwise_lanes(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results, size_t begin, unsigned int parallelMask) {
+			size_t hits = 0;
+			for (size_t lane = 0; parallelMask != 0; ++lane, parallelMask >>= 1) {
+				if (parallelMask & 1u) {
+					hits += line_segments_intersect_pairwise_lane(first, other, results, begin + lane);
+				}
+			}
+			return hits;
+		}
+
+
+		/**
+		 * \brief Tests the pairs (aabbs[i], segments[i]) from the given index to the end, one at a time.
+		 */
+		static size_t aabb_segment_intersects_pairwise_range(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < aabbs.size(); ++i) {
+				results[i] = line_segment_aabb_clip(segments.at(i), aabbs.bounds(i)).intersects ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		/**
+		 * \brief Tests the pairs (circles[i], segments[i]) from the given index to the end, one at a time.
+		 */
+		static size_t circle_segment_intersects_pairwise_range(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results, size_t begin) {
+			size_t hits = 0;
+			for (size_t i = begin; i < circles.size(); ++i) {
+				results[i] = circle_intersects(circles.at(i), segments.at(i)) ? 1 : 0;
+				hits += results[i];
+			}
+			return hits;
+		}
+
+		static size_t aabb_intersects_batch_scalar(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			return aabb_intersects_range(aabb, batch, results, 0);
+		}
+
+		static size_t circle_intersects_batch_scalar(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			return circle_intersects_range(circle, batch, results, 0);
+		}
+
+		static size_t line_segments_intersect_batch_scalar(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			return line_segments_intersect_range(segment, batch, results, t, u, 0);
+		}
+
+		static size_t line_segment_aabb_clip_batch_scalar(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			return line_segment_aabb_clip_range(segment, batch, results, entry, exit, 0);
+		}
+
+		static size_t circle_aabb_collision_batch_scalar(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			return circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, 0);
+		}
+
+		static size_t aabb_collision_batch_scalar(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			return aabb_collision_range(batch, pairs, count, collisions, 0);
+		}
+
+		static void circle_sweep_batch_scalar(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex) {
+			circle_sweep_range(circle, motion, batch, earliest, earliestIndex, 0);
+		}
+
+		static size_t aabb_obb_intersects_batch_scalar(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			return aabb_obb_intersects_range(aabb, batch, results, 0);
+		}
+
+		static size_t circle_obb_intersects_batch_scalar(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			return circle_obb_intersects_range(circle, batch, results, 0);
+		}
+
+		static size_t capsule_aabb_intersects_batch_scalar(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			return capsule_aabb_intersects_range(capsule, batch, results, 0);
+		}
+
+		static size_t aabb_intersects_pairwise_scalar(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			return aabb_intersects_pairwise_range(first, other, results, 0);
+		}
+
+		static size_t circle_intersects_pairwise_scalar(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			return circle_intersects_pairwise_range(first, other, results, 0);
+		}
+
+		static size_t aabb_circle_intersects_pairwise_scalar(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			return aabb_circle_intersects_pairwise_range(aabbs, circles, results, 0);
+		}
+
+		static size_t line_segments_intersect_pairwise_scalar(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			return line_segments_intersect_pairwise_range(first, other, results, 0);
+		}
+
+		static size_t aabb_segment_intersects_pairwise_scalar(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			return aabb_segment_intersects_pairwise_range(aabbs, segments, results, 0);
+		}
+
+		static size_t circle_segment_intersects_pairwise_scalar(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			return circle_segment_intersects_pairwise_range(circles, segments, results, 0);
+		}
+
+		/**
+		 * \brief Writes the lanes of a comparison bitmask into the results array (one byte per lane).
+		 * \return The number of bits set in the mask.
+		 */
+		static size_t write_lane_mask(unsigned int mask, size_t lanes, std::uint8_t* results) {
+			size_t hits = 0;
+			for (size_t lane = 0; lane < lanes; ++lane) {
+				results[lane] = static_cast<std::uint8_t>((mask >> lane) & 1u);
+				hits += results[lane];
+			}
+			return hits;
+		}
+
+#ifdef CH_SIMD_X86
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_intersects_batch_sse2(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			const __m128 minX = _mm_set1_ps(aabb.pos.x);
+			const __m128 minY = _mm_set1_ps(aabb.pos.y);
+			const __m128 maxX = _mm_set1_ps(aabb.pos.x + aabb.size.x);
+			const __m128 maxY = _mm_set1_ps(aabb.pos.y + aabb.size.y);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 inside = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(maxX, _mm_loadu_ps(&batch.minX[i])), _mm_cmpge_ps(maxY, _mm_loadu_ps(&batch.minY[i]))),
+					_mm_and_ps(_mm_cmple_ps(minX, _mm_loadu_ps(&batch.maxX[i])), _mm_cmple_ps(minY, _mm_loadu_ps(&batch.maxY[i]))));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_intersects_batch_sse2(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 cr = _mm_set1_ps(circle.radius);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 dx = _mm_sub_ps(cx, _mm_loadu_ps(&batch.x[i]));
+				__m128 dy = _mm_sub_ps(cy, _mm_loadu_ps(&batch.y[i]));
+				__m128 radii = _mm_add_ps(cr, _mm_loadu_ps(&batch.radius[i]));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(radii, radii));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_intersects_range(circle, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t line_segments_intersect_batch_sse2(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			const __m128 ax = _mm_set1_ps(segment.start.x);
+			const __m128 ay = _mm_set1_ps(segment.start.y);
+			const __m128 rx = _mm_set1_ps(segment.end.x - segment.start.x);
+			const __m128 ry = _mm_set1_ps(segment.end.y - segment.start.y);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 bx = _mm_loadu_ps(&batch.startX[i]);
+				__m128 by = _mm_loadu_ps(&batch.startY[i]);
+				__m128 sx = _mm_sub_ps(_mm_loadu_ps(&batch.endX[i]), bx);
+				__m128 sy = _mm_sub_ps(_mm_loadu_ps(&batch.endY[i]), by);
+				__m128 qpx = _mm_sub_ps(bx, ax);
+				__m128 qpy = _mm_sub_ps(by, ay);
+
+				__m128 denominator = _mm_sub_ps(_mm_mul_ps(rx, sy), _mm_mul_ps(ry, sx));
+				__m128 tv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, sy), _mm_mul_ps(qpy, sx)), denominator);
+				__m128 uv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, ry), _mm_mul_ps(qpy, rx)), denominator);
+				__m128 crossing = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(tv, zero), _mm_cmple_ps(tv, one)),
+					_mm_and_ps(_mm_cmpge_ps(uv, zero), _mm_cmple_ps(uv, one)));
+
+				if (t) {
+					_mm_storeu_ps(t + i, _mm_and_ps(tv, crossing));
+				}
+				if (u) {
+					_mm_storeu_ps(u + i, _mm_and_ps(uv, crossing));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(crossing)), 4, results + i);
+				hits += fix_parallel_lanes(segment, batch, results, t, u, i, static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(denominator, zero))));
+			}
+			return hits + line_segments_intersect_range(segment, batch, results, t, u, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t line_segment_aabb_clip_batch_sse2(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			const vec_t direction = segment.end - segment.start;
+			const __m128 sx = _mm_set1_ps(segment.start.x);
+			const __m128 sy = _mm_set1_ps(segment.start.y);
+			const __m128 inverseX = _mm_set1_ps(direction.x != 0.f ? 1.f / direction.x : 0.f);
+			const __m128 inverseY = _mm_set1_ps(direction.y != 0.f ? 1.f / direction.y : 0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&batch.minX[i]);
+				__m128 minY = _mm_loadu_ps(&batch.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&batch.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&batch.maxY[i]);
+				__m128 tEntry = _mm_setzero_ps();
+				__m128 tExit = _mm_set1_ps(1.f);
+				__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+				// The direction is the same for every lane, so are the branches
+				if (direction.x != 0.f) {
+					__m128 t1 = _mm_mul_ps(_mm_sub_ps(minX, sx), inverseX);
+					__m128 t2 = _mm_mul_ps(_mm_sub_ps(maxX, sx), inverseX);
+					tEntry = _mm_max_ps(tEntry, _mm_min_ps(t1, t2));
+					tExit = _mm_min_ps(tExit, _mm_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(minX, sx), _mm_cmpge_ps(maxX, sx)));
+				}
+				if (direction.y != 0.f) {
+					__m128 t1 = _mm_mul_ps(_mm_sub_ps(minY, sy), inverseY);
+					__m128 t2 = _mm_mul_ps(_mm_sub_ps(maxY, sy), inverseY);
+					tEntry = _mm_max_ps(tEntry, _mm_min_ps(t1, t2));
+					tExit = _mm_min_ps(tExit, _mm_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(minY, sy), _mm_cmpge_ps(maxY, sy)));
+				}
+
+				inside = _mm_and_ps(inside, _mm_cmple_ps(tEntry, tExit));
+				if (entry) {
+					_mm_storeu_ps(entry + i, _mm_and_ps(tEntry, inside));
+				}
+				if (exit) {
+					_mm_storeu_ps(exit + i, _mm_and_ps(tExit, inside));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + line_segment_aabb_clip_range(segment, batch, results, entry, exit, i);
+		}
+
+		/**
+		 * \brief Selects a where the mask is set, b elsewhere.
+		 */
+		CH_SIMD_TARGET("sse2")
+		static __m128 select_sse2(__m128 mask, __m128 a, __m128 b) {
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_aabb_collision_batch_sse2(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 radius = _mm_set1_ps(circle.radius);
+			const __m128 radiusSquared = _mm_set1_ps(circle.radius * circle.radius);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 minusOne = _mm_set1_ps(-1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&batch.minX[i]);
+				__m128 minY = _mm_loadu_ps(&batch.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&batch.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&batch.maxY[i]);
+
+				__m128 dx = _mm_sub_ps(cx, _mm_min_ps(_mm_max_ps(cx, minX), maxX));
+				__m128 dy = _mm_sub_ps(cy, _mm_min_ps(_mm_max_ps(cy, minY), maxY));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 overlap = _mm_cmplt_ps(distanceSquared, radiusSquared);
+				__m128 outside = _mm_cmpgt_ps(distanceSquared, zero);
+
+				// Center outside of the box : the normal goes from the closest point towards the center
+				__m128 distance = _mm_sqrt_ps(distanceSquared);
+				__m128 outsideX = _mm_div_ps(dx, distance);
+				__m128 outsideY = _mm_div_ps(dy, distance);
+				__m128 outsideDepth = _mm_sub_ps(radius, distance);
+
+				// Center inside of the box : the circle is pushed out through the closest side
+				__m128 left = _mm_sub_ps(cx, minX);
+				__m128 right = _mm_sub_ps(maxX, cx);
+				__m128 top = _mm_sub_ps(cy, minY);
+				__m128 bottom = _mm_sub_ps(maxY, cy);
+				__m128 closestX = _mm_min_ps(left, right);
+				__m128 closestY = _mm_min_ps(top, bottom);
+				__m128 alongX = _mm_cmplt_ps(closestX, closestY);
+				__m128 insideX = _mm_and_ps(alongX, select_sse2(_mm_cmplt_ps(left, right), minusOne, one));
+				__m128 insideY = _mm_andnot_ps(alongX, select_sse2(_mm_cmplt_ps(top, bottom), minusOne, one));
+				__m128 insideDepth = _mm_add_ps(radius, _mm_min_ps(closestX, closestY));
+
+				if (normalX) {
+					_mm_storeu_ps(normalX + i, _mm_and_ps(overlap, select_sse2(outside, outsideX, insideX)));
+				}
+				if (normalY) {
+					_mm_storeu_ps(normalY + i, _mm_and_ps(overlap, select_sse2(outside, outsideY, insideY)));
+				}
+				if (depth) {
+					_mm_storeu_ps(depth + i, _mm_and_ps(overlap, select_sse2(outside, outsideDepth, insideDepth)));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(overlap)), 4, results + i);
+			}
+			return hits + circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_collision_batch_sse2(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 minusOne = _mm_set1_ps(-1.f);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			alignas(16) float normalX[4];
+			alignas(16) float normalY[4];
+			alignas(16) float deltaX[4];
+			alignas(16) float deltaY[4];
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				const AABBIndexPair* p = pairs + i;
+				__m128 minX1 = _mm_set_ps(batch.minX[p[3].first], batch.minX[p[2].first], batch.minX[p[1].first], batch.minX[p[0].first]);
+				__m128 minY1 = _mm_set_ps(batch.minY[p[3].first], batch.minY[p[2].first], batch.minY[p[1].first], batch.minY[p[0].first]);
+				__m128 maxX1 = _mm_set_ps(batch.maxX[p[3].first], batch.maxX[p[2].first], batch.maxX[p[1].first], batch.maxX[p[0].first]);
+				__m128 maxY1 = _mm_set_ps(batch.maxY[p[3].first], batch.maxY[p[2].first], batch.maxY[p[1].first], batch.maxY[p[0].first]);
+				__m128 minX2 = _mm_set_ps(batch.minX[p[3].second], batch.minX[p[2].second], batch.minX[p[1].second], batch.minX[p[0].second]);
+				__m128 minY2 = _mm_set_ps(batch.minY[p[3].second], batch.minY[p[2].second], batch.minY[p[1].second], batch.minY[p[0].second]);
+				__m128 maxX2 = _mm_set_ps(batch.maxX[p[3].second], batch.maxX[p[2].second], batch.maxX[p[1].second], batch.maxX[p[0].second]);
+				__m128 maxY2 = _mm_set_ps(batch.maxY[p[3].second], batch.maxY[p[2].second], batch.maxY[p[1].second], batch.maxY[p[0].second]);
+
+				__m128 intersects = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(maxX1, minX2), _mm_cmpge_ps(maxY1, minY2)),
+					_mm_and_ps(_mm_cmple_ps(minX1, maxX2), _mm_cmple_ps(minY1, maxY2)));
+
+				// Side of the first AABB closest to the center of the second one, on each axis
+				__m128 left = _mm_cmple_ps(_mm_add_ps(minX2, maxX2), _mm_add_ps(minX1, maxX1));
+				__m128 top = _mm_cmple_ps(_mm_add_ps(minY2, maxY2), _mm_add_ps(minY1, maxY1));
+				__m128 dx = _mm_andnot_ps(signMask, select_sse2(left, _mm_sub_ps(minX1, maxX2), _mm_sub_ps(maxX1, minX2)));
+				__m128 dy = _mm_andnot_ps(signMask, select_sse2(top, _mm_sub_ps(minY1, maxY2), _mm_sub_ps(maxY1, minY2)));
+				__m128 vertical = _mm_cmpgt_ps(dx, dy);
+
+				_mm_store_ps(normalX, _mm_and_ps(intersects, _mm_andnot_ps(vertical, select_sse2(left, minusOne, one))));
+				_mm_store_ps(normalY, _mm_and_ps(intersects, _mm_and_ps(vertical, select_sse2(top, minusOne, one))));
+				_mm_store_ps(deltaX, _mm_and_ps(intersects, dx));
+				_mm_store_ps(deltaY, _mm_and_ps(intersects, dy));
+				hits += write_aabb_collision_lanes(normalX, normalY, deltaX, deltaY, 4, collisions + i);
+			}
+			return hits + aabb_collision_range(batch, pairs, count, collisions, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static void circle_sweep_batch_sse2(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 r = _mm_set1_ps(circle.radius);
+			const __m128 r2 = _mm_set1_ps(circle.radius * circle.radius);
+			const __m128 dx = _mm_set1_ps(motion.x);
+			const __m128 dy = _mm_set1_ps(motion.y);
+			const __m128 dd = _mm_set1_ps(motion.x * motion.x + motion.y * motion.y);
+			const __m128 moving = _mm_cmpgt_ps(dd, _mm_setzero_ps());
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+			const __m128 signBit = _mm_set1_ps(-0.f);
+
+			size_t i = 0;
+			alignas(16) float times[4];
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 ax = _mm_loadu_ps(&batch.startX[i]);
+				__m128 ay = _mm_loadu_ps(&batch.startY[i]);
+				__m128 ex = _mm_sub_ps(_mm_loadu_ps(&batch.endX[i]), ax);
+				__m128 ey = _mm_sub_ps(_mm_loadu_ps(&batch.endY[i]), ay);
+				__m128 mx = _mm_sub_ps(cx, ax);
+				__m128 my = _mm_sub_ps(cy, ay);
+				__m128 ee = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+				__m128 notPoint = _mm_cmpgt_ps(ee, zero);
+
+				// Already intersecting (distance from the center to the closest point of the segment)
+				__m128 u0 = _mm_and_ps(_mm_div_ps(_mm_add_ps(_mm_mul_ps(mx, ex), _mm_mul_ps(my, ey)), ee), notPoint);
+				u0 = _mm_min_ps(_mm_max_ps(u0, zero), one);
+				__m128 qx = _mm_sub_ps(_mm_mul_ps(ex, u0), mx);
+				__m128 qy = _mm_sub_ps(_mm_mul_ps(ey, u0), my);
+				__m128 intersecting = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), r2);
+
+				// Side of the segment
+				__m128 length = _mm_sqrt_ps(ee);
+				__m128 nx = _mm_div_ps(_mm_xor_ps(ey, signBit), length);
+				__m128 ny = _mm_div_ps(ex, length);
+				__m128 side = _mm_add_ps(_mm_mul_ps(mx, nx), _mm_mul_ps(my, ny));
+				__m128 flip = _mm_and_ps(side, signBit);
+				nx = _mm_xor_ps(nx, flip);
+				ny = _mm_xor_ps(ny, flip);
+				side = _mm_xor_ps(side, flip);
+				__m128 approach = _mm_add_ps(_mm_mul_ps(dx, nx), _mm_mul_ps(dy, ny));
+				__m128 tSide = _mm_div_ps(_mm_sub_ps(side, r), _mm_xor_ps(approach, signBit));
+				__m128 px = _mm_sub_ps(_mm_add_ps(mx, _mm_mul_ps(dx, tSide)), _mm_mul_ps(nx, r));
+				__m128 py = _mm_sub_ps(_mm_add_ps(my, _mm_mul_ps(dy, tSide)), _mm_mul_ps(ny, r));
+				__m128 u = _mm_div_ps(_mm_add_ps(_mm_mul_ps(px, ex), _mm_mul_ps(py, ey)), ee);
+				__m128 sideHit = _mm_and_ps(_mm_and_ps(notPoint, _mm_cmplt_ps(approach, zero)),
+					_mm_and_ps(_mm_and_ps(_mm_cmpge_ps(tSide, zero), _mm_cmple_ps(tSide, one)), _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one))));
+				__m128 best = select_sse2(sideHit, tSide, infinity);
+
+				// Extremities of the segment
+				for (int extremity = 0; extremity < 2; ++extremity) {
+					__m128 tx = extremity == 0 ? mx : _mm_sub_ps(mx, ex);
+					__m128 ty = extremity == 0 ? my : _mm_sub_ps(my, ey);
+					__m128 b = _mm_add_ps(_mm_mul_ps(tx, dx), _mm_mul_ps(ty, dy));
+					__m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(tx, tx), _mm_mul_ps(ty, ty)), r2);
+					__m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(dd, c));
+					__m128 t = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(b, signBit), _mm_sqrt_ps(_mm_max_ps(discriminant, zero))), dd);
+					__m128 extremityHit = _mm_and_ps(_mm_and_ps(moving, _mm_cmplt_ps(b, zero)), _mm_and_ps(_mm_cmpge_ps(discriminant, zero), _mm_cmple_ps(t, one)));
+					best = _mm_min_ps(best, select_sse2(extremityHit, t, infinity));
+				}
+
+				best = select_sse2(intersecting, zero, best);
+				if (_mm_movemask_ps(_mm_cmplt_ps(best, _mm_set1_ps(earliest))) != 0) {
+					_mm_store_ps(times, best);
+					keep_earliest_lane(times, 4, i, earliest, earliestIndex);
+				}
+			}
+			circle_sweep_range(circle, motion, batch, earliest, earliestIndex, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_obb_intersects_batch_sse2(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			const float halfWidth = aabb.size.x / 2.f;
+			const float halfHeight = aabb.size.y / 2.f;
+			const __m128 halfX = _mm_set1_ps(halfWidth);
+			const __m128 halfY = _mm_set1_ps(halfHeight);
+			const __m128 centerX = _mm_set1_ps(aabb.pos.x + halfWidth);
+			const __m128 centerY = _mm_set1_ps(aabb.pos.y + halfHeight);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 tx = _mm_sub_ps(_mm_loadu_ps(&batch.centerX[i]), centerX);
+				__m128 ty = _mm_sub_ps(_mm_loadu_ps(&batch.centerY[i]), centerY);
+				__m128 cosine = _mm_loadu_ps(&batch.cosine[i]);
+				__m128 sine = _mm_loadu_ps(&batch.sine[i]);
+				__m128 absCosine = _mm_andnot_ps(signMask, cosine);
+				__m128 absSine = _mm_andnot_ps(signMask, sine);
+				__m128 obbHalfX = _mm_loadu_ps(&batch.halfWidth[i]);
+				__m128 obbHalfY = _mm_loadu_ps(&batch.halfHeight[i]);
+				__m128 extentX = _mm_add_ps(halfX, _mm_add_ps(_mm_mul_ps(obbHalfX, absCosine), _mm_mul_ps(obbHalfY, absSine)));
+				__m128 extentY = _mm_add_ps(halfY, _mm_add_ps(_mm_mul_ps(obbHalfX, absSine), _mm_mul_ps(obbHalfY, absCosine)));
+				__m128 extentU = _mm_add_ps(_mm_add_ps(_mm_mul_ps(halfX, absCosine), _mm_mul_ps(halfY, absSine)), obbHalfX);
+				__m128 extentV = _mm_add_ps(_mm_add_ps(_mm_mul_ps(halfX, absSine), _mm_mul_ps(halfY, absCosine)), obbHalfY);
+				__m128 projectedU = _mm_andnot_ps(signMask, _mm_add_ps(_mm_mul_ps(tx, cosine), _mm_mul_ps(ty, sine)));
+				__m128 projectedV = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_mul_ps(ty, cosine), _mm_mul_ps(tx, sine)));
+				__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(_mm_andnot_ps(signMask, tx), extentX), _mm_cmplt_ps(_mm_andnot_ps(signMask, ty), extentY)), _mm_and_ps(_mm_cmplt_ps(projectedU, extentU), _mm_cmplt_ps(projectedV, extentV)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_obb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_obb_intersects_batch_sse2(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			const __m128 cx = _mm_set1_ps(circle.pos.x);
+			const __m128 cy = _mm_set1_ps(circle.pos.y);
+			const __m128 radiusSquared = _mm_set1_ps(circle.radius * circle.radius);
+			const __m128 zero = _mm_set1_ps(0.f);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 dx = _mm_sub_ps(cx, _mm_loadu_ps(&batch.centerX[i]));
+				__m128 dy = _mm_sub_ps(cy, _mm_loadu_ps(&batch.centerY[i]));
+				__m128 cosine = _mm_loadu_ps(&batch.cosine[i]);
+				__m128 sine = _mm_loadu_ps(&batch.sine[i]);
+				__m128 localX = _mm_add_ps(_mm_mul_ps(dx, cosine), _mm_mul_ps(dy, sine));
+				__m128 localY = _mm_sub_ps(_mm_mul_ps(dy, cosine), _mm_mul_ps(dx, sine));
+				__m128 outsideX = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, localX), _mm_loadu_ps(&batch.halfWidth[i])), zero);
+				__m128 outsideY = _mm_max_ps(_mm_sub_ps(_mm_andnot_ps(signMask, localY), _mm_loadu_ps(&batch.halfHeight[i])), zero);
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(outsideX, outsideX), _mm_mul_ps(outsideY, outsideY));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, radiusSquared);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_obb_intersects_range(circle, batch, results, i);
+		}
+
+		/**
+		 * \brief Squared distance between a corner of the boxes of 4 lanes and the segment of a capsule.
+		 */
+		CH_SIMD_TARGET("sse2")
+		static __m128 capsule_batch_corner_distance_sse2(__m128 x, __m128 y, __m128 startX, __m128 startY, __m128 directionX, __m128 directionY, __m128 inverseLengthSquared, __m128 zero, __m128 one) {
+			__m128 t = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(x, startX), directionX), _mm_mul_ps(_mm_sub_ps(y, startY), directionY)), inverseLengthSquared), zero), one);
+			__m128 dx = _mm_sub_ps(_mm_add_ps(startX, _mm_mul_ps(t, directionX)), x);
+			__m128 dy = _mm_sub_ps(_mm_add_ps(startY, _mm_mul_ps(t, directionY)), y);
+			return _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t capsule_aabb_intersects_batch_sse2(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const __m128 startX = _mm_set1_ps(query.startX);
+			const __m128 startY = _mm_set1_ps(query.startY);
+			const __m128 endX = _mm_set1_ps(query.startX + query.directionX);
+			const __m128 endY = _mm_set1_ps(query.startY + query.directionY);
+			const __m128 directionX = _mm_set1_ps(query.directionX);
+			const __m128 directionY = _mm_set1_ps(query.directionY);
+			const __m128 inverseLengthSquared = _mm_set1_ps(query.inverseLengthSquared);
+			const __m128 segmentMinX = _mm_set1_ps(query.minX);
+			const __m128 segmentMinY = _mm_set1_ps(query.minY);
+			const __m128 segmentMaxX = _mm_set1_ps(query.maxX);
+			const __m128 segmentMaxY = _mm_set1_ps(query.maxY);
+			const __m128 normalX = _mm_set1_ps(query.normalX);
+			const __m128 normalY = _mm_set1_ps(query.normalY);
+			const __m128 absNormalX = _mm_set1_ps(query.absNormalX);
+			const __m128 absNormalY = _mm_set1_ps(query.absNormalY);
+			const __m128 normalDotStart = _mm_set1_ps(query.normalDotStart);
+			const __m128 radiusSquared = _mm_set1_ps(query.radiusSquared);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 zero = _mm_set1_ps(0.f);
+			const __m128 one = _mm_set1_ps(1.f);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= batch.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&batch.minX[i]);
+				__m128 minY = _mm_loadu_ps(&batch.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&batch.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&batch.maxY[i]);
+
+				__m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+				__m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+				__m128 halfX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+				__m128 halfY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+				__m128 crossing = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(segmentMinX, maxX), _mm_cmpgt_ps(segmentMaxX, minX)), _mm_and_ps(_mm_cmplt_ps(segmentMinY, maxY), _mm_cmpgt_ps(segmentMaxY, minY)));
+				crossing = _mm_and_ps(crossing, _mm_cmplt_ps(_mm_andnot_ps(signMask, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(normalX, centerX), _mm_mul_ps(normalY, centerY)), normalDotStart)), _mm_add_ps(_mm_mul_ps(halfX, absNormalX), _mm_mul_ps(halfY, absNormalY))));
+
+				__m128 startDX = _mm_sub_ps(startX, _mm_min_ps(_mm_max_ps(startX, minX), maxX));
+				__m128 startDY = _mm_sub_ps(startY, _mm_min_ps(_mm_max_ps(startY, minY), maxY));
+				__m128 endDX = _mm_sub_ps(endX, _mm_min_ps(_mm_max_ps(endX, minX), maxX));
+				__m128 endDY = _mm_sub_ps(endY, _mm_min_ps(_mm_max_ps(endY, minY), maxY));
+				__m128 closest = _mm_min_ps(_mm_add_ps(_mm_mul_ps(startDX, startDX), _mm_mul_ps(startDY, startDY)), _mm_add_ps(_mm_mul_ps(endDX, endDX), _mm_mul_ps(endDY, endDY)));
+				closest = _mm_min_ps(closest, _mm_min_ps(capsule_batch_corner_distance_sse2(minX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_sse2(maxX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+				closest = _mm_min_ps(closest, _mm_min_ps(capsule_batch_corner_distance_sse2(minX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_sse2(maxX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+
+				__m128 inside = _mm_or_ps(crossing, _mm_cmplt_ps(closest, radiusSquared));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + capsule_aabb_intersects_range(capsule, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_intersects_pairwise_sse2(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= first.size(); i += 4) {
+				__m128 inside = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(&first.maxX[i]), _mm_loadu_ps(&other.minX[i])), _mm_cmpge_ps(_mm_loadu_ps(&first.maxY[i]), _mm_loadu_ps(&other.minY[i]))),
+					_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&first.minX[i]), _mm_loadu_ps(&other.maxX[i])), _mm_cmple_ps(_mm_loadu_ps(&first.minY[i]), _mm_loadu_ps(&other.maxY[i]))));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_intersects_pairwise_sse2(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= first.size(); i += 4) {
+				__m128 dx = _mm_sub_ps(_mm_loadu_ps(&first.x[i]), _mm_loadu_ps(&other.x[i]));
+				__m128 dy = _mm_sub_ps(_mm_loadu_ps(&first.y[i]), _mm_loadu_ps(&other.y[i]));
+				__m128 radii = _mm_add_ps(_mm_loadu_ps(&first.radius[i]), _mm_loadu_ps(&other.radius[i]));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(radii, radii));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_circle_intersects_pairwise_sse2(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= aabbs.size(); i += 4) {
+				__m128 cx = _mm_loadu_ps(&circles.x[i]);
+				__m128 cy = _mm_loadu_ps(&circles.y[i]);
+				__m128 r = _mm_loadu_ps(&circles.radius[i]);
+				__m128 dx = _mm_sub_ps(cx, _mm_min_ps(_mm_max_ps(cx, _mm_loadu_ps(&aabbs.minX[i])), _mm_loadu_ps(&aabbs.maxX[i])));
+				__m128 dy = _mm_sub_ps(cy, _mm_min_ps(_mm_max_ps(cy, _mm_loadu_ps(&aabbs.minY[i])), _mm_loadu_ps(&aabbs.maxY[i])));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(r, r));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_circle_intersects_pairwise_range(aabbs, circles, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t line_segments_intersect_pairwise_sse2(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= first.size(); i += 4) {
+				__m128 ax = _mm_loadu_ps(&first.startX[i]);
+				__m128 ay = _mm_loadu_ps(&first.startY[i]);
+				__m128 rx = _mm_sub_ps(_mm_loadu_ps(&first.endX[i]), ax);
+				__m128 ry = _mm_sub_ps(_mm_loadu_ps(&first.endY[i]), ay);
+				__m128 bx = _mm_loadu_ps(&other.startX[i]);
+				__m128 by = _mm_loadu_ps(&other.startY[i]);
+				__m128 sx = _mm_sub_ps(_mm_loadu_ps(&other.endX[i]), bx);
+				__m128 sy = _mm_sub_ps(_mm_loadu_ps(&other.endY[i]), by);
+				__m128 qpx = _mm_sub_ps(bx, ax);
+				__m128 qpy = _mm_sub_ps(by, ay);
+
+				__m128 denominator = _mm_sub_ps(_mm_mul_ps(rx, sy), _mm_mul_ps(ry, sx));
+				__m128 tv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, sy), _mm_mul_ps(qpy, sx)), denominator);
+				__m128 uv = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(qpx, ry), _mm_mul_ps(qpy, rx)), denominator);
+				__m128 crossing = _mm_and_ps(
+					_mm_and_ps(_mm_cmpge_ps(tv, zero), _mm_cmple_ps(tv, one)),
+					_mm_and_ps(_mm_cmpge_ps(uv, zero), _mm_cmple_ps(uv, one)));
+
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(crossing)), 4, results + i);
+				hits += fix_parallel_pairwise_lanes(first, other, results, i, static_cast<unsigned int>(_mm_movemask_ps(_mm_cmpeq_ps(denominator, zero))));
+			}
+			return hits + line_segments_intersect_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t aabb_segment_intersects_pairwise_sse2(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= aabbs.size(); i += 4) {
+				__m128 minX = _mm_loadu_ps(&aabbs.minX[i]);
+				__m128 minY = _mm_loadu_ps(&aabbs.minY[i]);
+				__m128 maxX = _mm_loadu_ps(&aabbs.maxX[i]);
+				__m128 maxY = _mm_loadu_ps(&aabbs.maxY[i]);
+				__m128 sx = _mm_loadu_ps(&segments.startX[i]);
+				__m128 sy = _mm_loadu_ps(&segments.startY[i]);
+				__m128 dx = _mm_sub_ps(_mm_loadu_ps(&segments.endX[i]), sx);
+				__m128 dy = _mm_sub_ps(_mm_loadu_ps(&segments.endY[i]), sy);
+
+				// Each lane has its own direction : the lanes parallel to an axis are masked instead of branched on
+				__m128 parallelX = _mm_cmpeq_ps(dx, zero);
+				__m128 parallelY = _mm_cmpeq_ps(dy, zero);
+				__m128 inverseX = _mm_div_ps(one, dx);
+				__m128 inverseY = _mm_div_ps(one, dy);
+
+				__m128 t1 = _mm_mul_ps(_mm_sub_ps(minX, sx), inverseX);
+				__m128 t2 = _mm_mul_ps(_mm_sub_ps(maxX, sx), inverseX);
+				__m128 tEntry = _mm_max_ps(zero, select_sse2(parallelX, zero, _mm_min_ps(t1, t2)));
+				__m128 tExit = _mm_min_ps(one, select_sse2(parallelX, one, _mm_max_ps(t1, t2)));
+				t1 = _mm_mul_ps(_mm_sub_ps(minY, sy), inverseY);
+				t2 = _mm_mul_ps(_mm_sub_ps(maxY, sy), inverseY);
+				tEntry = _mm_max_ps(tEntry, select_sse2(parallelY, zero, _mm_min_ps(t1, t2)));
+				tExit = _mm_min_ps(tExit, select_sse2(parallelY, one, _mm_max_ps(t1, t2)));
+
+				__m128 betweenX = _mm_and_ps(_mm_cmple_ps(minX, sx), _mm_cmpge_ps(maxX, sx));
+				__m128 betweenY = _mm_and_ps(_mm_cmple_ps(minY, sy), _mm_cmpge_ps(maxY, sy));
+				__m128 inside = _mm_and_ps(
+					_mm_and_ps(select_sse2(parallelX, betweenX, _mm_castsi128_ps(_mm_set1_epi32(-1))), select_sse2(parallelY, betweenY, _mm_castsi128_ps(_mm_set1_epi32(-1)))),
+					_mm_cmple_ps(tEntry, tExit));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + aabb_segment_intersects_pairwise_range(aabbs, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("sse2")
+		static size_t circle_segment_intersects_pairwise_sse2(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 4 <= circles.size(); i += 4) {
+				__m128 cx = _mm_loadu_ps(&circles.x[i]);
+				__m128 cy = _mm_loadu_ps(&circles.y[i]);
+				__m128 r = _mm_loadu_ps(&circles.radius[i]);
+				__m128 sx = _mm_loadu_ps(&segments.startX[i]);
+				__m128 sy = _mm_loadu_ps(&segments.startY[i]);
+				__m128 ex = _mm_sub_ps(_mm_loadu_ps(&segments.endX[i]), sx);
+				__m128 ey = _mm_sub_ps(_mm_loadu_ps(&segments.endY[i]), sy);
+
+				// Closest point of the segment, its start if the segment is a point
+				__m128 lengthSquared = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+				__m128 u = _mm_div_ps(_mm_add_ps(_mm_mul_ps(_mm_sub_ps(cx, sx), ex), _mm_mul_ps(_mm_sub_ps(cy, sy), ey)), lengthSquared);
+				u = select_sse2(_mm_cmpeq_ps(lengthSquared, zero), zero, _mm_min_ps(_mm_max_ps(u, zero), one));
+				__m128 dx = _mm_sub_ps(cx, _mm_add_ps(sx, _mm_mul_ps(ex, u)));
+				__m128 dy = _mm_sub_ps(cy, _mm_add_ps(sy, _mm_mul_ps(ey, u)));
+				__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+				__m128 inside = _mm_cmplt_ps(distanceSquared, _mm_mul_ps(r, r));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm_movemask_ps(inside)), 4, results + i);
+			}
+			return hits + circle_segment_intersects_pairwise_range(circles, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_intersects_batch_avx2(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			const __m256 minX = _mm256_set1_ps(aabb.pos.x);
+			const __m256 minY = _mm256_set1_ps(aabb.pos.y);
+			const __m256 maxX = _mm256_set1_ps(aabb.pos.x + aabb.size.x);
+			const __m256 maxY = _mm256_set1_ps(aabb.pos.y + aabb.size.y);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 inside = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(maxX, _mm256_loadu_ps(&batch.minX[i]), _CMP_GE_OQ), _mm256_cmp_ps(maxY, _mm256_loadu_ps(&batch.minY[i]), _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(minX, _mm256_loadu_ps(&batch.maxX[i]), _CMP_LE_OQ), _mm256_cmp_ps(minY, _mm256_loadu_ps(&batch.maxY[i]), _CMP_LE_OQ)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_intersects_batch_avx2(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 cr = _mm256_set1_ps(circle.radius);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 dx = _mm256_sub_ps(cx, _mm256_loadu_ps(&batch.x[i]));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_loadu_ps(&batch.y[i]));
+				__m256 radii = _mm256_add_ps(cr, _mm256_loadu_ps(&batch.radius[i]));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radii, radii), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_intersects_range(circle, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t line_segments_intersect_batch_avx2(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			const __m256 ax = _mm256_set1_ps(segment.start.x);
+			const __m256 ay = _mm256_set1_ps(segment.start.y);
+			const __m256 rx = _mm256_set1_ps(segment.end.x - segment.start.x);
+			const __m256 ry = _mm256_set1_ps(segment.end.y - segment.start.y);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 bx = _mm256_loadu_ps(&batch.startX[i]);
+				__m256 by = _mm256_loadu_ps(&batch.startY[i]);
+				__m256 sx = _mm256_sub_ps(_mm256_loadu_ps(&batch.endX[i]), bx);
+				__m256 sy = _mm256_sub_ps(_mm256_loadu_ps(&batch.endY[i]), by);
+				__m256 qpx = _mm256_sub_ps(bx, ax);
+				__m256 qpy = _mm256_sub_ps(by, ay);
+
+				__m256 denominator = _mm256_sub_ps(_mm256_mul_ps(rx, sy), _mm256_mul_ps(ry, sx));
+				__m256 tv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, sy), _mm256_mul_ps(qpy, sx)), denominator);
+				__m256 uv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, ry), _mm256_mul_ps(qpy, rx)), denominator);
+				__m256 crossing = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(tv, zero, _CMP_GE_OQ), _mm256_cmp_ps(tv, one, _CMP_LE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(uv, zero, _CMP_GE_OQ), _mm256_cmp_ps(uv, one, _CMP_LE_OQ)));
+
+				if (t) {
+					_mm256_storeu_ps(t + i, _mm256_and_ps(tv, crossing));
+				}
+				if (u) {
+					_mm256_storeu_ps(u + i, _mm256_and_ps(uv, crossing));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(crossing)), 8, results + i);
+				hits += fix_parallel_lanes(segment, batch, results, t, u, i, static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(denominator, zero, _CMP_EQ_OQ))));
+			}
+			return hits + line_segments_intersect_range(segment, batch, results, t, u, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t line_segment_aabb_clip_batch_avx2(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			const vec_t direction = segment.end - segment.start;
+			const __m256 sx = _mm256_set1_ps(segment.start.x);
+			const __m256 sy = _mm256_set1_ps(segment.start.y);
+			const __m256 inverseX = _mm256_set1_ps(direction.x != 0.f ? 1.f / direction.x : 0.f);
+			const __m256 inverseY = _mm256_set1_ps(direction.y != 0.f ? 1.f / direction.y : 0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&batch.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&batch.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&batch.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&batch.maxY[i]);
+				__m256 tEntry = _mm256_setzero_ps();
+				__m256 tExit = _mm256_set1_ps(1.f);
+				__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+				// The direction is the same for every lane, so are the branches
+				if (direction.x != 0.f) {
+					__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(minX, sx), inverseX);
+					__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(maxX, sx), inverseX);
+					tEntry = _mm256_max_ps(tEntry, _mm256_min_ps(t1, t2));
+					tExit = _mm256_min_ps(tExit, _mm256_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(minX, sx, _CMP_LE_OQ), _mm256_cmp_ps(maxX, sx, _CMP_GE_OQ)));
+				}
+				if (direction.y != 0.f) {
+					__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(minY, sy), inverseY);
+					__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(maxY, sy), inverseY);
+					tEntry = _mm256_max_ps(tEntry, _mm256_min_ps(t1, t2));
+					tExit = _mm256_min_ps(tExit, _mm256_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(minY, sy, _CMP_LE_OQ), _mm256_cmp_ps(maxY, sy, _CMP_GE_OQ)));
+				}
+
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(tEntry, tExit, _CMP_LE_OQ));
+				if (entry) {
+					_mm256_storeu_ps(entry + i, _mm256_and_ps(tEntry, inside));
+				}
+				if (exit) {
+					_mm256_storeu_ps(exit + i, _mm256_and_ps(tExit, inside));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + line_segment_aabb_clip_range(segment, batch, results, entry, exit, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_aabb_collision_batch_avx2(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 radius = _mm256_set1_ps(circle.radius);
+			const __m256 radiusSquared = _mm256_set1_ps(circle.radius * circle.radius);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 minusOne = _mm256_set1_ps(-1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&batch.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&batch.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&batch.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&batch.maxY[i]);
+
+				__m256 dx = _mm256_sub_ps(cx, _mm256_min_ps(_mm256_max_ps(cx, minX), maxX));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_min_ps(_mm256_max_ps(cy, minY), maxY));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 overlap = _mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				__m256 outside = _mm256_cmp_ps(distanceSquared, zero, _CMP_GT_OQ);
+
+				// Center outside of the box : the normal goes from the closest point towards the center
+				__m256 distance = _mm256_sqrt_ps(distanceSquared);
+				__m256 outsideX = _mm256_div_ps(dx, distance);
+				__m256 outsideY = _mm256_div_ps(dy, distance);
+				__m256 outsideDepth = _mm256_sub_ps(radius, distance);
+
+				// Center inside of the box : the circle is pushed out through the closest side
+				__m256 left = _mm256_sub_ps(cx, minX);
+				__m256 right = _mm256_sub_ps(maxX, cx);
+				__m256 top = _mm256_sub_ps(cy, minY);
+				__m256 bottom = _mm256_sub_ps(maxY, cy);
+				__m256 closestX = _mm256_min_ps(left, right);
+				__m256 closestY = _mm256_min_ps(top, bottom);
+				__m256 alongX = _mm256_cmp_ps(closestX, closestY, _CMP_LT_OQ);
+				__m256 insideX = _mm256_and_ps(alongX, _mm256_blendv_ps(one, minusOne, _mm256_cmp_ps(left, right, _CMP_LT_OQ)));
+				__m256 insideY = _mm256_andnot_ps(alongX, _mm256_blendv_ps(one, minusOne, _mm256_cmp_ps(top, bottom, _CMP_LT_OQ)));
+				__m256 insideDepth = _mm256_add_ps(radius, _mm256_min_ps(closestX, closestY));
+
+				if (normalX) {
+					_mm256_storeu_ps(normalX + i, _mm256_and_ps(overlap, _mm256_blendv_ps(insideX, outsideX, outside)));
+				}
+				if (normalY) {
+					_mm256_storeu_ps(normalY + i, _mm256_and_ps(overlap, _mm256_blendv_ps(insideY, outsideY, outside)));
+				}
+				if (depth) {
+					_mm256_storeu_ps(depth + i, _mm256_and_ps(overlap, _mm256_blendv_ps(insideDepth, outsideDepth, outside)));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(overlap)), 8, results + i);
+			}
+			return hits + circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, i);
+		}
+
+		/**
+		 * \brief Splits 8 consecutive pairs into the indices of the first and of the second AABBs.
+		 */
+		CH_SIMD_TARGET("avx2")
+		static void load_pair_indices_avx2(const AABBIndexPair* pairs, __m256i& first, __m256i& second) {
+			const __m256i evenThenOdd = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			__m256i low = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs)), evenThenOdd);
+			__m256i high = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pairs + 4)), evenThenOdd);
+			first = _mm256_permute2x128_si256(low, high, 0x20);
+			second = _mm256_permute2x128_si256(low, high, 0x31);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_collision_batch_avx2(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 minusOne = _mm256_set1_ps(-1.f);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			alignas(32) float normalX[8];
+			alignas(32) float normalY[8];
+			alignas(32) float deltaX[8];
+			alignas(32) float deltaY[8];
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= count; i += 8) {
+				__m256i first, second;
+				load_pair_indices_avx2(pairs + i, first, second);
+				__m256 minX1 = _mm256_i32gather_ps(batch.minX.data(), first, 4);
+				__m256 minY1 = _mm256_i32gather_ps(batch.minY.data(), first, 4);
+				__m256 maxX1 = _mm256_i32gather_ps(batch.maxX.data(), first, 4);
+				__m256 maxY1 = _mm256_i32gather_ps(batch.maxY.data(), first, 4);
+				__m256 minX2 = _mm256_i32gather_ps(batch.minX.data(), second, 4);
+				__m256 minY2 = _mm256_i32gather_ps(batch.minY.data(), second, 4);
+				__m256 maxX2 = _mm256_i32gather_ps(batch.maxX.data(), second, 4);
+				__m256 maxY2 = _mm256_i32gather_ps(batch.maxY.data(), second, 4);
+
+				__m256 intersects = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(maxX1, minX2, _CMP_GE_OQ), _mm256_cmp_ps(maxY1, minY2, _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(minX1, maxX2, _CMP_LE_OQ), _mm256_cmp_ps(minY1, maxY2, _CMP_LE_OQ)));
+
+				// Side of the first AABB closest to the center of the second one, on each axis
+				__m256 left = _mm256_cmp_ps(_mm256_add_ps(minX2, maxX2), _mm256_add_ps(minX1, maxX1), _CMP_LE_OQ);
+				__m256 top = _mm256_cmp_ps(_mm256_add_ps(minY2, maxY2), _mm256_add_ps(minY1, maxY1), _CMP_LE_OQ);
+				__m256 dx = _mm256_andnot_ps(signMask, _mm256_blendv_ps(_mm256_sub_ps(maxX1, minX2), _mm256_sub_ps(minX1, maxX2), left));
+				__m256 dy = _mm256_andnot_ps(signMask, _mm256_blendv_ps(_mm256_sub_ps(maxY1, minY2), _mm256_sub_ps(minY1, maxY2), top));
+				__m256 vertical = _mm256_cmp_ps(dx, dy, _CMP_GT_OQ);
+
+				_mm256_store_ps(normalX, _mm256_and_ps(intersects, _mm256_andnot_ps(vertical, _mm256_blendv_ps(one, minusOne, left))));
+				_mm256_store_ps(normalY, _mm256_and_ps(intersects, _mm256_and_ps(vertical, _mm256_blendv_ps(one, minusOne, top))));
+				_mm256_store_ps(deltaX, _mm256_and_ps(intersects, dx));
+				_mm256_store_ps(deltaY, _mm256_and_ps(intersects, dy));
+				hits += write_aabb_collision_lanes(normalX, normalY, deltaX, deltaY, 8, collisions + i);
+			}
+			return hits + aabb_collision_range(batch, pairs, count, collisions, i);
+		}
+
+		/**
+		 * \brief Selects a where the mask is set, b elsewhere.
+		 */
+		CH_SIMD_TARGET("avx2")
+		static __m256 select_avx2(__m256 mask, __m256 a, __m256 b) {
+			return _mm256_blendv_ps(b, a, mask);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static void circle_sweep_batch_avx2(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, float& earliest, size_t& earliestIndex) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 r = _mm256_set1_ps(circle.radius);
+			const __m256 r2 = _mm256_set1_ps(circle.radius * circle.radius);
+			const __m256 dx = _mm256_set1_ps(motion.x);
+			const __m256 dy = _mm256_set1_ps(motion.y);
+			const __m256 dd = _mm256_set1_ps(motion.x * motion.x + motion.y * motion.y);
+			const __m256 moving = _mm256_cmp_ps(dd, _mm256_setzero_ps(), _CMP_GT_OQ);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 infinity = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+			const __m256 signBit = _mm256_set1_ps(-0.f);
+
+			size_t i = 0;
+			alignas(32) float times[8];
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 ax = _mm256_loadu_ps(&batch.startX[i]);
+				__m256 ay = _mm256_loadu_ps(&batch.startY[i]);
+				__m256 ex = _mm256_sub_ps(_mm256_loadu_ps(&batch.endX[i]), ax);
+				__m256 ey = _mm256_sub_ps(_mm256_loadu_ps(&batch.endY[i]), ay);
+				__m256 mx = _mm256_sub_ps(cx, ax);
+				__m256 my = _mm256_sub_ps(cy, ay);
+				__m256 ee = _mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey));
+				__m256 notPoint = _mm256_cmp_ps(ee, zero, _CMP_GT_OQ);
+
+				// Already intersecting (distance from the center to the closest point of the segment)
+				__m256 u0 = _mm256_and_ps(_mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(mx, ex), _mm256_mul_ps(my, ey)), ee), notPoint);
+				u0 = _mm256_min_ps(_mm256_max_ps(u0, zero), one);
+				__m256 qx = _mm256_sub_ps(_mm256_mul_ps(ex, u0), mx);
+				__m256 qy = _mm256_sub_ps(_mm256_mul_ps(ey, u0), my);
+				__m256 intersecting = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(qx, qx), _mm256_mul_ps(qy, qy)), r2, _CMP_LT_OQ);
+
+				// Side of the segment
+				__m256 length = _mm256_sqrt_ps(ee);
+				__m256 nx = _mm256_div_ps(_mm256_xor_ps(ey, signBit), length);
+				__m256 ny = _mm256_div_ps(ex, length);
+				__m256 side = _mm256_add_ps(_mm256_mul_ps(mx, nx), _mm256_mul_ps(my, ny));
+				__m256 flip = _mm256_and_ps(side, signBit);
+				nx = _mm256_xor_ps(nx, flip);
+				ny = _mm256_xor_ps(ny, flip);
+				side = _mm256_xor_ps(side, flip);
+				__m256 approach = _mm256_add_ps(_mm256_mul_ps(dx, nx), _mm256_mul_ps(dy, ny));
+				__m256 tSide = _mm256_div_ps(_mm256_sub_ps(side, r), _mm256_xor_ps(approach, signBit));
+				__m256 px = _mm256_sub_ps(_mm256_add_ps(mx, _mm256_mul_ps(dx, tSide)), _mm256_mul_ps(nx, r));
+				__m256 py = _mm256_sub_ps(_mm256_add_ps(my, _mm256_mul_ps(dy, tSide)), _mm256_mul_ps(ny, r));
+				__m256 u = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(px, ex), _mm256_mul_ps(py, ey)), ee);
+				__m256 sideHit = _mm256_and_ps(_mm256_and_ps(notPoint, _mm256_cmp_ps(approach, zero, _CMP_LT_OQ)),
+					_mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(tSide, zero, _CMP_GE_OQ), _mm256_cmp_ps(tSide, one, _CMP_LE_OQ)), _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ))));
+				__m256 best = select_avx2(sideHit, tSide, infinity);
+
+				// Extremities of the segment
+				for (int extremity = 0; extremity < 2; ++extremity) {
+					__m256 tx = extremity == 0 ? mx : _mm256_sub_ps(mx, ex);
+					__m256 ty = extremity == 0 ? my : _mm256_sub_ps(my, ey);
+					__m256 b = _mm256_add_ps(_mm256_mul_ps(tx, dx), _mm256_mul_ps(ty, dy));
+					__m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(tx, tx), _mm256_mul_ps(ty, ty)), r2);
+					__m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b), _mm256_mul_ps(dd, c));
+					__m256 t = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(b, signBit), _mm256_sqrt_ps(_mm256_max_ps(discriminant, zero))), dd);
+					__m256 extremityHit = _mm256_and_ps(_mm256_and_ps(moving, _mm256_cmp_ps(b, zero, _CMP_LT_OQ)), _mm256_and_ps(_mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, one, _CMP_LE_OQ)));
+					best = _mm256_min_ps(best, select_avx2(extremityHit, t, infinity));
+				}
+
+				best = select_avx2(intersecting, zero, best);
+				if (_mm256_movemask_ps(_mm256_cmp_ps(best, _mm256_set1_ps(earliest), _CMP_LT_OQ)) != 0) {
+					_mm256_store_ps(times, best);
+					keep_earliest_lane(times, 8, i, earliest, earliestIndex);
+				}
+			}
+			circle_sweep_range(circle, motion, batch, earliest, earliestIndex, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_obb_intersects_batch_avx2(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			const float halfWidth = aabb.size.x / 2.f;
+			const float halfHeight = aabb.size.y / 2.f;
+			const __m256 halfX = _mm256_set1_ps(halfWidth);
+			const __m256 halfY = _mm256_set1_ps(halfHeight);
+			const __m256 centerX = _mm256_set1_ps(aabb.pos.x + halfWidth);
+			const __m256 centerY = _mm256_set1_ps(aabb.pos.y + halfHeight);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 tx = _mm256_sub_ps(_mm256_loadu_ps(&batch.centerX[i]), centerX);
+				__m256 ty = _mm256_sub_ps(_mm256_loadu_ps(&batch.centerY[i]), centerY);
+				__m256 cosine = _mm256_loadu_ps(&batch.cosine[i]);
+				__m256 sine = _mm256_loadu_ps(&batch.sine[i]);
+				__m256 absCosine = _mm256_andnot_ps(signMask, cosine);
+				__m256 absSine = _mm256_andnot_ps(signMask, sine);
+				__m256 obbHalfX = _mm256_loadu_ps(&batch.halfWidth[i]);
+				__m256 obbHalfY = _mm256_loadu_ps(&batch.halfHeight[i]);
+				__m256 extentX = _mm256_add_ps(halfX, _mm256_add_ps(_mm256_mul_ps(obbHalfX, absCosine), _mm256_mul_ps(obbHalfY, absSine)));
+				__m256 extentY = _mm256_add_ps(halfY, _mm256_add_ps(_mm256_mul_ps(obbHalfX, absSine), _mm256_mul_ps(obbHalfY, absCosine)));
+				__m256 extentU = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(halfX, absCosine), _mm256_mul_ps(halfY, absSine)), obbHalfX);
+				__m256 extentV = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(halfX, absSine), _mm256_mul_ps(halfY, absCosine)), obbHalfY);
+				__m256 projectedU = _mm256_andnot_ps(signMask, _mm256_add_ps(_mm256_mul_ps(tx, cosine), _mm256_mul_ps(ty, sine)));
+				__m256 projectedV = _mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_mul_ps(ty, cosine), _mm256_mul_ps(tx, sine)));
+				__m256 inside = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, tx), extentX, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_andnot_ps(signMask, ty), extentY, _CMP_LT_OQ)), _mm256_and_ps(_mm256_cmp_ps(projectedU, extentU, _CMP_LT_OQ), _mm256_cmp_ps(projectedV, extentV, _CMP_LT_OQ)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_obb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_obb_intersects_batch_avx2(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			const __m256 cx = _mm256_set1_ps(circle.pos.x);
+			const __m256 cy = _mm256_set1_ps(circle.pos.y);
+			const __m256 radiusSquared = _mm256_set1_ps(circle.radius * circle.radius);
+			const __m256 zero = _mm256_set1_ps(0.f);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 dx = _mm256_sub_ps(cx, _mm256_loadu_ps(&batch.centerX[i]));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_loadu_ps(&batch.centerY[i]));
+				__m256 cosine = _mm256_loadu_ps(&batch.cosine[i]);
+				__m256 sine = _mm256_loadu_ps(&batch.sine[i]);
+				__m256 localX = _mm256_add_ps(_mm256_mul_ps(dx, cosine), _mm256_mul_ps(dy, sine));
+				__m256 localY = _mm256_sub_ps(_mm256_mul_ps(dy, cosine), _mm256_mul_ps(dx, sine));
+				__m256 outsideX = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, localX), _mm256_loadu_ps(&batch.halfWidth[i])), zero);
+				__m256 outsideY = _mm256_max_ps(_mm256_sub_ps(_mm256_andnot_ps(signMask, localY), _mm256_loadu_ps(&batch.halfHeight[i])), zero);
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(outsideX, outsideX), _mm256_mul_ps(outsideY, outsideY));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_obb_intersects_range(circle, batch, results, i);
+		}
+
+		/**
+		 * \brief Squared distance between a corner of the boxes of 8 lanes and the segment of a capsule.
+		 */
+		CH_SIMD_TARGET("avx2")
+		static __m256 capsule_batch_corner_distance_avx2(__m256 x, __m256 y, __m256 startX, __m256 startY, __m256 directionX, __m256 directionY, __m256 inverseLengthSquared, __m256 zero, __m256 one) {
+			__m256 t = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(x, startX), directionX), _mm256_mul_ps(_mm256_sub_ps(y, startY), directionY)), inverseLengthSquared), zero), one);
+			__m256 dx = _mm256_sub_ps(_mm256_add_ps(startX, _mm256_mul_ps(t, directionX)), x);
+			__m256 dy = _mm256_sub_ps(_mm256_add_ps(startY, _mm256_mul_ps(t, directionY)), y);
+			return _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t capsule_aabb_intersects_batch_avx2(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const __m256 startX = _mm256_set1_ps(query.startX);
+			const __m256 startY = _mm256_set1_ps(query.startY);
+			const __m256 endX = _mm256_set1_ps(query.startX + query.directionX);
+			const __m256 endY = _mm256_set1_ps(query.startY + query.directionY);
+			const __m256 directionX = _mm256_set1_ps(query.directionX);
+			const __m256 directionY = _mm256_set1_ps(query.directionY);
+			const __m256 inverseLengthSquared = _mm256_set1_ps(query.inverseLengthSquared);
+			const __m256 segmentMinX = _mm256_set1_ps(query.minX);
+			const __m256 segmentMinY = _mm256_set1_ps(query.minY);
+			const __m256 segmentMaxX = _mm256_set1_ps(query.maxX);
+			const __m256 segmentMaxY = _mm256_set1_ps(query.maxY);
+			const __m256 normalX = _mm256_set1_ps(query.normalX);
+			const __m256 normalY = _mm256_set1_ps(query.normalY);
+			const __m256 absNormalX = _mm256_set1_ps(query.absNormalX);
+			const __m256 absNormalY = _mm256_set1_ps(query.absNormalY);
+			const __m256 normalDotStart = _mm256_set1_ps(query.normalDotStart);
+			const __m256 radiusSquared = _mm256_set1_ps(query.radiusSquared);
+			const __m256 half = _mm256_set1_ps(0.5f);
+			const __m256 zero = _mm256_set1_ps(0.f);
+			const __m256 one = _mm256_set1_ps(1.f);
+			const __m256 signMask = _mm256_set1_ps(-0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= batch.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&batch.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&batch.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&batch.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&batch.maxY[i]);
+
+				__m256 centerX = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+				__m256 centerY = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+				__m256 halfX = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+				__m256 halfY = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+				__m256 crossing = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(segmentMinX, maxX, _CMP_LT_OQ), _mm256_cmp_ps(segmentMaxX, minX, _CMP_GT_OQ)), _mm256_and_ps(_mm256_cmp_ps(segmentMinY, maxY, _CMP_LT_OQ), _mm256_cmp_ps(segmentMaxY, minY, _CMP_GT_OQ)));
+				crossing = _mm256_and_ps(crossing, _mm256_cmp_ps(_mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(normalX, centerX), _mm256_mul_ps(normalY, centerY)), normalDotStart)), _mm256_add_ps(_mm256_mul_ps(halfX, absNormalX), _mm256_mul_ps(halfY, absNormalY)), _CMP_LT_OQ));
+
+				__m256 startDX = _mm256_sub_ps(startX, _mm256_min_ps(_mm256_max_ps(startX, minX), maxX));
+				__m256 startDY = _mm256_sub_ps(startY, _mm256_min_ps(_mm256_max_ps(startY, minY), maxY));
+				__m256 endDX = _mm256_sub_ps(endX, _mm256_min_ps(_mm256_max_ps(endX, minX), maxX));
+				__m256 endDY = _mm256_sub_ps(endY, _mm256_min_ps(_mm256_max_ps(endY, minY), maxY));
+				__m256 closest = _mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(startDX, startDX), _mm256_mul_ps(startDY, startDY)), _mm256_add_ps(_mm256_mul_ps(endDX, endDX), _mm256_mul_ps(endDY, endDY)));
+				closest = _mm256_min_ps(closest, _mm256_min_ps(capsule_batch_corner_distance_avx2(minX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx2(maxX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+				closest = _mm256_min_ps(closest, _mm256_min_ps(capsule_batch_corner_distance_avx2(minX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx2(maxX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+
+				__m256 inside = _mm256_or_ps(crossing, _mm256_cmp_ps(closest, radiusSquared, _CMP_LT_OQ));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + capsule_aabb_intersects_range(capsule, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_intersects_pairwise_avx2(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= first.size(); i += 8) {
+				__m256 inside = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&first.maxX[i]), _mm256_loadu_ps(&other.minX[i]), _CMP_GE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&first.maxY[i]), _mm256_loadu_ps(&other.minY[i]), _CMP_GE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&first.minX[i]), _mm256_loadu_ps(&other.maxX[i]), _CMP_LE_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&first.minY[i]), _mm256_loadu_ps(&other.maxY[i]), _CMP_LE_OQ)));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_intersects_pairwise_avx2(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= first.size(); i += 8) {
+				__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&first.x[i]), _mm256_loadu_ps(&other.x[i]));
+				__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&first.y[i]), _mm256_loadu_ps(&other.y[i]));
+				__m256 radii = _mm256_add_ps(_mm256_loadu_ps(&first.radius[i]), _mm256_loadu_ps(&other.radius[i]));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(radii, radii), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_intersects_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_circle_intersects_pairwise_avx2(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= aabbs.size(); i += 8) {
+				__m256 cx = _mm256_loadu_ps(&circles.x[i]);
+				__m256 cy = _mm256_loadu_ps(&circles.y[i]);
+				__m256 r = _mm256_loadu_ps(&circles.radius[i]);
+				__m256 dx = _mm256_sub_ps(cx, _mm256_min_ps(_mm256_max_ps(cx, _mm256_loadu_ps(&aabbs.minX[i])), _mm256_loadu_ps(&aabbs.maxX[i])));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_min_ps(_mm256_max_ps(cy, _mm256_loadu_ps(&aabbs.minY[i])), _mm256_loadu_ps(&aabbs.maxY[i])));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(r, r), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_circle_intersects_pairwise_range(aabbs, circles, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t line_segments_intersect_pairwise_avx2(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= first.size(); i += 8) {
+				__m256 ax = _mm256_loadu_ps(&first.startX[i]);
+				__m256 ay = _mm256_loadu_ps(&first.startY[i]);
+				__m256 rx = _mm256_sub_ps(_mm256_loadu_ps(&first.endX[i]), ax);
+				__m256 ry = _mm256_sub_ps(_mm256_loadu_ps(&first.endY[i]), ay);
+				__m256 bx = _mm256_loadu_ps(&other.startX[i]);
+				__m256 by = _mm256_loadu_ps(&other.startY[i]);
+				__m256 sx = _mm256_sub_ps(_mm256_loadu_ps(&other.endX[i]), bx);
+				__m256 sy = _mm256_sub_ps(_mm256_loadu_ps(&other.endY[i]), by);
+				__m256 qpx = _mm256_sub_ps(bx, ax);
+				__m256 qpy = _mm256_sub_ps(by, ay);
+
+				__m256 denominator = _mm256_sub_ps(_mm256_mul_ps(rx, sy), _mm256_mul_ps(ry, sx));
+				__m256 tv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, sy), _mm256_mul_ps(qpy, sx)), denominator);
+				__m256 uv = _mm256_div_ps(_mm256_sub_ps(_mm256_mul_ps(qpx, ry), _mm256_mul_ps(qpy, rx)), denominator);
+				__m256 crossing = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(tv, zero, _CMP_GE_OQ), _mm256_cmp_ps(tv, one, _CMP_LE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(uv, zero, _CMP_GE_OQ), _mm256_cmp_ps(uv, one, _CMP_LE_OQ)));
+
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(crossing)), 8, results + i);
+				hits += fix_parallel_pairwise_lanes(first, other, results, i, static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(denominator, zero, _CMP_EQ_OQ))));
+			}
+			return hits + line_segments_intersect_pairwise_range(first, other, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t aabb_segment_intersects_pairwise_avx2(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= aabbs.size(); i += 8) {
+				__m256 minX = _mm256_loadu_ps(&aabbs.minX[i]);
+				__m256 minY = _mm256_loadu_ps(&aabbs.minY[i]);
+				__m256 maxX = _mm256_loadu_ps(&aabbs.maxX[i]);
+				__m256 maxY = _mm256_loadu_ps(&aabbs.maxY[i]);
+				__m256 sx = _mm256_loadu_ps(&segments.startX[i]);
+				__m256 sy = _mm256_loadu_ps(&segments.startY[i]);
+				__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&segments.endX[i]), sx);
+				__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&segments.endY[i]), sy);
+
+				// Each lane has its own direction : the lanes parallel to an axis are masked instead of branched on
+				__m256 parallelX = _mm256_cmp_ps(dx, zero, _CMP_EQ_OQ);
+				__m256 parallelY = _mm256_cmp_ps(dy, zero, _CMP_EQ_OQ);
+				__m256 inverseX = _mm256_div_ps(one, dx);
+				__m256 inverseY = _mm256_div_ps(one, dy);
+
+				__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(minX, sx), inverseX);
+				__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(maxX, sx), inverseX);
+				__m256 tEntry = _mm256_max_ps(zero, select_avx2(parallelX, zero, _mm256_min_ps(t1, t2)));
+				__m256 tExit = _mm256_min_ps(one, select_avx2(parallelX, one, _mm256_max_ps(t1, t2)));
+				t1 = _mm256_mul_ps(_mm256_sub_ps(minY, sy), inverseY);
+				t2 = _mm256_mul_ps(_mm256_sub_ps(maxY, sy), inverseY);
+				tEntry = _mm256_max_ps(tEntry, select_avx2(parallelY, zero, _mm256_min_ps(t1, t2)));
+				tExit = _mm256_min_ps(tExit, select_avx2(parallelY, one, _mm256_max_ps(t1, t2)));
+
+				__m256 betweenX = _mm256_and_ps(_mm256_cmp_ps(minX, sx, _CMP_LE_OQ), _mm256_cmp_ps(maxX, sx, _CMP_GE_OQ));
+				__m256 betweenY = _mm256_and_ps(_mm256_cmp_ps(minY, sy, _CMP_LE_OQ), _mm256_cmp_ps(maxY, sy, _CMP_GE_OQ));
+				__m256 inside = _mm256_and_ps(
+					_mm256_and_ps(select_avx2(parallelX, betweenX, _mm256_castsi256_ps(_mm256_set1_epi32(-1))), select_avx2(parallelY, betweenY, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))),
+					_mm256_cmp_ps(tEntry, tExit, _CMP_LE_OQ));
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + aabb_segment_intersects_pairwise_range(aabbs, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("avx2")
+		static size_t circle_segment_intersects_pairwise_avx2(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 one = _mm256_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 8 <= circles.size(); i += 8) {
+				__m256 cx = _mm256_loadu_ps(&circles.x[i]);
+				__m256 cy = _mm256_loadu_ps(&circles.y[i]);
+				__m256 r = _mm256_loadu_ps(&circles.radius[i]);
+				__m256 sx = _mm256_loadu_ps(&segments.startX[i]);
+				__m256 sy = _mm256_loadu_ps(&segments.startY[i]);
+				__m256 ex = _mm256_sub_ps(_mm256_loadu_ps(&segments.endX[i]), sx);
+				__m256 ey = _mm256_sub_ps(_mm256_loadu_ps(&segments.endY[i]), sy);
+
+				// Closest point of the segment, its start if the segment is a point
+				__m256 lengthSquared = _mm256_add_ps(_mm256_mul_ps(ex, ex), _mm256_mul_ps(ey, ey));
+				__m256 u = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(cx, sx), ex), _mm256_mul_ps(_mm256_sub_ps(cy, sy), ey)), lengthSquared);
+				u = select_avx2(_mm256_cmp_ps(lengthSquared, zero, _CMP_EQ_OQ), zero, _mm256_min_ps(_mm256_max_ps(u, zero), one));
+				__m256 dx = _mm256_sub_ps(cx, _mm256_add_ps(sx, _mm256_mul_ps(ex, u)));
+				__m256 dy = _mm256_sub_ps(cy, _mm256_add_ps(sy, _mm256_mul_ps(ey, u)));
+				__m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+				__m256 inside = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(r, r), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), 8, results + i);
+			}
+			return hits + circle_segment_intersects_pairwise_range(circles, segments, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t aabb_intersects_batch_avx512(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			const __m512 minX = _mm512_set1_ps(aabb.pos.x);
+			const __m512 minY = _mm512_set1_ps(aabb.pos.y);
+			const __m512 maxX = _mm512_set1_ps(aabb.pos.x + aabb.size.x);
+			const __m512 maxY = _mm512_set1_ps(aabb.pos.y + aabb.size.y);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__mmask16 inside = _mm512_cmp_ps_mask(maxX, _mm512_loadu_ps(&batch.minX[i]), _CMP_GE_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, maxY, _mm512_loadu_ps(&batch.minY[i]), _CMP_GE_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, minX, _mm512_loadu_ps(&batch.maxX[i]), _CMP_LE_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, minY, _mm512_loadu_ps(&batch.maxY[i]), _CMP_LE_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + aabb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t circle_intersects_batch_avx512(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			const __m512 cx = _mm512_set1_ps(circle.pos.x);
+			const __m512 cy = _mm512_set1_ps(circle.pos.y);
+			const __m512 cr = _mm512_set1_ps(circle.radius);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 dx = _mm512_sub_ps(cx, _mm512_loadu_ps(&batch.x[i]));
+				__m512 dy = _mm512_sub_ps(cy, _mm512_loadu_ps(&batch.y[i]));
+				__m512 radii = _mm512_add_ps(cr, _mm512_loadu_ps(&batch.radius[i]));
+				__m512 distanceSquared = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+				__mmask16 inside = _mm512_cmp_ps_mask(distanceSquared, _mm512_mul_ps(radii, radii), _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + circle_intersects_range(circle, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t line_segments_intersect_batch_avx512(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			const __m512 ax = _mm512_set1_ps(segment.start.x);
+			const __m512 ay = _mm512_set1_ps(segment.start.y);
+			const __m512 rx = _mm512_set1_ps(segment.end.x - segment.start.x);
+			const __m512 ry = _mm512_set1_ps(segment.end.y - segment.start.y);
+			const __m512 zero = _mm512_setzero_ps();
+			const __m512 one = _mm512_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 bx = _mm512_loadu_ps(&batch.startX[i]);
+				__m512 by = _mm512_loadu_ps(&batch.startY[i]);
+				__m512 sx = _mm512_sub_ps(_mm512_loadu_ps(&batch.endX[i]), bx);
+				__m512 sy = _mm512_sub_ps(_mm512_loadu_ps(&batch.endY[i]), by);
+				__m512 qpx = _mm512_sub_ps(bx, ax);
+				__m512 qpy = _mm512_sub_ps(by, ay);
+
+				__m512 denominator = _mm512_sub_ps(_mm512_mul_ps(rx, sy), _mm512_mul_ps(ry, sx));
+				__m512 tv = _mm512_div_ps(_mm512_sub_ps(_mm512_mul_ps(qpx, sy), _mm512_mul_ps(qpy, sx)), denominator);
+				__m512 uv = _mm512_div_ps(_mm512_sub_ps(_mm512_mul_ps(qpx, ry), _mm512_mul_ps(qpy, rx)), denominator);
+				__mmask16 crossing = _mm512_cmp_ps_mask(tv, zero, _CMP_GE_OQ);
+				crossing = _mm512_mask_cmp_ps_mask(crossing, tv, one, _CMP_LE_OQ);
+				crossing = _mm512_mask_cmp_ps_mask(crossing, uv, zero, _CMP_GE_OQ);
+				crossing = _mm512_mask_cmp_ps_mask(crossing, uv, one, _CMP_LE_OQ);
+
+				if (t) {
+					_mm512_storeu_ps(t + i, _mm512_maskz_mov_ps(crossing, tv));
+				}
+				if (u) {
+					_mm512_storeu_ps(u + i, _mm512_maskz_mov_ps(crossing, uv));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(crossing), 16, results + i);
+				hits += fix_parallel_lanes(segment, batch, results, t, u, i, static_cast<unsigned int>(_mm512_cmp_ps_mask(denominator, zero, _CMP_EQ_OQ)));
+			}
+			return hits + line_segments_intersect_range(segment, batch, results, t, u, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t line_segment_aabb_clip_batch_avx512(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			const vec_t direction = segment.end - segment.start;
+			const __m512 sx = _mm512_set1_ps(segment.start.x);
+			const __m512 sy = _mm512_set1_ps(segment.start.y);
+			const __m512 inverseX = _mm512_set1_ps(direction.x != 0.f ? 1.f / direction.x : 0.f);
+			const __m512 inverseY = _mm512_set1_ps(direction.y != 0.f ? 1.f / direction.y : 0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 minX = _mm512_loadu_ps(&batch.minX[i]);
+				__m512 minY = _mm512_loadu_ps(&batch.minY[i]);
+				__m512 maxX = _mm512_loadu_ps(&batch.maxX[i]);
+				__m512 maxY = _mm512_loadu_ps(&batch.maxY[i]);
+				__m512 tEntry = _mm512_setzero_ps();
+				__m512 tExit = _mm512_set1_ps(1.f);
+				__mmask16 inside = 0xFFFF;
+
+				// The direction is the same for every lane, so are the branches
+				if (direction.x != 0.f) {
+					__m512 t1 = _mm512_mul_ps(_mm512_sub_ps(minX, sx), inverseX);
+					__m512 t2 = _mm512_mul_ps(_mm512_sub_ps(maxX, sx), inverseX);
+					tEntry = _mm512_max_ps(tEntry, _mm512_min_ps(t1, t2));
+					tExit = _mm512_min_ps(tExit, _mm512_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm512_mask_cmp_ps_mask(inside, minX, sx, _CMP_LE_OQ);
+					inside = _mm512_mask_cmp_ps_mask(inside, maxX, sx, _CMP_GE_OQ);
+				}
+				if (direction.y != 0.f) {
+					__m512 t1 = _mm512_mul_ps(_mm512_sub_ps(minY, sy), inverseY);
+					__m512 t2 = _mm512_mul_ps(_mm512_sub_ps(maxY, sy), inverseY);
+					tEntry = _mm512_max_ps(tEntry, _mm512_min_ps(t1, t2));
+					tExit = _mm512_min_ps(tExit, _mm512_max_ps(t1, t2));
+				}
+				else {
+					inside = _mm512_mask_cmp_ps_mask(inside, minY, sy, _CMP_LE_OQ);
+					inside = _mm512_mask_cmp_ps_mask(inside, maxY, sy, _CMP_GE_OQ);
+				}
+
+				inside = _mm512_mask_cmp_ps_mask(inside, tEntry, tExit, _CMP_LE_OQ);
+				if (entry) {
+					_mm512_storeu_ps(entry + i, _mm512_maskz_mov_ps(inside, tEntry));
+				}
+				if (exit) {
+					_mm512_storeu_ps(exit + i, _mm512_maskz_mov_ps(inside, tExit));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + line_segment_aabb_clip_range(segment, batch, results, entry, exit, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t circle_aabb_collision_batch_avx512(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			const __m512 cx = _mm512_set1_ps(circle.pos.x);
+			const __m512 cy = _mm512_set1_ps(circle.pos.y);
+			const __m512 radius = _mm512_set1_ps(circle.radius);
+			const __m512 radiusSquared = _mm512_set1_ps(circle.radius * circle.radius);
+			const __m512 zero = _mm512_setzero_ps();
+			const __m512 one = _mm512_set1_ps(1.f);
+			const __m512 minusOne = _mm512_set1_ps(-1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 minX = _mm512_loadu_ps(&batch.minX[i]);
+				__m512 minY = _mm512_loadu_ps(&batch.minY[i]);
+				__m512 maxX = _mm512_loadu_ps(&batch.maxX[i]);
+				__m512 maxY = _mm512_loadu_ps(&batch.maxY[i]);
+
+				__m512 dx = _mm512_sub_ps(cx, _mm512_min_ps(_mm512_max_ps(cx, minX), maxX));
+				__m512 dy = _mm512_sub_ps(cy, _mm512_min_ps(_mm512_max_ps(cy, minY), maxY));
+				__m512 distanceSquared = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+				__mmask16 overlap = _mm512_cmp_ps_mask(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				__mmask16 outside = _mm512_cmp_ps_mask(distanceSquared, zero, _CMP_GT_OQ);
+
+				// Center outside of the box : the normal goes from the closest point towards the center
+				__m512 distance = _mm512_sqrt_ps(distanceSquared);
+				__m512 outsideX = _mm512_div_ps(dx, distance);
+				__m512 outsideY = _mm512_div_ps(dy, distance);
+				__m512 outsideDepth = _mm512_sub_ps(radius, distance);
+
+				// Center inside of the box : the circle is pushed out through the closest side
+				__m512 left = _mm512_sub_ps(cx, minX);
+				__m512 right = _mm512_sub_ps(maxX, cx);
+				__m512 top = _mm512_sub_ps(cy, minY);
+				__m512 bottom = _mm512_sub_ps(maxY, cy);
+				__m512 closestX = _mm512_min_ps(left, right);
+				__m512 closestY = _mm512_min_ps(top, bottom);
+				__mmask16 alongX = _mm512_cmp_ps_mask(closestX, closestY, _CMP_LT_OQ);
+				__m512 insideX = _mm512_maskz_mov_ps(alongX, _mm512_mask_blend_ps(_mm512_cmp_ps_mask(left, right, _CMP_LT_OQ), one, minusOne));
+				__m512 insideY = _mm512_maskz_mov_ps(static_cast<__mmask16>(~alongX), _mm512_mask_blend_ps(_mm512_cmp_ps_mask(top, bottom, _CMP_LT_OQ), one, minusOne));
+				__m512 insideDepth = _mm512_add_ps(radius, _mm512_min_ps(closestX, closestY));
+
+				if (normalX) {
+					_mm512_storeu_ps(normalX + i, _mm512_maskz_mov_ps(overlap, _mm512_mask_blend_ps(outside, insideX, outsideX)));
+				}
+				if (normalY) {
+					_mm512_storeu_ps(normalY + i, _mm512_maskz_mov_ps(overlap, _mm512_mask_blend_ps(outside, insideY, outsideY)));
+				}
+				if (depth) {
+					_mm512_storeu_ps(depth + i, _mm512_maskz_mov_ps(overlap, _mm512_mask_blend_ps(outside, insideDepth, outsideDepth)));
+				}
+				hits += write_lane_mask(static_cast<unsigned int>(overlap), 16, results + i);
+			}
+			return hits + circle_aabb_collision_range(circle, batch, results, normalX, normalY, depth, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t aabb_collision_batch_avx512(const AABBBatch& batch, const AABBIndexPair* pairs, size_t count, AABBCollision* collisions) {
+			const __m512i evenIndices = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+			const __m512i oddIndices = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+			const __m512 one = _mm512_set1_ps(1.f);
+			const __m512 minusOne = _mm512_set1_ps(-1.f);
+
+			alignas(64) float normalX[16];
+			alignas(64) float normalY[16];
+			alignas(64) float deltaX[16];
+			alignas(64) float deltaY[16];
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= count; i += 16) {
+				__m512i low = _mm512_loadu_si512(pairs + i);
+				__m512i high = _mm512_loadu_si512(pairs + i + 8);
+				__m512i first = _mm512_permutex2var_epi32(low, evenIndices, high);
+				__m512i second = _mm512_permutex2var_epi32(low, oddIndices, high);
+				__m512 minX1 = _mm512_i32gather_ps(first, batch.minX.data(), 4);
+				__m512 minY1 = _mm512_i32gather_ps(first, batch.minY.data(), 4);
+				__m512 maxX1 = _mm512_i32gather_ps(first, batch.maxX.data(), 4);
+				__m512 maxY1 = _mm512_i32gather_ps(first, batch.maxY.data(), 4);
+				__m512 minX2 = _mm512_i32gather_ps(second, batch.minX.data(), 4);
+				__m512 minY2 = _mm512_i32gather_ps(second, batch.minY.data(), 4);
+				__m512 maxX2 = _mm512_i32gather_ps(second, batch.maxX.data(), 4);
+				__m512 maxY2 = _mm512_i32gather_ps(second, batch.maxY.data(), 4);
+
+				__mmask16 intersects = _mm512_cmp_ps_mask(maxX1, minX2, _CMP_GE_OQ);
+				intersects = _mm512_mask_cmp_ps_mask(intersects, maxY1, minY2, _CMP_GE_OQ);
+				intersects = _mm512_mask_cmp_ps_mask(intersects, minX1, maxX2, _CMP_LE_OQ);
+				intersects = _mm512_mask_cmp_ps_mask(intersects, minY1, maxY2, _CMP_LE_OQ);
+
+				// Side of the first AABB closest to the center of the second one, on each axis
+				__mmask16 left = _mm512_cmp_ps_mask(_mm512_add_ps(minX2, maxX2), _mm512_add_ps(minX1, maxX1), _CMP_LE_OQ);
+				__mmask16 top = _mm512_cmp_ps_mask(_mm512_add_ps(minY2, maxY2), _mm512_add_ps(minY1, maxY1), _CMP_LE_OQ);
+				__m512 dx = _mm512_abs_ps(_mm512_mask_blend_ps(left, _mm512_sub_ps(maxX1, minX2), _mm512_sub_ps(minX1, maxX2)));
+				__m512 dy = _mm512_abs_ps(_mm512_mask_blend_ps(top, _mm512_sub_ps(maxY1, minY2), _mm512_sub_ps(minY1, maxY2)));
+				__mmask16 vertical = _mm512_cmp_ps_mask(dx, dy, _CMP_GT_OQ);
+
+				_mm512_store_ps(normalX, _mm512_maskz_mov_ps(intersects & static_cast<__mmask16>(~vertical), _mm512_mask_blend_ps(left, one, minusOne)));
+				_mm512_store_ps(normalY, _mm512_maskz_mov_ps(intersects & vertical, _mm512_mask_blend_ps(top, one, minusOne)));
+				_mm512_store_ps(deltaX, _mm512_maskz_mov_ps(intersects, dx));
+				_mm512_store_ps(deltaY, _mm512_maskz_mov_ps(intersects, dy));
+				hits += write_aabb_collision_lanes(normalX, normalY, deltaX, deltaY, 16, collisions + i);
+			}
+			return hits + aabb_collision_range(batch, pairs, count, collisions, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t aabb_obb_intersects_batch_avx512(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			const float halfWidth = aabb.size.x / 2.f;
+			const float halfHeight = aabb.size.y / 2.f;
+			const __m512 halfX = _mm512_set1_ps(halfWidth);
+			const __m512 halfY = _mm512_set1_ps(halfHeight);
+			const __m512 centerX = _mm512_set1_ps(aabb.pos.x + halfWidth);
+			const __m512 centerY = _mm512_set1_ps(aabb.pos.y + halfHeight);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 tx = _mm512_sub_ps(_mm512_loadu_ps(&batch.centerX[i]), centerX);
+				__m512 ty = _mm512_sub_ps(_mm512_loadu_ps(&batch.centerY[i]), centerY);
+				__m512 cosine = _mm512_loadu_ps(&batch.cosine[i]);
+				__m512 sine = _mm512_loadu_ps(&batch.sine[i]);
+				__m512 absCosine = _mm512_abs_ps(cosine);
+				__m512 absSine = _mm512_abs_ps(sine);
+				__m512 obbHalfX = _mm512_loadu_ps(&batch.halfWidth[i]);
+				__m512 obbHalfY = _mm512_loadu_ps(&batch.halfHeight[i]);
+				__m512 extentX = _mm512_add_ps(halfX, _mm512_add_ps(_mm512_mul_ps(obbHalfX, absCosine), _mm512_mul_ps(obbHalfY, absSine)));
+				__m512 extentY = _mm512_add_ps(halfY, _mm512_add_ps(_mm512_mul_ps(obbHalfX, absSine), _mm512_mul_ps(obbHalfY, absCosine)));
+				__m512 extentU = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(halfX, absCosine), _mm512_mul_ps(halfY, absSine)), obbHalfX);
+				__m512 extentV = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(halfX, absSine), _mm512_mul_ps(halfY, absCosine)), obbHalfY);
+				__m512 projectedU = _mm512_abs_ps(_mm512_add_ps(_mm512_mul_ps(tx, cosine), _mm512_mul_ps(ty, sine)));
+				__m512 projectedV = _mm512_abs_ps(_mm512_sub_ps(_mm512_mul_ps(ty, cosine), _mm512_mul_ps(tx, sine)));
+				__mmask16 inside = _mm512_cmp_ps_mask(_mm512_abs_ps(tx), extentX, _CMP_LT_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, _mm512_abs_ps(ty), extentY, _CMP_LT_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, projectedU, extentU, _CMP_LT_OQ);
+				inside = _mm512_mask_cmp_ps_mask(inside, projectedV, extentV, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + aabb_obb_intersects_range(aabb, batch, results, i);
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t circle_obb_intersects_batch_avx512(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			const __m512 cx = _mm512_set1_ps(circle.pos.x);
+			const __m512 cy = _mm512_set1_ps(circle.pos.y);
+			const __m512 radiusSquared = _mm512_set1_ps(circle.radius * circle.radius);
+			const __m512 zero = _mm512_set1_ps(0.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 dx = _mm512_sub_ps(cx, _mm512_loadu_ps(&batch.centerX[i]));
+				__m512 dy = _mm512_sub_ps(cy, _mm512_loadu_ps(&batch.centerY[i]));
+				__m512 cosine = _mm512_loadu_ps(&batch.cosine[i]);
+				__m512 sine = _mm512_loadu_ps(&batch.sine[i]);
+				__m512 localX = _mm512_add_ps(_mm512_mul_ps(dx, cosine), _mm512_mul_ps(dy, sine));
+				__m512 localY = _mm512_sub_ps(_mm512_mul_ps(dy, cosine), _mm512_mul_ps(dx, sine));
+				__m512 outsideX = _mm512_max_ps(_mm512_sub_ps(_mm512_abs_ps(localX), _mm512_loadu_ps(&batch.halfWidth[i])), zero);
+				__m512 outsideY = _mm512_max_ps(_mm512_sub_ps(_mm512_abs_ps(localY), _mm512_loadu_ps(&batch.halfHeight[i])), zero);
+				__m512 distanceSquared = _mm512_add_ps(_mm512_mul_ps(outsideX, outsideX), _mm512_mul_ps(outsideY, outsideY));
+				__mmask16 inside = _mm512_cmp_ps_mask(distanceSquared, radiusSquared, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + circle_obb_intersects_range(circle, batch, results, i);
+		}
+
+		/**
+		 * \brief Squared distance between a corner of the boxes of 16 lanes and the segment of a capsule.
+		 */
+		CH_SIMD_TARGET("avx512f")
+		static __m512 capsule_batch_corner_distance_avx512(__m512 x, __m512 y, __m512 startX, __m512 startY, __m512 directionX, __m512 directionY, __m512 inverseLengthSquared, __m512 zero, __m512 one) {
+			__m512 t = _mm512_min_ps(_mm512_max_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_sub_ps(x, startX), directionX), _mm512_mul_ps(_mm512_sub_ps(y, startY), directionY)), inverseLengthSquared), zero), one);
+			__m512 dx = _mm512_sub_ps(_mm512_add_ps(startX, _mm512_mul_ps(t, directionX)), x);
+			__m512 dy = _mm512_sub_ps(_mm512_add_ps(startY, _mm512_mul_ps(t, directionY)), y);
+			return _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+		}
+
+		CH_SIMD_TARGET("avx512f")
+		static size_t capsule_aabb_intersects_batch_avx512(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			const CapsuleBatchQuery query = make_capsule_batch_query(capsule);
+			const __m512 startX = _mm512_set1_ps(query.startX);
+			const __m512 startY = _mm512_set1_ps(query.startY);
+			const __m512 endX = _mm512_set1_ps(query.startX + query.directionX);
+			const __m512 endY = _mm512_set1_ps(query.startY + query.directionY);
+			const __m512 directionX = _mm512_set1_ps(query.directionX);
+			const __m512 directionY = _mm512_set1_ps(query.directionY);
+			const __m512 inverseLengthSquared = _mm512_set1_ps(query.inverseLengthSquared);
+			const __m512 segmentMinX = _mm512_set1_ps(query.minX);
+			const __m512 segmentMinY = _mm512_set1_ps(query.minY);
+			const __m512 segmentMaxX = _mm512_set1_ps(query.maxX);
+			const __m512 segmentMaxY = _mm512_set1_ps(query.maxY);
+			const __m512 normalX = _mm512_set1_ps(query.normalX);
+			const __m512 normalY = _mm512_set1_ps(query.normalY);
+			const __m512 absNormalX = _mm512_set1_ps(query.absNormalX);
+			const __m512 absNormalY = _mm512_set1_ps(query.absNormalY);
+			const __m512 normalDotStart = _mm512_set1_ps(query.normalDotStart);
+			const __m512 radiusSquared = _mm512_set1_ps(query.radiusSquared);
+			const __m512 half = _mm512_set1_ps(0.5f);
+			const __m512 zero = _mm512_set1_ps(0.f);
+			const __m512 one = _mm512_set1_ps(1.f);
+
+			size_t hits = 0;
+			size_t i = 0;
+			for (; i + 16 <= batch.size(); i += 16) {
+				__m512 minX = _mm512_loadu_ps(&batch.minX[i]);
+				__m512 minY = _mm512_loadu_ps(&batch.minY[i]);
+				__m512 maxX = _mm512_loadu_ps(&batch.maxX[i]);
+				__m512 maxY = _mm512_loadu_ps(&batch.maxY[i]);
+
+				__m512 centerX = _mm512_mul_ps(_mm512_add_ps(minX, maxX), half);
+				__m512 centerY = _mm512_mul_ps(_mm512_add_ps(minY, maxY), half);
+				__m512 halfX = _mm512_mul_ps(_mm512_sub_ps(maxX, minX), half);
+				__m512 halfY = _mm512_mul_ps(_mm512_sub_ps(maxY, minY), half);
+				__mmask16 crossing = _mm512_cmp_ps_mask(segmentMinX, maxX, _CMP_LT_OQ) & _mm512_cmp_ps_mask(segmentMaxX, minX, _CMP_GT_OQ) & _mm512_cmp_ps_mask(segmentMinY, maxY, _CMP_LT_OQ) & _mm512_cmp_ps_mask(segmentMaxY, minY, _CMP_GT_OQ);
+				crossing &= _mm512_cmp_ps_mask(_mm512_abs_ps(_mm512_sub_ps(_mm512_add_ps(_mm512_mul_ps(normalX, centerX), _mm512_mul_ps(normalY, centerY)), normalDotStart)), _mm512_add_ps(_mm512_mul_ps(halfX, absNormalX), _mm512_mul_ps(halfY, absNormalY)), _CMP_LT_OQ);
+
+				__m512 startDX = _mm512_sub_ps(startX, _mm512_min_ps(_mm512_max_ps(startX, minX), maxX));
+				__m512 startDY = _mm512_sub_ps(startY, _mm512_min_ps(_mm512_max_ps(startY, minY), maxY));
+				__m512 endDX = _mm512_sub_ps(endX, _mm512_min_ps(_mm512_max_ps(endX, minX), maxX));
+				__m512 endDY = _mm512_sub_ps(endY, _mm512_min_ps(_mm512_max_ps(endY, minY), maxY));
+				__m512 closest = _mm512_min_ps(_mm512_add_ps(_mm512_mul_ps(startDX, startDX), _mm512_mul_ps(startDY, startDY)), _mm512_add_ps(_mm512_mul_ps(endDX, endDX), _mm512_mul_ps(endDY, endDY)));
+				closest = _mm512_min_ps(closest, _mm512_min_ps(capsule_batch_corner_distance_avx512(minX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx512(maxX, minY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+				closest = _mm512_min_ps(closest, _mm512_min_ps(capsule_batch_corner_distance_avx512(minX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one), capsule_batch_corner_distance_avx512(maxX, maxY, startX, startY, directionX, directionY, inverseLengthSquared, zero, one)));
+
+				__mmask16 inside = crossing | _mm512_cmp_ps_mask(closest, radiusSquared, _CMP_LT_OQ);
+				hits += write_lane_mask(static_cast<unsigned int>(inside), 16, results + i);
+			}
+			return hits + capsule_aabb_intersects_range(capsule, batch, results, i);
+		}
+#endif
+
+		/**
+		 * \brief Throws if the two batches given to a pairwise function don't have the same size.
+		 */
+		static void check_pairwise_sizes(size_t firstSize, size_t otherSize) {
+			if (firstSize != otherSize) {
+				throw std::invalid_argument("Invalid argument : the batches of a pairwise test must have the same size.");
+			}
+		}
+
+		/**
+		 * \brief Returns the kernels matching the active SIMD tier.
+		 */
+		static const BatchCollisionKernels& batch_collision_kernels() {
+			static const std::array<BatchCollisionKernels, static_cast<size_t>(simd::SimdLevel::MAX_VALUE)> KERNELS =
+			{
+#ifdef CH_SIMD_X86
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_sse2, circle_intersects_batch_sse2, line_segments_intersect_batch_sse2, circle_sweep_batch_sse2, line_segment_aabb_clip_batch_sse2, circle_aabb_collision_batch_sse2, aabb_collision_batch_sse2, aabb_obb_intersects_batch_sse2, circle_obb_intersects_batch_sse2, capsule_aabb_intersects_batch_sse2, aabb_intersects_pairwise_sse2, circle_intersects_pairwise_sse2, aabb_circle_intersects_pairwise_sse2, line_segments_intersect_pairwise_sse2, aabb_segment_intersects_pairwise_sse2, circle_segment_intersects_pairwise_sse2 },
+				BatchCollisionKernels{ aabb_intersects_batch_avx2, circle_intersects_batch_avx2, line_segments_intersect_batch_avx2, circle_sweep_batch_avx2, line_segment_aabb_clip_batch_avx2, circle_aabb_collision_batch_avx2, aabb_collision_batch_avx2, aabb_obb_intersects_batch_avx2, circle_obb_intersects_batch_avx2, capsule_aabb_intersects_batch_avx2, aabb_intersects_pairwise_avx2, circle_intersects_pairwise_avx2, aabb_circle_intersects_pairwise_avx2, line_segments_intersect_pairwise_avx2, aabb_segment_intersects_pairwise_avx2, circle_segment_intersects_pairwise_avx2 },
+				BatchCollisionKernels{ aabb_intersects_batch_avx512, circle_intersects_batch_avx512, line_segments_intersect_batch_avx512, circle_sweep_batch_avx2, line_segment_aabb_clip_batch_avx512, circle_aabb_collision_batch_avx512, aabb_collision_batch_avx512, aabb_obb_intersects_batch_avx512, circle_obb_intersects_batch_avx512, capsule_aabb_intersects_batch_avx512, aabb_intersects_pairwise_avx2, circle_intersects_pairwise_avx2, aabb_circle_intersects_pairwise_avx2, line_segments_intersect_pairwise_avx2, aabb_segment_intersects_pairwise_avx2, circle_segment_intersects_pairwise_avx2 }
+#else
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar },
+				BatchCollisionKernels{ aabb_intersects_batch_scalar, circle_intersects_batch_scalar, line_segments_intersect_batch_scalar, circle_sweep_batch_scalar, line_segment_aabb_clip_batch_scalar, circle_aabb_collision_batch_scalar, aabb_collision_batch_scalar, aabb_obb_intersects_batch_scalar, circle_obb_intersects_batch_scalar, capsule_aabb_intersects_batch_scalar, aabb_intersects_pairwise_scalar, circle_intersects_pairwise_scalar, aabb_circle_intersects_pairwise_scalar, line_segments_intersect_pairwise_scalar, aabb_segment_intersects_pairwise_scalar, circle_segment_intersects_pairwise_scalar }
+#endif
+			};
+			return KERNELS[static_cast<size_t>(simd::active_simd_level())];
+		}
+
+		size_t aabb_intersects_batch(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().aabbIntersects(aabb, batch, results);
+		}
+
+		size_t circle_intersects_batch(const Circle& circle, const CircleBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().circleIntersects(circle, batch, results);
+		}
+
+		size_t line_segments_intersect_batch(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t, float* u) {
+			return batch_collision_kernels().segmentsIntersect(segment, batch, results, t, u);
+		}
+
+		size_t line_segments_intersect_batch(const LineSegmentBatch& first, const LineSegmentBatch& other, std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs) {
+			pairs.clear();
+			const SegmentBatchKernel kernel = batch_collision_kernels().segmentsIntersect;
+			std::vector<std::uint8_t> results(other.size());
+
+			for (size_t i = 0; i < first.size(); ++i) {
+				if (kernel(first.at(i), other, results.data(), nullptr, nullptr) == 0) {
+					continue;
+				}
+				for (size_t j = 0; j < other.size(); ++j) {
+					if (results[j]) {
+						pairs.emplace_back(static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j));
+					}
+				}
+			}
+			return pairs.size();
+		}
+
+		bool circle_sweep_batch(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, CircleSweepHit& hit) {
+			float earliest = std::numeric_limits<float>::infinity();
+			size_t earliestIndex = batch.size();
+			batch_collision_kernels().circleSweep(circle, motion, batch, earliest, earliestIndex);
+
+			if (earliestIndex == batch.size()) {
+				return false;
+			}
+			hit = circle_sweep_hit(circle, motion, batch.at(earliestIndex), static_cast<std::uint32_t>(earliestIndex), earliest);
+			return true;
+		}
+
+		size_t line_segment_aabb_clip_batch(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry, float* exit) {
+			return batch_collision_kernels().segmentAABBClip(segment, batch, results, entry, exit);
+		}
+
+		size_t circle_aabb_collision_batch(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX, float* normalY, float* depth) {
+			return batch_collision_kernels().circleAABBCollision(circle, batch, results, normalX, normalY, depth);
+		}
+
+		size_t aabb_collision_batch(const AABBBatch& batch, const std::vector<AABBIndexPair>& pairs, std::vector<AABBCollision>& collisions) {
+			collisions.resize(pairs.size());
+			return batch_collision_kernels().aabbPairCollision(batch, pairs.data(), pairs.size(), collisions.data());
+		}
+
+		size_t obb_intersects_batch(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().aabbOBBIntersects(aabb, batch, results);
+		}
+
+		size_t obb_intersects_batch(const Circle& circle, const OBBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().circleOBBIntersects(circle, batch, results);
+		}
+
+		size_t capsule_aabb_intersects_batch(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results) {
+			return batch_collision_kernels().capsuleAABBIntersects(capsule, batch, results);
+		}
+
+		size_t aabb_intersects_pairwise(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results) {
+			check_pairwise_sizes(first.size(), other.size());
+			return batch_collision_kernels().aabbPairwise(first, other, results);
+		}
+
+		size_t circle_intersects_pairwise(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results) {
+			check_pairwise_sizes(first.size(), other.size());
+			return batch_collision_kernels().circlePairwise(first, other, results);
+		}
+
+		size_t aabb_circle_intersects_pairwise(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results) {
+			check_pairwise_sizes(aabbs.size(), circles.size());
+			return batch_collision_kernels().aabbCirclePairwise(aabbs, circles, results);
+		}
+
+		size_t line_segments_intersect_pairwise(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results) {
+			check_pairwise_sizes(first.size(), other.size());
+			return batch_collision_kernels().segmentPairwise(first, other, results);
+		}
+
+		size_t aabb_segment_intersects_pairwise(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results) {
+			check_pairwise_sizes(aabbs.size(), segments.size());
+			return batch_collision_kernels().aabbSegmentPairwise(aabbs, segments, results);
+		}
+
+		size_t circle_segment_intersects_pairwise(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results) {
+			check_pairwise_sizes(circles.size(), segments.size());
+			return batch_collision_kernels().circleSegmentPairwise(circles, segments, results);
+		}
+	}
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "AABB.h"
+#include "Circle.h"
+#include "Capsule.h"
+#include "AABBBatch.h"
+#include "CircleBatch.h"
+#include "LineSegmentBatch.h"
+#include "OBBBatch.h"
+#include "CircleSweepHit.h"
+#include "AABBCollision.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ch {
+	namespace collision {
+
+		/**
+		 * \brief A pair of indices of AABBs in an AABBBatch, as returned by a broadphase.
+		 */
+		using AABBIndexPair = std::pair<std::uint32_t, std::uint32_t>;
+
+		/**
+		 * \brief Tests one AABB against every AABB of a batch.
+		 *
+		 * This is the batched equivalent of aabb_intersects(const AABB&, const AABB&). The
+		 * implementation (scalar, SSE2, AVX2 or AVX-512) is chosen at runtime depending on
+		 * ch::simd::active_simd_level().
+		 *
+		 * \param aabb The AABB tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the AABB intersects the i-th AABB of the batch, 0 otherwise.
+		 * \return The number of intersecting AABBs.
+		 */
+		size_t aabb_intersects_batch(const AABB& aabb, const AABBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one circle against every circle of a batch.
+		 *
+		 * This is the batched equivalent of circle_intersects(const Circle&, const Circle&).
+		 *
+		 * \param circle The circle tested against the batch.
+		 * \param batch The circles to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the circle intersects the i-th circle of the batch, 0 otherwise.
+		 * \return The number of intersecting circles.
+		 */
+		size_t circle_intersects_batch(const Circle& circle, const CircleBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one line segment against every segment of a batch.
+		 *
+		 * This is the batched equivalent of line_segments_parametric_intersection(). Segments
+		 * that cross or overlap are intersecting. Depending on the compiler, the SIMD kernels may
+		 * fuse multiplications and additions, so t and u can differ from the scalar function in
+		 * their last bits.
+		 *
+		 * \param segment The segment tested against the batch.
+		 * \param batch The segments to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the segment intersects the i-th segment of the batch, 0 otherwise.
+		 * \param t Optional output array of at least batch.size() elements. t[i] receives the position
+		 * 		  of the intersection (or of the start of the overlap) along the segment, 0 if there is none.
+		 * \param u Optional output array, same as t but along the i-th segment of the batch.
+		 * \return The number of intersecting segments.
+		 */
+		size_t line_segments_intersect_batch(const LineSegment& segment, const LineSegmentBatch& batch, std::uint8_t* results, float* t = nullptr, float* u = nullptr);
+
+		/**
+		 * \brief Tests every segment of a batch against every segment of another batch.
+		 *
+		 * \param pairs Cleared, then filled with the (index in first, index in other) pairs of
+		 * 		  intersecting segments, sorted by index in first then by index in other.
+		 * \return The number of intersecting pairs.
+		 */
+		size_t line_segments_intersect_batch(const LineSegmentBatch& first, const LineSegmentBatch& other, std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs);
+
+		/**
+		 * \brief Clips one line segment against every AABB of a batch.
+		 *
+		 * This is the batched equivalent of line_segment_aabb_clip().
+		 *
+		 * \param segment The segment tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the segment crosses or touches the i-th AABB of the batch, 0 otherwise.
+		 * \param entry Optional output array of at least batch.size() elements. entry[i] receives the position
+		 * 		  where the segment enters the i-th AABB, 0 if it doesn't intersect it.
+		 * \param exit Optional output array, same as entry but for the position where the segment leaves the AABB.
+		 * \return The number of intersected AABBs.
+		 */
+		size_t line_segment_aabb_clip_batch(const LineSegment& segment, const AABBBatch& batch, std::uint8_t* results, float* entry = nullptr, float* exit = nullptr);
+
+		/**
+		 * \brief Computes the collision between one circle and every AABB of a batch.
+		 *
+		 * This is the batched equivalent of circle_aabb_collision_info().
+		 *
+		 * \param circle The circle tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the circle collides with the i-th AABB of the batch, 0 otherwise.
+		 * \param normalX Optional output array of at least batch.size() elements. normalX[i] receives the X component
+		 * 		  of the normal towards which the circle must be pushed out of the i-th AABB, 0 if they don't collide.
+		 * \param normalY Optional output array, same as normalX but for the Y component of the normal.
+		 * \param depth Optional output array, same as normalX but for the penetration depth.
+		 * \return The number of AABBs colliding with the circle.
+		 */
+		size_t circle_aabb_collision_batch(const Circle& circle, const AABBBatch& batch, std::uint8_t* results, float* normalX = nullptr, float* normalY = nullptr, float* depth = nullptr);
+
+		/**
+		 * \brief Computes the collision of every pair of AABBs of a list.
+		 *
+		 * This is the batched equivalent of aabb_collision_info(), meant to be used as the
+		 * narrowphase of a broadphase that outputs pairs of indices.
+		 *
+		 * \param batch The AABBs referenced by the pairs.
+		 * \param pairs The pairs to test. Both indices must be lower than batch.size().
+		 * \param collisions Resized to pairs.size(). collisions[i] receives the collision between the
+		 * 		  AABBs of the i-th pair, as computed by aabb_collision_info(batch.at(first), batch.at(second)).
+		 * \return The number of colliding pairs.
+		 */
+		size_t aabb_collision_batch(const AABBBatch& batch, const std::vector<AABBIndexPair>& pairs, std::vector<AABBCollision>& collisions);
+
+		/**
+		 * \brief Tests one AABB against every OBB of a batch.
+		 *
+		 * This is the batched equivalent of obb_intersects(const OBB&, const AABB&). The boxes are
+		 * projected on their 4 axes using the cosines and sines stored in the batch.
+		 *
+		 * \param aabb The AABB tested against the batch.
+		 * \param batch The OBBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the AABB intersects the i-th OBB of the batch, 0 otherwise.
+		 * \return The number of intersecting OBBs.
+		 */
+		size_t obb_intersects_batch(const AABB& aabb, const OBBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one circle against every OBB of a batch.
+		 *
+		 * This is the batched equivalent of obb_intersects(const OBB&, const Circle&).
+		 *
+		 * \param circle The circle tested against the batch.
+		 * \param batch The OBBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the circle intersects the i-th OBB of the batch, 0 otherwise.
+		 * \return The number of intersecting OBBs.
+		 */
+		size_t obb_intersects_batch(const Circle& circle, const OBBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests one capsule against every AABB of a batch.
+		 *
+		 * This is the batched equivalent of capsule_intersects(const Capsule&, const AABB&), meant to
+		 * test a character against the level geometry.
+		 *
+		 * \param capsule The capsule tested against the batch.
+		 * \param batch The AABBs to test.
+		 * \param results Output array of at least batch.size() elements. results[i] is set to 1
+		 * 		  if the capsule intersects the i-th AABB of the batch, 0 otherwise.
+		 * \return The number of intersecting AABBs.
+		 */
+		size_t capsule_aabb_intersects_batch(const Capsule& capsule, const AABBBatch& batch, std::uint8_t* results);
+
+		/**
+		 * \brief Tests every pair of AABBs (first[i], other[i]) of two batches of the same size.
+		 *
+		 * Unlike the functions above, which test one shape against a whole batch, the pairwise
+		 * functions test the i-th element of a batch against the i-th element of the other batch.
+		 * They are meant to process the candidate pairs of a broadphase once gathered by shape type
+		 * (see ShapePairDispatcher). The AVX-512 tier uses the AVX2 kernels.
+		 *
+		 * \param results Output array of at least first.size() elements. results[i] is set to 1
+		 * 		  if first[i] and other[i] intersect (see aabb_intersects()), 0 otherwise.
+		 * \throws std::invalid_argument If the batches don't have the same size.
+		 * \return The number of intersecting pairs.
+		 */
+		size_t aabb_intersects_pairwise(const AABBBatch& first, const AABBBatch& other, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs of circles (see circle_intersects(const Circle&, const Circle&)). */
+		size_t circle_intersects_pairwise(const CircleBatch& first, const CircleBatch& other, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs (aabbs[i], circles[i]) (see aabb_intersects(const AABB&, const Circle&)). */
+		size_t aabb_circle_intersects_pairwise(const AABBBatch& aabbs, const CircleBatch& circles, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs of segments (see line_segments_intersect_batch()). */
+		size_t line_segments_intersect_pairwise(const LineSegmentBatch& first, const LineSegmentBatch& other, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs (aabbs[i], segments[i]) (see aabb_intersects(const AABB&, const LineSegment&)). */
+		size_t aabb_segment_intersects_pairwise(const AABBBatch& aabbs, const LineSegmentBatch& segments, std::uint8_t* results);
+
+		/** \brief Same as aabb_intersects_pairwise(), for pairs (circles[i], segments[i]) (see circle_intersects(const Circle&, const LineSegment&)). */
+		size_t circle_segment_intersects_pairwise(const CircleBatch& circles, const LineSegmentBatch& segments, std::uint8_t* results);
+
+		/**
+		 * \brief Finds the first segment of a batch hit by a moving circle.
+		 *
+		 * This is the batched equivalent of circle_sweep(). The circle moves from circle.pos
+		 * to circle.pos + motion. The AVX-512 tier uses the AVX2 kernel.
+		 *
+		 * \param hit Receives the index of the segment, the time of impact, the normal and the contact point.
+		 * \return True if a segment was hit, false otherwise (hit is left untouched).
+		 */
+		bool circle_sweep_batch(const Circle& circle, const vec_t& motion, const LineSegmentBatch& batch, CircleSweepHit& hit);
+	}
+}
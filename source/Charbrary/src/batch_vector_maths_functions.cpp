@@ -0,0 +1,210 @@
+#include "batch_vector_maths_functions.h"
+#include "cpu_features.h"
+
+#include <array>
+#include <cmath>
+
+#ifdef CH_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace ch {
+
+	using MagnitudeBatchKernel = void(*)(const float*, const float*, float*, size_t);
+	using DotProductBatchKernel = void(*)(const float*, const float*, const float*, const float*, float*, size_t);
+	using NormalizeBatchKernel = void(*)(float*, float*, size_t);
+
+	/**
+	 * \brief Function pointers to the batched vector maths kernels of one SIMD tier.
+	 */
+	struct BatchVectorMathsKernels {
+		MagnitudeBatchKernel magnitude;
+		DotProductBatchKernel dotProduct;
+		NormalizeBatchKernel normalize;
+	};
+
+	static void vec_magnitude_range(const float* x, const float* y, float* magnitudes, size_t first, size_t count) {
+		for (size_t i = first; i < count; ++i) {
+			magnitudes[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+		}
+	}
+
+	static void vec_dot_product_range(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t first, size_t count) {
+		for (size_t i = first; i < count; ++i) {
+			products[i] = ax[i] * bx[i] + ay[i] * by[i];
+		}
+	}
+
+	static void vec_normalize_range(float* x, float* y, size_t first, size_t count) {
+		for (size_t i = first; i < count; ++i) {
+			if (x[i] != 0.f || y[i] != 0.f) {
+				float magnitude = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+				x[i] /= magnitude;
+				y[i] /= magnitude;
+			}
+		}
+	}
+
+	static void vec_magnitude_batch_scalar(const float* x, const float* y, float* magnitudes, size_t count) {
+		vec_magnitude_range(x, y, magnitudes, 0, count);
+	}
+
+	static void vec_dot_product_batch_scalar(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		vec_dot_product_range(ax, ay, bx, by, products, 0, count);
+	}
+
+	static void vec_normalize_batch_scalar(float* x, float* y, size_t count) {
+		vec_normalize_range(x, y, 0, count);
+	}
+
+#ifdef CH_SIMD_X86
+	CH_SIMD_TARGET("sse2")
+	static void vec_magnitude_batch_sse2(const float* x, const float* y, float* magnitudes, size_t count) {
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 vx = _mm_loadu_ps(x + i);
+			__m128 vy = _mm_loadu_ps(y + i);
+			_mm_storeu_ps(magnitudes + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy))));
+		}
+		vec_magnitude_range(x, y, magnitudes, i, count);
+	}
+
+	CH_SIMD_TARGET("sse2")
+	static void vec_dot_product_batch_sse2(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 xx = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+			__m128 yy = _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+			_mm_storeu_ps(products + i, _mm_add_ps(xx, yy));
+		}
+		vec_dot_product_range(ax, ay, bx, by, products, i, count);
+	}
+
+	CH_SIMD_TARGET("sse2")
+	static void vec_normalize_batch_sse2(float* x, float* y, size_t count) {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 vx = _mm_loadu_ps(x + i);
+			__m128 vy = _mm_loadu_ps(y + i);
+			__m128 magnitude = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+			// Null vectors are divided by 1 so they stay null instead of becoming NaN
+			__m128 isNull = _mm_cmpeq_ps(magnitude, zero);
+			__m128 divisor = _mm_or_ps(_mm_and_ps(isNull, one), _mm_andnot_ps(isNull, magnitude));
+			_mm_storeu_ps(x + i, _mm_div_ps(vx, divisor));
+			_mm_storeu_ps(y + i, _mm_div_ps(vy, divisor));
+		}
+		vec_normalize_range(x, y, i, count);
+	}
+
+	CH_SIMD_TARGET("avx2")
+	static void vec_magnitude_batch_avx2(const float* x, const float* y, float* magnitudes, size_t count) {
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 vx = _mm256_loadu_ps(x + i);
+			__m256 vy = _mm256_loadu_ps(y + i);
+			_mm256_storeu_ps(magnitudes + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy))));
+		}
+		vec_magnitude_range(x, y, magnitudes, i, count);
+	}
+
+	CH_SIMD_TARGET("avx2")
+	static void vec_dot_product_batch_avx2(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 xx = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+			__m256 yy = _mm256_mul_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i));
+			_mm256_storeu_ps(products + i, _mm256_add_ps(xx, yy));
+		}
+		vec_dot_product_range(ax, ay, bx, by, products, i, count);
+	}
+
+	CH_SIMD_TARGET("avx2")
+	static void vec_normalize_batch_avx2(float* x, float* y, size_t count) {
+		const __m256 zero = _mm256_setzero_ps();
+		const __m256 one = _mm256_set1_ps(1.f);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 vx = _mm256_loadu_ps(x + i);
+			__m256 vy = _mm256_loadu_ps(y + i);
+			__m256 magnitude = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+			__m256 divisor = _mm256_blendv_ps(magnitude, one, _mm256_cmp_ps(magnitude, zero, _CMP_EQ_OQ));
+			_mm256_storeu_ps(x + i, _mm256_div_ps(vx, divisor));
+			_mm256_storeu_ps(y + i, _mm256_div_ps(vy, divisor));
+		}
+		vec_normalize_range(x, y, i, count);
+	}
+
+	CH_SIMD_TARGET("avx512f")
+	static void vec_magnitude_batch_avx512(const float* x, const float* y, float* magnitudes, size_t count) {
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m512 vx = _mm512_loadu_ps(x + i);
+			__m512 vy = _mm512_loadu_ps(y + i);
+			_mm512_storeu_ps(magnitudes + i, _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(vx, vx), _mm512_mul_ps(vy, vy))));
+		}
+		vec_magnitude_range(x, y, magnitudes, i, count);
+	}
+
+	CH_SIMD_TARGET("avx512f")
+	static void vec_dot_product_batch_avx512(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m512 xx = _mm512_mul_ps(_mm512_loadu_ps(ax + i), _mm512_loadu_ps(bx + i));
+			__m512 yy = _mm512_mul_ps(_mm512_loadu_ps(ay + i), _mm512_loadu_ps(by + i));
+			_mm512_storeu_ps(products + i, _mm512_add_ps(xx, yy));
+		}
+		vec_dot_product_range(ax, ay, bx, by, products, i, count);
+	}
+
+	CH_SIMD_TARGET("avx512f")
+	static void vec_normalize_batch_avx512(float* x, float* y, size_t count) {
+		const __m512 zero = _mm512_setzero_ps();
+		const __m512 one = _mm512_set1_ps(1.f);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16) {
+			__m512 vx = _mm512_loadu_ps(x + i);
+			__m512 vy = _mm512_loadu_ps(y + i);
+			__m512 magnitude = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(vx, vx), _mm512_mul_ps(vy, vy)));
+			__m512 divisor = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(magnitude, zero, _CMP_EQ_OQ), magnitude, one);
+			_mm512_storeu_ps(x + i, _mm512_div_ps(vx, divisor));
+			_mm512_storeu_ps(y + i, _mm512_div_ps(vy, divisor));
+		}
+		vec_normalize_range(x, y, i, count);
+	}
+#endif
+
+	/**
+	 * \brief Returns the kernels matching the active SIMD tier.
+	 */
+	static const BatchVectorMathsKernels& batch_vector_maths_kernels() {
+		static const std::array<BatchVectorMathsKernels, static_cast<size_t>(simd::SimdLevel::MAX_VALUE)> KERNELS =
+		{
+#ifdef CH_SIMD_X86
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_sse2, vec_dot_product_batch_sse2, vec_normalize_batch_sse2 },
+			BatchVectorMathsKernels{ vec_magnitude_batch_avx2, vec_dot_product_batch_avx2, vec_normalize_batch_avx2 },
+			BatchVectorMathsKernels{ vec_magnitude_batch_avx512, vec_dot_product_batch_avx512, vec_normalize_batch_avx512 }
+#else
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar },
+			BatchVectorMathsKernels{ vec_magnitude_batch_scalar, vec_dot_product_batch_scalar, vec_normalize_batch_scalar }
+#endif
+		};
+		return KERNELS[static_cast<size_t>(simd::active_simd_level())];
+	}
+
+	void vec_magnitude_batch(const float* x, const float* y, float* magnitudes, size_t count) {
+		batch_vector_maths_kernels().magnitude(x, y, magnitudes, count);
+	}
+
+	void vec_dot_product_batch(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count) {
+		batch_vector_maths_kernels().dotProduct(ax, ay, bx, by, products, count);
+	}
+
+	void vec_normalize_batch(float* x, float* y, size_t count) {
+		batch_vector_maths_kernels().normalize(x, y, count);
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ch {
+	/**
+	 * \brief Computes the magnitude of many vectors.
+	 *
+	 * Batched equivalent of vec_magnitude(). The vectors are given as two arrays, one
+	 * for the X components and one for the Y components. The implementation (scalar,
+	 * SSE2, AVX2 or AVX-512) is chosen at runtime depending on ch::simd::active_simd_level().
+	 *
+	 * \param x X components of the vectors.
+	 * \param y Y components of the vectors.
+	 * \param magnitudes Output array receiving the magnitude of each vector.
+	 * \param count Number of vectors.
+	 */
+	void vec_magnitude_batch(const float* x, const float* y, float* magnitudes, size_t count);
+
+	/**
+	 * \brief Computes the dot product of many pairs of vectors.
+	 *
+	 * Batched equivalent of vec_dot_product(). products[i] receives the dot product of (ax[i], ay[i]) and (bx[i], by[i]).
+	 */
+	void vec_dot_product_batch(const float* ax, const float* ay, const float* bx, const float* by, float* products, size_t count);
+
+	/**
+	 * \brief Normalizes many vectors in place.
+	 *
+	 * Batched equivalent of vec_normalize(). Null vectors stay null.
+	 *
+	 * \param x X components of the vectors, overwritten with the normalized components.
+	 * \param y Y components of the vectors, overwritten with the normalized components.
+	 * \param count Number of vectors.
+	 */
+	void vec_normalize_batch(float* x, float* y, size_t count);
+}
@@ -1,5 +1,8 @@
 #include "collision_functions.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace ch {
 	namespace collision {
 		Circle enclosingCircle(const AABB& aabb) {
@@ -24,26 +27,44 @@ namespace ch {
 			return AABB(circle.pos - halfSize, halfSize * 2.f);
 		}
 
+		Bounds enclosingBounds(const Circle& circle) {
+			return Bounds(circle.pos.x - circle.radius, circle.pos.y - circle.radius, circle.pos.x + circle.radius, circle.pos.y + circle.radius);
+		}
+
+		Bounds enclosingBounds(const LineSegment& lineSegment) {
+			return Bounds(lineSegment.minX(), lineSegment.minY(), lineSegment.maxX(), lineSegment.maxY());
+		}
+
 		bool aabb_contains(const AABB& aabb, const vec_t& point) {
+			return aabb_contains(Bounds(aabb), point);
+		}
+
+		bool aabb_contains(const Bounds& bounds, const vec_t& point) {
 			return
-				point.x >= aabb.pos.x &&
-				point.y >= aabb.pos.y &&
-				point.x <= aabb.pos.x + aabb.size.x &&
-				point.y <= aabb.pos.y + aabb.size.y;
+				point.x >= bounds.min.x &&
+				point.y >= bounds.min.y &&
+				point.x <= bounds.max.x &&
+				point.y <= bounds.max.y;
 		}
 
 		bool aabb_contains(const AABB& first, const AABB& other) {
-			if (first.area() >= other.area()) {
-				AABB zone = first;
-				zone.size -= other.size;
+			return aabb_contains(Bounds(first), Bounds(other));
+		}
 
-				return aabb_contains(zone, other.pos);
-			}
-			return false;
+		bool aabb_contains(const Bounds& first, const Bounds& other) {
+			return
+				other.min.x >= first.min.x &&
+				other.min.y >= first.min.y &&
+				other.max.x <= first.max.x &&
+				other.max.y <= first.max.y;
 		}
 
 		bool aabb_contains(const AABB& aabb, const Circle& circle) {
-			return aabb_contains(aabb, enclosingAABB(circle));
+			return aabb_contains(Bounds(aabb), enclosingBounds(circle));
+		}
+
+		bool aabb_contains(const Bounds& bounds, const Circle& circle) {
+			return aabb_contains(bounds, enclosingBounds(circle));
 		}
 
 		bool circle_contains(const Circle& circle, const vec_t& point) {
@@ -58,43 +79,79 @@ namespace ch {
 		}
 
 		bool circle_contains(const Circle& circle, const AABB& aabb) {
+			return circle_contains(circle, Bounds(aabb));
+		}
+
+		bool circle_contains(const Circle& circle, const Bounds& bounds) {
 			return
-				circle_contains(circle, aabb.corner(ch::Corner::TopLeft)) &&
-				circle_contains(circle, aabb.corner(ch::Corner::TopRight)) &&
-				circle_contains(circle, aabb.corner(ch::Corner::BottomLeft)) &&
-				circle_contains(circle, aabb.corner(ch::Corner::BottomRight));
+				circle_contains(circle, bounds.min) &&
+				circle_contains(circle, vec_t(bounds.max.x, bounds.min.y)) &&
+				circle_contains(circle, vec_t(bounds.min.x, bounds.max.y)) &&
+				circle_contains(circle, bounds.max);
 		}
 
 		bool aabb_intersects(const AABB& a, const AABB& b) {
-			AABB extended = b;
-
-			extended.size += a.size;
-			extended.pos -= a.size;
+			return aabb_intersects(Bounds(a), Bounds(b));
+		}
 
-			return aabb_contains(extended, a.pos);
+		bool aabb_intersects(const Bounds& a, const Bounds& b) {
+			return
+				a.max.x >= b.min.x &&
+				a.max.y >= b.min.y &&
+				a.min.x <= b.max.x &&
+				a.min.y <= b.max.y;
 		}
 
 		bool aabb_intersects(const AABB& aabb, const Circle& circle) {
-			// First check : are the circle and the box close enough to be colliding ?
-			if (!aabb_intersects(aabb, enclosingAABB(circle))) {
+			return aabb_intersects(Bounds(aabb), circle);
+		}
+
+		bool aabb_intersects(const Bounds& bounds, const Circle& circle) {
+			vec_t delta = circle.pos - closest_point_on_aabb(bounds, circle.pos);
+			return vec_magnitude_squared(delta) < circle.radius * circle.radius;
+		}
+
+		bool aabb_intersects(const AABB& aabb, const LineSegment& segment) {
+			return line_segment_aabb_clip(segment, Bounds(aabb)).intersects;
+		}
+
+		bool aabb_intersects(const Bounds& bounds, const LineSegment& segment) {
+			return line_segment_aabb_clip(segment, bounds).intersects;
+		}
+
+		bool aabb_intersects(const AABB& aabb, const PreparedSegment& segment) {
+			return aabb_intersects(Bounds(aabb), segment);
+		}
+
+		bool aabb_intersects(const Bounds& bounds, const PreparedSegment& segment) {
+			// Same slab test as clip_to_bounds(), without building the clipped segment. The
+			// direction is the same for every box, so the branches are always predicted.
+			const vec_t& start = segment.start();
+			const vec_t& inverse = segment.inverseDirection();
+			float entry = 0.f;
+			float exit = 1.f;
+
+			if (inverse.x != 0.f) {
+				float t1 = (bounds.min.x - start.x) * inverse.x;
+				float t2 = (bounds.max.x - start.x) * inverse.x;
+				entry = std::max(entry, std::min(t1, t2));
+				exit = std::min(exit, std::max(t1, t2));
+			}
+			else if (start.x < bounds.min.x || start.x > bounds.max.x) {
 				return false;
 			}
 
-			// Second check : does the circle contain any of the box corners ?
-			if (circle_contains(circle, aabb.corner(ch::Corner::TopLeft)) ||
-				circle_contains(circle, aabb.corner(ch::Corner::TopRight)) ||
-				circle_contains(circle, aabb.corner(ch::Corner::BottomLeft)) ||
-				circle_contains(circle, aabb.corner(ch::Corner::BottomRight)))
-					return true;
-
-			// Last check : does the aabb contain any of the extremums of the circle ?
-			if (aabb_contains(aabb, circle.pos + LEFT_VEC * circle.radius) ||
-				aabb_contains(aabb, circle.pos + RIGHT_VEC * circle.radius) ||
-				aabb_contains(aabb, circle.pos + UP_VEC * circle.radius) ||
-				aabb_contains(aabb, circle.pos + DOWN_VEC * circle.radius))
-					return true;
+			if (inverse.y != 0.f) {
+				float t1 = (bounds.min.y - start.y) * inverse.y;
+				float t2 = (bounds.max.y - start.y) * inverse.y;
+				entry = std::max(entry, std::min(t1, t2));
+				exit = std::min(exit, std::max(t1, t2));
+			}
+			else if (start.y < bounds.min.y || start.y > bounds.max.y) {
+				return false;
+			}
 
-			return false;
+			return entry <= exit;
 		}
 
 		bool circle_intersects(const Circle& circle, const Circle& other) {
@@ -102,57 +159,76 @@ namespace ch {
 		}
 
 		bool circle_intersects(const Circle& circle, const AABB& aabb) {
-			return aabb_intersects(aabb, circle);
+			return aabb_intersects(Bounds(aabb), circle);
 		}
 
-		float circles_distance(const Circle& a, const Circle& b) {
-			return vec_magnitude(a.pos - b.pos) - a.radius - b.radius;
+		bool circle_intersects(const Circle& circle, const Bounds& bounds) {
+			return aabb_intersects(bounds, circle);
 		}
-		
-		AABBCollision aabb_collision_info(const AABB& first, const AABB& other) {
-			if (!aabb_intersects(first, other)) {
-				return AABBCollision{ NULL_VEC, NULL_VEC };
-			}
 
-			auto currentCorners = first.corners();
-			auto otherCorners = other.corners();
+		bool circle_intersects(const Circle& circle, const LineSegment& segment) {
+			return vec_magnitude_squared(circle.pos - closest_point_on_segment(segment, circle.pos)) < circle.radius * circle.radius;
+		}
 
-			auto otherCenter = other.center();
+		bool circle_intersects(const Circle& circle, const PreparedSegment& segment) {
+			return vec_magnitude_squared(circle.pos - closest_point_on_segment(segment, circle.pos)) < circle.radius * circle.radius;
+		}
 
-			float closestCornerDistanceSquared = std::numeric_limits<float>::infinity();
+		vec_t closest_point_on_segment(const LineSegment& segment, const vec_t& point) {
+			const vec_t e = segment.end - segment.start;
+			const float lengthSquared = vec_dot_product(e, e);
+			if (lengthSquared == 0.f) {
+				return segment.start;
+			}
+			float u = vec_dot_product(point - segment.start, e) / lengthSquared;
+			u = std::min(std::max(u, 0.f), 1.f);
+			return segment.start + e * u;
+		}
 
-			Corner closestCorner = Corner::MAX_VALUE;
+		vec_t closest_point_on_segment(const PreparedSegment& segment, const vec_t& point) {
+			float u = vec_dot_product(point - segment.start(), segment.direction()) * segment.inverseLengthSquared();
+			u = std::min(std::max(u, 0.f), 1.f);
+			return segment.start() + segment.direction() * u;
+		}
 
-			for (size_t i = 0; i < static_cast<size_t>(Corner::MAX_VALUE); ++i) {
-				float distanceToOtherCenterSquared = vec_magnitude(currentCorners[i] - otherCenter);
+		vec_t closest_point_on_aabb(const AABB& aabb, const vec_t& point) {
+			return closest_point_on_aabb(Bounds(aabb), point);
+		}
 
-				if (distanceToOtherCenterSquared < closestCornerDistanceSquared) {
-					closestCornerDistanceSquared = distanceToOtherCenterSquared;
-					closestCorner = static_cast<Corner>(i);
-				}
-			}
+		vec_t closest_point_on_aabb(const Bounds& bounds, const vec_t& point) {
+			return vec_t(
+				std::min(std::max(point.x, bounds.min.x), bounds.max.x),
+				std::min(std::max(point.y, bounds.min.y), bounds.max.y));
+		}
 
-			Corner oppositeCorner = diagonally_opposed_corner(closestCorner);
+		float circles_distance(const Circle& a, const Circle& b) {
+			return vec_magnitude(a.pos - b.pos) - a.radius - b.radius;
+		}
+		
+		AABBCollision aabb_collision_info(const AABB& first, const AABB& other) {
+			return aabb_collision_info(Bounds(first), Bounds(other));
+		}
 
-			auto c1 = currentCorners[static_cast<size_t>(closestCorner)];
-			auto c2 = otherCorners[static_cast<size_t>(oppositeCorner)];
-			vec_t delta = c1 - c2;
-			delta = vec_abs(delta);
+		AABBCollision aabb_collision_info(const Bounds& first, const Bounds& other) {
+			if (!aabb_intersects(first, other)) {
+				return AABBCollision{ NULL_VEC, NULL_VEC };
+			}
+
+			// Side of the first AABB closest to the center of the other one, on each axis (the sums are twice the centers)
+			const bool left = other.min.x + other.max.x <= first.min.x + first.max.x;
+			const bool top = other.min.y + other.max.y <= first.min.y + first.max.y;
 
 			AABBCollision collision;
-			collision.delta = delta;
+			collision.delta = vec_t(
+				std::abs(left ? first.min.x - other.max.x : first.max.x - other.min.x),
+				std::abs(top ? first.min.y - other.max.y : first.max.y - other.min.y));
 
-			if (delta.x > delta.y) {
-				if (closestCorner == Corner::TopLeft || closestCorner == Corner::TopRight)
-					collision.normal = UP_VEC;
-				else
-					collision.normal = DOWN_VEC;
+			// The collision is resolved along the axis with the smallest overlap
+			if (collision.delta.x > collision.delta.y) {
+				collision.normal = top ? UP_VEC : DOWN_VEC;
 			}
 			else {
-				if (closestCorner == Corner::TopLeft || closestCorner == Corner::BottomLeft)
-					collision.normal = LEFT_VEC;
-				else
-					collision.normal = RIGHT_VEC;
+				collision.normal = left ? LEFT_VEC : RIGHT_VEC;
 			}
 
 			return collision;
@@ -166,29 +242,36 @@ namespace ch {
 		}
 
 		CircleAABBCollision circle_aabb_collision_info(const AABB& aabb, const Circle& circle) {
+			return circle_aabb_collision_info(Bounds(aabb), circle);
+		}
+
+		CircleAABBCollision circle_aabb_collision_info(const Bounds& bounds, const Circle& circle) {
 			static const CircleAABBCollision NO_COLLISION = CircleAABBCollision{ NULL_VEC, 0.f };
 
-			if (!aabb_intersects(aabb, enclosingAABB(circle))) {
+			vec_t delta = circle.pos - closest_point_on_aabb(bounds, circle.pos);
+			float distanceSquared = vec_magnitude_squared(delta);
+
+			if (distanceSquared >= circle.radius * circle.radius) {
 				return NO_COLLISION;
 			}
 
-			if ((circle.pos.x > aabb.pos.x && circle.pos.x < aabb.pos.x + aabb.size.x) ||
-				(circle.pos.y > aabb.pos.y && circle.pos.y < aabb.pos.y + aabb.size.y)) {
-				auto aabbColl = aabb_collision_info(aabb, enclosingAABB(circle));
-				return CircleAABBCollision{ aabbColl.normal, aabbColl.absolutePenetrationDepthAlongNormal() };
-			}
-			else {
-				auto corners = aabb.corners();
-				for (const auto& corner : corners) {
-					if (circle_contains(circle, corner)) {
-						auto dir = vec_normalize(circle.pos - corner);
-						float depth = circle.radius - vec_magnitude(circle.pos - corner);
-						return CircleAABBCollision{ dir, depth };
-					}
-				}
+			if (distanceSquared > 0.f) {
+				float distance = std::sqrt(distanceSquared);
+				return CircleAABBCollision{ delta / distance, circle.radius - distance };
 			}
 
-			return NO_COLLISION;
+			// The center of the circle is inside the box : the circle is pushed out through the closest side
+			float left = circle.pos.x - bounds.min.x;
+			float right = bounds.max.x - circle.pos.x;
+			float top = circle.pos.y - bounds.min.y;
+			float bottom = bounds.max.y - circle.pos.y;
+			float closestX = std::min(left, right);
+			float closestY = std::min(top, bottom);
+
+			if (closestX < closestY) {
+				return CircleAABBCollision{ left < right ? LEFT_VEC : RIGHT_VEC, circle.radius + closestX };
+			}
+			return CircleAABBCollision{ top < bottom ? UP_VEC : DOWN_VEC, circle.radius + closestY };
 		}
 
 		SegmentsIntersection line_segments_intersection_info(const LineSegment& first, const LineSegment& other) {
@@ -284,5 +367,724 @@ namespace ch {
 				return SegmentsIntersection(IntersectionType::None);
 			}
 		}
+
+		SegmentsParametricIntersection line_segments_parametric_intersection(const LineSegment& first, const LineSegment& other) {
+			const SegmentsParametricIntersection none{ IntersectionType::None, 0.f, 0.f, 0.f, 0.f };
+			const vec_t r = first.end - first.start;
+			const vec_t s = other.end - other.start;
+			const vec_t qp = other.start - first.start;
+			const float denominator = vec_cross_product(r, s);
+
+			if (denominator != 0.f) {
+				float t = vec_cross_product(qp, s) / denominator;
+				float u = vec_cross_product(qp, r) / denominator;
+				if (t < 0.f || t > 1.f || u < 0.f || u > 1.f) {
+					return none;
+				}
+				return { IntersectionType::Crossing, t, u, t, u };
+			}
+
+			// Parallel segments (or segments reduced to a point) : they must be on the same line
+			if (vec_cross_product(qp, r) != 0.f || vec_cross_product(qp, s) != 0.f) {
+				return none;
+			}
+
+			const float rr = vec_dot_product(r, r);
+			const float ss = vec_dot_product(s, s);
+			if (rr == 0.f && ss == 0.f) {
+				return qp.x == 0.f && qp.y == 0.f ? SegmentsParametricIntersection{ IntersectionType::Crossing, 0.f, 0.f, 0.f, 0.f } : none;
+			}
+			if (rr == 0.f) {
+				float u = -vec_dot_product(qp, s) / ss;
+				return u >= 0.f && u <= 1.f ? SegmentsParametricIntersection{ IntersectionType::Crossing, 0.f, u, 0.f, u } : none;
+			}
+			if (ss == 0.f) {
+				float t = vec_dot_product(qp, r) / rr;
+				return t >= 0.f && t <= 1.f ? SegmentsParametricIntersection{ IntersectionType::Crossing, t, 0.f, t, 0.f } : none;
+			}
+
+			// Collinear : project the extremities of the other segment on the first one
+			float t0 = vec_dot_product(qp, r) / rr;
+			float t1 = t0 + vec_dot_product(s, r) / rr;
+			float tStart = std::max(std::min(t0, t1), 0.f);
+			float tEnd = std::min(std::max(t0, t1), 1.f);
+			if (tStart > tEnd) {
+				return none;
+			}
+
+			float uStart = vec_dot_product(r * tStart - qp, s) / ss;
+			if (tStart == tEnd) {
+				return { IntersectionType::Crossing, tStart, uStart, tStart, uStart };
+			}
+			float uEnd = vec_dot_product(r * tEnd - qp, s) / ss;
+			return { IntersectionType::Overlapping, tStart, uStart, tEnd, uEnd };
+		}
+
+		CircleSegmentCollision circle_segment_collision_info(const LineSegment& segment, const Circle& circle) {
+			const vec_t closest = closest_point_on_segment(segment, circle.pos);
+			const float distanceSquared = vec_magnitude_squared(circle.pos - closest);
+			if (distanceSquared >= circle.radius * circle.radius) {
+				return CircleSegmentCollision{ NULL_VEC, 0.f };
+			}
+
+			vec_t normal = vec_normalize(circle.pos - closest);
+			if (normal == NULL_VEC) {
+				const vec_t e = segment.end - segment.start;
+				normal = vec_normalize(vec_t(-e.y, e.x));
+			}
+			return CircleSegmentCollision{ normal, circle.radius - std::sqrt(distanceSquared) };
+		}
+
+		bool circle_segment_time_of_impact(const Circle& circle, const vec_t& motion, const LineSegment& segment, float& time) {
+			if (circle_intersects(circle, segment)) {
+				time = 0.f;
+				return true;
+			}
+
+			const vec_t e = segment.end - segment.start;
+			const vec_t m = circle.pos - segment.start;
+			const float lengthSquared = vec_dot_product(e, e);
+			float best = std::numeric_limits<float>::infinity();
+
+			// Side of the segment : the circle touches the line at a distance of radius
+			if (lengthSquared > 0.f) {
+				vec_t normal = vec_t(-e.y, e.x) / std::sqrt(lengthSquared);
+				float side = vec_dot_product(m, normal);
+				if (side < 0.f) {
+					normal = -normal;
+					side = -side;
+				}
+				float approach = vec_dot_product(motion, normal);
+				if (approach < 0.f) {
+					float t = (side - circle.radius) / -approach;
+					float u = vec_dot_product(m + motion * t - normal * circle.radius, e) / lengthSquared;
+					if (t >= 0.f && t <= 1.f && u >= 0.f && u <= 1.f) {
+						best = t;
+					}
+				}
+			}
+
+			// Extremities of the segment : the center comes at a distance of radius from them
+			const float a = vec_dot_product(motion, motion);
+			for (const vec_t& extremity : { segment.start, segment.end }) {
+				const vec_t toCenter = circle.pos - extremity;
+				const float b = vec_dot_product(toCenter, motion);
+				const float c = vec_dot_product(toCenter, toCenter) - circle.radius * circle.radius;
+				const float discriminant = b * b - a * c;
+				if (a > 0.f && b < 0.f && discriminant >= 0.f) {
+					float t = (-b - std::sqrt(discriminant)) / a;
+					if (t <= 1.f) {
+						best = std::min(best, t);
+					}
+				}
+			}
+
+			if (best > 1.f) {
+				return false;
+			}
+			time = best;
+			return true;
+		}
+
+		CircleSweepHit circle_sweep_hit(const Circle& circle, const vec_t& motion, const LineSegment& segment, std::uint32_t index, float time) {
+			const vec_t center = circle.pos + motion * time;
+			const vec_t point = closest_point_on_segment(segment, center);
+
+			vec_t normal = vec_normalize(center - point);
+			if (normal == NULL_VEC) {
+				// The center is on the segment, push the circle back against its motion
+				const vec_t e = segment.end - segment.start;
+				normal = vec_normalize(vec_t(-e.y, e.x));
+				if (vec_dot_product(normal, motion) > 0.f) {
+					normal = -normal;
+				}
+			}
+			return CircleSweepHit{ index, time, normal, point };
+		}
+
+		bool circle_sweep(const Circle& circle, const vec_t& motion, const std::vector<LineSegment>& segments, CircleSweepHit& hit) {
+			float earliest = std::numeric_limits<float>::infinity();
+			size_t earliestIndex = segments.size();
+			for (size_t i = 0; i < segments.size(); ++i) {
+				float time;
+				if (circle_segment_time_of_impact(circle, motion, segments[i], time) && time < earliest) {
+					earliest = time;
+					earliestIndex = i;
+				}
+			}
+
+			if (earliestIndex == segments.size()) {
+				return false;
+			}
+			hit = circle_sweep_hit(circle, motion, segments[earliestIndex], static_cast<std::uint32_t>(earliestIndex), earliest);
+			return true;
+		}
+
+		/**
+		 * \brief Computes when a point moving from start to start + motion enters the bounds (slab test).
+		 *
+		 * Implementation of aabb_time_of_impact() and circle_aabb_time_of_impact(). A point moving
+		 * along a side of the bounds doesn't enter them.
+		 *
+		 * \param normal Receives the normal of the side the point enters through, pointing out of the bounds.
+		 */
+		static bool point_bounds_time_of_impact(const vec_t& start, const vec_t& motion, const Bounds& bounds, float& time, vec_t& normal) {
+			const float starts[2] = { start.x, start.y };
+			const float directions[2] = { motion.x, motion.y };
+			const float mins[2] = { bounds.min.x, bounds.min.y };
+			const float maxs[2] = { bounds.max.x, bounds.max.y };
+
+			float entry = -std::numeric_limits<float>::infinity();
+			float exit = std::numeric_limits<float>::infinity();
+			int entryAxis = -1;
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					// Parallel to the sides : the point must be strictly between them
+					if (starts[axis] <= mins[axis] || starts[axis] >= maxs[axis]) {
+						return false;
+					}
+					continue;
+				}
+
+				float t1 = (mins[axis] - starts[axis]) / directions[axis];
+				float t2 = (maxs[axis] - starts[axis]) / directions[axis];
+				if (std::min(t1, t2) > entry) {
+					entry = std::min(t1, t2);
+					entryAxis = axis;
+				}
+				exit = std::min(exit, std::max(t1, t2));
+			}
+
+			if (entryAxis < 0 || entry >= exit || entry > 1.f || exit <= 0.f) {
+				return false;
+			}
+			time = std::max(entry, 0.f);
+			normal = entryAxis == 0 ? vec_t(motion.x > 0.f ? -1.f : 1.f, 0.f) : vec_t(0.f, motion.y > 0.f ? -1.f : 1.f);
+			return true;
+		}
+
+		bool aabb_time_of_impact(const AABB& aabb, const vec_t& motion, const AABB& other, float& time, vec_t& normal) {
+			// Already overlapping (touching isn't enough, the AABBs can still move apart or along each other)
+			const AABBCollision overlap = aabb_collision_info(other, aabb);
+			if (overlap.absolutePenetrationDepthAlongNormal() > 0.f) {
+				time = 0.f;
+				normal = overlap.normal;
+				return true;
+			}
+
+			// The position of the moving AABB enters the other AABB grown by the size of the moving one (Minkowski sum)
+			return point_bounds_time_of_impact(aabb.pos, motion, Bounds(other.pos - aabb.size, other.pos + other.size), time, normal);
+		}
+
+		bool circle_aabb_time_of_impact(const Circle& circle, const vec_t& motion, const AABB& aabb, float& time, vec_t& normal) {
+			const CircleAABBCollision overlap = circle_aabb_collision_info(aabb, circle);
+			if (overlap.absoluteDepth > 0.f) {
+				time = 0.f;
+				normal = overlap.normal;
+				return true;
+			}
+
+			// The center enters the AABB grown by the radius, with rounded corners : two grown AABBs and four circles
+			const Bounds bounds(aabb);
+			const float r = circle.radius;
+			float best = std::numeric_limits<float>::infinity();
+			float t;
+			vec_t n;
+			if (point_bounds_time_of_impact(circle.pos, motion, Bounds(bounds.min.x - r, bounds.min.y, bounds.max.x + r, bounds.max.y), t, n)) {
+				best = t;
+				normal = n;
+			}
+			if (point_bounds_time_of_impact(circle.pos, motion, Bounds(bounds.min.x, bounds.min.y - r, bounds.max.x, bounds.max.y + r), t, n) && t < best) {
+				best = t;
+				normal = n;
+			}
+
+			const float a = vec_dot_product(motion, motion);
+			for (const vec_t& corner : aabb.corners()) {
+				const vec_t toCenter = circle.pos - corner;
+				const float b = vec_dot_product(toCenter, motion);
+				const float c = vec_dot_product(toCenter, toCenter) - r * r;
+				const float discriminant = b * b - a * c;
+				if (a > 0.f && b < 0.f && discriminant >= 0.f) {
+					t = std::max((-b - std::sqrt(discriminant)) / a, 0.f);
+					if (t <= 1.f && t < best) {
+						best = t;
+						normal = vec_normalize(toCenter + motion * t);
+					}
+				}
+			}
+
+			if (best > 1.f) {
+				return false;
+			}
+			time = best;
+			return true;
+		}
+
+		/**
+		 * \brief Clips the segment going from start to start + direction against the bounds.
+		 *
+		 * Implementation of every line_segment_aabb_clip() overload.
+		 *
+		 * \param inverseDirection 1 / direction on each axis. Not used along an axis where the direction is 0.
+		 */
+		static SegmentAABBClip clip_to_bounds(const vec_t& start, const vec_t& direction, const vec_t& inverseDirection, const Bounds& bounds) {
+			const float starts[2] = { start.x, start.y };
+			const float directions[2] = { direction.x, direction.y };
+			const float inverses[2] = { inverseDirection.x, inverseDirection.y };
+			const float mins[2] = { bounds.min.x, bounds.min.y };
+			const float maxs[2] = { bounds.max.x, bounds.max.y };
+
+			float entry = 0.f;
+			float exit = 1.f;
+			for (int axis = 0; axis < 2; ++axis) {
+				if (directions[axis] == 0.f) {
+					// Parallel to the sides : the segment must be between them
+					if (starts[axis] < mins[axis] || starts[axis] > maxs[axis]) {
+						return SegmentAABBClip{ false, 0.f, 0.f, LineSegment() };
+					}
+					continue;
+				}
+
+				float t1 = (mins[axis] - starts[axis]) * inverses[axis];
+				float t2 = (maxs[axis] - starts[axis]) * inverses[axis];
+				entry = std::max(entry, std::min(t1, t2));
+				exit = std::min(exit, std::max(t1, t2));
+			}
+
+			if (entry > exit) {
+				return SegmentAABBClip{ false, 0.f, 0.f, LineSegment() };
+			}
+			return SegmentAABBClip{ true, entry, exit, LineSegment(start + direction * entry, start + direction * exit) };
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const AABB& aabb) {
+			return line_segment_aabb_clip(segment, Bounds(aabb));
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const Bounds& bounds) {
+			const vec_t direction = segment.end - segment.start;
+			const vec_t inverseDirection(direction.x != 0.f ? 1.f / direction.x : 0.f, direction.y != 0.f ? 1.f / direction.y : 0.f);
+			return clip_to_bounds(segment.start, direction, inverseDirection, bounds);
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const AABB& aabb) {
+			return clip_to_bounds(segment.start(), segment.direction(), segment.inverseDirection(), Bounds(aabb));
+		}
+
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const Bounds& bounds) {
+			return clip_to_bounds(segment.start(), segment.direction(), segment.inverseDirection(), bounds);
+		}
+
+		static void project_polygon(const ConvexPolygon& polygon, const vec_t& axis, float& min, float& max) {
+			min = max = vec_dot_product(polygon.vertex(0), axis);
+			for (size_t i = 1; i < polygon.size(); ++i) {
+				float projection = vec_dot_product(polygon.vertex(i), axis);
+				min = std::min(min, projection);
+				max = std::max(max, projection);
+			}
+		}
+
+		// Returns false if the axis separates the shapes, otherwise keeps the axis if pushing the other shape along it is the shortest way so far
+		static bool sat_test_axis(const vec_t& axis, float firstMin, float firstMax, float otherMin, float otherMax, vec_t& bestNormal, float& bestDepth) {
+			float forward = firstMax - otherMin;
+			float backward = otherMax - firstMin;
+			if (forward <= 0.f || backward <= 0.f) {
+				return false;
+			}
+			float depth = std::min(forward, backward);
+			if (depth < bestDepth) {
+				bestDepth = depth;
+				bestNormal = forward < backward ? axis : -axis;
+			}
+			return true;
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& first, const ConvexPolygon& other) {
+			static const PolygonCollision NO_COLLISION = PolygonCollision{ NULL_VEC, 0.f };
+
+			if (!aabb_intersects(first.bounds(), other.bounds())) {
+				return NO_COLLISION;
+			}
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float firstMin, firstMax, otherMin, otherMax;
+
+			for (const ConvexPolygon* polygon : { &first, &other }) {
+				for (size_t i = 0; i < polygon->size(); ++i) {
+					const vec_t& axis = polygon->normal(i);
+					project_polygon(first, axis, firstMin, firstMax);
+					project_polygon(other, axis, otherMin, otherMax);
+					if (!sat_test_axis(axis, firstMin, firstMax, otherMin, otherMax, bestNormal, bestDepth)) {
+						return NO_COLLISION;
+					}
+				}
+			}
+
+			return PolygonCollision{ bestNormal, bestDepth };
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const AABB& aabb) {
+			return polygon_collision_info(polygon, Bounds(aabb));
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Bounds& bounds) {
+			static const PolygonCollision NO_COLLISION = PolygonCollision{ NULL_VEC, 0.f };
+
+			// The axes of the box come first : the polygon is projected on them with its bounds
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			const Bounds& polygonBounds = polygon.bounds();
+			if (!sat_test_axis(RIGHT_VEC, polygonBounds.min.x, polygonBounds.max.x, bounds.min.x, bounds.max.x, bestNormal, bestDepth) ||
+				!sat_test_axis(DOWN_VEC, polygonBounds.min.y, polygonBounds.max.y, bounds.min.y, bounds.max.y, bestNormal, bestDepth)) {
+				return NO_COLLISION;
+			}
+
+			const vec_t boxCenter = bounds.center();
+			const vec_t halfSize = bounds.size() / 2.f;
+			float polygonMin, polygonMax;
+
+			for (size_t i = 0; i < polygon.size(); ++i) {
+				const vec_t& axis = polygon.normal(i);
+				float center = vec_dot_product(boxCenter, axis);
+				float radius = halfSize.x * std::abs(axis.x) + halfSize.y * std::abs(axis.y);
+				project_polygon(polygon, axis, polygonMin, polygonMax);
+				if (!sat_test_axis(axis, polygonMin, polygonMax, center - radius, center + radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return PolygonCollision{ bestNormal, bestDepth };
+		}
+
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Circle& circle) {
+			static const PolygonCollision NO_COLLISION = PolygonCollision{ NULL_VEC, 0.f };
+
+			if (!aabb_intersects(polygon.bounds(), enclosingBounds(circle))) {
+				return NO_COLLISION;
+			}
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float polygonMin, polygonMax;
+
+			// The polygon normals, plus the axis going from the closest vertex to the center of the circle
+			size_t closestVertex = 0;
+			float closestDistance = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < polygon.size(); ++i) {
+				float distance = vec_magnitude_squared(circle.pos - polygon.vertex(i));
+				if (distance < closestDistance) {
+					closestDistance = distance;
+					closestVertex = i;
+				}
+
+				const vec_t& axis = polygon.normal(i);
+				float center = vec_dot_product(circle.pos, axis);
+				project_polygon(polygon, axis, polygonMin, polygonMax);
+				if (!sat_test_axis(axis, polygonMin, polygonMax, center - circle.radius, center + circle.radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			if (closestDistance > 0.f) {
+				const vec_t axis = (circle.pos - polygon.vertex(closestVertex)) / std::sqrt(closestDistance);
+				float center = vec_dot_product(circle.pos, axis);
+				project_polygon(polygon, axis, polygonMin, polygonMax);
+				if (!sat_test_axis(axis, polygonMin, polygonMax, center - circle.radius, center + circle.radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return PolygonCollision{ bestNormal, bestDepth };
+		}
+
+		bool polygon_intersects(const ConvexPolygon& first, const ConvexPolygon& other) {
+			return polygon_collision_info(first, other).absoluteDepth > 0.f;
+		}
+
+		bool polygon_intersects(const ConvexPolygon& polygon, const AABB& aabb) {
+			return polygon_collision_info(polygon, Bounds(aabb)).absoluteDepth > 0.f;
+		}
+
+		bool polygon_intersects(const ConvexPolygon& polygon, const Bounds& bounds) {
+			return polygon_collision_info(polygon, bounds).absoluteDepth > 0.f;
+		}
+
+		bool polygon_intersects(const ConvexPolygon& polygon, const Circle& circle) {
+			return polygon_collision_info(polygon, circle).absoluteDepth > 0.f;
+		}
+
+		// Projects a box given by its center, half size and axes : center +- radius
+		static void project_box(const vec_t& center, const vec_t& halfSize, const vec_t& axisX, const vec_t& axisY, const vec_t& axis, float& min, float& max) {
+			float projectedCenter = vec_dot_product(center, axis);
+			float radius = halfSize.x * std::abs(vec_dot_product(axisX, axis)) + halfSize.y * std::abs(vec_dot_product(axisY, axis));
+			min = projectedCenter - radius;
+			max = projectedCenter + radius;
+		}
+
+		static OBBCollision boxes_collision_info(const vec_t& firstCenter, const vec_t& firstHalfSize, const vec_t& firstX, const vec_t& firstY, const vec_t& otherCenter, const vec_t& otherHalfSize, const vec_t& otherX, const vec_t& otherY) {
+			static const OBBCollision NO_COLLISION = OBBCollision{ NULL_VEC, 0.f };
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float firstMin, firstMax, otherMin, otherMax;
+
+			for (const vec_t* axis : { &firstX, &firstY, &otherX, &otherY }) {
+				project_box(firstCenter, firstHalfSize, firstX, firstY, *axis, firstMin, firstMax);
+				project_box(otherCenter, otherHalfSize, otherX, otherY, *axis, otherMin, otherMax);
+				if (!sat_test_axis(*axis, firstMin, firstMax, otherMin, otherMax, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return OBBCollision{ bestNormal, bestDepth };
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const AABB& aabb) {
+			return obb_collision_info(obb, Bounds(aabb));
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const Bounds& bounds) {
+			return boxes_collision_info(obb.center(), obb.halfSize(), obb.axisX(), obb.axisY(), bounds.center(), bounds.size() / 2.f, RIGHT_VEC, DOWN_VEC);
+		}
+
+		OBBCollision obb_collision_info(const OBB& first, const OBB& other) {
+			return boxes_collision_info(first.center(), first.halfSize(), first.axisX(), first.axisY(), other.center(), other.halfSize(), other.axisX(), other.axisY());
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const Circle& circle) {
+			const vec_t& halfSize = obb.halfSize();
+			CircleAABBCollision local = circle_aabb_collision_info(Bounds(-halfSize, halfSize), Circle(obb.toLocal(circle.pos), circle.radius));
+			return OBBCollision{ obb.axisX() * local.normal.x + obb.axisY() * local.normal.y, local.absoluteDepth };
+		}
+
+		OBBCollision obb_collision_info(const OBB& obb, const LineSegment& segment) {
+			static const OBBCollision NO_COLLISION = OBBCollision{ NULL_VEC, 0.f };
+
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			float boxMin, boxMax;
+
+			const vec_t direction = segment.end - segment.start;
+			const vec_t segmentNormal = direction == NULL_VEC ? NULL_VEC : vec_normalize(vec_t(-direction.y, direction.x));
+
+			for (const vec_t* axis : { &obb.axisX(), &obb.axisY(), &segmentNormal }) {
+				if (*axis == NULL_VEC) {
+					continue;
+				}
+				float start = vec_dot_product(segment.start, *axis);
+				float end = vec_dot_product(segment.end, *axis);
+				project_box(obb.center(), obb.halfSize(), obb.axisX(), obb.axisY(), *axis, boxMin, boxMax);
+				if (!sat_test_axis(*axis, boxMin, boxMax, std::min(start, end), std::max(start, end), bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return OBBCollision{ bestNormal, bestDepth };
+		}
+
+		bool obb_intersects(const OBB& obb, const AABB& aabb) {
+			return obb_collision_info(obb, Bounds(aabb)).absoluteDepth > 0.f;
+		}
+
+		bool obb_intersects(const OBB& obb, const Bounds& bounds) {
+			return obb_collision_info(obb, bounds).absoluteDepth > 0.f;
+		}
+
+		bool obb_intersects(const OBB& first, const OBB& other) {
+			return obb_collision_info(first, other).absoluteDepth > 0.f;
+		}
+
+		bool obb_intersects(const OBB& obb, const Circle& circle) {
+			const vec_t local = obb.toLocal(circle.pos);
+			float dx = std::max(std::abs(local.x) - obb.halfSize().x, 0.f);
+			float dy = std::max(std::abs(local.y) - obb.halfSize().y, 0.f);
+			return dx * dx + dy * dy < circle.radius * circle.radius;
+		}
+
+		bool obb_intersects(const OBB& obb, const LineSegment& segment) {
+			return obb_collision_info(obb, segment).absoluteDepth > 0.f;
+		}
+
+		void closest_points_between_segments(const LineSegment& first, const LineSegment& other, vec_t& onFirst, vec_t& onOther) {
+			// From "Real-Time Collision Detection" by Christer Ericson (section 5.1.9)
+			const vec_t d1 = first.end - first.start;
+			const vec_t d2 = other.end - other.start;
+			const vec_t r = first.start - other.start;
+			const float a = vec_dot_product(d1, d1);
+			const float e = vec_dot_product(d2, d2);
+			const float f = vec_dot_product(d2, r);
+
+			float s = 0.f;
+			float t = 0.f;
+			if (a == 0.f && e == 0.f) {
+				// Both segments are points
+			}
+			else if (a == 0.f) {
+				t = std::min(std::max(f / e, 0.f), 1.f);
+			}
+			else {
+				const float c = vec_dot_product(d1, r);
+				if (e == 0.f) {
+					s = std::min(std::max(-c / a, 0.f), 1.f);
+				}
+				else {
+					const float b = vec_dot_product(d1, d2);
+					const float denominator = a * e - b * b;
+					s = denominator != 0.f ? std::min(std::max((b * f - c * e) / denominator, 0.f), 1.f) : 0.f;
+					t = (b * s + f) / e;
+					if (t < 0.f) {
+						t = 0.f;
+						s = std::min(std::max(-c / a, 0.f), 1.f);
+					}
+					else if (t > 1.f) {
+						t = 1.f;
+						s = std::min(std::max((b - c) / a, 0.f), 1.f);
+					}
+				}
+			}
+
+			onFirst = first.start + d1 * s;
+			onOther = other.start + d2 * t;
+		}
+
+		// Collision between the segment of a capsule and another shape (a segment, or a point), from their closest points
+		static CapsuleCollision capsule_contact(const LineSegment& segment, const vec_t& onSegment, const LineSegment& other, const vec_t& onOther, float radius) {
+			const vec_t delta = onOther - onSegment;
+			const float distanceSquared = vec_magnitude_squared(delta);
+			if (distanceSquared >= radius * radius) {
+				return CapsuleCollision{ NULL_VEC, 0.f };
+			}
+
+			// Closest points of crossing segments are only equal up to rounding : the crossing is tested exactly
+			if (distanceSquared > 0.f && line_segments_parametric_intersection(segment, other).type == IntersectionType::None) {
+				float distance = std::sqrt(distanceSquared);
+				return CapsuleCollision{ delta / distance, radius - distance };
+			}
+
+			// The segments cross : separating axis theorem on their normals, the segment of the capsule being widened by the radius
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			const vec_t direction = segment.end - segment.start;
+			const vec_t otherDirection = other.end - other.start;
+			for (const vec_t& axis : { vec_normalize(vec_t(-direction.y, direction.x)), vec_normalize(vec_t(-otherDirection.y, otherDirection.x)) }) {
+				if (axis == NULL_VEC) {
+					continue;
+				}
+				float start = vec_dot_product(segment.start, axis);
+				float end = vec_dot_product(segment.end, axis);
+				float otherStart = vec_dot_product(other.start, axis);
+				float otherEnd = vec_dot_product(other.end, axis);
+				sat_test_axis(axis, std::min(start, end) - radius, std::max(start, end) + radius, std::min(otherStart, otherEnd), std::max(otherStart, otherEnd), bestNormal, bestDepth);
+			}
+			if (bestNormal == NULL_VEC) {
+				return CapsuleCollision{ UP_VEC, radius };
+			}
+			return CapsuleCollision{ bestNormal, bestDepth };
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& first, const Capsule& other) {
+			vec_t onFirst, onOther;
+			closest_points_between_segments(first.segment, other.segment, onFirst, onOther);
+			return capsule_contact(first.segment, onFirst, other.segment, onOther, first.radius + other.radius);
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Circle& circle) {
+			const vec_t onSegment = closest_point_on_segment(capsule.segment, circle.pos);
+			return capsule_contact(capsule.segment, onSegment, LineSegment(circle.pos, circle.pos), circle.pos, capsule.radius + circle.radius);
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const LineSegment& segment) {
+			vec_t onCapsule, onSegment;
+			closest_points_between_segments(capsule.segment, segment, onCapsule, onSegment);
+			return capsule_contact(capsule.segment, onCapsule, segment, onSegment, capsule.radius);
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const AABB& aabb) {
+			return capsule_collision_info(capsule, Bounds(aabb));
+		}
+
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Bounds& bounds) {
+			static const CapsuleCollision NO_COLLISION = CapsuleCollision{ NULL_VEC, 0.f };
+
+			if (!aabb_intersects(capsule.bounds(), bounds)) {
+				return NO_COLLISION;
+			}
+
+			const LineSegment& segment = capsule.segment;
+			if (!line_segment_aabb_clip(segment, bounds).intersects) {
+				// The closest points of a segment and a box that don't touch are on an extremity of the segment or on a corner of the box
+				vec_t onSegment = segment.start;
+				vec_t onBox = closest_point_on_aabb(bounds, segment.start);
+				float closest = vec_magnitude_squared(onBox - onSegment);
+
+				const vec_t endOnBox = closest_point_on_aabb(bounds, segment.end);
+				if (vec_magnitude_squared(endOnBox - segment.end) < closest) {
+					onSegment = segment.end;
+					onBox = endOnBox;
+					closest = vec_magnitude_squared(endOnBox - segment.end);
+				}
+				for (const vec_t& corner : { bounds.min, vec_t(bounds.max.x, bounds.min.y), vec_t(bounds.min.x, bounds.max.y), bounds.max }) {
+					const vec_t cornerOnSegment = closest_point_on_segment(segment, corner);
+					float distance = vec_magnitude_squared(corner - cornerOnSegment);
+					if (distance < closest) {
+						onSegment = cornerOnSegment;
+						onBox = corner;
+						closest = distance;
+					}
+				}
+				return capsule_contact(segment, onSegment, LineSegment(onBox, onBox), onBox, capsule.radius);
+			}
+
+			// The segment crosses the box : separating axis theorem on the axes of the box and the normal of the segment
+			vec_t bestNormal = NULL_VEC;
+			float bestDepth = std::numeric_limits<float>::max();
+			const vec_t direction = segment.end - segment.start;
+			const vec_t segmentNormal = vec_normalize(vec_t(-direction.y, direction.x));
+			const vec_t boxCenter = bounds.center();
+			const vec_t halfSize = bounds.size() / 2.f;
+
+			for (const vec_t& axis : { RIGHT_VEC, DOWN_VEC, segmentNormal }) {
+				if (axis == NULL_VEC) {
+					continue;
+				}
+				float start = vec_dot_product(segment.start, axis);
+				float end = vec_dot_product(segment.end, axis);
+				float center = vec_dot_product(boxCenter, axis);
+				float radius = halfSize.x * std::abs(axis.x) + halfSize.y * std::abs(axis.y);
+				if (!sat_test_axis(axis, std::min(start, end) - capsule.radius, std::max(start, end) + capsule.radius, center - radius, center + radius, bestNormal, bestDepth)) {
+					return NO_COLLISION;
+				}
+			}
+
+			return CapsuleCollision{ bestNormal, bestDepth };
+		}
+
+		bool capsule_intersects(const Capsule& first, const Capsule& other) {
+			vec_t onFirst, onOther;
+			closest_points_between_segments(first.segment, other.segment, onFirst, onOther);
+			float radii = first.radius + other.radius;
+			return vec_magnitude_squared(onOther - onFirst) < radii * radii;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const Circle& circle) {
+			float radii = capsule.radius + circle.radius;
+			return vec_magnitude_squared(circle.pos - closest_point_on_segment(capsule.segment, circle.pos)) < radii * radii;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const LineSegment& segment) {
+			vec_t onCapsule, onSegment;
+			closest_points_between_segments(capsule.segment, segment, onCapsule, onSegment);
+			return vec_magnitude_squared(onSegment - onCapsule) < capsule.radius * capsule.radius;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const AABB& aabb) {
+			return capsule_collision_info(capsule, Bounds(aabb)).absoluteDepth > 0.f;
+		}
+
+		bool capsule_intersects(const Capsule& capsule, const Bounds& bounds) {
+			return capsule_collision_info(capsule, bounds).absoluteDepth > 0.f;
+		}
 	}
 }
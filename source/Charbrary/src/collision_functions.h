@@ -1,11 +1,25 @@
 #pragma once
 
 #include "AABB.h"
+#include "Bounds.h"
 #include "Circle.h"
 #include "AABBCollision.h"
 #include "CirclesCollision.h"
 #include "CircleAABBCollision.h"
 #include "LineSegment.h"
+#include "PreparedSegment.h"
+#include "SegmentsParametricIntersection.h"
+#include "CircleSegmentCollision.h"
+#include "CircleSweepHit.h"
+#include "SegmentAABBClip.h"
+#include "ConvexPolygon.h"
+#include "PolygonCollision.h"
+#include "OBB.h"
+#include "OBBCollision.h"
+#include "Capsule.h"
+#include "CapsuleCollision.h"
+
+#include <vector>
 
 namespace ch {
 
@@ -26,16 +40,31 @@ namespace ch {
 
 		/** \return An AABB contained in the given circle. */
 		AABB inscribedAABB(const Circle& circle);
+
+		/** \return The bounds of the given circle. */
+		Bounds enclosingBounds(const Circle& circle);
+
+		/** \return The smallest bounds that contain both points of the segment. */
+		Bounds enclosingBounds(const LineSegment& lineSegment);
 			
 		/** \returns True if the given point is inside the AABB, false otherwise. */
 		bool aabb_contains(const AABB& aabb, const vec_t& point);
 
+		/** \returns True if the given point is inside the bounds, false otherwise. */
+		bool aabb_contains(const Bounds& bounds, const vec_t& point);
+
 		/** \returns True if the first AABB contains the other AABB, false otherwise. */
 		bool aabb_contains(const AABB& first, const AABB& other);
 
+		/** \returns True if the first bounds contain the other bounds, false otherwise. */
+		bool aabb_contains(const Bounds& first, const Bounds& other);
+
 		/** \returns True if the AABB contains the circle, false otherwise. */
 		bool aabb_contains(const AABB& aabb, const Circle& circle);
 
+		/** \returns True if the bounds contain the circle, false otherwise. */
+		bool aabb_contains(const Bounds& bounds, const Circle& circle);
+
 		/** \returns True if the circle contains the point, false otherwise. */
 		bool circle_contains(const Circle& circle, const vec_t& point);
 
@@ -45,18 +74,60 @@ namespace ch {
 		/** \returns True if the circle contains the AABB, false otherwise. */
 		bool circle_contains(const Circle& circle, const AABB& aabb);
 
+		/** \returns True if the circle contains the bounds, false otherwise. */
+		bool circle_contains(const Circle& circle, const Bounds& bounds);
+
 		/** \returns True if the given AABBs intersect, false otherwise. */
 		bool aabb_intersects(const AABB& a, const AABB& b);
 
+		/** \returns True if the given bounds intersect, false otherwise. */
+		bool aabb_intersects(const Bounds& a, const Bounds& b);
+
 		/** \returns True if the AABB and the circle intersect, false otherwise. */
 		bool aabb_intersects(const AABB& aabb, const Circle& circle);
 
+		/** \returns True if the bounds and the circle intersect, false otherwise. */
+		bool aabb_intersects(const Bounds& bounds, const Circle& circle);
+
+		/** \returns True if the line segment crosses or touches the AABB, false otherwise. */
+		bool aabb_intersects(const AABB& aabb, const LineSegment& segment);
+
+		/** \returns True if the line segment crosses or touches the bounds, false otherwise. */
+		bool aabb_intersects(const Bounds& bounds, const LineSegment& segment);
+
+		/** \returns True if the prepared segment crosses or touches the AABB, false otherwise. */
+		bool aabb_intersects(const AABB& aabb, const PreparedSegment& segment);
+
+		/** \returns True if the prepared segment crosses or touches the bounds, false otherwise. */
+		bool aabb_intersects(const Bounds& bounds, const PreparedSegment& segment);
+
 		/** \returns True if the circles intersect, false otherwise. */
 		bool circle_intersects(const Circle& circle, const Circle& other);
 
 		/** \returns True if the Circle and the AABB intersect, false otherwise. */
 		bool circle_intersects(const Circle& circle, const AABB& aabb);
 
+		/** \returns True if the circle and the bounds intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const Bounds& bounds);
+
+		/** \returns True if the circle and the line segment intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const LineSegment& segment);
+
+		/** \returns True if the circle and the prepared segment intersect, false otherwise. */
+		bool circle_intersects(const Circle& circle, const PreparedSegment& segment);
+
+		/** \returns The point of the segment that is the closest to the given point. */
+		vec_t closest_point_on_segment(const LineSegment& segment, const vec_t& point);
+
+		/** \returns The point of the prepared segment that is the closest to the given point. */
+		vec_t closest_point_on_segment(const PreparedSegment& segment, const vec_t& point);
+
+		/** \returns The point of the AABB that is the closest to the given point (the point itself if it is inside the AABB). */
+		vec_t closest_point_on_aabb(const AABB& aabb, const vec_t& point);
+
+		/** \returns The point of the bounds that is the closest to the given point. */
+		vec_t closest_point_on_aabb(const Bounds& bounds, const vec_t& point);
+
 		/** \returns The distance separating two circles (negative if overlapping) */
 		float circles_distance(const Circle& a, const Circle& b);
 
@@ -71,6 +142,9 @@ namespace ch {
 		 */
 		AABBCollision aabb_collision_info(const AABB& first, const AABB& other);
 
+		/** \brief Same as aabb_collision_info(const AABB&, const AABB&), for bounds. */
+		AABBCollision aabb_collision_info(const Bounds& first, const Bounds& other);
+
 		/**
 		 * \brief Checks if the first circle collides with the other one.
 		 *
@@ -89,10 +163,16 @@ namespace ch {
 		 * The collision normal is the direction (a unit vector) towards which the *circle* needs to be pushed in order to resolve the collision.
 		 * The collision normal will be set to a null vector (0,0) if there is no collision.
 		 *
+		 * The normal goes from the point of the AABB closest to the center of the circle towards the center. If the center
+		 * is inside the AABB, the circle is pushed out through the closest side.
+		 *
 		 * \returns A CircleAABBCollision object containing information about the collision.
 		 */
 		CircleAABBCollision circle_aabb_collision_info(const AABB& aabb, const Circle& circle);
 
+		/** \brief Same as circle_aabb_collision_info(const AABB&, const Circle&), for bounds. */
+		CircleAABBCollision circle_aabb_collision_info(const Bounds& bounds, const Circle& circle);
+
 		/**
 		 * \brief Checks if the given line segments are intersecting.
 		 *
@@ -105,6 +185,244 @@ namespace ch {
 		 * \return A SegmentsIntersection giving information about the intersection.
 		 */
 		SegmentsIntersection line_segments_intersection_info(const LineSegment& first, const LineSegment& other);
+
+		/**
+		 * \brief Computes the intersection of 2 line segments as positions along the segments.
+		 *
+		 * Unlike line_segments_intersection_info(), this method uses cross products instead of
+		 * slopes : there are no special cases for vertical segments and no divisions before the
+		 * segments are known to be non-parallel. Segments that touch at a single point (including
+		 * collinear segments sharing an extremity) are crossing. A segment reduced to a point
+		 * crosses the other segment if the point is located on it.
+		 *
+		 * \note See the SegmentsParametricIntersection struct to learn how to interpret the
+		 * 		 result of this method.
+		 *
+		 * \return A SegmentsParametricIntersection giving information about the intersection.
+		 */
+		SegmentsParametricIntersection line_segments_parametric_intersection(const LineSegment& first, const LineSegment& other);
+
+		/**
+		 * \brief Checks if a line segment and a circle collide with each other.
+		 *
+		 * In case of a collision, this function returns an instance of CircleSegmentCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the *circle* needs to be pushed in order to resolve the collision.
+		 * If the center of the circle is on the segment, the circle is pushed perpendicularly to the segment.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 *
+		 * \returns A CircleSegmentCollision object containing information about the collision.
+		 */
+		CircleSegmentCollision circle_segment_collision_info(const LineSegment& segment, const Circle& circle);
+
+		/**
+		 * \brief Computes when a moving circle hits a line segment.
+		 *
+		 * The circle moves from circle.pos to circle.pos + motion. If the circle already
+		 * intersects the segment before moving, the time of impact is 0.
+		 *
+		 * \param time Receives the time of impact, between 0 and 1.
+		 * \return True if the circle hits the segment during the motion, false otherwise.
+		 */
+		bool circle_segment_time_of_impact(const Circle& circle, const vec_t& motion, const LineSegment& segment, float& time);
+
+		/**
+		 * \brief Computes when a moving AABB hits another AABB.
+		 *
+		 * The AABB moves from aabb.pos to aabb.pos + motion. If the AABBs already overlap
+		 * before moving, the time of impact is 0 and the normal is the one of aabb_collision_info(other, aabb).
+		 * An AABB touching the other one only hits it if it moves towards it : it can slide along its side.
+		 *
+		 * \param time Receives the time of impact, between 0 and 1.
+		 * \param normal Receives the direction towards which the moving AABB is pushed by the other one (unit vector).
+		 * \return True if the moving AABB hits the other one during the motion, false otherwise.
+		 */
+		bool aabb_time_of_impact(const AABB& aabb, const vec_t& motion, const AABB& other, float& time, vec_t& normal);
+
+		/**
+		 * \brief Computes when a moving circle hits an AABB.
+		 *
+		 * The circle moves from circle.pos to circle.pos + motion. If the circle already overlaps
+		 * the AABB before moving, the time of impact is 0 and the normal is the one of circle_aabb_collision_info(aabb, circle).
+		 * The circle hits either a side of the AABB or one of its rounded corners.
+		 *
+		 * \param time Receives the time of impact, between 0 and 1.
+		 * \param normal Receives the direction towards which the circle is pushed by the AABB (unit vector).
+		 * \return True if the circle hits the AABB during the motion, false otherwise.
+		 */
+		bool circle_aabb_time_of_impact(const Circle& circle, const vec_t& motion, const AABB& aabb, float& time, vec_t& normal);
+
+		/**
+		 * \brief Finds the first line segment hit by a moving circle.
+		 *
+		 * The circle moves from circle.pos to circle.pos + motion. Use the batched version
+		 * (circle_sweep_batch()) for large segment arrays.
+		 *
+		 * \param hit Receives the index of the segment, the time of impact, the normal and the contact point.
+		 * \return True if a segment was hit, false otherwise (hit is left untouched).
+		 */
+		bool circle_sweep(const Circle& circle, const vec_t& motion, const std::vector<LineSegment>& segments, CircleSweepHit& hit);
+
+		/**
+		 * \brief Computes the contact information of a moving circle that hits a segment at the given time.
+		 * \return The hit, with the given index and time.
+		 */
+		CircleSweepHit circle_sweep_hit(const Circle& circle, const vec_t& motion, const LineSegment& segment, std::uint32_t index, float time);
+
+		/**
+		 * \brief Clips a line segment against an AABB (Liang-Barsky algorithm).
+		 *
+		 * The segment is tested directly against the 2 pairs of parallel sides of the AABB
+		 * instead of being intersected with each side. A segment that only touches the AABB
+		 * intersects it.
+		 *
+		 * \note See the SegmentAABBClip struct to learn how to interpret the result of this method.
+		 *
+		 * \returns A SegmentAABBClip containing the entry and exit positions and the clipped segment.
+		 */
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const AABB& aabb);
+
+		/** \brief Same as line_segment_aabb_clip(const LineSegment&, const AABB&), for bounds. */
+		SegmentAABBClip line_segment_aabb_clip(const LineSegment& segment, const Bounds& bounds);
+
+		/** \brief Same as line_segment_aabb_clip(const LineSegment&, const AABB&), without recomputing the inverse direction of the segment. */
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const AABB& aabb);
+
+		/** \brief Same as line_segment_aabb_clip(const LineSegment&, const AABB&), for a prepared segment and bounds. */
+		SegmentAABBClip line_segment_aabb_clip(const PreparedSegment& segment, const Bounds& bounds);
+
+		/**
+		 * \brief Checks if two convex polygons collide with each other (separating axis theorem).
+		 *
+		 * In case of a collision, this function returns an instance of PolygonCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision. Polygons that only touch do not collide.
+		 *
+		 * The bounds of the polygons are compared first, so distant polygons are rejected without projecting them.
+		 *
+		 * \returns A PolygonCollision object containing information about the collision.
+		 */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& first, const ConvexPolygon& other);
+
+		/** \brief Same as polygon_collision_info(const ConvexPolygon&, const ConvexPolygon&), against an AABB. */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const AABB& aabb);
+
+		/** \brief Same as polygon_collision_info(const ConvexPolygon&, const ConvexPolygon&), against bounds. */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Bounds& bounds);
+
+		/** \brief Same as polygon_collision_info(const ConvexPolygon&, const ConvexPolygon&), against a circle. */
+		PolygonCollision polygon_collision_info(const ConvexPolygon& polygon, const Circle& circle);
+
+		/** \returns True if the polygons collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& first, const ConvexPolygon& other);
+
+		/** \returns True if the polygon and the AABB collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& polygon, const AABB& aabb);
+
+		/** \returns True if the polygon and the bounds collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& polygon, const Bounds& bounds);
+
+		/** \returns True if the polygon and the circle collide (see polygon_collision_info()). */
+		bool polygon_intersects(const ConvexPolygon& polygon, const Circle& circle);
+
+		/**
+		 * \brief Checks if an OBB collides with an AABB (separating axis theorem on the 4 axes of the boxes).
+		 *
+		 * In case of a collision, this function returns an instance of OBBCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision. Shapes that only touch do not collide.
+		 *
+		 * \returns An OBBCollision object containing information about the collision.
+		 */
+		OBBCollision obb_collision_info(const OBB& obb, const AABB& aabb);
+
+		/** \brief Same as obb_collision_info(const OBB&, const AABB&), against bounds. */
+		OBBCollision obb_collision_info(const OBB& obb, const Bounds& bounds);
+
+		/** \brief Same as obb_collision_info(const OBB&, const AABB&), against another OBB. */
+		OBBCollision obb_collision_info(const OBB& first, const OBB& other);
+
+		/**
+		 * \brief Same as obb_collision_info(const OBB&, const AABB&), against a circle.
+		 *
+		 * The circle is moved into the coordinates of the box and tested like with circle_aabb_collision_info().
+		 */
+		OBBCollision obb_collision_info(const OBB& obb, const Circle& circle);
+
+		/** \brief Same as obb_collision_info(const OBB&, const AABB&), against a line segment (the normal of the segment is the third axis). */
+		OBBCollision obb_collision_info(const OBB& obb, const LineSegment& segment);
+
+		/** \returns True if the OBB and the AABB collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const AABB& aabb);
+
+		/** \returns True if the OBB and the bounds collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const Bounds& bounds);
+
+		/** \returns True if the OBBs collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& first, const OBB& other);
+
+		/** \returns True if the OBB and the circle collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const Circle& circle);
+
+		/** \returns True if the OBB and the line segment collide (see obb_collision_info()). */
+		bool obb_intersects(const OBB& obb, const LineSegment& segment);
+
+		/**
+		 * \brief Finds the closest points between two line segments.
+		 *
+		 * If the segments cross, both points are at the intersection. If they are parallel, one
+		 * of the pairs of closest points is returned.
+		 *
+		 * \param onFirst Receives the point of the first segment closest to the other segment.
+		 * \param onOther Receives the point of the other segment closest to the first segment.
+		 */
+		void closest_points_between_segments(const LineSegment& first, const LineSegment& other, vec_t& onFirst, vec_t& onOther);
+
+		/**
+		 * \brief Checks if two capsules collide with each other.
+		 *
+		 * In case of a collision, this function returns an instance of CapsuleCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision. Shapes that only touch do not collide.
+		 *
+		 * The normal goes from the closest point of the segment of the capsule to the closest point of the other shape. If the
+		 * segments cross, the collision is found with the separating axis theorem on the normals of both segments : the other
+		 * shape is pushed until it's far enough from the line of the segment of the capsule, or its line far enough from the
+		 * segment of the capsule, whichever is shorter.
+		 *
+		 * \returns A CapsuleCollision object containing information about the collision.
+		 */
+		CapsuleCollision capsule_collision_info(const Capsule& first, const Capsule& other);
+
+		/** \brief Same as capsule_collision_info(const Capsule&, const Capsule&), against a circle. */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Circle& circle);
+
+		/** \brief Same as capsule_collision_info(const Capsule&, const Capsule&), against a line segment. */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const LineSegment& segment);
+
+		/**
+		 * \brief Same as capsule_collision_info(const Capsule&, const Capsule&), against an AABB.
+		 *
+		 * If the segment of the capsule crosses the AABB, the collision is found with the separating axis
+		 * theorem on the axes of the AABB and the normal of the segment.
+		 */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const AABB& aabb);
+
+		/** \brief Same as capsule_collision_info(const Capsule&, const AABB&), against bounds. */
+		CapsuleCollision capsule_collision_info(const Capsule& capsule, const Bounds& bounds);
+
+		/** \returns True if the capsules collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& first, const Capsule& other);
+
+		/** \returns True if the capsule and the circle collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const Circle& circle);
+
+		/** \returns True if the capsule and the line segment collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const LineSegment& segment);
+
+		/** \returns True if the capsule and the AABB collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const AABB& aabb);
+
+		/** \returns True if the capsule and the bounds collide (see capsule_collision_info()). */
+		bool capsule_intersects(const Capsule& capsule, const Bounds& bounds);
 	}
 }
-
@@ -0,0 +1,160 @@
+#include "cpu_features.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+#if defined(CH_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(CH_SIMD_X86)
+#include <cpuid.h>
+#endif
+
+namespace ch {
+	namespace simd {
+
+		constexpr const char* SIMD_ENVIRONMENT_VARIABLE = "CHARBRARY_SIMD";
+
+		constexpr std::array<const char*, static_cast<size_t>(SimdLevel::MAX_VALUE)> SIMD_LEVEL_NAMES =
+		{
+			"scalar",
+			"sse2",
+			"avx2",
+			"avx512"
+		};
+
+#ifdef CH_SIMD_X86
+		/**
+		 * \brief Executes the CPUID instruction for the given leaf (and sub-leaf 0).
+		 */
+		static std::array<unsigned int, 4> cpuid(unsigned int leaf) {
+			std::array<unsigned int, 4> registers = { 0, 0, 0, 0 };
+#ifdef _MSC_VER
+			int values[4];
+			__cpuidex(values, static_cast<int>(leaf), 0);
+			for (size_t i = 0; i < registers.size(); ++i) {
+				registers[i] = static_cast<unsigned int>(values[i]);
+			}
+#else
+			if (leaf > __get_cpuid_max(0, nullptr)) {
+				return registers;
+			}
+			__cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+#endif
+			return registers;
+		}
+
+		/**
+		 * \brief Reads the XCR0 register, which tells which vector registers are saved by the operating system.
+		 */
+		static unsigned long long read_xcr0() {
+#ifdef _MSC_VER
+			return _xgetbv(0);
+#else
+			unsigned int eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+		}
+
+		static SimdLevel query_cpu_simd_level() {
+			constexpr unsigned int SSE2_BIT = 1u << 26; // leaf 1, EDX
+			constexpr unsigned int OSXSAVE_BIT = 1u << 27; // leaf 1, ECX
+			constexpr unsigned int AVX_BIT = 1u << 28; // leaf 1, ECX
+			constexpr unsigned int AVX2_BIT = 1u << 5; // leaf 7, EBX
+			constexpr unsigned int AVX512F_BIT = 1u << 16; // leaf 7, EBX
+			constexpr unsigned long long XCR0_AVX_STATE = 0x6; // XMM + YMM
+			constexpr unsigned long long XCR0_AVX512_STATE = 0xE6; // XMM + YMM + opmask + ZMM
+
+			auto leaf1 = cpuid(1);
+			if (!(leaf1[3] & SSE2_BIT)) {
+				return SimdLevel::Scalar;
+			}
+
+			if (!(leaf1[2] & OSXSAVE_BIT) || !(leaf1[2] & AVX_BIT)) {
+				return SimdLevel::SSE2;
+			}
+
+			unsigned long long xcr0 = read_xcr0();
+			if ((xcr0 & XCR0_AVX_STATE) != XCR0_AVX_STATE) {
+				return SimdLevel::SSE2;
+			}
+
+			auto leaf7 = cpuid(7);
+			if (!(leaf7[1] & AVX2_BIT)) {
+				return SimdLevel::SSE2;
+			}
+
+			if ((leaf7[1] & AVX512F_BIT) && (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE) {
+				return SimdLevel::AVX512;
+			}
+
+			return SimdLevel::AVX2;
+		}
+#else
+		static SimdLevel query_cpu_simd_level() {
+			return SimdLevel::Scalar;
+		}
+#endif
+
+		/**
+		 * \brief Reads the CHARBRARY_SIMD environment variable. Returns an empty string if it is not set.
+		 */
+		static std::string read_simd_environment_variable() {
+#ifdef _MSC_VER
+			char* buffer = nullptr;
+			size_t length = 0;
+			std::string value;
+			if (_dupenv_s(&buffer, &length, SIMD_ENVIRONMENT_VARIABLE) == 0 && buffer != nullptr) {
+				value = buffer;
+			}
+			std::free(buffer);
+			return value;
+#else
+			const char* value = std::getenv(SIMD_ENVIRONMENT_VARIABLE);
+			return value != nullptr ? value : "";
+#endif
+		}
+
+		static SimdLevel startup_simd_level() {
+			std::string requested = read_simd_environment_variable();
+			for (size_t i = 0; i < SIMD_LEVEL_NAMES.size(); ++i) {
+				if (requested == SIMD_LEVEL_NAMES[i]) {
+					auto level = static_cast<SimdLevel>(i);
+					return level < detected_simd_level() ? level : detected_simd_level();
+				}
+			}
+			return detected_simd_level();
+		}
+
+		/**
+		 * \brief Returns a reference to the tier currently used by the kernels.
+		 */
+		static std::atomic<SimdLevel>& current_simd_level() {
+			static std::atomic<SimdLevel> level{ startup_simd_level() };
+			return level;
+		}
+
+		SimdLevel detected_simd_level() {
+			static const SimdLevel level = query_cpu_simd_level();
+			return level;
+		}
+
+		SimdLevel active_simd_level() {
+			return current_simd_level().load(std::memory_order_relaxed);
+		}
+
+		SimdLevel set_simd_level(SimdLevel level) {
+			if (level > detected_simd_level()) {
+				level = detected_simd_level();
+			}
+			current_simd_level().store(level, std::memory_order_relaxed);
+			return level;
+		}
+
+		const char* simd_level_name(SimdLevel level) {
+			return level < SimdLevel::MAX_VALUE ? SIMD_LEVEL_NAMES[static_cast<size_t>(level)] : "unknown";
+		}
+	}
+}
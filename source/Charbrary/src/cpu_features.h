@@ -0,0 +1,63 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CH_SIMD_X86 1
+#endif
+
+// GCC and Clang only emit SSE/AVX instructions inside functions marked with the matching target.
+// MSVC accepts the intrinsics anywhere, so the attribute is simply dropped.
+#if defined(__GNUC__) || defined(__clang__)
+#define CH_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CH_SIMD_TARGET(isa)
+#endif
+
+namespace ch {
+
+	//! Contains utilities to detect the SIMD instruction sets supported by the CPU and to select the batched kernels
+	namespace simd {
+
+		/**
+		 * \brief Represents a tier of SIMD instructions.
+		 *
+		 * The tiers are ordered : a CPU supporting a tier also supports all the tiers below it.
+		 */
+		enum class SimdLevel {
+			Scalar, /**< Plain C++ code, available everywhere. */
+			SSE2, /**< 128-bit vectors (4 floats). */
+			AVX2, /**< 256-bit vectors (8 floats). */
+			AVX512, /**< 512-bit vectors (16 floats), AVX-512F. */
+			MAX_VALUE
+		};
+
+		/**
+		 * \brief Returns the highest SIMD tier supported by the CPU and the operating system.
+		 *
+		 * The CPU is only queried once, the result is cached for the lifetime of the program.
+		 */
+		SimdLevel detected_simd_level();
+
+		/**
+		 * \brief Returns the SIMD tier used by the batched kernels.
+		 *
+		 * By default, this is the detected tier. It can be lowered by setting the environment
+		 * variable CHARBRARY_SIMD to "scalar", "sse2", "avx2" or "avx512" before starting the
+		 * program, which is useful to benchmark each tier on the same machine.
+		 * A tier higher than the detected one is never selected.
+		 */
+		SimdLevel active_simd_level();
+
+		/**
+		 * \brief Changes the SIMD tier used by the batched kernels.
+		 *
+		 * \param level The requested tier. It is clamped to the detected tier.
+		 * \return The tier that is actually used from now on.
+		 */
+		SimdLevel set_simd_level(SimdLevel level);
+
+		/**
+		 * \brief Returns a readable name for the given tier ("scalar", "sse2", "avx2" or "avx512").
+		 */
+		const char* simd_level_name(SimdLevel level);
+	}
+}
@@ -0,0 +1,412 @@
+#include "gjk_functions.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace ch {
+	namespace collision {
+
+		constexpr std::uint32_t GJK_MAX_ITERATIONS = 32; /**< Maximum number of support points computed by GJK. */
+		constexpr std::uint32_t EPA_MAX_VERTICES = 32; /**< Maximum number of vertices of the EPA polytope. */
+		constexpr float GJK_TOLERANCE = 1e-5f; /**< Minimum progress along the search direction, in world units. */
+
+		vec_t support_point(const AABB& aabb, const vec_t& direction) {
+			return support_point(Bounds(aabb), direction);
+		}
+
+		vec_t support_point(const Bounds& bounds, const vec_t& direction) {
+			return vec_t(direction.x >= 0.f ? bounds.max.x : bounds.min.x, direction.y >= 0.f ? bounds.max.y : bounds.min.y);
+		}
+
+		vec_t support_point(const Circle& circle, const vec_t& direction) {
+			return circle.pos + vec_normalize(direction) * circle.radius;
+		}
+
+		vec_t support_point(const LineSegment& segment, const vec_t& direction) {
+			return vec_dot_product(segment.end - segment.start, direction) > 0.f ? segment.end : segment.start;
+		}
+
+		vec_t support_point(const ConvexPolygon& polygon, const vec_t& direction) {
+			size_t farthest = 0;
+			float farthestProjection = vec_dot_product(polygon.vertex(0), direction);
+			for (size_t i = 1; i < polygon.size(); ++i) {
+				float projection = vec_dot_product(polygon.vertex(i), direction);
+				if (projection > farthestProjection) {
+					farthestProjection = projection;
+					farthest = i;
+				}
+			}
+			return polygon.vertex(farthest);
+		}
+
+		vec_t support_point(const OBB& obb, const vec_t& direction) {
+			float x = vec_dot_product(direction, obb.axisX()) >= 0.f ? obb.halfSize().x : -obb.halfSize().x;
+			float y = vec_dot_product(direction, obb.axisY()) >= 0.f ? obb.halfSize().y : -obb.halfSize().y;
+			return obb.toWorld(vec_t(x, y));
+		}
+
+		vec_t support_point(const Capsule& capsule, const vec_t& direction) {
+			return support_point(capsule.segment, direction) + vec_normalize(direction) * capsule.radius;
+		}
+
+		/**
+		 * \brief A vertex of the Minkowski difference of the cores of two shapes.
+		 */
+		struct GJKVertex {
+			vec_t onFirst; /**< Support point of the first shape. */
+			vec_t onOther; /**< Support point of the other shape, in the opposite direction. */
+			vec_t point; /**< onFirst - onOther. */
+			vec_t direction; /**< Direction that produced the vertex. */
+		};
+
+		/**
+		 * \brief The simplex of GJK, reduced to the vertices closest to the origin by gjk_solve().
+		 */
+		struct GJKSimplex {
+			std::array<GJKVertex, 3> vertices; /**< The vertices, only the first count are used. */
+			std::array<float, 3> weights; /**< Barycentric coordinates of the point of the simplex closest to the origin. */
+			std::uint32_t count; /**< Number of vertices. */
+		};
+
+		static GJKVertex gjk_support(const SupportShape& first, const SupportShape& other, const vec_t& direction) {
+			GJKVertex vertex;
+			vertex.onFirst = first.support(direction);
+			vertex.onOther = other.support(-direction);
+			vertex.point = vertex.onFirst - vertex.onOther;
+			vertex.direction = direction;
+			return vertex;
+		}
+
+		static bool gjk_contains(const GJKSimplex& simplex, const vec_t& point) {
+			for (std::uint32_t i = 0; i < simplex.count; ++i) {
+				if (simplex.vertices[i].point == point) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Keeps the vertices of the segment closest to the origin (Voronoi regions of the segment)
+		static void gjk_solve2(GJKSimplex& simplex) {
+			const vec_t w1 = simplex.vertices[0].point;
+			const vec_t w2 = simplex.vertices[1].point;
+			const vec_t e12 = w2 - w1;
+
+			float d12_2 = -vec_dot_product(w1, e12);
+			if (d12_2 <= 0.f) {
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+				return;
+			}
+
+			float d12_1 = vec_dot_product(w2, e12);
+			if (d12_1 <= 0.f) {
+				simplex.vertices[0] = simplex.vertices[1];
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+				return;
+			}
+
+			float inverse = 1.f / (d12_1 + d12_2);
+			simplex.weights[0] = d12_1 * inverse;
+			simplex.weights[1] = d12_2 * inverse;
+		}
+
+		// Keeps the vertices of the triangle closest to the origin (Voronoi regions of the triangle)
+		static void gjk_solve3(GJKSimplex& simplex) {
+			const vec_t w1 = simplex.vertices[0].point;
+			const vec_t w2 = simplex.vertices[1].point;
+			const vec_t w3 = simplex.vertices[2].point;
+
+			const vec_t e12 = w2 - w1;
+			float d12_1 = vec_dot_product(w2, e12);
+			float d12_2 = -vec_dot_product(w1, e12);
+
+			const vec_t e13 = w3 - w1;
+			float d13_1 = vec_dot_product(w3, e13);
+			float d13_2 = -vec_dot_product(w1, e13);
+
+			const vec_t e23 = w3 - w2;
+			float d23_1 = vec_dot_product(w3, e23);
+			float d23_2 = -vec_dot_product(w2, e23);
+
+			float n123 = vec_cross_product(e12, e13);
+			float d123_1 = n123 * vec_cross_product(w2, w3);
+			float d123_2 = n123 * vec_cross_product(w3, w1);
+			float d123_3 = n123 * vec_cross_product(w1, w2);
+
+			if (d12_2 <= 0.f && d13_2 <= 0.f) {
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+			}
+			else if (d12_1 > 0.f && d12_2 > 0.f && d123_3 <= 0.f) {
+				float inverse = 1.f / (d12_1 + d12_2);
+				simplex.weights[0] = d12_1 * inverse;
+				simplex.weights[1] = d12_2 * inverse;
+				simplex.count = 2;
+			}
+			else if (d13_1 > 0.f && d13_2 > 0.f && d123_2 <= 0.f) {
+				float inverse = 1.f / (d13_1 + d13_2);
+				simplex.weights[0] = d13_1 * inverse;
+				simplex.weights[1] = d13_2 * inverse;
+				simplex.vertices[1] = simplex.vertices[2];
+				simplex.count = 2;
+			}
+			else if (d12_1 <= 0.f && d23_2 <= 0.f) {
+				simplex.vertices[0] = simplex.vertices[1];
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+			}
+			else if (d13_1 <= 0.f && d23_1 <= 0.f) {
+				simplex.vertices[0] = simplex.vertices[2];
+				simplex.weights[0] = 1.f;
+				simplex.count = 1;
+			}
+			else if (d23_1 > 0.f && d23_2 > 0.f && d123_1 <= 0.f) {
+				float inverse = 1.f / (d23_1 + d23_2);
+				simplex.vertices[0] = simplex.vertices[2];
+				simplex.weights[0] = d23_2 * inverse;
+				simplex.weights[1] = d23_1 * inverse;
+				simplex.count = 2;
+			}
+			else {
+				// The origin is inside the triangle
+				float inverse = 1.f / (d123_1 + d123_2 + d123_3);
+				simplex.weights[0] = d123_1 * inverse;
+				simplex.weights[1] = d123_2 * inverse;
+				simplex.weights[2] = d123_3 * inverse;
+			}
+		}
+
+		static void gjk_solve(GJKSimplex& simplex) {
+			if (simplex.count == 1) {
+				simplex.weights[0] = 1.f;
+			}
+			else if (simplex.count == 2) {
+				gjk_solve2(simplex);
+			}
+			else if (simplex.count == 3) {
+				gjk_solve3(simplex);
+			}
+		}
+
+		static vec_t gjk_closest_point(const GJKSimplex& simplex) {
+			vec_t closest(0.f, 0.f);
+			for (std::uint32_t i = 0; i < simplex.count; ++i) {
+				closest += simplex.vertices[i].point * simplex.weights[i];
+			}
+			return closest;
+		}
+
+		// Runs GJK on the cores of the shapes and leaves the final simplex in the given one
+		static GJKResult gjk_run(const SupportShape& first, const SupportShape& other, GJKCache* cache, GJKSimplex& simplex) {
+			simplex.count = 0;
+			if (cache != nullptr) {
+				for (std::uint32_t i = 0; i < cache->count; ++i) {
+					GJKVertex vertex = gjk_support(first, other, cache->directions[i]);
+					if (!gjk_contains(simplex, vertex.point)) {
+						simplex.vertices[simplex.count++] = vertex;
+					}
+				}
+			}
+			if (simplex.count == 0) {
+				simplex.vertices[simplex.count++] = gjk_support(first, other, RIGHT_VEC);
+			}
+
+			std::uint32_t iterations = 0;
+			gjk_solve(simplex);
+			while (simplex.count < 3 && iterations < GJK_MAX_ITERATIONS) {
+				const vec_t closest = gjk_closest_point(simplex);
+
+				// Search towards the origin, perpendicularly to the segment when there are 2 vertices
+				vec_t direction = -closest;
+				bool onSegment = false;
+				if (simplex.count == 2) {
+					const vec_t e12 = simplex.vertices[1].point - simplex.vertices[0].point;
+					float side = vec_cross_product(e12, -simplex.vertices[0].point);
+					direction = side > 0.f ? vec_t(-e12.y, e12.x) : vec_t(e12.y, -e12.x);
+					onSegment = side == 0.f;
+				}
+				if (direction == NULL_VEC) {
+					// The origin is a vertex of the Minkowski difference : the cores touch
+					break;
+				}
+
+				GJKVertex vertex = gjk_support(first, other, direction);
+				++iterations;
+				bool progress = !gjk_contains(simplex, vertex.point) && vec_dot_product(vertex.point - closest, direction) > GJK_TOLERANCE * vec_magnitude(direction);
+				if (!progress && onSegment) {
+					// The origin is on the segment : it is inside the cores unless the segment is on their boundary on both sides
+					vertex = gjk_support(first, other, -direction);
+					++iterations;
+					progress = !gjk_contains(simplex, vertex.point) && vec_dot_product(vertex.point - closest, -direction) > GJK_TOLERANCE * vec_magnitude(direction);
+				}
+				if (!progress) {
+					break;
+				}
+
+				simplex.vertices[simplex.count++] = vertex;
+				gjk_solve(simplex);
+			}
+
+			if (cache != nullptr) {
+				cache->count = simplex.count;
+				for (std::uint32_t i = 0; i < simplex.count; ++i) {
+					cache->directions[i] = simplex.vertices[i].direction;
+				}
+			}
+
+			vec_t onFirst(0.f, 0.f);
+			vec_t onOther(0.f, 0.f);
+			for (std::uint32_t i = 0; i < simplex.count; ++i) {
+				onFirst += simplex.vertices[i].onFirst * simplex.weights[i];
+				onOther += simplex.vertices[i].onOther * simplex.weights[i];
+			}
+
+			const float radii = first.radius() + other.radius();
+			if (simplex.count == 3) {
+				return GJKResult{ true, 0.f, onFirst, onOther, iterations };
+			}
+
+			float coreDistance = vec_magnitude(onOther - onFirst);
+			if (coreDistance > 0.f) {
+				const vec_t normal = (onOther - onFirst) / coreDistance;
+				onFirst += normal * first.radius();
+				onOther -= normal * other.radius();
+			}
+			return GJKResult{ coreDistance < radii, std::max(coreDistance - radii, 0.f), onFirst, onOther, iterations };
+		}
+
+		GJKResult gjk_distance(const SupportShape& first, const SupportShape& other, GJKCache* cache) {
+			GJKSimplex simplex;
+			return gjk_run(first, other, cache, simplex);
+		}
+
+		bool gjk_intersects(const SupportShape& first, const SupportShape& other, GJKCache* cache) {
+			return gjk_distance(first, other, cache).intersects;
+		}
+
+		// Expands the simplex of overlapping cores until the edge of the Minkowski difference closest to the origin is found
+		static ConvexCollision epa_collision_info(const SupportShape& first, const SupportShape& other, const GJKSimplex& simplex, float radii) {
+			std::array<GJKVertex, EPA_MAX_VERTICES> polytope;
+			std::uint32_t count = simplex.count;
+			for (std::uint32_t i = 0; i < count; ++i) {
+				polytope[i] = simplex.vertices[i];
+			}
+
+			// The cores only touch : the simplex is completed into a triangle that has the origin on its boundary
+			if (count == 1) {
+				polytope[1] = gjk_support(first, other, RIGHT_VEC);
+				if (polytope[1].point == polytope[0].point) {
+					polytope[1] = gjk_support(first, other, LEFT_VEC);
+				}
+				count = polytope[1].point == polytope[0].point ? 1 : 2;
+			}
+			if (count == 2) {
+				const vec_t e = polytope[1].point - polytope[0].point;
+				const vec_t perpendicular(-e.y, e.x);
+				polytope[2] = gjk_support(first, other, perpendicular);
+				if (vec_cross_product(e, polytope[2].point - polytope[0].point) == 0.f) {
+					polytope[2] = gjk_support(first, other, -perpendicular);
+				}
+				if (vec_cross_product(e, polytope[2].point - polytope[0].point) != 0.f) {
+					count = 3;
+				}
+			}
+			if (count < 3) {
+				// The Minkowski difference is flat (parallel segments, points) : push the other shape perpendicularly to it
+				const vec_t e = polytope[count - 1].point - polytope[0].point;
+				const vec_t normal = e == NULL_VEC ? UP_VEC : vec_normalize(vec_t(-e.y, e.x));
+				return ConvexCollision{ normal, radii };
+			}
+
+			// Counter-clockwise order : the outward normal of the edge a -> b is (e.y, -e.x)
+			if (vec_cross_product(polytope[1].point - polytope[0].point, polytope[2].point - polytope[0].point) < 0.f) {
+				std::swap(polytope[1], polytope[2]);
+			}
+
+			while (true) {
+				std::uint32_t closestEdge = 0;
+				float closestDistance = std::numeric_limits<float>::max();
+				vec_t closestNormal = NULL_VEC;
+				for (std::uint32_t i = 0; i < count; ++i) {
+					const vec_t& a = polytope[i].point;
+					const vec_t e = polytope[(i + 1) % count].point - a;
+					const float length = vec_magnitude(e);
+					if (length == 0.f) {
+						continue;
+					}
+					const vec_t normal = vec_t(e.y, -e.x) / length;
+					float distance = vec_dot_product(normal, a);
+					if (distance < closestDistance) {
+						closestDistance = distance;
+						closestEdge = i;
+						closestNormal = normal;
+					}
+				}
+
+				GJKVertex vertex = gjk_support(first, other, closestNormal);
+				if (count == EPA_MAX_VERTICES || vec_dot_product(vertex.point, closestNormal) - closestDistance <= GJK_TOLERANCE) {
+					return ConvexCollision{ closestNormal, std::max(closestDistance, 0.f) + radii };
+				}
+
+				for (std::uint32_t i = count; i > closestEdge + 1; --i) {
+					polytope[i] = polytope[i - 1];
+				}
+				polytope[closestEdge + 1] = vertex;
+				++count;
+			}
+		}
+
+		// Computes the collision of shapes that GJK found intersecting, from its final simplex
+		static ConvexCollision gjk_penetration(const SupportShape& first, const SupportShape& other, const GJKSimplex& simplex) {
+			const float radii = first.radius() + other.radius();
+			if (simplex.count < 3) {
+				// Only the radii overlap : the normal goes from the core of the first shape to the core of the other one
+				const vec_t delta = -gjk_closest_point(simplex);
+				const float coreDistance = vec_magnitude(delta);
+				if (coreDistance > 0.f) {
+					return ConvexCollision{ delta / coreDistance, radii - coreDistance };
+				}
+			}
+			return epa_collision_info(first, other, simplex, radii);
+		}
+
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, GJKCache* cache) {
+			static const ConvexCollision NO_COLLISION = ConvexCollision{ NULL_VEC, 0.f };
+
+			GJKSimplex simplex;
+			if (!gjk_run(first, other, cache, simplex).intersects) {
+				return NO_COLLISION;
+			}
+			return gjk_penetration(first, other, simplex);
+		}
+
+		bool separated_along_axis(const SupportShape& first, const SupportShape& other, const vec_t& axis) {
+			const float length = vec_magnitude(axis);
+			float firstMax = vec_dot_product(first.support(axis), axis) + first.radius() * length;
+			float otherMin = vec_dot_product(other.support(-axis), axis) - other.radius() * length;
+			return firstMax <= otherMin;
+		}
+
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, PairContact& contact) {
+			static const ConvexCollision NO_COLLISION = ConvexCollision{ NULL_VEC, 0.f };
+
+			if (contact.separatingAxis != NULL_VEC && separated_along_axis(first, other, contact.separatingAxis)) {
+				return NO_COLLISION;
+			}
+
+			GJKSimplex simplex;
+			const GJKResult result = gjk_run(first, other, &contact.gjk, simplex);
+			if (!result.intersects) {
+				// The vector between the closest points separates the shapes
+				contact.separatingAxis = result.pointOnOther - result.pointOnFirst;
+				return NO_COLLISION;
+			}
+			contact.separatingAxis = NULL_VEC;
+			return gjk_penetration(first, other, simplex);
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABB.h"
+#include "Bounds.h"
+#include "Circle.h"
+#include "LineSegment.h"
+#include "ConvexPolygon.h"
+#include "OBB.h"
+#include "Capsule.h"
+#include "SupportShape.h"
+#include "GJKCache.h"
+#include "GJKResult.h"
+#include "ConvexCollision.h"
+#include "PairContact.h"
+
+namespace ch {
+	namespace collision {
+
+		/**
+		 * \brief Support mapping of an AABB : the corner of the AABB that is the farthest in the given direction.
+		 */
+		vec_t support_point(const AABB& aabb, const vec_t& direction);
+
+		/** \brief Same as support_point(const AABB&, const vec_t&), for bounds. */
+		vec_t support_point(const Bounds& bounds, const vec_t& direction);
+
+		/** \brief Support mapping of a circle : the point of the circle that is the farthest in the given direction. */
+		vec_t support_point(const Circle& circle, const vec_t& direction);
+
+		/** \brief Support mapping of a line segment : the extremity that is the farthest in the given direction. */
+		vec_t support_point(const LineSegment& segment, const vec_t& direction);
+
+		/** \brief Support mapping of a convex polygon : the vertex that is the farthest in the given direction. */
+		vec_t support_point(const ConvexPolygon& polygon, const vec_t& direction);
+
+		/** \brief Support mapping of an OBB : the corner of the OBB that is the farthest in the given direction. */
+		vec_t support_point(const OBB& obb, const vec_t& direction);
+
+		/** \brief Support mapping of a capsule : the point of the capsule that is the farthest in the given direction. */
+		vec_t support_point(const Capsule& capsule, const vec_t& direction);
+
+		/**
+		 * \brief Computes the distance between two convex shapes with the GJK algorithm.
+		 *
+		 * GJK searches the point of the Minkowski difference of the shapes closest to the origin,
+		 * using only the support mappings of the shapes, so any pair of convex shapes can be tested
+		 * with the same function. Use the shape specific functions (see collision_functions.h) when
+		 * they exist, as they are faster.
+		 *
+		 * \param cache Optional simplex cache of the pair. If it isn't empty, the search starts from
+		 * 		  the simplex of the previous call. It receives the final simplex.
+		 * \return A GJKResult containing the distance and the closest points.
+		 */
+		GJKResult gjk_distance(const SupportShape& first, const SupportShape& other, GJKCache* cache = nullptr);
+
+		/**
+		 * \return True if the shapes overlap (see gjk_distance()).
+		 */
+		bool gjk_intersects(const SupportShape& first, const SupportShape& other, GJKCache* cache = nullptr);
+
+		/**
+		 * \brief Computes the collision between two convex shapes with the GJK and EPA algorithms.
+		 *
+		 * In case of a collision, this function returns an instance of ConvexCollision containing the collision normal and the penetration depth.
+		 * The collision normal is the direction (a unit vector) towards which the other shape needs to be pushed in order to resolve the collision.
+		 * The collision normal will be set to a null vector (0,0) if there is no collision.
+		 *
+		 * If only the radii of the shapes overlap, the normal goes from the core of the first shape to the core of
+		 * the other one. If the cores overlap, the expanding polytope algorithm (EPA) finds the shortest way out of
+		 * the Minkowski difference of the cores.
+		 *
+		 * \param cache Optional simplex cache of the pair (see gjk_distance()).
+		 * \return A ConvexCollision containing information about the collision.
+		 */
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, GJKCache* cache = nullptr);
+
+		/**
+		 * \brief Checks if an axis separates two convex shapes.
+		 *
+		 * Only needs one support point per shape, which makes it a cheap early out when the axis
+		 * separated the shapes on the previous tick (see PairContact::separatingAxis).
+		 *
+		 * \param axis The axis, pointing from the first shape towards the other one. It doesn't need to be normalized.
+		 * \return True if the shapes are separated (or touching) along the axis, false otherwise.
+		 */
+		bool separated_along_axis(const SupportShape& first, const SupportShape& other, const vec_t& axis);
+
+		/**
+		 * \brief Same as gjk_collision_info(const SupportShape&, const SupportShape&, GJKCache*), starting from the data of the previous tick.
+		 *
+		 * If the separating axis of the contact still separates the shapes, the function returns
+		 * without running GJK. Otherwise GJK starts from the simplex of the contact. The separating
+		 * axis and the simplex of the contact are updated for the next tick, the normal and the
+		 * depth are left to PairCache::setContact().
+		 *
+		 * \param contact The contact of the pair, as returned by PairCache::get(). The first shape
+		 * 		  must be the shape of handle contact.first.
+		 * \return A ConvexCollision containing information about the collision.
+		 */
+		ConvexCollision gjk_collision_info(const SupportShape& first, const SupportShape& other, PairContact& contact);
+	}
+}
@@ -0,0 +1,153 @@
+#include "morton_functions.h"
+#include "parallel_functions.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace ch {
+	namespace spatial {
+
+		constexpr unsigned int RADIX_BITS = 8;
+		constexpr size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+		constexpr std::uint32_t RADIX_MASK = static_cast<std::uint32_t>(RADIX_BUCKETS - 1);
+		constexpr size_t RADIX_MIN_CHUNK_SIZE = 16384;
+		constexpr float MORTON_GRID_MAX = 65535.f;
+
+		/**
+		 * \brief Inserts a 0 bit between each of the 16 lowest bits of the given value.
+		 */
+		static std::uint32_t spread_bits(std::uint32_t v) {
+			v &= 0x0000FFFF;
+			v = (v | (v << 8)) & 0x00FF00FF;
+			v = (v | (v << 4)) & 0x0F0F0F0F;
+			v = (v | (v << 2)) & 0x33333333;
+			v = (v | (v << 1)) & 0x55555555;
+			return v;
+		}
+
+		/**
+		 * \brief Maps a coordinate to the [0, 65535] range of the quantization grid.
+		 */
+		static std::uint32_t quantize(float value, float min, float size) {
+			if (size <= 0.f) {
+				return 0;
+			}
+			float normalized = (value - min) / size * MORTON_GRID_MAX;
+			normalized = std::min(std::max(normalized, 0.f), MORTON_GRID_MAX);
+			return static_cast<std::uint32_t>(normalized);
+		}
+
+		std::uint32_t morton_encode(std::uint32_t x, std::uint32_t y) {
+			return spread_bits(x) | (spread_bits(y) << 1);
+		}
+
+		std::uint32_t morton_code(const vec_t& point, const AABB& worldBounds) {
+			return morton_encode(
+				quantize(point.x, worldBounds.pos.x, worldBounds.size.x),
+				quantize(point.y, worldBounds.pos.y, worldBounds.size.y));
+		}
+
+		std::vector<std::uint32_t> morton_codes(const std::vector<AABB>& aabbs, const AABB& worldBounds) {
+			std::vector<std::uint32_t> codes(aabbs.size());
+			for (size_t i = 0; i < aabbs.size(); ++i) {
+				codes[i] = morton_code(aabbs[i].center(), worldBounds);
+			}
+			return codes;
+		}
+
+		std::vector<std::uint32_t> morton_codes(const std::vector<Circle>& circles, const AABB& worldBounds) {
+			std::vector<std::uint32_t> codes(circles.size());
+			for (size_t i = 0; i < circles.size(); ++i) {
+				codes[i] = morton_code(circles[i].pos, worldBounds);
+			}
+			return codes;
+		}
+
+		void radix_sort(std::vector<std::uint32_t>& keys, std::vector<std::uint32_t>& values, unsigned int threadCount) {
+			if (threadCount == 0) {
+				threadCount = default_thread_count();
+			}
+
+			const size_t count = keys.size();
+			std::vector<std::uint32_t> sortedKeys(count);
+			std::vector<std::uint32_t> sortedValues(count);
+
+			// One histogram per chunk, so that the threads never write to the same counters
+			std::vector<size_t> histograms(threadCount * RADIX_BUCKETS);
+
+			for (unsigned int shift = 0; shift < 32; shift += RADIX_BITS) {
+				std::fill(histograms.begin(), histograms.end(), 0);
+
+				size_t chunks = parallel_for(count, [&](size_t begin, size_t end, size_t chunk) {
+					size_t* histogram = &histograms[chunk * RADIX_BUCKETS];
+					for (size_t i = begin; i < end; ++i) {
+						++histogram[(keys[i] >> shift) & RADIX_MASK];
+					}
+				}, threadCount, RADIX_MIN_CHUNK_SIZE);
+
+				// Exclusive prefix sum, ordered by digit then by chunk, to keep the sort stable
+				bool singleDigit = false;
+				size_t offset = 0;
+				for (size_t digit = 0; digit < RADIX_BUCKETS; ++digit) {
+					size_t digitCount = 0;
+					for (size_t chunk = 0; chunk < chunks; ++chunk) {
+						size_t& counter = histograms[chunk * RADIX_BUCKETS + digit];
+						size_t chunkCount = counter;
+						counter = offset;
+						offset += chunkCount;
+						digitCount += chunkCount;
+					}
+					singleDigit = singleDigit || digitCount == count;
+				}
+
+				if (singleDigit) {
+					continue;
+				}
+
+				parallel_for(count, [&](size_t begin, size_t end, size_t chunk) {
+					size_t* positions = &histograms[chunk * RADIX_BUCKETS];
+					for (size_t i = begin; i < end; ++i) {
+						size_t position = positions[(keys[i] >> shift) & RADIX_MASK]++;
+						sortedKeys[position] = keys[i];
+						sortedValues[position] = values[i];
+					}
+				}, threadCount, RADIX_MIN_CHUNK_SIZE);
+
+				keys.swap(sortedKeys);
+				values.swap(sortedValues);
+			}
+		}
+
+		/**
+		 * \brief Sorts the given Morton codes and returns the resulting permutation.
+		 */
+		static std::vector<std::uint32_t> sort_morton_codes(std::vector<std::uint32_t>& codes, unsigned int threadCount) {
+			std::vector<std::uint32_t> permutation(codes.size());
+			std::iota(permutation.begin(), permutation.end(), 0);
+			radix_sort(codes, permutation, threadCount);
+			return permutation;
+		}
+
+		std::vector<std::uint32_t> morton_order(const std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount) {
+			auto codes = morton_codes(aabbs, worldBounds);
+			return sort_morton_codes(codes, threadCount);
+		}
+
+		std::vector<std::uint32_t> morton_order(const std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount) {
+			auto codes = morton_codes(circles, worldBounds);
+			return sort_morton_codes(codes, threadCount);
+		}
+
+		std::vector<std::uint32_t> morton_sort(std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount) {
+			auto permutation = morton_order(aabbs, worldBounds, threadCount);
+			apply_permutation(aabbs, permutation);
+			return permutation;
+		}
+
+		std::vector<std::uint32_t> morton_sort(std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount) {
+			auto permutation = morton_order(circles, worldBounds, threadCount);
+			apply_permutation(circles, permutation);
+			return permutation;
+		}
+	}
+}
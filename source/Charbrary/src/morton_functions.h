@@ -0,0 +1,103 @@
+#pragma once
+
+#include "vector_type_definition.h"
+#include "AABB.h"
+#include "Circle.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+
+	//! Contains spatial sorting and partitioning utils (Morton codes, bounding volume hierarchies)
+	namespace spatial {
+
+		/**
+		 * \brief Interleaves the bits of two 16-bit coordinates into a 32-bit Morton code (Z-order).
+		 *
+		 * The bits of x occupy the even positions and the bits of y the odd positions. Points
+		 * that are close to each other in 2D tend to have close Morton codes.
+		 *
+		 * \param x Quantized X coordinate (only the 16 lowest bits are used).
+		 * \param y Quantized Y coordinate (only the 16 lowest bits are used).
+		 * \return The Morton code of the coordinates.
+		 */
+		std::uint32_t morton_encode(std::uint32_t x, std::uint32_t y);
+
+		/**
+		 * \brief Computes the Morton code of a point located inside the given world bounds.
+		 *
+		 * The point is quantized on a 65536 x 65536 grid covering the world bounds. Points
+		 * outside of the bounds are clamped to the closest border.
+		 *
+		 * \return The Morton code of the point.
+		 */
+		std::uint32_t morton_code(const vec_t& point, const AABB& worldBounds);
+
+		/**
+		 * \return The Morton code of the center of every AABB.
+		 */
+		std::vector<std::uint32_t> morton_codes(const std::vector<AABB>& aabbs, const AABB& worldBounds);
+
+		/**
+		 * \return The Morton code of the center of every circle.
+		 */
+		std::vector<std::uint32_t> morton_codes(const std::vector<Circle>& circles, const AABB& worldBounds);
+
+		/**
+		 * \brief Sorts keys in ascending order and moves the associated values along with them.
+		 *
+		 * This is a stable least-significant-digit radix sort (8 bits per pass). Each pass is
+		 * split between several threads. Passes on digits that are equal for every key are skipped.
+		 *
+		 * \param keys The keys to sort.
+		 * \param values The values associated to each key (same size as keys).
+		 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+		 */
+		void radix_sort(std::vector<std::uint32_t>& keys, std::vector<std::uint32_t>& values, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Computes the order in which the AABBs should be stored to follow the Z-order curve.
+		 *
+		 * \return A permutation : the i-th element of the sorted array is aabbs[permutation[i]].
+		 */
+		std::vector<std::uint32_t> morton_order(const std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Computes the order in which the circles should be stored to follow the Z-order curve.
+		 *
+		 * \return A permutation : the i-th element of the sorted array is circles[permutation[i]].
+		 */
+		std::vector<std::uint32_t> morton_order(const std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Reorders an array according to a permutation.
+		 *
+		 * After the call, values[i] contains what was previously stored at values[permutation[i]].
+		 * Use it to reorder the arrays that are associated with a shape array (entity ids, velocities, etc...).
+		 */
+		template <typename T>
+		void apply_permutation(std::vector<T>& values, const std::vector<std::uint32_t>& permutation) {
+			std::vector<T> reordered;
+			reordered.reserve(permutation.size());
+			for (auto index : permutation) {
+				reordered.push_back(values[index]);
+			}
+			values.swap(reordered);
+		}
+
+		/**
+		 * \brief Sorts the AABBs along the Z-order curve so that boxes that are close in space are also close in memory.
+		 *
+		 * \return The permutation that was applied (see apply_permutation()).
+		 */
+		std::vector<std::uint32_t> morton_sort(std::vector<AABB>& aabbs, const AABB& worldBounds, unsigned int threadCount = 0);
+
+		/**
+		 * \brief Sorts the circles along the Z-order curve so that circles that are close in space are also close in memory.
+		 *
+		 * \return The permutation that was applied (see apply_permutation()).
+		 */
+		std::vector<std::uint32_t> morton_sort(std::vector<Circle>& circles, const AABB& worldBounds, unsigned int threadCount = 0);
+	}
+}
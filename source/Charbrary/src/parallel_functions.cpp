@@ -0,0 +1,45 @@
+#include "parallel_functions.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace ch {
+
+	unsigned int default_thread_count() {
+		unsigned int threads = std::thread::hardware_concurrency();
+		return threads > 0 ? threads : 1;
+	}
+
+	size_t parallel_for(size_t count, const std::function<void(size_t begin, size_t end, size_t chunk)>& task, unsigned int threadCount, size_t minChunkSize) {
+		if (count == 0) {
+			return 0;
+		}
+
+		if (threadCount == 0) {
+			threadCount = default_thread_count();
+		}
+
+		minChunkSize = std::max<size_t>(minChunkSize, 1);
+		size_t chunks = std::min<size_t>(threadCount, (count + minChunkSize - 1) / minChunkSize);
+		chunks = std::max<size_t>(chunks, 1);
+		size_t chunkSize = (count + chunks - 1) / chunks;
+		chunks = (count + chunkSize - 1) / chunkSize;
+
+		std::vector<std::thread> workers;
+		workers.reserve(chunks - 1);
+		for (size_t chunk = 1; chunk < chunks; ++chunk) {
+			size_t begin = chunk * chunkSize;
+			size_t end = std::min(count, begin + chunkSize);
+			workers.emplace_back(task, begin, end, chunk);
+		}
+
+		task(0, std::min(count, chunkSize), 0);
+
+		for (auto& worker : workers) {
+			worker.join();
+		}
+
+		return chunks;
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace ch {
+
+	/**
+	 * \brief Returns the number of threads used by the parallel algorithms when none is specified.
+	 *
+	 * This is the number of hardware threads reported by the system (at least 1).
+	 */
+	unsigned int default_thread_count();
+
+	/**
+	 * \brief Splits a range of indices in contiguous chunks and processes each chunk on its own thread.
+	 *
+	 * The calling thread processes the first chunk itself and the function returns once every chunk
+	 * has been processed. The chunks are as large as possible, there is at most one chunk per thread.
+	 *
+	 * \param count Number of indices to process (from 0 to count - 1).
+	 * \param task Function called once per chunk with the first index, the index past the last one and
+	 * 		  the index of the chunk (between 0 and the number of chunks - 1).
+	 * \param threadCount Maximum number of threads to use. 0 means default_thread_count().
+	 * \param minChunkSize Chunks are never smaller than this, so small ranges are processed on fewer threads.
+	 * \return The number of chunks the range was split into.
+	 */
+	size_t parallel_for(size_t count, const std::function<void(size_t begin, size_t end, size_t chunk)>& task, unsigned int threadCount = 0, size_t minChunkSize = 1024);
+}
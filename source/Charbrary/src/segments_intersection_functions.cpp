@@ -0,0 +1,521 @@
+#include "segments_intersection_functions.h"
+#include "collision_functions.h"
+#include "parallel_functions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_set>
+
+namespace ch {
+	namespace collision {
+
+		constexpr size_t SEGMENTS_INTERSECTION_MIN_CHUNK_SIZE = 1024;
+		constexpr std::uint32_t SEGMENTS_SWEEP_NONE = 0xFFFFFFFF;
+
+		/**
+		 * \brief A point of the sweep, in double precision so that the float coordinates of the segments are exact.
+		 */
+		struct SegmentsSweepPoint {
+			double x, y;
+		};
+
+		/**
+		 * \brief A segment with its extremities ordered along the sweep (smallest x first, then smallest y).
+		 */
+		struct SegmentsSweepSegment {
+			SegmentsSweepPoint start, end;
+		};
+
+		/**
+		 * \brief Node of the sweep line : a treap of the segments crossing the sweep line, from the lowest to the highest.
+		 *
+		 * Node i holds segment i, the order of the nodes is only given by the links.
+		 */
+		struct SegmentsSweepNode {
+			std::uint32_t left, right, parent;
+			std::uint32_t priority;
+		};
+
+		/**
+		 * \brief The segments crossing the sweep line.
+		 */
+		struct SegmentsSweepStatus {
+			std::vector<SegmentsSweepNode> nodes;
+			std::uint32_t root;
+		};
+
+		/**
+		 * \brief Extremity of a segment, or crossing of two neighbouring segments, still to be swept.
+		 */
+		struct SegmentsSweepEvent {
+			SegmentsSweepPoint point;
+			std::uint32_t below; /**< Segment of the extremity, or lower segment of the crossing. */
+			std::uint32_t above; /**< SEGMENTS_SWEEP_NONE for an extremity, upper segment of the crossing otherwise. */
+			bool start; /**< For an extremity, true if it's the start of the segment. */
+		};
+
+		/**
+		 * \return true if the point a is swept before the point b.
+		 */
+		static bool segments_sweep_before(const SegmentsSweepPoint& a, const SegmentsSweepPoint& b) {
+			return a.x < b.x || (a.x == b.x && a.y < b.y);
+		}
+
+		/**
+		 * \brief Computes the exact sign of a sum of doubles.
+		 *
+		 * The sum is first computed naively, and only summed again without rounding errors (as an
+		 * expansion of non-overlapping components) when it's too close to 0 to trust its sign.
+		 */
+		static int segments_sweep_sign(const double* terms, size_t count) {
+			double sum = 0.0;
+			double magnitude = 0.0;
+			for (size_t i = 0; i < count; ++i) {
+				sum += terms[i];
+				magnitude += std::abs(terms[i]);
+			}
+			if (std::abs(sum) > magnitude * 1e-14) {
+				return sum > 0.0 ? 1 : -1;
+			}
+
+			double expansion[8];
+			size_t length = 0;
+			for (size_t i = 0; i < count; ++i) {
+				double carry = terms[i];
+				for (size_t j = 0; j < length; ++j) {
+					const double total = carry + expansion[j];
+					const double bigger = total - carry;
+					const double error = (carry - (total - bigger)) + (expansion[j] - bigger);
+					expansion[j] = error;
+					carry = total;
+				}
+				expansion[length++] = carry;
+			}
+			for (size_t i = length; i > 0; --i) {
+				if (expansion[i - 1] != 0.0) {
+					return expansion[i - 1] > 0.0 ? 1 : -1;
+				}
+			}
+			return 0;
+		}
+
+		/**
+		 * \brief Exact orientation of the point c relative to the line going from a to b.
+		 *
+		 * The products of two float coordinates are exact in double precision, so the cross product
+		 * is expanded into such products before being summed.
+		 *
+		 * \return 1 if c is above the line (to its left), -1 if it's below, 0 if it's on the line.
+		 */
+		static int segments_sweep_orientation(const SegmentsSweepPoint& a, const SegmentsSweepPoint& b, const SegmentsSweepPoint& c) {
+			const double terms[6] = { b.x * c.y, -b.x * a.y, -a.x * c.y, -b.y * c.x, b.y * a.x, a.y * c.x };
+			return segments_sweep_sign(terms, 6);
+		}
+
+		/**
+		 * \return 1 if the segment a is steeper than the segment b after the point where they meet, -1 if it's less steep, 0 if they're parallel.
+		 */
+		static int segments_sweep_compare_slopes(const SegmentsSweepSegment& a, const SegmentsSweepSegment& b) {
+			// Sign of cross(b.end - b.start, a.end - a.start)
+			const double terms[8] = {
+				b.end.x * a.end.y, -b.end.x * a.start.y, -b.start.x * a.end.y, b.start.x * a.start.y,
+				-b.end.y * a.end.x, b.end.y * a.start.x, b.start.y * a.end.x, -b.start.y * a.start.x
+			};
+			return segments_sweep_sign(terms, 8);
+		}
+
+		static std::uint32_t segments_sweep_first(const SegmentsSweepStatus& status, std::uint32_t node) {
+			while (status.nodes[node].left != SEGMENTS_SWEEP_NONE) {
+				node = status.nodes[node].left;
+			}
+			return node;
+		}
+
+		static std::uint32_t segments_sweep_last(const SegmentsSweepStatus& status, std::uint32_t node) {
+			while (status.nodes[node].right != SEGMENTS_SWEEP_NONE) {
+				node = status.nodes[node].right;
+			}
+			return node;
+		}
+
+		/**
+		 * \return The segment just above the given one on the sweep line, SEGMENTS_SWEEP_NONE if it's the highest.
+		 */
+		static std::uint32_t segments_sweep_next(const SegmentsSweepStatus& status, std::uint32_t node) {
+			if (status.nodes[node].right != SEGMENTS_SWEEP_NONE) {
+				return segments_sweep_first(status, status.nodes[node].right);
+			}
+			std::uint32_t parent = status.nodes[node].parent;
+			while (parent != SEGMENTS_SWEEP_NONE && status.nodes[parent].right == node) {
+				node = parent;
+				parent = status.nodes[node].parent;
+			}
+			return parent;
+		}
+
+		/**
+		 * \return The segment just below the given one on the sweep line, SEGMENTS_SWEEP_NONE if it's the lowest.
+		 */
+		static std::uint32_t segments_sweep_previous(const SegmentsSweepStatus& status, std::uint32_t node) {
+			if (status.nodes[node].left != SEGMENTS_SWEEP_NONE) {
+				return segments_sweep_last(status, status.nodes[node].left);
+			}
+			std::uint32_t parent = status.nodes[node].parent;
+			while (parent != SEGMENTS_SWEEP_NONE && status.nodes[parent].left == node) {
+				node = parent;
+				parent = status.nodes[node].parent;
+			}
+			return parent;
+		}
+
+		/**
+		 * \brief Moves a node up, in place of its parent.
+		 */
+		static void segments_sweep_rotate_up(SegmentsSweepStatus& status, std::uint32_t node) {
+			SegmentsSweepNode& child = status.nodes[node];
+			const std::uint32_t parent = child.parent;
+			SegmentsSweepNode& top = status.nodes[parent];
+			const std::uint32_t grandParent = top.parent;
+
+			if (top.left == node) {
+				top.left = child.right;
+				if (child.right != SEGMENTS_SWEEP_NONE) {
+					status.nodes[child.right].parent = parent;
+				}
+				child.right = parent;
+			}
+			else {
+				top.right = child.left;
+				if (child.left != SEGMENTS_SWEEP_NONE) {
+					status.nodes[child.left].parent = parent;
+				}
+				child.left = parent;
+			}
+			top.parent = node;
+			child.parent = grandParent;
+
+			if (grandParent == SEGMENTS_SWEEP_NONE) {
+				status.root = node;
+			}
+			else if (status.nodes[grandParent].left == parent) {
+				status.nodes[grandParent].left = node;
+			}
+			else {
+				status.nodes[grandParent].right = node;
+			}
+		}
+
+		/**
+		 * \brief Inserts a segment just above another one on the sweep line.
+		 * \param after The segment below, SEGMENTS_SWEEP_NONE to insert the segment below all the others.
+		 */
+		static void segments_sweep_insert(SegmentsSweepStatus& status, std::uint32_t node, std::uint32_t after) {
+			SegmentsSweepNode& inserted = status.nodes[node];
+			inserted.left = SEGMENTS_SWEEP_NONE;
+			inserted.right = SEGMENTS_SWEEP_NONE;
+			inserted.parent = SEGMENTS_SWEEP_NONE;
+			if (status.root == SEGMENTS_SWEEP_NONE) {
+				status.root = node;
+				return;
+			}
+
+			if (after == SEGMENTS_SWEEP_NONE) {
+				inserted.parent = segments_sweep_first(status, status.root);
+				status.nodes[inserted.parent].left = node;
+			}
+			else if (status.nodes[after].right == SEGMENTS_SWEEP_NONE) {
+				inserted.parent = after;
+				status.nodes[after].right = node;
+			}
+			else {
+				inserted.parent = segments_sweep_first(status, status.nodes[after].right);
+				status.nodes[inserted.parent].left = node;
+			}
+
+			while (inserted.parent != SEGMENTS_SWEEP_NONE && status.nodes[inserted.parent].priority < inserted.priority) {
+				segments_sweep_rotate_up(status, node);
+			}
+		}
+
+		/**
+		 * \brief Removes a segment from the sweep line.
+		 */
+		static void segments_sweep_erase(SegmentsSweepStatus& status, std::uint32_t node) {
+			SegmentsSweepNode& erased = status.nodes[node];
+			while (erased.left != SEGMENTS_SWEEP_NONE && erased.right != SEGMENTS_SWEEP_NONE) {
+				const std::uint32_t left = erased.left;
+				const std::uint32_t right = erased.right;
+				segments_sweep_rotate_up(status, status.nodes[left].priority > status.nodes[right].priority ? left : right);
+			}
+
+			const std::uint32_t child = erased.left != SEGMENTS_SWEEP_NONE ? erased.left : erased.right;
+			if (child != SEGMENTS_SWEEP_NONE) {
+				status.nodes[child].parent = erased.parent;
+			}
+			if (erased.parent == SEGMENTS_SWEEP_NONE) {
+				status.root = child;
+			}
+			else if (status.nodes[erased.parent].left == node) {
+				status.nodes[erased.parent].left = child;
+			}
+			else {
+				status.nodes[erased.parent].right = child;
+			}
+			erased.left = SEGMENTS_SWEEP_NONE;
+			erased.right = SEGMENTS_SWEEP_NONE;
+			erased.parent = SEGMENTS_SWEEP_NONE;
+		}
+
+		/**
+		 * \brief Finds the lowest segment of the sweep line that isn't below the point.
+		 * \return SEGMENTS_SWEEP_NONE if every segment is below the point.
+		 */
+		static std::uint32_t segments_sweep_locate(const SegmentsSweepStatus& status, const std::vector<SegmentsSweepSegment>& segments, const SegmentsSweepPoint& point) {
+			std::uint32_t found = SEGMENTS_SWEEP_NONE;
+			std::uint32_t node = status.root;
+			while (node != SEGMENTS_SWEEP_NONE) {
+				if (segments_sweep_orientation(segments[node].start, segments[node].end, point) > 0) {
+					node = status.nodes[node].right;
+				}
+				else {
+					found = node;
+					node = status.nodes[node].left;
+				}
+			}
+			return found;
+		}
+
+		static std::uint64_t segments_sweep_pair_key(std::uint32_t first, std::uint32_t other) {
+			return first < other ? (static_cast<std::uint64_t>(first) << 32) | other : (static_cast<std::uint64_t>(other) << 32) | first;
+		}
+
+		/**
+		 * \brief Finds every pair of segments that meet, with a Bentley-Ottmann sweep.
+		 *
+		 * The sweep line goes through the extremities of the segments and the crossings of neighbouring
+		 * segments, from the smallest x to the largest (then from the smallest y, so vertical segments
+		 * are swept from bottom to top). The segments crossing the sweep line are kept from the lowest
+		 * to the highest in a treap, whose order is only ever changed by inserting a segment at a
+		 * position found with exact orientations, or by swapping two neighbours at their crossing.
+		 *
+		 * Segments that meet at an extremity (one ending or starting on the other, collinear overlaps)
+		 * are found exactly, when the sweep line reaches the extremity. Crossings inside both segments
+		 * are found when the segments become neighbours, which needs the crossing points : they are
+		 * only rounded to double precision, which can swap the order of two events within a rounding
+		 * error of each other.
+		 *
+		 * \return The pairs, first index in the high bits, in no particular order.
+		 */
+		static std::vector<std::uint64_t> segments_sweep_pairs(const std::vector<LineSegment>& input) {
+			const std::uint32_t count = static_cast<std::uint32_t>(input.size());
+			std::vector<SegmentsSweepSegment> segments(count);
+			std::vector<SegmentsSweepEvent> extremities;
+			extremities.reserve(2 * static_cast<size_t>(count));
+			for (std::uint32_t i = 0; i < count; ++i) {
+				SegmentsSweepPoint start{ input[i].start.x, input[i].start.y };
+				SegmentsSweepPoint end{ input[i].end.x, input[i].end.y };
+				if (segments_sweep_before(end, start)) {
+					std::swap(start, end);
+				}
+				segments[i] = SegmentsSweepSegment{ start, end };
+				extremities.push_back(SegmentsSweepEvent{ start, i, SEGMENTS_SWEEP_NONE, true });
+				extremities.push_back(SegmentsSweepEvent{ end, i, SEGMENTS_SWEEP_NONE, false });
+			}
+			std::sort(extremities.begin(), extremities.end(), [](const SegmentsSweepEvent& a, const SegmentsSweepEvent& b) {
+				return segments_sweep_before(a.point, b.point);
+			});
+
+			SegmentsSweepStatus status{ std::vector<SegmentsSweepNode>(count), SEGMENTS_SWEEP_NONE };
+			for (std::uint32_t i = 0; i < count; ++i) {
+				// Deterministic pseudo-random priorities (splitmix)
+				std::uint64_t hash = (i + 1) * 0x9E3779B97F4A7C15ull;
+				hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+				hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+				status.nodes[i] = SegmentsSweepNode{ SEGMENTS_SWEEP_NONE, SEGMENTS_SWEEP_NONE, SEGMENTS_SWEEP_NONE, static_cast<std::uint32_t>(hash >> 32) };
+			}
+
+			std::vector<std::uint64_t> pairs;
+			std::unordered_set<std::uint64_t> found;
+			const auto report = [&](std::uint32_t first, std::uint32_t other) {
+				const std::uint64_t key = segments_sweep_pair_key(first, other);
+				if (found.insert(key).second) {
+					pairs.push_back(key);
+				}
+			};
+
+			// Crossings, the earliest first
+			const auto later = [](const SegmentsSweepEvent& a, const SegmentsSweepEvent& b) {
+				return segments_sweep_before(b.point, a.point);
+			};
+			std::priority_queue<SegmentsSweepEvent, std::vector<SegmentsSweepEvent>, decltype(later)> crossings(later);
+			SegmentsSweepPoint sweep{ -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+
+			// Schedules the crossing of two neighbours, if they cross inside both segments and haven't been swapped yet
+			const auto schedule = [&](std::uint32_t below, std::uint32_t above) {
+				if (below == SEGMENTS_SWEEP_NONE || above == SEGMENTS_SWEEP_NONE || found.count(segments_sweep_pair_key(below, above)) != 0) {
+					return;
+				}
+				const SegmentsSweepSegment& a = segments[below];
+				const SegmentsSweepSegment& b = segments[above];
+				if (segments_sweep_orientation(a.start, a.end, b.start) * segments_sweep_orientation(a.start, a.end, b.end) >= 0 ||
+					segments_sweep_orientation(b.start, b.end, a.start) * segments_sweep_orientation(b.start, b.end, a.end) >= 0) {
+					return;
+				}
+
+				const double dx = a.end.x - a.start.x, dy = a.end.y - a.start.y;
+				const double ex = b.end.x - b.start.x, ey = b.end.y - b.start.y;
+				const double t = ((b.start.x - a.start.x) * ey - (b.start.y - a.start.y) * ex) / (dx * ey - dy * ex);
+				SegmentsSweepPoint point{ a.start.x + dx * t, a.start.y + dy * t };
+				if (segments_sweep_before(point, sweep)) {
+					point = sweep;
+				}
+				crossings.push(SegmentsSweepEvent{ point, below, above, false });
+			};
+
+			std::vector<std::uint32_t> starting, through, ending, reordered;
+			size_t next = 0;
+			while (next < extremities.size() || !crossings.empty()) {
+				if (!crossings.empty() && (next == extremities.size() || !segments_sweep_before(extremities[next].point, crossings.top().point))) {
+					// Crossing of two neighbours : they swap places, if they're still neighbours
+					const SegmentsSweepEvent crossing = crossings.top();
+					crossings.pop();
+					sweep = crossing.point;
+					if (segments_sweep_next(status, crossing.below) != crossing.above || found.count(segments_sweep_pair_key(crossing.below, crossing.above)) != 0) {
+						continue;
+					}
+					report(crossing.below, crossing.above);
+					segments_sweep_erase(status, crossing.above);
+					segments_sweep_insert(status, crossing.above, segments_sweep_previous(status, crossing.below));
+					schedule(segments_sweep_previous(status, crossing.above), crossing.above);
+					schedule(crossing.below, segments_sweep_next(status, crossing.below));
+					continue;
+				}
+
+				// Every extremity at this point
+				const SegmentsSweepPoint point = extremities[next].point;
+				sweep = point;
+				starting.clear();
+				ending.clear();
+				for (; next < extremities.size() && extremities[next].point.x == point.x && extremities[next].point.y == point.y; ++next) {
+					(extremities[next].start ? starting : ending).push_back(extremities[next].below);
+				}
+
+				// Segments of the sweep line going through the point : they're neighbours, the segments ending here among them
+				through.clear();
+				const std::uint32_t located = segments_sweep_locate(status, segments, point);
+				std::uint32_t below = located == SEGMENTS_SWEEP_NONE ? (status.root == SEGMENTS_SWEEP_NONE ? SEGMENTS_SWEEP_NONE : segments_sweep_last(status, status.root)) : segments_sweep_previous(status, located);
+				std::uint32_t above = located;
+				while (above != SEGMENTS_SWEEP_NONE && segments_sweep_orientation(segments[above].start, segments[above].end, point) == 0) {
+					through.push_back(above);
+					above = segments_sweep_next(status, above);
+				}
+
+				// Every segment starting here meets every segment going through or starting here
+				for (size_t i = 0; i < starting.size(); ++i) {
+					for (std::uint32_t segment : through) {
+						report(starting[i], segment);
+					}
+					for (size_t j = i + 1; j < starting.size(); ++j) {
+						report(starting[i], starting[j]);
+					}
+				}
+
+				// Segments ending here meet every segment going through, the others cross here unless they're collinear (then they already met)
+				for (size_t i = 0; i < through.size(); ++i) {
+					const bool endsHere = segments[through[i]].end.x == point.x && segments[through[i]].end.y == point.y;
+					for (size_t j = i + 1; j < through.size(); ++j) {
+						const bool otherEndsHere = segments[through[j]].end.x == point.x && segments[through[j]].end.y == point.y;
+						if (endsHere || otherEndsHere || segments_sweep_compare_slopes(segments[through[i]], segments[through[j]]) != 0) {
+							report(through[i], through[j]);
+						}
+					}
+				}
+
+				// The segments going on after the point are put back, from the least steep to the steepest
+				reordered.clear();
+				for (std::uint32_t segment : through) {
+					segments_sweep_erase(status, segment);
+					if (!(segments[segment].end.x == point.x && segments[segment].end.y == point.y)) {
+						reordered.push_back(segment);
+					}
+				}
+				for (std::uint32_t segment : starting) {
+					if (segments_sweep_before(point, segments[segment].end)) {
+						reordered.push_back(segment);
+					}
+				}
+				std::sort(reordered.begin(), reordered.end(), [&](std::uint32_t a, std::uint32_t b) {
+					const int steeper = segments_sweep_compare_slopes(segments[a], segments[b]);
+					return steeper != 0 ? steeper < 0 : a < b;
+				});
+
+				// Segments ending here that weren't found next to the point (rounding of the crossings) still leave the sweep line
+				for (std::uint32_t segment : ending) {
+					if (status.nodes[segment].parent != SEGMENTS_SWEEP_NONE || status.root == segment) {
+						if (below == segment) {
+							below = segments_sweep_previous(status, segment);
+						}
+						if (above == segment) {
+							above = segments_sweep_next(status, segment);
+						}
+						segments_sweep_erase(status, segment);
+					}
+				}
+
+				for (std::uint32_t segment : reordered) {
+					segments_sweep_insert(status, segment, below);
+					schedule(below, segment);
+					below = segment;
+				}
+				schedule(below, above);
+			}
+			return pairs;
+		}
+
+		std::vector<IndexedSegmentsIntersection> all_line_segments_intersections(const std::vector<LineSegment>& segments, unsigned int threadCount) {
+			if (threadCount == 0) {
+				threadCount = default_thread_count();
+			}
+
+			std::vector<std::uint64_t> pairs = segments_sweep_pairs(segments);
+			std::sort(pairs.begin(), pairs.end());
+
+			// Every chunk fills its own array, the arrays are then concatenated in order
+			std::vector<std::vector<IndexedSegmentsIntersection>> chunkResults(threadCount);
+			size_t chunks = parallel_for(pairs.size(), [&](size_t begin, size_t end, size_t chunk) {
+				auto& results = chunkResults[chunk];
+				for (size_t i = begin; i < end; ++i) {
+					const std::uint32_t firstIndex = static_cast<std::uint32_t>(pairs[i] >> 32);
+					const std::uint32_t otherIndex = static_cast<std::uint32_t>(pairs[i]);
+					const LineSegment& first = segments[firstIndex];
+					const vec_t direction = first.end - first.start;
+
+					auto parameters = line_segments_parametric_intersection(first, segments[otherIndex]);
+					if (parameters.type == IntersectionType::Crossing) {
+						results.push_back({ firstIndex, otherIndex, SegmentsIntersection(IntersectionType::Crossing, first.start + direction * parameters.t) });
+					}
+					else if (parameters.type == IntersectionType::Overlapping) {
+						std::pair<vec_t, vec_t> overlap{ first.start + direction * parameters.t, first.start + direction * parameters.tEnd };
+						results.push_back({ firstIndex, otherIndex, SegmentsIntersection(IntersectionType::Overlapping, overlap) });
+					}
+				}
+			}, threadCount, SEGMENTS_INTERSECTION_MIN_CHUNK_SIZE);
+
+			std::vector<IndexedSegmentsIntersection> intersections;
+			size_t total = 0;
+			for (size_t chunk = 0; chunk < chunks; ++chunk) {
+				total += chunkResults[chunk].size();
+			}
+			intersections.reserve(total);
+			// SegmentsIntersection can't be assigned, only copy constructed
+			for (size_t chunk = 0; chunk < chunks; ++chunk) {
+				for (const auto& intersection : chunkResults[chunk]) {
+					intersections.push_back(intersection);
+				}
+			}
+			return intersections;
+		}
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "LineSegment.h"
+#include "SegmentsIntersection.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ch {
+	namespace collision {
+
+		/**
+		 * \brief An intersection found between 2 segments of an array.
+		 */
+		struct IndexedSegmentsIntersection {
+			std::uint32_t first; /**< Index of the first segment. */
+			std::uint32_t second; /**< Index of the second segment (always greater than first). */
+			SegmentsIntersection intersection; /**< The intersection, either IntersectionType::Crossing or IntersectionType::Overlapping. */
+		};
+
+		/**
+		 * \brief Finds every pair of intersecting segments in an array.
+		 *
+		 * Instead of testing every pair of segments (n² tests), a sweep line (Bentley-Ottmann) goes
+		 * through the extremities of the segments and the crossings it finds, only testing segments
+		 * that are neighbours on the sweep line. The cost is O((n + k) log n) for k intersections,
+		 * whatever the layout of the segments (long parallel walls included). Segments meeting at an
+		 * extremity or overlapping are found with exact orientation tests; crossing points are rounded,
+		 * so crossings closer than the rounding error to another event can be swept out of order.
+		 *
+		 * The sweep runs on a single thread, the intersections of the pairs found are then computed
+		 * with line_segments_parametric_intersection() on several threads.
+		 *
+		 * Points of the intersections are computed from the first segment of each pair. For
+		 * overlapping segments, resultingSegment goes in the direction of the first segment.
+		 *
+		 * \param segments The segments to test.
+		 * \param threadCount Maximum number of threads to use. 0 means ch::default_thread_count().
+		 * \return Every intersection, sorted by first index then by second index.
+		 */
+		std::vector<IndexedSegmentsIntersection> all_line_segments_intersections(const std::vector<LineSegment>& segments, unsigned int threadCount = 0);
+	}
+}
@@ -19,6 +19,10 @@ namespace ch {
 		return a.x * b.x + a.y * b.y;
 	}	
 
+	float vec_cross_product(vec_t a, vec_t b) {
+		return a.x * b.y - a.y * b.x;
+	}
+
 	vec_t vec_abs(vec_t v) {
 		return vec_t(std::abs(v.x), std::abs(v.y));
 	}
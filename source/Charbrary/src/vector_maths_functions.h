@@ -28,6 +28,16 @@ namespace ch {
 	 */
 	float vec_dot_product(vec_t a, vec_t b);
 
+	/**
+	 * \brief Computes the 2D cross product of 2 vectors (a.x * b.y - a.y * b.x).
+	 *
+	 * The result is positive if b is rotated clockwise from a on a screen (Y axis going
+	 * down), negative if it is rotated counterclockwise, and 0 if the vectors are parallel.
+	 *
+	 * \return The result of the cross product, a scalar.
+	 */
+	float vec_cross_product(vec_t a, vec_t b);
+
 	/**
 	 * \brief Makes the components of the vector positive.
 	 * \return A vector whose components are positive numbers.
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+TEST_CASE("collision masks of different sizes", "[.][benchmark][CollisionMask]") {
+	for (std::uint32_t size : { 16u, 64u, 256u }) {
+		// Rings : the AABBs overlap most of the time, the pixels rarely do
+		std::vector<std::uint8_t> alpha(size * size, 0);
+		const float radius = size / 2.f;
+		for (std::uint32_t y = 0; y < size; ++y) {
+			for (std::uint32_t x = 0; x < size; ++x) {
+				const float distance = ch::vec_magnitude(ch::vec_t(x + 0.5f - radius, y + 0.5f - radius));
+				alpha[x + y * size] = distance < radius && distance > radius - 2.f ? 255 : 0;
+			}
+		}
+		const ch::CollisionMask mask(size, size, alpha);
+
+		std::vector<ch::vec_t> positions;
+		for (int i = 0; i < 1000; ++i) {
+			positions.push_back(ch::rand::rand_vector(-(float)size, (float)size, -(float)size, (float)size));
+		}
+
+		BENCHMARK("1000 tests, " + std::to_string(size) + "x" + std::to_string(size) + " masks, word by word") {
+			size_t hits = 0;
+			for (const ch::vec_t& position : positions) {
+				hits += mask.intersects(ch::NULL_VEC, mask, position) ? 1 : 0;
+			}
+			return hits;
+		};
+
+		BENCHMARK("1000 tests, " + std::to_string(size) + "x" + std::to_string(size) + " masks, pixel by pixel") {
+			size_t hits = 0;
+			for (const ch::vec_t& position : positions) {
+				const std::int64_t dx = static_cast<std::int64_t>(std::floor(position.x));
+				const std::int64_t dy = static_cast<std::int64_t>(std::floor(position.y));
+				bool hit = false;
+				for (std::int64_t y = 0; y < size && !hit; ++y) {
+					for (std::int64_t x = 0; x < size && !hit; ++x) {
+						hit = mask.isSolid(x, y) && mask.isSolid(x - dx, y - dy);
+					}
+				}
+				hits += hit ? 1 : 0;
+			}
+			return hits;
+		};
+	}
+}
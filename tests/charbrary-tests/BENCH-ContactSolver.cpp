@@ -0,0 +1,56 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("contact solver on a pile of 10k circles", "[.][benchmark][ContactSolver]") {
+	// 100 x 100 circles, each one touching its neighbours, on a static bottom row
+	const int side = 100;
+	std::vector<ch::vec_t> positions;
+	std::vector<ch::vec_t> velocities;
+	std::vector<float> inverseMasses;
+	for (int y = 0; y < side; ++y) {
+		for (int x = 0; x < side; ++x) {
+			positions.emplace_back(x * 1.9f, y * 1.9f);
+			velocities.push_back(ch::rand::rand_vector(-1.f, 1.f, -1.f, 1.f));
+			inverseMasses.push_back(y == side - 1 ? 0.f : 1.f);
+		}
+	}
+
+	ch::ContactSolver sequential(8, 3, 0.01f, 1.f, 1);
+	ch::ContactSolver parallel(8, 3, 0.01f, 1.f, 0);
+	ch::ContactSolver fourThreads(8, 3, 0.01f, 1.f, 4);
+
+	// Every tick starts from the same pile, so that all the contacts are solved on every run
+	const std::vector<ch::vec_t> startPositions = positions;
+	const std::vector<ch::vec_t> startVelocities = velocities;
+
+	auto tick = [&](ch::ContactSolver& solver) {
+		positions = startPositions;
+		velocities = startVelocities;
+		solver.newFrame();
+		for (int i = 0; i < side * side; ++i) {
+			if ((i + 1) % side != 0) {
+				solver.addContact(i, i + 1, ch::collision::circles_collision_info(ch::Circle(positions[i], 1.f), ch::Circle(positions[i + 1], 1.f)), 0.1f, 0.5f);
+			}
+			if (i + side < side * side) {
+				solver.addContact(i, i + side, ch::collision::circles_collision_info(ch::Circle(positions[i], 1.f), ch::Circle(positions[i + side], 1.f)), 0.1f, 0.5f);
+			}
+		}
+		solver.solve(positions, velocities, inverseMasses, 1.f / 60.f);
+		return solver.size();
+	};
+
+	BENCHMARK("tick with 10k bodies (1 thread)") {
+		return tick(sequential);
+	};
+
+	BENCHMARK("tick with 10k bodies (all threads)") {
+		return tick(parallel);
+	};
+
+	BENCHMARK("tick with 10k bodies (4 threads)") {
+		return tick(fourThreads);
+	};
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("circles against thousands of static walls", "[.][benchmark][DistanceField]") {
+	const ch::Bounds area(0.f, 0.f, 2048.f, 2048.f);
+	std::vector<ch::AABB> walls;
+	for (int i = 0; i < 4000; ++i) {
+		walls.emplace_back(ch::rand::rand_vector(0.f, 2000.f, 0.f, 2000.f), ch::rand::rand_vector(4.f, 40.f, 4.f, 40.f));
+	}
+
+	std::vector<ch::Circle> circles;
+	for (int i = 0; i < 10000; ++i) {
+		circles.emplace_back(ch::rand::rand_vector(0.f, 2048.f, 0.f, 2048.f), ch::rand::rand_float(2.f, 10.f));
+	}
+
+	ch::spatial::DistanceField field(area, 2.f);
+	BENCHMARK("bake, 4000 walls, 1025x1025 nodes, 1 thread") {
+		field.bake(walls, {}, {}, 1);
+		return field.nodeDistance(0, 0);
+	};
+
+	BENCHMARK("bake, 4000 walls, 1025x1025 nodes, all threads") {
+		field.bake(walls, {}, {}, 0);
+		return field.nodeDistance(0, 0);
+	};
+
+	ch::spatial::LBVH bvh;
+	bvh.build(walls);
+	std::vector<std::uint32_t> results;
+
+	BENCHMARK("10k circles, distance field") {
+		size_t hits = 0;
+		for (const ch::Circle& circle : circles) {
+			hits += field.intersects(circle) ? 1 : 0;
+		}
+		return hits;
+	};
+
+	BENCHMARK("10k circles, lbvh") {
+		size_t hits = 0;
+		for (const ch::Circle& circle : circles) {
+			bvh.query(circle, results);
+			bool hit = false;
+			for (std::uint32_t wall : results) {
+				hit = hit || ch::collision::aabb_intersects(walls[wall], circle);
+			}
+			hits += hit ? 1 : 0;
+		}
+		return hits;
+	};
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("lbvh full rebuild and queries", "[.][benchmark][LBVH]") {
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 100000; ++i) {
+		boxes.emplace_back(ch::rand::rand_vector(0.f, 10000.f, 0.f, 10000.f), ch::rand::rand_vector(2.f, 20.f, 2.f, 20.f));
+	}
+
+	ch::spatial::LBVH bvh;
+	bvh.build(boxes);
+
+	BENCHMARK("rebuild 100k aabbs (all threads)") {
+		bvh.build(boxes);
+		return bvh.size();
+	};
+
+	BENCHMARK("rebuild 100k aabbs (1 thread)") {
+		bvh.build(boxes, 1);
+		return bvh.size();
+	};
+
+	std::vector<std::uint32_t> results;
+	BENCHMARK("1000 aabb queries") {
+		size_t found = 0;
+		for (int i = 0; i < 1000; ++i) {
+			bvh.query(boxes[i * 97], results);
+			found += results.size();
+		}
+		return found;
+	};
+
+	BENCHMARK("1000 raycasts") {
+		size_t found = 0;
+		ch::RaycastHit hit;
+		for (int i = 0; i < 1000; ++i) {
+			found += bvh.raycast(ch::LineSegment(boxes[i].center(), boxes[i + 1000].center()), hit) ? 1 : 0;
+		}
+		return found;
+	};
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("segment bvh raycasts against 50k walls", "[.][benchmark][SegmentBVH]") {
+	std::vector<ch::LineSegment> walls;
+	for (int i = 0; i < 50000; ++i) {
+		ch::vec_t start = ch::rand::rand_vector(0.f, 20000.f, 0.f, 20000.f);
+		walls.emplace_back(start, start + ch::rand::rand_vector(-60.f, 60.f, -60.f, 60.f));
+	}
+
+	std::vector<ch::LineSegment> rays;
+	for (int i = 0; i < 1000; ++i) {
+		ch::vec_t start = ch::rand::rand_vector(0.f, 20000.f, 0.f, 20000.f);
+		rays.emplace_back(start, start + ch::rand::rand_vector(-2000.f, 2000.f, -2000.f, 2000.f));
+	}
+
+	ch::spatial::SegmentBVH bvh;
+	BENCHMARK("build") {
+		bvh.build(walls);
+		return bvh.nodes().size();
+	};
+
+	bvh.build(walls);
+
+	BENCHMARK("1000 closest hits") {
+		size_t hits = 0;
+		ch::RaycastHit hit;
+		for (const auto& ray : rays) {
+			hits += bvh.closestHit(ray, hit) ? 1 : 0;
+		}
+		return hits;
+	};
+
+	BENCHMARK("1000 any hits") {
+		size_t hits = 0;
+		for (const auto& ray : rays) {
+			hits += bvh.anyHit(ray) ? 1 : 0;
+		}
+		return hits;
+	};
+
+	BENCHMARK("10 rays, testing every wall") {
+		size_t hits = 0;
+		for (size_t r = 0; r < 10; ++r) {
+			for (const auto& wall : walls) {
+				hits += ch::collision::line_segments_intersection_info(rays[r], wall).type != ch::IntersectionType::None ? 1 : 0;
+			}
+		}
+		return hits;
+	};
+}
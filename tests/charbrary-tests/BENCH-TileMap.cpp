@@ -0,0 +1,68 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("tile map queries against aabbs built from the tiles", "[.][benchmark][TileMap]") {
+	const std::uint32_t side = 1024;
+	const ch::vec_t tileSize(16.f, 16.f);
+	ch::spatial::TileMap map(side, side, tileSize);
+	std::vector<std::uint8_t> solid(side * side, 0);
+	for (std::uint32_t y = 0; y < side; ++y) {
+		for (std::uint32_t x = 0; x < side; ++x) {
+			if (ch::rand::rand_int(0, 9) == 0) {
+				map.setSolid(x, y);
+				solid[x + y * side] = 1;
+			}
+		}
+	}
+
+	std::vector<ch::AABB> players;
+	for (int i = 0; i < 10000; ++i) {
+		players.emplace_back(ch::rand::rand_vector(0.f, side * 16.f - 40.f, 0.f, side * 16.f - 40.f), ch::vec_t(12.f, 30.f));
+	}
+
+	BENCHMARK("10k aabbs, tile map") {
+		size_t hits = 0;
+		for (const ch::AABB& player : players) {
+			hits += map.intersects(player) ? 1 : 0;
+		}
+		return hits;
+	};
+
+	BENCHMARK("10k aabbs, one aabb per nearby tile") {
+		size_t hits = 0;
+		for (const ch::AABB& player : players) {
+			const int x0 = static_cast<int>(player.pos.x / tileSize.x);
+			const int y0 = static_cast<int>(player.pos.y / tileSize.y);
+			const int x1 = static_cast<int>(std::ceil((player.pos.x + player.size.x) / tileSize.x)) - 1;
+			const int y1 = static_cast<int>(std::ceil((player.pos.y + player.size.y) / tileSize.y)) - 1;
+			bool hit = false;
+			for (int y = y0; y <= y1 && !hit; ++y) {
+				for (int x = x0; x <= x1 && !hit; ++x) {
+					if (solid[x + y * side]) {
+						hit = ch::collision::aabb_collision_info(ch::AABB(ch::vec_t(x * tileSize.x, y * tileSize.y), tileSize), player).normal != ch::NULL_VEC;
+					}
+				}
+			}
+			hits += hit ? 1 : 0;
+		}
+		return hits;
+	};
+
+	std::vector<ch::LineSegment> rays;
+	for (int i = 0; i < 1000; ++i) {
+		rays.emplace_back(ch::rand::rand_vector(0.f, side * 16.f, 0.f, side * 16.f), ch::rand::rand_vector(0.f, side * 16.f, 0.f, side * 16.f));
+	}
+
+	BENCHMARK("1000 raycasts") {
+		size_t hits = 0;
+		ch::RaycastHit hit;
+		for (const ch::LineSegment& ray : rays) {
+			hits += map.raycast(ray, hit) ? 1 : 0;
+		}
+		return hits;
+	};
+}
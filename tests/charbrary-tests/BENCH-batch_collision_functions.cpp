@@ -0,0 +1,96 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("aabb collision info on a list of pairs", "[.][benchmark][Batch collision functions]") {
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 100000; ++i) {
+		boxes.emplace_back(ch::rand::rand_vector(0.f, 200.f, 0.f, 200.f), ch::rand::rand_vector(2.f, 20.f, 2.f, 20.f));
+	}
+	ch::AABBBatch batch(boxes);
+
+	// Each box is paired with the next ones, like the output of a broadphase over sorted boxes
+	std::vector<ch::collision::AABBIndexPair> pairs;
+	for (std::uint32_t i = 0; i + 4 < boxes.size(); ++i) {
+		for (std::uint32_t j = 1; j <= 4; ++j) {
+			pairs.emplace_back(i, i + j);
+		}
+	}
+
+	BENCHMARK("aabb_collision_info on 400k pairs") {
+		float totalDepth = 0.f;
+		for (const auto& pair : pairs) {
+			totalDepth += ch::collision::aabb_collision_info(boxes[pair.first], boxes[pair.second]).absolutePenetrationDepthAlongNormal();
+		}
+		return totalDepth;
+	};
+
+	std::vector<ch::AABBCollision> collisions;
+	BENCHMARK("aabb_collision_batch on 400k pairs") {
+		ch::collision::aabb_collision_batch(batch, pairs, collisions);
+		float totalDepth = 0.f;
+		for (const auto& collision : collisions) {
+			totalDepth += collision.absolutePenetrationDepthAlongNormal();
+		}
+		return totalDepth;
+	};
+}
+
+TEST_CASE("intersection of a mixed list of pairs", "[.][benchmark][Batch collision functions]") {
+	std::vector<ch::AABB> aabbs;
+	std::vector<ch::Circle> circles;
+	std::vector<ch::LineSegment> segments;
+	for (int i = 0; i < 10000; ++i) {
+		aabbs.emplace_back(ch::rand::rand_vector(0.f, 200.f, 0.f, 200.f), ch::rand::rand_vector(2.f, 20.f, 2.f, 20.f));
+		circles.emplace_back(ch::rand::rand_vector(0.f, 200.f, 0.f, 200.f), ch::rand::rand_float(1.f, 10.f));
+		ch::vec_t start = ch::rand::rand_vector(0.f, 200.f, 0.f, 200.f);
+		segments.emplace_back(start, start + ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f));
+	}
+	ch::AABBBatch aabbBatch(aabbs);
+	ch::CircleBatch circleBatch(circles);
+	ch::LineSegmentBatch segmentBatch(segments);
+
+	std::vector<ch::ShapePair> pairs;
+	for (int i = 0; i < 400000; ++i) {
+		ch::ShapeRef first{ static_cast<ch::ShapeType>(ch::rand::rand_int(0, 2)), static_cast<std::uint32_t>(ch::rand::rand_int(0, 9999)) };
+		ch::ShapeRef other{ static_cast<ch::ShapeType>(ch::rand::rand_int(0, 2)), static_cast<std::uint32_t>(ch::rand::rand_int(0, 9999)) };
+		pairs.push_back(ch::ShapePair{ first, other });
+	}
+
+	BENCHMARK("switch on the types of each of 400k pairs") {
+		size_t hits = 0;
+		for (const auto& pair : pairs) {
+			ch::ShapeRef first = pair.first;
+			ch::ShapeRef other = pair.other;
+			if (first.type > other.type) {
+				std::swap(first, other);
+			}
+			bool intersects = false;
+			if (first.type == ch::ShapeType::AABB) {
+				switch (other.type) {
+				case ch::ShapeType::AABB: intersects = ch::collision::aabb_intersects(aabbs[first.index], aabbs[other.index]); break;
+				case ch::ShapeType::Circle: intersects = ch::collision::aabb_intersects(aabbs[first.index], circles[other.index]); break;
+				default: intersects = ch::collision::aabb_intersects(aabbs[first.index], segments[other.index]); break;
+				}
+			}
+			else if (first.type == ch::ShapeType::Circle) {
+				intersects = other.type == ch::ShapeType::Circle
+					? ch::collision::circle_intersects(circles[first.index], circles[other.index])
+					: ch::collision::circle_intersects(circles[first.index], segments[other.index]);
+			}
+			else {
+				intersects = ch::collision::line_segments_parametric_intersection(segments[first.index], segments[other.index]).type != ch::IntersectionType::None;
+			}
+			hits += intersects ? 1 : 0;
+		}
+		return hits;
+	};
+
+	ch::ShapePairDispatcher dispatcher;
+	std::vector<std::uint8_t> results;
+	BENCHMARK("ShapePairDispatcher on 400k pairs") {
+		return dispatcher.intersects(aabbBatch, circleBatch, segmentBatch, pairs, results);
+	};
+}
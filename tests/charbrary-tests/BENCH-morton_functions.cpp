@@ -0,0 +1,76 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	/**
+	 * Builds the candidate pairs of a broadphase (boxes sharing a cell of a uniform grid),
+	 * sorted by the index of the first box, like a real broadphase would output them.
+	 */
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> grid_candidate_pairs(const std::vector<ch::AABB>& boxes, float cellSize) {
+		std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells;
+		for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+			auto cx = static_cast<std::uint64_t>(boxes[i].pos.x / cellSize);
+			auto cy = static_cast<std::uint64_t>(boxes[i].pos.y / cellSize);
+			cells[(cx << 32) | cy].push_back(i);
+		}
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+		for (const auto& cell : cells) {
+			for (size_t a = 0; a < cell.second.size(); ++a) {
+				for (size_t b = a + 1; b < cell.second.size(); ++b) {
+					pairs.emplace_back(std::min(cell.second[a], cell.second[b]), std::max(cell.second[a], cell.second[b]));
+				}
+			}
+		}
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	float narrowphase_pass(const std::vector<ch::AABB>& boxes, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& pairs) {
+		float totalDepth = 0.f;
+		for (const auto& pair : pairs) {
+			totalDepth += ch::collision::aabb_collision_info(boxes[pair.first], boxes[pair.second]).absolutePenetrationDepthAlongNormal();
+		}
+		return totalDepth;
+	}
+}
+
+TEST_CASE("collision pass before and after morton reordering", "[.][benchmark][Morton functions]") {
+	const size_t count = 1000000;
+	ch::AABB world(0.f, 0.f, 20000.f, 20000.f);
+
+	std::vector<ch::AABB> boxes;
+	boxes.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		boxes.emplace_back(ch::rand::rand_vector(0.f, 19990.f, 0.f, 19990.f), ch::vec_t(10.f, 10.f));
+	}
+
+	auto creationOrderPairs = grid_candidate_pairs(boxes, 40.f);
+
+	std::vector<ch::AABB> sortedBoxes = boxes;
+	ch::spatial::morton_sort(sortedBoxes, world);
+	auto mortonOrderPairs = grid_candidate_pairs(sortedBoxes, 40.f);
+
+	BENCHMARK("collision pass, creation order") {
+		return narrowphase_pass(boxes, creationOrderPairs);
+	};
+
+	BENCHMARK("collision pass, morton order") {
+		return narrowphase_pass(sortedBoxes, mortonOrderPairs);
+	};
+
+	BENCHMARK("morton sort of 1M aabbs (all threads)") {
+		std::vector<ch::AABB> copy = boxes;
+		return ch::spatial::morton_sort(copy, world).size();
+	};
+
+	BENCHMARK("morton sort of 1M aabbs (1 thread)") {
+		std::vector<ch::AABB> copy = boxes;
+		return ch::spatial::morton_sort(copy, world, 1).size();
+	};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("all segments intersections", "[.][benchmark][Segments intersection functions]") {
+	std::vector<ch::LineSegment> random;
+	for (int i = 0; i < 100000; ++i) {
+		ch::vec_t start = ch::rand::rand_vector(0.f, 20000.f, 0.f, 20000.f);
+		random.emplace_back(start, start + ch::rand::rand_vector(-80.f, 80.f, -80.f, 80.f));
+	}
+
+	// Walls of a 224 x 224 tile grid : every wall touches its neighbours at its extremities
+	std::vector<ch::LineSegment> grid;
+	for (int y = 0; y < 224; ++y) {
+		for (int x = 0; x < 224; ++x) {
+			grid.emplace_back(ch::vec_t(x * 32.f, y * 32.f), ch::vec_t(x * 32.f + 32.f, y * 32.f));
+			grid.emplace_back(ch::vec_t(x * 32.f, y * 32.f), ch::vec_t(x * 32.f, y * 32.f + 32.f));
+		}
+	}
+
+	// Long parallel walls : their enclosing AABBs all overlap, but none of them intersect
+	std::vector<ch::LineSegment> diagonal;
+	for (int i = 0; i < 10000; ++i) {
+		diagonal.emplace_back(ch::vec_t(i * 0.5f, 0.f), ch::vec_t(i * 0.5f + 10000.f, 10000.f));
+	}
+
+	std::vector<ch::LineSegment> smallRandom(random.begin(), random.begin() + 5000);
+
+	BENCHMARK("100k random segments") {
+		return ch::collision::all_line_segments_intersections(random).size();
+	};
+
+	BENCHMARK("100k grid walls") {
+		return ch::collision::all_line_segments_intersections(grid).size();
+	};
+
+	BENCHMARK("10k diagonal walls") {
+		return ch::collision::all_line_segments_intersections(diagonal).size();
+	};
+
+	BENCHMARK("5k random segments") {
+		return ch::collision::all_line_segments_intersections(smallRandom).size();
+	};
+
+	BENCHMARK("5k random segments, testing every pair") {
+		size_t count = 0;
+		for (size_t i = 0; i < smallRandom.size(); ++i) {
+			for (size_t j = i + 1; j < smallRandom.size(); ++j) {
+				count += ch::collision::line_segments_intersection_info(smallRandom[i], smallRandom[j]).type != ch::IntersectionType::None ? 1 : 0;
+			}
+		}
+		return count;
+	};
+}
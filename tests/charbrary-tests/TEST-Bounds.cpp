@@ -0,0 +1,75 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("construct bounds from 4 floats", "[Bounds]") {
+	ch::Bounds bounds(3.f, 5.f, 9.f, 8.f);
+
+	REQUIRE(bounds.min == ch::vec_t(3.f, 5.f));
+	REQUIRE(bounds.max == ch::vec_t(9.f, 8.f));
+	REQUIRE(bounds.size() == ch::vec_t(6.f, 3.f));
+	REQUIRE(bounds.center() == ch::vec_t(6.f, 6.5f));
+	REQUIRE(bounds.area() == 18.f);
+	REQUIRE(bounds.perimeter() == 18.f);
+}
+
+TEST_CASE("default construct bounds", "[Bounds]") {
+	ch::Bounds bounds;
+
+	REQUIRE(bounds.min == ch::NULL_VEC);
+	REQUIRE(bounds.max == ch::NULL_VEC);
+}
+
+TEST_CASE("convert an aabb to bounds and back", "[Bounds]") {
+	ch::AABB aabb(-4.f, 2.5f, 10.f, 0.25f);
+	ch::Bounds bounds(aabb);
+
+	REQUIRE(bounds.min == ch::vec_t(-4.f, 2.5f));
+	REQUIRE(bounds.max == ch::vec_t(6.f, 2.75f));
+	REQUIRE(bounds.toAABB() == aabb);
+}
+
+TEST_CASE("move bounds", "[Bounds]") {
+	ch::Bounds bounds(0.f, 0.f, 2.f, 3.f);
+	bounds.move({ 1.f, -1.f });
+
+	REQUIRE(bounds == ch::Bounds(1.f, -1.f, 3.f, 2.f));
+	REQUIRE(bounds != ch::Bounds(0.f, 0.f, 2.f, 3.f));
+}
+
+TEST_CASE("collision functions give the same results for bounds and aabbs", "[Bounds]") {
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 200; ++i) {
+		boxes.emplace_back(std::floor(ch::rand::rand_float(0.f, 40.f)), std::floor(ch::rand::rand_float(0.f, 40.f)), std::floor(ch::rand::rand_float(0.f, 15.f)), std::floor(ch::rand::rand_float(0.f, 15.f)));
+	}
+	ch::Circle circle({ 20.5f, 19.f }, 7.f);
+	ch::LineSegment segment({ -3.f, 10.f }, { 45.f, 28.f });
+	ch::vec_t point(12.f, 12.f);
+
+	for (size_t i = 0; i + 1 < boxes.size(); ++i) {
+		const ch::AABB& a = boxes[i];
+		const ch::AABB& b = boxes[i + 1];
+		ch::Bounds boundsA(a);
+		ch::Bounds boundsB(b);
+
+		REQUIRE(ch::collision::aabb_intersects(boundsA, boundsB) == ch::collision::aabb_intersects(a, b));
+		REQUIRE(ch::collision::aabb_contains(boundsA, boundsB) == ch::collision::aabb_contains(a, b));
+		REQUIRE(ch::collision::aabb_contains(boundsA, point) == ch::collision::aabb_contains(a, point));
+		REQUIRE(ch::collision::aabb_contains(boundsA, circle) == ch::collision::aabb_contains(a, circle));
+		REQUIRE(ch::collision::aabb_intersects(boundsA, circle) == ch::collision::aabb_intersects(a, circle));
+		REQUIRE(ch::collision::aabb_intersects(boundsA, segment) == ch::collision::aabb_intersects(a, segment));
+		REQUIRE(ch::collision::circle_contains(circle, boundsA) == ch::collision::circle_contains(circle, a));
+
+		auto boundsCollision = ch::collision::aabb_collision_info(boundsA, boundsB);
+		auto aabbCollision = ch::collision::aabb_collision_info(a, b);
+		REQUIRE(boundsCollision.normal == aabbCollision.normal);
+		REQUIRE(boundsCollision.delta == aabbCollision.delta);
+
+		auto boundsCircleCollision = ch::collision::circle_aabb_collision_info(boundsA, circle);
+		auto aabbCircleCollision = ch::collision::circle_aabb_collision_info(a, circle);
+		REQUIRE(boundsCircleCollision.normal == aabbCircleCollision.normal);
+		REQUIRE(boundsCircleCollision.absoluteDepth == aabbCircleCollision.absoluteDepth);
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+TEST_CASE("capsule bounds include the radius around the segment", "[Capsule]") {
+	ch::Capsule capsule({ 2.f, 8.f }, { 2.f, 3.f }, 1.5f);
+	REQUIRE(capsule.center() == ch::vec_t(2.f, 5.5f));
+	REQUIRE(capsule.bounds() == ch::Bounds(0.5f, 1.5f, 3.5f, 9.5f));
+	REQUIRE(capsule.aabb() == ch::AABB(0.5f, 1.5f, 3.f, 8.f));
+
+	capsule.move({ 1.f, -1.f });
+	REQUIRE(capsule == ch::Capsule(ch::LineSegment({ 3.f, 7.f }, { 3.f, 2.f }), 1.5f));
+	REQUIRE(capsule != ch::Capsule(ch::LineSegment({ 3.f, 7.f }, { 3.f, 2.f }), 1.f));
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <cmath>
+#include <vector>
+
+// Random mask, roughly one pixel out of density solid
+ch::CollisionMask collision_mask_test_random(std::uint32_t width, std::uint32_t height, int density) {
+	std::vector<std::uint8_t> alpha(width * height, 0);
+	for (std::uint8_t& value : alpha) {
+		value = ch::rand::rand_int(0, density - 1) == 0 ? 255 : 0;
+	}
+	return ch::CollisionMask(width, height, alpha);
+}
+
+TEST_CASE("collision mask stores the solid pixels", "[CollisionMask]") {
+	// 3x2 sprite, only the opaque enough pixels are solid
+	const ch::CollisionMask mask(3, 2, { 0, 200, 10, 255, 0, 128 }, 127);
+	REQUIRE(mask.width() == 3);
+	REQUIRE(mask.height() == 2);
+	REQUIRE_FALSE(mask.isSolid(0, 0));
+	REQUIRE(mask.isSolid(1, 0));
+	REQUIRE_FALSE(mask.isSolid(2, 0));
+	REQUIRE(mask.isSolid(0, 1));
+	REQUIRE(mask.isSolid(2, 1));
+	REQUIRE_FALSE(mask.isSolid(3, 1));
+	REQUIRE_FALSE(mask.isSolid(-1, 0));
+	REQUIRE(mask.aabb(ch::vec_t(1.5f, -0.5f)) == ch::AABB(1.f, -1.f, 3.f, 2.f));
+
+	REQUIRE_THROWS_AS(ch::CollisionMask(0, 2, {}), std::invalid_argument);
+	REQUIRE_THROWS_AS(ch::CollisionMask(3, 2, { 0, 0, 0 }), std::invalid_argument);
+}
+
+TEST_CASE("collision masks only collide where solid pixels overlap", "[CollisionMask]") {
+	// Two diagonal lines of 100 pixels
+	std::vector<std::uint8_t> alpha(100 * 100, 0);
+	for (int i = 0; i < 100; ++i) {
+		alpha[i + i * 100] = 255;
+	}
+	const ch::CollisionMask diagonal(100, 100, alpha);
+	const ch::vec_t position(-20.f, 10.f);
+
+	// The AABBs overlap but the lines are parallel
+	REQUIRE_FALSE(diagonal.intersects(position, diagonal, position + ch::vec_t(70.f, 0.f)));
+	REQUIRE_FALSE(diagonal.intersects(position, diagonal, position + ch::vec_t(0.f, 1.f)));
+	REQUIRE(diagonal.intersects(position, diagonal, position + ch::vec_t(0.9f, 0.5f)));
+	REQUIRE(diagonal.intersects(position, diagonal, position + ch::vec_t(-70.f, -70.f)));
+	REQUIRE(diagonal.intersects(position + ch::vec_t(-70.f, -70.f), diagonal, position));
+
+	// Touching AABBs : no pixel in common
+	const ch::CollisionMask full(10, 10, std::vector<std::uint8_t>(100, 255));
+	REQUIRE_FALSE(full.intersects(position, full, position + ch::vec_t(10.f, 0.f)));
+	REQUIRE(full.intersects(position, full, position + ch::vec_t(9.f, 9.f)));
+}
+
+TEST_CASE("collision masks agree with testing every pixel", "[CollisionMask]") {
+	const ch::CollisionMask first = collision_mask_test_random(ch::rand::rand_int(1, 200), ch::rand::rand_int(1, 50), ch::rand::rand_int(1, 400));
+	const ch::CollisionMask other = collision_mask_test_random(ch::rand::rand_int(1, 200), ch::rand::rand_int(1, 50), ch::rand::rand_int(1, 400));
+	const ch::vec_t position = ch::rand::rand_vector(-100.f, 100.f, -100.f, 100.f);
+
+	for (int i = 0; i < 200; ++i) {
+		const ch::vec_t otherPosition = position + ch::rand::rand_vector(-210.f, 210.f, -60.f, 60.f);
+
+		// Every pixel of the first mask against the pixel of the other mask at the same place
+		const std::int64_t dx = static_cast<std::int64_t>(std::floor(otherPosition.x)) - static_cast<std::int64_t>(std::floor(position.x));
+		const std::int64_t dy = static_cast<std::int64_t>(std::floor(otherPosition.y)) - static_cast<std::int64_t>(std::floor(position.y));
+		bool expected = false;
+		for (std::int64_t y = 0; y < first.height() && !expected; ++y) {
+			for (std::int64_t x = 0; x < first.width() && !expected; ++x) {
+				expected = first.isSolid(x, y) && other.isSolid(x - dx, y - dy);
+			}
+		}
+
+		REQUIRE(first.intersects(position, other, otherPosition) == expected);
+		REQUIRE(other.intersects(otherPosition, first, position) == expected);
+	}
+}
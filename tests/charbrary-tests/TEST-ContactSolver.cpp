@@ -0,0 +1,187 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("contact solver bounces colliding bodies", "[ContactSolver]") {
+	const ch::Circle left(ch::vec_t(0.f, 0.f), 1.f);
+	const ch::Circle right(ch::vec_t(1.9f, 0.f), 1.f);
+
+	std::vector<ch::vec_t> positions{ left.pos, right.pos };
+	std::vector<float> inverseMasses{ 1.f, 1.f };
+
+	// Elastic : equal masses exchange their velocities
+	ch::ContactSolver solver(8, 3, 0.01f, 1.f);
+	std::vector<ch::vec_t> velocities{ ch::vec_t(10.f, 0.f), ch::vec_t(-4.f, 0.f) };
+	solver.addContact(0, 1, ch::collision::circles_collision_info(left, right), 1.f, 0.f);
+	REQUIRE(solver.size() == 1);
+	solver.solve(positions, velocities, inverseMasses, 0.01f);
+	REQUIRE(velocities[0].x == Approx(-4.f));
+	REQUIRE(velocities[1].x == Approx(10.f));
+	REQUIRE(solver.normalImpulse(0) == Approx(14.f));
+	REQUIRE(solver.colorCount() == 1);
+
+	// Inelastic : both bodies end up moving at the average velocity
+	solver.newFrame();
+	REQUIRE(solver.size() == 0);
+	positions = { left.pos, right.pos };
+	velocities = { ch::vec_t(10.f, 0.f), ch::vec_t(-4.f, 0.f) };
+	solver.addContact(0, 1, ch::collision::circles_collision_info(left, right), 0.f, 0.f);
+	// Not a collision : ignored
+	solver.addContact(0, 1, ch::collision::circles_collision_info(left, ch::Circle(ch::vec_t(10.f, 0.f), 1.f)), 0.f, 0.f);
+	REQUIRE(solver.size() == 1);
+	solver.solve(positions, velocities, inverseMasses, 0.01f);
+	REQUIRE(velocities[0].x == Approx(3.f));
+	REQUIRE(velocities[1].x == Approx(3.f));
+
+	// A static body isn't moved
+	solver.newFrame();
+	positions = { left.pos, right.pos };
+	velocities = { ch::vec_t(10.f, 0.f), ch::NULL_VEC };
+	inverseMasses = { 1.f, 0.f };
+	solver.addContact(0, 1, ch::collision::circles_collision_info(left, right), 0.5f, 0.f);
+	solver.solve(positions, velocities, inverseMasses, 0.01f);
+	REQUIRE(velocities[0].x == Approx(-5.f));
+	REQUIRE(velocities[1] == ch::NULL_VEC);
+	REQUIRE(positions[1] == right.pos);
+
+	solver.newFrame();
+	REQUIRE_THROWS_AS(solver.addContact(1, 1, ch::DOWN_VEC, 1.f, 0.f, 0.f), std::invalid_argument);
+	solver.addContact(0, 2, ch::DOWN_VEC, 1.f, 0.f, 0.f);
+	REQUIRE_THROWS_AS(solver.solve(positions, velocities, inverseMasses, 0.01f), std::invalid_argument);
+	inverseMasses.push_back(1.f);
+	REQUIRE_THROWS_AS(solver.solve(positions, velocities, inverseMasses, 0.01f), std::invalid_argument);
+	REQUIRE_THROWS_AS(solver.normalImpulse(1), std::out_of_range);
+}
+
+TEST_CASE("contact solver keeps a box at rest on the floor", "[ContactSolver]") {
+	const float dt = 1.f / 60.f;
+	const ch::vec_t gravity(0.f, 500.f);
+	const ch::AABB floor(ch::vec_t(-100.f, 100.f), ch::vec_t(200.f, 20.f));
+	const ch::vec_t boxSize(10.f, 10.f);
+
+	// Falling box, sliding to the right on the floor. The normal pushes the box (other) up.
+	std::vector<ch::vec_t> positions{ floor.pos, ch::vec_t(0.f, 80.f) };
+	std::vector<ch::vec_t> velocities{ ch::NULL_VEC, ch::vec_t(50.f, 0.f) };
+	const std::vector<float> inverseMasses{ 0.f, 0.5f };
+
+	ch::ContactSolver solver(4, 2, 0.01f, 1.f);
+	float lastNormalImpulse = 0.f;
+	for (int tick = 0; tick < 240; ++tick) {
+		solver.newFrame();
+		velocities[1] += gravity * dt;
+		solver.addContact(0, 1, ch::collision::aabb_collision_info(floor, ch::AABB(positions[1], boxSize)), 0.f, 0.5f);
+		solver.solve(positions, velocities, inverseMasses, dt);
+		if (solver.size() == 1) {
+			lastNormalImpulse = solver.normalImpulse(0);
+		}
+	}
+
+	// Resting on the floor : the contact cancels the gravity (mass 2) and the friction stopped the box
+	REQUIRE(positions[1].y + boxSize.y == Approx(floor.pos.y).margin(0.1f));
+	REQUIRE(std::abs(velocities[1].y) < 0.1f);
+	REQUIRE(velocities[1].x == Approx(0.f).margin(0.01f));
+	REQUIRE(lastNormalImpulse == Approx(2.f * gravity.y * dt).epsilon(0.01f));
+	REQUIRE(positions[0] == floor.pos);
+
+	// Without friction, a box sliding on the floor keeps its speed
+	velocities[1] = ch::vec_t(50.f, 0.f);
+	for (int tick = 0; tick < 10; ++tick) {
+		solver.newFrame();
+		velocities[1] += gravity * dt;
+		solver.addContact(0, 1, ch::collision::aabb_collision_info(floor, ch::AABB(positions[1], boxSize)), 0.f, 0.f);
+		solver.solve(positions, velocities, inverseMasses, dt);
+	}
+	REQUIRE(velocities[1].x == Approx(50.f));
+}
+
+TEST_CASE("contact solver warm starts the pairs that keep touching", "[ContactSolver]") {
+	const ch::Circle ground(ch::vec_t(0.f, 0.f), 1.f);
+	const ch::Circle ball(ch::vec_t(0.f, -1.95f), 1.f);
+	const std::vector<float> inverseMasses{ 0.f, 1.f };
+
+	// No iteration : only the impulse of the previous tick is applied
+	ch::ContactSolver solver(0, 0);
+	std::vector<ch::vec_t> positions{ ground.pos, ball.pos };
+	std::vector<ch::vec_t> velocities{ ch::NULL_VEC, ch::vec_t(0.f, 1.f) };
+	solver.addContact(0, 1, ch::collision::circles_collision_info(ground, ball), 0.f, 0.f);
+	solver.solve(positions, velocities, inverseMasses, 0.01f);
+	REQUIRE(solver.normalImpulse(0) == 0.f);
+
+	ch::ContactSolver warmSolver(1, 0);
+	warmSolver.addContact(0, 1, ch::collision::circles_collision_info(ground, ball), 0.f, 0.f);
+	velocities = { ch::NULL_VEC, ch::vec_t(0.f, 1.f) };
+	warmSolver.solve(positions, velocities, inverseMasses, 0.01f);
+	REQUIRE(warmSolver.normalImpulse(0) == Approx(1.f));
+
+	// Same pair, given in the other order : the impulse is reused
+	warmSolver.newFrame();
+	velocities = { ch::NULL_VEC, ch::vec_t(0.f, 1.f) };
+	warmSolver.addContact(1, 0, ch::collision::circles_collision_info(ball, ground), 0.f, 0.f);
+	warmSolver.solve(positions, velocities, inverseMasses, 0.01f);
+	REQUIRE(warmSolver.normalImpulse(0) == Approx(1.f));
+	REQUIRE(velocities[1].y == Approx(0.f).margin(0.0001f));
+
+	// The normal changed too much : the impulse of the previous tick is dropped
+	warmSolver.newFrame();
+	velocities = { ch::NULL_VEC, ch::NULL_VEC };
+	warmSolver.addContact(0, 1, ch::RIGHT_VEC, 0.05f, 0.f, 0.f);
+	warmSolver.solve(positions, velocities, inverseMasses, 0.01f);
+	REQUIRE(warmSolver.normalImpulse(0) == 0.f);
+	REQUIRE(velocities[1] == ch::NULL_VEC);
+}
+
+TEST_CASE("parallel contact solver gives the same results as a single thread", "[ContactSolver]") {
+	// Grid of circles, each touching its neighbours, with random velocities
+	const int columns = ch::rand::rand_int(5, 60);
+	const int rows = ch::rand::rand_int(5, 60);
+	std::vector<ch::Circle> circles;
+	std::vector<ch::vec_t> velocities;
+	std::vector<float> inverseMasses;
+	for (int y = 0; y < rows; ++y) {
+		for (int x = 0; x < columns; ++x) {
+			circles.emplace_back(ch::vec_t(x * 1.9f, y * 1.9f), 1.f);
+			velocities.push_back(ch::rand::rand_vector(-5.f, 5.f, -5.f, 5.f));
+			inverseMasses.push_back(y == rows - 1 ? 0.f : ch::rand::rand_float(0.5f, 2.f));
+		}
+	}
+
+	std::vector<ch::vec_t> positions;
+	for (const auto& circle : circles) {
+		positions.push_back(circle.pos);
+	}
+
+	ch::ContactSolver sequential(8, 3, 0.01f, 1.f, 1);
+	ch::ContactSolver parallel(8, 3, 0.01f, 1.f, 4);
+	std::vector<ch::vec_t> sequentialPositions = positions;
+	std::vector<ch::vec_t> sequentialVelocities = velocities;
+	std::vector<ch::vec_t> parallelPositions = positions;
+	std::vector<ch::vec_t> parallelVelocities = velocities;
+
+	for (int tick = 0; tick < 3; ++tick) {
+		sequential.newFrame();
+		parallel.newFrame();
+		for (int i = 0; i < rows * columns; ++i) {
+			for (int j : { i + 1, i + columns }) {
+				if (j >= rows * columns || (j == i + 1 && j % columns == 0)) {
+					continue;
+				}
+				const ch::Circle first(sequentialPositions[i], 1.f);
+				const ch::Circle other(sequentialPositions[j], 1.f);
+				sequential.addContact(i, j, ch::collision::circles_collision_info(first, other), 0.3f, 0.4f);
+				parallel.addContact(i, j, ch::collision::circles_collision_info(first, other), 0.3f, 0.4f);
+			}
+		}
+		sequential.solve(sequentialPositions, sequentialVelocities, inverseMasses, 0.01f);
+		parallel.solve(parallelPositions, parallelVelocities, inverseMasses, 0.01f);
+
+		// Each contact shares its bodies with at most 6 other contacts
+		REQUIRE(parallel.colorCount() == sequential.colorCount());
+		REQUIRE(parallel.colorCount() <= 7);
+		for (int i = 0; i < rows * columns; ++i) {
+			REQUIRE(parallelPositions[i] == sequentialPositions[i]);
+			REQUIRE(parallelVelocities[i] == sequentialVelocities[i]);
+		}
+	}
+}
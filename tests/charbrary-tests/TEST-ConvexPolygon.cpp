@@ -0,0 +1,55 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("convex polygon stores its vertices with outward normals", "[ConvexPolygon]") {
+	// Clockwise and counter-clockwise orders give the same normals
+	ch::ConvexPolygon clockwise({ { 0.f, 0.f }, { 4.f, 0.f }, { 4.f, 2.f }, { 0.f, 2.f } });
+	ch::ConvexPolygon counterClockwise({ { 0.f, 2.f }, { 4.f, 2.f }, { 4.f, 0.f }, { 0.f, 0.f } });
+
+	for (const ch::ConvexPolygon* polygon : { &clockwise, &counterClockwise }) {
+		REQUIRE(polygon->size() == 4);
+		for (size_t i = 0; i < polygon->size(); ++i) {
+			ch::vec_t edgeMiddle = (polygon->vertex(i) + polygon->vertex((i + 1) % polygon->size())) / 2.f;
+			REQUIRE(ch::vec_dot_product(polygon->normal(i), edgeMiddle - polygon->center()) > 0.f);
+			REQUIRE(ch::vec_magnitude(polygon->normal(i)) == Approx(1.f));
+		}
+	}
+	REQUIRE(clockwise.center() == ch::vec_t(2.f, 1.f));
+	REQUIRE(clockwise.bounds() == ch::Bounds(0.f, 0.f, 4.f, 2.f));
+	REQUIRE(clockwise.aabb() == ch::AABB(0.f, 0.f, 4.f, 2.f));
+}
+
+TEST_CASE("convex polygon rejects invalid vertices", "[ConvexPolygon]") {
+	REQUIRE_THROWS_AS(ch::ConvexPolygon(std::vector<ch::vec_t>{ { 0.f, 0.f }, { 1.f, 0.f } }), std::invalid_argument);
+	REQUIRE_THROWS_AS(ch::ConvexPolygon(std::vector<ch::vec_t>(ch::ConvexPolygon::MAX_VERTICES + 1, ch::NULL_VEC)), std::invalid_argument);
+
+	// Concave
+	REQUIRE_THROWS_AS(ch::ConvexPolygon({ { 0.f, 0.f }, { 4.f, 0.f }, { 1.f, 1.f }, { 0.f, 4.f } }), std::invalid_argument);
+	// Flat
+	REQUIRE_THROWS_AS(ch::ConvexPolygon({ { 0.f, 0.f }, { 1.f, 1.f }, { 2.f, 2.f } }), std::invalid_argument);
+	// Repeated vertex
+	REQUIRE_THROWS_AS(ch::ConvexPolygon({ { 0.f, 0.f }, { 4.f, 0.f }, { 4.f, 0.f }, { 4.f, 4.f }, { 0.f, 4.f } }), std::invalid_argument);
+	// Self-intersecting, every turn in the same direction
+	REQUIRE_THROWS_AS(ch::ConvexPolygon({ { 0.f, 0.f }, { 2.f, 4.f }, { 4.f, 0.f }, { 0.f, 3.f }, { 4.f, 3.f } }), std::invalid_argument);
+}
+
+TEST_CASE("convex polygon moves and rotates with its bounds", "[ConvexPolygon]") {
+	ch::ConvexPolygon polygon(ch::AABB(0.f, 0.f, 4.f, 2.f));
+	polygon.move({ 1.f, 1.f });
+	REQUIRE(polygon.bounds() == ch::Bounds(1.f, 1.f, 5.f, 3.f));
+
+	polygon.rotate(90.f);
+	REQUIRE(polygon.center().x == Approx(3.f));
+	REQUIRE(polygon.center().y == Approx(2.f));
+	REQUIRE(polygon.bounds().min.x == Approx(2.f));
+	REQUIRE(polygon.bounds().min.y == Approx(0.f).margin(1e-5));
+	REQUIRE(polygon.bounds().max.x == Approx(4.f));
+	REQUIRE(polygon.bounds().max.y == Approx(4.f));
+	for (size_t i = 0; i < polygon.size(); ++i) {
+		REQUIRE(ch::vec_magnitude(polygon.normal(i)) == Approx(1.f));
+	}
+}
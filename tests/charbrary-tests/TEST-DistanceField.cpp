@@ -0,0 +1,119 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Signed distance to the closest shape, testing every shape
+float distance_field_test_distance(const std::vector<ch::AABB>& aabbs, const std::vector<ch::Circle>& circles, const std::vector<ch::LineSegment>& segments, const ch::vec_t& point) {
+	float distance = std::numeric_limits<float>::max();
+	for (const ch::AABB& aabb : aabbs) {
+		const ch::vec_t closest = ch::collision::closest_point_on_aabb(aabb, point);
+		if (closest == point) {
+			const float inside = std::min({ point.x - aabb.pos.x, aabb.pos.x + aabb.size.x - point.x, point.y - aabb.pos.y, aabb.pos.y + aabb.size.y - point.y });
+			distance = std::min(distance, -inside);
+		}
+		else {
+			distance = std::min(distance, ch::vec_magnitude(point - closest));
+		}
+	}
+	for (const ch::Circle& circle : circles) {
+		distance = std::min(distance, ch::vec_magnitude(point - circle.pos) - circle.radius);
+	}
+	for (const ch::LineSegment& segment : segments) {
+		distance = std::min(distance, ch::vec_magnitude(point - ch::collision::closest_point_on_segment(segment, point)));
+	}
+	return distance;
+}
+
+TEST_CASE("distance field samples the distance to a wall", "[DistanceField]") {
+	ch::spatial::DistanceField field(ch::Bounds(-50.f, -50.f, 150.f, 60.f), 1.f);
+	REQUIRE(field.columns() == 201);
+	REQUIRE(field.rows() == 111);
+	REQUIRE(field.nodePosition(3, 2) == ch::vec_t(-47.f, -48.f));
+	REQUIRE(field.nodeDistance(0, 0) == std::numeric_limits<float>::max());
+	REQUIRE_FALSE(field.intersects(ch::Circle({ 0.f, 0.f }, 10.f)));
+
+	field.bake({ ch::AABB(0.f, 0.f, 100.f, 10.f) }, {}, {}, 1);
+	REQUIRE(field.distance(ch::vec_t(50.f, 20.f)) == Approx(10.f));
+	REQUIRE(field.distance(ch::vec_t(50.5f, 5.5f)) == Approx(-4.5f));
+	REQUIRE(field.distance(ch::vec_t(-20.f, 5.f)) == Approx(20.f));
+	REQUIRE(field.normal(ch::vec_t(50.5f, 20.5f)) == ch::DOWN_VEC);
+	REQUIRE(field.normal(ch::vec_t(-20.f, 5.f)) == ch::LEFT_VEC);
+
+	// Outside of the area of the field
+	REQUIRE(field.distance(ch::vec_t(50.f, 100.f)) == Approx(90.f));
+
+	// Circle sinking into the bottom of the wall
+	const ch::Circle circle({ 50.f, 18.f }, 10.f);
+	ch::vec_t normal;
+	REQUIRE(field.intersects(circle));
+	REQUIRE(field.penetration(circle, normal) == Approx(2.f));
+	REQUIRE(normal == ch::DOWN_VEC);
+	REQUIRE(field.resolve(circle).y == Approx(2.f));
+	REQUIRE_FALSE(field.intersects(ch::Circle({ 50.f, 25.f }, 10.f)));
+	REQUIRE(field.resolve(ch::Circle({ 50.f, 25.f }, 10.f)) == ch::NULL_VEC);
+
+	REQUIRE_THROWS_AS(field.nodeDistance(201, 0), std::out_of_range);
+	REQUIRE_THROWS_AS(ch::spatial::DistanceField(ch::Bounds(0.f, 0.f, 10.f, 10.f), 0.f), std::invalid_argument);
+	REQUIRE_THROWS_AS(ch::spatial::DistanceField(ch::Bounds(0.f, 0.f, 0.f, 10.f), 1.f), std::invalid_argument);
+}
+
+TEST_CASE("distance field agrees with testing every shape", "[DistanceField]") {
+	const ch::Bounds area(0.f, 0.f, ch::rand::rand_float(50.f, 300.f), ch::rand::rand_float(50.f, 300.f));
+	const float cellSize = ch::rand::rand_float(0.5f, 4.f);
+
+	// Shapes inside of the area that don't overlap each other
+	std::vector<ch::AABB> aabbs;
+	std::vector<ch::Circle> circles;
+	std::vector<ch::LineSegment> segments;
+	std::vector<ch::Bounds> occupied;
+	const int shapeCount = ch::rand::rand_int(1, 30);
+	for (int i = 0; i < shapeCount; ++i) {
+		const ch::vec_t position = ch::rand::rand_vector(area.min.x, area.max.x, area.min.y, area.max.y);
+		const int type = ch::rand::rand_int(0, 2);
+		const ch::AABB aabb(position, ch::rand::rand_vector(1.f, 40.f, 1.f, 40.f));
+		const ch::Circle circle(position, ch::rand::rand_float(1.f, 20.f));
+		const ch::LineSegment segment(position, position + ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f));
+		const ch::Bounds bounds = type == 0 ? ch::Bounds(aabb) : type == 1 ? ch::collision::enclosingBounds(circle) : ch::collision::enclosingBounds(segment);
+		if (std::any_of(occupied.begin(), occupied.end(), [&](const ch::Bounds& other) { return ch::collision::aabb_intersects(bounds, other); })) {
+			continue;
+		}
+		occupied.push_back(bounds);
+		switch (type) {
+		case 0:
+			aabbs.push_back(aabb);
+			break;
+		case 1:
+			circles.push_back(circle);
+			break;
+		default:
+			segments.push_back(segment);
+			break;
+		}
+	}
+
+	ch::spatial::DistanceField field(area, cellSize);
+	field.bake(aabbs, circles, segments, 1);
+	ch::spatial::DistanceField parallelField(area, cellSize);
+	parallelField.bake(aabbs, circles, segments, 4);
+
+	// The nodes hold the distance to the closest shape, whatever the number of threads. Jump flooding can
+	// keep a shape that is almost as close as the closest one : never closer, and only by a fraction of a cell.
+	for (std::uint32_t y = 0; y < field.rows(); ++y) {
+		for (std::uint32_t x = 0; x < field.columns(); ++x) {
+			const float expected = distance_field_test_distance(aabbs, circles, segments, field.nodePosition(x, y));
+			REQUIRE(parallelField.nodeDistance(x, y) == field.nodeDistance(x, y));
+			REQUIRE(field.nodeDistance(x, y) >= expected - 0.001f);
+			REQUIRE(field.nodeDistance(x, y) == Approx(expected).margin(0.1f * cellSize));
+		}
+	}
+
+	// Between the nodes, the interpolation is off by less than a cell
+	for (int i = 0; i < 1000; ++i) {
+		const ch::vec_t point = ch::rand::rand_vector(area.min.x, area.max.x, area.min.y, area.max.y);
+		REQUIRE(field.distance(point) == Approx(distance_field_test_distance(aabbs, circles, segments, point)).margin(cellSize));
+	}
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("kinematic mover lands on the floor and slides along it", "[KinematicMover]") {
+	// Floor, with a wall on the right
+	const std::vector<ch::AABB> obstacles{ ch::AABB(0.f, 100.f, 200.f, 20.f), ch::AABB(150.f, 0.f, 20.f, 100.f) };
+	ch::spatial::LBVH broadphase;
+	broadphase.build(obstacles);
+	ch::spatial::KinematicMover mover(4, 0.01f);
+
+	// Falling to the right : stops on the floor and keeps moving horizontally
+	ch::AABB player(10.f, 50.f, 10.f, 20.f);
+	ch::spatial::MoveResult result = mover.moveAndSlide(player, { 20.f, 60.f }, broadphase, obstacles);
+	REQUIRE(result.contactCount == 1);
+	REQUIRE(result.contacts[0].index == 0);
+	REQUIRE(result.contacts[0].normal == ch::UP_VEC);
+	REQUIRE(result.position.x == Approx(30.f).margin(0.02f));
+	REQUIRE(result.position.y + player.size.y == Approx(100.f).margin(0.02f));
+	REQUIRE(result.position.y + player.size.y < 100.f);
+
+	// Walking on the floor, with gravity : one contact with the floor every tick, no vertical drift
+	player.pos = result.position;
+	for (int tick = 0; tick < 10; ++tick) {
+		result = mover.moveAndSlide(player, { 5.f, 1.f }, broadphase, obstacles);
+		REQUIRE(result.contactCount >= 1);
+		REQUIRE(result.contacts[0].normal == ch::UP_VEC);
+		REQUIRE(result.position.x == Approx(player.pos.x + 5.f).margin(0.02f));
+		REQUIRE(result.position.y + player.size.y == Approx(100.f).margin(0.02f));
+		player.pos = result.position;
+	}
+
+	// Walking slowly : the skin width kept from the floor doesn't slow the player down
+	for (int tick = 0; tick < 10; ++tick) {
+		result = mover.moveAndSlide(player, { 0.5f, 0.5f }, broadphase, obstacles);
+		REQUIRE(result.position.x == Approx(player.pos.x + 0.5f).margin(0.0005f));
+		REQUIRE(result.position.y + player.size.y == Approx(100.f).margin(0.02f));
+		player.pos = result.position;
+	}
+
+	// Running into the corner between the floor and the wall : blocked by both
+	result = mover.moveAndSlide(player, { 200.f, 1.f }, broadphase, obstacles);
+	REQUIRE(result.contactCount == 2);
+	REQUIRE(result.position.x + player.size.x == Approx(150.f).margin(0.02f));
+	REQUIRE(result.position.x + player.size.x < 150.f);
+	REQUIRE(result.position.y + player.size.y < 100.f);
+	bool hitWall = false;
+	for (std::uint32_t i = 0; i < result.contactCount; ++i) {
+		hitWall = hitWall || (result.contacts[i].index == 1 && result.contacts[i].normal == ch::LEFT_VEC);
+	}
+	REQUIRE(hitWall);
+
+	// Jumping along the wall : slides up
+	player.pos = result.position;
+	result = mover.moveAndSlide(player, { 10.f, -30.f }, broadphase, obstacles);
+	REQUIRE(result.contactCount == 1);
+	REQUIRE(result.contacts[0].index == 1);
+	REQUIRE(result.position.y == Approx(player.pos.y - 30.f).margin(0.02f));
+
+	REQUIRE_THROWS_AS(ch::spatial::KinematicMover(0), std::invalid_argument);
+	REQUIRE_THROWS_AS(ch::spatial::KinematicMover(ch::spatial::MAX_SLIDE_ITERATIONS + 1), std::invalid_argument);
+}
+
+TEST_CASE("kinematic mover slides a circle and pushes it out of obstacles", "[KinematicMover]") {
+	const std::vector<ch::AABB> obstacles{ ch::AABB(0.f, 100.f, 200.f, 20.f) };
+	ch::spatial::LBVH broadphase;
+	broadphase.build(obstacles);
+	ch::spatial::KinematicMover mover;
+
+	// Sliding on the floor
+	ch::spatial::MoveResult result = mover.moveAndSlide(ch::Circle({ 50.f, 80.f }, 10.f), { 30.f, 30.f }, broadphase, obstacles);
+	REQUIRE(result.contactCount == 1);
+	REQUIRE(result.contacts[0].normal == ch::UP_VEC);
+	REQUIRE(result.position.x > 60.f);
+	REQUIRE(result.position.y == Approx(90.f).margin(0.02f));
+
+	// Overlapping the floor before moving : pushed out first
+	result = mover.moveAndSlide(ch::Circle({ 50.f, 95.f }, 10.f), { 10.f, 0.f }, broadphase, obstacles);
+	REQUIRE(result.contactCount == 1);
+	REQUIRE(result.contacts[0].normal == ch::UP_VEC);
+	REQUIRE(result.position.x == Approx(60.f));
+	REQUIRE(result.position.y == Approx(90.f).margin(0.02f));
+	REQUIRE_FALSE(ch::collision::aabb_intersects(obstacles[0], ch::Circle(result.position, 10.f)));
+
+	// Nothing on the way
+	result = mover.moveAndSlide(ch::Circle({ 50.f, 0.f }, 10.f), { 10.f, 10.f }, broadphase, obstacles);
+	REQUIRE(result.contactCount == 0);
+	REQUIRE(result.position == ch::vec_t(60.f, 10.f));
+}
+
+TEST_CASE("kinematic mover pushes a shape sunk into a tiled floor up", "[KinematicMover]") {
+	// Floor of 16x16 tiles, with a wall of tiles on top of it from x = 64
+	std::vector<ch::AABB> obstacles;
+	for (int x = 0; x < 8; ++x) {
+		obstacles.emplace_back(x * 16.f, 100.f, 16.f, 16.f);
+	}
+	for (int y = 1; y <= 3; ++y) {
+		obstacles.emplace_back(64.f, 100.f - y * 16.f, 16.f, 16.f);
+	}
+	ch::spatial::LBVH broadphase;
+	broadphase.build(obstacles);
+	ch::spatial::KinematicMover mover;
+
+	// Sunk across the seam between two tiles, deeper than it overlaps the tile on the left
+	const ch::AABB box(15.34f, 92.f, 10.f, 10.f);
+	ch::spatial::MoveResult result = mover.moveAndSlide(box, ch::NULL_VEC, broadphase, obstacles);
+	REQUIRE(result.contactCount == 1);
+	REQUIRE(result.contacts[0].normal == ch::UP_VEC);
+	REQUIRE(result.position.x == box.pos.x);
+	REQUIRE(result.position.y + box.size.y == Approx(100.f).margin(0.02f));
+
+	// Sunk into the floor and into the wall : pushed up and left, not into the wall
+	const ch::AABB corner(57.f, 93.f, 10.f, 10.f);
+	result = mover.moveAndSlide(corner, ch::NULL_VEC, broadphase, obstacles);
+	REQUIRE(result.position.x + corner.size.x == Approx(64.f).margin(0.02f));
+	REQUIRE(result.position.y + corner.size.y == Approx(100.f).margin(0.02f));
+
+	const ch::spatial::MoveResult circleResult = mover.moveAndSlide(ch::Circle({ 16.5f, 93.f }, 8.f), ch::NULL_VEC, broadphase, obstacles);
+	REQUIRE(circleResult.contacts[0].normal == ch::UP_VEC);
+	REQUIRE(circleResult.position.x == 16.5f);
+	REQUIRE(circleResult.position.y == Approx(92.f).margin(0.02f));
+
+	// Anywhere along the floor, sunk by up to 3 pixels : never ends inside a tile
+	for (int i = 0; i < 1000; ++i) {
+		const ch::AABB sunk(ch::rand::rand_float(0.f, 54.f), 90.f + ch::rand::rand_float(0.01f, 3.f), 10.f, 10.f);
+		const ch::Circle sunkCircle(ch::vec_t(ch::rand::rand_float(5.f, 59.f), 95.f + ch::rand::rand_float(0.01f, 3.f)), 5.f);
+		result = mover.moveAndSlide(sunk, ch::rand::rand_vector(-5.f, 5.f, -5.f, 5.f), broadphase, obstacles);
+		const ch::spatial::MoveResult sunkCircleResult = mover.moveAndSlide(sunkCircle, ch::rand::rand_vector(-5.f, 5.f, -5.f, 5.f), broadphase, obstacles);
+		REQUIRE(result.contacts[0].normal == ch::UP_VEC);
+		REQUIRE(sunkCircleResult.contacts[0].normal == ch::UP_VEC);
+		for (const ch::AABB& obstacle : obstacles) {
+			REQUIRE(ch::collision::aabb_collision_info(obstacle, ch::AABB(result.position, sunk.size)).absolutePenetrationDepthAlongNormal() == 0.f);
+			REQUIRE(ch::collision::circle_aabb_collision_info(obstacle, ch::Circle(sunkCircleResult.position, sunkCircle.radius)).absoluteDepth == 0.f);
+		}
+	}
+}
+
+TEST_CASE("kinematic mover never ends inside an obstacle", "[KinematicMover]") {
+	std::vector<ch::AABB> obstacles;
+	for (int i = 0; i < 50; ++i) {
+		obstacles.emplace_back(ch::rand::rand_vector(0.f, 500.f, 0.f, 500.f), ch::rand::rand_vector(5.f, 60.f, 5.f, 60.f));
+	}
+	ch::spatial::LBVH broadphase;
+	broadphase.build(obstacles);
+	ch::spatial::KinematicMover mover(ch::spatial::MAX_SLIDE_ITERATIONS);
+
+	// Random walk of a box and a circle, starting from free positions
+	ch::AABB box(-50.f, -50.f, 10.f, 10.f);
+	ch::Circle circle({ -50.f, -50.f }, 5.f);
+	for (int tick = 0; tick < 100; ++tick) {
+		const ch::vec_t motion = ch::rand::rand_vector(-20.f, 40.f, -20.f, 40.f);
+
+		box.pos = mover.moveAndSlide(box, motion, broadphase, obstacles).position;
+		circle.pos = mover.moveAndSlide(circle, motion, broadphase, obstacles).position;
+		for (const ch::AABB& obstacle : obstacles) {
+			REQUIRE(ch::collision::aabb_collision_info(obstacle, box).absolutePenetrationDepthAlongNormal() == 0.f);
+			REQUIRE(ch::collision::circle_aabb_collision_info(obstacle, circle).absoluteDepth == 0.f);
+		}
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+	std::vector<ch::AABB> random_boxes(size_t count) {
+		std::vector<ch::AABB> boxes;
+		for (size_t i = 0; i < count; ++i) {
+			boxes.emplace_back(ch::rand::rand_vector(-500.f, 500.f, -500.f, 500.f), ch::rand::rand_vector(1.f, 30.f, 1.f, 30.f));
+		}
+		// Boxes sharing the same center (same Morton code)
+		boxes.emplace_back(10.f, 10.f, 5.f, 5.f);
+		boxes.emplace_back(10.f, 10.f, 5.f, 5.f);
+		boxes.emplace_back(11.f, 11.f, 3.f, 3.f);
+		return boxes;
+	}
+
+	/** Reference segment vs box test (parametric clipping). Returns the entry position or -1. */
+	float reference_segment_entry(const ch::LineSegment& segment, const ch::AABB& box) {
+		float t0 = 0.f, t1 = 1.f;
+		ch::vec_t d = segment.end - segment.start;
+		float p[4] = { -d.x, d.x, -d.y, d.y };
+		float q[4] = { segment.start.x - box.pos.x, box.pos.x + box.size.x - segment.start.x, segment.start.y - box.pos.y, box.pos.y + box.size.y - segment.start.y };
+		for (int i = 0; i < 4; ++i) {
+			if (p[i] == 0.f) {
+				if (q[i] < 0.f) return -1.f;
+				continue;
+			}
+			float r = q[i] / p[i];
+			if (p[i] < 0.f) t0 = std::max(t0, r);
+			else t1 = std::min(t1, r);
+		}
+		return t0 <= t1 ? t0 : -1.f;
+	}
+}
+
+TEST_CASE("lbvh of an empty array doesn't find anything", "[LBVH]") {
+	ch::spatial::LBVH bvh;
+	bvh.build(std::vector<ch::AABB>());
+	std::vector<std::uint32_t> results{ 42 };
+	ch::RaycastHit hit;
+
+	bvh.query(ch::AABB(0.f, 0.f, 10.f, 10.f), results);
+	REQUIRE(results.empty());
+	REQUIRE_FALSE(bvh.raycast(ch::LineSegment({ 0.f, 0.f }, { 10.f, 10.f }), hit));
+}
+
+TEST_CASE("lbvh with a single aabb", "[LBVH]") {
+	ch::spatial::LBVH bvh;
+	bvh.build({ ch::AABB(0.f, 0.f, 10.f, 10.f) });
+	std::vector<std::uint32_t> results;
+
+	bvh.query(ch::AABB(5.f, 5.f, 10.f, 10.f), results);
+	REQUIRE(results == std::vector<std::uint32_t>{ 0 });
+	bvh.query(ch::Circle({ 20.f, 20.f }, 2.f), results);
+	REQUIRE(results.empty());
+}
+
+TEST_CASE("lbvh queries give the same results as testing every aabb", "[LBVH]") {
+	auto boxes = random_boxes(2000);
+	ch::spatial::LBVH bvh;
+	bvh.build(random_boxes(5000), 4); // Rebuilding must not depend on the previous build
+	bvh.build(boxes, 4);
+
+	REQUIRE(bvh.size() == boxes.size());
+	REQUIRE(bvh.nodes().size() == 2 * boxes.size() - 1);
+
+	std::vector<std::uint32_t> results;
+	for (int q = 0; q < 50; ++q) {
+		ch::AABB area(ch::rand::rand_vector(-500.f, 500.f, -500.f, 500.f), ch::rand::rand_vector(0.f, 100.f, 0.f, 100.f));
+		ch::Circle circle(ch::rand::rand_vector(-500.f, 500.f, -500.f, 500.f), ch::rand::rand_float(0.f, 60.f));
+		ch::LineSegment segment(ch::rand::rand_vector(-500.f, 500.f, -500.f, 500.f), ch::rand::rand_vector(-500.f, 500.f, -500.f, 500.f));
+
+		std::vector<std::uint32_t> expectedArea, expectedCircle, expectedSegment;
+		float closest = 2.f;
+		for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+			if (ch::collision::aabb_intersects(area, boxes[i])) {
+				expectedArea.push_back(i);
+			}
+			float dx = std::max(std::max(boxes[i].pos.x - circle.pos.x, 0.f), circle.pos.x - boxes[i].pos.x - boxes[i].size.x);
+			float dy = std::max(std::max(boxes[i].pos.y - circle.pos.y, 0.f), circle.pos.y - boxes[i].pos.y - boxes[i].size.y);
+			if (dx * dx + dy * dy < circle.radius * circle.radius) {
+				expectedCircle.push_back(i);
+			}
+			float entry = reference_segment_entry(segment, boxes[i]);
+			if (entry >= 0.f) {
+				expectedSegment.push_back(i);
+				closest = std::min(closest, entry);
+			}
+		}
+
+		bvh.query(area, results);
+		std::sort(results.begin(), results.end());
+		REQUIRE(results == expectedArea);
+
+		bvh.query(circle, results);
+		std::sort(results.begin(), results.end());
+		REQUIRE(results == expectedCircle);
+
+		bvh.query(segment, results);
+		std::sort(results.begin(), results.end());
+		REQUIRE(results == expectedSegment);
+
+		ch::RaycastHit hit;
+		REQUIRE(bvh.raycast(segment, hit) == !expectedSegment.empty());
+		if (!expectedSegment.empty()) {
+			REQUIRE(hit.t == Approx(closest).margin(1e-5f));
+			REQUIRE(reference_segment_entry(segment, boxes[hit.index]) == Approx(closest).margin(1e-5f));
+		}
+	}
+}
+
+TEST_CASE("lbvh built from bounds finds the same aabbs as one built from aabbs", "[LBVH]") {
+	std::vector<ch::AABB> boxes;
+	std::vector<ch::Bounds> bounds;
+	for (int i = 0; i < 500; ++i) {
+		boxes.emplace_back(ch::rand::rand_vector(-500.f, 500.f, -500.f, 500.f), ch::rand::rand_vector(1.f, 40.f, 1.f, 40.f));
+		bounds.emplace_back(boxes.back());
+	}
+
+	ch::spatial::LBVH fromAABBs;
+	ch::spatial::LBVH fromBounds;
+	fromAABBs.build(boxes);
+	fromBounds.build(bounds);
+
+	std::vector<std::uint32_t> expected;
+	std::vector<std::uint32_t> results;
+	for (int i = 0; i < 50; ++i) {
+		ch::AABB area(ch::rand::rand_vector(-500.f, 500.f, -500.f, 500.f), ch::rand::rand_vector(0.f, 100.f, 0.f, 100.f));
+		fromAABBs.query(area, expected);
+		fromBounds.query(ch::Bounds(area), results);
+		std::sort(expected.begin(), expected.end());
+		std::sort(results.begin(), results.end());
+		REQUIRE(results == expected);
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+TEST_CASE("obb caches the axes of its rotation", "[OBB]") {
+	ch::OBB obb({ 5.f, 5.f }, { 2.f, 1.f });
+	REQUIRE(obb.axisX() == ch::RIGHT_VEC);
+	REQUIRE(obb.axisY() == ch::DOWN_VEC);
+	REQUIRE(obb.bounds() == ch::Bounds(3.f, 4.f, 7.f, 6.f));
+
+	obb.setAngle(90.f);
+	REQUIRE(obb.angle() == 90.f);
+	REQUIRE(obb.axisX().x == Approx(0.f).margin(1e-6));
+	REQUIRE(obb.axisX().y == Approx(1.f));
+	REQUIRE(obb.axisY().x == Approx(-1.f));
+	REQUIRE(obb.axisY().y == Approx(0.f).margin(1e-6));
+
+	// The box is now 2 wide and 4 high
+	REQUIRE(obb.bounds().min.x == Approx(4.f));
+	REQUIRE(obb.bounds().min.y == Approx(3.f));
+	REQUIRE(obb.bounds().max.x == Approx(6.f));
+	REQUIRE(obb.bounds().max.y == Approx(7.f));
+
+	obb.rotate(-90.f);
+	REQUIRE(obb.angle() == 0.f);
+	REQUIRE(obb.axisX() == ch::RIGHT_VEC);
+}
+
+TEST_CASE("obb converts positions between world and local coordinates", "[OBB]") {
+	ch::OBB obb({ 1.f, 2.f }, { 3.f, 1.f }, 30.f);
+	ch::vec_t point(4.f, -2.f);
+	ch::vec_t back = obb.toWorld(obb.toLocal(point));
+	REQUIRE(back.x == Approx(point.x));
+	REQUIRE(back.y == Approx(point.y));
+
+	auto corners = obb.corners();
+	ch::vec_t bottomRight = obb.toLocal(corners[static_cast<size_t>(ch::Corner::BottomRight)]);
+	REQUIRE(bottomRight.x == Approx(3.f));
+	REQUIRE(bottomRight.y == Approx(1.f));
+}
+
+TEST_CASE("obb built from an aabb covers it", "[OBB]") {
+	ch::OBB obb(ch::AABB(2.f, 3.f, 4.f, 6.f));
+	REQUIRE(obb.center() == ch::vec_t(4.f, 6.f));
+	REQUIRE(obb.halfSize() == ch::vec_t(2.f, 3.f));
+	REQUIRE(obb.aabb() == ch::AABB(2.f, 3.f, 4.f, 6.f));
+
+	ch::OBBBatch batch({ obb });
+	REQUIRE(batch.at(0).center() == obb.center());
+	REQUIRE(batch.at(0).halfSize() == obb.halfSize());
+	REQUIRE(batch.at(0).angle() == 0.f);
+}
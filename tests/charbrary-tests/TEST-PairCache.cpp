@@ -0,0 +1,132 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <map>
+#include <utility>
+
+TEST_CASE("pair cache reports contacts that begin and end", "[PairCache]") {
+	ch::PairCache cache;
+	std::vector<ch::ContactEvent> events;
+
+	cache.newFrame();
+	ch::PairContact& contact = cache.get(7, 2);
+	REQUIRE(contact.first == 2);
+	REQUIRE(contact.other == 7);
+	cache.setContact(contact, ch::NULL_VEC, 0.f);
+	cache.endFrame(events);
+	REQUIRE(events.empty());
+	REQUIRE(cache.size() == 1);
+
+	// The order of the handles doesn't matter
+	cache.newFrame();
+	cache.setContact(cache.get(2, 7), ch::DOWN_VEC, 0.5f);
+	cache.endFrame(events);
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].type == ch::ContactEventType::Begin);
+	REQUIRE(events[0].first == 2);
+	REQUIRE(events[0].other == 7);
+	REQUIRE(cache.find(7, 2)->beginFrame == cache.frame());
+	REQUIRE(cache.find(7, 2)->normal == ch::DOWN_VEC);
+
+	// Still touching : no event
+	cache.newFrame();
+	cache.setContact(cache.get(7, 2), ch::DOWN_VEC, 0.25f);
+	cache.endFrame(events);
+	REQUIRE(events.empty());
+	REQUIRE(cache.find(2, 7)->depth == 0.25f);
+
+	// Still reported, not touching anymore
+	cache.newFrame();
+	cache.get(7, 2);
+	cache.endFrame(events);
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].type == ch::ContactEventType::End);
+
+	// Touching again, then the pair leaves the broadphase
+	cache.newFrame();
+	cache.setContact(cache.get(7, 2), ch::UP_VEC, 1.f);
+	cache.endFrame(events);
+	REQUIRE(events.size() == 1);
+	cache.newFrame();
+	cache.endFrame(events);
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].type == ch::ContactEventType::End);
+	REQUIRE(cache.size() == 0);
+	REQUIRE(cache.find(2, 7) == nullptr);
+
+	REQUIRE_THROWS_AS(cache.get(3, 3), std::invalid_argument);
+}
+
+TEST_CASE("pair cache keeps the pairs reported by the broadphase", "[PairCache]") {
+	ch::PairCache cache(4);
+	std::vector<ch::ContactEvent> events;
+	std::map<std::pair<std::uint32_t, std::uint32_t>, bool> touching;
+
+	for (int frame = 0; frame < 30; ++frame) {
+		cache.newFrame();
+
+		std::map<std::pair<std::uint32_t, std::uint32_t>, bool> reported;
+		for (int i = 0; i < 400; ++i) {
+			std::uint32_t a = static_cast<std::uint32_t>(ch::rand::rand_int(0, 40));
+			std::uint32_t b = static_cast<std::uint32_t>(ch::rand::rand_int(0, 40));
+			if (a == b) {
+				continue;
+			}
+			bool touches = ch::rand::rand_int(0, 1) == 1;
+			ch::PairContact& contact = cache.get(a, b);
+			if (touches) {
+				cache.setContact(contact, ch::RIGHT_VEC, 1.f);
+			}
+			reported[std::make_pair(std::min(a, b), std::max(a, b))] |= touches;
+		}
+		cache.endFrame(events);
+
+		size_t begins = 0;
+		size_t ends = 0;
+		for (const auto& pair : reported) {
+			bool before = touching.count(pair.first) && touching[pair.first];
+			begins += pair.second && !before ? 1 : 0;
+			ends += !pair.second && before ? 1 : 0;
+		}
+		for (const auto& pair : touching) {
+			ends += pair.second && reported.count(pair.first) == 0 ? 1 : 0;
+		}
+
+		size_t eventBegins = 0;
+		for (const auto& event : events) {
+			eventBegins += event.type == ch::ContactEventType::Begin ? 1 : 0;
+		}
+		REQUIRE(eventBegins == begins);
+		REQUIRE(events.size() - eventBegins == ends);
+
+		touching = reported;
+		REQUIRE(cache.size() == reported.size());
+		for (const auto& pair : reported) {
+			const ch::PairContact* contact = cache.find(pair.first.second, pair.first.first);
+			REQUIRE(contact != nullptr);
+			REQUIRE(contact->touching == pair.second);
+		}
+	}
+}
+
+TEST_CASE("gjk collision info reuses the separating axis of the previous tick", "[PairCache]") {
+	ch::OBB obb({ 0.f, 0.f }, { 2.f, 1.f }, 20.f);
+	ch::Circle circle({ 6.f, 0.f }, 1.f);
+
+	ch::PairContact contact = ch::PairCache().get(0, 1);
+	ch::ConvexCollision collision = ch::collision::gjk_collision_info(obb, circle, contact);
+	REQUIRE(collision.normal == ch::NULL_VEC);
+	REQUIRE(contact.separatingAxis != ch::NULL_VEC);
+	REQUIRE(ch::collision::separated_along_axis(obb, circle, contact.separatingAxis));
+
+	// The circle approaches then overlaps the OBB : the results match the uncached function
+	for (int tick = 0; tick < 40; ++tick) {
+		circle.pos.x -= 0.1f;
+		ch::ConvexCollision cached = ch::collision::gjk_collision_info(obb, circle, contact);
+		ch::ConvexCollision expected = ch::collision::gjk_collision_info(obb, circle);
+		REQUIRE((cached.normal == ch::NULL_VEC) == (expected.normal == ch::NULL_VEC));
+		REQUIRE(cached.absoluteDepth == Approx(expected.absoluteDepth).margin(1e-4f));
+		REQUIRE((contact.separatingAxis == ch::NULL_VEC) == (expected.normal != ch::NULL_VEC));
+	}
+}
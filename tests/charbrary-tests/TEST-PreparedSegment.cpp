@@ -0,0 +1,74 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("prepared segment caches its direction, length and bounds", "[PreparedSegment]") {
+	ch::PreparedSegment segment({ 4.f, 1.f }, { 1.f, 5.f });
+
+	REQUIRE(segment.start() == ch::vec_t(4.f, 1.f));
+	REQUIRE(segment.end() == ch::vec_t(1.f, 5.f));
+	REQUIRE(segment.direction() == ch::vec_t(-3.f, 4.f));
+	REQUIRE(segment.inverseDirection() == ch::vec_t(1.f / -3.f, 0.25f));
+	REQUIRE(segment.length() == 5.f);
+	REQUIRE(segment.inverseLengthSquared() == 1.f / 25.f);
+	REQUIRE(segment.bounds() == ch::Bounds(1.f, 1.f, 4.f, 5.f));
+	REQUIRE(segment.segment() == ch::LineSegment({ 4.f, 1.f }, { 1.f, 5.f }));
+}
+
+TEST_CASE("prepared segment parallel to an axis has a null inverse direction along the other axis", "[PreparedSegment]") {
+	ch::PreparedSegment horizontal(ch::LineSegment({ 0.f, 2.f }, { 8.f, 2.f }));
+	REQUIRE(horizontal.inverseDirection() == ch::vec_t(0.125f, 0.f));
+
+	ch::PreparedSegment point({ 3.f, 3.f }, { 3.f, 3.f });
+	REQUIRE(point.inverseDirection() == ch::NULL_VEC);
+	REQUIRE(point.length() == 0.f);
+	REQUIRE(point.inverseLengthSquared() == 0.f);
+}
+
+TEST_CASE("prepared segment gives the same clipping results as a line segment", "[PreparedSegment]") {
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 300; ++i) {
+		boxes.emplace_back(ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f), ch::rand::rand_vector(0.f, 20.f, 0.f, 20.f));
+	}
+
+	const std::vector<ch::LineSegment> segments = {
+		ch::LineSegment({ -40.f, -30.f }, { 45.f, 20.f }),
+		ch::LineSegment({ -40.f, 5.f }, { 45.f, 5.f }),
+		ch::LineSegment({ 3.f, -50.f }, { 3.f, 50.f }),
+		ch::LineSegment({ 3.f, 3.f }, { 3.f, 3.f })
+	};
+
+	for (const auto& segment : segments) {
+		ch::PreparedSegment prepared(segment);
+		for (const auto& box : boxes) {
+			auto expected = ch::collision::line_segment_aabb_clip(segment, box);
+			auto clip = ch::collision::line_segment_aabb_clip(prepared, box);
+			REQUIRE(clip.intersects == expected.intersects);
+			REQUIRE(clip.entry == expected.entry);
+			REQUIRE(clip.exit == expected.exit);
+			REQUIRE(clip.clipped == expected.clipped);
+			REQUIRE(ch::collision::aabb_intersects(box, prepared) == expected.intersects);
+			REQUIRE(ch::collision::aabb_intersects(ch::Bounds(box), prepared) == expected.intersects);
+		}
+	}
+}
+
+TEST_CASE("prepared segment closest point and circle intersection", "[PreparedSegment]") {
+	ch::PreparedSegment segment({ 0.f, 0.f }, { 10.f, 0.f });
+
+	// The position along the segment is multiplied by the cached inverse length, so it can be rounded
+	auto closest = ch::collision::closest_point_on_segment(segment, { 4.f, 3.f });
+	REQUIRE(closest.x == Approx(4.f));
+	REQUIRE(closest.y == 0.f);
+	REQUIRE(ch::collision::closest_point_on_segment(segment, { -4.f, 3.f }) == ch::vec_t(0.f, 0.f));
+	REQUIRE(ch::collision::closest_point_on_segment(segment, { 14.f, -3.f }) == ch::vec_t(10.f, 0.f));
+
+	REQUIRE(ch::collision::circle_intersects(ch::Circle({ 5.f, 2.f }, 3.f), segment));
+	REQUIRE_FALSE(ch::collision::circle_intersects(ch::Circle({ 5.f, 4.f }, 3.f), segment));
+	REQUIRE(ch::collision::circle_intersects(ch::Circle({ -1.f, 1.f }, 2.f), segment));
+
+	ch::PreparedSegment point({ 3.f, 3.f }, { 3.f, 3.f });
+	REQUIRE(ch::collision::closest_point_on_segment(point, { 8.f, 1.f }) == ch::vec_t(3.f, 3.f));
+}
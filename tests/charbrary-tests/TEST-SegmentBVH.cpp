@@ -0,0 +1,156 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+	std::vector<ch::LineSegment> random_walls(size_t count) {
+		std::vector<ch::LineSegment> walls;
+		for (size_t i = 0; i < count; ++i) {
+			ch::vec_t start = ch::rand::rand_vector(-1000.f, 1000.f, -1000.f, 1000.f);
+			walls.emplace_back(start, start + ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f));
+		}
+		// Axis-aligned and duplicated walls
+		walls.emplace_back(ch::vec_t(0.f, 0.f), ch::vec_t(100.f, 0.f));
+		walls.emplace_back(ch::vec_t(0.f, 0.f), ch::vec_t(0.f, 100.f));
+		walls.emplace_back(ch::vec_t(0.f, 0.f), ch::vec_t(0.f, 100.f));
+		return walls;
+	}
+
+	/** Reference ray vs segment test. Returns the position of the hit along the ray or -1. */
+	float reference_ray_hit(const ch::LineSegment& ray, const ch::LineSegment& wall) {
+		ch::vec_t r = ray.end - ray.start;
+		ch::vec_t s = wall.end - wall.start;
+		ch::vec_t qp = wall.start - ray.start;
+		float denominator = r.x * s.y - r.y * s.x;
+		if (denominator == 0.f) {
+			return -1.f; // Collinear cases are tested separately
+		}
+		float t = (qp.x * s.y - qp.y * s.x) / denominator;
+		float u = (qp.x * r.y - qp.y * r.x) / denominator;
+		return t >= 0.f && t <= 1.f && u >= 0.f && u <= 1.f ? t : -1.f;
+	}
+}
+
+TEST_CASE("empty segment bvh doesn't hit anything", "[SegmentBVH]") {
+	ch::spatial::SegmentBVH bvh;
+	bvh.build({});
+	ch::RaycastHit hit;
+
+	REQUIRE(bvh.nodes().empty());
+	REQUIRE_FALSE(bvh.closestHit(ch::LineSegment({ 0.f, 0.f }, { 10.f, 10.f }), hit));
+	REQUIRE_FALSE(bvh.anyHit(ch::LineSegment({ 0.f, 0.f }, { 10.f, 10.f })));
+}
+
+TEST_CASE("segment bvh nodes are 32 bytes", "[SegmentBVH]") {
+	REQUIRE(sizeof(ch::spatial::SegmentBVHNode) == 32);
+}
+
+TEST_CASE("segment bvh closest hit", "[SegmentBVH]") {
+	ch::spatial::SegmentBVH bvh;
+	bvh.build({
+		ch::LineSegment({ 10.f, -5.f }, { 10.f, 5.f }),
+		ch::LineSegment({ 5.f, -5.f }, { 5.f, 5.f }),
+		ch::LineSegment({ 20.f, -5.f }, { 20.f, 5.f })
+	});
+	ch::RaycastHit hit;
+
+	REQUIRE(bvh.closestHit(ch::LineSegment({ 0.f, 0.f }, { 40.f, 0.f }), hit));
+	REQUIRE(hit.index == 1);
+	REQUIRE(hit.t == Approx(0.125f));
+	REQUIRE(hit.point == ch::vec_t(5.f, 0.f));
+
+	REQUIRE(bvh.closestHit(ch::LineSegment({ 40.f, 0.f }, { 0.f, 0.f }), hit));
+	REQUIRE(hit.index == 2);
+
+	REQUIRE_FALSE(bvh.closestHit(ch::LineSegment({ 0.f, 0.f }, { 4.f, 0.f }), hit));
+	REQUIRE_FALSE(bvh.anyHit(ch::LineSegment({ 0.f, 10.f }, { 40.f, 10.f })));
+}
+
+TEST_CASE("segment bvh hits collinear segments where the overlap starts", "[SegmentBVH]") {
+	ch::spatial::SegmentBVH bvh;
+	bvh.build({ ch::LineSegment({ 10.f, 0.f }, { 20.f, 0.f }) });
+	ch::RaycastHit hit;
+
+	REQUIRE(bvh.closestHit(ch::LineSegment({ 0.f, 0.f }, { 40.f, 0.f }), hit));
+	REQUIRE(hit.t == Approx(0.25f));
+	REQUIRE(bvh.closestHit(ch::LineSegment({ 15.f, 0.f }, { 40.f, 0.f }), hit));
+	REQUIRE(hit.t == 0.f);
+	REQUIRE_FALSE(bvh.anyHit(ch::LineSegment({ 0.f, 0.f }, { 5.f, 0.f })));
+	REQUIRE_FALSE(bvh.anyHit(ch::LineSegment({ 0.f, 1.f }, { 40.f, 1.f })));
+}
+
+TEST_CASE("segment bvh gives the same results as testing every segment", "[SegmentBVH]") {
+	auto walls = random_walls(3000);
+	ch::spatial::SegmentBVH bvh;
+	bvh.build(walls);
+	REQUIRE(bvh.size() == walls.size());
+
+	for (int q = 0; q < 200; ++q) {
+		ch::LineSegment ray(ch::rand::rand_vector(-1000.f, 1000.f, -1000.f, 1000.f), ch::rand::rand_vector(-1000.f, 1000.f, -1000.f, 1000.f));
+
+		float closest = 2.f;
+		for (const auto& wall : walls) {
+			float t = reference_ray_hit(ray, wall);
+			if (t >= 0.f && t < closest) {
+				closest = t;
+			}
+		}
+
+		ch::RaycastHit hit;
+		bool expected = closest <= 1.f;
+		REQUIRE(bvh.anyHit(ray) == expected);
+		REQUIRE(bvh.closestHit(ray, hit) == expected);
+		if (expected) {
+			REQUIRE(hit.t == Approx(closest));
+			REQUIRE(reference_ray_hit(ray, walls[hit.index]) == Approx(closest));
+		}
+	}
+}
+
+TEST_CASE("serialized segment bvh can be loaded back", "[SegmentBVH]") {
+	auto walls = random_walls(500);
+	ch::spatial::SegmentBVH bvh;
+	bvh.build(walls);
+
+	auto data = bvh.serialize();
+	auto loaded = ch::spatial::SegmentBVH::deserialize(data);
+	REQUIRE(loaded.size() == bvh.size());
+	REQUIRE(loaded.nodes().size() == bvh.nodes().size());
+	REQUIRE(loaded.serialize() == data);
+
+	for (int q = 0; q < 50; ++q) {
+		ch::LineSegment ray(ch::rand::rand_vector(-1000.f, 1000.f, -1000.f, 1000.f), ch::rand::rand_vector(-1000.f, 1000.f, -1000.f, 1000.f));
+		ch::RaycastHit expected{}, actual{};
+		REQUIRE(loaded.closestHit(ray, actual) == bvh.closestHit(ray, expected));
+		REQUIRE(actual.index == expected.index);
+		REQUIRE(actual.t == expected.t);
+	}
+
+	auto empty = ch::spatial::SegmentBVH::deserialize(ch::spatial::SegmentBVH().serialize());
+	REQUIRE(empty.size() == 0);
+}
+
+TEST_CASE("loading invalid segment bvh data throws", "[SegmentBVH]") {
+	ch::spatial::SegmentBVH bvh;
+	bvh.build(random_walls(100));
+	auto data = bvh.serialize();
+
+	auto truncated = data;
+	truncated.pop_back();
+	REQUIRE_THROWS_AS(ch::spatial::SegmentBVH::deserialize(truncated), std::invalid_argument);
+
+	auto badMagic = data;
+	badMagic[0] = 'X';
+	REQUIRE_THROWS_AS(ch::spatial::SegmentBVH::deserialize(badMagic), std::invalid_argument);
+
+	// Right child index of the root (first node, after the 16 bytes header) pointing out of the tree
+	auto badChild = data;
+	std::uint32_t outOfRange = 0xFFFFFF;
+	std::memcpy(badChild.data() + 16 + 16, &outOfRange, sizeof(outOfRange));
+	REQUIRE_THROWS_AS(ch::spatial::SegmentBVH::deserialize(badChild), std::invalid_argument);
+
+	REQUIRE_THROWS_AS(ch::spatial::SegmentBVH::deserialize({}), std::invalid_argument);
+}
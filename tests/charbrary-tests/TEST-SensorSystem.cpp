@@ -0,0 +1,121 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+TEST_CASE("sensor reports the entities entering, staying in and exiting it", "[SensorSystem]") {
+	ch::spatial::SensorSystem sensors;
+	std::uint32_t door = sensors.add(ch::AABB(0.f, 0.f, 10.f, 10.f));
+	std::uint32_t trap = sensors.add(ch::Circle({ 30.f, 5.f }, 3.f));
+	REQUIRE(sensors.size() == 2);
+
+	std::vector<ch::AABB> players = { ch::AABB(-5.f, 2.f, 2.f, 2.f), ch::AABB(5.f, 5.f, 1.f, 1.f) };
+	std::vector<ch::spatial::SensorEvent> events;
+
+	sensors.update(players, events);
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].type == ch::spatial::SensorEventType::Enter);
+	REQUIRE(events[0].sensor == door);
+	REQUIRE(events[0].entity == 1);
+
+	// Player 0 enters the door, player 1 stays
+	players[0].pos.x = 1.f;
+	sensors.update(players, events, true);
+	REQUIRE(events.size() == 2);
+	REQUIRE(events[0].type == ch::spatial::SensorEventType::Enter);
+	REQUIRE(events[0].entity == 0);
+	REQUIRE(events[1].type == ch::spatial::SensorEventType::Stay);
+	REQUIRE(events[1].entity == 1);
+	REQUIRE(sensors.overlaps(door) == std::vector<std::uint32_t>{ 0, 1 });
+
+	// Player 1 walks from the door into the trap
+	players[1].pos = ch::vec_t(29.f, 4.f);
+	sensors.update(players, events);
+	REQUIRE(events.size() == 2);
+	REQUIRE(events[0].type == ch::spatial::SensorEventType::Exit);
+	REQUIRE(events[0].sensor == door);
+	REQUIRE(events[0].entity == 1);
+	REQUIRE(events[1].type == ch::spatial::SensorEventType::Enter);
+	REQUIRE(events[1].sensor == trap);
+	REQUIRE(events[1].entity == 1);
+
+	// Nothing moves : nothing to report
+	sensors.update(players, events);
+	REQUIRE(events.empty());
+
+	// Removing the trap makes player 1 exit it, then its identifier is reused
+	sensors.remove(trap);
+	REQUIRE_THROWS_AS(sensors.overlaps(trap), std::invalid_argument);
+	sensors.update(players, events);
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].type == ch::spatial::SensorEventType::Exit);
+	REQUIRE(events[0].sensor == trap);
+	REQUIRE(sensors.add(ch::AABB(100.f, 100.f, 1.f, 1.f)) == trap);
+}
+
+TEST_CASE("containment sensors only report the entities inside them", "[SensorSystem]") {
+	ch::spatial::SensorSystem sensors;
+	std::uint32_t zone = sensors.add(ch::Circle({ 0.f, 0.f }, 5.f), true);
+
+	std::vector<ch::AABB> entities = { ch::AABB(-1.f, -1.f, 2.f, 2.f), ch::AABB(3.f, 3.f, 2.f, 2.f) };
+	std::vector<ch::spatial::SensorEvent> events;
+	sensors.update(entities, events);
+	REQUIRE(sensors.overlaps(zone) == std::vector<std::uint32_t>{ 0 });
+
+	sensors.set(zone, ch::AABB(-10.f, -10.f, 20.f, 20.f));
+	sensors.update(entities, events);
+	REQUIRE(sensors.overlaps(zone) == std::vector<std::uint32_t>{ 0, 1 });
+	REQUIRE(events.size() == 1);
+	REQUIRE(events[0].entity == 1);
+}
+
+TEST_CASE("sensor events match polling every entity against every sensor", "[SensorSystem]") {
+	ch::spatial::SensorSystem sensors;
+	std::vector<ch::AABB> aabbRegions;
+	std::vector<ch::Circle> circleRegions;
+	for (int i = 0; i < 10; ++i) {
+		aabbRegions.emplace_back(ch::rand::rand_vector(0.f, 100.f, 0.f, 100.f), ch::rand::rand_vector(5.f, 30.f, 5.f, 30.f));
+		circleRegions.emplace_back(ch::rand::rand_vector(0.f, 100.f, 0.f, 100.f), ch::rand::rand_float(5.f, 20.f));
+		sensors.add(aabbRegions.back(), i % 2 == 0);
+		sensors.add(circleRegions.back(), i % 3 == 0);
+	}
+
+	std::vector<ch::AABB> entities;
+	for (int i = 0; i < 200; ++i) {
+		entities.emplace_back(ch::rand::rand_vector(0.f, 100.f, 0.f, 100.f), ch::rand::rand_vector(1.f, 4.f, 1.f, 4.f));
+	}
+
+	std::vector<std::vector<bool>> inside(20, std::vector<bool>(entities.size(), false));
+	std::vector<ch::spatial::SensorEvent> events;
+	for (int tick = 0; tick < 10; ++tick) {
+		for (auto& entity : entities) {
+			entity.pos += ch::rand::rand_vector(-3.f, 3.f, -3.f, 3.f);
+		}
+		sensors.update(entities, events);
+
+		size_t expectedEvents = 0;
+		for (std::uint32_t sensor = 0; sensor < 20; ++sensor) {
+			const int region = sensor / 2;
+			std::vector<std::uint32_t> expectedOverlaps;
+			for (std::uint32_t entity = 0; entity < entities.size(); ++entity) {
+				bool overlaps;
+				if (sensor % 2 == 0) {
+					overlaps = region % 2 == 0
+						? ch::collision::aabb_contains(aabbRegions[region], entities[entity])
+						: ch::collision::aabb_intersects(aabbRegions[region], entities[entity]);
+				}
+				else {
+					overlaps = region % 3 == 0
+						? ch::collision::circle_contains(circleRegions[region], entities[entity])
+						: ch::collision::aabb_intersects(entities[entity], circleRegions[region]);
+				}
+				if (overlaps) {
+					expectedOverlaps.push_back(entity);
+				}
+				expectedEvents += overlaps != inside[sensor][entity] ? 1 : 0;
+				inside[sensor][entity] = overlaps;
+			}
+			REQUIRE(sensors.overlaps(sensor) == expectedOverlaps);
+		}
+		REQUIRE(events.size() == expectedEvents);
+	}
+}
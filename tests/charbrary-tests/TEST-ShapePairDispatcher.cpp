@@ -0,0 +1,95 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+bool shape_pair_intersects(const ch::ShapePair& pair, const std::vector<ch::AABB>& aabbs, const std::vector<ch::Circle>& circles, const std::vector<ch::LineSegment>& segments) {
+	ch::ShapeRef first = pair.first;
+	ch::ShapeRef other = pair.other;
+	if (first.type > other.type) {
+		std::swap(first, other);
+	}
+
+	if (first.type == ch::ShapeType::AABB) {
+		const ch::AABB& aabb = aabbs[first.index];
+		switch (other.type) {
+		case ch::ShapeType::AABB: return ch::collision::aabb_intersects(aabb, aabbs[other.index]);
+		case ch::ShapeType::Circle: return ch::collision::aabb_intersects(aabb, circles[other.index]);
+		default: return ch::collision::aabb_intersects(aabb, segments[other.index]);
+		}
+	}
+	if (first.type == ch::ShapeType::Circle) {
+		const ch::Circle& circle = circles[first.index];
+		return other.type == ch::ShapeType::Circle
+			? ch::collision::circle_intersects(circle, circles[other.index])
+			: ch::collision::circle_intersects(circle, segments[other.index]);
+	}
+	return ch::collision::line_segments_parametric_intersection(segments[first.index], segments[other.index]).type != ch::IntersectionType::None;
+}
+
+TEST_CASE("shape pair dispatcher gives the same results as the scalar functions", "[ShapePairDispatcher]") {
+	std::vector<ch::AABB> aabbs;
+	std::vector<ch::Circle> circles;
+	std::vector<ch::LineSegment> segments;
+	for (int i = 0; i < 50; ++i) {
+		aabbs.emplace_back(ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f), ch::rand::rand_vector(0.f, 10.f, 0.f, 10.f));
+		circles.emplace_back(ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f), ch::rand::rand_float(0.5f, 8.f));
+		ch::vec_t start = ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f);
+		segments.emplace_back(start, start + ch::rand::rand_vector(-15.f, 15.f, -15.f, 15.f));
+	}
+	ch::AABBBatch aabbBatch(aabbs);
+	ch::CircleBatch circleBatch(circles);
+	ch::LineSegmentBatch segmentBatch(segments);
+
+	auto random_shape = []() {
+		return ch::ShapeRef{ static_cast<ch::ShapeType>(ch::rand::rand_int(0, 2)), static_cast<std::uint32_t>(ch::rand::rand_int(0, 49)) };
+	};
+
+	ch::ShapePairDispatcher dispatcher;
+	std::vector<std::uint8_t> results;
+	// The second list is shorter : the buffers of the first call are reused
+	for (size_t count : { 500u, 123u }) {
+		std::vector<ch::ShapePair> pairs;
+		for (size_t i = 0; i < count; ++i) {
+			pairs.push_back(ch::ShapePair{ random_shape(), random_shape() });
+		}
+
+		size_t hits = dispatcher.intersects(aabbBatch, circleBatch, segmentBatch, pairs, results);
+		REQUIRE(results.size() == count);
+
+		size_t expectedHits = 0;
+		size_t circleSegmentPairs = 0;
+		for (size_t i = 0; i < count; ++i) {
+			bool expected = shape_pair_intersects(pairs[i], aabbs, circles, segments);
+			REQUIRE(static_cast<bool>(results[i]) == expected);
+			expectedHits += expected ? 1 : 0;
+
+			bool circleSegment =
+				(pairs[i].first.type == ch::ShapeType::Circle && pairs[i].other.type == ch::ShapeType::LineSegment) ||
+				(pairs[i].first.type == ch::ShapeType::LineSegment && pairs[i].other.type == ch::ShapeType::Circle);
+			circleSegmentPairs += circleSegment ? 1 : 0;
+		}
+		REQUIRE(hits == expectedHits);
+		REQUIRE(dispatcher.combinationSize(ch::ShapeType::LineSegment, ch::ShapeType::Circle) == circleSegmentPairs);
+		REQUIRE(dispatcher.combinationSize(ch::ShapeType::Circle, ch::ShapeType::LineSegment) == circleSegmentPairs);
+	}
+}
+
+TEST_CASE("shape pair dispatcher handles empty lists and single combinations", "[ShapePairDispatcher]") {
+	ch::AABBBatch aabbs(std::vector<ch::AABB>{ ch::AABB(0.f, 0.f, 2.f, 2.f), ch::AABB(1.f, 1.f, 2.f, 2.f), ch::AABB(5.f, 5.f, 1.f, 1.f) });
+	ch::CircleBatch circles;
+	ch::LineSegmentBatch segments;
+
+	ch::ShapePairDispatcher dispatcher;
+	std::vector<std::uint8_t> results(4, 2);
+	REQUIRE(dispatcher.intersects(aabbs, circles, segments, {}, results) == 0);
+	REQUIRE(results.empty());
+
+	const std::vector<ch::ShapePair> pairs = {
+		{ { ch::ShapeType::AABB, 0 }, { ch::ShapeType::AABB, 2 } },
+		{ { ch::ShapeType::AABB, 1 }, { ch::ShapeType::AABB, 0 } }
+	};
+	REQUIRE(dispatcher.intersects(aabbs, circles, segments, pairs, results) == 1);
+	REQUIRE(results == std::vector<std::uint8_t>{ 0, 1 });
+	REQUIRE(dispatcher.combinationSize(ch::ShapeType::AABB, ch::ShapeType::AABB) == 2);
+	REQUIRE(dispatcher.combinationSize(ch::ShapeType::AABB, ch::ShapeType::Circle) == 0);
+}
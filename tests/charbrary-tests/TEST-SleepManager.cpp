@@ -0,0 +1,166 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <utility>
+#include <vector>
+
+// Reports the contacts of the given pairs that the narrowphase would test, then ends the tick
+void sleep_manager_tick(ch::SleepManager& manager, const std::vector<std::pair<std::uint32_t, std::uint32_t>>& touching) {
+	for (const auto& pair : touching) {
+		if (manager.needsCollision(pair.first, pair.second)) {
+			manager.addContact(pair.first, pair.second);
+		}
+	}
+	manager.step(0.1f);
+}
+
+TEST_CASE("resting islands fall asleep and wake up when touched", "[SleepManager]") {
+	ch::SleepManager manager(0.05f, 0.01f, 0.45f);
+
+	const std::uint32_t floor = manager.add(ch::vec_t(0.f, 100.f), true);
+	const std::uint32_t a1 = manager.add(ch::vec_t(0.f, 90.f));
+	const std::uint32_t a2 = manager.add(ch::vec_t(0.f, 80.f));
+	const std::uint32_t b1 = manager.add(ch::vec_t(50.f, 90.f));
+	const std::uint32_t b2 = manager.add(ch::vec_t(50.f, 80.f));
+	REQUIRE(manager.size() == 5);
+	REQUIRE(manager.awakeBodies() == std::vector<std::uint32_t>{ a1, a2, b1, b2 });
+	REQUIRE(!manager.isAwake(floor));
+	REQUIRE(manager.isStatic(floor));
+
+	// Two stacks of crates on the same floor
+	const std::vector<std::pair<std::uint32_t, std::uint32_t>> stacks{ { floor, a1 }, { a1, a2 }, { floor, b1 }, { b1, b2 } };
+	for (int tick = 0; tick < 4; ++tick) {
+		sleep_manager_tick(manager, stacks);
+		REQUIRE(manager.awakeBodies().size() == 4);
+	}
+	REQUIRE(manager.islandCount() == 2);
+
+	sleep_manager_tick(manager, stacks);
+	REQUIRE(manager.islandCount() == 2);
+	REQUIRE(manager.awakeBodies().empty());
+	REQUIRE(!manager.isAwake(a1));
+	REQUIRE(!manager.isAwake(b2));
+	REQUIRE(!manager.needsCollision(a1, a2));
+	REQUIRE(!manager.needsCollision(floor, b1));
+
+	// Nothing moves : the islands stay asleep, and their contacts aren't tested anymore
+	sleep_manager_tick(manager, stacks);
+	REQUIRE(manager.awakeBodies().empty());
+
+	// A moving ball hits the top of the second stack, which wakes up the whole stack but not the first one
+	const std::uint32_t ball = manager.add(ch::vec_t(60.f, 80.f));
+	manager.setMotion(ball, ch::vec_t(55.f, 80.f), ch::vec_t(-50.f, 0.f));
+	REQUIRE(manager.needsCollision(ball, b2));
+	manager.addContact(ball, b2);
+	REQUIRE(manager.isAwake(b1));
+	REQUIRE(manager.isAwake(b2));
+	REQUIRE(!manager.isAwake(a1));
+	REQUIRE(manager.awakeBodies() == std::vector<std::uint32_t>{ b1, b2, ball });
+	sleep_manager_tick(manager, stacks);
+	REQUIRE(manager.islandCount() == 1);
+	REQUIRE(manager.awakeBodies() == std::vector<std::uint32_t>{ b1, b2, ball });
+
+	// Teleporting a sleeping crate wakes up its island, a small drift doesn't
+	manager.setMotion(a2, ch::vec_t(0.f, 80.005f), ch::NULL_VEC);
+	REQUIRE(!manager.isAwake(a2));
+	manager.setMotion(a2, ch::vec_t(10.f, 80.f), ch::NULL_VEC);
+	REQUIRE(manager.isAwake(a1));
+	REQUIRE(manager.isAwake(a2));
+
+	// Static bodies never wake up
+	manager.wake(floor);
+	REQUIRE(!manager.isAwake(floor));
+}
+
+TEST_CASE("moving bodies keep their island awake", "[SleepManager]") {
+	ch::SleepManager manager(0.05f, 0.01f, 0.45f);
+	const std::uint32_t resting = manager.add(ch::vec_t(0.f, 0.f));
+	const std::uint32_t moving = manager.add(ch::vec_t(10.f, 0.f));
+	const std::uint32_t alone = manager.add(ch::vec_t(100.f, 0.f));
+
+	ch::vec_t position(10.f, 0.f);
+	for (int tick = 0; tick < 20; ++tick) {
+		// Very slow speed, but the position keeps changing
+		position += ch::vec_t(0.f, 0.02f);
+		manager.setMotion(moving, position, ch::vec_t(0.f, 0.01f));
+		manager.addContact(resting, moving);
+		manager.step(0.1f);
+	}
+	REQUIRE(manager.isAwake(resting));
+	REQUIRE(manager.isAwake(moving));
+	REQUIRE(!manager.isAwake(alone));
+	REQUIRE(manager.islandCount() == 1);
+
+	// Once the island is asleep, removing one of its bodies wakes up the others
+	for (int tick = 0; tick < 5; ++tick) {
+		manager.addContact(resting, moving);
+		manager.step(0.1f);
+	}
+	REQUIRE(!manager.isAwake(resting));
+	REQUIRE(!manager.isAwake(moving));
+	manager.remove(moving);
+	REQUIRE(manager.isAwake(resting));
+	REQUIRE(manager.size() == 2);
+	REQUIRE_THROWS_AS(manager.isAwake(moving), std::invalid_argument);
+	REQUIRE_THROWS_AS(manager.addContact(resting, moving), std::invalid_argument);
+	REQUIRE_THROWS_AS(manager.wake(42), std::invalid_argument);
+
+	// The identifier is reused once the tick is over
+	REQUIRE(manager.add(ch::NULL_VEC) != moving);
+	manager.step(0.1f);
+	REQUIRE(manager.add(ch::NULL_VEC) == moving);
+	REQUIRE(manager.isAwake(moving));
+}
+
+TEST_CASE("islands match the connected components of the contact graph", "[SleepManager]") {
+	const int bodyCount = ch::rand::rand_int(2, 60);
+	const int contactCount = ch::rand::rand_int(0, 80);
+
+	ch::SleepManager manager(0.05f, 0.01f, 0.45f);
+	for (int i = 0; i < bodyCount; ++i) {
+		manager.add(ch::NULL_VEC);
+	}
+
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> contacts;
+	for (int i = 0; i < contactCount; ++i) {
+		contacts.emplace_back(ch::rand::rand_int(0, bodyCount - 1), ch::rand::rand_int(0, bodyCount - 1));
+	}
+
+	// Connected components by repeated relabelling
+	std::vector<int> labels(bodyCount);
+	for (int i = 0; i < bodyCount; ++i) {
+		labels[i] = i;
+	}
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (const auto& contact : contacts) {
+			const int label = std::min(labels[contact.first], labels[contact.second]);
+			if (labels[contact.first] != label || labels[contact.second] != label) {
+				labels[contact.first] = label;
+				labels[contact.second] = label;
+				changed = true;
+			}
+		}
+	}
+	size_t componentCount = 0;
+	for (int i = 0; i < bodyCount; ++i) {
+		componentCount += labels[i] == i ? 1 : 0;
+	}
+
+	sleep_manager_tick(manager, contacts);
+	REQUIRE(manager.islandCount() == componentCount);
+
+	// Every body rests : all the islands fall asleep together, then waking one body wakes exactly its component
+	for (int tick = 0; tick < 5; ++tick) {
+		sleep_manager_tick(manager, contacts);
+	}
+	REQUIRE(manager.awakeBodies().empty());
+
+	const std::uint32_t woken = ch::rand::rand_int(0, bodyCount - 1);
+	manager.wake(woken);
+	for (int i = 0; i < bodyCount; ++i) {
+		REQUIRE(manager.isAwake(i) == (labels[i] == labels[woken]));
+	}
+}
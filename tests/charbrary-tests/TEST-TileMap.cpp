@@ -0,0 +1,148 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+// Returns true if the interiors of the bounds overlap (touching doesn't count)
+bool tile_map_test_overlap(const ch::Bounds& a, const ch::Bounds& b) {
+	return a.min.x < b.max.x && b.min.x < a.max.x && a.min.y < b.max.y && b.min.y < a.max.y;
+}
+
+TEST_CASE("tile map stores solid tiles", "[TileMap]") {
+	ch::spatial::TileMap map(100, 3, ch::vec_t(16.f, 8.f), ch::vec_t(-10.f, 20.f));
+	REQUIRE(map.width() == 100);
+	REQUIRE(map.height() == 3);
+	REQUIRE(map.tileSize() == ch::vec_t(16.f, 8.f));
+	REQUIRE(map.bounds() == ch::Bounds(-10.f, 20.f, 1590.f, 44.f));
+	REQUIRE(map.tileBounds(2, 1) == ch::Bounds(22.f, 28.f, 38.f, 36.f));
+
+	map.setSolid(70, 2);
+	map.setSolid(3, 0);
+	map.setSolid(3, 0, false);
+	REQUIRE(map.isSolid(70, 2));
+	REQUIRE_FALSE(map.isSolid(3, 0));
+	REQUIRE_FALSE(map.isSolid(-1, 0));
+	REQUIRE_FALSE(map.isSolid(70, 3));
+	REQUIRE_THROWS_AS(map.setSolid(100, 0), std::out_of_range);
+
+	REQUIRE_THROWS_AS(ch::spatial::TileMap(0, 3, ch::vec_t(16.f, 16.f)), std::invalid_argument);
+	REQUIRE_THROWS_AS(ch::spatial::TileMap(3, 3, ch::vec_t(16.f, 0.f)), std::invalid_argument);
+}
+
+TEST_CASE("tile map queries agree with testing every solid tile", "[TileMap]") {
+	const std::uint32_t width = ch::rand::rand_int(1, 150);
+	const std::uint32_t height = ch::rand::rand_int(1, 40);
+	const ch::vec_t tileSize = ch::rand::rand_vector(4.f, 20.f, 4.f, 20.f);
+	ch::spatial::TileMap map(width, height, tileSize, ch::rand::rand_vector(-100.f, 100.f, -100.f, 100.f));
+
+	std::vector<std::uint32_t> solidTiles;
+	for (std::uint32_t y = 0; y < height; ++y) {
+		for (std::uint32_t x = 0; x < width; ++x) {
+			if (ch::rand::rand_int(0, 3) == 0) {
+				map.setSolid(x, y);
+				solidTiles.push_back(x + y * width);
+			}
+		}
+	}
+
+	const ch::Bounds area = map.bounds();
+	std::vector<std::uint32_t> results;
+	for (int i = 0; i < 100; ++i) {
+		const ch::AABB aabb(ch::rand::rand_vector(area.min.x - 50.f, area.max.x, area.min.y - 50.f, area.max.y), ch::rand::rand_vector(1.f, 50.f, 1.f, 50.f));
+		const ch::Circle circle(ch::rand::rand_vector(area.min.x - 20.f, area.max.x + 20.f, area.min.y - 20.f, area.max.y + 20.f), ch::rand::rand_float(1.f, 30.f));
+
+		std::vector<std::uint32_t> expectedAABB;
+		std::vector<std::uint32_t> expectedCircle;
+		for (std::uint32_t tile : solidTiles) {
+			const ch::Bounds bounds = map.tileBounds(tile % width, tile / width);
+			if (tile_map_test_overlap(bounds, ch::Bounds(aabb))) {
+				expectedAABB.push_back(tile);
+			}
+			if (ch::collision::aabb_intersects(bounds, circle)) {
+				expectedCircle.push_back(tile);
+			}
+		}
+
+		map.query(aabb, results);
+		REQUIRE(results == expectedAABB);
+		REQUIRE(map.intersects(aabb) == !expectedAABB.empty());
+		map.query(circle, results);
+		REQUIRE(results == expectedCircle);
+		REQUIRE(map.intersects(circle) == !expectedCircle.empty());
+
+		// First solid tile hit by a ray, against the entry of the ray in every solid tile
+		const ch::LineSegment ray(ch::rand::rand_vector(area.min.x - 20.f, area.max.x + 20.f, area.min.y - 20.f, area.max.y + 20.f), ch::rand::rand_vector(area.min.x - 20.f, area.max.x + 20.f, area.min.y - 20.f, area.max.y + 20.f));
+		float expectedT = 2.f;
+		for (std::uint32_t tile : solidTiles) {
+			const ch::SegmentAABBClip clip = ch::collision::line_segment_aabb_clip(ray, map.tileBounds(tile % width, tile / width));
+			if (clip.intersects) {
+				expectedT = std::min(expectedT, clip.entry);
+			}
+		}
+		ch::RaycastHit hit;
+		const bool found = map.raycast(ray, hit);
+		REQUIRE(found == (expectedT <= 1.f));
+		if (found) {
+			REQUIRE(hit.t == Approx(expectedT).margin(0.0001f));
+			REQUIRE(map.isSolid(hit.index % width, hit.index / width));
+		}
+	}
+}
+
+TEST_CASE("tile map pushes shapes out of the solid tiles", "[TileMap]") {
+	// Floor on the last row, wall on the last column
+	ch::spatial::TileMap map(10, 10, ch::vec_t(10.f, 10.f));
+	for (std::uint32_t i = 0; i < 10; ++i) {
+		map.setSolid(i, 9);
+		map.setSolid(9, i);
+	}
+
+	// Sinking into the floor across the seam between two tiles : pushed up, not sideways
+	const ch::AABB box(19.f, 85.f, 10.f, 10.f);
+	REQUIRE(map.intersects(box));
+	REQUIRE(map.resolve(box) == ch::vec_t(0.f, -5.f));
+
+	// Resting on the floor : nothing to do
+	REQUIRE(map.resolve(ch::AABB(19.f, 80.f, 10.f, 10.f)) == ch::NULL_VEC);
+	REQUIRE_FALSE(map.intersects(ch::AABB(19.f, 80.f, 10.f, 10.f)));
+
+	// In the corner between the floor and the wall : pushed out of both
+	ch::AABB corner(85.f, 83.f, 10.f, 10.f);
+	const ch::vec_t translation = map.resolve(corner);
+	REQUIRE(translation == ch::vec_t(-5.f, -3.f));
+	corner.move(translation);
+	REQUIRE_FALSE(map.intersects(corner));
+
+	// Circle on the seam between two floor tiles, and in the corner
+	REQUIRE(map.resolve(ch::Circle({ 20.f, 86.f }, 5.f)) == ch::vec_t(0.f, -1.f));
+	REQUIRE(map.resolve(ch::Circle({ 20.5f, 86.f }, 5.f)) == ch::vec_t(0.f, -1.f));
+	ch::Circle circle({ 88.f, 88.f }, 5.f);
+	circle.pos += map.resolve(circle);
+	REQUIRE(circle.pos.x == Approx(85.f));
+	REQUIRE(circle.pos.y == Approx(85.f));
+	REQUIRE_FALSE(map.intersects(circle));
+
+	// Concave corner between a low ceiling and the edge of a ledge : pushed out of the ceiling, then sideways off the edge
+	ch::spatial::TileMap corners(6, 6, ch::vec_t(16.f, 16.f));
+	for (std::uint32_t i = 0; i < 6; ++i) {
+		corners.setSolid(i, 1);
+		corners.setSolid(i, 5);
+	}
+	corners.setSolid(0, 3);
+	corners.setSolid(1, 3);
+	ch::Circle cornered({ 33.f, 41.f }, 10.f);
+	cornered.pos += corners.resolve(cornered);
+	REQUIRE(cornered.pos.x == Approx(40.f));
+	REQUIRE(cornered.pos.y == Approx(42.f));
+	REQUIRE_FALSE(corners.intersects(cornered));
+
+	// Pit narrower than the circle : pushed out of the floor, then stuck between the walls
+	corners.setSolid(3, 4);
+	corners.setSolid(5, 4);
+	const ch::Circle stuck({ 72.f, 75.f }, 9.f);
+	const ch::vec_t pushed = corners.resolve(stuck);
+	REQUIRE(pushed.y == Approx(-4.f));
+	REQUIRE(corners.resolve(stuck, 16) == pushed);
+	REQUIRE(corners.intersects(ch::Circle(stuck.pos + pushed, stuck.radius)));
+}
@@ -0,0 +1,436 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("the active simd level never exceeds the detected level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	REQUIRE(ch::simd::active_simd_level() <= ch::simd::detected_simd_level());
+	REQUIRE(ch::simd::set_simd_level(ch::simd::SimdLevel::AVX512) == ch::simd::detected_simd_level());
+	REQUIRE(ch::simd::set_simd_level(ch::simd::SimdLevel::Scalar) == ch::simd::SimdLevel::Scalar);
+	REQUIRE(std::string(ch::simd::simd_level_name(ch::simd::SimdLevel::AVX2)) == "avx2");
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("aabb batch stores the boundaries of the boxes", "[Batch collision functions]") {
+	ch::AABBBatch batch({ ch::AABB(1.f, 2.f, 3.f, 4.f), ch::AABB(-5.f, 6.f, 7.f, 8.f) });
+
+	REQUIRE(batch.size() == 2);
+	REQUIRE(batch.maxX[0] == 4.f);
+	REQUIRE(batch.maxY[1] == 14.f);
+	REQUIRE(batch.at(1) == ch::AABB(-5.f, 6.f, 7.f, 8.f));
+}
+
+TEST_CASE("aabb batch intersection gives the same results as aabb_intersects on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 203; ++i) {
+		boxes.emplace_back(ch::rand::rand_float(-50.f, 50.f), ch::rand::rand_float(-50.f, 50.f), ch::rand::rand_float(0.f, 20.f), ch::rand::rand_float(0.f, 20.f));
+	}
+	// Touching boxes are considered intersecting
+	boxes.emplace_back(10.f, 0.f, 5.f, 5.f);
+	ch::AABBBatch batch(boxes);
+	ch::AABB tested(0.f, 0.f, 10.f, 10.f);
+
+	size_t expectedHits = 0;
+	for (const auto& box : boxes) {
+		expectedHits += ch::collision::aabb_intersects(tested, box) ? 1 : 0;
+	}
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+		std::vector<std::uint8_t> results(batch.size(), 2);
+
+		REQUIRE(ch::collision::aabb_intersects_batch(tested, batch, results.data()) == expectedHits);
+		for (size_t i = 0; i < boxes.size(); ++i) {
+			REQUIRE(static_cast<bool>(results[i]) == ch::collision::aabb_intersects(tested, boxes[i]));
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("circle batch intersection gives the same results as circle_intersects on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	std::vector<ch::Circle> circles;
+	for (int i = 0; i < 77; ++i) {
+		circles.emplace_back(ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f), ch::rand::rand_float(0.f, 10.f));
+	}
+	ch::CircleBatch batch(circles);
+	ch::Circle tested({ 3.f, -4.f }, 15.f);
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+		std::vector<std::uint8_t> results(batch.size(), 2);
+
+		ch::collision::circle_intersects_batch(tested, batch, results.data());
+		for (size_t i = 0; i < circles.size(); ++i) {
+			REQUIRE(static_cast<bool>(results[i]) == ch::collision::circle_intersects(tested, circles[i]));
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("segment batch intersection gives the same results as line_segments_parametric_intersection on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	ch::LineSegment tested({ -20.f, -5.f }, { 30.f, 10.f });
+	std::vector<ch::LineSegment> segments;
+	for (int i = 0; i < 150; ++i) {
+		segments.emplace_back(ch::rand::rand_vector(-40.f, 40.f, -40.f, 40.f), ch::rand::rand_vector(-40.f, 40.f, -40.f, 40.f));
+	}
+	// Parallel, collinear and touching segments, handled outside of the simd lanes
+	segments.emplace_back(ch::vec_t(-20.f, -4.f), ch::vec_t(30.f, 11.f));
+	segments.emplace_back(ch::vec_t(0.f, 1.f), ch::vec_t(40.f, 13.f));
+	segments.emplace_back(ch::vec_t(30.f, 10.f), ch::vec_t(30.f, 20.f));
+	segments.emplace_back(ch::vec_t(-20.f, -5.f), ch::vec_t(-20.f, -5.f));
+	ch::LineSegmentBatch batch(segments);
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+		std::vector<std::uint8_t> results(batch.size(), 2);
+		std::vector<float> t(batch.size(), -1.f);
+		std::vector<float> u(batch.size(), -1.f);
+
+		size_t expectedHits = 0;
+		size_t hits = ch::collision::line_segments_intersect_batch(tested, batch, results.data(), t.data(), u.data());
+		for (size_t i = 0; i < segments.size(); ++i) {
+			auto expected = ch::collision::line_segments_parametric_intersection(tested, segments[i]);
+			expectedHits += expected.type != ch::IntersectionType::None ? 1 : 0;
+			REQUIRE(static_cast<bool>(results[i]) == (expected.type != ch::IntersectionType::None));
+			REQUIRE(t[i] == Approx(expected.t).margin(1e-6f));
+			REQUIRE(u[i] == Approx(expected.u).margin(1e-6f));
+		}
+		REQUIRE(hits == expectedHits);
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("segment batch against segment batch finds every intersecting pair", "[Batch collision functions]") {
+	std::vector<ch::LineSegment> first, other;
+	for (int i = 0; i < 40; ++i) {
+		first.emplace_back(ch::rand::rand_vector(-40.f, 40.f, -40.f, 40.f), ch::rand::rand_vector(-40.f, 40.f, -40.f, 40.f));
+		other.emplace_back(ch::rand::rand_vector(-40.f, 40.f, -40.f, 40.f), ch::rand::rand_vector(-40.f, 40.f, -40.f, 40.f));
+	}
+	other.emplace_back(ch::vec_t(0.f, 0.f), ch::vec_t(1.f, 1.f));
+
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> expected;
+	for (std::uint32_t i = 0; i < first.size(); ++i) {
+		for (std::uint32_t j = 0; j < other.size(); ++j) {
+			if (ch::collision::line_segments_parametric_intersection(first[i], other[j]).type != ch::IntersectionType::None) {
+				expected.emplace_back(i, j);
+			}
+		}
+	}
+
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs{ { 99, 99 } };
+	REQUIRE(ch::collision::line_segments_intersect_batch(ch::LineSegmentBatch(first), ch::LineSegmentBatch(other), pairs) == expected.size());
+	REQUIRE(pairs == expected);
+}
+
+TEST_CASE("circle sweep batch gives the same results as circle_sweep on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	std::vector<ch::LineSegment> walls;
+	for (int i = 0; i < 301; ++i) {
+		ch::vec_t start = ch::rand::rand_vector(-200.f, 200.f, -200.f, 200.f);
+		walls.emplace_back(start, start + ch::rand::rand_vector(-30.f, 30.f, -30.f, 30.f));
+	}
+	walls.emplace_back(ch::vec_t(50.f, 50.f), ch::vec_t(50.f, 50.f));
+	ch::LineSegmentBatch batch(walls);
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+
+		for (int q = 0; q < 100; ++q) {
+			ch::Circle circle(ch::rand::rand_vector(-200.f, 200.f, -200.f, 200.f), ch::rand::rand_float(0.5f, 5.f));
+			ch::vec_t motion = ch::rand::rand_vector(-60.f, 60.f, -60.f, 60.f);
+
+			ch::CircleSweepHit expected{}, actual{};
+			bool hit = ch::collision::circle_sweep(circle, motion, walls, expected);
+			REQUIRE(ch::collision::circle_sweep_batch(circle, motion, batch, actual) == hit);
+			if (hit) {
+				REQUIRE(actual.index == expected.index);
+				REQUIRE(actual.time == Approx(expected.time).margin(1e-5f));
+			}
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("segment vs aabb batch gives the same results as line_segment_aabb_clip on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 203; ++i) {
+		boxes.emplace_back(ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f), ch::rand::rand_vector(0.f, 20.f, 0.f, 20.f));
+	}
+	ch::AABBBatch batch(boxes);
+
+	const std::vector<ch::LineSegment> segments = {
+		ch::LineSegment({ -40.f, -30.f }, { 45.f, 20.f }),
+		ch::LineSegment({ -40.f, 5.f }, { 45.f, 5.f }),
+		ch::LineSegment({ 3.f, -50.f }, { 3.f, 50.f }),
+		ch::LineSegment({ 3.f, 3.f }, { 3.f, 3.f })
+	};
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+
+		for (const auto& segment : segments) {
+			std::vector<std::uint8_t> results(batch.size(), 2);
+			std::vector<float> entry(batch.size(), -1.f);
+			std::vector<float> exit(batch.size(), -1.f);
+
+			size_t expectedHits = 0;
+			size_t hits = ch::collision::line_segment_aabb_clip_batch(segment, batch, results.data(), entry.data(), exit.data());
+			for (size_t i = 0; i < boxes.size(); ++i) {
+				auto expected = ch::collision::line_segment_aabb_clip(segment, boxes[i]);
+				expectedHits += expected.intersects ? 1 : 0;
+				REQUIRE(static_cast<bool>(results[i]) == expected.intersects);
+				REQUIRE(entry[i] == expected.entry);
+				REQUIRE(exit[i] == expected.exit);
+			}
+			REQUIRE(hits == expectedHits);
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("circle vs aabb batch gives the same results as circle_aabb_collision_info on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	// Integer coordinates, so that rebuilding the boxes from the batch is exact
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 203; ++i) {
+		boxes.emplace_back(std::floor(ch::rand::rand_float(-50.f, 50.f)), std::floor(ch::rand::rand_float(-50.f, 50.f)), std::floor(ch::rand::rand_float(1.f, 20.f)), std::floor(ch::rand::rand_float(1.f, 20.f)));
+	}
+	ch::AABBBatch batch(boxes);
+
+	const std::vector<ch::Circle> circles = {
+		ch::Circle({ 0.5f, 0.5f }, 10.f),
+		ch::Circle({ -20.25f, 30.75f }, 4.f),
+		ch::Circle({ 40.f, -40.f }, 25.f),
+		ch::Circle({ 3.f, 3.f }, 0.f)
+	};
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+
+		for (const auto& circle : circles) {
+			std::vector<std::uint8_t> results(batch.size(), 2);
+			std::vector<float> normalX(batch.size(), -2.f);
+			std::vector<float> normalY(batch.size(), -2.f);
+			std::vector<float> depth(batch.size(), -1.f);
+
+			size_t expectedHits = 0;
+			size_t hits = ch::collision::circle_aabb_collision_batch(circle, batch, results.data(), normalX.data(), normalY.data(), depth.data());
+			for (size_t i = 0; i < boxes.size(); ++i) {
+				auto expected = ch::collision::circle_aabb_collision_info(boxes[i], circle);
+				bool collides = expected.normal.x != 0.f || expected.normal.y != 0.f;
+				expectedHits += collides ? 1 : 0;
+				REQUIRE(static_cast<bool>(results[i]) == collides);
+				REQUIRE(normalX[i] == Approx(expected.normal.x).margin(1e-6));
+				REQUIRE(normalY[i] == Approx(expected.normal.y).margin(1e-6));
+				REQUIRE(depth[i] == Approx(expected.absoluteDepth).margin(1e-5));
+			}
+			REQUIRE(hits == expectedHits);
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("aabb pair batch gives the same results as aabb_collision_info on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	// Integer coordinates, so that rebuilding the boxes from the batch is exact
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 150; ++i) {
+		boxes.emplace_back(std::floor(ch::rand::rand_float(0.f, 60.f)), std::floor(ch::rand::rand_float(0.f, 60.f)), std::floor(ch::rand::rand_float(0.f, 20.f)), std::floor(ch::rand::rand_float(0.f, 20.f)));
+	}
+	boxes.emplace_back(10.f, 10.f, 30.f, 30.f);
+	boxes.emplace_back(15.f, 12.f, 4.f, 4.f);
+	ch::AABBBatch batch(boxes);
+
+	std::vector<ch::collision::AABBIndexPair> pairs;
+	for (std::uint32_t i = 0; i < 203; ++i) {
+		pairs.emplace_back(i % boxes.size(), (i * 7 + 3) % boxes.size());
+	}
+	pairs.emplace_back(150, 151);
+	pairs.emplace_back(151, 150);
+	pairs.emplace_back(151, 151);
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+
+		std::vector<ch::AABBCollision> collisions;
+		size_t expectedHits = 0;
+		size_t hits = ch::collision::aabb_collision_batch(batch, pairs, collisions);
+		REQUIRE(collisions.size() == pairs.size());
+		for (size_t i = 0; i < pairs.size(); ++i) {
+			auto expected = ch::collision::aabb_collision_info(boxes[pairs[i].first], boxes[pairs[i].second]);
+			expectedHits += expected.normal == ch::NULL_VEC ? 0 : 1;
+			REQUIRE(collisions[i].normal == expected.normal);
+			REQUIRE(collisions[i].delta == expected.delta);
+		}
+		REQUIRE(hits == expectedHits);
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("obb batch intersection gives the same results as obb_intersects on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	std::vector<ch::OBB> obbs;
+	for (int i = 0; i < 77; ++i) {
+		obbs.emplace_back(ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f), ch::rand::rand_vector(1.f, 10.f, 1.f, 10.f), ch::rand::rand_float(0.f, 360.f));
+	}
+	ch::OBBBatch batch(obbs);
+	ch::AABB aabb(-12.f, -7.f, 30.f, 18.f);
+	ch::Circle circle({ 3.f, -4.f }, 15.f);
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+		std::vector<std::uint8_t> aabbResults(batch.size(), 2);
+		std::vector<std::uint8_t> circleResults(batch.size(), 2);
+
+		ch::collision::obb_intersects_batch(aabb, batch, aabbResults.data());
+		ch::collision::obb_intersects_batch(circle, batch, circleResults.data());
+		for (size_t i = 0; i < obbs.size(); ++i) {
+			REQUIRE(static_cast<bool>(aabbResults[i]) == ch::collision::obb_intersects(obbs[i], aabb));
+			REQUIRE(static_cast<bool>(circleResults[i]) == ch::collision::obb_intersects(obbs[i], circle));
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("capsule vs aabb batch gives the same results as capsule_intersects on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	std::vector<ch::AABB> aabbs;
+	for (int i = 0; i < 77; ++i) {
+		aabbs.emplace_back(ch::rand::rand_vector(-30.f, 30.f, -30.f, 30.f), ch::rand::rand_vector(0.f, 10.f, 0.f, 10.f));
+	}
+	// Boxes only touched by the segments of the capsules without radius
+	aabbs.emplace_back(1.f, -5.f, 4.f, 3.f);
+	aabbs.emplace_back(3.f, -2.f, 5.f, 4.f);
+	aabbs.emplace_back(-3.f, -10.f, 6.f, 5.f);
+	ch::AABBBatch batch(aabbs);
+	const std::vector<ch::Capsule> capsules = {
+		ch::Capsule({ -12.f, -7.f }, { 15.f, 9.f }, 2.f),
+		ch::Capsule({ 3.f, -20.f }, { 3.f, 20.f }, 4.5f),
+		ch::Capsule({ 1.f, 2.f }, { 1.f, 2.f }, 6.f),
+		ch::Capsule({ -2.f, 5.f }, { 1.f, -5.f }, 0.f),
+		ch::Capsule({ 3.f, -20.f }, { 3.f, 20.f }, 0.f),
+		ch::Capsule({ 1.f, -5.f }, { 1.f, -5.f }, 0.f)
+	};
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+		for (const ch::Capsule& capsule : capsules) {
+			std::vector<std::uint8_t> results(batch.size(), 2);
+			ch::collision::capsule_aabb_intersects_batch(capsule, batch, results.data());
+			for (size_t i = 0; i < aabbs.size(); ++i) {
+				REQUIRE(static_cast<bool>(results[i]) == ch::collision::capsule_intersects(capsule, aabbs[i]));
+			}
+			if (capsule.radius == 0.f && capsule.segment.start == ch::vec_t(-2.f, 5.f)) {
+				REQUIRE(results[aabbs.size() - 3] == 0);
+			}
+			if (capsule.radius == 0.f && capsule.segment.start == ch::vec_t(3.f, -20.f)) {
+				REQUIRE(results[aabbs.size() - 2] == 0);
+				REQUIRE(results[aabbs.size() - 1] == 0);
+			}
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
+
+TEST_CASE("pairwise batches give the same results as the scalar functions on every simd level", "[Batch collision functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	std::vector<ch::AABB> aabbs[2];
+	std::vector<ch::Circle> circles[2];
+	std::vector<ch::LineSegment> segments[2];
+	for (int side = 0; side < 2; ++side) {
+		for (int i = 0; i < 83; ++i) {
+			aabbs[side].emplace_back(ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f), ch::rand::rand_vector(0.f, 10.f, 0.f, 10.f));
+			circles[side].emplace_back(ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f), ch::rand::rand_float(0.5f, 8.f));
+			ch::vec_t start = ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f);
+			ch::vec_t motion = ch::rand::rand_vector(-15.f, 15.f, -15.f, 15.f);
+			// Some segments are axis aligned or reduced to a point to cover the special cases of the kernels
+			if (i % 7 == 0) {
+				motion.x = 0.f;
+			}
+			if (i % 11 == 0) {
+				motion.y = 0.f;
+			}
+			segments[side].emplace_back(start, start + motion);
+		}
+	}
+	// Collinear overlapping segments
+	segments[0][5] = ch::LineSegment({ 0.f, 0.f }, { 4.f, 4.f });
+	segments[1][5] = ch::LineSegment({ 2.f, 2.f }, { 6.f, 6.f });
+
+	ch::AABBBatch aabbBatches[2] = { ch::AABBBatch(aabbs[0]), ch::AABBBatch(aabbs[1]) };
+	ch::CircleBatch circleBatches[2] = { ch::CircleBatch(circles[0]), ch::CircleBatch(circles[1]) };
+	ch::LineSegmentBatch segmentBatches[2] = { ch::LineSegmentBatch(segments[0]), ch::LineSegmentBatch(segments[1]) };
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+		std::vector<std::uint8_t> results(83, 2);
+
+		ch::collision::aabb_intersects_pairwise(aabbBatches[0], aabbBatches[1], results.data());
+		for (size_t i = 0; i < results.size(); ++i) {
+			REQUIRE(static_cast<bool>(results[i]) == ch::collision::aabb_intersects(aabbs[0][i], aabbs[1][i]));
+		}
+
+		ch::collision::circle_intersects_pairwise(circleBatches[0], circleBatches[1], results.data());
+		for (size_t i = 0; i < results.size(); ++i) {
+			REQUIRE(static_cast<bool>(results[i]) == ch::collision::circle_intersects(circles[0][i], circles[1][i]));
+		}
+
+		ch::collision::aabb_circle_intersects_pairwise(aabbBatches[0], circleBatches[1], results.data());
+		for (size_t i = 0; i < results.size(); ++i) {
+			REQUIRE(static_cast<bool>(results[i]) == ch::collision::aabb_intersects(aabbs[0][i], circles[1][i]));
+		}
+
+		size_t hits = ch::collision::line_segments_intersect_pairwise(segmentBatches[0], segmentBatches[1], results.data());
+		size_t expectedHits = 0;
+		for (size_t i = 0; i < results.size(); ++i) {
+			bool expected = ch::collision::line_segments_parametric_intersection(segments[0][i], segments[1][i]).type != ch::IntersectionType::None;
+			REQUIRE(static_cast<bool>(results[i]) == expected);
+			expectedHits += expected ? 1 : 0;
+		}
+		REQUIRE(hits == expectedHits);
+		REQUIRE(results[5] == 1);
+
+		ch::collision::aabb_segment_intersects_pairwise(aabbBatches[0], segmentBatches[1], results.data());
+		for (size_t i = 0; i < results.size(); ++i) {
+			REQUIRE(static_cast<bool>(results[i]) == ch::collision::aabb_intersects(aabbs[0][i], segments[1][i]));
+		}
+
+		ch::collision::circle_segment_intersects_pairwise(circleBatches[0], segmentBatches[1], results.data());
+		for (size_t i = 0; i < results.size(); ++i) {
+			REQUIRE(static_cast<bool>(results[i]) == ch::collision::circle_intersects(circles[0][i], segments[1][i]));
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+
+	std::vector<std::uint8_t> results(83);
+	aabbBatches[1].push_back(ch::AABB(0.f, 0.f, 1.f, 1.f));
+	REQUIRE_THROWS_AS(ch::collision::aabb_intersects_pairwise(aabbBatches[0], aabbBatches[1], results.data()), std::invalid_argument);
+}
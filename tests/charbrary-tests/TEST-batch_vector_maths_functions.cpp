@@ -0,0 +1,43 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+TEST_CASE("batched vector maths give the same results as the scalar functions on every simd level", "[Batch vector maths functions]") {
+	auto previous = ch::simd::active_simd_level();
+
+	const size_t count = 37;
+	std::vector<float> x(count), y(count), otherX(count), otherY(count);
+	for (size_t i = 0; i < count; ++i) {
+		x[i] = ch::rand::rand_float(-10.f, 10.f);
+		y[i] = ch::rand::rand_float(-10.f, 10.f);
+		otherX[i] = ch::rand::rand_float(-10.f, 10.f);
+		otherY[i] = ch::rand::rand_float(-10.f, 10.f);
+	}
+	// Null vectors must stay null once normalized
+	x[3] = 0.f;
+	y[3] = 0.f;
+
+	for (int level = 0; level <= static_cast<int>(ch::simd::detected_simd_level()); ++level) {
+		ch::simd::set_simd_level(static_cast<ch::simd::SimdLevel>(level));
+
+		std::vector<float> magnitudes(count), products(count);
+		std::vector<float> normalizedX = x, normalizedY = y;
+		ch::vec_magnitude_batch(x.data(), y.data(), magnitudes.data(), count);
+		ch::vec_dot_product_batch(x.data(), y.data(), otherX.data(), otherY.data(), products.data(), count);
+		ch::vec_normalize_batch(normalizedX.data(), normalizedY.data(), count);
+
+		for (size_t i = 0; i < count; ++i) {
+			ch::vec_t v(x[i], y[i]);
+			ch::vec_t normalized = ch::vec_normalize(v);
+
+			REQUIRE(magnitudes[i] == Approx(ch::vec_magnitude(v)));
+			REQUIRE(products[i] == Approx(ch::vec_dot_product(v, { otherX[i], otherY[i] })));
+			REQUIRE(normalizedX[i] == Approx(normalized.x));
+			REQUIRE(normalizedY[i] == Approx(normalized.y));
+		}
+	}
+
+	ch::simd::set_simd_level(previous);
+}
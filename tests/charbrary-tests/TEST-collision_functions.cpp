@@ -265,6 +265,25 @@ TEST_CASE("aabb collides with the bottom side of the first aabb", "[Collision fu
 	REQUIRE(ch::collision::aabb_collision_info(current, other).normal == ch::DOWN_VEC);
 }
 
+TEST_CASE("aabb collision info gives the overlap on both axes", "[Collision functions]") {
+	ch::AABB current(0.f, 0.f, 10.f, 10.f);
+	ch::AABB other(8.f, 5.f, 40.f, 40.f);
+
+	auto collision = ch::collision::aabb_collision_info(current, other);
+	REQUIRE(collision.normal == ch::RIGHT_VEC);
+	REQUIRE(collision.delta == ch::vec_t(2.f, 5.f));
+	REQUIRE(collision.absolutePenetrationDepthAlongNormal() == 2.f);
+}
+
+TEST_CASE("aabbs touching by their sides collide with a null overlap", "[Collision functions]") {
+	ch::AABB current(0.f, 0.f, 10.f, 10.f);
+	ch::AABB other(-5.f, 2.f, 5.f, 5.f);
+
+	auto collision = ch::collision::aabb_collision_info(current, other);
+	REQUIRE(collision.normal == ch::LEFT_VEC);
+	REQUIRE(collision.absolutePenetrationDepthAlongNormal() == 0.f);
+}
+
 TEST_CASE("compute the depth of the collision along the collision normal", "[Collision functions]") {
 	ch::AABBCollision collision{ ch::LEFT_VEC, {-140.f,20.f} };
 
@@ -434,6 +453,36 @@ TEST_CASE("circle collides bottom left corner of AABB", "[Collision functions]")
 	REQUIRE(collision.absoluteDepth == Approx(expectedCollision.absoluteDepth));
 }
 
+TEST_CASE("circle inside AABB is pushed out through the closest side", "[Collision functions]") {
+	ch::AABB aabb(6.f, 7.f, 9.f, 3.f);
+	ch::Circle circle({ 14.f,8.5f }, 1.f);
+
+	auto collision = ch::collision::circle_aabb_collision_info(aabb, circle);
+	REQUIRE(collision.normal.x == ch::RIGHT_VEC.x);
+	REQUIRE(collision.normal.y == ch::RIGHT_VEC.y);
+	REQUIRE(collision.absoluteDepth == 2.f);
+}
+
+TEST_CASE("circle near a corner of AABB but outside of it doesn't collide", "[Collision functions]") {
+	ch::AABB aabb(6.f, 7.f, 9.f, 3.f);
+	ch::Circle circle({ 5.f,6.f }, 1.2f);
+
+	auto collision = ch::collision::circle_aabb_collision_info(aabb, circle);
+	REQUIRE(collision.normal.x == ch::NULL_VEC.x);
+	REQUIRE(collision.normal.y == ch::NULL_VEC.y);
+	REQUIRE_FALSE(ch::collision::aabb_intersects(aabb, circle));
+}
+
+TEST_CASE("circle touching a side of AABB doesn't collide", "[Collision functions]") {
+	ch::AABB aabb(6.f, 7.f, 9.f, 3.f);
+	ch::Circle circle({ 5.f,8.f }, 1.f);
+
+	auto collision = ch::collision::circle_aabb_collision_info(aabb, circle);
+	REQUIRE(collision.normal.x == ch::NULL_VEC.x);
+	REQUIRE(collision.normal.y == ch::NULL_VEC.y);
+	REQUIRE_FALSE(ch::collision::aabb_intersects(aabb, circle));
+}
+
 TEST_CASE("2 line segments don't intersect", "[Collision functions]") {
 	ch::LineSegment first({ -70.f,4.f }, { -1.f,10.f });
 	ch::LineSegment second({ -1.f,4.f }, { -4.f,1.f });
@@ -517,3 +566,528 @@ TEST_CASE("2 horizontally overlapping line segments", "[Collision functions]") {
 	ch::LineSegment expected(pair.first, pair.second);
 	REQUIRE(ch::LineSegment({ 0.f,-4.f }, { 3.f, -4.f }) == expected);
 }
+
+TEST_CASE("parametric segment intersection agrees with line_segments_intersection_info", "[Collision functions]") {
+	const std::vector<std::pair<ch::LineSegment, ch::LineSegment>> cases = {
+		{ ch::LineSegment({ -70.f,4.f }, { -1.f,10.f }), ch::LineSegment({ -1.f,4.f }, { -4.f,1.f }) },
+		{ ch::LineSegment({ -7.f,4.f }, { -1.f,1.f }), ch::LineSegment({ -1.f,4.f }, { -4.f,1.f }) },
+		{ ch::LineSegment({ -7.f,4.f }, { -1.f,1.f }), ch::LineSegment({ -1.f,4.f }, { -3.f,3.f }) },
+		{ ch::LineSegment({ 9.f,-5.f }, { -3.f,3.f }), ch::LineSegment({ -3.f,-1.f }, { 6.f,5.f }) },
+		{ ch::LineSegment({ -2.f,4.f }, { -5.f,1.f }), ch::LineSegment({ -1.f,4.f }, { -4.f,1.f }) },
+		{ ch::LineSegment({ -3.f,3.f }, { -3.f,2.f }), ch::LineSegment({ -2.f,4.f }, { -2.f,-1.f }) },
+		{ ch::LineSegment({ -11.f,3.f }, { -5.f,0.f }), ch::LineSegment({ -7.f,1.f }, { -3.f,-1.f }) },
+		{ ch::LineSegment({ -5.f,-1.f }, { -5.f,2.f }), ch::LineSegment({ -5.f,0.f }, { -5.f,-4.f }) },
+		{ ch::LineSegment({ -1.f,-4.f }, { 3.f,-4.f }), ch::LineSegment({ 0.f,-4.f }, { 5.f,-4.f }) }
+	};
+
+	for (const auto& segments : cases) {
+		const auto& first = segments.first;
+		const auto& other = segments.second;
+		auto expected = ch::collision::line_segments_intersection_info(first, other);
+		auto intersection = ch::collision::line_segments_parametric_intersection(first, other);
+		ch::vec_t r = first.end - first.start;
+		ch::vec_t s = other.end - other.start;
+
+		REQUIRE(intersection.type == expected.type);
+		if (expected.type == ch::IntersectionType::Crossing) {
+			ch::vec_t point = first.start + r * intersection.t;
+			ch::vec_t pointOnOther = other.start + s * intersection.u;
+			REQUIRE(point.x == Approx(expected.point.x).margin(1e-5f));
+			REQUIRE(point.y == Approx(expected.point.y).margin(1e-5f));
+			REQUIRE(pointOnOther.x == Approx(expected.point.x).margin(1e-5f));
+			REQUIRE(pointOnOther.y == Approx(expected.point.y).margin(1e-5f));
+		}
+		else if (expected.type == ch::IntersectionType::Overlapping) {
+			ch::LineSegment overlap(first.start + r * intersection.t, first.start + r * intersection.tEnd);
+			REQUIRE(overlap == ch::LineSegment(expected.resultingSegment.first, expected.resultingSegment.second));
+			REQUIRE(other.start + s * intersection.u == overlap.start);
+			REQUIRE(other.start + s * intersection.uEnd == overlap.end);
+		}
+	}
+}
+
+TEST_CASE("parametric segment intersection of vertical and touching segments", "[Collision functions]") {
+	// Vertical segment crossing a horizontal one
+	auto crossing = ch::collision::line_segments_parametric_intersection(ch::LineSegment({ 2.f, -2.f }, { 2.f, 6.f }), ch::LineSegment({ 0.f, 0.f }, { 8.f, 0.f }));
+	REQUIRE(crossing.type == ch::IntersectionType::Crossing);
+	REQUIRE(crossing.t == 0.25f);
+	REQUIRE(crossing.u == 0.25f);
+
+	// Segments sharing an extremity
+	auto touching = ch::collision::line_segments_parametric_intersection(ch::LineSegment({ 0.f, 0.f }, { 4.f, 4.f }), ch::LineSegment({ 4.f, 4.f }, { 8.f, 0.f }));
+	REQUIRE(touching.type == ch::IntersectionType::Crossing);
+	REQUIRE(touching.t == 1.f);
+	REQUIRE(touching.u == 0.f);
+
+	// Collinear segments sharing an extremity
+	auto collinear = ch::collision::line_segments_parametric_intersection(ch::LineSegment({ 0.f, 0.f }, { 4.f, 0.f }), ch::LineSegment({ 8.f, 0.f }, { 4.f, 0.f }));
+	REQUIRE(collinear.type == ch::IntersectionType::Crossing);
+	REQUIRE(collinear.t == 1.f);
+	REQUIRE(collinear.u == 1.f);
+
+	// Collinear segments separated by a gap
+	auto gap = ch::collision::line_segments_parametric_intersection(ch::LineSegment({ 0.f, 0.f }, { 0.f, 4.f }), ch::LineSegment({ 0.f, 5.f }, { 0.f, 8.f }));
+	REQUIRE(gap.type == ch::IntersectionType::None);
+
+	// Point located on a segment
+	auto point = ch::collision::line_segments_parametric_intersection(ch::LineSegment({ 1.f, 1.f }, { 1.f, 1.f }), ch::LineSegment({ 0.f, 0.f }, { 4.f, 4.f }));
+	REQUIRE(point.type == ch::IntersectionType::Crossing);
+	REQUIRE(point.u == 0.25f);
+}
+
+TEST_CASE("closest point of a segment", "[Collision functions]") {
+	ch::LineSegment segment({ 0.f, 0.f }, { 10.f, 0.f });
+
+	REQUIRE(ch::collision::closest_point_on_segment(segment, { 4.f, 5.f }) == ch::vec_t(4.f, 0.f));
+	REQUIRE(ch::collision::closest_point_on_segment(segment, { -4.f, 5.f }) == ch::vec_t(0.f, 0.f));
+	REQUIRE(ch::collision::closest_point_on_segment(segment, { 14.f, -5.f }) == ch::vec_t(10.f, 0.f));
+	REQUIRE(ch::collision::closest_point_on_segment(ch::LineSegment({ 1.f, 1.f }, { 1.f, 1.f }), { 4.f, 5.f }) == ch::vec_t(1.f, 1.f));
+}
+
+TEST_CASE("circle and segment intersect", "[Collision functions]") {
+	ch::LineSegment segment({ 0.f, 0.f }, { 10.f, 0.f });
+
+	REQUIRE(ch::collision::circle_intersects(ch::Circle({ 5.f, 2.f }, 3.f), segment));
+	REQUIRE(ch::collision::circle_intersects(ch::Circle({ 12.f, 0.f }, 3.f), segment));
+	REQUIRE_FALSE(ch::collision::circle_intersects(ch::Circle({ 5.f, 4.f }, 3.f), segment));
+	REQUIRE_FALSE(ch::collision::circle_intersects(ch::Circle({ 13.f, 0.f }, 3.f), segment));
+}
+
+TEST_CASE("circle and segment collision info", "[Collision functions]") {
+	ch::LineSegment segment({ 0.f, 0.f }, { 10.f, 0.f });
+
+	auto collision = ch::collision::circle_segment_collision_info(segment, ch::Circle({ 5.f, 2.f }, 3.f));
+	REQUIRE(collision.normal == ch::DOWN_VEC);
+	REQUIRE(collision.absoluteDepth == 1.f);
+
+	// Collision with an extremity of the segment
+	collision = ch::collision::circle_segment_collision_info(segment, ch::Circle({ -3.f, -4.f }, 6.f));
+	REQUIRE(collision.normal.x == Approx(-0.6f));
+	REQUIRE(collision.normal.y == Approx(-0.8f));
+	REQUIRE(collision.absoluteDepth == Approx(1.f));
+
+	// Center on the segment
+	collision = ch::collision::circle_segment_collision_info(segment, ch::Circle({ 5.f, 0.f }, 3.f));
+	REQUIRE(std::abs(collision.normal.y) == 1.f);
+	REQUIRE(collision.absoluteDepth == 3.f);
+
+	collision = ch::collision::circle_segment_collision_info(segment, ch::Circle({ 5.f, 4.f }, 3.f));
+	REQUIRE(collision.normal == ch::NULL_VEC);
+}
+
+TEST_CASE("moving circle hits the side of a segment", "[Collision functions]") {
+	ch::LineSegment wall({ 0.f, 10.f }, { 10.f, 10.f });
+	ch::Circle circle({ 5.f, 0.f }, 2.f);
+	float time = -1.f;
+
+	REQUIRE(ch::collision::circle_segment_time_of_impact(circle, { 0.f, 16.f }, wall, time));
+	REQUIRE(time == Approx(0.5f));
+	REQUIRE_FALSE(ch::collision::circle_segment_time_of_impact(circle, { 0.f, 7.f }, wall, time));
+	REQUIRE_FALSE(ch::collision::circle_segment_time_of_impact(circle, { 0.f, -16.f }, wall, time));
+
+	auto hit = ch::collision::circle_sweep_hit(circle, { 0.f, 16.f }, wall, 3, 0.5f);
+	REQUIRE(hit.index == 3);
+	REQUIRE(hit.normal == ch::UP_VEC);
+	REQUIRE(hit.point.x == Approx(5.f));
+	REQUIRE(hit.point.y == Approx(10.f));
+}
+
+TEST_CASE("moving circle hits the extremity of a segment", "[Collision functions]") {
+	ch::LineSegment wall({ 10.f, 0.f }, { 10.f, -10.f });
+	ch::Circle circle({ 0.f, 1.f }, 2.f);
+	float time = -1.f;
+
+	// The center passes 1 unit below the extremity : contact when the center is at x = 10 - sqrt(3)
+	REQUIRE(ch::collision::circle_segment_time_of_impact(circle, { 20.f, 0.f }, wall, time));
+	REQUIRE(time == Approx((10.f - std::sqrt(3.f)) / 20.f));
+
+	auto hit = ch::collision::circle_sweep_hit(circle, { 20.f, 0.f }, wall, 0, time);
+	REQUIRE(hit.point.x == Approx(10.f));
+	REQUIRE(hit.point.y == Approx(0.f));
+	REQUIRE(hit.normal.x == Approx(-std::sqrt(3.f) / 2.f));
+	REQUIRE(hit.normal.y == Approx(0.5f));
+}
+
+TEST_CASE("circle already touching a segment hits it immediately", "[Collision functions]") {
+	float time = -1.f;
+	REQUIRE(ch::collision::circle_segment_time_of_impact(ch::Circle({ 0.f, 1.f }, 2.f), { 5.f, 5.f }, ch::LineSegment({ -5.f, 0.f }, { 5.f, 0.f }), time));
+	REQUIRE(time == 0.f);
+}
+
+TEST_CASE("moving circle hits the first segment on its way", "[Collision functions]") {
+	std::vector<ch::LineSegment> walls = {
+		ch::LineSegment({ 30.f, -10.f }, { 30.f, 10.f }),
+		ch::LineSegment({ 20.f, -10.f }, { 20.f, 10.f }),
+		ch::LineSegment({ 10.f, 20.f }, { 10.f, 40.f })
+	};
+	ch::CircleSweepHit hit;
+
+	REQUIRE(ch::collision::circle_sweep(ch::Circle({ 0.f, 0.f }, 5.f), { 50.f, 0.f }, walls, hit));
+	REQUIRE(hit.index == 1);
+	REQUIRE(hit.time == Approx(0.3f));
+	REQUIRE(hit.normal == ch::LEFT_VEC);
+
+	REQUIRE_FALSE(ch::collision::circle_sweep(ch::Circle({ 0.f, 0.f }, 5.f), { 0.f, -50.f }, walls, hit));
+}
+
+TEST_CASE("moving aabb hits another aabb", "[Collision functions]") {
+	const ch::AABB wall(20.f, -10.f, 10.f, 30.f);
+	const ch::AABB box(0.f, 0.f, 10.f, 10.f);
+	float time = -1.f;
+	ch::vec_t normal;
+
+	REQUIRE(ch::collision::aabb_time_of_impact(box, { 20.f, 5.f }, wall, time, normal));
+	REQUIRE(time == Approx(0.5f));
+	REQUIRE(normal == ch::LEFT_VEC);
+
+	REQUIRE_FALSE(ch::collision::aabb_time_of_impact(box, { 5.f, 0.f }, wall, time, normal));
+	REQUIRE_FALSE(ch::collision::aabb_time_of_impact(box, { 20.f, -40.f }, wall, time, normal));
+
+	// Sliding along the side of the wall, touching it, doesn't hit it
+	const ch::AABB touching(10.f, 0.f, 10.f, 10.f);
+	REQUIRE_FALSE(ch::collision::aabb_time_of_impact(touching, { 0.f, 15.f }, wall, time, normal));
+	REQUIRE(ch::collision::aabb_time_of_impact(touching, { 1.f, 15.f }, wall, time, normal));
+	REQUIRE(time == 0.f);
+	REQUIRE(normal == ch::LEFT_VEC);
+
+	// Already overlapping
+	REQUIRE(ch::collision::aabb_time_of_impact(ch::AABB(12.f, 0.f, 10.f, 10.f), { -5.f, 0.f }, wall, time, normal));
+	REQUIRE(time == 0.f);
+	REQUIRE(normal == ch::LEFT_VEC);
+}
+
+TEST_CASE("moving circle hits the sides and the corners of an aabb", "[Collision functions]") {
+	const ch::AABB box(10.f, 0.f, 10.f, 10.f);
+	const ch::Circle circle({ 0.f, 5.f }, 2.f);
+	float time = -1.f;
+	ch::vec_t normal;
+
+	REQUIRE(ch::collision::circle_aabb_time_of_impact(circle, { 16.f, 0.f }, box, time, normal));
+	REQUIRE(time == Approx(0.5f));
+	REQUIRE(normal == ch::LEFT_VEC);
+
+	// The center passes 1 unit above the top-left corner : contact when the center is at x = 10 - sqrt(3)
+	const ch::Circle above({ 0.f, -1.f }, 2.f);
+	REQUIRE(ch::collision::circle_aabb_time_of_impact(above, { 20.f, 0.f }, box, time, normal));
+	REQUIRE(time == Approx((10.f - std::sqrt(3.f)) / 20.f));
+	REQUIRE(normal.x == Approx(-std::sqrt(3.f) / 2.f));
+	REQUIRE(normal.y == Approx(-0.5f));
+
+	// Passes next to the corner, inside the AABB grown by the radius but outside the rounded corner
+	REQUIRE_FALSE(ch::collision::circle_aabb_time_of_impact(ch::Circle({ 0.f, 6.4f }, 2.f), { 20.f, -20.f }, box, time, normal));
+
+	REQUIRE(ch::collision::circle_aabb_time_of_impact(ch::Circle({ 11.f, 5.f }, 2.f), { 5.f, 5.f }, box, time, normal));
+	REQUIRE(time == 0.f);
+	REQUIRE(normal == ch::LEFT_VEC);
+}
+
+TEST_CASE("time of impact of moving shapes agrees with sampling the motion", "[Collision functions]") {
+	const ch::AABB obstacle(ch::rand::rand_vector(-20.f, 20.f, -20.f, 20.f), ch::rand::rand_vector(1.f, 20.f, 1.f, 20.f));
+	const ch::vec_t motion = ch::rand::rand_vector(-60.f, 60.f, -60.f, 60.f);
+	const int samples = 200;
+
+	const ch::AABB box(ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f), ch::rand::rand_vector(1.f, 10.f, 1.f, 10.f));
+	float time;
+	ch::vec_t normal;
+	if (ch::collision::aabb_time_of_impact(box, motion, obstacle, time, normal)) {
+		REQUIRE(ch::vec_magnitude(normal) == Approx(1.f));
+		// Touching the obstacle at the time of impact
+		ch::AABB moved(box.pos - ch::vec_t(0.01f, 0.01f), box.size + ch::vec_t(0.02f, 0.02f));
+		moved.move(motion * time);
+		REQUIRE(ch::collision::aabb_intersects(moved, obstacle));
+	}
+	else {
+		time = 1.f;
+	}
+	for (int i = 0; i < samples && time > 0.f; ++i) {
+		ch::AABB moved = box;
+		moved.move(motion * (time * i / samples));
+		REQUIRE_FALSE(ch::collision::aabb_intersects(moved, obstacle));
+	}
+
+	const ch::Circle circle(ch::rand::rand_vector(-50.f, 50.f, -50.f, 50.f), ch::rand::rand_float(1.f, 10.f));
+	if (ch::collision::circle_aabb_time_of_impact(circle, motion, obstacle, time, normal)) {
+		REQUIRE(ch::vec_magnitude(normal) == Approx(1.f));
+		REQUIRE(ch::collision::aabb_intersects(obstacle, ch::Circle(circle.pos + motion * time, circle.radius + 0.01f)));
+	}
+	else {
+		time = 1.f;
+	}
+	for (int i = 0; i < samples && time > 0.f; ++i) {
+		REQUIRE_FALSE(ch::collision::aabb_intersects(obstacle, ch::Circle(circle.pos + motion * (time * i / samples), circle.radius)));
+	}
+}
+
+TEST_CASE("segment clipped by an aabb", "[Collision functions]") {
+	ch::AABB box(10.f, 10.f, 10.f, 10.f);
+
+	auto clip = ch::collision::line_segment_aabb_clip(ch::LineSegment({ 0.f, 15.f }, { 40.f, 15.f }), box);
+	REQUIRE(clip.intersects);
+	REQUIRE(clip.entry == 0.25f);
+	REQUIRE(clip.exit == 0.5f);
+	REQUIRE(clip.clipped == ch::LineSegment({ 10.f, 15.f }, { 20.f, 15.f }));
+
+	// Diagonal segment starting inside the box
+	clip = ch::collision::line_segment_aabb_clip(ch::LineSegment({ 15.f, 15.f }, { 25.f, 25.f }), box);
+	REQUIRE(clip.intersects);
+	REQUIRE(clip.entry == 0.f);
+	REQUIRE(clip.exit == 0.5f);
+	REQUIRE(clip.clipped == ch::LineSegment({ 15.f, 15.f }, { 20.f, 20.f }));
+
+	// Segment touching a side
+	REQUIRE(ch::collision::aabb_intersects(box, ch::LineSegment({ 20.f, 0.f }, { 20.f, 40.f })));
+
+	// Segments missing the box
+	REQUIRE_FALSE(ch::collision::aabb_intersects(box, ch::LineSegment({ 0.f, 0.f }, { 9.f, 40.f })));
+	REQUIRE_FALSE(ch::collision::aabb_intersects(box, ch::LineSegment({ 0.f, 15.f }, { 15.f, 0.f })));
+	REQUIRE_FALSE(ch::collision::aabb_intersects(box, ch::LineSegment({ 0.f, 15.f }, { 5.f, 15.f })));
+}
+
+TEST_CASE("segment vs aabb agrees with testing the sides of the aabb", "[Collision functions]") {
+	ch::AABB box(-10.f, -5.f, 20.f, 10.f);
+	const std::vector<ch::LineSegment> sides = {
+		ch::LineSegment(box.corner(ch::Corner::TopLeft), box.corner(ch::Corner::TopRight)),
+		ch::LineSegment(box.corner(ch::Corner::TopRight), box.corner(ch::Corner::BottomRight)),
+		ch::LineSegment(box.corner(ch::Corner::BottomRight), box.corner(ch::Corner::BottomLeft)),
+		ch::LineSegment(box.corner(ch::Corner::BottomLeft), box.corner(ch::Corner::TopLeft))
+	};
+
+	for (int i = 0; i < 500; ++i) {
+		ch::LineSegment segment(ch::rand::rand_vector(-30.f, 30.f, -30.f, 30.f), ch::rand::rand_vector(-30.f, 30.f, -30.f, 30.f));
+
+		bool crossesSide = false;
+		for (const auto& side : sides) {
+			crossesSide = crossesSide || ch::collision::line_segments_parametric_intersection(segment, side).type != ch::IntersectionType::None;
+		}
+		bool expected = crossesSide || ch::collision::aabb_contains(box, segment.start);
+
+		REQUIRE(ch::collision::aabb_intersects(box, segment) == expected);
+	}
+}
+
+TEST_CASE("convex polygons collision", "[Collision functions]") {
+	// Triangle pointing right, overlapping a square on its right by 1
+	ch::ConvexPolygon triangle({ { 0.f, 0.f }, { 4.f, 2.f }, { 0.f, 4.f } });
+	ch::ConvexPolygon square(ch::AABB(3.f, 1.f, 2.f, 2.f));
+
+	ch::PolygonCollision collision = ch::collision::polygon_collision_info(triangle, square);
+	REQUIRE(ch::collision::polygon_intersects(triangle, square));
+	REQUIRE(collision.normal.x > 0.f);
+	REQUIRE(collision.absoluteDepth > 0.f);
+	REQUIRE(collision.absoluteDepth <= 1.f);
+
+	// The normal goes from the first polygon towards the other one
+	ch::PolygonCollision reversed = ch::collision::polygon_collision_info(square, triangle);
+	REQUIRE(reversed.normal.x == Approx(-collision.normal.x));
+	REQUIRE(reversed.normal.y == Approx(-collision.normal.y));
+	REQUIRE(reversed.absoluteDepth == Approx(collision.absoluteDepth));
+
+	// Separated by the edge of the triangle even though the bounds overlap
+	square.move({ 0.f, -2.5f });
+	REQUIRE(ch::collision::aabb_intersects(triangle.bounds(), square.bounds()));
+	REQUIRE_FALSE(ch::collision::polygon_intersects(triangle, square));
+	REQUIRE(ch::collision::polygon_collision_info(triangle, square).normal == ch::NULL_VEC);
+
+	// Only touching
+	ch::ConvexPolygon left(ch::AABB(0.f, 0.f, 2.f, 2.f));
+	ch::ConvexPolygon right(ch::AABB(2.f, 0.f, 2.f, 2.f));
+	REQUIRE_FALSE(ch::collision::polygon_intersects(left, right));
+}
+
+TEST_CASE("convex polygon vs aabb agrees with aabb collision info", "[Collision functions]") {
+	for (int i = 0; i < 500; ++i) {
+		ch::AABB first(static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(1, 8)), static_cast<float>(ch::rand::rand_int(1, 8)));
+		ch::AABB other(static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(1, 8)), static_cast<float>(ch::rand::rand_int(1, 8)));
+		ch::ConvexPolygon polygon(first);
+
+		ch::AABBCollision expected = ch::collision::aabb_collision_info(first, other);
+		bool overlapping = expected.normal != ch::NULL_VEC && expected.delta.x > 0.f && expected.delta.y > 0.f;
+
+		ch::PolygonCollision collision = ch::collision::polygon_collision_info(polygon, other);
+		ch::PolygonCollision polygonCollision = ch::collision::polygon_collision_info(polygon, ch::ConvexPolygon(other));
+		REQUIRE(ch::collision::polygon_intersects(polygon, other) == overlapping);
+		REQUIRE(ch::collision::polygon_intersects(polygon, ch::ConvexPolygon(other)) == overlapping);
+		if (overlapping) {
+			REQUIRE(collision.normal == expected.normal);
+			REQUIRE(collision.absoluteDepth == std::min(expected.delta.x, expected.delta.y));
+			REQUIRE(polygonCollision.absoluteDepth == collision.absoluteDepth);
+		}
+		else {
+			REQUIRE(collision.normal == ch::NULL_VEC);
+		}
+	}
+}
+
+TEST_CASE("convex polygon vs circle", "[Collision functions]") {
+	ch::ConvexPolygon square(ch::AABB(0.f, 0.f, 4.f, 4.f));
+
+	// Against a side
+	ch::PolygonCollision side = ch::collision::polygon_collision_info(square, ch::Circle({ 5.f, 2.f }, 2.f));
+	REQUIRE(side.normal == ch::RIGHT_VEC);
+	REQUIRE(side.absoluteDepth == 1.f);
+
+	// Near a corner : the axis goes from the corner to the center
+	ch::PolygonCollision corner = ch::collision::polygon_collision_info(square, ch::Circle({ 7.f, 8.f }, 6.f));
+	REQUIRE(corner.normal.x == Approx(0.6f));
+	REQUIRE(corner.normal.y == Approx(0.8f));
+	REQUIRE(corner.absoluteDepth == Approx(1.f));
+
+	// Inside the bounds of the circle but separated by the corner axis
+	REQUIRE_FALSE(ch::collision::polygon_intersects(square, ch::Circle({ 7.f, 8.f }, 4.5f)));
+
+	// Touching
+	REQUIRE_FALSE(ch::collision::polygon_intersects(square, ch::Circle({ 6.f, 2.f }, 2.f)));
+}
+
+TEST_CASE("non-rotated obb collides like an aabb", "[Collision functions]") {
+	for (int i = 0; i < 500; ++i) {
+		ch::AABB first(static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(1, 8)), static_cast<float>(ch::rand::rand_int(1, 8)));
+		ch::AABB other(static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(-10, 10)), static_cast<float>(ch::rand::rand_int(1, 8)), static_cast<float>(ch::rand::rand_int(1, 8)));
+		ch::PolygonCollision expected = ch::collision::polygon_collision_info(ch::ConvexPolygon(first), other);
+
+		ch::OBBCollision collision = ch::collision::obb_collision_info(ch::OBB(first), other);
+		ch::OBBCollision obbCollision = ch::collision::obb_collision_info(ch::OBB(first), ch::OBB(other));
+		REQUIRE(ch::collision::obb_intersects(ch::OBB(first), other) == (expected.absoluteDepth > 0.f));
+		REQUIRE(collision.absoluteDepth == expected.absoluteDepth);
+		REQUIRE(obbCollision.absoluteDepth == expected.absoluteDepth);
+		if (expected.absoluteDepth > 0.f) {
+			REQUIRE(ch::vec_dot_product(collision.normal, other.center() - first.center()) >= 0.f);
+		}
+	}
+}
+
+TEST_CASE("rotated obb collision", "[Collision functions]") {
+	// A diamond of half diagonal sqrt(2) * 2 centered on the origin
+	ch::OBB diamond({ 0.f, 0.f }, { 2.f, 2.f }, 45.f);
+	const float halfDiagonal = 2.f * std::sqrt(2.f);
+
+	// AABB to the right : pushed along X by the tip of the diamond
+	ch::OBBCollision right = ch::collision::obb_collision_info(diamond, ch::AABB(halfDiagonal - 0.5f, -1.f, 4.f, 2.f));
+	REQUIRE(right.normal.x == Approx(1.f));
+	REQUIRE(right.normal.y == Approx(0.f).margin(1e-5));
+	REQUIRE(right.absoluteDepth == Approx(0.5f));
+
+	// Inside the bounds of the diamond but outside of its edge
+	REQUIRE_FALSE(ch::collision::obb_intersects(diamond, ch::AABB(2.f, 2.f, 1.f, 1.f)));
+	REQUIRE_FALSE(ch::collision::obb_intersects(diamond, ch::Circle({ 2.5f, 2.5f }, 1.f)));
+
+	// Circle against an edge : pushed along the normal of the edge
+	ch::OBBCollision circle = ch::collision::obb_collision_info(diamond, ch::Circle({ 2.f, 2.f }, 1.5f));
+	REQUIRE(circle.normal.x == Approx(std::sqrt(0.5f)));
+	REQUIRE(circle.normal.y == Approx(std::sqrt(0.5f)));
+	REQUIRE(circle.absoluteDepth == Approx(1.5f - (halfDiagonal - 2.f)));
+	REQUIRE(ch::collision::obb_intersects(diamond, ch::Circle({ 2.f, 2.f }, 1.5f)));
+
+	// Two diamonds side by side
+	ch::OBB other({ 2.f * halfDiagonal - 1.f, 0.f }, { 2.f, 2.f }, 45.f);
+	ch::OBBCollision diamonds = ch::collision::obb_collision_info(diamond, other);
+	REQUIRE(diamonds.absoluteDepth == Approx(std::sqrt(0.5f)));
+	REQUIRE(diamonds.normal.x > 0.f);
+}
+
+TEST_CASE("obb vs line segment", "[Collision functions]") {
+	ch::OBB diamond({ 0.f, 0.f }, { 2.f, 2.f }, 45.f);
+	const float halfDiagonal = 2.f * std::sqrt(2.f);
+
+	// Vertical segment crossing the right tip of the diamond
+	ch::OBBCollision tip = ch::collision::obb_collision_info(diamond, ch::LineSegment({ halfDiagonal - 0.5f, -5.f }, { halfDiagonal - 0.5f, 5.f }));
+	REQUIRE(tip.normal.x == Approx(1.f));
+	REQUIRE(tip.absoluteDepth == Approx(0.5f));
+
+	// Segment whose bounds overlap the diamond, separated by the edge of the diamond
+	REQUIRE_FALSE(ch::collision::obb_intersects(diamond, ch::LineSegment({ 1.f, 3.5f }, { 3.5f, 1.f })));
+	REQUIRE(ch::collision::obb_intersects(diamond, ch::LineSegment({ 0.5f, 2.f }, { 2.f, 0.5f })));
+
+	// A point inside
+	REQUIRE(ch::collision::obb_intersects(diamond, ch::LineSegment({ 0.5f, 0.f }, { 0.5f, 0.f })));
+}
+
+TEST_CASE("closest points between segments", "[Collision functions]") {
+	ch::vec_t onFirst, onOther;
+
+	// Crossing
+	ch::collision::closest_points_between_segments(ch::LineSegment({ 0.f, 0.f }, { 4.f, 4.f }), ch::LineSegment({ 0.f, 4.f }, { 4.f, 0.f }), onFirst, onOther);
+	REQUIRE(onFirst == ch::vec_t(2.f, 2.f));
+	REQUIRE(onOther == ch::vec_t(2.f, 2.f));
+
+	// Extremity of one segment against the middle of the other
+	ch::collision::closest_points_between_segments(ch::LineSegment({ 0.f, 0.f }, { 4.f, 0.f }), ch::LineSegment({ 2.f, 1.f }, { 2.f, 5.f }), onFirst, onOther);
+	REQUIRE(onFirst == ch::vec_t(2.f, 0.f));
+	REQUIRE(onOther == ch::vec_t(2.f, 1.f));
+
+	// Extremities
+	ch::collision::closest_points_between_segments(ch::LineSegment({ 0.f, 0.f }, { 1.f, 0.f }), ch::LineSegment({ 3.f, 2.f }, { 5.f, 4.f }), onFirst, onOther);
+	REQUIRE(onFirst == ch::vec_t(1.f, 0.f));
+	REQUIRE(onOther == ch::vec_t(3.f, 2.f));
+
+	// Points
+	ch::collision::closest_points_between_segments(ch::LineSegment({ 1.f, 1.f }, { 1.f, 1.f }), ch::LineSegment({ 0.f, 3.f }, { 4.f, 3.f }), onFirst, onOther);
+	REQUIRE(onFirst == ch::vec_t(1.f, 1.f));
+	REQUIRE(onOther == ch::vec_t(1.f, 3.f));
+}
+
+TEST_CASE("capsule collision against capsules, circles and segments", "[Collision functions]") {
+	ch::Capsule vertical({ 0.f, 0.f }, { 0.f, 10.f }, 1.f);
+
+	ch::CapsuleCollision capsules = ch::collision::capsule_collision_info(vertical, ch::Capsule({ 1.5f, 4.f }, { 5.f, 4.f }, 1.f));
+	REQUIRE(capsules.normal == ch::RIGHT_VEC);
+	REQUIRE(capsules.absoluteDepth == 0.5f);
+	REQUIRE(ch::collision::capsule_intersects(vertical, ch::Capsule({ 1.5f, 4.f }, { 5.f, 4.f }, 1.f)));
+	REQUIRE_FALSE(ch::collision::capsule_intersects(vertical, ch::Capsule({ 2.f, 4.f }, { 5.f, 4.f }, 1.f)));
+
+	// Against the rounded end
+	ch::CapsuleCollision circle = ch::collision::capsule_collision_info(vertical, ch::Circle({ 0.f, 12.f }, 1.5f));
+	REQUIRE(circle.normal == ch::DOWN_VEC);
+	REQUIRE(circle.absoluteDepth == 0.5f);
+	REQUIRE_FALSE(ch::collision::capsule_intersects(vertical, ch::Circle({ 0.f, 12.f }, 1.f)));
+
+	// Segment crossing the capsule : pushed perpendicularly to the capsule, out of the side it sticks out the least
+	const ch::LineSegment across({ -1.f, 5.f }, { 3.f, 5.f });
+	ch::CapsuleCollision crossing = ch::collision::capsule_collision_info(vertical, across);
+	REQUIRE(crossing.normal == ch::RIGHT_VEC);
+	REQUIRE(crossing.absoluteDepth == 2.f);
+	REQUIRE_FALSE(ch::collision::capsule_intersects(vertical, ch::LineSegment(across.start + crossing.normal * crossing.absoluteDepth, across.end + crossing.normal * crossing.absoluteDepth)));
+	// Crossing capsules
+	ch::CapsuleCollision crossingCapsules = ch::collision::capsule_collision_info(vertical, ch::Capsule(across.start, across.end, 0.5f));
+	REQUIRE(crossingCapsules.normal == ch::RIGHT_VEC);
+	REQUIRE(crossingCapsules.absoluteDepth == 2.5f);
+	REQUIRE_FALSE(ch::collision::capsule_intersects(vertical, ch::Capsule(across.start + crossingCapsules.normal * 2.5f, across.end + crossingCapsules.normal * 2.5f, 0.5f)));
+	// Crossing near the end of the capsule : pushed along the capsule, past its rounded end
+	ch::CapsuleCollision nearEnd = ch::collision::capsule_collision_info(vertical, ch::LineSegment({ -5.f, 9.5f }, { 5.f, 9.5f }));
+	REQUIRE(nearEnd.normal == ch::DOWN_VEC);
+	REQUIRE(nearEnd.absoluteDepth == 1.5f);
+
+	// Pushing the other capsule by the depth separates them
+	for (int i = 0; i < 1000; ++i) {
+		const ch::Capsule first(ch::rand::rand_vector(-10.f, 10.f, -10.f, 10.f), ch::rand::rand_vector(-10.f, 10.f, -10.f, 10.f), ch::rand::rand_float(0.1f, 3.f));
+		const ch::Capsule other(ch::rand::rand_vector(-10.f, 10.f, -10.f, 10.f), ch::rand::rand_vector(-10.f, 10.f, -10.f, 10.f), ch::rand::rand_float(0.1f, 3.f));
+		const ch::CapsuleCollision collision = ch::collision::capsule_collision_info(first, other);
+		REQUIRE((collision.absoluteDepth > 0.f) == ch::collision::capsule_intersects(first, other));
+		const ch::vec_t push = collision.normal * (collision.absoluteDepth + 0.001f);
+		REQUIRE_FALSE(ch::collision::capsule_intersects(first, ch::Capsule(other.segment.start + push, other.segment.end + push, other.radius)));
+	}
+	REQUIRE(ch::collision::capsule_intersects(vertical, ch::LineSegment({ 0.5f, 5.f }, { 3.f, 5.f })));
+	REQUIRE_FALSE(ch::collision::capsule_intersects(vertical, ch::LineSegment({ 1.f, 5.f }, { 3.f, 5.f })));
+}
+
+TEST_CASE("capsule collision against an aabb", "[Collision functions]") {
+	ch::Capsule vertical({ 0.f, 0.f }, { 0.f, 10.f }, 1.f);
+
+	// Side of the capsule against the side of the box
+	ch::CapsuleCollision side = ch::collision::capsule_collision_info(vertical, ch::AABB(0.5f, 2.f, 3.f, 3.f));
+	REQUIRE(side.normal == ch::RIGHT_VEC);
+	REQUIRE(side.absoluteDepth == 0.5f);
+
+	// Rounded end against a corner of the box
+	ch::CapsuleCollision corner = ch::collision::capsule_collision_info(vertical, ch::AABB(0.3f, 10.4f, 3.f, 3.f));
+	REQUIRE(corner.normal.x == Approx(0.6f));
+	REQUIRE(corner.normal.y == Approx(0.8f));
+	REQUIRE(corner.absoluteDepth == Approx(0.5f));
+	REQUIRE_FALSE(ch::collision::capsule_intersects(vertical, ch::AABB(0.8f, 10.8f, 3.f, 3.f)));
+
+	// Segment going through the box : the box is pushed along the shortest axis
+	ch::CapsuleCollision through = ch::collision::capsule_collision_info(vertical, ch::AABB(-0.5f, 3.f, 4.f, 2.f));
+	REQUIRE(through.normal == ch::RIGHT_VEC);
+	REQUIRE(through.absoluteDepth == 1.5f);
+	REQUIRE(ch::collision::capsule_intersects(vertical, ch::AABB(-0.5f, 3.f, 4.f, 2.f)));
+}
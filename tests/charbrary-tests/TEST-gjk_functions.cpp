@@ -0,0 +1,135 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+TEST_CASE("support points are the farthest points of the shapes", "[gjk_functions]") {
+	REQUIRE(ch::collision::support_point(ch::AABB(1.f, 2.f, 3.f, 4.f), { 1.f, -1.f }) == ch::vec_t(4.f, 2.f));
+	REQUIRE(ch::collision::support_point(ch::Circle({ 1.f, 1.f }, 2.f), { 0.f, 5.f }) == ch::vec_t(1.f, 3.f));
+	REQUIRE(ch::collision::support_point(ch::LineSegment({ 0.f, 0.f }, { 2.f, 1.f }), { -1.f, 0.f }) == ch::vec_t(0.f, 0.f));
+	REQUIRE(ch::collision::support_point(ch::ConvexPolygon({ { 0.f, 0.f }, { 4.f, 2.f }, { 0.f, 4.f } }), { 1.f, 0.f }) == ch::vec_t(4.f, 2.f));
+	REQUIRE(ch::collision::support_point(ch::Capsule({ 0.f, 0.f }, { 0.f, 4.f }, 1.f), { 0.f, 1.f }) == ch::vec_t(0.f, 5.f));
+
+	ch::vec_t corner = ch::collision::support_point(ch::OBB({ 0.f, 0.f }, { 2.f, 1.f }, 90.f), { 1.f, 1.f });
+	REQUIRE(corner.x == Approx(1.f));
+	REQUIRE(corner.y == Approx(2.f));
+}
+
+TEST_CASE("gjk distance between separated aabbs", "[gjk_functions]") {
+	ch::AABB first(0.f, 0.f, 2.f, 2.f);
+	ch::AABB other(5.f, 6.f, 2.f, 2.f);
+
+	ch::GJKResult result = ch::collision::gjk_distance(first, other);
+	REQUIRE_FALSE(result.intersects);
+	REQUIRE(result.distance == Approx(5.f));
+	REQUIRE(result.pointOnFirst.x == Approx(2.f));
+	REQUIRE(result.pointOnFirst.y == Approx(2.f));
+	REQUIRE(result.pointOnOther.x == Approx(5.f));
+	REQUIRE(result.pointOnOther.y == Approx(6.f));
+}
+
+TEST_CASE("gjk distance between circles agrees with circles_distance", "[gjk_functions]") {
+	for (int i = 0; i < 100; ++i) {
+		ch::Circle first(ch::rand::rand_vector(-10.f, 10.f, -10.f, 10.f), ch::rand::rand_float(0.5f, 3.f));
+		ch::Circle other(ch::rand::rand_vector(-10.f, 10.f, -10.f, 10.f), ch::rand::rand_float(0.5f, 3.f));
+
+		float expected = ch::collision::circles_distance(first, other);
+		ch::GJKResult result = ch::collision::gjk_distance(first, other);
+		REQUIRE(result.intersects == (expected < 0.f));
+		if (!result.intersects) {
+			REQUIRE(result.distance == Approx(expected).margin(1e-4f));
+		}
+	}
+}
+
+TEST_CASE("gjk overlap agrees with polygon_intersects", "[gjk_functions]") {
+	for (int i = 0; i < 200; ++i) {
+		ch::ConvexPolygon polygon(ch::AABB(ch::rand::rand_vector(-5.f, 5.f, -5.f, 5.f), ch::rand::rand_vector(1.f, 4.f, 1.f, 4.f)));
+		polygon.rotate(ch::rand::rand_float(0.f, 90.f));
+		ch::AABB aabb(ch::rand::rand_vector(-5.f, 5.f, -5.f, 5.f), ch::rand::rand_vector(1.f, 4.f, 1.f, 4.f));
+
+		REQUIRE(ch::collision::gjk_intersects(polygon, aabb) == ch::collision::polygon_intersects(polygon, aabb));
+	}
+}
+
+TEST_CASE("gjk collision info agrees with polygon_collision_info", "[gjk_functions]") {
+	for (int i = 0; i < 200; ++i) {
+		ch::ConvexPolygon polygon(ch::AABB(ch::rand::rand_vector(-5.f, 5.f, -5.f, 5.f), ch::rand::rand_vector(1.f, 4.f, 1.f, 4.f)));
+		polygon.rotate(ch::rand::rand_float(0.f, 90.f));
+		ch::ConvexPolygon other(ch::AABB(ch::rand::rand_vector(-5.f, 5.f, -5.f, 5.f), ch::rand::rand_vector(1.f, 4.f, 1.f, 4.f)));
+
+		ch::PolygonCollision expected = ch::collision::polygon_collision_info(polygon, other);
+		ch::ConvexCollision collision = ch::collision::gjk_collision_info(polygon, other);
+		REQUIRE((collision.normal == ch::NULL_VEC) == (expected.normal == ch::NULL_VEC));
+		REQUIRE(collision.absoluteDepth == Approx(expected.absoluteDepth).margin(1e-3f));
+	}
+}
+
+TEST_CASE("gjk collision info agrees with circle_aabb_collision_info", "[gjk_functions]") {
+	ch::AABB aabb(0.f, 0.f, 4.f, 4.f);
+	for (int i = 0; i < 200; ++i) {
+		ch::Circle circle(ch::rand::rand_vector(-2.f, 6.f, -2.f, 6.f), ch::rand::rand_float(0.5f, 2.f));
+
+		ch::CircleAABBCollision expected = ch::collision::circle_aabb_collision_info(aabb, circle);
+		ch::ConvexCollision collision = ch::collision::gjk_collision_info(aabb, circle);
+		REQUIRE((collision.normal == ch::NULL_VEC) == (expected.normal == ch::NULL_VEC));
+		if (expected.normal != ch::NULL_VEC) {
+			REQUIRE(collision.absoluteDepth == Approx(expected.absoluteDepth).margin(1e-3f));
+			REQUIRE(collision.normal.x == Approx(expected.normal.x).margin(1e-3f));
+			REQUIRE(collision.normal.y == Approx(expected.normal.y).margin(1e-3f));
+		}
+	}
+}
+
+TEST_CASE("gjk finds the shortest way out of concentric boxes", "[gjk_functions]") {
+	ch::AABB outer(0.f, 0.f, 10.f, 4.f);
+	ch::AABB inner(4.f, 1.f, 2.f, 2.f);
+
+	ch::ConvexCollision collision = ch::collision::gjk_collision_info(outer, inner);
+	REQUIRE(collision.absoluteDepth == Approx(3.f));
+	REQUIRE(collision.normal.x == Approx(0.f).margin(1e-5f));
+	REQUIRE(std::abs(collision.normal.y) == Approx(1.f));
+}
+
+TEST_CASE("gjk cache converges in a few iterations for persistent pairs", "[gjk_functions]") {
+	ch::OBB obb({ 0.f, 0.f }, { 2.f, 1.f }, 30.f);
+	ch::Capsule capsule({ 4.f, -3.f }, { 6.f, 3.f }, 0.5f);
+
+	ch::GJKCache cache;
+	ch::GJKResult first = ch::collision::gjk_distance(obb, capsule, &cache);
+	REQUIRE(cache.count > 0);
+
+	for (int frame = 0; frame < 20; ++frame) {
+		capsule.move({ -0.02f, 0.01f });
+		obb.rotate(0.1f);
+
+		ch::GJKResult cold = ch::collision::gjk_distance(obb, capsule);
+		ch::GJKResult warm = ch::collision::gjk_distance(obb, capsule, &cache);
+		REQUIRE(warm.iterations <= 2);
+		REQUIRE(warm.distance == Approx(cold.distance).margin(1e-4f));
+	}
+	REQUIRE(first.distance > 0.f);
+}
+
+ch::vec_t support_point_triangle(const void* shape, const ch::vec_t& direction) {
+	const ch::vec_t* vertices = static_cast<const ch::vec_t*>(shape);
+	ch::vec_t farthest = vertices[0];
+	for (int i = 1; i < 3; ++i) {
+		if (ch::vec_dot_product(vertices[i], direction) > ch::vec_dot_product(farthest, direction)) {
+			farthest = vertices[i];
+		}
+	}
+	return farthest;
+}
+
+TEST_CASE("gjk works with any support mapping", "[gjk_functions]") {
+	const ch::vec_t triangle[3] = { { 0.f, 0.f }, { 4.f, 0.f }, { 0.f, 4.f } };
+	ch::SupportShape roundedTriangle(triangle, support_point_triangle, 1.f);
+
+	ch::GJKResult result = ch::collision::gjk_distance(roundedTriangle, ch::Circle({ 6.f, 6.f }, 1.f));
+	REQUIRE_FALSE(result.intersects);
+	REQUIRE(result.distance == Approx(std::sqrt(32.f) - 2.f));
+
+	ch::ConvexCollision collision = ch::collision::gjk_collision_info(roundedTriangle, ch::AABB(4.5f, -1.f, 2.f, 2.f));
+	REQUIRE(collision.normal.x == Approx(1.f));
+	REQUIRE(collision.absoluteDepth == Approx(0.5f));
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+TEST_CASE("interleave the bits of 2 coordinates into a morton code", "[Morton functions]") {
+	REQUIRE(ch::spatial::morton_encode(0, 0) == 0);
+	REQUIRE(ch::spatial::morton_encode(1, 0) == 1);
+	REQUIRE(ch::spatial::morton_encode(0, 1) == 2);
+	REQUIRE(ch::spatial::morton_encode(3, 3) == 15);
+	REQUIRE(ch::spatial::morton_encode(0xFFFF, 0) == 0x55555555);
+	REQUIRE(ch::spatial::morton_encode(0, 0xFFFF) == 0xAAAAAAAA);
+}
+
+TEST_CASE("points outside the world bounds are clamped to the border", "[Morton functions]") {
+	ch::AABB world(0.f, 0.f, 100.f, 100.f);
+
+	REQUIRE(ch::spatial::morton_code({ -50.f, -50.f }, world) == 0);
+	REQUIRE(ch::spatial::morton_code({ 500.f, 500.f }, world) == 0xFFFFFFFF);
+	REQUIRE(ch::spatial::morton_code({ 100.f, 0.f }, world) == 0x55555555);
+}
+
+TEST_CASE("radix sort gives the same order as a stable sort", "[Morton functions]") {
+	const size_t count = 100000;
+	std::vector<std::uint32_t> keys(count);
+	for (auto& key : keys) {
+		key = static_cast<std::uint32_t>(ch::rand::rand_int(0, 5000)) * 7919u;
+	}
+	std::vector<std::uint32_t> values(count);
+	std::iota(values.begin(), values.end(), 0);
+
+	std::vector<std::uint32_t> expected = values;
+	std::stable_sort(expected.begin(), expected.end(), [&](std::uint32_t a, std::uint32_t b) { return keys[a] < keys[b]; });
+
+	auto sortedKeys = keys;
+	ch::spatial::radix_sort(sortedKeys, values, 4);
+
+	REQUIRE(std::is_sorted(sortedKeys.begin(), sortedKeys.end()));
+	REQUIRE(values == expected);
+}
+
+TEST_CASE("morton sort orders aabbs along the z-order curve", "[Morton functions]") {
+	ch::AABB world(0.f, 0.f, 1000.f, 1000.f);
+	std::vector<ch::AABB> boxes;
+	for (int i = 0; i < 500; ++i) {
+		boxes.emplace_back(ch::rand::rand_vector(0.f, 990.f, 0.f, 990.f), ch::vec_t(10.f, 10.f));
+	}
+	auto original = boxes;
+
+	auto permutation = ch::spatial::morton_sort(boxes, world);
+	auto codes = ch::spatial::morton_codes(boxes, world);
+
+	REQUIRE(std::is_sorted(codes.begin(), codes.end()));
+	for (size_t i = 0; i < boxes.size(); ++i) {
+		REQUIRE(boxes[i] == original[permutation[i]]);
+	}
+}
+
+TEST_CASE("morton order of circles is based on their center", "[Morton functions]") {
+	ch::AABB world(0.f, 0.f, 100.f, 100.f);
+	std::vector<ch::Circle> circles = { ch::Circle({ 90.f, 90.f }, 1.f), ch::Circle({ 10.f, 10.f }, 50.f), ch::Circle({ 90.f, 10.f }, 1.f) };
+
+	auto order = ch::spatial::morton_order(circles, world);
+
+	REQUIRE(order == std::vector<std::uint32_t>{ 1, 2, 0 });
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "charbrary_and_catch2.h"
+
+#include <vector>
+
+namespace {
+	/** Tests every pair of segments. */
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> brute_force_intersecting_pairs(const std::vector<ch::LineSegment>& segments) {
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+		for (std::uint32_t i = 0; i < segments.size(); ++i) {
+			for (std::uint32_t j = i + 1; j < segments.size(); ++j) {
+				if (ch::collision::line_segments_parametric_intersection(segments[i], segments[j]).type != ch::IntersectionType::None) {
+					pairs.emplace_back(i, j);
+				}
+			}
+		}
+		return pairs;
+	}
+
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> intersecting_pairs(const std::vector<ch::collision::IndexedSegmentsIntersection>& intersections) {
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> pairs;
+		for (const auto& intersection : intersections) {
+			pairs.emplace_back(intersection.first, intersection.second);
+		}
+		return pairs;
+	}
+}
+
+TEST_CASE("no intersections in empty and single segment arrays", "[Segments intersection functions]") {
+	REQUIRE(ch::collision::all_line_segments_intersections({}).empty());
+	REQUIRE(ch::collision::all_line_segments_intersections({ ch::LineSegment({ 0.f, 0.f }, { 1.f, 1.f }) }).empty());
+}
+
+TEST_CASE("all intersections of crossing and overlapping segments", "[Segments intersection functions]") {
+	std::vector<ch::LineSegment> segments = {
+		ch::LineSegment({ -7.f,4.f }, { -1.f,1.f }),
+		ch::LineSegment({ -1.f,4.f }, { -4.f,1.f }),
+		ch::LineSegment({ 10.f,0.f }, { 20.f,0.f }),
+		ch::LineSegment({ 15.f,0.f }, { 25.f,0.f }),
+		ch::LineSegment({ 100.f,100.f }, { 101.f,101.f })
+	};
+	auto intersections = ch::collision::all_line_segments_intersections(segments);
+
+	REQUIRE(intersections.size() == 2);
+	REQUIRE(intersections[0].first == 0);
+	REQUIRE(intersections[0].second == 1);
+	REQUIRE(intersections[0].intersection.type == ch::IntersectionType::Crossing);
+	REQUIRE(intersections[0].intersection.point.x == Approx(-3.f));
+	REQUIRE(intersections[0].intersection.point.y == Approx(2.f));
+
+	REQUIRE(intersections[1].first == 2);
+	REQUIRE(intersections[1].second == 3);
+	REQUIRE(intersections[1].intersection.type == ch::IntersectionType::Overlapping);
+	REQUIRE(intersections[1].intersection.resultingSegment.first == ch::vec_t(15.f, 0.f));
+	REQUIRE(intersections[1].intersection.resultingSegment.second == ch::vec_t(20.f, 0.f));
+}
+
+TEST_CASE("all segments intersections match testing every pair", "[Segments intersection functions]") {
+	std::vector<ch::LineSegment> segments;
+	for (int i = 0; i < 1500; ++i) {
+		ch::vec_t start = ch::rand::rand_vector(0.f, 500.f, 0.f, 500.f);
+		segments.emplace_back(start, start + ch::rand::rand_vector(-40.f, 40.f, -40.f, 40.f));
+	}
+	// Grid lines sharing extremities and crossing each other
+	for (int i = 0; i <= 10; ++i) {
+		segments.emplace_back(ch::vec_t(0.f, i * 50.f), ch::vec_t(500.f, i * 50.f));
+		segments.emplace_back(ch::vec_t(i * 50.f, 0.f), ch::vec_t(i * 50.f, 500.f));
+		segments.emplace_back(ch::vec_t(i * 50.f, 0.f), ch::vec_t(i * 50.f, 50.f));
+	}
+
+	auto expected = brute_force_intersecting_pairs(segments);
+	REQUIRE(intersecting_pairs(ch::collision::all_line_segments_intersections(segments, 1)) == expected);
+	REQUIRE(intersecting_pairs(ch::collision::all_line_segments_intersections(segments, 4)) == expected);
+}
@@ -1,4 +1,5 @@
 #pragma once
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch.hpp"
 #include "../../single-include/charbrary.h"